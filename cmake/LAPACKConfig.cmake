@@ -70,6 +70,33 @@ else()
     message( "${red}   XBLAS not found.${plain}" )
 endif()
 
+#-------------------------------------------------------------------------------
+# Per-thread setting, since OpenBLAS 0.3.27.
+message( STATUS "Checking for openblas_set_num_threads_local" )
+
+try_run(
+    run_result compile_result ${CMAKE_CURRENT_BINARY_DIR}
+    SOURCES
+        "${CMAKE_CURRENT_SOURCE_DIR}/config/openblas_threads_local.cc"
+    LINK_LIBRARIES
+        ${LAPACK_LIBRARIES} ${blaspp_libraries}
+    COMPILE_DEFINITIONS
+        ${blaspp_defines}
+    COMPILE_OUTPUT_VARIABLE
+        compile_output
+    RUN_OUTPUT_VARIABLE
+        run_output
+)
+debug_try_run( "openblas_threads_local.cc" "${compile_result}" "${compile_output}"
+                                           "${run_result}" "${run_output}" )
+
+if (compile_result AND "${run_output}" MATCHES "ok")
+    message( "${blue}   Found openblas_set_num_threads_local${plain}" )
+    list( APPEND lapackpp_defs_ "-DLAPACK_HAVE_OPENBLAS_THREADS_LOCAL" )
+else()
+    message( "${red}   openblas_set_num_threads_local not found.${plain}" )
+endif()
+
 #-------------------------------------------------------------------------------
 # Find LAPACKE, either in the BLAS/LAPACK library or in -llapacke.
 # Check for pstrf (Cholesky with pivoting).
@@ -689,6 +689,13 @@ def openblas_version():
     if (rc == 0 and s):
         config.environ.append( 'CXXFLAGS', define('HAVE_OPENBLAS') )
         config.print_result( 'OpenBLAS', rc, '(' + s.group(1) + ')' )
+
+        # per-thread setting, since OpenBLAS 0.3.27
+        (rc, out, err) = config.compile_run(
+            'config/openblas_threads_local.cc', {},
+            'OpenBLAS per-thread threads (openblas_set_num_threads_local)' )
+        if (rc == 0):
+            config.environ.append( 'CXXFLAGS', define('HAVE_OPENBLAS_THREADS_LOCAL') )
     else:
         config.print_result( 'OpenBLAS', rc )
 # end
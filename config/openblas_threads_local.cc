@@ -0,0 +1,21 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include <stdio.h>
+
+// Per-thread setting, since OpenBLAS 0.3.27.
+// Declared here since older cblas.h don't have it.
+#ifdef __cplusplus
+extern "C"
+#endif
+int openblas_set_num_threads_local( int nthreads );
+
+int main()
+{
+    int prev = openblas_set_num_threads_local( 1 );
+    openblas_set_num_threads_local( prev );
+    printf( "ok\n" );
+    return 0;
+}
@@ -20,5 +20,16 @@ const char* lapackpp_id();
 }  // namespace lapack
 
 #include "lapack/wrappers.hh"
+#include "lapack/workspace.hh"
+#include "lapack/allocator.hh"
+#include "lapack/threads.hh"
+#include "lapack/batch.hh"
+#include "lapack/interleaved.hh"
+#include "lapack/fixed.hh"
+#include "lapack/work.hh"
+#include "lapack/plan.hh"
+#include "lapack/async.hh"
+#include "lapack/stats.hh"
+#include "lapack/trace.hh"
 
 #endif // LAPACK_HH
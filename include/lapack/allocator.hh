@@ -0,0 +1,203 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_ALLOCATOR_HH
+#define LAPACK_ALLOCATOR_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lapack {
+namespace workspace {
+
+//==============================================================================
+/// Interface for allocating the workspace that LAPACK++ routines allocate
+/// internally (work, iwork, rwork, and 32-bit copies of integer arrays).
+///
+/// By default, workspace comes from the heap, aligned to 64 bytes.
+/// An allocator can be set for all threads with set_allocator(), or for the
+/// calling thread with set_thread_allocator(), which takes precedence.
+/// It is used for workspace that doesn't fit in the on-stack buffer
+/// (see set_stack_threshold()) and isn't taken from the workspace arena
+/// (see enable()), and for the arena's own buffer.
+///
+/// Each block is requested with one extra cache line (64 bytes) in front,
+/// recording its allocator, so it is freed by the allocator that made it
+/// even if the current allocator changes meanwhile. The allocator must
+/// outlive the blocks it made, and must be thread-safe if it is used by
+/// several threads.
+///
+/// @ingroup workspace
+class Allocator
+{
+public:
+    virtual ~Allocator() {}
+
+    /// Allocates bytes, aligned to at least 64 bytes.
+    /// @param[in] bytes
+    ///     Number of bytes; may be 0.
+    /// @param[in] routine
+    ///     Name of the LAPACK++ routine requesting workspace
+    ///     (e.g., "gesdd"), if known, otherwise nullptr.
+    /// @throws std::bad_alloc if allocation fails.
+    virtual void* allocate( size_t bytes, const char* routine ) = 0;
+
+    /// Frees ptr, allocated by allocate( bytes, ... ).
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept = 0;
+};
+
+//------------------------------------------------------------------------------
+/// Heap allocator, using posix_memalign or _aligned_malloc.
+/// This is the default.
+///
+/// @ingroup workspace
+class HeapAllocator: public Allocator
+{
+public:
+    virtual void* allocate( size_t bytes, const char* routine ) override;
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept override;
+};
+
+//------------------------------------------------------------------------------
+/// Allocates large blocks with mmap backed by huge pages, to reduce TLB
+/// misses and page faults for large work arrays (e.g., in gesdd, syevd).
+/// Blocks of at least min_bytes are rounded up to a multiple of the huge
+/// page size and mapped with MAP_HUGETLB; if no huge pages are reserved,
+/// they are mapped normally with madvise( MADV_HUGEPAGE ) to request
+/// transparent huge pages. Smaller blocks come from the heap.
+/// On systems without these (non-Linux), all blocks come from the heap.
+///
+/// @ingroup workspace
+class HugePageAllocator: public Allocator
+{
+public:
+    /// @param[in] min_bytes
+    ///     Blocks of at least this many bytes use huge pages.
+    ///     Default is the huge page size, 2 MiB.
+    explicit HugePageAllocator( size_t min_bytes = page_size );
+
+    virtual void* allocate( size_t bytes, const char* routine ) override;
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept override;
+
+    /// Huge page size assumed, 2 MiB.
+    static const size_t page_size = 2*1024*1024;
+
+private:
+    size_t min_bytes_;
+    HeapAllocator heap_;
+};
+
+//------------------------------------------------------------------------------
+/// Caches freed blocks in power-of-two size classes, so repeated
+/// allocations of similar sizes are served without going to the upstream
+/// allocator. Blocks larger than max_bytes are not cached.
+/// Cached blocks are freed by release() or the destructor.
+/// Thread-safe.
+///
+/// @ingroup workspace
+class PoolAllocator: public Allocator
+{
+public:
+    /// @param[in] max_bytes
+    ///     Largest size class to cache; larger blocks go directly
+    ///     to upstream. Default 256 MiB.
+    /// @param[in] upstream
+    ///     Allocator for new blocks. If nullptr, uses the heap.
+    explicit PoolAllocator( size_t max_bytes = size_t(256)*1024*1024,
+                            Allocator* upstream = nullptr );
+
+    virtual ~PoolAllocator();
+
+    // Disable copying.
+    PoolAllocator( PoolAllocator const& ) = delete;
+    PoolAllocator& operator=( PoolAllocator const& ) = delete;
+
+    virtual void* allocate( size_t bytes, const char* routine ) override;
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept override;
+
+    /// Frees all cached blocks to upstream.
+    void release();
+
+    /// @return bytes in cached blocks.
+    size_t cached() const;
+
+private:
+    int size_class( size_t bytes ) const;
+
+    size_t max_bytes_;
+    Allocator* upstream_;
+    HeapAllocator heap_;
+    std::vector< std::vector< void* > > free_;  ///< free blocks per class
+    size_t cached_;
+    mutable std::mutex mutex_;
+};
+
+//------------------------------------------------------------------------------
+/// Forwards to an upstream allocator, counting allocations and bytes
+/// per LAPACK++ routine. The arena's buffer is counted under "arena",
+/// and workspace of unknown origin under "unknown".
+/// Thread-safe.
+///
+/// @ingroup workspace
+class CountingAllocator: public Allocator
+{
+public:
+    /// Counts for one routine.
+    struct Counts {
+        int64_t count;     ///< number of allocations
+        int64_t bytes;     ///< total bytes allocated
+        int64_t current;   ///< bytes currently allocated
+        int64_t peak;      ///< max of current
+    };
+
+    /// @param[in] upstream
+    ///     Allocator to forward to. If nullptr, uses the heap.
+    explicit CountingAllocator( Allocator* upstream = nullptr );
+
+    virtual void* allocate( size_t bytes, const char* routine ) override;
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept override;
+
+    /// @return counts per routine.
+    std::map< std::string, Counts > counts() const;
+
+    /// Prints a table of counts per routine.
+    void print( FILE* stream=stdout ) const;
+
+    /// Resets all counts to zero.
+    void reset();
+
+private:
+    Allocator* upstream_;
+    HeapAllocator heap_;
+
+    /// Counts keyed by the routine name pointer, to avoid building a string
+    /// per allocation; counts() merges equal names at different addresses.
+    std::map< const char*, Counts > counts_;
+
+    /// Counts of the routine owning each live block. Few blocks are live
+    /// at once, so a vector searched from the end, where the most recent
+    /// block is, is cheaper than a map.
+    std::vector< std::pair< void*, Counts* > > live_;
+
+    mutable std::mutex mutex_;
+};
+
+//------------------------------------------------------------------------------
+void set_allocator( Allocator* allocator );
+
+void set_thread_allocator( Allocator* allocator );
+
+Allocator* allocator();
+
+}  // namespace workspace
+}  // namespace lapack
+
+#endif // LAPACK_ALLOCATOR_HH
@@ -0,0 +1,376 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_ASYNC_HH
+#define LAPACK_ASYNC_HH
+
+#include "lapack/util.hh"
+#include "lapack/wrappers.hh"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace lapack {
+namespace async {
+
+//==============================================================================
+// Asynchronous host routines.
+//
+// lapack::async::foo( args..., queue ) enqueues lapack::foo( args... ) on
+// an async::Queue and returns immediately with a Future for its info.
+// Tasks on one queue run one at a time, in the order submitted; tasks on
+// different queues run concurrently on a library-managed pool of worker
+// threads, created on first use with lapack::get_num_threads() threads.
+// Any callable can be enqueued with Queue::submit.
+//
+// Arrays are referenced, not copied, so they must stay valid and must not
+// be modified until the task finishes. Exceptions, including
+// lapack::Error for invalid arguments, are rethrown by Future::get.
+// A task that has not started can be cancelled, either one task via
+// Future::cancel, or all of a queue's pending tasks via Queue::cancel.
+//
+// Tasks should not wait on futures from other queues: with fewer worker
+// threads than queues, that can deadlock.
+
+class Queue;
+
+namespace internal {
+
+struct QueueState;
+
+//------------------------------------------------------------------------------
+// State of one task, shared by its Future and the queue that runs it.
+class Task
+{
+public:
+    enum class Status { Pending, Running, Done, Cancelled };
+
+    Task(): status_( Status::Pending ) {}
+    virtual ~Task() {}
+
+    // Disable copying.
+    Task( Task const& ) = delete;
+    Task& operator=( Task const& ) = delete;
+
+    void run();
+    bool cancel();
+    void wait();
+    bool ready();
+    void rethrow();
+
+protected:
+    virtual void call() = 0;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    Status status_;
+    std::exception_ptr error_;
+};
+
+//------------------------------------------------------------------------------
+// Task with its result.
+template <typename T>
+class Result: public Task
+{
+public:
+    Result(): value_() {}
+    T get() { rethrow(); return value_; }
+
+protected:
+    T value_;
+};
+
+template <>
+class Result< void >: public Task
+{
+public:
+    void get() { rethrow(); }
+};
+
+//------------------------------------------------------------------------------
+// Task calling f().
+template <typename T, typename F>
+class Call: public Result< T >
+{
+public:
+    explicit Call( F&& f ): f_( std::move( f ) ) {}
+
+protected:
+    void call() override { this->value_ = f_(); }
+
+    F f_;
+};
+
+template <typename F>
+class Call< void, F >: public Result< void >
+{
+public:
+    explicit Call( F&& f ): f_( std::move( f ) ) {}
+
+protected:
+    void call() override { f_(); }
+
+    F f_;
+};
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Handle to the result of a task submitted to an async::Queue.
+/// Copies refer to the same task.
+/// @ingroup async
+template <typename T>
+class Future
+{
+public:
+    /// Constructs an invalid future, not referring to any task.
+    Future() {}
+
+    /// @return true if this refers to a task.
+    bool valid() const { return task_ != nullptr; }
+
+    /// @return true if the task finished or was cancelled, so get
+    /// won't block.
+    bool ready() const { return task_->ready(); }
+
+    /// Blocks until the task finishes or is cancelled.
+    void wait() const { task_->wait(); }
+
+    /// Cancels the task if it has not started.
+    /// @return true if cancelled; false if it already started.
+    bool cancel() { return task_->cancel(); }
+
+    /// Blocks until the task finishes, then returns its result.
+    /// Rethrows the task's exception, if any; throws lapack::Error if
+    /// the task was cancelled. Can be called more than once.
+    T get() { return task_->get(); }
+
+private:
+    friend class Queue;
+
+    explicit Future( std::shared_ptr< internal::Result< T > > task ):
+        task_( std::move( task ) )
+    {}
+
+    std::shared_ptr< internal::Result< T > > task_;
+};
+
+//------------------------------------------------------------------------------
+/// In-order execution queue for asynchronous host routines.
+/// Tasks on one queue run in submission order, one at a time;
+/// different queues share the library's worker threads.
+/// @ingroup async
+class Queue
+{
+public:
+    Queue();
+
+    /// Waits for submitted tasks to finish; doesn't cancel them.
+    ~Queue();
+
+    // Disable copying; must construct anew.
+    Queue( Queue const& ) = delete;
+    Queue& operator=( Queue const& ) = delete;
+
+    /// Submits f() to run after all tasks previously submitted to this
+    /// queue.
+    /// @return future for the result of f().
+    template <typename F>
+    Future< decltype( std::declval< F& >()() ) > submit( F f )
+    {
+        typedef decltype( std::declval< F& >()() ) T;
+        std::shared_ptr< internal::Result< T > > task
+            = std::make_shared< internal::Call< T, F > >( std::move( f ) );
+        enqueue( task );
+        return Future< T >( task );
+    }
+
+    /// Blocks until all tasks submitted so far finish or are cancelled.
+    /// Exceptions from tasks are reported only by their futures.
+    void sync();
+
+    /// Cancels all tasks that have not started.
+    /// @return number of tasks cancelled.
+    int64_t cancel();
+
+private:
+    void enqueue( std::shared_ptr< internal::Task > task );
+
+    std::shared_ptr< internal::QueueState > state_;
+};
+
+//------------------------------------------------------------------------------
+/// Asynchronous lapack::getrf.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::getrf( m, n, A, lda, ipiv );
+    });
+}
+
+/// Asynchronous lapack::getrs.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv,
+    scalar_t* B, int64_t ldb, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    });
+}
+
+/// Asynchronous lapack::gesv.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::gesv( n, nrhs, A, lda, ipiv, B, ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous lapack::potrf.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::potrf( uplo, n, A, lda );
+    });
+}
+
+/// Asynchronous lapack::potrs.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::potrs( uplo, n, nrhs, A, lda, B, ldb );
+    });
+}
+
+/// Asynchronous lapack::posv.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::posv( uplo, n, nrhs, A, lda, B, ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous lapack::geqrf.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > geqrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::geqrf( m, n, A, lda, tau );
+    });
+}
+
+/// Asynchronous lapack::gels.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::gels( trans, m, n, nrhs, A, lda, B, ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous lapack::gesdd.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt );
+    });
+}
+
+/// Asynchronous lapack::gesvd.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::gesvd( jobu, jobvt, m, n, A, lda, S,
+                              U, ldu, VT, ldvt );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous lapack::heevd.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W, Queue& queue )
+{
+    return queue.submit( [=]() {
+        return lapack::heevd( jobz, uplo, n, A, lda, W );
+    });
+}
+
+/// Asynchronous lapack::syevd, for real types; same as async::heevd.
+/// @ingroup async
+template <typename scalar_t>
+Future< int64_t > syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W, Queue& queue )
+{
+    return heevd( jobz, uplo, n, A, lda, W, queue );
+}
+
+}  // namespace async
+}  // namespace lapack
+
+#endif // LAPACK_ASYNC_HH
@@ -0,0 +1,384 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_BATCH_HH
+#define LAPACK_BATCH_HH
+
+#include "lapack/util.hh"
+
+#include <vector>
+
+namespace lapack {
+
+//==============================================================================
+// Batched routines, for many independent small problems on the CPU.
+//
+// As in BLAS++ batch routines, there are two variants:
+//
+// - Pointer-array: each option or dimension argument (m, n, lda, ...) is a
+//   vector with either 1 entry, used for all problems, or batch entries,
+//   one per problem. Arrays (Aarray, ipiv_array, ...) are vectors of
+//   batch pointers.
+//
+// - Strided: all problems have the same options and dimensions, and
+//   problem i's arrays are at A + i*strideA, ipiv + i*stride_ipiv, etc.
+//
+// - Grouped (some routines): problems are in groups, with group g having
+//   group_size[ g ] problems that share the same options and dimensions.
+//   Option and dimension vectors have one entry per group; arrays are
+//   vectors of pointers for all problems, numbered consecutively across
+//   groups. The batch size is the sum of group_size.
+//
+// Routines needing workspace query its size once per batch (once per
+// distinct set of dimensions, for pointer-array), then give each worker
+// thread one buffer that it reuses for all its problems.
+//
+// Problems are spread over LAPACK++'s thread pool (see set_num_threads),
+// with BLAS and LAPACK calls inside limited to one thread where the
+// library allows it. Arguments are checked for all problems before any
+// is computed; an invalid argument throws lapack::Error.
+// On output, info has batch entries: info[ i ] is the info that the
+// non-batched routine returns for problem i.
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::complex_type<scalar_t>* > const& Warray,
+    std::vector<scalar_t*> const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector<scalar_t*> const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::complex_type<scalar_t>* W, int64_t strideW,
+    scalar_t* VL, int64_t ldvl, int64_t strideVL,
+    scalar_t* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gels_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void gels_batch(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< blas::real_type<scalar_t>* > const& Sarray,
+    std::vector< blas::real_type<scalar_t> > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    blas::real_type<scalar_t>* S, int64_t strideS,
+    blas::real_type<scalar_t> rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& tau_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void geqrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesdd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Sarray,
+    std::vector<scalar_t*> const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector<scalar_t*> const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void gesdd_batch(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* S, int64_t strideS,
+    scalar_t* U, int64_t ldu, int64_t strideU,
+    scalar_t* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Sarray,
+    std::vector<scalar_t*> const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector<scalar_t*> const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* S, int64_t strideS,
+    scalar_t* U, int64_t ldu, int64_t strideU,
+    scalar_t* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void getrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+// For real scalar_t, calls syevd.
+template <typename scalar_t>
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info );
+
+// syevd_batch alias to heevd_batch
+template <typename scalar_t>
+inline void syevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    size_t batch, std::vector<int64_t>& info )
+{
+    heevd_batch( jobz, uplo, n, Aarray, lda, Warray, batch, info );
+}
+
+template <typename scalar_t>
+inline void syevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info )
+{
+    heevd_batch( jobz, uplo, n, A, lda, strideA, W, strideW, batch, info );
+}
+
+//------------------------------------------------------------------------------
+// For real scalar_t, calls syevr.
+template <typename scalar_t>
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t> > const& vl,
+    std::vector< blas::real_type<scalar_t> > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< blas::real_type<scalar_t> > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    std::vector<scalar_t*> const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    std::vector<int64_t>& nfound,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    scalar_t* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info );
+
+// syevr_batch alias to heevr_batch
+template <typename scalar_t>
+inline void syevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t> > const& vl,
+    std::vector< blas::real_type<scalar_t> > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< blas::real_type<scalar_t> > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    std::vector<scalar_t*> const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info )
+{
+    heevr_batch( jobz, range, uplo, n, Aarray, lda, vl, vu, il, iu, abstol,
+                 nfound, Warray, Zarray, ldz, isuppz_array, batch, info );
+}
+
+template <typename scalar_t>
+inline void syevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    std::vector<int64_t>& nfound,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    scalar_t* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info )
+{
+    heevr_batch( jobz, range, uplo, n, A, lda, strideA, vl, vu, il, iu,
+                 abstol, nfound, W, strideW, Z, ldz, strideZ,
+                 isuppz, stride_isuppz, batch, info );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potri_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potri_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template <typename scalar_t>
+void potri_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
+
+#endif // LAPACK_BATCH_HH
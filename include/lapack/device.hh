@@ -13,6 +13,23 @@
     #include <cusolverDn.h>
 #endif
 
+// Without a GPU library, lapack::Queue is a host device: it runs device
+// routines asynchronously, in order, on a worker thread that it owns, and
+// "device" memory is host memory.
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) \
+       || defined(LAPACK_HAVE_ONEMKL))
+    #define LAPACK_HAVE_HOST_DEVICE
+
+    #include <condition_variable>
+    #include <cstdlib>
+    #include <cstring>
+    #include <deque>
+    #include <exception>
+    #include <functional>
+    #include <mutex>
+    #include <thread>
+#endif
+
 namespace lapack {
 
 // Since we pass pointers to these integers, their types have to match
@@ -40,11 +57,20 @@ class Queue: public blas::Queue
 public:
     Queue( int device=-1, int64_t batch_size=30000 )
       : blas::Queue( device, batch_size )
+        , dev_workspace_( nullptr )
+        , host_workspace_( nullptr )
+        , dev_workspace_size_( 0 )
+        , host_workspace_size_( 0 )
+        , dev_workspace_peak_( 0 )
+        , host_workspace_peak_( 0 )
         #if defined(LAPACK_HAVE_CUBLAS)
             , solver_( nullptr )
             #if CUSOLVER_VERSION >= 11000
                 , solver_params_( nullptr )
             #endif
+        #elif defined(LAPACK_HAVE_HOST_DEVICE)
+            , busy_( false )
+            , stop_( false )
         #endif
     {}
 
@@ -63,7 +89,10 @@ public:
                 cusolverDnDestroy( solver_ );
                 solver_ = nullptr;
             }
+        #elif defined(LAPACK_HAVE_HOST_DEVICE)
+            host_stop();
         #endif
+        workspace_free();
     }
 
     // Disable copying; must construct anew.
@@ -102,17 +131,183 @@ public:
                 return solver_params_;
             }
         #endif
+    #elif defined(LAPACK_HAVE_HOST_DEVICE)
+        /// Enqueues task to run asynchronously on the queue's worker thread,
+        /// after all tasks enqueued before it. The worker thread is started
+        /// on first use.
+        void enqueue( std::function< void () > task );
+
+        /// Blocks until all enqueued tasks finish. If a task threw, the
+        /// first exception is rethrown here, and is then cleared.
+        /// This hides blas::Queue::sync, so it must be called on a
+        /// lapack::Queue, not via a blas::Queue reference.
+        void sync();
     #endif
 
+    //----------------------------------------
+    // Workspace pool, used by device routines called without workspace
+    // arguments. It is reused across calls and grows as needed. Growing
+    // or releasing it first syncs the queue, as tasks in flight may
+    // still use it.
+
+    /// Grows the workspace pool to at least dev_size bytes of device
+    /// memory and host_size bytes of pinned host memory.
+    void workspace_reserve( size_t dev_size, size_t host_size );
+
+    /// Frees the workspace pool. Peak sizes are kept.
+    void workspace_release();
+
+    /// @return device workspace in the pool; null if its size is 0.
+    void* dev_workspace() { return dev_workspace_; }
+
+    /// @return pinned host workspace in the pool; null if its size is 0.
+    void* host_workspace() { return host_workspace_; }
+
+    /// @return size in bytes of device workspace in the pool.
+    size_t dev_workspace_size() const { return dev_workspace_size_; }
+
+    /// @return size in bytes of host workspace in the pool.
+    size_t host_workspace_size() const { return host_workspace_size_; }
+
+    /// @return largest device workspace, in bytes, reserved so far.
+    size_t dev_workspace_peak() const { return dev_workspace_peak_; }
+
+    /// @return largest host workspace, in bytes, reserved so far.
+    size_t host_workspace_peak() const { return host_workspace_peak_; }
+
 private:
+    void workspace_free();
+
+    void*  dev_workspace_;
+    void*  host_workspace_;
+    size_t dev_workspace_size_;
+    size_t host_workspace_size_;
+    size_t dev_workspace_peak_;
+    size_t host_workspace_peak_;
+
     #if defined(LAPACK_HAVE_CUBLAS)
         cusolverDnHandle_t solver_;
         #if CUSOLVER_VERSION >= 11000
             cusolverDnParams_t solver_params_;
         #endif
+    #elif defined(LAPACK_HAVE_HOST_DEVICE)
+        void host_run();
+        void host_stop();
+
+        std::thread worker_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque< std::function< void () > > tasks_;
+        std::exception_ptr error_;
+        bool busy_;
+        bool stop_;
     #endif
 };
 
+//------------------------------------------------------------------------------
+// Device memory management and copies that also work on the host device,
+// where blas::device_malloc, etc. are not available. With a GPU library,
+// these call the BLAS++ versions. As in BLAS++, copies are async on the
+// queue; device_free first syncs the queue on the host device, as
+// cudaFree does on a GPU.
+
+/// @return number of devices; 1 for the host device.
+inline int get_device_count()
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        return 1;
+    #else
+        return blas::get_device_count();
+    #endif
+}
+
+/// @return array of nelements of type T in device memory.
+template <typename T>
+T* device_malloc( int64_t nelements, lapack::Queue& queue )
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        lapack_error_if( nelements < 0 );
+        if (nelements == 0)
+            return nullptr;
+        T* ptr = (T*) std::malloc( nelements * sizeof(T) );
+        if (ptr == nullptr)
+            throw Error( "device memory allocation failed", __func__ );
+        return ptr;
+    #else
+        return blas::device_malloc< T >( nelements );
+    #endif
+}
+
+/// Frees device memory allocated by device_malloc.
+template <typename T>
+void device_free( T* ptr, lapack::Queue& queue )
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        // tasks in flight may still reference ptr
+        queue.sync();
+        std::free( ptr );
+    #else
+        blas::device_free( ptr );
+    #endif
+}
+
+/// Copies nelements from src to dst, either of which may be on the device.
+template <typename T>
+void device_memcpy(
+    T* dst, T const* src, int64_t nelements, lapack::Queue& queue )
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        lapack_error_if( nelements < 0 );
+        queue.enqueue( [=]() {
+            std::memcpy( dst, src, nelements * sizeof(T) );
+        });
+    #else
+        blas::device_memcpy( dst, src, nelements, queue );
+    #endif
+}
+
+/// Copies m-by-n matrix from host A to device dA.
+template <typename T>
+void device_setmatrix(
+    int64_t m, int64_t n,
+    T const* A, int64_t lda,
+    T* dA, int64_t ldda, lapack::Queue& queue )
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        lapack_error_if( m < 0 );
+        lapack_error_if( n < 0 );
+        lapack_error_if( lda < m );
+        lapack_error_if( ldda < m );
+        queue.enqueue( [=]() {
+            for (int64_t j = 0; j < n; ++j)
+                std::memcpy( &dA[ j*ldda ], &A[ j*lda ], m * sizeof(T) );
+        });
+    #else
+        blas::device_setmatrix( m, n, A, lda, dA, ldda, queue );
+    #endif
+}
+
+/// Copies m-by-n matrix from device dA to host A.
+template <typename T>
+void device_getmatrix(
+    int64_t m, int64_t n,
+    T const* dA, int64_t ldda,
+    T* A, int64_t lda, lapack::Queue& queue )
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        lapack_error_if( m < 0 );
+        lapack_error_if( n < 0 );
+        lapack_error_if( ldda < m );
+        lapack_error_if( lda < m );
+        queue.enqueue( [=]() {
+            for (int64_t j = 0; j < n; ++j)
+                std::memcpy( &A[ j*lda ], &dA[ j*ldda ], m * sizeof(T) );
+        });
+    #else
+        blas::device_getmatrix( m, n, dA, ldda, A, lda, queue );
+    #endif
+}
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void potrf(
@@ -136,6 +331,21 @@ void getrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue );
 
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    getrf_work_size_bytes( m, n, dA, ldda, &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    getrf( m, n, dA, ldda, dev_ipiv,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void geqrf_work_size_bytes(
@@ -152,6 +362,335 @@ void geqrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue );
 
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, scalar_t* dtau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    geqrf_work_size_bytes( m, n, dA, ldda, &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    geqrf( m, n, dA, ldda, dtau,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Solve using the Cholesky factor from potrf.
+template <typename scalar_t>
+void potrs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    potrs_work_size_bytes( uplo, n, nrhs, (scalar_t*) dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    potrs( uplo, n, nrhs, dA, ldda, dB, lddb,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Solve using the LU factors and pivots from getrf.
+template <typename scalar_t>
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    getrs_work_size_bytes( trans, n, nrhs, (scalar_t*) dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    getrs( trans, n, nrhs, dA, ldda, dev_ipiv, dB, lddb,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Multiply by Q from geqrf. For real scalar_t, ConjTrans is Trans.
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda, scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda, scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    unmqr_work_size_bytes( side, trans, m, n, k, (scalar_t*) dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    unmqr( side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+// ormqr alias to unmqr
+template <typename scalar_t>
+inline void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    unmqr_work_size_bytes( side, trans, m, n, k, dA, ldda,
+                           dev_work_size, host_work_size, queue );
+}
+
+template <typename scalar_t>
+inline void ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda, scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    unmqr( side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+           dev_work, dev_work_size, host_work, host_work_size,
+           dev_info, queue );
+}
+
+template <typename scalar_t>
+inline void ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda, scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    unmqr( side, trans, m, n, k, dA, ldda, dtau, dC, lddc, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Generate Q from geqrf.
+template <typename scalar_t>
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda, scalar_t const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda, scalar_t const* dtau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    ungqr_work_size_bytes( m, n, k, dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    ungqr( m, n, k, dA, ldda, dtau,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+// orgqr alias to ungqr
+template <typename scalar_t>
+inline void orgqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    ungqr_work_size_bytes( m, n, k, dA, ldda,
+                           dev_work_size, host_work_size, queue );
+}
+
+template <typename scalar_t>
+inline void orgqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda, scalar_t const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    ungqr( m, n, k, dA, ldda, dtau,
+           dev_work, dev_work_size, host_work, host_work_size,
+           dev_info, queue );
+}
+
+template <typename scalar_t>
+inline void orgqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda, scalar_t const* dtau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    ungqr( m, n, k, dA, ldda, dtau, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Hermitian (symmetric) eigenvalues, divide and conquer.
+template <typename scalar_t>
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    heevd_work_size_bytes( jobz, uplo, n, dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    heevd( jobz, uplo, n, dA, ldda, dW,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
+// syevd alias to heevd
+template <typename scalar_t>
+inline void syevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    heevd_work_size_bytes( jobz, uplo, n, dA, ldda,
+                           dev_work_size, host_work_size, queue );
+}
+
+template <typename scalar_t>
+inline void syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    heevd( jobz, uplo, n, dA, ldda, dW,
+           dev_work, dev_work_size, host_work, host_work_size,
+           dev_info, queue );
+}
+
+template <typename scalar_t>
+inline void syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    heevd( jobz, uplo, n, dA, ldda, dW, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Singular value decomposition.
+// With cuSolver, requires m >= n, and jobu, jobvt in { AllVec, SomeVec,
+// NoVec } or OverwriteVec for at most one of them.
+template <typename scalar_t>
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dS,
+    scalar_t* dU, int64_t lddu,
+    scalar_t* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+/// Same, using the queue's workspace pool.
+template <typename scalar_t>
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dS,
+    scalar_t* dU, int64_t lddu,
+    scalar_t* dVT, int64_t lddvt,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_size, host_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, dA, ldda,
+                           &dev_size, &host_size, queue );
+    queue.workspace_reserve( dev_size, host_size );
+    gesvd( jobu, jobvt, m, n, dA, ldda, dS, dU, lddu, dVT, lddvt,
+           queue.dev_workspace(), dev_size,
+           queue.host_workspace(), host_size, dev_info, queue );
+}
+
 }  // namespace lapack
 
 #endif // LAPACK_DEVICE_HH
@@ -0,0 +1,661 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_FIXED_HH
+#define LAPACK_FIXED_HH
+
+#include "lapack/util.hh"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+// LAPACK_FIXED_UNROLL precedes loops with compile-time trip counts,
+// asking the compiler to unroll them completely.
+#if defined( __clang__ )
+    #define LAPACK_FIXED_UNROLL _Pragma( "clang loop unroll(full)" )
+#elif defined( __GNUC__ ) && __GNUC__ >= 8
+    #define LAPACK_FIXED_UNROLL _Pragma( "GCC unroll 64" )
+#else
+    #define LAPACK_FIXED_UNROLL
+#endif
+
+namespace lapack {
+
+//==============================================================================
+/// Native C++ kernels for matrices whose size N is known at compile time,
+/// such as 3x3, 4x4, 6x6, or 8x8 systems.
+///
+/// Each routine copies the matrix to a local N-by-N array, works on it
+/// with loops whose trip counts are compile-time constants, which the
+/// compiler unrolls completely and keeps in registers, and copies the
+/// result back. Nothing is allocated and no LAPACK routine is called,
+/// so for tiny N they are much faster than the generic wrappers, or even
+/// lapack::tiny, which still pays for the Fortran call and the blocked
+/// algorithm's setup.
+///
+/// Arguments and info codes are the same as the generic routines, minus
+/// the dimension N, which is the first template argument:
+///
+///     #include "lapack/fixed.hh"
+///
+///     double A[ 16 ], b[ 4 ];
+///     int64_t ipiv[ 4 ];
+///     int64_t info = lapack::fixed::getrf<4>( A, 4, ipiv );
+///     lapack::fixed::getrs<4>( lapack::Op::NoTrans, 1, A, 4, ipiv, b, 4 );
+///
+/// getrf uses unblocked right-looking LU and potrf unblocked left-looking
+/// Cholesky; pivots are chosen as in LAPACK, so results match the generic
+/// routines up to rounding. heev uses cyclic Jacobi, which for small N is
+/// both faster and more accurate than tridiagonal reduction.
+///
+/// These are meant for N up to about 16; larger N works, but unrolling
+/// bloats code, and the generic routines win.
+///
+/// @ingroup fixed
+namespace fixed {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+// |Re(x)| + |Im(x)|, as used by LAPACK's i?amax for pivoting.
+template <typename real_t>
+inline real_t abs1( real_t x )
+{
+    return std::abs( x );
+}
+
+template <typename real_t>
+inline real_t abs1( std::complex<real_t> x )
+{
+    return std::abs( x.real() ) + std::abs( x.imag() );
+}
+
+//------------------------------------------------------------------------------
+// Copies an N-by-N matrix between A, with leading dimension lda,
+// and a local array a, with leading dimension N.
+template <int64_t N, typename scalar_t>
+inline void load( scalar_t const* A, int64_t lda, scalar_t* a )
+{
+    LAPACK_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            a[ i + j*N ] = A[ i + j*lda ];
+    }
+}
+
+template <int64_t N, typename scalar_t>
+inline void store( scalar_t const* a, scalar_t* A, int64_t lda )
+{
+    LAPACK_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            A[ i + j*lda ] = a[ i + j*N ];
+    }
+}
+
+//------------------------------------------------------------------------------
+// Solves op(T) x = b for one column x, with the N-by-N triangular T in the
+// local array a, as in trsv.
+template <int64_t N, typename scalar_t>
+inline void trsv(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag,
+    scalar_t const* a, scalar_t* x )
+{
+    bool nounit = (diag == Diag::NonUnit);
+    if (trans == Op::NoTrans) {
+        if (uplo == Uplo::Upper) {
+            LAPACK_FIXED_UNROLL
+            for (int64_t j = N-1; j >= 0; --j) {
+                if (nounit)
+                    x[ j ] /= a[ j + j*N ];
+                LAPACK_FIXED_UNROLL
+                for (int64_t i = 0; i < j; ++i)
+                    x[ i ] -= x[ j ] * a[ i + j*N ];
+            }
+        }
+        else {
+            LAPACK_FIXED_UNROLL
+            for (int64_t j = 0; j < N; ++j) {
+                if (nounit)
+                    x[ j ] /= a[ j + j*N ];
+                LAPACK_FIXED_UNROLL
+                for (int64_t i = j+1; i < N; ++i)
+                    x[ i ] -= x[ j ] * a[ i + j*N ];
+            }
+        }
+    }
+    else {
+        // op(T) = T^T or T^H: dot products down columns of T
+        bool conj = (trans == Op::ConjTrans);
+        auto t = [&]( int64_t i, int64_t j ) {
+            return conj ? blas::conj( a[ i + j*N ] ) : a[ i + j*N ];
+        };
+        if (uplo == Uplo::Upper) {
+            LAPACK_FIXED_UNROLL
+            for (int64_t j = 0; j < N; ++j) {
+                scalar_t sum = x[ j ];
+                LAPACK_FIXED_UNROLL
+                for (int64_t i = 0; i < j; ++i)
+                    sum -= t( i, j ) * x[ i ];
+                x[ j ] = (nounit ? sum / t( j, j ) : sum);
+            }
+        }
+        else {
+            LAPACK_FIXED_UNROLL
+            for (int64_t j = N-1; j >= 0; --j) {
+                scalar_t sum = x[ j ];
+                LAPACK_FIXED_UNROLL
+                for (int64_t i = j+1; i < N; ++i)
+                    sum -= t( i, j ) * x[ i ];
+                x[ j ] = (nounit ? sum / t( j, j ) : sum);
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Computes an LU factorization of an N-by-N matrix, with partial pivoting;
+/// see lapack::getrf.
+///
+/// @tparam N
+///     Order of A, a compile-time constant.
+///
+/// @param[in,out] A
+///     The N-by-N matrix A, stored in an lda-by-N array.
+///     On exit, the factors L and U; the unit diagonal of L is not stored.
+///
+/// @param[in] lda
+///     Leading dimension of A; lda >= max(1, N).
+///
+/// @param[out] ipiv
+///     The pivot indices, of length N, either int64_t or lapack_int.
+///     Row i was interchanged with row ipiv(i). Indices are 1-based.
+///
+/// @return = 0: successful exit.
+/// @return i > 0: U(i, i) is exactly zero. The factorization has been
+///     completed, but U is singular.
+///
+/// @ingroup fixed
+template <int64_t N, typename scalar_t, typename ipiv_t>
+inline int64_t getrf(
+    scalar_t* A, int64_t lda,
+    ipiv_t* ipiv )
+{
+    static_assert( N > 0, "N must be positive" );
+    lapack_error_if( lda < N );
+
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    scalar_t a[ N*N ];
+    internal::load<N>( A, lda, a );
+
+    int64_t info = 0;
+    LAPACK_FIXED_UNROLL
+    for (int64_t k = 0; k < N; ++k) {
+        // find pivot: first entry of largest |Re| + |Im|
+        int64_t piv = k;
+        auto amax = internal::abs1( a[ k + k*N ] );
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = k+1; i < N; ++i) {
+            auto ai = internal::abs1( a[ i + k*N ] );
+            if (ai > amax) {
+                amax = ai;
+                piv = i;
+            }
+        }
+        ipiv[ k ] = ipiv_t( piv + 1 );
+
+        if (a[ piv + k*N ] != zero) {
+            if (piv != k) {
+                LAPACK_FIXED_UNROLL
+                for (int64_t j = 0; j < N; ++j)
+                    std::swap( a[ k + j*N ], a[ piv + j*N ] );
+            }
+            scalar_t inv = one / a[ k + k*N ];
+            LAPACK_FIXED_UNROLL
+            for (int64_t i = k+1; i < N; ++i)
+                a[ i + k*N ] *= inv;
+        }
+        else if (info == 0) {
+            info = k + 1;
+        }
+
+        // rank-1 update of trailing matrix
+        LAPACK_FIXED_UNROLL
+        for (int64_t j = k+1; j < N; ++j) {
+            LAPACK_FIXED_UNROLL
+            for (int64_t i = k+1; i < N; ++i)
+                a[ i + j*N ] -= a[ i + k*N ] * a[ k + j*N ];
+        }
+    }
+
+    internal::store<N>( a, A, lda );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Solves op(A) X = B, using the LU factorization from fixed::getrf;
+/// see lapack::getrs.
+///
+/// @tparam N
+///     Order of A, a compile-time constant.
+///
+/// @param[in] trans
+///     The form of op(A): NoTrans, Trans, or ConjTrans.
+///
+/// @param[in] nrhs
+///     Number of columns of B.
+///
+/// @param[in] A
+///     The factors L and U from fixed::getrf, in an lda-by-N array.
+///
+/// @param[in] lda
+///     Leading dimension of A; lda >= max(1, N).
+///
+/// @param[in] ipiv
+///     The pivot indices from fixed::getrf.
+///
+/// @param[in,out] B
+///     The N-by-nrhs matrix B, in an ldb-by-nrhs array.
+///     On exit, the solution X.
+///
+/// @param[in] ldb
+///     Leading dimension of B; ldb >= max(1, N).
+///
+/// @return = 0: successful exit.
+///
+/// @ingroup fixed
+template <int64_t N, typename scalar_t, typename ipiv_t>
+inline int64_t getrs(
+    lapack::Op trans, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    ipiv_t const* ipiv,
+    scalar_t* B, int64_t ldb )
+{
+    static_assert( N > 0, "N must be positive" );
+    lapack_error_if( trans != Op::NoTrans && trans != Op::Trans
+                     && trans != Op::ConjTrans );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < N );
+    lapack_error_if( ldb < N );
+
+    scalar_t a[ N*N ];
+    internal::load<N>( A, lda, a );
+
+    for (int64_t j = 0; j < nrhs; ++j) {
+        scalar_t x[ N ];
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            x[ i ] = B[ i + j*ldb ];
+
+        if (trans == Op::NoTrans) {
+            // solve L U x = P^T b
+            LAPACK_FIXED_UNROLL
+            for (int64_t i = 0; i < N; ++i)
+                std::swap( x[ i ], x[ ipiv[ i ] - 1 ] );
+            internal::trsv<N>( Uplo::Lower, Op::NoTrans, Diag::Unit, a, x );
+            internal::trsv<N>( Uplo::Upper, Op::NoTrans, Diag::NonUnit, a, x );
+        }
+        else {
+            // solve U^T L^T P^T x = b, or with ^H
+            internal::trsv<N>( Uplo::Upper, trans, Diag::NonUnit, a, x );
+            internal::trsv<N>( Uplo::Lower, trans, Diag::Unit, a, x );
+            LAPACK_FIXED_UNROLL
+            for (int64_t i = N-1; i >= 0; --i)
+                std::swap( x[ i ], x[ ipiv[ i ] - 1 ] );
+        }
+
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            B[ i + j*ldb ] = x[ i ];
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Computes the Cholesky factorization of an N-by-N Hermitian positive
+/// definite matrix; see lapack::potrf.
+///
+/// @tparam N
+///     Order of A, a compile-time constant.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in,out] A
+///     The N-by-N Hermitian matrix A, stored in an lda-by-N array.
+///     On successful exit, the factor U or L, with A = U^H U or A = L L^H.
+///     The other triangle is not referenced.
+///
+/// @param[in] lda
+///     Leading dimension of A; lda >= max(1, N).
+///
+/// @return = 0: successful exit.
+/// @return i > 0: the leading minor of order i is not positive definite,
+///     and the factorization could not be completed.
+///
+/// @ingroup fixed
+template <int64_t N, typename scalar_t>
+inline int64_t potrf(
+    lapack::Uplo uplo,
+    scalar_t* A, int64_t lda )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    static_assert( N > 0, "N must be positive" );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( lda < N );
+
+    // Work on the lower triangle; for Upper, a holds U^H.
+    bool lower = (uplo == Uplo::Lower);
+    scalar_t a[ N*N ];
+    LAPACK_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = j; i < N; ++i) {
+            a[ i + j*N ] = lower ? A[ i + j*lda ]
+                                 : blas::conj( A[ j + i*lda ] );
+        }
+    }
+
+    int64_t info = 0;
+    LAPACK_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        // left-looking, as in potf2
+        real_t ajj = std::real( a[ j + j*N ] );
+        LAPACK_FIXED_UNROLL
+        for (int64_t k = 0; k < j; ++k)
+            ajj -= std::real( a[ j + k*N ] * blas::conj( a[ j + k*N ] ) );
+        // also catches NaN
+        if (! (ajj > 0)) {
+            a[ j + j*N ] = ajj;
+            info = j + 1;
+            break;
+        }
+        ajj = std::sqrt( ajj );
+        a[ j + j*N ] = ajj;
+        real_t inv = 1 / ajj;
+
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = j+1; i < N; ++i) {
+            scalar_t sum = a[ i + j*N ];
+            LAPACK_FIXED_UNROLL
+            for (int64_t k = 0; k < j; ++k)
+                sum -= a[ i + k*N ] * blas::conj( a[ j + k*N ] );
+            a[ i + j*N ] = sum * inv;
+        }
+    }
+
+    // As in LAPACK, columns after a failure are left unchanged.
+    int64_t ncols = (info == 0 ? N : info);
+    for (int64_t j = 0; j < ncols; ++j) {
+        for (int64_t i = j; i < N; ++i) {
+            if (lower)
+                A[ i + j*lda ] = a[ i + j*N ];
+            else
+                A[ j + i*lda ] = blas::conj( a[ i + j*N ] );
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Solves A X = B, using the Cholesky factorization from fixed::potrf;
+/// see lapack::potrs.
+///
+/// @tparam N
+///     Order of A, a compile-time constant.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: A = U^H U, with U in the upper triangle;
+///     - lapack::Uplo::Lower: A = L L^H, with L in the lower triangle.
+///
+/// @param[in] nrhs
+///     Number of columns of B.
+///
+/// @param[in] A
+///     The factor U or L from fixed::potrf, in an lda-by-N array.
+///
+/// @param[in] lda
+///     Leading dimension of A; lda >= max(1, N).
+///
+/// @param[in,out] B
+///     The N-by-nrhs matrix B, in an ldb-by-nrhs array.
+///     On exit, the solution X.
+///
+/// @param[in] ldb
+///     Leading dimension of B; ldb >= max(1, N).
+///
+/// @return = 0: successful exit.
+///
+/// @ingroup fixed
+template <int64_t N, typename scalar_t>
+inline int64_t potrs(
+    lapack::Uplo uplo, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    static_assert( N > 0, "N must be positive" );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < N );
+    lapack_error_if( ldb < N );
+
+    // A is triangular, so copying the whole array is harmless.
+    scalar_t a[ N*N ];
+    internal::load<N>( A, lda, a );
+
+    // solve L L^H x = b, or U^H U x = b
+    Op trans1 = (uplo == Uplo::Lower ? Op::NoTrans   : Op::ConjTrans);
+    Op trans2 = (uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans);
+    for (int64_t j = 0; j < nrhs; ++j) {
+        scalar_t x[ N ];
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            x[ i ] = B[ i + j*ldb ];
+
+        internal::trsv<N>( uplo, trans1, Diag::NonUnit, a, x );
+        internal::trsv<N>( uplo, trans2, Diag::NonUnit, a, x );
+
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i)
+            B[ i + j*ldb ] = x[ i ];
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of an N-by-N
+/// Hermitian matrix, using cyclic Jacobi; see lapack::heev.
+/// For real matrices, this is also fixed::syev.
+///
+/// Sweeps rotate every off-diagonal pair (p, q) until
+/// |A(p, q)| <= eps sqrt( |A(p, p) A(q, q)| ) for all pairs, which gives
+/// eigenvalues with high relative accuracy.
+///
+/// @tparam N
+///     Order of A, a compile-time constant.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in,out] A
+///     The N-by-N Hermitian matrix A, stored in an lda-by-N array.
+///     On exit, if jobz = Vec, the orthonormal eigenvectors of A;
+///     if jobz = NoVec, the stored triangle of A is destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of A; lda >= max(1, N).
+///
+/// @param[out] W
+///     The N eigenvalues, in ascending order.
+///
+/// @return = 0: successful exit.
+/// @return i > 0: the algorithm failed to converge (as for NaN input);
+///     i off-diagonal elements had not converged to zero.
+///
+/// @ingroup fixed
+template <int64_t N, typename scalar_t>
+inline int64_t heev(
+    lapack::Job jobz, lapack::Uplo uplo,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    static_assert( N > 0, "N must be positive" );
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( lda < N );
+
+    const int max_sweeps = 50;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const real_t safe_min = std::numeric_limits<real_t>::min();
+    bool wantz = (jobz == Job::Vec);
+
+    // full Hermitian copy of A, and V = I
+    scalar_t a[ N*N ], v[ N*N ];
+    bool lower = (uplo == Uplo::Lower);
+    LAPACK_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        a[ j + j*N ] = std::real( A[ j + j*lda ] );
+        v[ j + j*N ] = 1;
+        LAPACK_FIXED_UNROLL
+        for (int64_t i = j+1; i < N; ++i) {
+            scalar_t aij = lower ? A[ i + j*lda ]
+                                 : blas::conj( A[ j + i*lda ] );
+            a[ i + j*N ] = aij;
+            a[ j + i*N ] = blas::conj( aij );
+            v[ i + j*N ] = 0;
+            v[ j + i*N ] = 0;
+        }
+    }
+
+    int64_t info = 0;
+    for (int sweep = 0; sweep <= max_sweeps; ++sweep) {
+        // count unconverged pairs; on the last pass, just count
+        info = 0;
+        LAPACK_FIXED_UNROLL
+        for (int64_t p = 0; p < N-1; ++p) {
+            LAPACK_FIXED_UNROLL
+            for (int64_t q = p+1; q < N; ++q) {
+                scalar_t apq = a[ p + q*N ];
+                real_t abs_apq = std::abs( apq );
+                real_t app = std::real( a[ p + p*N ] );
+                real_t aqq = std::real( a[ q + q*N ] );
+                if (abs_apq <= eps * std::sqrt( std::abs( app * aqq ) )
+                    || abs_apq < safe_min)
+                    continue;
+                ++info;
+                if (sweep == max_sweeps)
+                    continue;
+
+                // Rotation J = [ c, s; -conj(e) s, conj(e) c ], with
+                // e = apq / |apq|, zeros A(p, q) in J^H A J.
+                scalar_t e = apq / abs_apq;
+                real_t theta = (aqq - app) / (2 * abs_apq);
+                real_t t = 1 / (std::abs( theta )
+                                + std::sqrt( theta*theta + 1 ));
+                if (theta < 0)
+                    t = -t;
+                real_t c = 1 / std::sqrt( t*t + 1 );
+                real_t s = t * c;
+                scalar_t es  = e * s;
+                scalar_t ce  = blas::conj( e );
+
+                // A = A J, columns p and q
+                LAPACK_FIXED_UNROLL
+                for (int64_t k = 0; k < N; ++k) {
+                    scalar_t akp = a[ k + p*N ];
+                    scalar_t akq = a[ k + q*N ];
+                    a[ k + p*N ] = c*akp - ce*s*akq;
+                    a[ k + q*N ] = s*akp + ce*c*akq;
+                }
+                // A = J^H A, rows p and q
+                LAPACK_FIXED_UNROLL
+                for (int64_t k = 0; k < N; ++k) {
+                    scalar_t apk = a[ p + k*N ];
+                    scalar_t aqk = a[ q + k*N ];
+                    a[ p + k*N ] = c*apk - es*aqk;
+                    a[ q + k*N ] = s*apk + e*c*aqk;
+                }
+                a[ p + p*N ] = app - t*abs_apq;
+                a[ q + q*N ] = aqq + t*abs_apq;
+                a[ p + q*N ] = 0;
+                a[ q + p*N ] = 0;
+
+                if (wantz) {
+                    // V = V J
+                    LAPACK_FIXED_UNROLL
+                    for (int64_t k = 0; k < N; ++k) {
+                        scalar_t vkp = v[ k + p*N ];
+                        scalar_t vkq = v[ k + q*N ];
+                        v[ k + p*N ] = c*vkp - ce*s*vkq;
+                        v[ k + q*N ] = s*vkp + ce*c*vkq;
+                    }
+                }
+            }
+        }
+        if (info == 0)
+            break;
+    }
+
+    // sort eigenvalues ascending, with eigenvectors, by selection sort
+    LAPACK_FIXED_UNROLL
+    for (int64_t i = 0; i < N; ++i)
+        W[ i ] = std::real( a[ i + i*N ] );
+    LAPACK_FIXED_UNROLL
+    for (int64_t i = 0; i < N-1; ++i) {
+        int64_t k = i;
+        LAPACK_FIXED_UNROLL
+        for (int64_t j = i+1; j < N; ++j) {
+            if (W[ j ] < W[ k ])
+                k = j;
+        }
+        if (k != i) {
+            std::swap( W[ i ], W[ k ] );
+            if (wantz) {
+                LAPACK_FIXED_UNROLL
+                for (int64_t r = 0; r < N; ++r)
+                    std::swap( v[ r + i*N ], v[ r + k*N ] );
+            }
+        }
+    }
+
+    if (wantz)
+        internal::store<N>( v, A, lda );
+    else
+        internal::store<N>( a, A, lda );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Symmetric eigenvalue problem; alias to fixed::heev.
+/// @ingroup fixed
+template <int64_t N, typename scalar_t>
+inline int64_t syev(
+    lapack::Job jobz, lapack::Uplo uplo,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W )
+{
+    return heev<N>( jobz, uplo, A, lda, W );
+}
+
+}  // namespace fixed
+}  // namespace lapack
+
+#endif // LAPACK_FIXED_HH
@@ -324,6 +324,53 @@ template< typename T >
 class Gbyte:
     public blas::Gbyte<T>
 {
+public:
+    // Copies read and write each element in the part of the m-by-n
+    // matrix given by matrixtype; laset only writes.
+    static double lacpy(lapack::MatrixType matrixtype, double m, double n)
+        { return 2 * laset( matrixtype, m, n ); }
+
+    static double lascl(lapack::MatrixType matrixtype, double m, double n)
+        { return lacpy( matrixtype, m, n ); }
+
+    static double laset(lapack::MatrixType matrixtype, double m, double n)
+    {
+        if (matrixtype == lapack::MatrixType::Upper)
+            return lantr( lapack::Uplo::Upper, m, n );
+        else if (matrixtype == lapack::MatrixType::Lower)
+            return lantr( lapack::Uplo::Lower, m, n );
+        else
+            return lange( m, n );
+    }
+
+    // Norms read each referenced element once.
+    static double lange(double m, double n)
+        { return 1e-9 * (m*n * sizeof(T)); }
+
+    static double lanhe(double n)
+        { return 1e-9 * (0.5*n*(n+1) * sizeof(T)); }
+
+    static double lansy(double n)
+        { return lanhe( n ); }
+
+    // Permutations read and write each element once.
+    static double lapmr(double m, double n)
+        { return 1e-9 * (2*m*n * sizeof(T)); }
+
+    static double lapmt(double m, double n)
+        { return lapmr( m, n ); }
+
+    // k interchanges, each reading and writing two rows of n elements.
+    static double laswp(double n, double k)
+        { return 1e-9 * (4*k*n * sizeof(T)); }
+
+    // m-by-n trapezoid: k = min(m, n) triangle plus rectangle.
+    static double lantr(lapack::Uplo uplo, double m, double n)
+    {
+        double k = blas::min( m, n );
+        double rect = (uplo == lapack::Uplo::Upper ? k*(n - k) : k*(m - k));
+        return 1e-9 * ((0.5*k*(k+1) + rect) * sizeof(T));
+    }
 };
 
 //==============================================================================
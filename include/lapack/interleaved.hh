@@ -0,0 +1,148 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_INTERLEAVED_HH
+#define LAPACK_INTERLEAVED_HH
+
+#include "lapack/util.hh"
+
+#include <vector>
+
+namespace lapack {
+
+//==============================================================================
+/// Batched routines on interleaved storage, for batches of tiny matrices
+/// (n up to about 32) where even the batched loop over LAPACK in
+/// lapack/batch.hh is dominated by scalar code.
+///
+/// In interleaved storage, the batch is split into groups of
+/// W = lanes<scalar_t>() consecutive matrices, and element (i, j) of the
+/// W matrices in a group is contiguous, so one SIMD register holds the
+/// same element of every matrix in the group. Element (i, j) of matrix k
+/// is at
+///
+///     Ai[ ((k / W)*ld*n + i + j*ld)*W + k % W ]
+///
+/// for an m-by-n matrix with leading dimension ld >= m. The routines here
+/// are native C++, not LAPACK calls: each operation is written as a loop
+/// over the W lanes, which the compiler vectorizes, so every instruction
+/// works on W matrices at once. With GCC on x86-64 Linux, kernels are
+/// compiled for AVX-512, AVX2, and baseline x86-64, selected at run time.
+/// Groups are spread over LAPACK++'s thread pool.
+///
+/// W is 64 bytes worth of elements: 16 float, 8 double, 8 complex-float,
+/// or 4 complex-double, one AVX-512 register or two AVX2 registers.
+/// If the batch size is not a multiple of W, the last group is padded;
+/// pack() sets padding matrices to the identity, so factorizations on
+/// them succeed, and their results are ignored.
+///
+/// Use pack() to convert column-major matrices (pointer-array or strided,
+/// as in lapack/batch.hh) to interleaved storage, and unpack() to convert
+/// back. Pivots are not interleaved: as in the strided getrf_batch, the
+/// pivots of matrix k are at ipiv + k*stride_ipiv.
+///
+/// On output, info has batch entries: info[ k ] is the info that the
+/// non-batched routine returns for matrix k.
+///
+/// @ingroup interleaved
+namespace interleaved {
+
+//------------------------------------------------------------------------------
+/// @return number of matrices per group, W, in interleaved storage.
+/// @ingroup interleaved
+template <typename scalar_t>
+constexpr int64_t lanes()
+{
+    return 64 / sizeof(scalar_t);
+}
+
+//------------------------------------------------------------------------------
+/// @return number of elements of interleaved storage for batch
+/// matrices with leading dimension ld and n columns, including padding
+/// of the last group.
+/// @ingroup interleaved
+template <typename scalar_t>
+inline size_t size( int64_t ld, int64_t n, size_t batch )
+{
+    size_t W = lanes<scalar_t>();
+    return ((batch + W - 1) / W) * W * ld * n;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pack(
+    int64_t m, int64_t n,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    scalar_t* Ai, int64_t ldai,
+    size_t batch );
+
+template <typename scalar_t>
+void pack(
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t* Ai, int64_t ldai,
+    size_t batch );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unpack(
+    int64_t m, int64_t n,
+    scalar_t const* Ai, int64_t ldai,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    size_t batch );
+
+template <typename scalar_t>
+void unpack(
+    int64_t m, int64_t n,
+    scalar_t const* Ai, int64_t ldai,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    size_t batch );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t batch );
+
+}  // namespace interleaved
+}  // namespace lapack
+
+#endif // LAPACK_INTERLEAVED_HH
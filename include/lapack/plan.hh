@@ -0,0 +1,2859 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_PLAN_HH
+#define LAPACK_PLAN_HH
+
+#include "lapack/util.hh"
+#include "lapack/work.hh"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace lapack {
+
+namespace internal {
+
+// Aligned heap allocation; see workspace.cc.
+void* aligned_malloc( std::size_t bytes );
+void  aligned_free( void* ptr ) noexcept;
+
+}  // namespace internal
+
+//==============================================================================
+/// Plans hoist the workspace query and allocation out of repeated calls.
+///
+/// Routines such as gesdd query LAPACK for the optimal workspace size
+/// (lwork = -1), allocate it, then call LAPACK again, on every call.
+/// A plan does the query and allocation once when it is constructed,
+/// for fixed options and dimensions; then each execute() makes a single
+/// LAPACK call, with no query and no allocation.
+/// For example:
+///
+///     lapack::plan::gesdd< double > plan( lapack::Job::SomeVec, m, n );
+///     for (...) {
+///         int64_t info = plan.execute( A, lda, S, U, ldu, VT, ldvt );
+///     }
+///
+/// Arguments to the plan's constructor are the options and dimensions
+/// of the corresponding routine, that is, the arguments before the first
+/// array, plus any later dimensions the workspace query needs (trevc3's
+/// n and mm, geqr's tsize). Arguments to execute() are the remaining
+/// arguments, that is, arrays and their leading dimensions. The plan's
+/// workspace is reused by each execute(), so a plan must not be executed
+/// concurrently from multiple threads; use one plan per thread.
+///
+/// A plan holds one buffer, sized by the routine's *_work_size_bytes
+/// query (see lapack/work.hh), and passes it to the routine's
+/// caller-provided workspace overload. The buffer is aligned and
+/// not initialized.
+/// Every routine that does a workspace query has a plan, generated by
+/// tools/wrapper_gen.py -p. As in lapack/work.hh, real routines named
+/// sy, sp, sb, or, and op use the complex-named plan, instantiated for
+/// all precisions (syev uses heev). If the real routine has only real
+/// precisions, its name is an alias of that plan (plan::syev is
+/// plan::heev). Routines with hand-written wrappers, such as geev, gees,
+/// gges, and trsen, have hand-written plans in the same form.
+///
+/// @ingroup plan
+namespace plan {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Allocator for a plan's workspace: aligned heap memory whose elements
+/// are not initialized, like lapack::vector. Unlike lapack::vector, it
+/// doesn't use the workspace arena, since a plan's buffer outlives the
+/// calls that use it and may be freed on another thread.
+template <typename T>
+struct WorkAllocator
+{
+    using value_type = T;
+
+    WorkAllocator() = default;
+
+    template <typename U>
+    WorkAllocator( WorkAllocator< U > const& ) noexcept {}
+
+    // Construction and destruction are null-ops, leaving memory uninitialized.
+    template <typename... Args>
+    void construct( T* ptr, Args&& ... args ) {}
+
+    void destroy( T* ptr ) {}
+
+    T* allocate( std::size_t n )
+    {
+        if (n > std::numeric_limits< std::size_t >::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast< T* >( lapack::internal::aligned_malloc( n*sizeof(T) ) );
+    }
+
+    void deallocate( T* ptr, std::size_t n ) noexcept
+    {
+        lapack::internal::aligned_free( ptr );
+    }
+};
+
+template <typename T, typename U>
+bool operator == ( WorkAllocator< T > const&, WorkAllocator< U > const& )
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator != ( WorkAllocator< T > const&, WorkAllocator< U > const& )
+{
+    return false;
+}
+
+/// Workspace buffer of a plan.
+using work_vector = std::vector< char, WorkAllocator< char > >;
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::bbcsd.
+/// @ingroup plan
+template <typename scalar_t>
+class bbcsd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    bbcsd(
+        lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+        lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q );
+
+    int64_t execute(
+        real_t* theta,
+        real_t* phi,
+        scalar_t* U1, int64_t ldu1,
+        scalar_t* U2, int64_t ldu2,
+        scalar_t* V1T, int64_t ldv1t,
+        scalar_t* V2T, int64_t ldv2t,
+        real_t* B11D,
+        real_t* B11E,
+        real_t* B12D,
+        real_t* B12E,
+        real_t* B21D,
+        real_t* B21E,
+        real_t* B22D,
+        real_t* B22E );
+
+private:
+    lapack::Job jobu1_;
+    lapack::Job jobu2_;
+    lapack::Job jobv1t_;
+    lapack::Job jobv2t_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t p_;
+    int64_t q_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gebrd.
+/// @ingroup plan
+template <typename scalar_t>
+class gebrd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gebrd(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* D,
+        real_t* E,
+        scalar_t* tauq,
+        scalar_t* taup );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gees.
+/// @ingroup plan
+template <typename scalar_t>
+class gees
+{
+public:
+    using select_t = typename lapack::internal::gees_select< scalar_t >::type;
+
+    gees(
+        lapack::Job jobvs, lapack::Sort sort, select_t select, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* sdim,
+        blas::complex_type<scalar_t>* W,
+        scalar_t* VS, int64_t ldvs );
+
+private:
+    lapack::Job jobvs_;
+    lapack::Sort sort_;
+    select_t select_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geesx.
+/// @ingroup plan
+template <typename scalar_t>
+class geesx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+    using select_t = typename lapack::internal::gees_select< scalar_t >::type;
+
+    geesx(
+        lapack::Job jobvs, lapack::Sort sort, select_t select,
+        lapack::Sense sense, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* sdim,
+        blas::complex_type<scalar_t>* W,
+        scalar_t* VS, int64_t ldvs,
+        real_t* rconde,
+        real_t* rcondv );
+
+private:
+    lapack::Job jobvs_;
+    lapack::Sort sort_;
+    select_t select_;
+    lapack::Sense sense_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geev.
+/// @ingroup plan
+template <typename scalar_t>
+class geev
+{
+public:
+    geev(
+        lapack::Job jobvl, lapack::Job jobvr, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        blas::complex_type<scalar_t>* W,
+        scalar_t* VL, int64_t ldvl,
+        scalar_t* VR, int64_t ldvr );
+
+private:
+    lapack::Job jobvl_;
+    lapack::Job jobvr_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gehrd.
+/// @ingroup plan
+template <typename scalar_t>
+class gehrd
+{
+public:
+    gehrd(
+        int64_t n, int64_t ilo, int64_t ihi );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t n_;
+    int64_t ilo_;
+    int64_t ihi_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gelq.
+/// @ingroup plan
+template <typename scalar_t>
+class gelq
+{
+public:
+    gelq(
+        int64_t m, int64_t n, int64_t tsize );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* T );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t tsize_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gelqf.
+/// @ingroup plan
+template <typename scalar_t>
+class gelqf
+{
+public:
+    gelqf(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gels.
+/// @ingroup plan
+template <typename scalar_t>
+class gels
+{
+public:
+    gels(
+        lapack::Op trans, int64_t m, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gelsd.
+/// @ingroup plan
+template <typename scalar_t>
+class gelsd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gelsd(
+        int64_t m, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* S, real_t rcond,
+        int64_t* rank );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gelss.
+/// @ingroup plan
+template <typename scalar_t>
+class gelss
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gelss(
+        int64_t m, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* S, real_t rcond,
+        int64_t* rank );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gelsy.
+/// @ingroup plan
+template <typename scalar_t>
+class gelsy
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gelsy(
+        int64_t m, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        int64_t* jpvt, real_t rcond,
+        int64_t* rank );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gemlq.
+/// @ingroup plan
+template <typename scalar_t>
+class gemlq
+{
+public:
+    gemlq(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+        int64_t tsize );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* T,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    int64_t tsize_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gemqr.
+/// @ingroup plan
+template <typename scalar_t>
+class gemqr
+{
+public:
+    gemqr(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+        int64_t tsize );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* T,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    int64_t tsize_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geqlf.
+/// @ingroup plan
+template <typename scalar_t>
+class geqlf
+{
+public:
+    geqlf(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geqp3.
+/// @ingroup plan
+template <typename scalar_t>
+class geqp3
+{
+public:
+    geqp3(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* jpvt,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geqr.
+/// @ingroup plan
+template <typename scalar_t>
+class geqr
+{
+public:
+    geqr(
+        int64_t m, int64_t n, int64_t tsize );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* T );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t tsize_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geqrf.
+/// @ingroup plan
+template <typename scalar_t>
+class geqrf
+{
+public:
+    geqrf(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::geqrfp.
+/// @ingroup plan
+template <typename scalar_t>
+class geqrfp
+{
+public:
+    geqrfp(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gerqf.
+/// @ingroup plan
+template <typename scalar_t>
+class gerqf
+{
+public:
+    gerqf(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gesdd.
+/// @ingroup plan
+template <typename scalar_t>
+class gesdd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gesdd(
+        lapack::Job jobz, int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* S,
+        scalar_t* U, int64_t ldu,
+        scalar_t* VT, int64_t ldvt );
+
+private:
+    lapack::Job jobz_;
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gesvd.
+/// @ingroup plan
+template <typename scalar_t>
+class gesvd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gesvd(
+        lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* S,
+        scalar_t* U, int64_t ldu,
+        scalar_t* VT, int64_t ldvt );
+
+private:
+    lapack::Job jobu_;
+    lapack::Job jobvt_;
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gesvdx.
+/// @ingroup plan
+template <typename scalar_t>
+class gesvdx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    gesvdx(
+        lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+        int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+        int64_t* nfound,
+        real_t* S,
+        scalar_t* U, int64_t ldu,
+        scalar_t* VT, int64_t ldvt );
+
+private:
+    lapack::Job jobu_;
+    lapack::Job jobvt_;
+    lapack::Range range_;
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::getri.
+/// @ingroup plan
+template <typename scalar_t>
+class getri
+{
+public:
+    getri(
+        int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::getsls.
+/// @ingroup plan
+template <typename scalar_t>
+class getsls
+{
+public:
+    getsls(
+        lapack::Op trans, int64_t m, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gges.
+/// @ingroup plan
+template <typename scalar_t>
+class gges
+{
+public:
+    using select_t = typename lapack::internal::gges_select< scalar_t >::type;
+
+    gges(
+        lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+        select_t select, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        int64_t* sdim,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* VSL, int64_t ldvsl,
+        scalar_t* VSR, int64_t ldvsr );
+
+private:
+    lapack::Job jobvsl_;
+    lapack::Job jobvsr_;
+    lapack::Sort sort_;
+    select_t select_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gges3.
+/// @ingroup plan
+template <typename scalar_t>
+class gges3
+{
+public:
+    using select_t = typename lapack::internal::gges_select< scalar_t >::type;
+
+    gges3(
+        lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+        select_t select, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        int64_t* sdim,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* VSL, int64_t ldvsl,
+        scalar_t* VSR, int64_t ldvsr );
+
+private:
+    lapack::Job jobvsl_;
+    lapack::Job jobvsr_;
+    lapack::Sort sort_;
+    select_t select_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggesx.
+/// @ingroup plan
+template <typename scalar_t>
+class ggesx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+    using select_t = typename lapack::internal::gges_select< scalar_t >::type;
+
+    ggesx(
+        lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+        select_t select, lapack::Sense sense, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        int64_t* sdim,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* VSL, int64_t ldvsl,
+        scalar_t* VSR, int64_t ldvsr,
+        real_t* rconde,
+        real_t* rcondv );
+
+private:
+    lapack::Job jobvsl_;
+    lapack::Job jobvsr_;
+    lapack::Sort sort_;
+    select_t select_;
+    lapack::Sense sense_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggev.
+/// @ingroup plan
+template <typename scalar_t>
+class ggev
+{
+public:
+    ggev(
+        lapack::Job jobvl, lapack::Job jobvr, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* VL, int64_t ldvl,
+        scalar_t* VR, int64_t ldvr );
+
+private:
+    lapack::Job jobvl_;
+    lapack::Job jobvr_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggev3.
+/// @ingroup plan
+template <typename scalar_t>
+class ggev3
+{
+public:
+    ggev3(
+        lapack::Job jobvl, lapack::Job jobvr, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* VL, int64_t ldvl,
+        scalar_t* VR, int64_t ldvr );
+
+private:
+    lapack::Job jobvl_;
+    lapack::Job jobvr_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggglm.
+/// @ingroup plan
+template <typename scalar_t>
+class ggglm
+{
+public:
+    ggglm(
+        int64_t n, int64_t m, int64_t p );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        scalar_t* D,
+        scalar_t* X,
+        scalar_t* Y );
+
+private:
+    int64_t n_;
+    int64_t m_;
+    int64_t p_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::gglse.
+/// @ingroup plan
+template <typename scalar_t>
+class gglse
+{
+public:
+    gglse(
+        int64_t m, int64_t n, int64_t p );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        scalar_t* C,
+        scalar_t* D,
+        scalar_t* X );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t p_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggqrf.
+/// @ingroup plan
+template <typename scalar_t>
+class ggqrf
+{
+public:
+    ggqrf(
+        int64_t n, int64_t m, int64_t p );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* taua,
+        scalar_t* B, int64_t ldb,
+        scalar_t* taub );
+
+private:
+    int64_t n_;
+    int64_t m_;
+    int64_t p_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggrqf.
+/// @ingroup plan
+template <typename scalar_t>
+class ggrqf
+{
+public:
+    ggrqf(
+        int64_t m, int64_t p, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* taua,
+        scalar_t* B, int64_t ldb,
+        scalar_t* taub );
+
+private:
+    int64_t m_;
+    int64_t p_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggsvd3.
+/// @ingroup plan
+template <typename scalar_t>
+class ggsvd3
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    ggsvd3(
+        lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+        int64_t n, int64_t p );
+
+    int64_t execute(
+        int64_t* k,
+        int64_t* l,
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* alpha,
+        real_t* beta,
+        scalar_t* U, int64_t ldu,
+        scalar_t* V, int64_t ldv,
+        scalar_t* Q, int64_t ldq );
+
+private:
+    lapack::Job jobu_;
+    lapack::Job jobv_;
+    lapack::Job jobq_;
+    int64_t m_;
+    int64_t n_;
+    int64_t p_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ggsvp3.
+/// @ingroup plan
+template <typename scalar_t>
+class ggsvp3
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    ggsvp3(
+        lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+        int64_t p, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb, real_t tola, real_t tolb,
+        int64_t* k,
+        int64_t* l,
+        scalar_t* U, int64_t ldu,
+        scalar_t* V, int64_t ldv,
+        scalar_t* Q, int64_t ldq,
+        scalar_t* tau );
+
+private:
+    lapack::Job jobu_;
+    lapack::Job jobv_;
+    lapack::Job jobq_;
+    int64_t m_;
+    int64_t p_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hbev_2stage and lapack::sbev_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class hbev_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hbev_2stage(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd );
+
+    int64_t execute(
+        scalar_t* AB, int64_t ldab,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t kd_;
+    internal::work_vector work_;
+};
+
+// sbev_2stage alias to hbev_2stage
+template <typename scalar_t>
+using sbev_2stage = hbev_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hbevd and lapack::sbevd.
+/// @ingroup plan
+template <typename scalar_t>
+class hbevd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hbevd(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd );
+
+    int64_t execute(
+        scalar_t* AB, int64_t ldab,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t kd_;
+    internal::work_vector work_;
+};
+
+// sbevd alias to hbevd
+template <typename scalar_t>
+using sbevd = hbevd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hbevd_2stage and lapack::sbevd_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class hbevd_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hbevd_2stage(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd );
+
+    int64_t execute(
+        scalar_t* AB, int64_t ldab,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t kd_;
+    internal::work_vector work_;
+};
+
+// sbevd_2stage alias to hbevd_2stage
+template <typename scalar_t>
+using sbevd_2stage = hbevd_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hbevx_2stage and lapack::sbevx_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class hbevx_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hbevx_2stage(
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+        int64_t kd );
+
+    int64_t execute(
+        scalar_t* AB, int64_t ldab,
+        scalar_t* Q, int64_t ldq, real_t vl, real_t vu, int64_t il, int64_t iu,
+        real_t abstol,
+        int64_t* m,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* ifail );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t kd_;
+    internal::work_vector work_;
+};
+
+// sbevx_2stage alias to hbevx_2stage
+template <typename scalar_t>
+using sbevx_2stage = hbevx_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hbgvd and lapack::sbgvd.
+/// @ingroup plan
+template <typename scalar_t>
+class hbgvd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hbgvd(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka,
+        int64_t kb );
+
+    int64_t execute(
+        scalar_t* AB, int64_t ldab,
+        scalar_t* BB, int64_t ldbb,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t ka_;
+    int64_t kb_;
+    internal::work_vector work_;
+};
+
+// sbgvd alias to hbgvd
+template <typename scalar_t>
+using sbgvd = hbgvd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heev and lapack::syev.
+/// @ingroup plan
+template <typename scalar_t>
+class heev
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heev(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* W );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syev alias to heev
+template <typename scalar_t>
+using syev = heev< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heev_2stage and lapack::syev_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class heev_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heev_2stage(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* W );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syev_2stage alias to heev_2stage
+template <typename scalar_t>
+using syev_2stage = heev_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevd and lapack::syevd.
+/// @ingroup plan
+template <typename scalar_t>
+class heevd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevd(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* W );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevd alias to heevd
+template <typename scalar_t>
+using syevd = heevd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevd_2stage and lapack::syevd_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class heevd_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevd_2stage(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* W );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevd_2stage alias to heevd_2stage
+template <typename scalar_t>
+using syevd_2stage = heevd_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevr and lapack::syevr.
+/// @ingroup plan
+template <typename scalar_t>
+class heevr
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevr(
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t vl, real_t vu, int64_t il, int64_t iu, real_t abstol,
+        int64_t* nfound,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* isuppz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevr alias to heevr
+template <typename scalar_t>
+using syevr = heevr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevr_2stage and lapack::syevr_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class heevr_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevr_2stage(
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+        real_t abstol,
+        int64_t* nfound,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* isuppz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevr_2stage alias to heevr_2stage
+template <typename scalar_t>
+using syevr_2stage = heevr_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevx and lapack::syevx.
+/// @ingroup plan
+template <typename scalar_t>
+class heevx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevx(
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+        real_t abstol,
+        int64_t* nfound,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* ifail );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevx alias to heevx
+template <typename scalar_t>
+using syevx = heevx< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::heevx_2stage and lapack::syevx_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class heevx_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    heevx_2stage(
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+        real_t abstol,
+        int64_t* nfound,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* ifail );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// syevx_2stage alias to heevx_2stage
+template <typename scalar_t>
+using syevx_2stage = heevx_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hegv and lapack::sygv.
+/// @ingroup plan
+template <typename scalar_t>
+class hegv
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hegv(
+        int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* W );
+
+private:
+    int64_t itype_;
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// sygv alias to hegv
+template <typename scalar_t>
+using sygv = hegv< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hegv_2stage and lapack::sygv_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class hegv_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hegv_2stage(
+        int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* W );
+
+private:
+    int64_t itype_;
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// sygv_2stage alias to hegv_2stage
+template <typename scalar_t>
+using sygv_2stage = hegv_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hegvd and lapack::sygvd.
+/// @ingroup plan
+template <typename scalar_t>
+class hegvd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hegvd(
+        int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb,
+        real_t* W );
+
+private:
+    int64_t itype_;
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// sygvd alias to hegvd
+template <typename scalar_t>
+using sygvd = hegvd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hegvx and lapack::sygvx.
+/// @ingroup plan
+template <typename scalar_t>
+class hegvx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hegvx(
+        int64_t itype, lapack::Job jobz, lapack::Range range,
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* B, int64_t ldb, real_t vl, real_t vu, int64_t il, int64_t iu,
+        real_t abstol,
+        int64_t* m,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* ifail );
+
+private:
+    int64_t itype_;
+    lapack::Job jobz_;
+    lapack::Range range_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// sygvx alias to hegvx
+template <typename scalar_t>
+using sygvx = hegvx< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hesv.
+/// @ingroup plan
+template <typename scalar_t>
+class hesv
+{
+public:
+    hesv(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hesv_aa.
+/// @ingroup plan
+template <typename scalar_t>
+class hesv_aa
+{
+public:
+    hesv_aa(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hesv_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class hesv_rk
+{
+public:
+    hesv_rk(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* E,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hesv_rook.
+/// @ingroup plan
+template <typename scalar_t>
+class hesv_rook
+{
+public:
+    hesv_rook(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hesvx.
+/// @ingroup plan
+template <typename scalar_t>
+class hesvx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hesvx(
+        lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t* AF, int64_t ldaf,
+        int64_t* ipiv,
+        scalar_t const* B, int64_t ldb,
+        scalar_t* X, int64_t ldx,
+        real_t* rcond,
+        real_t* ferr,
+        real_t* berr );
+
+private:
+    lapack::Factored fact_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrd and lapack::sytrd.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hetrd(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* D,
+        real_t* E,
+        scalar_t* tau );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// sytrd alias to hetrd
+template <typename scalar_t>
+using sytrd = hetrd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrd_2stage and lapack::sytrd_2stage.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrd_2stage
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hetrd_2stage(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t lhous2 );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        real_t* D,
+        real_t* E,
+        scalar_t* tau,
+        scalar_t* hous2 );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t lhous2_;
+    internal::work_vector work_;
+};
+
+// sytrd_2stage alias to hetrd_2stage
+template <typename scalar_t>
+using sytrd_2stage = hetrd_2stage< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrf.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrf
+{
+public:
+    hetrf(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrf_aa.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrf_aa
+{
+public:
+    hetrf_aa(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrf_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrf_rk
+{
+public:
+    hetrf_rk(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* E,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetrf_rook.
+/// @ingroup plan
+template <typename scalar_t>
+class hetrf_rook
+{
+public:
+    hetrf_rook(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetri2.
+/// @ingroup plan
+template <typename scalar_t>
+class hetri2
+{
+public:
+    hetri2(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t const* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hetri_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class hetri_rk
+{
+public:
+    hetri_rk(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* E,
+        int64_t const* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hgeqz.
+/// @ingroup plan
+template <typename scalar_t>
+class hgeqz
+{
+public:
+    hgeqz(
+        lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+        int64_t n, int64_t ilo, int64_t ihi );
+
+    int64_t execute(
+        scalar_t* H, int64_t ldh,
+        scalar_t* T, int64_t ldt,
+        blas::complex_type<scalar_t>* alpha,
+        scalar_t* beta,
+        scalar_t* Q, int64_t ldq,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::JobSchur jobschur_;
+    lapack::Job compq_;
+    lapack::Job compz_;
+    int64_t n_;
+    int64_t ilo_;
+    int64_t ihi_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hpevd and lapack::spevd.
+/// @ingroup plan
+template <typename scalar_t>
+class hpevd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hpevd(
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* AP,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// spevd alias to hpevd
+template <typename scalar_t>
+using spevd = hpevd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hpgvd and lapack::spgvd.
+/// @ingroup plan
+template <typename scalar_t>
+class hpgvd
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    hpgvd(
+        int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* AP,
+        scalar_t* BP,
+        real_t* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    int64_t itype_;
+    lapack::Job jobz_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// spgvd alias to hpgvd
+template <typename scalar_t>
+using spgvd = hpgvd< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::hseqr.
+/// @ingroup plan
+template <typename scalar_t>
+class hseqr
+{
+public:
+    hseqr(
+        lapack::JobSchur jobschur, lapack::Job compz,
+        int64_t n, int64_t ilo, int64_t ihi );
+
+    int64_t execute(
+        scalar_t* H, int64_t ldh,
+        blas::complex_type<scalar_t>* W,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::JobSchur jobschur_;
+    lapack::Job compz_;
+    int64_t n_;
+    int64_t ilo_;
+    int64_t ihi_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::orcsd2by1.
+/// @ingroup plan
+template <typename scalar_t>
+class orcsd2by1
+{
+public:
+    orcsd2by1(
+        lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+        int64_t p, int64_t q );
+
+    int64_t execute(
+        scalar_t* X11, int64_t ldx11,
+        scalar_t* X21, int64_t ldx21,
+        scalar_t* theta,
+        scalar_t* U1, int64_t ldu1,
+        scalar_t* U2, int64_t ldu2,
+        scalar_t* V1T, int64_t ldv1t );
+
+private:
+    lapack::Job jobu1_;
+    lapack::Job jobu2_;
+    lapack::Job jobv1t_;
+    int64_t m_;
+    int64_t p_;
+    int64_t q_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::stedc.
+/// @ingroup plan
+template <typename scalar_t>
+class stedc
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    stedc(
+        lapack::Job compz, int64_t n );
+
+    int64_t execute(
+        real_t* D,
+        real_t* E,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job compz_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::stegr.
+/// @ingroup plan
+template <typename scalar_t>
+class stegr
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    stegr(
+        lapack::Job jobz, lapack::Range range, int64_t n );
+
+    int64_t execute(
+        real_t* D,
+        real_t* E, real_t vl, real_t vu, int64_t il, int64_t iu, real_t abstol,
+        int64_t* m,
+        real_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* isuppz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::stemr.
+/// @ingroup plan
+template <typename scalar_t>
+class stemr
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    stemr(
+        lapack::Job jobz, lapack::Range range, int64_t n );
+
+    int64_t execute(
+        real_t* D,
+        real_t* E, real_t vl, real_t vu, int64_t il, int64_t iu,
+        int64_t* m,
+        real_t* W,
+        scalar_t* Z, int64_t ldz, int64_t nzc,
+        int64_t* isuppz,
+        bool* tryrac );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::stevd.
+/// @ingroup plan
+template <typename scalar_t>
+class stevd
+{
+public:
+    stevd(
+        lapack::Job jobz, int64_t n );
+
+    int64_t execute(
+        scalar_t* D,
+        scalar_t* E,
+        scalar_t* Z, int64_t ldz );
+
+private:
+    lapack::Job jobz_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::stevr.
+/// @ingroup plan
+template <typename scalar_t>
+class stevr
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    stevr(
+        lapack::Job jobz, lapack::Range range, int64_t n );
+
+    int64_t execute(
+        scalar_t* D,
+        scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+        scalar_t abstol,
+        int64_t* m,
+        scalar_t* W,
+        scalar_t* Z, int64_t ldz,
+        int64_t* isuppz );
+
+private:
+    lapack::Job jobz_;
+    lapack::Range range_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sysv.
+/// @ingroup plan
+template <typename scalar_t>
+class sysv
+{
+public:
+    sysv(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sysv_aa.
+/// @ingroup plan
+template <typename scalar_t>
+class sysv_aa
+{
+public:
+    sysv_aa(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sysv_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class sysv_rk
+{
+public:
+    sysv_rk(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* E,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sysv_rook.
+/// @ingroup plan
+template <typename scalar_t>
+class sysv_rook
+{
+public:
+    sysv_rook(
+        lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv,
+        scalar_t* B, int64_t ldb );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sysvx.
+/// @ingroup plan
+template <typename scalar_t>
+class sysvx
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    sysvx(
+        lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t* AF, int64_t ldaf,
+        int64_t* ipiv,
+        scalar_t const* B, int64_t ldb,
+        scalar_t* X, int64_t ldx,
+        real_t* rcond,
+        real_t* ferr,
+        real_t* berr );
+
+private:
+    lapack::Factored fact_;
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t nrhs_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytrf.
+/// @ingroup plan
+template <typename scalar_t>
+class sytrf
+{
+public:
+    sytrf(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytrf_aa.
+/// @ingroup plan
+template <typename scalar_t>
+class sytrf_aa
+{
+public:
+    sytrf_aa(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytrf_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class sytrf_rk
+{
+public:
+    sytrf_rk(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* E,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytrf_rook.
+/// @ingroup plan
+template <typename scalar_t>
+class sytrf_rook
+{
+public:
+    sytrf_rook(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytri2.
+/// @ingroup plan
+template <typename scalar_t>
+class sytri2
+{
+public:
+    sytri2(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        int64_t const* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::sytri_rk.
+/// @ingroup plan
+template <typename scalar_t>
+class sytri_rk
+{
+public:
+    sytri_rk(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* E,
+        int64_t const* ipiv );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::tgsyl.
+/// @ingroup plan
+template <typename scalar_t>
+class tgsyl
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    tgsyl(
+        lapack::Op trans, int64_t ijob, int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* B, int64_t ldb,
+        scalar_t* C, int64_t ldc,
+        scalar_t const* D, int64_t ldd,
+        scalar_t const* E, int64_t lde,
+        scalar_t* F, int64_t ldf,
+        real_t* dif,
+        real_t* scale );
+
+private:
+    lapack::Op trans_;
+    int64_t ijob_;
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::trevc3.
+/// @ingroup plan
+template <typename scalar_t>
+class trevc3
+{
+public:
+    trevc3(
+        lapack::Sides sides, lapack::HowMany howmany, int64_t n, int64_t mm );
+
+    int64_t execute(
+        bool* select,
+        scalar_t* T, int64_t ldt,
+        scalar_t* VL, int64_t ldvl,
+        scalar_t* VR, int64_t ldvr,
+        int64_t* m );
+
+private:
+    lapack::Sides sides_;
+    lapack::HowMany howmany_;
+    int64_t n_;
+    int64_t mm_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::trsen.
+/// @ingroup plan
+template <typename scalar_t>
+class trsen
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    trsen(
+        lapack::Sense sense, lapack::Job compq, int64_t n );
+
+    int64_t execute(
+        bool const* select,
+        scalar_t* T, int64_t ldt,
+        scalar_t* Q, int64_t ldq,
+        blas::complex_type<scalar_t>* W,
+        int64_t* m,
+        real_t* s,
+        real_t* sep );
+
+private:
+    lapack::Sense sense_;
+    lapack::Job compq_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::tzrzf.
+/// @ingroup plan
+template <typename scalar_t>
+class tzrzf
+{
+public:
+    tzrzf(
+        int64_t m, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ungbr and lapack::orgbr.
+/// @ingroup plan
+template <typename scalar_t>
+class ungbr
+{
+public:
+    ungbr(
+        lapack::Vect vect, int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    lapack::Vect vect_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// orgbr alias to ungbr
+template <typename scalar_t>
+using orgbr = ungbr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unghr and lapack::orghr.
+/// @ingroup plan
+template <typename scalar_t>
+class unghr
+{
+public:
+    unghr(
+        int64_t n, int64_t ilo, int64_t ihi );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    int64_t n_;
+    int64_t ilo_;
+    int64_t ihi_;
+    internal::work_vector work_;
+};
+
+// orghr alias to unghr
+template <typename scalar_t>
+using orghr = unghr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unglq and lapack::orglq.
+/// @ingroup plan
+template <typename scalar_t>
+class unglq
+{
+public:
+    unglq(
+        int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// orglq alias to unglq
+template <typename scalar_t>
+using orglq = unglq< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ungql and lapack::orgql.
+/// @ingroup plan
+template <typename scalar_t>
+class ungql
+{
+public:
+    ungql(
+        int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// orgql alias to ungql
+template <typename scalar_t>
+using orgql = ungql< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ungqr and lapack::orgqr.
+/// @ingroup plan
+template <typename scalar_t>
+class ungqr
+{
+public:
+    ungqr(
+        int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// orgqr alias to ungqr
+template <typename scalar_t>
+using orgqr = ungqr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ungrq and lapack::orgrq.
+/// @ingroup plan
+template <typename scalar_t>
+class ungrq
+{
+public:
+    ungrq(
+        int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// orgrq alias to ungrq
+template <typename scalar_t>
+using orgrq = ungrq< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::ungtr and lapack::orgtr.
+/// @ingroup plan
+template <typename scalar_t>
+class ungtr
+{
+public:
+    ungtr(
+        lapack::Uplo uplo, int64_t n );
+
+    int64_t execute(
+        scalar_t* A, int64_t lda,
+        scalar_t const* tau );
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// orgtr alias to ungtr
+template <typename scalar_t>
+using orgtr = ungtr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmbr and lapack::ormbr.
+/// @ingroup plan
+template <typename scalar_t>
+class unmbr
+{
+public:
+    unmbr(
+        lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+        int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Vect vect_;
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// ormbr alias to unmbr
+template <typename scalar_t>
+using ormbr = unmbr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmhr and lapack::ormhr.
+/// @ingroup plan
+template <typename scalar_t>
+class unmhr
+{
+public:
+    unmhr(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+        int64_t ihi );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t ilo_;
+    int64_t ihi_;
+    internal::work_vector work_;
+};
+
+// ormhr alias to unmhr
+template <typename scalar_t>
+using ormhr = unmhr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmlq and lapack::ormlq.
+/// @ingroup plan
+template <typename scalar_t>
+class unmlq
+{
+public:
+    unmlq(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// ormlq alias to unmlq
+template <typename scalar_t>
+using ormlq = unmlq< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmql and lapack::ormql.
+/// @ingroup plan
+template <typename scalar_t>
+class unmql
+{
+public:
+    unmql(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// ormql alias to unmql
+template <typename scalar_t>
+using ormql = unmql< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmqr and lapack::ormqr.
+/// @ingroup plan
+template <typename scalar_t>
+class unmqr
+{
+public:
+    unmqr(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// ormqr alias to unmqr
+template <typename scalar_t>
+using ormqr = unmqr< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmrq and lapack::ormrq.
+/// @ingroup plan
+template <typename scalar_t>
+class unmrq
+{
+public:
+    unmrq(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    internal::work_vector work_;
+};
+
+// ormrq alias to unmrq
+template <typename scalar_t>
+using ormrq = unmrq< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmrz and lapack::ormrz.
+/// @ingroup plan
+template <typename scalar_t>
+class unmrz
+{
+public:
+    unmrz(
+        lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+        int64_t l );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    int64_t k_;
+    int64_t l_;
+    internal::work_vector work_;
+};
+
+// ormrz alias to unmrz
+template <typename scalar_t>
+using ormrz = unmrz< scalar_t >;
+
+//------------------------------------------------------------------------------
+/// Plan for lapack::unmtr and lapack::ormtr.
+/// @ingroup plan
+template <typename scalar_t>
+class unmtr
+{
+public:
+    unmtr(
+        lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+        int64_t n );
+
+    int64_t execute(
+        scalar_t const* A, int64_t lda,
+        scalar_t const* tau,
+        scalar_t* C, int64_t ldc );
+
+private:
+    lapack::Side side_;
+    lapack::Uplo uplo_;
+    lapack::Op trans_;
+    int64_t m_;
+    int64_t n_;
+    internal::work_vector work_;
+};
+
+// ormtr alias to unmtr
+template <typename scalar_t>
+using ormtr = unmtr< scalar_t >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif // LAPACK_PLAN_HH
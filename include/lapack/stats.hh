@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_STATS_HH
+#define LAPACK_STATS_HH
+
+#include "lapack/util.hh"
+
+#include <atomic>
+#include <cstdio>
+
+namespace lapack {
+namespace stats {
+
+//==============================================================================
+// Call statistics.
+//
+// For each traced routine (see lapack/trace.hh) and precision, counts
+// calls, total, min, and max time, total Gflop, and histograms of m and
+// n in log2 buckets: bucket 0 is size 0, bucket b >= 1 is sizes in
+// [2^(b-1), 2^b). dump() prints them, sorted by total time, which shows
+// where batching or plans would pay off; reset() starts a new window.
+//
+// Statistics are on by default. Each thread counts into its own table,
+// without locks, so threads don't contend. A table holds 256 routines
+// and precisions; calls to others are dropped, and dump() reports how many.
+//
+// Setting $LAPACKPP_STATS to off turns statistics off at startup;
+// setting it to table or json dumps them to stderr at exit.
+
+/// Output format for dump.
+/// @ingroup stats
+enum class Format { Table, JSON };
+
+/// Turns statistics on. They are on by default.
+/// @ingroup stats
+void on();
+
+/// Turns statistics off. Statistics so far are kept.
+/// @ingroup stats
+void off();
+
+/// Discards statistics so far, starting a new window.
+/// Calls running in other threads during reset may be counted in either
+/// window.
+/// @ingroup stats
+void reset();
+
+/// Prints statistics so far, summed over all threads, sorted by total time,
+/// and the number of calls dropped because a thread's table was full.
+/// @param[in] format
+///     Format::Table for a table, or Format::JSON.
+/// @param[in] stream
+///     Stream to print to.
+/// @ingroup stats
+void dump( Format format = Format::Table, FILE* stream = stdout );
+
+namespace internal {
+
+extern std::atomic< bool > enabled;
+
+/// Number of log2 buckets in m and n histograms; the last bucket also
+/// holds larger sizes.
+const int num_buckets = 32;
+
+void record(
+    char const* name, char precision,
+    int64_t m, int64_t n,
+    double time, double gflop );
+
+}  // namespace internal
+
+/// @return true if statistics are on.
+/// @ingroup stats
+inline bool is_on()
+{
+    return internal::enabled.load( std::memory_order_relaxed );
+}
+
+}  // namespace stats
+}  // namespace lapack
+
+#endif // LAPACK_STATS_HH
@@ -0,0 +1,17 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_THREADS_HH
+#define LAPACK_THREADS_HH
+
+namespace lapack {
+
+void set_num_threads( int nthreads );
+
+int get_num_threads();
+
+}  // namespace lapack
+
+#endif // LAPACK_THREADS_HH
@@ -0,0 +1,171 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_TRACE_HH
+#define LAPACK_TRACE_HH
+
+#include "lapack/util.hh"
+#include "lapack/stats.hh"
+
+#include <atomic>
+#include <complex>
+#include <exception>
+
+namespace lapack {
+namespace trace {
+
+//==============================================================================
+// Per-call tracing.
+//
+// While tracing is on, each traced routine records an event with its name,
+// precision, dimensions, wall time, thread, and Gflop from lapack/flops.hh,
+// plus Gbyte for memory-bound routines such as norms, copies, and
+// permutations.
+// finish() writes the events in Chrome trace JSON format, which
+// chrome://tracing and Perfetto (https://ui.perfetto.dev) display as a
+// timeline per thread.
+//
+// Setting $LAPACKPP_TRACE to a file name turns tracing on at startup,
+// and writes that file at exit.
+//
+// Traced routines also feed call statistics; see lapack/stats.hh.
+// While tracing and statistics are both off, a traced routine only loads
+// two flags.
+
+/// Turns tracing on. Events accumulate until finish or clear.
+/// @ingroup trace
+void on();
+
+/// Turns tracing off. Events recorded so far are kept.
+/// @ingroup trace
+void off();
+
+/// Writes events recorded so far to filename, in Chrome trace JSON
+/// format, then clears them. Tracing stays on or off as it was.
+/// Routines still running in other threads are written by a later
+/// finish.
+/// @ingroup trace
+void finish( const char* filename );
+
+/// Discards events recorded so far.
+/// @ingroup trace
+void clear();
+
+/// @return number of events recorded so far.
+/// @ingroup trace
+int64_t size();
+
+namespace internal {
+
+extern std::atomic< bool > enabled;
+
+void record(
+    char const* name, char precision,
+    int64_t m, int64_t n, int64_t k,
+    double start, double stop, double gflop, double gbyte );
+
+double now();
+
+//------------------------------------------------------------------------------
+/// precision< scalar_t >() is the LAPACK precision letter: s, d, c, or z.
+template <typename scalar_t>
+inline char precision();
+
+template <> inline char precision< float  >() { return 's'; }
+template <> inline char precision< double >() { return 'd'; }
+template <> inline char precision< std::complex<float>  >() { return 'c'; }
+template <> inline char precision< std::complex<double> >() { return 'z'; }
+
+//------------------------------------------------------------------------------
+/// @return number of exceptions being thrown, or before C++17 whether any
+/// are. Block compares it on entry and exit to detect unwinding.
+inline int uncaught_exceptions()
+{
+    #if defined( __cpp_lib_uncaught_exceptions )
+        return std::uncaught_exceptions();
+    #else
+        return std::uncaught_exception() ? 1 : 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Traces the enclosing scope: a wrapper creates a Block after checking its
+/// arguments, and its destructor records the event, and adds it to call
+/// statistics. Calls that throw are not recorded.
+/// Dimensions that don't apply are -1, e.g., m for n-by-n routines;
+/// for solves, k is nrhs. gflop is a callable returning the Gflop count,
+/// and the optional gbyte a callable returning the Gbyte moved, both
+/// called only if tracing or statistics are on.
+class Block
+{
+public:
+    template <typename F>
+    Block( char const* name, char precision,
+           int64_t m, int64_t n, int64_t k, F gflop ):
+        Block( name, precision, m, n, k, gflop, []() { return 0.0; } )
+    {}
+
+    template <typename F, typename G>
+    Block( char const* name, char precision,
+           int64_t m, int64_t n, int64_t k, F gflop, G gbyte ):
+        name_( nullptr )
+    {
+        tracing_  = enabled.load( std::memory_order_relaxed );
+        counting_ = stats::is_on();
+        if (tracing_ || counting_) {
+            name_ = name;
+            precision_ = precision;
+            m_ = m;
+            n_ = n;
+            k_ = k;
+            gflop_ = gflop();
+            gbyte_ = gbyte();
+            uncaught_ = uncaught_exceptions();
+            start_ = now();
+        }
+    }
+
+    ~Block()
+    {
+        if (name_ != nullptr && uncaught_exceptions() == uncaught_) {
+            double stop = now();
+            if (tracing_)
+                record( name_, precision_, m_, n_, k_, start_, stop,
+                        gflop_, gbyte_ );
+            if (counting_)
+                stats::internal::record( name_, precision_, m_, n_,
+                                         stop - start_, gflop_ );
+        }
+    }
+
+    // Disable copying.
+    Block( Block const& ) = delete;
+    Block& operator=( Block const& ) = delete;
+
+private:
+    char const* name_;  ///< null if neither tracing nor counting
+    bool tracing_;
+    bool counting_;
+    char precision_;
+    int64_t m_, n_, k_;
+    double gflop_;
+    double gbyte_;
+    double start_;
+    int uncaught_;      ///< uncaught exceptions on entry
+};
+
+}  // namespace internal
+
+/// @return true if tracing is on.
+/// @ingroup trace
+inline bool is_on()
+{
+    return internal::enabled.load( std::memory_order_relaxed );
+}
+
+}  // namespace trace
+}  // namespace lapack
+
+#endif // LAPACK_TRACE_HH
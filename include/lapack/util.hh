@@ -8,6 +8,7 @@
 
 #include <exception>
 #include <complex>
+#include <type_traits>
 #include <ctype.h>
 
 #include <assert.h>
@@ -841,6 +842,36 @@ inline const char* order2str( lapack::Order order )
     return "?";
 }
 
+// -----------------------------------------------------------------------------
+// laswp
+enum class SwapMethod {
+    Auto        = 'A',
+    Swap        = 'S',
+    Compose     = 'C',
+};
+
+inline char swapmethod2char( lapack::SwapMethod method )
+{
+    return char( method );
+}
+
+inline lapack::SwapMethod char2swapmethod( char method )
+{
+    method = char( toupper( method ));
+    lapack_error_if( method != 'A' && method != 'S' && method != 'C' );
+    return lapack::SwapMethod( method );
+}
+
+inline const char* swapmethod2str( lapack::SwapMethod method )
+{
+    switch (method) {
+        case lapack::SwapMethod::Auto:    return "auto";
+        case lapack::SwapMethod::Swap:    return "swap";
+        case lapack::SwapMethod::Compose: return "compose";
+    }
+    return "?";
+}
+
 // -----------------------------------------------------------------------------
 // check_ortho (LAPACK testing zunt01)
 enum class RowCol {
@@ -873,6 +904,31 @@ inline const char* rowcol2str( lapack::RowCol rowcol )
 // For %lld printf-style printing, cast to llong; guaranteed >= 64 bits.
 using llong = long long;
 
+//------------------------------------------------------------------------------
+/// Pivot index type that LAPACK uses natively: lapack_int, which is
+/// 32-bit int in LP64 builds and int64_t in ILP64 builds.
+///
+/// Routines with pivots (getrf, getrs, gesv, sytrf, hetrf, gbtrf, ...)
+/// take int64_t pivots, which in LP64 builds are copied to and from a
+/// temporary lapack_int array on each call. In LP64 builds, they also have
+/// overloads taking pivot_t pivots, which are passed directly to LAPACK,
+/// so pivots can go from a factorization into a solve with no conversion
+/// or allocation. Generic code can use pivot_t to get the fast path in
+/// either build:
+///
+///     std::vector< lapack::pivot_t > ipiv( n );
+///     lapack::getrf( n, n, A, lda, ipiv.data() );
+///     lapack::getrs( lapack::Op::NoTrans, n, nrhs, A, lda, ipiv.data(), B, ldb );
+///
+using pivot_t = lapack_int;
+
+/// True if pivots of type int_t are passed to LAPACK without conversion,
+/// that is, if int_t is pivot_t.
+template <typename int_t>
+struct is_native_pivot:
+    std::integral_constant< bool, std::is_same< int_t, pivot_t >::value >
+{};
+
 }  // namespace lapack
 
 #endif  // LAPACK_UTIL_HH
@@ -0,0 +1,8346 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_WORK_HH
+#define LAPACK_WORK_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+
+//==============================================================================
+// Routines taking caller-provided workspace, and their workspace queries.
+//
+// As with the device routines in lapack/device.hh, foo_work_size_bytes
+// returns the size in bytes of workspace needed by foo, then foo takes
+// a buffer of at least that size. Arrays passed to foo_work_size_bytes
+// only determine the template type; they are not referenced.
+// The buffer need not be aligned; all of its workspace arrays (work,
+// rwork, iwork, ...) are carved from it, so foo does no allocation.
+// A buffer larger than queried is allowed; the extra is given to LAPACK
+// as a larger lwork. A buffer smaller than queried throws lapack::Error.
+//
+// These overloads exist for every routine that takes work, rwork, iwork,
+// or bwork arrays, both those that query LAPACK for the workspace size
+// (geqrf, ormqr, syev, ...) and those with fixed-size workspace (gecon,
+// gerfs, trcon, ...). They are generated by tools/wrapper_gen.py -w,
+// except the routines returning split-complex eigenvalues or taking a
+// select function (geev, gees, geesx, ggev, ggev3, gges, gges3, ggesx,
+// hgeqz, hseqr, trsen), bdsdc, and mixed-precision gesv and posv, which
+// are written by hand. As in lapack/wrappers.hh, real precisions of the
+// Hermitian and unitary names (hesv, ungqr, ...) are inline aliases of
+// the symmetric and orthogonal routines (sysv, orgqr, ...), and syevd
+// and syevr are aliases of the heevd and heevr templates. Where only real
+// precisions have workspace (trexc, bdsdc), only those are instantiated.
+//
+// Routines without workspace arrays have no such overload. The default
+// overloads still take their workspace from the per-thread arena or the
+// workspace allocator; see lapack/workspace.hh and lapack/allocator.hh.
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    blas::real_type<scalar_t>* theta,
+    blas::real_type<scalar_t>* phi,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    scalar_t* V2T, int64_t ldv2t,
+    blas::real_type<scalar_t>* B11D,
+    blas::real_type<scalar_t>* B11E,
+    blas::real_type<scalar_t>* B12D,
+    blas::real_type<scalar_t>* B12E,
+    blas::real_type<scalar_t>* B21D,
+    blas::real_type<scalar_t>* B21E,
+    blas::real_type<scalar_t>* B22D,
+    blas::real_type<scalar_t>* B22E,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    blas::real_type<scalar_t>* theta,
+    blas::real_type<scalar_t>* phi,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    scalar_t* V2T, int64_t ldv2t,
+    blas::real_type<scalar_t>* B11D,
+    blas::real_type<scalar_t>* B11E,
+    blas::real_type<scalar_t>* B12D,
+    blas::real_type<scalar_t>* B12E,
+    blas::real_type<scalar_t>* B21D,
+    blas::real_type<scalar_t>* B21E,
+    blas::real_type<scalar_t>* B22D,
+    blas::real_type<scalar_t>* B22E,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// Only real precisions; there is no [cz]bdsdc.
+template <typename scalar_t>
+void bdsdc_work_size_bytes(
+    lapack::Uplo uplo, lapack::Job compq, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* Q,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t bdsdc(
+    lapack::Uplo uplo, lapack::Job compq, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* Q,
+    int64_t* IQ,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* U, int64_t ldu,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* U, int64_t ldu,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void bdsvdx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t* S,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t bdsvdx(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    scalar_t* S,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* PT, int64_t ldpt,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* PT, int64_t ldpt,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gbsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tauq,
+    scalar_t* taup,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gebrd(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tauq,
+    scalar_t* taup,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+namespace internal {
+
+/// gees_select< scalar_t >::type is the type of gees' select function.
+template <typename scalar_t>
+struct gees_select;
+
+template <> struct gees_select< float  > { typedef lapack_s_select2 type; };
+template <> struct gees_select< double > { typedef lapack_d_select2 type; };
+template <> struct gees_select< std::complex<float>  > { typedef lapack_c_select1 type; };
+template <> struct gees_select< std::complex<double> > { typedef lapack_z_select1 type; };
+
+}  // namespace internal
+
+template <typename scalar_t>
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    blas::real_type<scalar_t>* rconde,
+    blas::real_type<scalar_t>* rcondv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelq(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelq2_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelq2(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelqf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> rcond,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* jpvt, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gemlq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gemlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geql2(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqlf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqlf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqp3(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* jpvt,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqr_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqr2_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqr2(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrfp_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqrfp(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t> const* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t> const* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerq2_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gerq2(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerqf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gerqf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// Mixed precision; only double and complex<double>,
+// as [ds|zc]gesv.
+template <typename scalar_t>
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    blas::real_type<scalar_t>* rpivotgrowth,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getri_work_size_bytes(
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t getri(
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getsls_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t getsls(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* lscale,
+    blas::real_type<scalar_t>* rscale,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    blas::real_type<scalar_t>* lscale,
+    blas::real_type<scalar_t>* rscale,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+namespace internal {
+
+/// gges_select< scalar_t >::type is the type of gges' select function.
+template <typename scalar_t>
+struct gges_select;
+
+template <> struct gges_select< float  > { typedef lapack_s_select3 type; };
+template <> struct gges_select< double > { typedef lapack_d_select3 type; };
+template <> struct gges_select< std::complex<float>  > { typedef lapack_c_select2 type; };
+template <> struct gges_select< std::complex<double> > { typedef lapack_z_select2 type; };
+
+}  // namespace internal
+
+template <typename scalar_t>
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gges3_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gges3(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    blas::real_type<scalar_t>* rconde,
+    blas::real_type<scalar_t>* rcondv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* D,
+    scalar_t* X,
+    scalar_t* Y,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* D,
+    scalar_t* X,
+    scalar_t* Y,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* C,
+    scalar_t* D,
+    scalar_t* X,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* C,
+    scalar_t* D,
+    scalar_t* X,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggrqf_work_size_bytes(
+    int64_t m, int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggrqf(
+    int64_t m, int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    int64_t* k,
+    int64_t* l,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DU2, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DU2,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DLF,
+    scalar_t const* DF,
+    scalar_t const* DUF,
+    scalar_t const* DU2,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DLF,
+    scalar_t const* DF,
+    scalar_t const* DUF,
+    scalar_t const* DU2,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t* DLF,
+    scalar_t* DF,
+    scalar_t* DUF,
+    scalar_t* DU2,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t* DLF,
+    scalar_t* DF,
+    scalar_t* DUF,
+    scalar_t* DU2,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hecon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hecon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    blas::real_type<scalar_t>* scond,
+    blas::real_type<scalar_t>* amax,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// For real scalar_t, calls syevd.
+template <typename scalar_t>
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+// syevd alias to heevd
+template <typename scalar_t>
+inline void syevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size )
+{
+    heevd_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+template <typename scalar_t>
+inline int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size )
+{
+    return heevd( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// For real scalar_t, calls syevr.
+template <typename scalar_t>
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+// syevr alias to heevr
+template <typename scalar_t>
+inline void syevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    heevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu,
+                           abstol, W, Z, ldz, work_size );
+}
+
+template <typename scalar_t>
+inline int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size )
+{
+    return heevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol,
+                  nfound, W, Z, ldz, isuppz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heevr_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t heevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hegv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hegv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hegv_2stage_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hegv_2stage(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hegvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hegvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hegvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hegvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void herfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t herfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hesv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hesv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hesv_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hesv_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hesv_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hesv_rk(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hesv_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hesv_rook(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hesvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tau,
+    scalar_t* hous2, int64_t lhous2,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tau,
+    scalar_t* hous2, int64_t lhous2,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrf_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrf_aa(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrf_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrf_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrf_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrf_rook(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetri2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetri2(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetri_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* E,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetri_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrs2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrs2(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hetrs_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hetrs_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    scalar_t* T, int64_t ldt,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    scalar_t* T, int64_t ldt,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP, blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP, blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpgv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpgv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpgvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpgvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpgvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* AP,
+    scalar_t* BP, blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpgvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* AP,
+    scalar_t* BP, blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hprfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hprfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hpsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hpsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t* AFP,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void laghe_work_size_bytes(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t laghe(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t lagsy(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lanhb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lanhp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhs(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* V, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* V, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void opgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t opgtr(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+// upgtr_work_size_bytes alias to opgtr_work_size_bytes
+inline void upgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    float const* tau,
+    float* Q, int64_t ldq,
+    size_t* work_size )
+{
+    opgtr_work_size_bytes( uplo, n, AP, tau, Q, ldq, work_size );
+}
+
+// upgtr alias to opgtr
+inline int64_t upgtr(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    float const* tau,
+    float* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    return opgtr( uplo, n, AP, tau, Q, ldq, work, work_size );
+}
+
+// upgtr_work_size_bytes alias to opgtr_work_size_bytes
+inline void upgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    double const* tau,
+    double* Q, int64_t ldq,
+    size_t* work_size )
+{
+    opgtr_work_size_bytes( uplo, n, AP, tau, Q, ldq, work_size );
+}
+
+// upgtr alias to opgtr
+inline int64_t upgtr(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    double const* tau,
+    double* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    return opgtr( uplo, n, AP, tau, Q, ldq, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void opmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t opmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// upmtr_work_size_bytes alias to opmtr_work_size_bytes
+inline void upmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* AP,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    opmtr_work_size_bytes( side, uplo, trans, m, n, AP, tau, C, ldc, work_size );
+}
+
+// upmtr alias to opmtr
+inline int64_t upmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* AP,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return opmtr( side, uplo, trans, m, n, AP, tau, C, ldc, work, work_size );
+}
+
+// upmtr_work_size_bytes alias to opmtr_work_size_bytes
+inline void upmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* AP,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    opmtr_work_size_bytes( side, uplo, trans, m, n, AP, tau, C, ldc, work_size );
+}
+
+// upmtr alias to opmtr
+inline int64_t upmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* AP,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return opmtr( side, uplo, trans, m, n, AP, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orcsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    scalar_t* X11, int64_t ldx11,
+    scalar_t* X21, int64_t ldx21,
+    scalar_t* theta,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orcsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    scalar_t* X11, int64_t ldx11,
+    scalar_t* X21, int64_t ldx21,
+    scalar_t* theta,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    void* work, size_t work_size );
+
+// uncsd2by1_work_size_bytes alias to orcsd2by1_work_size_bytes
+inline void uncsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    float* X11, int64_t ldx11,
+    float* X21, int64_t ldx21,
+    float* theta,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    size_t* work_size )
+{
+    orcsd2by1_work_size_bytes( jobu1, jobu2, jobv1t, m, p, q, X11, ldx11, X21, ldx21, theta, U1, ldu1, U2, ldu2, V1T, ldv1t, work_size );
+}
+
+// uncsd2by1 alias to orcsd2by1
+inline int64_t uncsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    float* X11, int64_t ldx11,
+    float* X21, int64_t ldx21,
+    float* theta,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    void* work, size_t work_size )
+{
+    return orcsd2by1( jobu1, jobu2, jobv1t, m, p, q, X11, ldx11, X21, ldx21, theta, U1, ldu1, U2, ldu2, V1T, ldv1t, work, work_size );
+}
+
+// uncsd2by1_work_size_bytes alias to orcsd2by1_work_size_bytes
+inline void uncsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    double* X11, int64_t ldx11,
+    double* X21, int64_t ldx21,
+    double* theta,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    size_t* work_size )
+{
+    orcsd2by1_work_size_bytes( jobu1, jobu2, jobv1t, m, p, q, X11, ldx11, X21, ldx21, theta, U1, ldu1, U2, ldu2, V1T, ldv1t, work_size );
+}
+
+// uncsd2by1 alias to orcsd2by1
+inline int64_t uncsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    double* X11, int64_t ldx11,
+    double* X21, int64_t ldx21,
+    double* theta,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    void* work, size_t work_size )
+{
+    return orcsd2by1( jobu1, jobu2, jobv1t, m, p, q, X11, ldx11, X21, ldx21, theta, U1, ldu1, U2, ldu2, V1T, ldv1t, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orgbr_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orgbr(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// ungbr_work_size_bytes alias to orgbr_work_size_bytes
+inline void ungbr_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orgbr_work_size_bytes( vect, m, n, k, A, lda, tau, work_size );
+}
+
+// ungbr alias to orgbr
+inline int64_t ungbr(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orgbr( vect, m, n, k, A, lda, tau, work, work_size );
+}
+
+// ungbr_work_size_bytes alias to orgbr_work_size_bytes
+inline void ungbr_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orgbr_work_size_bytes( vect, m, n, k, A, lda, tau, work_size );
+}
+
+// ungbr alias to orgbr
+inline int64_t ungbr(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orgbr( vect, m, n, k, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orghr_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orghr(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// unghr_work_size_bytes alias to orghr_work_size_bytes
+inline void unghr_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orghr_work_size_bytes( n, ilo, ihi, A, lda, tau, work_size );
+}
+
+// unghr alias to orghr
+inline int64_t unghr(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orghr( n, ilo, ihi, A, lda, tau, work, work_size );
+}
+
+// unghr_work_size_bytes alias to orghr_work_size_bytes
+inline void unghr_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orghr_work_size_bytes( n, ilo, ihi, A, lda, tau, work_size );
+}
+
+// unghr alias to orghr
+inline int64_t unghr(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orghr( n, ilo, ihi, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orglq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orglq(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// unglq_work_size_bytes alias to orglq_work_size_bytes
+inline void unglq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orglq_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// unglq alias to orglq
+inline int64_t unglq(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orglq( m, n, k, A, lda, tau, work, work_size );
+}
+
+// unglq_work_size_bytes alias to orglq_work_size_bytes
+inline void unglq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orglq_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// unglq alias to orglq
+inline int64_t unglq(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orglq( m, n, k, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orgql_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orgql(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// ungql_work_size_bytes alias to orgql_work_size_bytes
+inline void ungql_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orgql_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungql alias to orgql
+inline int64_t ungql(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orgql( m, n, k, A, lda, tau, work, work_size );
+}
+
+// ungql_work_size_bytes alias to orgql_work_size_bytes
+inline void ungql_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orgql_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungql alias to orgql
+inline int64_t ungql(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orgql( m, n, k, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orgqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// ungqr_work_size_bytes alias to orgqr_work_size_bytes
+inline void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orgqr_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungqr alias to orgqr
+inline int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orgqr( m, n, k, A, lda, tau, work, work_size );
+}
+
+// ungqr_work_size_bytes alias to orgqr_work_size_bytes
+inline void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orgqr_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungqr alias to orgqr
+inline int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orgqr( m, n, k, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orgrq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orgrq(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// ungrq_work_size_bytes alias to orgrq_work_size_bytes
+inline void ungrq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orgrq_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungrq alias to orgrq
+inline int64_t ungrq(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orgrq( m, n, k, A, lda, tau, work, work_size );
+}
+
+// ungrq_work_size_bytes alias to orgrq_work_size_bytes
+inline void ungrq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orgrq_work_size_bytes( m, n, k, A, lda, tau, work_size );
+}
+
+// ungrq alias to orgrq
+inline int64_t ungrq(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orgrq( m, n, k, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void orgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t orgtr(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+// ungtr_work_size_bytes alias to orgtr_work_size_bytes
+inline void ungtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float const* tau,
+    size_t* work_size )
+{
+    orgtr_work_size_bytes( uplo, n, A, lda, tau, work_size );
+}
+
+// ungtr alias to orgtr
+inline int64_t ungtr(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float const* tau,
+    void* work, size_t work_size )
+{
+    return orgtr( uplo, n, A, lda, tau, work, work_size );
+}
+
+// ungtr_work_size_bytes alias to orgtr_work_size_bytes
+inline void ungtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double const* tau,
+    size_t* work_size )
+{
+    orgtr_work_size_bytes( uplo, n, A, lda, tau, work_size );
+}
+
+// ungtr alias to orgtr
+inline int64_t ungtr(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double const* tau,
+    void* work, size_t work_size )
+{
+    return orgtr( uplo, n, A, lda, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmbr_work_size_bytes alias to ormbr_work_size_bytes
+inline void unmbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormbr_work_size_bytes( vect, side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmbr alias to ormbr
+inline int64_t unmbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormbr( vect, side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmbr_work_size_bytes alias to ormbr_work_size_bytes
+inline void unmbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormbr_work_size_bytes( vect, side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmbr alias to ormbr
+inline int64_t unmbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormbr( vect, side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormhr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormhr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmhr_work_size_bytes alias to ormhr_work_size_bytes
+inline void unmhr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormhr_work_size_bytes( side, trans, m, n, ilo, ihi, A, lda, tau, C, ldc, work_size );
+}
+
+// unmhr alias to ormhr
+inline int64_t unmhr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormhr( side, trans, m, n, ilo, ihi, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmhr_work_size_bytes alias to ormhr_work_size_bytes
+inline void unmhr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormhr_work_size_bytes( side, trans, m, n, ilo, ihi, A, lda, tau, C, ldc, work_size );
+}
+
+// unmhr alias to ormhr
+inline int64_t unmhr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormhr( side, trans, m, n, ilo, ihi, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormlq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmlq_work_size_bytes alias to ormlq_work_size_bytes
+inline void unmlq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormlq_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmlq alias to ormlq
+inline int64_t unmlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormlq( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmlq_work_size_bytes alias to ormlq_work_size_bytes
+inline void unmlq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormlq_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmlq alias to ormlq
+inline int64_t unmlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormlq( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormql_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmql_work_size_bytes alias to ormql_work_size_bytes
+inline void unmql_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormql_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmql alias to ormql
+inline int64_t unmql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmql_work_size_bytes alias to ormql_work_size_bytes
+inline void unmql_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormql_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmql alias to ormql
+inline int64_t unmql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmqr_work_size_bytes alias to ormqr_work_size_bytes
+inline void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmqr alias to ormqr
+inline int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmqr_work_size_bytes alias to ormqr_work_size_bytes
+inline void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmqr alias to ormqr
+inline int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormrq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormrq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmrq_work_size_bytes alias to ormrq_work_size_bytes
+inline void unmrq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormrq_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmrq alias to ormrq
+inline int64_t unmrq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormrq( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmrq_work_size_bytes alias to ormrq_work_size_bytes
+inline void unmrq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormrq_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, work_size );
+}
+
+// unmrq alias to ormrq
+inline int64_t unmrq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormrq( side, trans, m, n, k, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormrz_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormrz(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmrz_work_size_bytes alias to ormrz_work_size_bytes
+inline void unmrz_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormrz_work_size_bytes( side, trans, m, n, k, l, A, lda, tau, C, ldc, work_size );
+}
+
+// unmrz alias to ormrz
+inline int64_t unmrz(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormrz( side, trans, m, n, k, l, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmrz_work_size_bytes alias to ormrz_work_size_bytes
+inline void unmrz_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormrz_work_size_bytes( side, trans, m, n, k, l, A, lda, tau, C, ldc, work_size );
+}
+
+// unmrz alias to ormrz
+inline int64_t unmrz(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormrz( side, trans, m, n, k, l, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ormtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ormtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+// unmtr_work_size_bytes alias to ormtr_work_size_bytes
+inline void unmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormtr_work_size_bytes( side, uplo, trans, m, n, A, lda, tau, C, ldc, work_size );
+}
+
+// unmtr alias to ormtr
+inline int64_t unmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormtr( side, uplo, trans, m, n, A, lda, tau, C, ldc, work, work_size );
+}
+
+// unmtr_work_size_bytes alias to ormtr_work_size_bytes
+inline void unmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size )
+{
+    ormtr_work_size_bytes( side, uplo, trans, m, n, A, lda, tau, C, ldc, work_size );
+}
+
+// unmtr alias to ormtr
+inline int64_t unmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    return ormtr( side, uplo, trans, m, n, A, lda, tau, C, ldc, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pbrfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pbrfs(
+    lapack::Uplo uplo, int64_t n, int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void porfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t porfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void porfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t porfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// Mixed precision; only double and complex<double>,
+// as [ds|zc]posv.
+template <typename scalar_t>
+void posv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void posvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t posvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pprfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pprfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ppsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* AP,
+    scalar_t* AFP,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ppsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* AP,
+    scalar_t* AFP,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> tol,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, blas::real_type<scalar_t> tol,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ptcon_work_size_bytes(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ptcon(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ptrfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t> const* DF,
+    scalar_t const* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ptrfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t> const* DF,
+    scalar_t const* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t>* DF,
+    scalar_t* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t>* DF,
+    scalar_t* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbev_work_size_bytes alias to sbev_work_size_bytes
+inline void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbev_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbev alias to sbev
+inline int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbev( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+// hbev_work_size_bytes alias to sbev_work_size_bytes
+inline void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbev_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbev alias to sbev
+inline int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbev( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbev_2stage_work_size_bytes alias to sbev_2stage_work_size_bytes
+inline void hbev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbev_2stage_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbev_2stage alias to sbev_2stage
+inline int64_t hbev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbev_2stage( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+// hbev_2stage_work_size_bytes alias to sbev_2stage_work_size_bytes
+inline void hbev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbev_2stage_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbev_2stage alias to sbev_2stage
+inline int64_t hbev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbev_2stage( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbevd_work_size_bytes alias to sbevd_work_size_bytes
+inline void hbevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevd_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbevd alias to sbevd
+inline int64_t hbevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbevd( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+// hbevd_work_size_bytes alias to sbevd_work_size_bytes
+inline void hbevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevd_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbevd alias to sbevd
+inline int64_t hbevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbevd( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbevd_2stage_work_size_bytes alias to sbevd_2stage_work_size_bytes
+inline void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevd_2stage_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbevd_2stage alias to sbevd_2stage
+inline int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbevd_2stage( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+// hbevd_2stage_work_size_bytes alias to sbevd_2stage_work_size_bytes
+inline void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevd_2stage_work_size_bytes( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work_size );
+}
+
+// hbevd_2stage alias to sbevd_2stage
+inline int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbevd_2stage( jobz, uplo, n, kd, AB, ldab, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hbevx_work_size_bytes alias to sbevx_work_size_bytes
+inline void hbevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    float* AB, int64_t ldab,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevx_work_size_bytes( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbevx alias to sbevx
+inline int64_t hbevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    float* AB, int64_t ldab,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbevx( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hbevx_work_size_bytes alias to sbevx_work_size_bytes
+inline void hbevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    double* AB, int64_t ldab,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevx_work_size_bytes( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbevx alias to sbevx
+inline int64_t hbevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    double* AB, int64_t ldab,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbevx( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hbevx_2stage_work_size_bytes alias to sbevx_2stage_work_size_bytes
+inline void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    float* AB, int64_t ldab,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevx_2stage_work_size_bytes( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbevx_2stage alias to sbevx_2stage
+inline int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    float* AB, int64_t ldab,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbevx_2stage( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hbevx_2stage_work_size_bytes alias to sbevx_2stage_work_size_bytes
+inline void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    double* AB, int64_t ldab,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbevx_2stage_work_size_bytes( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbevx_2stage alias to sbevx_2stage
+inline int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    double* AB, int64_t ldab,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbevx_2stage( jobz, range, uplo, n, kd, AB, ldab, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    void* work, size_t work_size );
+
+// hbgst_work_size_bytes alias to sbgst_work_size_bytes
+inline void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float const* BB, int64_t ldbb,
+    float* X, int64_t ldx,
+    size_t* work_size )
+{
+    sbgst_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, X, ldx, work_size );
+}
+
+// hbgst alias to sbgst
+inline int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float const* BB, int64_t ldbb,
+    float* X, int64_t ldx,
+    void* work, size_t work_size )
+{
+    return sbgst( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, X, ldx, work, work_size );
+}
+
+// hbgst_work_size_bytes alias to sbgst_work_size_bytes
+inline void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double const* BB, int64_t ldbb,
+    double* X, int64_t ldx,
+    size_t* work_size )
+{
+    sbgst_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, X, ldx, work_size );
+}
+
+// hbgst alias to sbgst
+inline int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double const* BB, int64_t ldbb,
+    double* X, int64_t ldx,
+    void* work, size_t work_size )
+{
+    return sbgst( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, X, ldx, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbgv_work_size_bytes alias to sbgv_work_size_bytes
+inline void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgv_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work_size );
+}
+
+// hbgv alias to sbgv
+inline int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbgv( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work, work_size );
+}
+
+// hbgv_work_size_bytes alias to sbgv_work_size_bytes
+inline void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgv_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work_size );
+}
+
+// hbgv alias to sbgv
+inline int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbgv( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hbgvd_work_size_bytes alias to sbgvd_work_size_bytes
+inline void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgvd_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work_size );
+}
+
+// hbgvd alias to sbgvd
+inline int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbgvd( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work, work_size );
+}
+
+// hbgvd_work_size_bytes alias to sbgvd_work_size_bytes
+inline void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgvd_work_size_bytes( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work_size );
+}
+
+// hbgvd alias to sbgvd
+inline int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return sbgvd( jobz, uplo, n, ka, kb, AB, ldab, BB, ldbb, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hbgvx_work_size_bytes alias to sbgvx_work_size_bytes
+inline void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgvx_work_size_bytes( jobz, range, uplo, n, ka, kb, AB, ldab, BB, ldbb, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbgvx alias to sbgvx
+inline int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float* BB, int64_t ldbb,
+    float* Q, int64_t ldq, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbgvx( jobz, range, uplo, n, ka, kb, AB, ldab, BB, ldbb, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hbgvx_work_size_bytes alias to sbgvx_work_size_bytes
+inline void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sbgvx_work_size_bytes( jobz, range, uplo, n, ka, kb, AB, ldab, BB, ldbb, Q, ldq, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hbgvx alias to sbgvx
+inline int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double* BB, int64_t ldbb,
+    double* Q, int64_t ldq, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sbgvx( jobz, range, uplo, n, ka, kb, AB, ldab, BB, ldbb, Q, ldq, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+// hbtrd_work_size_bytes alias to sbtrd_work_size_bytes
+inline void hbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    size_t* work_size )
+{
+    sbtrd_work_size_bytes( jobz, uplo, n, kd, AB, ldab, D, E, Q, ldq, work_size );
+}
+
+// hbtrd alias to sbtrd
+inline int64_t hbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    return sbtrd( jobz, uplo, n, kd, AB, ldab, D, E, Q, ldq, work, work_size );
+}
+
+// hbtrd_work_size_bytes alias to sbtrd_work_size_bytes
+inline void hbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    size_t* work_size )
+{
+    sbtrd_work_size_bytes( jobz, uplo, n, kd, AB, ldab, D, E, Q, ldq, work_size );
+}
+
+// hbtrd alias to sbtrd
+inline int64_t hbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    return sbtrd( jobz, uplo, n, kd, AB, ldab, D, E, Q, ldq, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spcon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+// hpcon_work_size_bytes alias to spcon_work_size_bytes
+inline void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP, float anorm,
+    size_t* work_size )
+{
+    spcon_work_size_bytes( uplo, n, AP, anorm, work_size );
+}
+
+// hpcon alias to spcon
+inline int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size )
+{
+    return spcon( uplo, n, AP, ipiv, anorm, rcond, work, work_size );
+}
+
+// hpcon_work_size_bytes alias to spcon_work_size_bytes
+inline void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP, double anorm,
+    size_t* work_size )
+{
+    spcon_work_size_bytes( uplo, n, AP, anorm, work_size );
+}
+
+// hpcon alias to spcon
+inline int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size )
+{
+    return spcon( uplo, n, AP, ipiv, anorm, rcond, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hpev_work_size_bytes alias to spev_work_size_bytes
+inline void hpev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spev_work_size_bytes( jobz, uplo, n, AP, W, Z, ldz, work_size );
+}
+
+// hpev alias to spev
+inline int64_t hpev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spev( jobz, uplo, n, AP, W, Z, ldz, work, work_size );
+}
+
+// hpev_work_size_bytes alias to spev_work_size_bytes
+inline void hpev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spev_work_size_bytes( jobz, uplo, n, AP, W, Z, ldz, work_size );
+}
+
+// hpev alias to spev
+inline int64_t hpev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spev( jobz, uplo, n, AP, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hpevd_work_size_bytes alias to spevd_work_size_bytes
+inline void hpevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spevd_work_size_bytes( jobz, uplo, n, AP, W, Z, ldz, work_size );
+}
+
+// hpevd alias to spevd
+inline int64_t hpevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spevd( jobz, uplo, n, AP, W, Z, ldz, work, work_size );
+}
+
+// hpevd_work_size_bytes alias to spevd_work_size_bytes
+inline void hpevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spevd_work_size_bytes( jobz, uplo, n, AP, W, Z, ldz, work_size );
+}
+
+// hpevd alias to spevd
+inline int64_t hpevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spevd( jobz, uplo, n, AP, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hpevx_work_size_bytes alias to spevx_work_size_bytes
+inline void hpevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* AP, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spevx_work_size_bytes( jobz, range, uplo, n, AP, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hpevx alias to spevx
+inline int64_t hpevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* AP, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return spevx( jobz, range, uplo, n, AP, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hpevx_work_size_bytes alias to spevx_work_size_bytes
+inline void hpevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* AP, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spevx_work_size_bytes( jobz, range, uplo, n, AP, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hpevx alias to spevx
+inline int64_t hpevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* AP, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return spevx( jobz, range, uplo, n, AP, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spgv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spgv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hpgv_work_size_bytes alias to spgv_work_size_bytes
+inline void hpgv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* BP,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgv_work_size_bytes( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work_size );
+}
+
+// hpgv alias to spgv
+inline int64_t hpgv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* BP,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spgv( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work, work_size );
+}
+
+// hpgv_work_size_bytes alias to spgv_work_size_bytes
+inline void hpgv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* BP,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgv_work_size_bytes( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work_size );
+}
+
+// hpgv alias to spgv
+inline int64_t hpgv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* BP,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spgv( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spgvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spgvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    scalar_t* BP,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+// hpgvd_work_size_bytes alias to spgvd_work_size_bytes
+inline void hpgvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* BP,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgvd_work_size_bytes( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work_size );
+}
+
+// hpgvd alias to spgvd
+inline int64_t hpgvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* AP,
+    float* BP,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spgvd( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work, work_size );
+}
+
+// hpgvd_work_size_bytes alias to spgvd_work_size_bytes
+inline void hpgvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* BP,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgvd_work_size_bytes( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work_size );
+}
+
+// hpgvd alias to spgvd
+inline int64_t hpgvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* AP,
+    double* BP,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    return spgvd( itype, jobz, uplo, n, AP, BP, W, Z, ldz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spgvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* AP,
+    scalar_t* BP, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spgvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* AP,
+    scalar_t* BP, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hpgvx_work_size_bytes alias to spgvx_work_size_bytes
+inline void hpgvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    float* AP,
+    float* BP, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgvx_work_size_bytes( itype, jobz, range, uplo, n, AP, BP, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hpgvx alias to spgvx
+inline int64_t hpgvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    float* AP,
+    float* BP, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return spgvx( itype, jobz, range, uplo, n, AP, BP, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hpgvx_work_size_bytes alias to spgvx_work_size_bytes
+inline void hpgvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    double* AP,
+    double* BP, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    spgvx_work_size_bytes( itype, jobz, range, uplo, n, AP, BP, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hpgvx alias to spgvx
+inline int64_t hpgvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    double* AP,
+    double* BP, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return spgvx( itype, jobz, range, uplo, n, AP, BP, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sprfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sprfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* AFP,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+// hprfs_work_size_bytes alias to sprfs_work_size_bytes
+inline void hprfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* AP,
+    float const* AFP,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size )
+{
+    sprfs_work_size_bytes( uplo, n, nrhs, AP, AFP, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hprfs alias to sprfs
+inline int64_t hprfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* AP,
+    float const* AFP,
+    int64_t const* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size )
+{
+    return sprfs( uplo, n, nrhs, AP, AFP, ipiv, B, ldb, X, ldx, ferr, berr, work, work_size );
+}
+
+// hprfs_work_size_bytes alias to sprfs_work_size_bytes
+inline void hprfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* AP,
+    double const* AFP,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size )
+{
+    sprfs_work_size_bytes( uplo, n, nrhs, AP, AFP, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hprfs alias to sprfs
+inline int64_t hprfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* AP,
+    double const* AFP,
+    int64_t const* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size )
+{
+    return sprfs( uplo, n, nrhs, AP, AFP, ipiv, B, ldb, X, ldx, ferr, berr, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void spsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t* AFP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t spsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t* AFP,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+// hpsvx_work_size_bytes alias to spsvx_work_size_bytes
+inline void hpsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* AP,
+    float* AFP,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size )
+{
+    spsvx_work_size_bytes( fact, uplo, n, nrhs, AP, AFP, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hpsvx alias to spsvx
+inline int64_t hpsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* AP,
+    float* AFP,
+    int64_t* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size )
+{
+    return spsvx( fact, uplo, n, nrhs, AP, AFP, ipiv, B, ldb, X, ldx, rcond, ferr, berr, work, work_size );
+}
+
+// hpsvx_work_size_bytes alias to spsvx_work_size_bytes
+inline void hpsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* AP,
+    double* AFP,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size )
+{
+    spsvx_work_size_bytes( fact, uplo, n, nrhs, AP, AFP, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hpsvx alias to spsvx
+inline int64_t hpsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* AP,
+    double* AFP,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size )
+{
+    return spsvx( fact, uplo, n, nrhs, AP, AFP, ipiv, B, ldb, X, ldx, rcond, ferr, berr, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sptri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+// hptri_work_size_bytes alias to sptri_work_size_bytes
+inline void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* AP,
+    size_t* work_size )
+{
+    sptri_work_size_bytes( uplo, n, AP, work_size );
+}
+
+// hptri alias to sptri
+inline int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    float* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sptri( uplo, n, AP, ipiv, work, work_size );
+}
+
+// hptri_work_size_bytes alias to sptri_work_size_bytes
+inline void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* AP,
+    size_t* work_size )
+{
+    sptri_work_size_bytes( uplo, n, AP, work_size );
+}
+
+// hptri alias to sptri
+inline int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    double* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sptri( uplo, n, AP, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stedc_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stegr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stegr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stein_work_size_bytes(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    blas::real_type<scalar_t> const* E, int64_t m,
+    blas::real_type<scalar_t> const* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stein(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    blas::real_type<scalar_t> const* E, int64_t m,
+    blas::real_type<scalar_t> const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stev_work_size_bytes(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stev(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stevd_work_size_bytes(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stevd(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t* D,
+    scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stevr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t* D,
+    scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void stevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t* D,
+    scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t stevx(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t* D,
+    scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sycon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sycon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+// hecon_work_size_bytes alias to sycon_work_size_bytes
+inline void hecon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda, float anorm,
+    size_t* work_size )
+{
+    sycon_work_size_bytes( uplo, n, A, lda, anorm, work_size );
+}
+
+// hecon alias to sycon
+inline int64_t hecon(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size )
+{
+    return sycon( uplo, n, A, lda, ipiv, anorm, rcond, work, work_size );
+}
+
+// hecon_work_size_bytes alias to sycon_work_size_bytes
+inline void hecon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda, double anorm,
+    size_t* work_size )
+{
+    sycon_work_size_bytes( uplo, n, A, lda, anorm, work_size );
+}
+
+// hecon alias to sycon
+inline int64_t hecon(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size )
+{
+    return sycon( uplo, n, A, lda, ipiv, anorm, rcond, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sycon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sycon_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+// hecon_rk_work_size_bytes alias to sycon_rk_work_size_bytes
+inline void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda,
+    float const* E, float anorm,
+    size_t* work_size )
+{
+    sycon_rk_work_size_bytes( uplo, n, A, lda, E, anorm, work_size );
+}
+
+// hecon_rk alias to sycon_rk
+inline int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda,
+    float const* E,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size )
+{
+    return sycon_rk( uplo, n, A, lda, E, ipiv, anorm, rcond, work, work_size );
+}
+
+// hecon_rk_work_size_bytes alias to sycon_rk_work_size_bytes
+inline void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda,
+    double const* E, double anorm,
+    size_t* work_size )
+{
+    sycon_rk_work_size_bytes( uplo, n, A, lda, E, anorm, work_size );
+}
+
+// hecon_rk alias to sycon_rk
+inline int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda,
+    double const* E,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size )
+{
+    return sycon_rk( uplo, n, A, lda, E, ipiv, anorm, rcond, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syequb(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    blas::real_type<scalar_t>* scond,
+    blas::real_type<scalar_t>* amax,
+    void* work, size_t work_size );
+
+// heequb_work_size_bytes alias to syequb_work_size_bytes
+inline void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda,
+    float* S,
+    size_t* work_size )
+{
+    syequb_work_size_bytes( uplo, n, A, lda, S, work_size );
+}
+
+// heequb alias to syequb
+inline int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda,
+    float* S,
+    float* scond,
+    float* amax,
+    void* work, size_t work_size )
+{
+    return syequb( uplo, n, A, lda, S, scond, amax, work, work_size );
+}
+
+// heequb_work_size_bytes alias to syequb_work_size_bytes
+inline void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda,
+    double* S,
+    size_t* work_size )
+{
+    syequb_work_size_bytes( uplo, n, A, lda, S, work_size );
+}
+
+// heequb alias to syequb
+inline int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda,
+    double* S,
+    double* scond,
+    double* amax,
+    void* work, size_t work_size )
+{
+    return syequb( uplo, n, A, lda, S, scond, amax, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// heev_work_size_bytes alias to syev_work_size_bytes
+inline void heev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* work_size )
+{
+    syev_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heev alias to syev
+inline int64_t heev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* work, size_t work_size )
+{
+    return syev( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+// heev_work_size_bytes alias to syev_work_size_bytes
+inline void heev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* work_size )
+{
+    syev_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heev alias to syev
+inline int64_t heev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* work, size_t work_size )
+{
+    return syev( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// heev_2stage_work_size_bytes alias to syev_2stage_work_size_bytes
+inline void heev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* work_size )
+{
+    syev_2stage_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heev_2stage alias to syev_2stage
+inline int64_t heev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* work, size_t work_size )
+{
+    return syev_2stage( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+// heev_2stage_work_size_bytes alias to syev_2stage_work_size_bytes
+inline void heev_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* work_size )
+{
+    syev_2stage_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heev_2stage alias to syev_2stage
+inline int64_t heev_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* work, size_t work_size )
+{
+    return syev_2stage( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// heevd_2stage_work_size_bytes alias to syevd_2stage_work_size_bytes
+inline void heevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* work_size )
+{
+    syevd_2stage_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heevd_2stage alias to syevd_2stage
+inline int64_t heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* work, size_t work_size )
+{
+    return syevd_2stage( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+// heevd_2stage_work_size_bytes alias to syevd_2stage_work_size_bytes
+inline void heevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* work_size )
+{
+    syevd_2stage_work_size_bytes( jobz, uplo, n, A, lda, W, work_size );
+}
+
+// heevd_2stage alias to syevd_2stage
+inline int64_t heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* work, size_t work_size )
+{
+    return syevd_2stage( jobz, uplo, n, A, lda, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syevr_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+// heevr_2stage_work_size_bytes alias to syevr_2stage_work_size_bytes
+inline void heevr_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevr_2stage_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevr_2stage alias to syevr_2stage
+inline int64_t heevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size )
+{
+    return syevr_2stage( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, work, work_size );
+}
+
+// heevr_2stage_work_size_bytes alias to syevr_2stage_work_size_bytes
+inline void heevr_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevr_2stage_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevr_2stage alias to syevr_2stage
+inline int64_t heevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size )
+{
+    return syevr_2stage( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// heevx_work_size_bytes alias to syevx_work_size_bytes
+inline void heevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevx_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevx alias to syevx
+inline int64_t heevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return syevx( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, ifail, work, work_size );
+}
+
+// heevx_work_size_bytes alias to syevx_work_size_bytes
+inline void heevx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevx_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevx alias to syevx
+inline int64_t heevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return syevx( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// heevx_2stage_work_size_bytes alias to syevx_2stage_work_size_bytes
+inline void heevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevx_2stage_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevx_2stage alias to syevx_2stage
+inline int64_t heevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return syevx_2stage( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, ifail, work, work_size );
+}
+
+// heevx_2stage_work_size_bytes alias to syevx_2stage_work_size_bytes
+inline void heevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    syevx_2stage_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// heevx_2stage alias to syevx_2stage
+inline int64_t heevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return syevx_2stage( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sygv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sygv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// hegv_work_size_bytes alias to sygv_work_size_bytes
+inline void hegv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    size_t* work_size )
+{
+    sygv_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegv alias to sygv
+inline int64_t hegv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    void* work, size_t work_size )
+{
+    return sygv( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+// hegv_work_size_bytes alias to sygv_work_size_bytes
+inline void hegv_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    size_t* work_size )
+{
+    sygv_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegv alias to sygv
+inline int64_t hegv(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    void* work, size_t work_size )
+{
+    return sygv( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sygv_2stage_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sygv_2stage(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// hegv_2stage_work_size_bytes alias to sygv_2stage_work_size_bytes
+inline void hegv_2stage_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    size_t* work_size )
+{
+    sygv_2stage_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegv_2stage alias to sygv_2stage
+inline int64_t hegv_2stage(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    void* work, size_t work_size )
+{
+    return sygv_2stage( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+// hegv_2stage_work_size_bytes alias to sygv_2stage_work_size_bytes
+inline void hegv_2stage_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    size_t* work_size )
+{
+    sygv_2stage_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegv_2stage alias to sygv_2stage
+inline int64_t hegv_2stage(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    void* work, size_t work_size )
+{
+    return sygv_2stage( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sygvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sygvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* W,
+    void* work, size_t work_size );
+
+// hegvd_work_size_bytes alias to sygvd_work_size_bytes
+inline void hegvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    size_t* work_size )
+{
+    sygvd_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegvd alias to sygvd
+inline int64_t hegvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* W,
+    void* work, size_t work_size )
+{
+    return sygvd( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+// hegvd_work_size_bytes alias to sygvd_work_size_bytes
+inline void hegvd_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    size_t* work_size )
+{
+    sygvd_work_size_bytes( itype, jobz, uplo, n, A, lda, B, ldb, W, work_size );
+}
+
+// hegvd alias to sygvd
+inline int64_t hegvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* W,
+    void* work, size_t work_size )
+{
+    return sygvd( itype, jobz, uplo, n, A, lda, B, ldb, W, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sygvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sygvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+// hegvx_work_size_bytes alias to sygvx_work_size_bytes
+inline void hegvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sygvx_work_size_bytes( itype, jobz, range, uplo, n, A, lda, B, ldb, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hegvx alias to sygvx
+inline int64_t hegvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sygvx( itype, jobz, range, uplo, n, A, lda, B, ldb, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+// hegvx_work_size_bytes alias to sygvx_work_size_bytes
+inline void hegvx_work_size_bytes(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size )
+{
+    sygvx_work_size_bytes( itype, jobz, range, uplo, n, A, lda, B, ldb, vl, vu, il, iu, abstol, W, Z, ldz, work_size );
+}
+
+// hegvx alias to sygvx
+inline int64_t hegvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    return sygvx( itype, jobz, range, uplo, n, A, lda, B, ldb, vl, vu, il, iu, abstol, m, W, Z, ldz, ifail, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syrfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syrfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+// herfs_work_size_bytes alias to syrfs_work_size_bytes
+inline void herfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size )
+{
+    syrfs_work_size_bytes( uplo, n, nrhs, A, lda, AF, ldaf, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// herfs alias to syrfs
+inline int64_t herfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size )
+{
+    return syrfs( uplo, n, nrhs, A, lda, AF, ldaf, ipiv, B, ldb, X, ldx, ferr, berr, work, work_size );
+}
+
+// herfs_work_size_bytes alias to syrfs_work_size_bytes
+inline void herfs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size )
+{
+    syrfs_work_size_bytes( uplo, n, nrhs, A, lda, AF, ldaf, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// herfs alias to syrfs
+inline int64_t herfs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size )
+{
+    return syrfs( uplo, n, nrhs, A, lda, AF, ldaf, ipiv, B, ldb, X, ldx, ferr, berr, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void syrfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t syrfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size );
+
+// herfsx_work_size_bytes alias to syrfsx_work_size_bytes
+inline void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    float* S,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size )
+{
+    syrfsx_work_size_bytes( uplo, equed, n, nrhs, A, lda, AF, ldaf, S, B, ldb, X, ldx, berr, n_err_bnds, err_bnds_norm, err_bnds_comp, nparams, params, work_size );
+}
+
+// herfsx alias to syrfsx
+inline int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float* S,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size )
+{
+    return syrfsx( uplo, equed, n, nrhs, A, lda, AF, ldaf, ipiv, S, B, ldb, X, ldx, rcond, berr, n_err_bnds, err_bnds_norm, err_bnds_comp, nparams, params, work, work_size );
+}
+
+// herfsx_work_size_bytes alias to syrfsx_work_size_bytes
+inline void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    double* S,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size )
+{
+    syrfsx_work_size_bytes( uplo, equed, n, nrhs, A, lda, AF, ldaf, S, B, ldb, X, ldx, berr, n_err_bnds, err_bnds_norm, err_bnds_comp, nparams, params, work_size );
+}
+
+// herfsx alias to syrfsx
+inline int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double* S,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size )
+{
+    return syrfsx( uplo, equed, n, nrhs, A, lda, AF, ldaf, ipiv, S, B, ldb, X, ldx, rcond, berr, n_err_bnds, err_bnds_norm, err_bnds_comp, nparams, params, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sysv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sysv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hesv_work_size_bytes alias to sysv_work_size_bytes
+inline void hesv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv alias to sysv
+inline int64_t hesv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+// hesv_work_size_bytes alias to sysv_work_size_bytes
+inline void hesv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv alias to sysv
+inline int64_t hesv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sysv_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sysv_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hesv_aa_work_size_bytes alias to sysv_aa_work_size_bytes
+inline void hesv_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_aa_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv_aa alias to sysv_aa
+inline int64_t hesv_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_aa( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+// hesv_aa_work_size_bytes alias to sysv_aa_work_size_bytes
+inline void hesv_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_aa_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv_aa alias to sysv_aa
+inline int64_t hesv_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_aa( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sysv_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sysv_rk(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hesv_rk_work_size_bytes alias to sysv_rk_work_size_bytes
+inline void hesv_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* E,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_rk_work_size_bytes( uplo, n, nrhs, A, lda, E, B, ldb, work_size );
+}
+
+// hesv_rk alias to sysv_rk
+inline int64_t hesv_rk(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* E,
+    int64_t* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_rk( uplo, n, nrhs, A, lda, E, ipiv, B, ldb, work, work_size );
+}
+
+// hesv_rk_work_size_bytes alias to sysv_rk_work_size_bytes
+inline void hesv_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* E,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_rk_work_size_bytes( uplo, n, nrhs, A, lda, E, B, ldb, work_size );
+}
+
+// hesv_rk alias to sysv_rk
+inline int64_t hesv_rk(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* E,
+    int64_t* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_rk( uplo, n, nrhs, A, lda, E, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sysv_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sysv_rook(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hesv_rook_work_size_bytes alias to sysv_rook_work_size_bytes
+inline void hesv_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_rook_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv_rook alias to sysv_rook
+inline int64_t hesv_rook(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_rook( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+// hesv_rook_work_size_bytes alias to sysv_rook_work_size_bytes
+inline void hesv_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sysv_rook_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hesv_rook alias to sysv_rook
+inline int64_t hesv_rook(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sysv_rook( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sysvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sysvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+// hesvx_work_size_bytes alias to sysvx_work_size_bytes
+inline void hesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float* AF, int64_t ldaf,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size )
+{
+    sysvx_work_size_bytes( fact, uplo, n, nrhs, A, lda, AF, ldaf, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hesvx alias to sysvx
+inline int64_t hesvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float* AF, int64_t ldaf,
+    int64_t* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size )
+{
+    return sysvx( fact, uplo, n, nrhs, A, lda, AF, ldaf, ipiv, B, ldb, X, ldx, rcond, ferr, berr, work, work_size );
+}
+
+// hesvx_work_size_bytes alias to sysvx_work_size_bytes
+inline void hesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double* AF, int64_t ldaf,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size )
+{
+    sysvx_work_size_bytes( fact, uplo, n, nrhs, A, lda, AF, ldaf, B, ldb, X, ldx, ferr, berr, work_size );
+}
+
+// hesvx alias to sysvx
+inline int64_t hesvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double* AF, int64_t ldaf,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size )
+{
+    return sysvx( fact, uplo, n, nrhs, A, lda, AF, ldaf, ipiv, B, ldb, X, ldx, rcond, ferr, berr, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrd(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+// hetrd_work_size_bytes alias to sytrd_work_size_bytes
+inline void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    size_t* work_size )
+{
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, work_size );
+}
+
+// hetrd alias to sytrd
+inline int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    void* work, size_t work_size )
+{
+    return sytrd( uplo, n, A, lda, D, E, tau, work, work_size );
+}
+
+// hetrd_work_size_bytes alias to sytrd_work_size_bytes
+inline void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    size_t* work_size )
+{
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, work_size );
+}
+
+// hetrd alias to sytrd
+inline int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    void* work, size_t work_size )
+{
+    return sytrd( uplo, n, A, lda, D, E, tau, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* tau,
+    scalar_t* hous2, int64_t lhous2,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* tau,
+    scalar_t* hous2, int64_t lhous2,
+    void* work, size_t work_size );
+
+// hetrd_2stage_work_size_bytes alias to sytrd_2stage_work_size_bytes
+inline void hetrd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    float* hous2, int64_t lhous2,
+    size_t* work_size )
+{
+    sytrd_2stage_work_size_bytes( jobz, uplo, n, A, lda, D, E, tau, hous2, lhous2, work_size );
+}
+
+// hetrd_2stage alias to sytrd_2stage
+inline int64_t hetrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    float* hous2, int64_t lhous2,
+    void* work, size_t work_size )
+{
+    return sytrd_2stage( jobz, uplo, n, A, lda, D, E, tau, hous2, lhous2, work, work_size );
+}
+
+// hetrd_2stage_work_size_bytes alias to sytrd_2stage_work_size_bytes
+inline void hetrd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    double* hous2, int64_t lhous2,
+    size_t* work_size )
+{
+    sytrd_2stage_work_size_bytes( jobz, uplo, n, A, lda, D, E, tau, hous2, lhous2, work_size );
+}
+
+// hetrd_2stage alias to sytrd_2stage
+inline int64_t hetrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    double* hous2, int64_t lhous2,
+    void* work, size_t work_size )
+{
+    return sytrd_2stage( jobz, uplo, n, A, lda, D, E, tau, hous2, lhous2, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+// hetrf_work_size_bytes alias to sytrf_work_size_bytes
+inline void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+// hetrf_work_size_bytes alias to sytrf_work_size_bytes
+inline void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrf_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrf_aa(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+// hetrf_aa_work_size_bytes alias to sytrf_aa_work_size_bytes
+inline void hetrf_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_aa_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf_aa alias to sytrf_aa
+inline int64_t hetrf_aa(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_aa( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+// hetrf_aa_work_size_bytes alias to sytrf_aa_work_size_bytes
+inline void hetrf_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_aa_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf_aa alias to sytrf_aa
+inline int64_t hetrf_aa(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_aa( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrf_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrf_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+// hetrf_rk_work_size_bytes alias to sytrf_rk_work_size_bytes
+inline void hetrf_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* E,
+    size_t* work_size )
+{
+    sytrf_rk_work_size_bytes( uplo, n, A, lda, E, work_size );
+}
+
+// hetrf_rk alias to sytrf_rk
+inline int64_t hetrf_rk(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* E,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_rk( uplo, n, A, lda, E, ipiv, work, work_size );
+}
+
+// hetrf_rk_work_size_bytes alias to sytrf_rk_work_size_bytes
+inline void hetrf_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* E,
+    size_t* work_size )
+{
+    sytrf_rk_work_size_bytes( uplo, n, A, lda, E, work_size );
+}
+
+// hetrf_rk alias to sytrf_rk
+inline int64_t hetrf_rk(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* E,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_rk( uplo, n, A, lda, E, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrf_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrf_rook(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+// hetrf_rook_work_size_bytes alias to sytrf_rook_work_size_bytes
+inline void hetrf_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_rook_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf_rook alias to sytrf_rook
+inline int64_t hetrf_rook(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_rook( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+// hetrf_rook_work_size_bytes alias to sytrf_rook_work_size_bytes
+inline void hetrf_rook_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size )
+{
+    sytrf_rook_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetrf_rook alias to sytrf_rook
+inline int64_t hetrf_rook(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    return sytrf_rook( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+// hetri_work_size_bytes alias to sytri_work_size_bytes
+inline void hetri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size )
+{
+    sytri_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetri alias to sytri
+inline int64_t hetri(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+// hetri_work_size_bytes alias to sytri_work_size_bytes
+inline void hetri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size )
+{
+    sytri_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetri alias to sytri
+inline int64_t hetri(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytri2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytri2(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+// hetri2_work_size_bytes alias to sytri2_work_size_bytes
+inline void hetri2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size )
+{
+    sytri2_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetri2 alias to sytri2
+inline int64_t hetri2(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri2( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+// hetri2_work_size_bytes alias to sytri2_work_size_bytes
+inline void hetri2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size )
+{
+    sytri2_work_size_bytes( uplo, n, A, lda, work_size );
+}
+
+// hetri2 alias to sytri2
+inline int64_t hetri2(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri2( uplo, n, A, lda, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytri_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* E,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytri_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+// hetri_rk_work_size_bytes alias to sytri_rk_work_size_bytes
+inline void hetri_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float const* E,
+    size_t* work_size )
+{
+    sytri_rk_work_size_bytes( uplo, n, A, lda, E, work_size );
+}
+
+// hetri_rk alias to sytri_rk
+inline int64_t hetri_rk(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float const* E,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri_rk( uplo, n, A, lda, E, ipiv, work, work_size );
+}
+
+// hetri_rk_work_size_bytes alias to sytri_rk_work_size_bytes
+inline void hetri_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double const* E,
+    size_t* work_size )
+{
+    sytri_rk_work_size_bytes( uplo, n, A, lda, E, work_size );
+}
+
+// hetri_rk alias to sytri_rk
+inline int64_t hetri_rk(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double const* E,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    return sytri_rk( uplo, n, A, lda, E, ipiv, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrs2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrs2(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t const* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hetrs2_work_size_bytes alias to sytrs2_work_size_bytes
+inline void hetrs2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sytrs2_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hetrs2 alias to sytrs2
+inline int64_t hetrs2(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    int64_t const* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sytrs2( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+// hetrs2_work_size_bytes alias to sytrs2_work_size_bytes
+inline void hetrs2_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sytrs2_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hetrs2 alias to sytrs2
+inline int64_t hetrs2(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t const* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sytrs2( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sytrs_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t sytrs_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+// hetrs_aa_work_size_bytes alias to sytrs_aa_work_size_bytes
+inline void hetrs_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size )
+{
+    sytrs_aa_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hetrs_aa alias to sytrs_aa
+inline int64_t hetrs_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    int64_t const* ipiv,
+    float* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sytrs_aa( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+// hetrs_aa_work_size_bytes alias to sytrs_aa_work_size_bytes
+inline void hetrs_aa_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size )
+{
+    sytrs_aa_work_size_bytes( uplo, n, nrhs, A, lda, B, ldb, work_size );
+}
+
+// hetrs_aa alias to sytrs_aa
+inline int64_t hetrs_aa(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    int64_t const* ipiv,
+    double* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    return sytrs_aa( uplo, n, nrhs, A, lda, ipiv, B, ldb, work, work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tbcon_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tbcon(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* C, int64_t ldc,
+    scalar_t const* D, int64_t ldd,
+    scalar_t const* E, int64_t lde,
+    scalar_t* F, int64_t ldf,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* C, int64_t ldc,
+    scalar_t const* D, int64_t ldd,
+    scalar_t const* E, int64_t lde,
+    scalar_t* F, int64_t ldf,
+    blas::real_type<scalar_t>* dif,
+    blas::real_type<scalar_t>* scale,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tpcon_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tpcon(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tpmlqt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t mb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tpmlqt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t mb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tprfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tprfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t nrhs,
+    scalar_t const* AP,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trcon_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* A, int64_t lda,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trcon(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+// Only real precisions; [cz]trexc have no workspace.
+template <typename scalar_t>
+void trexc_work_size_bytes(
+    lapack::Job compq, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trexc(
+    lapack::Job compq, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    int64_t* ifst,
+    int64_t* ilst,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    blas::complex_type<scalar_t>* W,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    blas::complex_type<scalar_t>* W,
+    int64_t* m,
+    blas::real_type<scalar_t>* s,
+    blas::real_type<scalar_t>* sep,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tzrzf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t tzrzf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ungbr_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ungbr(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unghr_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unghr(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unglq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unglq(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ungql_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ungql(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ungrq_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ungrq(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void ungtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t ungtr(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmhr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmhr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t ilo,
+    int64_t ihi,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmlq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmql_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmrq_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmrq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmrz_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmrz(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t unmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void upgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t upgtr(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void upmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size );
+
+template <typename scalar_t>
+int64_t upmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size );
+
+}  // namespace lapack
+
+#endif // LAPACK_WORK_HH
@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_WORKSPACE_HH
+#define LAPACK_WORKSPACE_HH
+
+#include <cstddef>
+
+namespace lapack {
+
+//==============================================================================
+/// Per-thread workspace arena.
+///
+/// By default, each LAPACK++ wrapper allocates its workspace (work, iwork,
+/// rwork, and 32-bit copies of integer arrays) from the heap on every call.
+/// When the arena is enabled on a thread, wrappers called on that thread
+/// instead take workspace from a thread-local buffer. The buffer grows to
+/// the high-water mark of the workspace requested, so once a call has been
+/// made, repeated calls of the same or smaller size do no heap allocation.
+///
+/// The arena is opt-in and must be enabled on each thread that uses it.
+///
+/// Independent of the arena, workspace arrays small enough to fit in a
+/// fixed-size on-stack buffer are put there instead of being allocated;
+/// see set_stack_threshold(). Workspace that is allocated comes from the
+/// heap by default, or from a custom Allocator; see set_allocator().
+///
+/// @ingroup workspace
+namespace workspace {
+
+void enable( bool enabled=true );
+
+bool enabled();
+
+size_t size();
+
+size_t high_water();
+
+void reserve( size_t bytes );
+
+void release();
+
+void set_stack_threshold( size_t bytes );
+
+size_t stack_threshold();
+
+}  // namespace workspace
+}  // namespace lapack
+
+#endif // LAPACK_WORKSPACE_HH
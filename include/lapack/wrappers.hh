@@ -424,6 +424,32 @@ int64_t gbsv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t gbsv(
+    int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    float* AB, int64_t ldab,
+    lapack_int* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gbsv(
+    int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    double* AB, int64_t ldab,
+    lapack_int* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gbsv(
+    int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<float>* AB, int64_t ldab,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gbsv(
+    int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<double>* AB, int64_t ldab,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gbsvx(
     lapack::Factored fact, lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
@@ -502,6 +528,28 @@ int64_t gbtrf(
     std::complex<double>* AB, int64_t ldab,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float>* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double>* AB, int64_t ldab,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gbtrs(
     lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
@@ -527,6 +575,32 @@ int64_t gbtrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gebak(
     lapack::Balance balance, lapack::Side side, int64_t n, int64_t ilo, int64_t ihi,
@@ -1523,6 +1597,48 @@ int64_t gesv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter );
 
+#ifndef LAPACK_ILP64
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gesvx(
     lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
@@ -1688,6 +1804,28 @@ int64_t getrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t getrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getrf2(
     int64_t m, int64_t n,
@@ -1709,6 +1847,28 @@ int64_t getrf2(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t getrf2(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf2(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf2(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf2(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getri(
     int64_t n,
@@ -1730,6 +1890,28 @@ int64_t getri(
     std::complex<double>* A, int64_t lda,
     int64_t const* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t getri(
+    int64_t n,
+    float* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    double* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int const* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getrs(
     lapack::Op trans, int64_t n, int64_t nrhs,
@@ -1755,6 +1937,32 @@ int64_t getrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getsls(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
@@ -2515,6 +2723,40 @@ int64_t gttrf(
     std::complex<double>* DU2,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t gttrf(
+    int64_t n,
+    float* DL,
+    float* D,
+    float* DU,
+    float* DU2,
+    lapack_int* ipiv );
+
+int64_t gttrf(
+    int64_t n,
+    double* DL,
+    double* D,
+    double* DU,
+    double* DU2,
+    lapack_int* ipiv );
+
+int64_t gttrf(
+    int64_t n,
+    std::complex<float>* DL,
+    std::complex<float>* D,
+    std::complex<float>* DU,
+    std::complex<float>* DU2,
+    lapack_int* ipiv );
+
+int64_t gttrf(
+    int64_t n,
+    std::complex<double>* DL,
+    std::complex<double>* D,
+    std::complex<double>* DU,
+    std::complex<double>* DU2,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gttrs(
     lapack::Op trans, int64_t n, int64_t nrhs,
@@ -2552,6 +2794,44 @@ int64_t gttrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t gttrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DU2,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gttrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DU2,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gttrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DU2,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gttrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DU2,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hbev(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
@@ -3009,6 +3289,20 @@ int64_t hesv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t hesv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t hesv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hesvx(
     lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -3125,6 +3419,18 @@ int64_t hetrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hetrf_aa(
     lapack::Uplo uplo, int64_t n,
@@ -3209,6 +3515,20 @@ int64_t hetrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hetrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -3511,6 +3831,18 @@ int64_t hptrf(
     std::complex<double>* AP,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t hptrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* AP,
+    lapack_int* ipiv );
+
+int64_t hptrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* AP,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hptri(
     lapack::Uplo uplo, int64_t n,
@@ -3535,6 +3867,20 @@ int64_t hptrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t hptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* AP,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t hptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* AP,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hseqr(
     lapack::JobSchur jobschur, lapack::Job compz, int64_t n, int64_t ilo, int64_t ihi,
@@ -3612,6 +3958,26 @@ void lacpy(
     std::complex<double> const* A, int64_t lda,
     std::complex<double>* B, int64_t ldb );
 
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    float alpha, float const* A, int64_t lda,
+    float* B, int64_t ldb );
+
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    double alpha, double const* A, int64_t lda,
+    double* B, int64_t ldb );
+
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<float> alpha, std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb );
+
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<double> alpha, std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb );
+
 // -----------------------------------------------------------------------------
 int64_t laed4(
     int64_t n, int64_t i,
@@ -4038,6 +4404,30 @@ void lapmr(
     std::complex<double>* X, int64_t ldx,
     int64_t* K );
 
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy );
+
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy );
+
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy );
+
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy );
+
 // -----------------------------------------------------------------------------
 void lapmt(
     bool forwrd, int64_t m, int64_t n,
@@ -4059,6 +4449,30 @@ void lapmt(
     std::complex<double>* X, int64_t ldx,
     int64_t* K );
 
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy );
+
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy );
+
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy );
+
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy );
+
 // -----------------------------------------------------------------------------
 float lapy2(
     float x, float y );
@@ -4370,6 +4784,26 @@ void lassq(
     double* sumsq );
 
 // -----------------------------------------------------------------------------
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx );
+
 void laswp(
     int64_t n,
     float* A, int64_t lda, int64_t k1, int64_t k2,
@@ -4390,6 +4824,48 @@ void laswp(
     std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx );
 
+#ifndef LAPACK_ILP64
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t lauum(
     lapack::Uplo uplo, int64_t n,
@@ -7089,6 +7565,28 @@ int64_t sptrf(
     std::complex<double>* AP,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t sptrf(
+    lapack::Uplo uplo, int64_t n,
+    float* AP,
+    lapack_int* ipiv );
+
+int64_t sptrf(
+    lapack::Uplo uplo, int64_t n,
+    double* AP,
+    lapack_int* ipiv );
+
+int64_t sptrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* AP,
+    lapack_int* ipiv );
+
+int64_t sptrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* AP,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sptri(
     lapack::Uplo uplo, int64_t n,
@@ -7173,6 +7671,32 @@ int64_t sptrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t sptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* AP,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t sptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* AP,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t sptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* AP,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t sptrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* AP,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t stedc(
     lapack::Job compz, int64_t n,
@@ -7423,6 +7947,22 @@ int64_t sturm(
     int64_t n, scalar_t const* diag,
     scalar_t const* offd, scalar_t u);
 
+template <typename scalar_t>
+void sturm(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshifts, scalar_t const* u, int64_t* count );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t tridiag_bisect(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz );
+
 // -----------------------------------------------------------------------------
 int64_t sycon(
     lapack::Uplo uplo, int64_t n,
@@ -8270,6 +8810,32 @@ int64_t sysv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t sysv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb );
+
+int64_t sysv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb );
+
+int64_t sysv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t sysv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sysv_aa(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -8636,6 +9202,28 @@ int64_t sytrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sytrf_aa(
     lapack::Uplo uplo, int64_t n,
@@ -8928,6 +9516,32 @@ int64_t sytrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sytrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -6,26 +6,76 @@
 #ifndef LAPACK_NO_CONSTRUCT_ALLOCATOR_HH
 #define LAPACK_NO_CONSTRUCT_ALLOCATOR_HH
 
-#include <cstddef>  // std::size_t
-#include <limits>   // std::numeric_limits
-#include <new>      // std::bad_alloc, std::bad_array_new_length
-#include <vector>   // std::vector
+#include <algorithm>  // std::copy
+#include <atomic>     // std::atomic
+#include <cstddef>    // std::size_t
+#include <iterator>   // std::distance
+#include <limits>     // std::numeric_limits
+#include <new>        // std::bad_alloc, std::bad_array_new_length
+#include <vector>     // std::vector
 #if defined( _WIN32 ) || defined( _WIN64 )
 #   include <malloc.h>  // _aligned_malloc, _aligned_free
 #else
 #   include <stdlib.h>  // posix_memalign, free
 #endif
 
+// Capacity, in bytes, of each small_vector's on-stack buffer.
+// Set to 0 to always use the heap (or workspace arena).
+#ifndef LAPACK_SMALL_BUFFER_BYTES
+#define LAPACK_SMALL_BUFFER_BYTES 1024
+#endif
+
+// Name of the function calling the function whose default argument this is,
+// used to attribute workspace to the wrapper that allocated it.
+#ifndef LAPACK_CALLER_FUNCTION
+    #if defined( __has_builtin )
+        #if __has_builtin( __builtin_FUNCTION )
+            #define LAPACK_CALLER_FUNCTION __builtin_FUNCTION()
+        #endif
+    #elif defined( __GNUC__ ) && __GNUC__ >= 5
+        #define LAPACK_CALLER_FUNCTION __builtin_FUNCTION()
+    #endif
+#endif
+#ifndef LAPACK_CALLER_FUNCTION
+    #define LAPACK_CALLER_FUNCTION nullptr
+#endif
+
 namespace lapack {
+namespace internal {
+
+// Aligned heap allocation; see workspace.cc.
+void* aligned_malloc( std::size_t bytes );
+void  aligned_free( void* ptr ) noexcept;
+
+// Allocates from the thread's workspace arena if enabled, else the current
+// allocator (see workspace::set_allocator). routine is the caller's name,
+// passed to the allocator, or nullptr if unknown.
+void* workspace_allocate( std::size_t bytes, const char* routine );
+void  workspace_deallocate( void* ptr, std::size_t bytes ) noexcept;
+
+// Arrays up to this many bytes use small_vector's on-stack buffer;
+// see workspace::set_stack_threshold.
+extern std::atomic< std::size_t > stack_threshold;
+
+}  // namespace internal
 
 // No-construct allocator type which allocates / deallocates.
+// routine defaults to the name of the function constructing the allocator,
+// which for lapack::vector< T > work( n ) is the calling wrapper, for
+// allocators that count per routine.
 template <typename T>
 struct NoConstructAllocator
 {
     using value_type = T;
 
-    NoConstructAllocator () = default;
-    //template <class U> constexpr NoConstructAllocator (const NoConstructAllocator <U>&) noexcept {}
+    explicit NoConstructAllocator( const char* routine = LAPACK_CALLER_FUNCTION ):
+        routine_( routine )
+    {}
+
+    template <typename U>
+    NoConstructAllocator( NoConstructAllocator<U> const& other ):
+        routine_( other.routine() )
+    {}
 
     // Construction given an allocated pointer is a null-op.
     //
@@ -43,32 +93,19 @@ struct NoConstructAllocator
         if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
             throw std::bad_array_new_length();
 
-        void* memPtr = nullptr;
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            memPtr = _aligned_malloc( n*sizeof(T), 64 );
-            if (memPtr != nullptr) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #else
-            int err = posix_memalign( &memPtr, 64, n*sizeof(T) );
-            if (err == 0) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #endif
-
-        throw std::bad_alloc();
+        return static_cast<T*>(
+            internal::workspace_allocate( n*sizeof(T), routine_ ) );
     }
 
     void deallocate(T* p, std::size_t n) noexcept
     {
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            _aligned_free( p );
-        #else
-            free( p );
-        #endif
+        internal::workspace_deallocate( p, n*sizeof(T) );
     }
+
+    const char* routine() const { return routine_; }
+
+private:
+    const char* routine_;
 };
 
 template <class T, class U>
@@ -86,6 +123,77 @@ bool operator!=(const NoConstructAllocator <T>&, const NoConstructAllocator <U>&
 template <typename T>
 using vector = std::vector< T, NoConstructAllocator<T> >;
 
+//------------------------------------------------------------------------------
+// Fixed-size workspace array that is in an on-stack buffer if it fits,
+// otherwise allocated like lapack::vector. For tiny problems, this avoids
+// a heap allocation in each call. Like lapack::vector, elements are not
+// initialized, except when constructed from a range.
+// Provides the subset of std::vector used by the wrappers.
+template <typename T, std::size_t nbytes = LAPACK_SMALL_BUFFER_BYTES>
+class small_vector
+{
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    // routine defaults to the name of the calling wrapper, for allocators
+    // that count per routine.
+    explicit small_vector( std::size_t n,
+                           const char* routine = LAPACK_CALLER_FUNCTION ):
+        data_( reinterpret_cast<T*>( buffer_ ) ),
+        size_( n )
+    {
+        if (n > nbytes / sizeof(T)
+            || n*sizeof(T) > internal::stack_threshold.load( std::memory_order_relaxed ))
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            data_ = static_cast<T*>(
+                internal::workspace_allocate( n*sizeof(T), routine ) );
+        }
+    }
+
+    // Copies [first, last), e.g., a 32-bit copy of an int64_t array.
+    template <typename InputIterator>
+    small_vector( InputIterator first, InputIterator last,
+                  const char* routine = LAPACK_CALLER_FUNCTION ):
+        small_vector( std::distance( first, last ), routine )
+    {
+        std::copy( first, last, data_ );
+    }
+
+    ~small_vector()
+    {
+        if (! on_stack())
+            internal::workspace_deallocate( data_, size_*sizeof(T) );
+    }
+
+    // Disable copying.
+    small_vector( small_vector const& ) = delete;
+    small_vector& operator=( small_vector const& ) = delete;
+
+    T&       operator[]( std::size_t i )       { return data_[ i ]; }
+    T const& operator[]( std::size_t i ) const { return data_[ i ]; }
+
+    T*       data()        { return data_; }
+    T const* data()  const { return data_; }
+    T*       begin()       { return data_; }
+    T const* begin() const { return data_; }
+    T*       end()         { return data_ + size_; }
+    T const* end()   const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+    bool on_stack() const
+        { return data_ == reinterpret_cast<T const*>( buffer_ ); }
+
+private:
+    // At least one element, since zero-length arrays aren't allowed.
+    alignas( T ) char buffer_[ nbytes > sizeof(T) ? nbytes : sizeof(T) ];
+    T* data_;
+    std::size_t size_;
+};
+
 }  // namespace lapack
 
 #endif  // LAPACK_NO_CONSTRUCT_ALLOCATOR_HH
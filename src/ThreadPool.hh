@@ -0,0 +1,46 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_THREAD_POOL_HH
+#define LAPACK_THREAD_POOL_HH
+
+#include <cstdint>
+#include <functional>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Calls body( i, worker ) for i in [0, n), spread dynamically over the
+// LAPACK++ thread pool; see lapack::set_num_threads. The calling thread
+// participates as worker 0; worker is in [0, num_threads()), and no two
+// concurrent calls of body in one parallel_for have the same worker,
+// so body can index per-worker workspace by it.
+//
+// While running body, BLAS and LAPACK are limited to one thread where the
+// library has a per-thread setting (MKL, OpenMP, OpenBLAS >= 0.3.27), so
+// the tiny calls inside don't oversubscribe cores. Older OpenBLAS and BLIS
+// are limited only if $LAPACKPP_BLAS_THREADS_GLOBAL is set; see
+// lapack::set_num_threads.
+//
+// Runs serially on the calling thread (worker 0) if n is small, the pool
+// has one thread, it is busy with another parallel_for, or this is called
+// from inside body. Blocks until all iterations finish. If body throws,
+// remaining iterations are skipped and the first exception is rethrown.
+void parallel_for(
+    int64_t n, std::function< void (int64_t i, int worker) > const& body );
+
+// Number of workers parallel_for may use, including the calling thread.
+int num_threads();
+
+// Sets the number of threads BLAS and LAPACK use on the calling thread,
+// for libraries that support it.
+// @return previous number, to restore; or 0 if not supported.
+int set_blas_threads_local( int nthreads );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_THREAD_POOL_HH
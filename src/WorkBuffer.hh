@@ -0,0 +1,99 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_WORK_BUFFER_HH
+#define LAPACK_WORK_BUFFER_HH
+
+#include "lapack/util.hh"
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uintptr_t
+#include <limits>   // std::numeric_limits
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Lays out typed workspace arrays (work, rwork, iwork, ...) in one untyped,
+/// caller-provided buffer. Each array starts on a cache line.
+///
+/// The same sequence of take() calls is used first without a buffer,
+/// to compute the size in bytes for *_work_size_bytes, then with the
+/// caller's buffer, to get the arrays. Putting the queried array (usually
+/// work) last lets it use whatever is left of the buffer, via remaining().
+class WorkBuffer
+{
+public:
+    static const std::size_t align = 64;
+
+    /// Sizing only; take() returns nullptr.
+    WorkBuffer():
+        base_( nullptr ),
+        size_( std::numeric_limits<std::size_t>::max() ),
+        used_( 0 )
+    {}
+
+    /// Carves arrays from work, which has work_size bytes.
+    WorkBuffer( void* work, std::size_t work_size ):
+        base_( static_cast<char*>( work ) ),
+        size_( 0 ),
+        used_( 0 )
+    {
+        lapack_error_if( work == nullptr && work_size > 0 );
+        std::size_t offset = (align - std::uintptr_t( work ) % align) % align;
+        if (offset <= work_size) {
+            base_ += offset;
+            size_ = work_size - offset;
+        }
+    }
+
+    /// Takes an array of n elements of type T.
+    /// @return pointer to array, or nullptr if sizing only.
+    /// @throws Error if the buffer is too small.
+    template <typename T>
+    T* take( int64_t n )
+    {
+        std::size_t bytes = std::max( n, int64_t( 0 ) ) * sizeof(T);
+        lapack_error_if( bytes > size_ - used_ );
+        T* ptr = nullptr;
+        if (base_ != nullptr)
+            ptr = reinterpret_cast<T*>( base_ + used_ );
+        // Padding after the last array needn't fit in the buffer.
+        used_ += std::min( roundup( bytes ), size_ - used_ );
+        return ptr;
+    }
+
+    /// @return number of elements of type T that fit in the rest of the
+    /// buffer, limited to what lapack_int can hold.
+    template <typename T>
+    lapack_int remaining() const
+    {
+        std::size_t n = (size_ - used_) / sizeof(T);
+        return (lapack_int) std::min(
+            n, std::size_t( std::numeric_limits<lapack_int>::max() ) );
+    }
+
+    /// @return bytes the caller must provide for the arrays taken so far,
+    /// including slack to align an arbitrary buffer.
+    std::size_t bytes() const
+    {
+        return used_ + align - 1;
+    }
+
+private:
+    static std::size_t roundup( std::size_t bytes )
+    {
+        return (bytes + align - 1) / align * align;
+    }
+
+    char* base_;
+    std::size_t size_;  ///< usable bytes after aligning base_
+    std::size_t used_;
+};
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_WORK_BUFFER_HH
@@ -0,0 +1,330 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/allocator.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#if defined( __linux__ )
+    #include <sys/mman.h>  // mmap, munmap, madvise
+#endif
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Allocator set by set_allocator, and by set_thread_allocator,
+// which takes precedence. nullptr means use the default heap allocator.
+std::atomic< workspace::Allocator* > global_allocator( nullptr );
+thread_local workspace::Allocator* thread_allocator = nullptr;
+
+//------------------------------------------------------------------------------
+/// @return allocator for workspace on the calling thread.
+workspace::Allocator* current_allocator()
+{
+    static workspace::HeapAllocator heap;
+
+    workspace::Allocator* alloc = thread_allocator;
+    if (alloc == nullptr)
+        alloc = global_allocator.load( std::memory_order_acquire );
+    if (alloc == nullptr)
+        alloc = &heap;
+    return alloc;
+}
+
+}  // namespace internal
+
+namespace workspace {
+
+//==============================================================================
+// HeapAllocator
+
+//------------------------------------------------------------------------------
+void* HeapAllocator::allocate( size_t bytes, const char* routine )
+{
+    return internal::aligned_malloc( bytes );
+}
+
+//------------------------------------------------------------------------------
+void HeapAllocator::deallocate( void* ptr, size_t bytes ) noexcept
+{
+    internal::aligned_free( ptr );
+}
+
+//==============================================================================
+// HugePageAllocator
+
+//------------------------------------------------------------------------------
+HugePageAllocator::HugePageAllocator( size_t min_bytes ):
+    min_bytes_( std::max( min_bytes, size_t( 1 ) ) )
+{}
+
+//------------------------------------------------------------------------------
+void* HugePageAllocator::allocate( size_t bytes, const char* routine )
+{
+    #if defined( __linux__ )
+        if (bytes >= min_bytes_) {
+            size_t len = (bytes + page_size - 1) / page_size * page_size;
+            void* ptr = MAP_FAILED;
+            #ifdef MAP_HUGETLB
+                // Explicit huge pages; fails if none are reserved.
+                ptr = mmap( nullptr, len, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+            #endif
+            if (ptr == MAP_FAILED) {
+                // Ordinary pages, requesting transparent huge pages.
+                ptr = mmap( nullptr, len, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+                if (ptr == MAP_FAILED)
+                    throw std::bad_alloc();
+                #ifdef MADV_HUGEPAGE
+                    madvise( ptr, len, MADV_HUGEPAGE );
+                #endif
+            }
+            return ptr;
+        }
+    #endif
+    return heap_.allocate( bytes, routine );
+}
+
+//------------------------------------------------------------------------------
+void HugePageAllocator::deallocate( void* ptr, size_t bytes ) noexcept
+{
+    #if defined( __linux__ )
+        if (bytes >= min_bytes_) {
+            size_t len = (bytes + page_size - 1) / page_size * page_size;
+            munmap( ptr, len );
+            return;
+        }
+    #endif
+    heap_.deallocate( ptr, bytes );
+}
+
+//==============================================================================
+// PoolAllocator
+
+// Smallest size class is 2^min_class = 64 bytes.
+static const int min_class = 6;
+
+//------------------------------------------------------------------------------
+PoolAllocator::PoolAllocator( size_t max_bytes, Allocator* upstream ):
+    max_bytes_( max_bytes ),
+    upstream_( upstream != nullptr ? upstream : &heap_ ),
+    cached_( 0 )
+{
+    int nclasses = 1;
+    while ((size_t( 1 ) << (min_class + nclasses - 1)) < max_bytes_)
+        ++nclasses;
+    free_.resize( nclasses );
+}
+
+//------------------------------------------------------------------------------
+PoolAllocator::~PoolAllocator()
+{
+    release();
+}
+
+//------------------------------------------------------------------------------
+/// @return size class for bytes, i.e., ceil( log2( bytes ) ) - min_class,
+/// or -1 if bytes is too large to cache.
+int PoolAllocator::size_class( size_t bytes ) const
+{
+    if (bytes > max_bytes_)
+        return -1;
+    int c = 0;
+    while ((size_t( 1 ) << (min_class + c)) < bytes)
+        ++c;
+    return c;
+}
+
+//------------------------------------------------------------------------------
+void* PoolAllocator::allocate( size_t bytes, const char* routine )
+{
+    int c = size_class( bytes );
+    if (c < 0)
+        return upstream_->allocate( bytes, routine );
+
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if (! free_[ c ].empty()) {
+            void* ptr = free_[ c ].back();
+            free_[ c ].pop_back();
+            cached_ -= size_t( 1 ) << (min_class + c);
+            return ptr;
+        }
+    }
+    return upstream_->allocate( size_t( 1 ) << (min_class + c), routine );
+}
+
+//------------------------------------------------------------------------------
+void PoolAllocator::deallocate( void* ptr, size_t bytes ) noexcept
+{
+    int c = size_class( bytes );
+    if (c < 0) {
+        upstream_->deallocate( ptr, bytes );
+        return;
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    try {
+        free_[ c ].push_back( ptr );
+        cached_ += size_t( 1 ) << (min_class + c);
+    }
+    catch (std::bad_alloc const&) {
+        upstream_->deallocate( ptr, size_t( 1 ) << (min_class + c) );
+    }
+}
+
+//------------------------------------------------------------------------------
+void PoolAllocator::release()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    for (size_t c = 0; c < free_.size(); ++c) {
+        for (void* ptr : free_[ c ])
+            upstream_->deallocate( ptr, size_t( 1 ) << (min_class + c) );
+        free_[ c ].clear();
+    }
+    cached_ = 0;
+}
+
+//------------------------------------------------------------------------------
+size_t PoolAllocator::cached() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return cached_;
+}
+
+//==============================================================================
+// CountingAllocator
+
+//------------------------------------------------------------------------------
+CountingAllocator::CountingAllocator( Allocator* upstream ):
+    upstream_( upstream != nullptr ? upstream : &heap_ )
+{}
+
+//------------------------------------------------------------------------------
+void* CountingAllocator::allocate( size_t bytes, const char* routine )
+{
+    void* ptr = upstream_->allocate( bytes, routine );
+
+    // If bookkeeping fails to allocate, return the block before rethrowing.
+    try {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        Counts& c = counts_[ routine != nullptr ? routine : "unknown" ];
+        c.count   += 1;
+        c.bytes   += bytes;
+        c.current += bytes;
+        c.peak     = std::max( c.peak, c.current );
+        live_.push_back( std::make_pair( ptr, &c ) );
+    }
+    catch (...) {
+        upstream_->deallocate( ptr, bytes );
+        throw;
+    }
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void CountingAllocator::deallocate( void* ptr, size_t bytes ) noexcept
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        for (size_t i = live_.size(); i-- > 0; ) {
+            if (live_[ i ].first == ptr) {
+                live_[ i ].second->current -= bytes;
+                live_[ i ] = live_.back();
+                live_.pop_back();
+                break;
+            }
+        }
+    }
+    upstream_->deallocate( ptr, bytes );
+}
+
+//------------------------------------------------------------------------------
+std::map< std::string, CountingAllocator::Counts >
+CountingAllocator::counts() const
+{
+    std::map< std::string, Counts > result;
+    std::lock_guard< std::mutex > lock( mutex_ );
+    for (auto const& iter : counts_) {
+        Counts const& c = iter.second;
+        Counts& r = result[ iter.first ];  // zero-initialized if new
+        r.count   += c.count;
+        r.bytes   += c.bytes;
+        r.current += c.current;
+        r.peak     = std::max( r.peak, c.peak );
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void CountingAllocator::print( FILE* stream ) const
+{
+    fprintf( stream, "%-20s  %12s  %16s  %16s\n",
+             "routine", "count", "bytes", "peak bytes" );
+    for (auto const& iter : counts()) {
+        Counts const& c = iter.second;
+        fprintf( stream, "%-20s  %12lld  %16lld  %16lld\n",
+                 iter.first.c_str(), (long long) c.count,
+                 (long long) c.bytes, (long long) c.peak );
+    }
+}
+
+//------------------------------------------------------------------------------
+void CountingAllocator::reset()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    // Keep current, since those blocks are still live.
+    for (auto& iter : counts_) {
+        Counts& c = iter.second;
+        c.count = 0;
+        c.bytes = 0;
+        c.peak  = c.current;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+/// Sets the allocator for workspace on all threads that don't have their
+/// own, set by set_thread_allocator(). Set it before other threads call
+/// LAPACK++ routines; it must not be changed while they are running.
+///
+/// @param[in] allocator
+///     Allocator to use; nullptr restores the default heap allocator.
+///
+/// @ingroup workspace
+void set_allocator( Allocator* allocator )
+{
+    internal::global_allocator.store( allocator, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// Sets the allocator for workspace on the calling thread, overriding the
+/// one set by set_allocator().
+///
+/// @param[in] allocator
+///     Allocator to use; nullptr reverts to the one set by set_allocator().
+///
+/// @ingroup workspace
+void set_thread_allocator( Allocator* allocator )
+{
+    internal::thread_allocator = allocator;
+}
+
+//------------------------------------------------------------------------------
+/// @return allocator used for workspace on the calling thread.
+///
+/// @ingroup workspace
+Allocator* allocator()
+{
+    return internal::current_allocator();
+}
+
+}  // namespace workspace
+}  // namespace lapack
@@ -0,0 +1,239 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/async.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace lapack {
+namespace async {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Runs the task, unless it was cancelled.
+void Task::run()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if (status_ != Status::Pending)
+            return;
+        status_ = Status::Running;
+    }
+    std::exception_ptr error;
+    try {
+        call();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        error_ = error;
+        status_ = Status::Done;
+    }
+    cv_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+bool Task::cancel()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if (status_ != Status::Pending)
+            return false;
+        status_ = Status::Cancelled;
+    }
+    cv_.notify_all();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void Task::wait()
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    cv_.wait( lock, [this] {
+        return status_ == Status::Done || status_ == Status::Cancelled;
+    });
+}
+
+//------------------------------------------------------------------------------
+bool Task::ready()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return status_ == Status::Done || status_ == Status::Cancelled;
+}
+
+//------------------------------------------------------------------------------
+// Waits, then rethrows the task's exception, if any.
+void Task::rethrow()
+{
+    wait();
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if (status_ == Status::Cancelled)
+        throw Error( "task was cancelled", __func__ );
+    if (error_)
+        std::rethrow_exception( error_ );
+}
+
+//------------------------------------------------------------------------------
+// Tasks of one queue. While the queue has tasks, it is scheduled: either
+// in the executor's ready list, or running one task on a worker. Since
+// it is in neither place twice, its tasks run one at a time, in order.
+struct QueueState
+{
+    QueueState(): scheduled( false ) {}
+
+    std::mutex mutex;
+    std::condition_variable idle_cv;
+    std::deque< std::shared_ptr< Task > > tasks;
+    bool scheduled;
+};
+
+//------------------------------------------------------------------------------
+// Worker threads shared by all queues. A worker takes the next ready
+// queue, runs its first task, then puts the queue at the back of the
+// ready list if it has more tasks, so busy queues take turns.
+class Executor
+{
+public:
+    explicit Executor( int nthreads ):
+        stop_( false )
+    {
+        for (int i = 0; i < nthreads; ++i)
+            threads_.emplace_back( &Executor::worker_main, this );
+    }
+
+    ~Executor()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    // Disable copying.
+    Executor( Executor const& ) = delete;
+    Executor& operator=( Executor const& ) = delete;
+
+    void schedule( std::shared_ptr< QueueState > state )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            ready_.push_back( std::move( state ) );
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void worker_main()
+    {
+        while (true) {
+            std::shared_ptr< QueueState > state;
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                cv_.wait( lock, [this] { return stop_ || ! ready_.empty(); } );
+                if (ready_.empty())
+                    return;  // stop_ and drained
+                state = std::move( ready_.front() );
+                ready_.pop_front();
+            }
+
+            std::shared_ptr< Task > task;
+            {
+                std::lock_guard< std::mutex > lock( state->mutex );
+                if (! state->tasks.empty())
+                    task = state->tasks.front();
+            }
+            if (task)
+                task->run();
+
+            bool more;
+            {
+                std::lock_guard< std::mutex > lock( state->mutex );
+                if (task)
+                    state->tasks.pop_front();
+                more = ! state->tasks.empty();
+                state->scheduled = more;
+            }
+            if (more)
+                schedule( std::move( state ) );
+            else
+                state->idle_cv.notify_all();
+        }
+    }
+
+    std::vector< std::thread > threads_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque< std::shared_ptr< QueueState > > ready_;
+    bool stop_;
+};
+
+//------------------------------------------------------------------------------
+// The executor is created on first use, with lapack::get_num_threads()
+// workers. It lives until exit, when its workers finish pending tasks.
+static Executor& executor()
+{
+    static Executor exec( std::max( lapack::internal::num_threads(), 1 ) );
+    return exec;
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+Queue::Queue():
+    state_( std::make_shared< internal::QueueState >() )
+{}
+
+//------------------------------------------------------------------------------
+Queue::~Queue()
+{
+    sync();
+}
+
+//------------------------------------------------------------------------------
+void Queue::enqueue( std::shared_ptr< internal::Task > task )
+{
+    bool schedule;
+    {
+        std::lock_guard< std::mutex > lock( state_->mutex );
+        state_->tasks.push_back( std::move( task ) );
+        schedule = ! state_->scheduled;
+        state_->scheduled = true;
+    }
+    if (schedule)
+        internal::executor().schedule( state_ );
+}
+
+//------------------------------------------------------------------------------
+void Queue::sync()
+{
+    std::unique_lock< std::mutex > lock( state_->mutex );
+    state_->idle_cv.wait( lock, [this] { return ! state_->scheduled; } );
+}
+
+//------------------------------------------------------------------------------
+// Cancelled tasks stay in the list, so the task a worker is running
+// remains first; the worker skips them.
+int64_t Queue::cancel()
+{
+    int64_t count = 0;
+    std::lock_guard< std::mutex > lock( state_->mutex );
+    for (auto& task : state_->tasks) {
+        if (task->cancel())
+            ++count;
+    }
+    return count;
+}
+
+}  // namespace async
+}  // namespace lapack
@@ -0,0 +1,130 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_BATCH_COMMON_HH
+#define LAPACK_BATCH_COMMON_HH
+
+#include "lapack/util.hh"
+#include "NoConstructAllocator.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+namespace batch {
+
+//------------------------------------------------------------------------------
+// @return argument for problem i: vec[ 0 ] if vec has one entry,
+// shared by all problems, else vec[ i ].
+template <typename T>
+inline T extract( std::vector<T> const& vec, size_t i )
+{
+    return vec.size() == 1 ? vec[ 0 ] : vec[ i ];
+}
+
+//------------------------------------------------------------------------------
+// @return dimension to trace a batch with: vec[ 0 ] if vec has one entry,
+// shared by all problems (or groups), else -1, as dimensions vary.
+inline int64_t trace_dim( std::vector<int64_t> const& vec )
+{
+    return vec.size() == 1 ? vec[ 0 ] : -1;
+}
+
+//------------------------------------------------------------------------------
+// Checks that an option or dimension vector has 1 or batch entries.
+template <typename T>
+inline void check_arg_size( std::vector<T> const& vec, size_t batch )
+{
+    lapack_error_if( vec.size() != 1 && vec.size() != batch );
+}
+
+//------------------------------------------------------------------------------
+// Checks that an array of pointers has batch entries.
+template <typename T>
+inline void check_array_size( std::vector<T*> const& vec, size_t batch )
+{
+    lapack_error_if( vec.size() != batch );
+}
+
+//------------------------------------------------------------------------------
+// Maps problem indices to groups, for grouped batch routines, where
+// group g has group_size[ g ] problems sharing the same arguments,
+// and problems are numbered consecutively across groups.
+class Groups
+{
+public:
+    explicit Groups( std::vector<int64_t> const& group_size ):
+        offset_( group_size.size() + 1 )
+    {
+        offset_[ 0 ] = 0;
+        for (size_t g = 0; g < group_size.size(); ++g) {
+            lapack_error_if( group_size[ g ] < 0 );
+            offset_[ g+1 ] = offset_[ g ] + group_size[ g ];
+        }
+    }
+
+    // Number of groups.
+    size_t count() const { return offset_.size() - 1; }
+
+    // Total number of problems.
+    int64_t batch() const { return offset_.back(); }
+
+    // Group of problem i.
+    size_t group( int64_t i ) const
+    {
+        // first offset > i, minus 1
+        return std::upper_bound( offset_.begin(), offset_.end(), i )
+               - offset_.begin() - 1;
+    }
+
+private:
+    std::vector<int64_t> offset_;  ///< first problem of each group
+};
+
+//------------------------------------------------------------------------------
+// Checks that a per-group argument vector has one entry per group.
+template <typename T>
+inline void check_group_size( std::vector<T> const& vec, Groups const& groups )
+{
+    lapack_error_if( vec.size() != groups.count() );
+}
+
+//------------------------------------------------------------------------------
+// One workspace buffer per worker of parallel_for, each of the same size,
+// so a batch queries its workspace once, then each problem calls the
+// overload taking caller-provided workspace, without allocating.
+// Buffers start on separate cache lines.
+class WorkerWorkspace
+{
+public:
+    explicit WorkerWorkspace( size_t bytes ):
+        stride_( (bytes + align - 1) / align * align ),
+        data_( stride_ * num_threads() + align )
+    {}
+
+    // Buffer for given worker.
+    void* get( int worker )
+    {
+        char* base = data_.data();
+        base += (align - uintptr_t( base ) % align) % align;
+        return base + worker * stride_;
+    }
+
+    // Size of each buffer, in bytes.
+    size_t size() const { return stride_; }
+
+private:
+    static const size_t align = 64;
+    size_t stride_;
+    lapack::vector< char > data_;
+};
+
+}  // namespace batch
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_BATCH_COMMON_HH
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30300  // >= 3.3
 
@@ -46,6 +47,11 @@ int64_t bbcsd(
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bbcsd", 's', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -90,7 +96,7 @@ int64_t bbcsd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sbbcsd(
         &jobu1_, &jobu2_, &jobv1t_, &jobv2t_, &trans_, &m_, &p_, &q_,
@@ -148,6 +154,11 @@ int64_t bbcsd(
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bbcsd", 'd', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -192,7 +203,7 @@ int64_t bbcsd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dbbcsd(
         &jobu1_, &jobu2_, &jobv1t_, &jobv2t_, &trans_, &m_, &p_, &q_,
@@ -250,6 +261,11 @@ int64_t bbcsd(
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bbcsd", 'c', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -294,7 +310,7 @@ int64_t bbcsd(
     lapack_int lrwork_ = real(qry_rwork[0]);
 
     // allocate workspace
-    lapack::vector< float > rwork( lrwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
 
     LAPACK_cbbcsd(
         &jobu1_, &jobu2_, &jobv1t_, &jobv2t_, &trans_, &m_, &p_, &q_,
@@ -537,6 +553,11 @@ int64_t bbcsd(
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bbcsd", 'z', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -581,7 +602,7 @@ int64_t bbcsd(
     lapack_int lrwork_ = real(qry_rwork[0]);
 
     // allocate workspace
-    lapack::vector< double > rwork( lrwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
 
     LAPACK_zbbcsd(
         &jobu1_, &jobu2_, &jobv1t_, &jobv2t_, &trans_, &m_, &p_, &q_,
@@ -610,6 +631,514 @@ int64_t bbcsd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_bbcsd(
+    char jobu1, char jobu2, char jobv1t, char jobv2t, char trans, lapack_int m, lapack_int p, lapack_int q,
+    float* theta,
+    float* phi,
+    float* U1, lapack_int ldu1,
+    float* U2, lapack_int ldu2,
+    float* V1T, lapack_int ldv1t,
+    float* V2T, lapack_int ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sbbcsd(
+        &jobu1, &jobu2, &jobv1t, &jobv2t, &trans, &m, &p, &q,
+        theta,
+        phi,
+        U1, &ldu1,
+        U2, &ldu2,
+        V1T, &ldv1t,
+        V2T, &ldv2t,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bbcsd(
+    char jobu1, char jobu2, char jobv1t, char jobv2t, char trans, lapack_int m, lapack_int p, lapack_int q,
+    double* theta,
+    double* phi,
+    double* U1, lapack_int ldu1,
+    double* U2, lapack_int ldu2,
+    double* V1T, lapack_int ldv1t,
+    double* V2T, lapack_int ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dbbcsd(
+        &jobu1, &jobu2, &jobv1t, &jobv2t, &trans, &m, &p, &q,
+        theta,
+        phi,
+        U1, &ldu1,
+        U2, &ldu2,
+        V1T, &ldv1t,
+        V2T, &ldv2t,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bbcsd(
+    char jobu1, char jobu2, char jobv1t, char jobv2t, char trans, lapack_int m, lapack_int p, lapack_int q,
+    float* theta,
+    float* phi,
+    std::complex<float>* U1, lapack_int ldu1,
+    std::complex<float>* U2, lapack_int ldu2,
+    std::complex<float>* V1T, lapack_int ldv1t,
+    std::complex<float>* V2T, lapack_int ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cbbcsd(
+        &jobu1, &jobu2, &jobv1t, &jobv2t, &trans, &m, &p, &q,
+        theta,
+        phi,
+        (lapack_complex_float*) U1, &ldu1,
+        (lapack_complex_float*) U2, &ldu2,
+        (lapack_complex_float*) V1T, &ldv1t,
+        (lapack_complex_float*) V2T, &ldv2t,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bbcsd(
+    char jobu1, char jobu2, char jobv1t, char jobv2t, char trans, lapack_int m, lapack_int p, lapack_int q,
+    double* theta,
+    double* phi,
+    std::complex<double>* U1, lapack_int ldu1,
+    std::complex<double>* U2, lapack_int ldu2,
+    std::complex<double>* V1T, lapack_int ldv1t,
+    std::complex<double>* V2T, lapack_int ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zbbcsd(
+        &jobu1, &jobu2, &jobv1t, &jobv2t, &trans, &m, &p, &q,
+        theta,
+        phi,
+        (lapack_complex_double*) U1, &ldu1,
+        (lapack_complex_double*) U2, &ldu2,
+        (lapack_complex_double*) V1T, &ldv1t,
+        (lapack_complex_double*) V2T, &ldv2t,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by bbcsd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    blas::real_type<scalar_t>* theta,
+    blas::real_type<scalar_t>* phi,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    scalar_t* V2T, int64_t ldv2t,
+    blas::real_type<scalar_t>* B11D,
+    blas::real_type<scalar_t>* B11E,
+    blas::real_type<scalar_t>* B12D,
+    blas::real_type<scalar_t>* B12E,
+    blas::real_type<scalar_t>* B21D,
+    blas::real_type<scalar_t>* B21E,
+    blas::real_type<scalar_t>* B22D,
+    blas::real_type<scalar_t>* B22E,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(q) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu1_ = job_csd2char( jobu1 );
+    char jobu2_ = job_csd2char( jobu2 );
+    char jobv1t_ = job_csd2char( jobv1t );
+    char jobv2t_ = job_csd2char( jobv2t );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int q_ = (lapack_int) q;
+    lapack_int ldu1_ = (lapack_int) ldu1;
+    lapack_int ldu2_ = (lapack_int) ldu2;
+    lapack_int ldv1t_ = (lapack_int) ldv1t;
+    lapack_int ldv2t_ = (lapack_int) ldv2t;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    real_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_bbcsd(
+        jobu1_, jobu2_, jobv1t_, jobv2t_, trans_, m_, p_, q_,
+        theta,
+        phi,
+        U1, ldu1_,
+        U2, ldu2_,
+        V1T, ldv1t_,
+        V2T, ldv2t_,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::bbcsd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::bbcsd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     bbcsd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    blas::real_type<scalar_t>* theta,
+    blas::real_type<scalar_t>* phi,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    scalar_t* V2T, int64_t ldv2t,
+    blas::real_type<scalar_t>* B11D,
+    blas::real_type<scalar_t>* B11E,
+    blas::real_type<scalar_t>* B12D,
+    blas::real_type<scalar_t>* B12E,
+    blas::real_type<scalar_t>* B21D,
+    blas::real_type<scalar_t>* B21E,
+    blas::real_type<scalar_t>* B22D,
+    blas::real_type<scalar_t>* B22E,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(q) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv2t) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "bbcsd", trace::internal::precision< scalar_t >(), m, -1, -1,
+        []() { return 0.0; } );
+
+    char jobu1_ = job_csd2char( jobu1 );
+    char jobu2_ = job_csd2char( jobu2 );
+    char jobv1t_ = job_csd2char( jobv1t );
+    char jobv2t_ = job_csd2char( jobv2t );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int q_ = (lapack_int) q;
+    lapack_int ldu1_ = (lapack_int) ldu1;
+    lapack_int ldu2_ = (lapack_int) ldu2;
+    lapack_int ldv1t_ = (lapack_int) ldv1t;
+    lapack_int ldv2t_ = (lapack_int) ldv2t;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< real_t >();
+    real_t* work_ = buffer.take< real_t >( lwork_ );
+
+    fortran_bbcsd(
+        jobu1_, jobu2_, jobv1t_, jobv2t_, trans_, m_, p_, q_,
+        theta,
+        phi,
+        U1, ldu1_,
+        U2, ldu2_,
+        V1T, ldv1t_,
+        V2T, ldv2t_,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    float* theta,
+    float* phi,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    float* V2T, int64_t ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    size_t* work_size );
+
+template
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    double* theta,
+    double* phi,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    double* V2T, int64_t ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    size_t* work_size );
+
+template
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    float* theta,
+    float* phi,
+    std::complex<float>* U1, int64_t ldu1,
+    std::complex<float>* U2, int64_t ldu2,
+    std::complex<float>* V1T, int64_t ldv1t,
+    std::complex<float>* V2T, int64_t ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    size_t* work_size );
+
+template
+void bbcsd_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    double* theta,
+    double* phi,
+    std::complex<double>* U1, int64_t ldu1,
+    std::complex<double>* U2, int64_t ldu2,
+    std::complex<double>* V1T, int64_t ldv1t,
+    std::complex<double>* V2T, int64_t ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    float* theta,
+    float* phi,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    float* V2T, int64_t ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    void* work, size_t work_size );
+
+template
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    double* theta,
+    double* phi,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    double* V2T, int64_t ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    void* work, size_t work_size );
+
+template
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    float* theta,
+    float* phi,
+    std::complex<float>* U1, int64_t ldu1,
+    std::complex<float>* U2, int64_t ldu2,
+    std::complex<float>* V1T, int64_t ldv1t,
+    std::complex<float>* V2T, int64_t ldv2t,
+    float* B11D,
+    float* B11E,
+    float* B12D,
+    float* B12E,
+    float* B21D,
+    float* B21E,
+    float* B22D,
+    float* B22E,
+    void* work, size_t work_size );
+
+template
+int64_t bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q,
+    double* theta,
+    double* phi,
+    std::complex<double>* U1, int64_t ldu1,
+    std::complex<double>* U2, int64_t ldu2,
+    std::complex<double>* V1T, int64_t ldv1t,
+    std::complex<double>* V2T, int64_t ldv2t,
+    double* B11D,
+    double* B11E,
+    double* B12D,
+    double* B12E,
+    double* B21D,
+    double* B21E,
+    double* B22D,
+    double* B22E,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.3.0
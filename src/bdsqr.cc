@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -35,6 +36,11 @@ int64_t bdsqr(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsqr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ncvt_ = (lapack_int) ncvt;
@@ -46,7 +52,7 @@ int64_t bdsqr(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
+    lapack::small_vector< float > work( (4*n) );
 
     LAPACK_sbdsqr(
         &uplo_, &n_, &ncvt_, &nru_, &ncc_,
@@ -86,6 +92,11 @@ int64_t bdsqr(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsqr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ncvt_ = (lapack_int) ncvt;
@@ -97,7 +108,7 @@ int64_t bdsqr(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
+    lapack::small_vector< double > work( (4*n) );
 
     LAPACK_dbdsqr(
         &uplo_, &n_, &ncvt_, &nru_, &ncc_,
@@ -137,6 +148,11 @@ int64_t bdsqr(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsqr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ncvt_ = (lapack_int) ncvt;
@@ -148,7 +164,7 @@ int64_t bdsqr(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > rwork( (4*n) );
+    lapack::small_vector< float > rwork( (4*n) );
 
     LAPACK_cbdsqr(
         &uplo_, &n_, &ncvt_, &nru_, &ncc_,
@@ -287,6 +303,11 @@ int64_t bdsqr(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsqr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ncvt_ = (lapack_int) ncvt;
@@ -298,7 +319,7 @@ int64_t bdsqr(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > rwork( (4*n) );
+    lapack::small_vector< double > rwork( (4*n) );
 
     LAPACK_zbdsqr(
         &uplo_, &n_, &ncvt_, &nru_, &ncc_,
@@ -318,4 +339,295 @@ int64_t bdsqr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_bdsqr(
+    char uplo, lapack_int n, lapack_int ncvt, lapack_int nru, lapack_int ncc,
+    float* D,
+    float* E,
+    float* VT, lapack_int ldvt,
+    float* U, lapack_int ldu,
+    float* C, lapack_int ldc,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sbdsqr(
+        &uplo, &n, &ncvt, &nru, &ncc,
+        D,
+        E,
+        VT, &ldvt,
+        U, &ldu,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bdsqr(
+    char uplo, lapack_int n, lapack_int ncvt, lapack_int nru, lapack_int ncc,
+    double* D,
+    double* E,
+    double* VT, lapack_int ldvt,
+    double* U, lapack_int ldu,
+    double* C, lapack_int ldc,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dbdsqr(
+        &uplo, &n, &ncvt, &nru, &ncc,
+        D,
+        E,
+        VT, &ldvt,
+        U, &ldu,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bdsqr(
+    char uplo, lapack_int n, lapack_int ncvt, lapack_int nru, lapack_int ncc,
+    float* D,
+    float* E,
+    std::complex<float>* VT, lapack_int ldvt,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* C, lapack_int ldc,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cbdsqr(
+        &uplo, &n, &ncvt, &nru, &ncc,
+        D,
+        E,
+        (lapack_complex_float*) VT, &ldvt,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) C, &ldc,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bdsqr(
+    char uplo, lapack_int n, lapack_int ncvt, lapack_int nru, lapack_int ncc,
+    double* D,
+    double* E,
+    std::complex<double>* VT, lapack_int ldvt,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* C, lapack_int ldc,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zbdsqr(
+        &uplo, &n, &ncvt, &nru, &ncc,
+        D,
+        E,
+        (lapack_complex_double*) VT, &ldvt,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) C, &ldc,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by bdsqr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* U, int64_t ldu,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nru) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 0 : 4*n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 4*n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::bdsqr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::bdsqr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     bdsqr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* VT, int64_t ldvt,
+    scalar_t* U, int64_t ldu,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nru) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "bdsqr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ncvt_ = (lapack_int) ncvt;
+    lapack_int nru_ = (lapack_int) nru;
+    lapack_int ncc_ = (lapack_int) ncc;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 0 : 4*n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 4*n : 0 );
+
+    fortran_bdsqr(
+        uplo_, n_, ncvt_, nru_, ncc_,
+        D,
+        E,
+        VT, ldvt_,
+        U, ldu_,
+        C, ldc_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    float* D,
+    float* E,
+    float* VT, int64_t ldvt,
+    float* U, int64_t ldu,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    double* D,
+    double* E,
+    double* VT, int64_t ldvt,
+    double* U, int64_t ldu,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    float* D,
+    float* E,
+    std::complex<float>* VT, int64_t ldvt,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void bdsqr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    double* D,
+    double* E,
+    std::complex<double>* VT, int64_t ldvt,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    float* D,
+    float* E,
+    float* VT, int64_t ldvt,
+    float* U, int64_t ldu,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    double* D,
+    double* E,
+    double* VT, int64_t ldvt,
+    double* U, int64_t ldu,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    float* D,
+    float* E,
+    std::complex<float>* VT, int64_t ldvt,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t bdsqr(
+    lapack::Uplo uplo, int64_t n, int64_t ncvt, int64_t nru, int64_t ncc,
+    double* D,
+    double* E,
+    std::complex<double>* VT, int64_t ldvt,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
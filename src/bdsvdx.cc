@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30600  // >= v3.6
 
@@ -34,6 +35,11 @@ int64_t bdsvdx(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsvdx", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
@@ -45,8 +51,8 @@ int64_t bdsvdx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (14*n) );
-    lapack::vector< lapack_int > iwork( (12*n) );
+    lapack::small_vector< float > work( (14*n) );
+    lapack::small_vector< lapack_int > iwork( (12*n) );
 
     LAPACK_sbdsvdx(
         &uplo_, &jobz_, &range_, &n_,
@@ -212,6 +218,11 @@ int64_t bdsvdx(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "bdsvdx", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
@@ -223,8 +234,8 @@ int64_t bdsvdx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (14*n) );
-    lapack::vector< lapack_int > iwork( (12*n) );
+    lapack::small_vector< double > work( (14*n) );
+    lapack::small_vector< lapack_int > iwork( (12*n) );
 
     LAPACK_dbdsvdx(
         &uplo_, &jobz_, &range_, &n_,
@@ -245,6 +256,192 @@ int64_t bdsvdx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_bdsvdx(
+    char uplo, char jobz, char range, lapack_int n,
+    float const* D,
+    float const* E, float vl, float vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    float* S,
+    float* Z, lapack_int ldz,
+    float* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sbdsvdx(
+        &uplo, &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, nfound,
+        S,
+        Z, &ldz,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_bdsvdx(
+    char uplo, char jobz, char range, lapack_int n,
+    double const* D,
+    double const* E, double vl, double vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    double* S,
+    double* Z, lapack_int ldz,
+    double* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dbdsvdx(
+        &uplo, &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, nfound,
+        S,
+        Z, &ldz,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by bdsvdx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void bdsvdx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t* S,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( 14*n );
+    buffer.take< lapack_int >( 12*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::bdsvdx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::bdsvdx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     bdsvdx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t bdsvdx(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    scalar_t* S,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "bdsvdx", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( 14*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( 12*n );
+
+    fortran_bdsvdx(
+        uplo_, jobz_, range_, n_,
+        D,
+        E, vl, vu, il_, iu_, &nfound_,
+        S,
+        Z, ldz_,
+        work_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void bdsvdx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    float const* D,
+    float const* E, float vl, float vu, int64_t il, int64_t iu,
+    float* S,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void bdsvdx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    double const* D,
+    double const* E, double vl, double vu, int64_t il, int64_t iu,
+    double* S,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t bdsvdx(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    float const* D,
+    float const* E, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t bdsvdx(
+    lapack::Uplo uplo, lapack::Job jobz, lapack::Range range, int64_t n,
+    double const* D,
+    double const* E, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= v3.6
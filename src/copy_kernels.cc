@@ -0,0 +1,613 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "copy_kernels.hh"
+#include "simd.hh"
+#include "ThreadPool.hh"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined( __SSE2__ )
+    #include <emmintrin.h>
+#endif
+
+namespace lapack {
+namespace internal {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+// Matrices are split into chunks of columns with about this many elements,
+// which are spread over the thread pool.
+static const int64_t chunk_elems = 65536;
+
+// Copies and fills that write at least this many bytes use non-temporal
+// stores. It is larger than the last-level cache of most processors, so
+// the destination would not stay in cache anyway.
+static const size_t nontemporal_bytes = size_t( 32 ) << 20;
+
+// Transposes are done in tile-by-tile blocks, which fit in L2 cache.
+static const int64_t tile = 64;
+
+// lascl applies each multiplier to blocks of this many reals in turn.
+static const int64_t scale_block = 512;
+
+//------------------------------------------------------------------------------
+// Part of an m-by-n matrix referenced by matrixtype, as in lascl.
+// lacpy and laset treat types other than Upper and Lower as General.
+struct Region {
+    lapack::MatrixType type;
+    int64_t kl, ku, m, n;
+
+    // Sets [i1, i2) to the rows referenced in column j.
+    void rows( int64_t j, int64_t* i1, int64_t* i2 ) const
+    {
+        switch (type) {
+            case MatrixType::Lower:
+                *i1 = min( j, m );
+                *i2 = m;
+                break;
+            case MatrixType::Upper:
+                *i1 = 0;
+                *i2 = min( j + 1, m );
+                break;
+            case MatrixType::Hessenberg:
+                *i1 = 0;
+                *i2 = min( j + 2, m );
+                break;
+            case MatrixType::LowerBand:
+                *i1 = 0;
+                *i2 = min( kl + 1, n - j );
+                break;
+            case MatrixType::UpperBand:
+                *i1 = max( ku - j, int64_t( 0 ) );
+                *i2 = ku + 1;
+                break;
+            case MatrixType::Band:
+                *i1 = max( kl + ku - j, kl );
+                *i2 = max( min( 2*kl + ku + 1, kl + ku + m - j ), *i1 );
+                break;
+            default:
+                *i1 = 0;
+                *i2 = m;
+                break;
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+// Returns bounds of column chunks of about chunk_elems elements each:
+// chunk c is columns [bounds[c], bounds[c+1]). Sets elems to the number of
+// elements in the region.
+inline std::vector< int64_t > column_chunks(
+    Region const& region, int64_t* elems )
+{
+    std::vector< int64_t > bounds( 1, 0 );
+    int64_t total = 0, count = 0;
+    for (int64_t j = 0; j < region.n; ++j) {
+        int64_t i1, i2;
+        region.rows( j, &i1, &i2 );
+        total += i2 - i1;
+        count += i2 - i1 + 1;  // + 1 for per-column overhead
+        if (count >= chunk_elems) {
+            bounds.push_back( j + 1 );
+            count = 0;
+        }
+    }
+    if (bounds.back() != region.n)
+        bounds.push_back( region.n );
+    *elems = total;
+    return bounds;
+}
+
+//------------------------------------------------------------------------------
+// alpha x, using the textbook complex product, without the NaN recovery of
+// C99 Annex G, as LAPACK's Fortran does.
+template <typename real_t>
+inline real_t scaled( real_t alpha, real_t x )
+{
+    return alpha * x;
+}
+
+template <typename real_t>
+inline std::complex<real_t> scaled(
+    std::complex<real_t> alpha, std::complex<real_t> x )
+{
+    return std::complex<real_t>(
+        real( alpha )*real( x ) - imag( alpha )*imag( x ),
+        real( alpha )*imag( x ) + imag( alpha )*real( x ) );
+}
+
+template <typename real_t>
+inline real_t conj_if( bool conj, real_t x )
+{
+    return x;
+}
+
+template <typename real_t>
+inline std::complex<real_t> conj_if( bool conj, std::complex<real_t> x )
+{
+    return conj ? std::conj( x ) : x;
+}
+
+//------------------------------------------------------------------------------
+// Lane kernels. Complex vectors are passed as real vectors of twice the
+// length where the operation is the same on real and imaginary parts.
+
+// x_i = value.
+template <typename scalar_t>
+LAPACK_SIMD_CLONES
+void fill( int64_t n, scalar_t value, scalar_t* x )
+{
+    constexpr int W = simd_width<scalar_t>();
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            x[ i + l ] = value;
+    }
+    for (; i < n; ++i)
+        x[ i ] = value;
+}
+
+// x_i *= alpha.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+void scale( int64_t n, real_t alpha, real_t* x )
+{
+    constexpr int W = simd_width<real_t>();
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            x[ i + l ] *= alpha;
+    }
+    for (; i < n; ++i)
+        x[ i ] *= alpha;
+}
+
+// y_i = alpha x_i.
+template <typename scalar_t>
+LAPACK_SIMD_CLONES
+void copy_scale( int64_t n, scalar_t alpha, scalar_t const* x, scalar_t* y )
+{
+    constexpr int W = simd_width<scalar_t>();
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            y[ i + l ] = scaled( alpha, x[ i + l ] );
+    }
+    for (; i < n; ++i)
+        y[ i ] = scaled( alpha, x[ i ] );
+}
+
+//------------------------------------------------------------------------------
+// Non-temporal stores write whole cache lines to memory without first
+// reading them into cache. They need 16-byte aligned destinations; the
+// unaligned head and tail use regular stores. stream_fence must follow a
+// series of streaming stores, before other threads read the data.
+#if defined( __SSE2__ )
+
+inline void stream_copy( size_t bytes, void const* src, void* dst )
+{
+    char const* s = (char const*) src;
+    char* d = (char*) dst;
+    size_t head = (16 - uintptr_t( d ) % 16) % 16;
+    if (head > bytes)
+        head = bytes;
+    std::memcpy( d, s, head );
+    size_t i = head;
+    for (; i + 64 <= bytes; i += 64) {
+        __m128i v0 = _mm_loadu_si128( (__m128i const*) (s + i     ) );
+        __m128i v1 = _mm_loadu_si128( (__m128i const*) (s + i + 16) );
+        __m128i v2 = _mm_loadu_si128( (__m128i const*) (s + i + 32) );
+        __m128i v3 = _mm_loadu_si128( (__m128i const*) (s + i + 48) );
+        _mm_stream_si128( (__m128i*) (d + i     ), v0 );
+        _mm_stream_si128( (__m128i*) (d + i + 16), v1 );
+        _mm_stream_si128( (__m128i*) (d + i + 32), v2 );
+        _mm_stream_si128( (__m128i*) (d + i + 48), v3 );
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        _mm_stream_si128( (__m128i*) (d + i),
+                          _mm_loadu_si128( (__m128i const*) (s + i) ) );
+    }
+    std::memcpy( d + i, s + i, bytes - i );
+}
+
+template <typename scalar_t>
+void stream_fill( int64_t n, scalar_t value, scalar_t* x )
+{
+    constexpr int64_t per16 = 16 / sizeof(scalar_t);
+    int64_t i = 0;
+    for (; i < min( n, per16 ) && uintptr_t( x + i ) % 16 != 0; ++i)
+        x[ i ] = value;
+    if (uintptr_t( x + i ) % 16 != 0) {
+        // can't be aligned, e.g., complex<double> on an 8-byte boundary
+        fill( n - i, value, x + i );
+        return;
+    }
+    scalar_t pattern[ per16 ];
+    for (int64_t l = 0; l < per16; ++l)
+        pattern[ l ] = value;
+    __m128i v = _mm_loadu_si128( (__m128i const*) pattern );
+    for (; i + per16 <= n; i += per16)
+        _mm_stream_si128( (__m128i*) (x + i), v );
+    for (; i < n; ++i)
+        x[ i ] = value;
+}
+
+inline void stream_fence()
+{
+    _mm_sfence();
+}
+
+#else
+
+inline void stream_copy( size_t bytes, void const* src, void* dst )
+{
+    std::memcpy( dst, src, bytes );
+}
+
+template <typename scalar_t>
+void stream_fill( int64_t n, scalar_t value, scalar_t* x )
+{
+    fill( n, value, x );
+}
+
+inline void stream_fence()
+{}
+
+#endif
+
+//------------------------------------------------------------------------------
+// Element operations for transposed copies.
+template <typename scalar_t>
+struct CopyOp {
+    bool conj;
+    scalar_t operator()( scalar_t x ) const
+        { return conj_if( conj, x ); }
+};
+
+template <typename scalar_t>
+struct ScaleOp {
+    bool conj;
+    scalar_t alpha;
+    scalar_t operator()( scalar_t x ) const
+        { return scaled( alpha, conj_if( conj, x ) ); }
+};
+
+//------------------------------------------------------------------------------
+// B = op( A^T ) on the region of A. Row blocks of A, which are column
+// blocks of B, are spread over the thread pool; within each, tiles keep
+// both the rows of A and the columns of B in cache.
+template <typename scalar_t, typename op_t>
+void transpose(
+    Region const& region, op_t const& op,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    int64_t m = region.m;
+    int64_t n = region.n;
+    int64_t mb = max( tile, (chunk_elems / n + tile - 1) / tile * tile );
+    int64_t nchunks = (m + mb - 1) / mb;
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        int64_t r1 = c*mb;
+        int64_t r2 = min( m, r1 + mb );
+        for (int64_t jj = 0; jj < n; jj += tile) {
+            int64_t jend = min( n, jj + tile );
+            for (int64_t ii = r1; ii < r2; ii += tile) {
+                int64_t iend = min( r2, ii + tile );
+                // Row bounds are monotonic in j for General, Upper, and
+                // Lower, so the first and last columns show if the tile
+                // is full. Full tiles write B contiguously.
+                int64_t f1, f2, l1, l2;
+                region.rows( jj, &f1, &f2 );
+                region.rows( jend - 1, &l1, &l2 );
+                if (max( f1, l1 ) <= ii && iend <= min( f2, l2 )) {
+                    for (int64_t i = ii; i < iend; ++i)
+                        for (int64_t j = jj; j < jend; ++j)
+                            B[ j + i*ldb ] = op( A[ i + j*lda ] );
+                    continue;
+                }
+                for (int64_t j = jj; j < jend; ++j) {
+                    int64_t i1, i2;
+                    region.rows( j, &i1, &i2 );
+                    i1 = max( i1, ii );
+                    i2 = min( i2, iend );
+                    for (int64_t i = i1; i < i2; ++i)
+                        B[ j + i*ldb ] = op( A[ i + j*lda ] );
+                }
+            }
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < m );
+    lapack_error_if( ldb < (trans == Op::NoTrans ? m : n) );
+
+    if (m == 0 || n == 0)
+        return;
+
+    if (matrixtype != MatrixType::Upper && matrixtype != MatrixType::Lower)
+        matrixtype = MatrixType::General;
+    Region region = { matrixtype, 0, 0, m, n };
+
+    // alpha = 1 copies exactly, without rounding or NaNs from 1 * Inf.
+    bool copy = (alpha == scalar_t( 1 ));
+
+    if (trans != Op::NoTrans) {
+        bool conj = (trans == Op::ConjTrans);
+        if (copy)
+            transpose( region, CopyOp<scalar_t>{ conj }, A, lda, B, ldb );
+        else
+            transpose( region, ScaleOp<scalar_t>{ conj, alpha }, A, lda, B, ldb );
+        return;
+    }
+
+    int64_t elems;
+    std::vector< int64_t > bounds = column_chunks( region, &elems );
+    bool stream = copy && size_t( elems ) * sizeof(scalar_t) >= nontemporal_bytes;
+    parallel_for( bounds.size() - 1, [&]( int64_t c, int worker ) {
+        for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+            int64_t i1, i2;
+            region.rows( j, &i1, &i2 );
+            scalar_t const* Aj = &A[ i1 + j*lda ];
+            scalar_t* Bj = &B[ i1 + j*ldb ];
+            if (stream)
+                stream_copy( (i2 - i1)*sizeof(scalar_t), Aj, Bj );
+            else if (copy)
+                std::memcpy( Bj, Aj, (i2 - i1)*sizeof(scalar_t) );
+            else
+                copy_scale( i2 - i1, alpha, Aj, Bj );
+        }
+        if (stream)
+            stream_fence();
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    scalar_t offdiag, scalar_t diag,
+    scalar_t* A, int64_t lda )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < m );
+
+    if (m == 0 || n == 0)
+        return;
+
+    if (matrixtype != MatrixType::Upper && matrixtype != MatrixType::Lower)
+        matrixtype = MatrixType::General;
+    Region region = { matrixtype, 0, 0, m, n };
+
+    int64_t elems;
+    std::vector< int64_t > bounds = column_chunks( region, &elems );
+    bool stream = size_t( elems ) * sizeof(scalar_t) >= nontemporal_bytes;
+    auto set = [stream]( int64_t len, scalar_t value, scalar_t* x ) {
+        if (stream)
+            stream_fill( len, value, x );
+        else
+            fill( len, value, x );
+    };
+    parallel_for( bounds.size() - 1, [&]( int64_t c, int worker ) {
+        for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+            int64_t i1, i2;
+            region.rows( j, &i1, &i2 );
+            scalar_t* Aj = &A[ j*lda ];
+            if (i1 <= j && j < i2) {
+                // The diagonal uses a regular store, never mixed with
+                // streaming stores to the same line.
+                set( j - i1, offdiag, &Aj[ i1 ] );
+                Aj[ j ] = diag;
+                set( i2 - j - 1, offdiag, &Aj[ j + 1 ] );
+            }
+            else {
+                set( i2 - i1, offdiag, &Aj[ i1 ] );
+            }
+        }
+        if (stream)
+            stream_fence();
+    });
+}
+
+//------------------------------------------------------------------------------
+// Multipliers whose product is cto / cfrom, computed as in LAPACK's lascl
+// so that no intermediate over- or underflows. Applying them in order to
+// each element gives the same result as LAPACK's successive passes.
+// Returns an empty vector if the final multiplier is 1.
+template <typename real_t>
+std::vector< real_t > lascl_multipliers( real_t cfrom, real_t cto )
+{
+    // Safe minimum, lamch( 'S' ), for IEEE arithmetic.
+    const real_t smlnum = std::numeric_limits< real_t >::min();
+    const real_t bignum = 1 / smlnum;
+
+    std::vector< real_t > muls;
+    real_t cfromc = cfrom;
+    real_t ctoc = cto;
+    while (true) {
+        real_t cfrom1 = cfromc * smlnum;
+        if (cfrom1 == cfromc) {
+            // cfromc is Inf. Multiply by a correctly signed zero for
+            // finite ctoc, or NaN if ctoc is Inf.
+            muls.push_back( ctoc / cfromc );
+            break;
+        }
+        real_t cto1 = ctoc / bignum;
+        if (cto1 == ctoc) {
+            // ctoc is 0 or Inf; either way, it is the multiplier.
+            muls.push_back( ctoc );
+            break;
+        }
+        else if (std::abs( cfrom1 ) > std::abs( ctoc ) && ctoc != 0) {
+            muls.push_back( smlnum );
+            cfromc = cfrom1;
+        }
+        else if (std::abs( cto1 ) > std::abs( cfromc )) {
+            muls.push_back( bignum );
+            ctoc = cto1;
+        }
+        else {
+            real_t mul = ctoc / cfromc;
+            if (mul == 1)
+                return muls;
+            muls.push_back( mul );
+            break;
+        }
+    }
+    return muls;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> cfrom, blas::real_type<scalar_t> cto,
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    bool sym_band = (matrixtype == MatrixType::LowerBand
+                     || matrixtype == MatrixType::UpperBand);
+    bool band = sym_band || matrixtype == MatrixType::Band;
+    lapack_error_if( cfrom == 0 || std::isnan( cfrom ) );
+    lapack_error_if( std::isnan( cto ) );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 || (sym_band && n != m) );
+    if (! band) {
+        lapack_error_if( lda < max( 1, m ) );
+    }
+    else {
+        lapack_error_if( kl < 0 || kl > max( m - 1, 0 ) );
+        lapack_error_if( ku < 0 || ku > max( n - 1, 0 )
+                         || (sym_band && kl != ku) );
+        lapack_error_if( (matrixtype == MatrixType::LowerBand && lda < kl + 1)
+                         || (matrixtype == MatrixType::UpperBand && lda < ku + 1)
+                         || (matrixtype == MatrixType::Band && lda < 2*kl + ku + 1) );
+    }
+
+    if (m == 0 || n == 0)
+        return;
+
+    std::vector< real_t > muls = lascl_multipliers( cfrom, cto );
+    if (muls.empty())
+        return;
+
+    // Scale complex elements as pairs of reals.
+    const int64_t reals = sizeof(scalar_t) / sizeof(real_t);
+
+    Region region = { matrixtype, kl, ku, m, n };
+    int64_t elems;
+    std::vector< int64_t > bounds = column_chunks( region, &elems );
+    parallel_for( bounds.size() - 1, [&]( int64_t c, int worker ) {
+        for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+            int64_t i1, i2;
+            region.rows( j, &i1, &i2 );
+            real_t* x = (real_t*) &A[ i1 + j*lda ];
+            int64_t len = (i2 - i1) * reals;
+            for (int64_t i = 0; i < len; i += scale_block) {
+                int64_t ib = min( scale_block, len - i );
+                for (real_t mul : muls)
+                    scale( ib, mul, &x[ i ] );
+            }
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    float alpha, float const* A, int64_t lda,
+    float* B, int64_t ldb );
+
+template
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    double alpha, double const* A, int64_t lda,
+    double* B, int64_t ldb );
+
+template
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<float> alpha, std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb );
+
+template
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<double> alpha, std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb );
+
+template
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    float offdiag, float diag,
+    float* A, int64_t lda );
+
+template
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    double offdiag, double diag,
+    double* A, int64_t lda );
+
+template
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    std::complex<float> offdiag, std::complex<float> diag,
+    std::complex<float>* A, int64_t lda );
+
+template
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    std::complex<double> offdiag, std::complex<double> diag,
+    std::complex<double>* A, int64_t lda );
+
+template
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    float cfrom, float cto, int64_t m, int64_t n,
+    float* A, int64_t lda );
+
+template
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    double cfrom, double cto, int64_t m, int64_t n,
+    double* A, int64_t lda );
+
+template
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    float cfrom, float cto, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda );
+
+template
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    double cfrom, double cto, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda );
+
+}  // namespace internal
+}  // namespace lapack
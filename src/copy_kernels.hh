@@ -0,0 +1,50 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_COPY_KERNELS_HH
+#define LAPACK_COPY_KERNELS_HH
+
+#include "lapack/util.hh"
+
+#include "blas.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Native, vectorized and threaded copy, set, and scale kernels, used by
+// lacpy, laset, and lascl in place of the reference LAPACK loops. Columns
+// are spread over the thread pool. Plain copies and fills larger than the
+// last-level cache use non-temporal stores, so they don't evict the
+// caller's working set. Results are bitwise identical to LAPACK's, except
+// that complex lascl scales real and imaginary parts separately, as
+// zdscal does, rather than multiplying by the complex (mul, 0). This
+// avoids NaN from Inf * 0 and keeps the sign of zero parts.
+
+// B = alpha op(A), where A is m-by-n; B is n-by-m if trans != NoTrans.
+// matrixtype selects the part of A copied, as in lacpy.
+template <typename scalar_t>
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb );
+
+template <typename scalar_t>
+void laset(
+    lapack::MatrixType matrixtype, int64_t m, int64_t n,
+    scalar_t offdiag, scalar_t diag,
+    scalar_t* A, int64_t lda );
+
+template <typename scalar_t>
+void lascl(
+    lapack::MatrixType matrixtype, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> cfrom, blas::real_type<scalar_t> cto,
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_COPY_KERNELS_HH
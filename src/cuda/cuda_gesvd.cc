@@ -0,0 +1,252 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_CUBLAS)
+
+#include "lapack/device.hh"
+#include "cuda_common.hh"
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_gesvd_bufferSize(
+    cusolverDnHandle_t solver, int m, int n, float* dA, int* lwork )
+{
+    return cusolverDnSgesvd_bufferSize(
+        solver, m, n, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd_bufferSize(
+    cusolverDnHandle_t solver, int m, int n, double* dA, int* lwork )
+{
+    return cusolverDnDgesvd_bufferSize(
+        solver, m, n, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd_bufferSize(
+    cusolverDnHandle_t solver, int m, int n, std::complex<float>* dA, int* lwork )
+{
+    return cusolverDnCgesvd_bufferSize(
+        solver, m, n, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd_bufferSize(
+    cusolverDnHandle_t solver, int m, int n, std::complex<double>* dA, int* lwork )
+{
+    return cusolverDnZgesvd_bufferSize(
+        solver, m, n, lwork );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_gesvd(
+    cusolverDnHandle_t solver, signed char jobu, signed char jobvt,
+    int m, int n,
+    float* dA, int ldda, float* dS,
+    float* dU, int lddu,
+    float* dVT, int lddvt,
+    float* dev_work, int lwork, float* dev_rwork, int* info )
+{
+    return cusolverDnSgesvd(
+        solver, jobu, jobvt, m, n,
+        dA, ldda, dS,
+        dU, lddu,
+        dVT, lddvt,
+        dev_work, lwork, dev_rwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd(
+    cusolverDnHandle_t solver, signed char jobu, signed char jobvt,
+    int m, int n,
+    double* dA, int ldda, double* dS,
+    double* dU, int lddu,
+    double* dVT, int lddvt,
+    double* dev_work, int lwork, double* dev_rwork, int* info )
+{
+    return cusolverDnDgesvd(
+        solver, jobu, jobvt, m, n,
+        dA, ldda, dS,
+        dU, lddu,
+        dVT, lddvt,
+        dev_work, lwork, dev_rwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd(
+    cusolverDnHandle_t solver, signed char jobu, signed char jobvt,
+    int m, int n,
+    std::complex<float>* dA, int ldda, float* dS,
+    std::complex<float>* dU, int lddu,
+    std::complex<float>* dVT, int lddvt,
+    std::complex<float>* dev_work, int lwork, float* dev_rwork, int* info )
+{
+    return cusolverDnCgesvd(
+        solver, jobu, jobvt, m, n,
+        (cuFloatComplex*) dA, ldda, dS,
+        (cuFloatComplex*) dU, lddu,
+        (cuFloatComplex*) dVT, lddvt,
+        (cuFloatComplex*) dev_work, lwork, dev_rwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_gesvd(
+    cusolverDnHandle_t solver, signed char jobu, signed char jobvt,
+    int m, int n,
+    std::complex<double>* dA, int ldda, double* dS,
+    std::complex<double>* dU, int lddu,
+    std::complex<double>* dVT, int lddvt,
+    std::complex<double>* dev_work, int lwork, double* dev_rwork, int* info )
+{
+    return cusolverDnZgesvd(
+        solver, jobu, jobvt, m, n,
+        (cuDoubleComplex*) dA, ldda, dS,
+        (cuDoubleComplex*) dU, lddu,
+        (cuDoubleComplex*) dVT, lddvt,
+        (cuDoubleComplex*) dev_work, lwork, dev_rwork, info );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver workspace query.
+// dev_work holds cuSolver's work, followed by rwork of min( m, n ) reals,
+// for the unconverged superdiagonal.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    auto solver = queue.solver();
+
+    blas::set_device( queue.device() );
+
+    // query for workspace size
+    int lwork;
+    blas_dev_call(
+        cusolver_gesvd_bufferSize( solver, m, n, dA, &lwork ));
+    *dev_work_size = lwork * sizeof(scalar_t)
+                   + blas::min( m, n ) * sizeof(blas::real_type<scalar_t>);
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+// cuSolver requires m >= n.
+template <typename scalar_t>
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dS,
+    scalar_t* dU, int64_t lddu,
+    scalar_t* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // todo: check for overflow
+    lapack_error_if( m < n );
+    auto solver = queue.solver();
+
+    blas::set_device( queue.device() );
+
+    // carve rwork from the end of dev_work
+    size_t rwork_size = blas::min( m, n ) * sizeof(real_t);
+    lapack_error_if( dev_work_size < rwork_size );
+    int lwork = (dev_work_size - rwork_size) / sizeof(scalar_t);
+    real_t* dev_rwork = (real_t*) ((scalar_t*) dev_work + lwork);
+
+    // launch kernel
+    blas_dev_call(
+        cusolver_gesvd(
+            solver, job2char( jobu ), job2char( jobvt ), m, n,
+            dA, ldda, dS, dU, lddu, dVT, lddvt,
+            (scalar_t*) dev_work, lwork, dev_rwork, dev_info ));
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* dA, int64_t ldda, float* dS,
+    float* dU, int64_t lddu,
+    float* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* dA, int64_t ldda, double* dS,
+    double* dU, int64_t lddu,
+    double* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda, float* dS,
+    std::complex<float>* dU, int64_t lddu,
+    std::complex<float>* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda, double* dS,
+    std::complex<double>* dU, int64_t lddu,
+    std::complex<double>* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_CUBLAS
@@ -0,0 +1,192 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_CUBLAS)
+
+#include "lapack/device.hh"
+#include "cuda_common.hh"
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+namespace blas {
+namespace device {
+
+cublasOperation_t op2cublas( blas::Op trans );
+
+} // namespace device
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_getrs(
+    cusolverDnHandle_t solver, cublasOperation_t trans, int n, int nrhs,
+    float const* dA, int ldda, int const* dipiv,
+    float* dB, int lddb, int* info )
+{
+    return cusolverDnSgetrs(
+        solver, trans, n, nrhs,
+        dA, ldda, dipiv,
+        dB, lddb, info );
+}
+
+//----------
+cusolverStatus_t cusolver_getrs(
+    cusolverDnHandle_t solver, cublasOperation_t trans, int n, int nrhs,
+    double const* dA, int ldda, int const* dipiv,
+    double* dB, int lddb, int* info )
+{
+    return cusolverDnDgetrs(
+        solver, trans, n, nrhs,
+        dA, ldda, dipiv,
+        dB, lddb, info );
+}
+
+//----------
+cusolverStatus_t cusolver_getrs(
+    cusolverDnHandle_t solver, cublasOperation_t trans, int n, int nrhs,
+    std::complex<float> const* dA, int ldda, int const* dipiv,
+    std::complex<float>* dB, int lddb, int* info )
+{
+    return cusolverDnCgetrs(
+        solver, trans, n, nrhs,
+        (cuFloatComplex const*) dA, ldda, dipiv,
+        (cuFloatComplex*) dB, lddb, info );
+}
+
+//----------
+cusolverStatus_t cusolver_getrs(
+    cusolverDnHandle_t solver, cublasOperation_t trans, int n, int nrhs,
+    std::complex<double> const* dA, int ldda, int const* dipiv,
+    std::complex<double>* dB, int lddb, int* info )
+{
+    return cusolverDnZgetrs(
+        solver, trans, n, nrhs,
+        (cuDoubleComplex const*) dA, ldda, dipiv,
+        (cuDoubleComplex*) dB, lddb, info );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver workspace query. No workspace is needed.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    *dev_work_size  = 0;
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dipiv,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    auto solver = queue.solver();
+    auto trans_ = blas::device::op2cublas( trans );
+
+    blas::set_device( queue.device() );
+
+    // launch kernel
+    #if CUSOLVER_VERSION >= 11000
+        auto params = queue.solver_params();
+        blas_dev_call(
+            cusolverDnXgetrs(
+                solver, params, trans_, n, nrhs,
+                CudaTraits<scalar_t>::datatype, dA, ldda, dipiv,
+                CudaTraits<scalar_t>::datatype, dB, lddb, dev_info ));
+    #else
+        blas_dev_call(
+            cusolver_getrs(
+                solver, trans_, n, nrhs, dA, ldda, dipiv,
+                dB, lddb, dev_info ));
+    #endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* dA, int64_t ldda, device_pivot_int const* dipiv,
+    float* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* dA, int64_t ldda, device_pivot_int const* dipiv,
+    double* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* dA, int64_t ldda, device_pivot_int const* dipiv,
+    std::complex<float>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* dA, int64_t ldda, device_pivot_int const* dipiv,
+    std::complex<double>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_CUBLAS
@@ -0,0 +1,239 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_CUBLAS)
+
+#include "lapack/device.hh"
+#include "cuda_common.hh"
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+namespace blas {
+namespace device {
+
+cublasFillMode_t uplo2cublas( blas::Uplo uplo );
+
+} // namespace device
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_heevd_bufferSize(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, float const* dA, int ldda, float const* dW, int* lwork )
+{
+    return cusolverDnSsyevd_bufferSize(
+        solver, jobz, uplo, n,
+        dA, ldda, dW, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd_bufferSize(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, double const* dA, int ldda, double const* dW, int* lwork )
+{
+    return cusolverDnDsyevd_bufferSize(
+        solver, jobz, uplo, n,
+        dA, ldda, dW, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd_bufferSize(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, std::complex<float> const* dA, int ldda, float const* dW, int* lwork )
+{
+    return cusolverDnCheevd_bufferSize(
+        solver, jobz, uplo, n,
+        (cuFloatComplex const*) dA, ldda, dW, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd_bufferSize(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, std::complex<double> const* dA, int ldda, double const* dW, int* lwork )
+{
+    return cusolverDnZheevd_bufferSize(
+        solver, jobz, uplo, n,
+        (cuDoubleComplex const*) dA, ldda, dW, lwork );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_heevd(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, float* dA, int ldda, float* dW,
+    float* dev_work, int lwork, int* info )
+{
+    return cusolverDnSsyevd(
+        solver, jobz, uplo, n,
+        dA, ldda, dW,
+        dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, double* dA, int ldda, double* dW,
+    double* dev_work, int lwork, int* info )
+{
+    return cusolverDnDsyevd(
+        solver, jobz, uplo, n,
+        dA, ldda, dW,
+        dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, std::complex<float>* dA, int ldda, float* dW,
+    std::complex<float>* dev_work, int lwork, int* info )
+{
+    return cusolverDnCheevd(
+        solver, jobz, uplo, n,
+        (cuFloatComplex*) dA, ldda, dW,
+        (cuFloatComplex*) dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_heevd(
+    cusolverDnHandle_t solver, cusolverEigMode_t jobz, cublasFillMode_t uplo,
+    int n, std::complex<double>* dA, int ldda, double* dW,
+    std::complex<double>* dev_work, int lwork, int* info )
+{
+    return cusolverDnZheevd(
+        solver, jobz, uplo, n,
+        (cuDoubleComplex*) dA, ldda, dW,
+        (cuDoubleComplex*) dev_work, lwork, info );
+}
+
+//------------------------------------------------------------------------------
+inline cusolverEigMode_t job2cusolver( lapack::Job jobz )
+{
+    return jobz == Job::Vec ? CUSOLVER_EIG_MODE_VECTOR
+                            : CUSOLVER_EIG_MODE_NOVECTOR;
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver workspace query.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    auto solver = queue.solver();
+    auto jobz_ = job2cusolver( jobz );
+    auto uplo_ = blas::device::uplo2cublas( uplo );
+
+    blas::set_device( queue.device() );
+
+    // query for workspace size
+    int lwork;
+    blas_dev_call(
+        cusolver_heevd_bufferSize(
+            solver, jobz_, uplo_, n, dA, ldda, nullptr, &lwork ));
+    *dev_work_size = lwork * sizeof(scalar_t);
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    auto solver = queue.solver();
+    auto jobz_ = job2cusolver( jobz );
+    auto uplo_ = blas::device::uplo2cublas( uplo );
+
+    blas::set_device( queue.device() );
+
+    // launch kernel
+    int lwork = dev_work_size / sizeof(scalar_t);
+    blas_dev_call(
+        cusolver_heevd(
+            solver, jobz_, uplo_, n, dA, ldda, dW,
+            (scalar_t*) dev_work, lwork, dev_info ));
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* dA, int64_t ldda, float* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* dA, int64_t ldda, double* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* dA, int64_t ldda, float* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* dA, int64_t ldda, double* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_CUBLAS
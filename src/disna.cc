@@ -25,6 +25,11 @@ int64_t disna(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "disna", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobcond_ = jobcond2char( jobcond );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -55,6 +60,11 @@ int64_t disna(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "disna", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobcond_ = jobcond2char( jobcond );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -38,6 +39,11 @@ int64_t gbbrd(
         lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbbrd", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -51,7 +57,7 @@ int64_t gbbrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*max(m,n)) );
+    lapack::small_vector< float > work( (2*max(m,n)) );
 
     LAPACK_sgbbrd(
         &vect_, &m_, &n_, &ncc_, &kl_, &ku_,
@@ -95,6 +101,11 @@ int64_t gbbrd(
         lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbbrd", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -108,7 +119,7 @@ int64_t gbbrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*max(m,n)) );
+    lapack::small_vector< double > work( (2*max(m,n)) );
 
     LAPACK_dgbbrd(
         &vect_, &m_, &n_, &ncc_, &kl_, &ku_,
@@ -152,6 +163,11 @@ int64_t gbbrd(
         lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbbrd", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -165,8 +181,8 @@ int64_t gbbrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (max(m,n)) );
-    lapack::vector< float > rwork( (max(m,n)) );
+    lapack::small_vector< std::complex<float> > work( (max(m,n)) );
+    lapack::small_vector< float > rwork( (max(m,n)) );
 
     LAPACK_cgbbrd(
         &vect_, &m_, &n_, &ncc_, &kl_, &ku_,
@@ -296,6 +312,11 @@ int64_t gbbrd(
         lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbbrd", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -309,8 +330,8 @@ int64_t gbbrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (max(m,n)) );
-    lapack::vector< double > rwork( (max(m,n)) );
+    lapack::small_vector< std::complex<double> > work( (max(m,n)) );
+    lapack::small_vector< double > rwork( (max(m,n)) );
 
     LAPACK_zgbbrd(
         &vect_, &m_, &n_, &ncc_, &kl_, &ku_,
@@ -332,4 +353,332 @@ int64_t gbbrd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gbbrd(
+    char vect, lapack_int m, lapack_int n, lapack_int ncc, lapack_int kl, lapack_int ku,
+    float* AB, lapack_int ldab,
+    float* D,
+    float* E,
+    float* Q, lapack_int ldq,
+    float* PT, lapack_int ldpt,
+    float* C, lapack_int ldc,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgbbrd(
+        &vect, &m, &n, &ncc, &kl, &ku,
+        AB, &ldab,
+        D,
+        E,
+        Q, &ldq,
+        PT, &ldpt,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbbrd(
+    char vect, lapack_int m, lapack_int n, lapack_int ncc, lapack_int kl, lapack_int ku,
+    double* AB, lapack_int ldab,
+    double* D,
+    double* E,
+    double* Q, lapack_int ldq,
+    double* PT, lapack_int ldpt,
+    double* C, lapack_int ldc,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgbbrd(
+        &vect, &m, &n, &ncc, &kl, &ku,
+        AB, &ldab,
+        D,
+        E,
+        Q, &ldq,
+        PT, &ldpt,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbbrd(
+    char vect, lapack_int m, lapack_int n, lapack_int ncc, lapack_int kl, lapack_int ku,
+    std::complex<float>* AB, lapack_int ldab,
+    float* D,
+    float* E,
+    std::complex<float>* Q, lapack_int ldq,
+    std::complex<float>* PT, lapack_int ldpt,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgbbrd(
+        &vect, &m, &n, &ncc, &kl, &ku,
+        (lapack_complex_float*) AB, &ldab,
+        D,
+        E,
+        (lapack_complex_float*) Q, &ldq,
+        (lapack_complex_float*) PT, &ldpt,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbbrd(
+    char vect, lapack_int m, lapack_int n, lapack_int ncc, lapack_int kl, lapack_int ku,
+    std::complex<double>* AB, lapack_int ldab,
+    double* D,
+    double* E,
+    std::complex<double>* Q, lapack_int ldq,
+    std::complex<double>* PT, lapack_int ldpt,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgbbrd(
+        &vect, &m, &n, &ncc, &kl, &ku,
+        (lapack_complex_double*) AB, &ldab,
+        D,
+        E,
+        (lapack_complex_double*) Q, &ldq,
+        (lapack_complex_double*) PT, &ldpt,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gbbrd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* PT, int64_t ldpt,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? max(m,n) : 2*max(m,n) );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? max(m,n) : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gbbrd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gbbrd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gbbrd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* PT, int64_t ldpt,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ncc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldpt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gbbrd", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char vect_ = vect2char( vect );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ncc_ = (lapack_int) ncc;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int ldpt_ = (lapack_int) ldpt;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? max(m,n) : 2*max(m,n) );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? max(m,n) : 0 );
+
+    fortran_gbbrd(
+        vect_, m_, n_, ncc_, kl_, ku_,
+        AB, ldab_,
+        D,
+        E,
+        Q, ldq_,
+        PT, ldpt_,
+        C, ldc_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    float* PT, int64_t ldpt,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    double* PT, int64_t ldpt,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    std::complex<float>* AB, int64_t ldab,
+    float* D,
+    float* E,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* PT, int64_t ldpt,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gbbrd_work_size_bytes(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    std::complex<double>* AB, int64_t ldab,
+    double* D,
+    double* E,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* PT, int64_t ldpt,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    float* PT, int64_t ldpt,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    double* PT, int64_t ldpt,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    std::complex<float>* AB, int64_t ldab,
+    float* D,
+    float* E,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* PT, int64_t ldpt,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gbbrd(
+    lapack::Vect vect, int64_t m, int64_t n, int64_t ncc, int64_t kl,
+    int64_t ku,
+    std::complex<double>* AB, int64_t ldab,
+    double* D,
+    double* E,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* PT, int64_t ldpt,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -30,6 +31,11 @@ int64_t gbcon(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbcon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -37,7 +43,7 @@ int64_t gbcon(
     lapack_int ldab_ = (lapack_int) ldab;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -45,8 +51,8 @@ int64_t gbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgbcon(
         &norm_, &n_, &kl_, &ku_,
@@ -79,6 +85,11 @@ int64_t gbcon(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbcon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -86,7 +97,7 @@ int64_t gbcon(
     lapack_int ldab_ = (lapack_int) ldab;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -94,8 +105,8 @@ int64_t gbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgbcon(
         &norm_, &n_, &kl_, &ku_,
@@ -128,6 +139,11 @@ int64_t gbcon(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -135,7 +151,7 @@ int64_t gbcon(
     lapack_int ldab_ = (lapack_int) ldab;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -143,8 +159,8 @@ int64_t gbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cgbcon(
         &norm_, &n_, &kl_, &ku_,
@@ -229,6 +245,11 @@ int64_t gbcon(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -236,7 +257,7 @@ int64_t gbcon(
     lapack_int ldab_ = (lapack_int) ldab;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -244,8 +265,8 @@ int64_t gbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zgbcon(
         &norm_, &n_, &kl_, &ku_,
@@ -263,4 +284,250 @@ int64_t gbcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gbcon(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    float const* AB, lapack_int ldab,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgbcon(
+        &norm, &n, &kl, &ku,
+        AB, &ldab,
+        ipiv, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbcon(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    double const* AB, lapack_int ldab,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgbcon(
+        &norm, &n, &kl, &ku,
+        AB, &ldab,
+        ipiv, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbcon(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    std::complex<float> const* AB, lapack_int ldab,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgbcon(
+        &norm, &n, &kl, &ku,
+        (lapack_complex_float const*) AB, &ldab,
+        ipiv, &anorm, rcond,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbcon(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    std::complex<double> const* AB, lapack_int ldab,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgbcon(
+        &norm, &n, &kl, &ku,
+        (lapack_complex_double const*) AB, &ldab,
+        ipiv, &anorm, rcond,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gbcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gbcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gbcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gbcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gbcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_gbcon(
+        norm_, n_, kl_, ku_,
+        AB, ldab_,
+        ipiv_ptr, anorm, rcond,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    float const* AB, int64_t ldab, float anorm,
+    size_t* work_size );
+
+template
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    double const* AB, int64_t ldab, double anorm,
+    size_t* work_size );
+
+template
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float> const* AB, int64_t ldab, float anorm,
+    size_t* work_size );
+
+template
+void gbcon_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double> const* AB, int64_t ldab, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    float const* AB, int64_t ldab,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    double const* AB, int64_t ldab,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float> const* AB, int64_t ldab,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gbcon(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double> const* AB, int64_t ldab,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -33,6 +33,11 @@ int64_t gbequ(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequ", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -70,6 +75,11 @@ int64_t gbequ(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequ", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -107,6 +117,11 @@ int64_t gbequ(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequ", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -209,6 +224,11 @@ int64_t gbequ(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequ", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
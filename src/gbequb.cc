@@ -33,6 +33,11 @@ int64_t gbequb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequb", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -70,6 +75,11 @@ int64_t gbequb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequb", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -107,6 +117,11 @@ int64_t gbequb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequb", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -216,6 +231,11 @@ int64_t gbequb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbequb", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
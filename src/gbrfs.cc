@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -38,6 +39,11 @@ int64_t gbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfs", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -47,7 +53,7 @@ int64_t gbrfs(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -57,8 +63,8 @@ int64_t gbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgbrfs(
         &trans_, &n_, &kl_, &ku_, &nrhs_,
@@ -104,6 +110,11 @@ int64_t gbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfs", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -113,7 +124,7 @@ int64_t gbrfs(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -123,8 +134,8 @@ int64_t gbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgbrfs(
         &trans_, &n_, &kl_, &ku_, &nrhs_,
@@ -170,6 +181,11 @@ int64_t gbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfs", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -179,7 +195,7 @@ int64_t gbrfs(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -189,8 +205,8 @@ int64_t gbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cgbrfs(
         &trans_, &n_, &kl_, &ku_, &nrhs_,
@@ -322,6 +338,11 @@ int64_t gbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfs", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -331,7 +352,7 @@ int64_t gbrfs(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -341,8 +362,8 @@ int64_t gbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zgbrfs(
         &trans_, &n_, &kl_, &ku_, &nrhs_,
@@ -365,4 +386,352 @@ int64_t gbrfs(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gbrfs(
+    char trans, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    float const* AB, lapack_int ldab,
+    float const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgbrfs(
+        &trans, &n, &kl, &ku, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfs(
+    char trans, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    double const* AB, lapack_int ldab,
+    double const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgbrfs(
+        &trans, &n, &kl, &ku, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfs(
+    char trans, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    std::complex<float> const* AB, lapack_int ldab,
+    std::complex<float> const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgbrfs(
+        &trans, &n, &kl, &ku, &nrhs,
+        (lapack_complex_float const*) AB, &ldab,
+        (lapack_complex_float const*) AFB, &ldafb,
+        ipiv,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfs(
+    char trans, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    std::complex<double> const* AB, lapack_int ldab,
+    std::complex<double> const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgbrfs(
+        &trans, &n, &kl, &ku, &nrhs,
+        (lapack_complex_double const*) AB, &ldab,
+        (lapack_complex_double const*) AFB, &ldafb,
+        ipiv,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gbrfs with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gbrfs, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gbrfs for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gbrfs_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gbrfs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldafb_ = (lapack_int) ldafb;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_gbrfs(
+        trans_, n_, kl_, ku_, nrhs_,
+        AB, ldab_,
+        AFB, ldafb_,
+        ipiv_ptr,
+        B, ldb_,
+        X, ldx_,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* AFB, int64_t ldafb,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* AFB, int64_t ldafb,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* AFB, int64_t ldafb,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gbrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* AFB, int64_t ldafb,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #ifdef LAPACK_HAVE_XBLAS
 
@@ -47,6 +48,11 @@ int64_t gbrfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfsx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -57,7 +63,7 @@ int64_t gbrfsx(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -69,8 +75,8 @@ int64_t gbrfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgbrfsx(
         &trans_, &equed_, &n_, &kl_, &ku_, &nrhs_,
@@ -127,6 +133,11 @@ int64_t gbrfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfsx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -137,7 +148,7 @@ int64_t gbrfsx(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -149,8 +160,8 @@ int64_t gbrfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgbrfsx(
         &trans_, &equed_, &n_, &kl_, &ku_, &nrhs_,
@@ -207,6 +218,11 @@ int64_t gbrfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfsx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -217,7 +233,7 @@ int64_t gbrfsx(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -229,8 +245,8 @@ int64_t gbrfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgbrfsx(
         &trans_, &equed_, &n_, &kl_, &ku_, &nrhs_,
@@ -588,6 +604,11 @@ int64_t gbrfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gbrfsx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -598,7 +619,7 @@ int64_t gbrfsx(
     lapack_int ldafb_ = (lapack_int) ldafb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -610,8 +631,8 @@ int64_t gbrfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgbrfsx(
         &trans_, &equed_, &n_, &kl_, &ku_, &nrhs_,
@@ -638,6 +659,452 @@ int64_t gbrfsx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gbrfsx(
+    char trans, char equed, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    float const* AB, lapack_int ldab,
+    float const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    float* R,
+    float* C,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* berr, lapack_int n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, lapack_int nparams,
+    float* params,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgbrfsx(
+        &trans, &equed, &n, &kl, &ku, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb,
+        ipiv,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfsx(
+    char trans, char equed, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    double const* AB, lapack_int ldab,
+    double const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    double* R,
+    double* C,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* berr, lapack_int n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, lapack_int nparams,
+    double* params,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgbrfsx(
+        &trans, &equed, &n, &kl, &ku, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb,
+        ipiv,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfsx(
+    char trans, char equed, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    std::complex<float> const* AB, lapack_int ldab,
+    std::complex<float> const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    float* R,
+    float* C,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* berr, lapack_int n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, lapack_int nparams,
+    float* params,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgbrfsx(
+        &trans, &equed, &n, &kl, &ku, &nrhs,
+        (lapack_complex_float const*) AB, &ldab,
+        (lapack_complex_float const*) AFB, &ldafb,
+        ipiv,
+        R,
+        C,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gbrfsx(
+    char trans, char equed, lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs,
+    std::complex<double> const* AB, lapack_int ldab,
+    std::complex<double> const* AFB, lapack_int ldafb,
+    lapack_int const* ipiv,
+    double* R,
+    double* C,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* berr, lapack_int n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, lapack_int nparams,
+    double* params,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgbrfsx(
+        &trans, &equed, &n, &kl, &ku, &nrhs,
+        (lapack_complex_double const*) AB, &ldab,
+        (lapack_complex_double const*) AFB, &ldafb,
+        ipiv,
+        R,
+        C,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gbrfsx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gbrfsx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gbrfsx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gbrfsx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gbrfsx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    char equed_ = equed2char( equed );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldafb_ = (lapack_int) ldafb;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int n_err_bnds_ = (lapack_int) n_err_bnds;
+    lapack_int nparams_ = (lapack_int) nparams;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+
+    fortran_gbrfsx(
+        trans_, equed_, n_, kl_, ku_, nrhs_,
+        AB, ldab_,
+        AFB, ldafb_,
+        ipiv_ptr,
+        R,
+        C,
+        B, ldb_,
+        X, ldx_, rcond,
+        berr, n_err_bnds_,
+        err_bnds_norm,
+        err_bnds_comp, nparams_,
+        params,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* AFB, int64_t ldafb,
+    float* R,
+    float* C,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size );
+
+template
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* AFB, int64_t ldafb,
+    double* R,
+    double* C,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size );
+
+template
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* AFB, int64_t ldafb,
+    float* R,
+    float* C,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size );
+
+template
+void gbrfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* AFB, int64_t ldafb,
+    double* R,
+    double* C,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    float* R,
+    float* C,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    double* R,
+    double* C,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    float* R,
+    float* C,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size );
+
+template
+int64_t gbrfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t kl, int64_t ku,
+    int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* AFB, int64_t ldafb,
+    int64_t const* ipiv,
+    double* R,
+    double* C,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // HAVE_XBLAS
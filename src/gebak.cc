@@ -29,6 +29,11 @@ int64_t gebak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebak", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -67,6 +72,11 @@ int64_t gebak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebak", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -105,6 +115,11 @@ int64_t gebak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebak", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -192,6 +207,11 @@ int64_t gebak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebak", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
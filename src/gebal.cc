@@ -28,6 +28,11 @@ int64_t gebal(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebal", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -65,6 +70,11 @@ int64_t gebal(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebal", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -102,6 +112,11 @@ int64_t gebal(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebal", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -228,6 +243,11 @@ int64_t gebal(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebal", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +33,11 @@ int64_t gebrd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebrd", 's', m, n, -1,
+        [&]() { return Gflop< float >::gebrd( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -53,7 +60,7 @@ int64_t gebrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgebrd(
         &m_, &n_,
@@ -85,6 +92,11 @@ int64_t gebrd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebrd", 'd', m, n, -1,
+        [&]() { return Gflop< double >::gebrd( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -107,7 +119,7 @@ int64_t gebrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgebrd(
         &m_, &n_,
@@ -139,6 +151,11 @@ int64_t gebrd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebrd", 'c', m, n, -1,
+        [&]() { return Gflop< std::complex<float> >::gebrd( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -161,7 +178,7 @@ int64_t gebrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgebrd(
         &m_, &n_,
@@ -321,6 +338,11 @@ int64_t gebrd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gebrd", 'z', m, n, -1,
+        [&]() { return Gflop< std::complex<double> >::gebrd( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -343,7 +365,7 @@ int64_t gebrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgebrd(
         &m_, &n_,
@@ -359,4 +381,276 @@ int64_t gebrd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gebrd(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* D,
+    float* E,
+    float* tauq,
+    float* taup,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgebrd(
+        &m, &n,
+        A, &lda,
+        D,
+        E,
+        tauq,
+        taup,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gebrd(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* D,
+    double* E,
+    double* tauq,
+    double* taup,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgebrd(
+        &m, &n,
+        A, &lda,
+        D,
+        E,
+        tauq,
+        taup,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gebrd(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    float* D,
+    float* E,
+    std::complex<float>* tauq,
+    std::complex<float>* taup,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgebrd(
+        &m, &n,
+        (lapack_complex_float*) A, &lda,
+        D,
+        E,
+        (lapack_complex_float*) tauq,
+        (lapack_complex_float*) taup,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_gebrd(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    double* D,
+    double* E,
+    std::complex<double>* tauq,
+    std::complex<double>* taup,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgebrd(
+        &m, &n,
+        (lapack_complex_double*) A, &lda,
+        D,
+        E,
+        (lapack_complex_double*) tauq,
+        (lapack_complex_double*) taup,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gebrd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tauq,
+    scalar_t* taup,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gebrd(
+        m_, n_,
+        A, lda_,
+        D,
+        E,
+        tauq,
+        taup,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gebrd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gebrd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gebrd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gebrd(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* tauq,
+    scalar_t* taup,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gebrd", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return Gflop< scalar_t >::gebrd( m, n ); } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gebrd(
+        m_, n_,
+        A, lda_,
+        D,
+        E,
+        tauq,
+        taup,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tauq,
+    float* taup,
+    size_t* work_size );
+
+template
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tauq,
+    double* taup,
+    size_t* work_size );
+
+template
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tauq,
+    std::complex<float>* taup,
+    size_t* work_size );
+
+template
+void gebrd_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tauq,
+    std::complex<double>* taup,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gebrd(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tauq,
+    float* taup,
+    void* work, size_t work_size );
+
+template
+int64_t gebrd(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tauq,
+    double* taup,
+    void* work, size_t work_size );
+
+template
+int64_t gebrd(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tauq,
+    std::complex<float>* taup,
+    void* work, size_t work_size );
+
+template
+int64_t gebrd(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tauq,
+    std::complex<double>* taup,
+    void* work, size_t work_size );
+
 }  // namespace lapack
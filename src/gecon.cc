@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,14 +28,19 @@ int64_t gecon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gecon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgecon(
         &norm_, &n_,
@@ -63,14 +69,19 @@ int64_t gecon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gecon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgecon(
         &norm_, &n_,
@@ -99,14 +110,19 @@ int64_t gecon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gecon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgecon(
         &norm_, &n_,
@@ -173,14 +189,19 @@ int64_t gecon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gecon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgecon(
         &norm_, &n_,
@@ -197,4 +218,220 @@ int64_t gecon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gecon(
+    char norm, lapack_int n,
+    float const* A, lapack_int lda, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgecon(
+        &norm, &n,
+        A, &lda, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gecon(
+    char norm, lapack_int n,
+    double const* A, lapack_int lda, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgecon(
+        &norm, &n,
+        A, &lda, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gecon(
+    char norm, lapack_int n,
+    std::complex<float> const* A, lapack_int lda, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgecon(
+        &norm, &n,
+        (lapack_complex_float const*) A, &lda, &anorm, rcond,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gecon(
+    char norm, lapack_int n,
+    std::complex<double> const* A, lapack_int lda, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgecon(
+        &norm, &n,
+        (lapack_complex_double const*) A, &lda, &anorm, rcond,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gecon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gecon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gecon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gecon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gecon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+
+    fortran_gecon(
+        norm_, n_,
+        A, lda_, anorm, rcond,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    float const* A, int64_t lda, float anorm,
+    size_t* work_size );
+
+template
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    double const* A, int64_t lda, double anorm,
+    size_t* work_size );
+
+template
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* A, int64_t lda, float anorm,
+    size_t* work_size );
+
+template
+void gecon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* A, int64_t lda, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    float const* A, int64_t lda, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    double const* A, int64_t lda, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* A, int64_t lda, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gecon(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* A, int64_t lda, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
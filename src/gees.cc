@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +30,11 @@ int64_t gees(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gees", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     lapack_int n_ = (lapack_int) n;
@@ -38,8 +44,8 @@ int64_t gees(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
+    lapack::small_vector< float > WR( max( 1, n ) );
+    lapack::small_vector< float > WI( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -64,8 +70,8 @@ int64_t gees(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_sgees(
         &jobvs_, &sort_,
@@ -105,6 +111,11 @@ int64_t gees(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gees", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     lapack_int n_ = (lapack_int) n;
@@ -114,8 +125,8 @@ int64_t gees(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
+    lapack::small_vector< double > WR( max( 1, n ) );
+    lapack::small_vector< double > WI( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -140,8 +151,8 @@ int64_t gees(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_dgees(
         &jobvs_, &sort_,
@@ -181,6 +192,11 @@ int64_t gees(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gees", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     lapack_int n_ = (lapack_int) n;
@@ -213,9 +229,9 @@ int64_t gees(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_cgees(
         &jobvs_, &sort_,
@@ -251,6 +267,11 @@ int64_t gees(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gees", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     lapack_int n_ = (lapack_int) n;
@@ -283,9 +304,9 @@ int64_t gees(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_zgees(
         &jobvs_, &sort_,
@@ -307,4 +328,339 @@ int64_t gees(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (WR, WI)
+// and don't reference W or rwork; complex precisions return W
+// directly and don't reference WR, WI.
+static void fortran_gees(
+    char jobvs, char sort,
+    lapack_s_select2 select, lapack_int n,
+    float* A, lapack_int lda, lapack_int* sdim,
+    std::complex<float>* W, float* WR, float* WI,
+    float* VS, lapack_int ldvs,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_sgees(
+        &jobvs, &sort,
+        select, &n,
+        A, &lda, sdim,
+        WR, WI,
+        VS, &ldvs,
+        work, &lwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gees(
+    char jobvs, char sort,
+    lapack_d_select2 select, lapack_int n,
+    double* A, lapack_int lda, lapack_int* sdim,
+    std::complex<double>* W, double* WR, double* WI,
+    double* VS, lapack_int ldvs,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_dgees(
+        &jobvs, &sort,
+        select, &n,
+        A, &lda, sdim,
+        WR, WI,
+        VS, &ldvs,
+        work, &lwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gees(
+    char jobvs, char sort,
+    lapack_c_select1 select, lapack_int n,
+    std::complex<float>* A, lapack_int lda, lapack_int* sdim,
+    std::complex<float>* W, float* WR, float* WI,
+    std::complex<float>* VS, lapack_int ldvs,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_cgees(
+        &jobvs, &sort,
+        (LAPACK_C_SELECT1) select, &n,
+        (lapack_complex_float*) A, &lda, sdim,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) VS, &ldvs,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gees(
+    char jobvs, char sort,
+    lapack_z_select1 select, lapack_int n,
+    std::complex<double>* A, lapack_int lda, lapack_int* sdim,
+    std::complex<double>* W, double* WR, double* WI,
+    std::complex<double>* VS, lapack_int ldvs,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_zgees(
+        &jobvs, &sort,
+        (LAPACK_Z_SELECT1) select, &n,
+        (lapack_complex_double*) A, &lda, sdim,
+        (lapack_complex_double*) W,
+        (lapack_complex_double*) VS, &ldvs,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gees with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvs_ = job2char( jobvs );
+    char sort_ = sort2char( sort );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int sdim_ = 0;
+    lapack_int ldvs_ = (lapack_int) ldvs;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_gees(
+        jobvs_, sort_,
+        select, n_,
+        A, lda_, &sdim_,
+        W, qry_WR, qry_WI,
+        VS, ldvs_,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WR
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WI
+    buffer.take< real_t >( is_complex ? n : 0 );  // rwork
+    buffer.take< lapack_int >( n );  // bwork
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gees, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gees for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gees_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gees", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvs_ = job2char( jobvs );
+    char sort_ = sort2char( sort );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int sdim_ = (lapack_int) *sdim;
+    lapack_int ldvs_ = (lapack_int) ldvs;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* WR = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* WI = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? n : 0 );
+    lapack_int* bwork_ = buffer.take< lapack_int >( n );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gees(
+        jobvs_, sort_,
+        select, n_,
+        A, lda_, &sdim_,
+        W, WR, WI,
+        VS, ldvs_,
+        work_, lwork_,
+        rwork_,
+        bwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *sdim = sdim_;
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            W[i] = complex_t( WR[i], WI[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_s_select2 select,
+    int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_d_select2 select,
+    int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_c_select1 select,
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void gees_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_z_select1 select,
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VS, int64_t ldvs,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_s_select2 select,
+    int64_t n,
+    float* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<float>* W,
+    float* VS, int64_t ldvs,
+    void* work, size_t work_size );
+
+template
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_d_select2 select,
+    int64_t n,
+    double* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<double>* W,
+    double* VS, int64_t ldvs,
+    void* work, size_t work_size );
+
+template
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_c_select1 select,
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<float>* W,
+    std::complex<float>* VS, int64_t ldvs,
+    void* work, size_t work_size );
+
+template
+int64_t gees(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_z_select1 select,
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<double>* W,
+    std::complex<double>* VS, int64_t ldvs,
+    void* work, size_t work_size );
+
 }  // namespace lapack
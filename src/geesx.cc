@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t geesx(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geesx", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     char sense_ = sense2char( sense );
@@ -41,8 +47,8 @@ int64_t geesx(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
+    lapack::small_vector< float > WR( max( 1, n ) );
+    lapack::small_vector< float > WI( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -70,9 +76,9 @@ int64_t geesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_sgeesx(
         &jobvs_, &sort_,
@@ -115,6 +121,11 @@ int64_t geesx(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geesx", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     char sense_ = sense2char( sense );
@@ -125,8 +136,8 @@ int64_t geesx(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
+    lapack::small_vector< double > WR( max( 1, n ) );
+    lapack::small_vector< double > WI( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -154,9 +165,9 @@ int64_t geesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_dgeesx(
         &jobvs_, &sort_,
@@ -199,6 +210,11 @@ int64_t geesx(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geesx", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     char sense_ = sense2char( sense );
@@ -232,9 +248,9 @@ int64_t geesx(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_cgeesx(
         &jobvs_, &sort_,
@@ -272,6 +288,11 @@ int64_t geesx(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geesx", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvs_ = job2char( jobvs );
     char sort_ = sort2char( sort );
     char sense_ = sense2char( sense );
@@ -305,9 +326,9 @@ int64_t geesx(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_zgeesx(
         &jobvs_, &sort_,
@@ -329,4 +350,395 @@ int64_t geesx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (WR, WI)
+// and don't reference W or rwork; complex precisions return W
+// directly and don't reference WR, WI, or iwork.
+static void fortran_geesx(
+    char jobvs, char sort,
+    lapack_s_select2 select, char sense, lapack_int n,
+    float* A, lapack_int lda, lapack_int* sdim,
+    std::complex<float>* W, float* WR, float* WI,
+    float* VS, lapack_int ldvs,
+    float* rconde, float* rcondv,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_sgeesx(
+        &jobvs, &sort,
+        select, &sense, &n,
+        A, &lda, sdim,
+        WR, WI,
+        VS, &ldvs, rconde, rcondv,
+        work, &lwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geesx(
+    char jobvs, char sort,
+    lapack_d_select2 select, char sense, lapack_int n,
+    double* A, lapack_int lda, lapack_int* sdim,
+    std::complex<double>* W, double* WR, double* WI,
+    double* VS, lapack_int ldvs,
+    double* rconde, double* rcondv,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_dgeesx(
+        &jobvs, &sort,
+        select, &sense, &n,
+        A, &lda, sdim,
+        WR, WI,
+        VS, &ldvs, rconde, rcondv,
+        work, &lwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geesx(
+    char jobvs, char sort,
+    lapack_c_select1 select, char sense, lapack_int n,
+    std::complex<float>* A, lapack_int lda, lapack_int* sdim,
+    std::complex<float>* W, float* WR, float* WI,
+    std::complex<float>* VS, lapack_int ldvs,
+    float* rconde, float* rcondv,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_cgeesx(
+        &jobvs, &sort,
+        (LAPACK_C_SELECT1) select, &sense, &n,
+        (lapack_complex_float*) A, &lda, sdim,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) VS, &ldvs, rconde, rcondv,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geesx(
+    char jobvs, char sort,
+    lapack_z_select1 select, char sense, lapack_int n,
+    std::complex<double>* A, lapack_int lda, lapack_int* sdim,
+    std::complex<double>* W, double* WR, double* WI,
+    std::complex<double>* VS, lapack_int ldvs,
+    double* rconde, double* rcondv,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_zgeesx(
+        &jobvs, &sort,
+        (LAPACK_Z_SELECT1) select, &sense, &n,
+        (lapack_complex_double*) A, &lda, sdim,
+        (lapack_complex_double*) W,
+        (lapack_complex_double*) VS, &ldvs, rconde, rcondv,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by geesx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvs_ = job2char( jobvs );
+    char sort_ = sort2char( sort );
+    char sense_ = sense2char( sense );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int sdim_ = 0;
+    lapack_int ldvs_ = (lapack_int) ldvs;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    real_t rconde_, rcondv_;
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1] = { 0 };
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_geesx(
+        jobvs_, sort_,
+        select, sense_, n_,
+        A, lda_, &sdim_,
+        W, qry_WR, qry_WI,
+        VS, ldvs_,
+        &rconde_, &rcondv_,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, ineg_one,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int liwork_ = is_complex ? 0 : qry_iwork[0];
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WR
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WI
+    buffer.take< real_t >( is_complex ? n : 0 );  // rwork
+    buffer.take< lapack_int >( n );  // bwork
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::geesx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::geesx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     geesx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    typename internal::gees_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    blas::real_type<scalar_t>* rconde,
+    blas::real_type<scalar_t>* rcondv,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvs) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "geesx", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvs_ = job2char( jobvs );
+    char sort_ = sort2char( sort );
+    char sense_ = sense2char( sense );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int sdim_ = (lapack_int) *sdim;
+    lapack_int ldvs_ = (lapack_int) ldvs;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* WR = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* WI = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? n : 0 );
+    lapack_int* bwork_ = buffer.take< lapack_int >( n );
+
+    // query for size of iwork
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1] = { 0 };
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_geesx(
+        jobvs_, sort_,
+        select, sense_, n_,
+        A, lda_, &sdim_,
+        W, qry_WR, qry_WI,
+        VS, ldvs_,
+        rconde, rcondv,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, ineg_one,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int liwork_ = is_complex ? 0 : qry_iwork[0];
+
+    // work gets the rest
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_geesx(
+        jobvs_, sort_,
+        select, sense_, n_,
+        A, lda_, &sdim_,
+        W, WR, WI,
+        VS, ldvs_,
+        rconde, rcondv,
+        work_, lwork_,
+        rwork_,
+        iwork_, liwork_,
+        bwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *sdim = sdim_;
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            W[i] = complex_t( WR[i], WI[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_s_select2 select,
+    lapack::Sense sense, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_d_select2 select,
+    lapack::Sense sense, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_c_select1 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VS, int64_t ldvs,
+    size_t* work_size );
+
+template
+void geesx_work_size_bytes(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_z_select1 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VS, int64_t ldvs,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_s_select2 select,
+    lapack::Sense sense, int64_t n,
+    float* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<float>* W,
+    float* VS, int64_t ldvs,
+    float* rconde,
+    float* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_d_select2 select,
+    lapack::Sense sense, int64_t n,
+    double* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<double>* W,
+    double* VS, int64_t ldvs,
+    double* rconde,
+    double* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_c_select1 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<float>* W,
+    std::complex<float>* VS, int64_t ldvs,
+    float* rconde,
+    float* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t geesx(
+    lapack::Job jobvs, lapack::Sort sort,
+    lapack_z_select1 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* sdim,
+    std::complex<double>* W,
+    std::complex<double>* VS, int64_t ldvs,
+    double* rconde,
+    double* rcondv,
+    void* work, size_t work_size );
+
 }  // namespace lapack
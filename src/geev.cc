@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +33,11 @@ int64_t geev(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geev", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -40,8 +47,8 @@ int64_t geev(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
+    lapack::small_vector< float > WR( max( 1, n ) );
+    lapack::small_vector< float > WI( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -63,7 +70,7 @@ int64_t geev(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgeev(
         &jobvl_, &jobvr_, &n_,
@@ -102,6 +109,11 @@ int64_t geev(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geev", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -111,8 +123,8 @@ int64_t geev(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
+    lapack::small_vector< double > WR( max( 1, n ) );
+    lapack::small_vector< double > WI( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -134,7 +146,7 @@ int64_t geev(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgeev(
         &jobvl_, &jobvr_, &n_,
@@ -173,6 +185,11 @@ int64_t geev(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geev", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -203,8 +220,8 @@ int64_t geev(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgeev(
         &jobvl_, &jobvr_, &n_,
@@ -340,6 +357,11 @@ int64_t geev(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geev", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -370,8 +392,8 @@ int64_t geev(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgeev(
         &jobvl_, &jobvr_, &n_,
@@ -391,4 +413,311 @@ int64_t geev(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (WR, WI) and
+// don't reference W or rwork; complex precisions return W directly
+// and don't reference WR or WI.
+static void fortran_geev(
+    char jobvl, char jobvr, lapack_int n,
+    float* A, lapack_int lda,
+    std::complex<float>* W, float* WR, float* WI,
+    float* VL, lapack_int ldvl,
+    float* VR, lapack_int ldvr,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgeev(
+        &jobvl, &jobvr, &n,
+        A, &lda,
+        WR, WI,
+        VL, &ldvl,
+        VR, &ldvr,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geev(
+    char jobvl, char jobvr, lapack_int n,
+    double* A, lapack_int lda,
+    std::complex<double>* W, double* WR, double* WI,
+    double* VL, lapack_int ldvl,
+    double* VR, lapack_int ldvr,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgeev(
+        &jobvl, &jobvr, &n,
+        A, &lda,
+        WR, WI,
+        VL, &ldvl,
+        VR, &ldvr,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geev(
+    char jobvl, char jobvr, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* W, float* WR, float* WI,
+    std::complex<float>* VL, lapack_int ldvl,
+    std::complex<float>* VR, lapack_int ldvr,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgeev(
+        &jobvl, &jobvr, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) VL, &ldvl,
+        (lapack_complex_float*) VR, &ldvr,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_geev(
+    char jobvl, char jobvr, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* W, double* WR, double* WI,
+    std::complex<double>* VL, lapack_int ldvl,
+    std::complex<double>* VR, lapack_int ldvr,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgeev(
+        &jobvl, &jobvr, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) W,
+        (lapack_complex_double*) VL, &ldvl,
+        (lapack_complex_double*) VR, &ldvr,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by geev with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int ineg_one = -1;
+    fortran_geev(
+        jobvl_, jobvr_, n_,
+        A, lda_,
+        W, qry_WR, qry_WI,
+        VL, ldvl_,
+        VR, ldvr_,
+        qry_work, ineg_one,
+        qry_rwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WR
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WI
+    buffer.take< real_t >( is_complex ? max( 1, 2*n ) : 0 );  // rwork
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::geev, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::geev for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     geev_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "geev", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* WR = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* WI = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? max( 1, 2*n ) : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_geev(
+        jobvl_, jobvr_, n_,
+        A, lda_,
+        W, WR, WI,
+        VL, ldvl_,
+        VR, ldvr_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            W[i] = blas::complex_type<scalar_t>( WR[i], WI[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -0,0 +1,346 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+// Checks job and leading dimension of one geev eigenvector matrix,
+// as LAPACK does.
+static void geev_check_vec( lapack::Job job, int64_t n, int64_t ldv )
+{
+    lapack_error_if( job != Job::NoVec && job != Job::Vec );
+    if (job == Job::Vec)
+        lapack_error_if( ldv < max( 1, n ) );
+    else
+        lapack_error_if( ldv < 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the eigenvalues and, optionally, the left and/or right
+/// eigenvectors of a batch of nonsymmetric matrices, pointer-array variant.
+/// See lapack::geev.
+///
+/// Workspace is queried once for each distinct (jobvl_i, jobvr_i, n_i),
+/// so once if all problems have the same arguments, and each worker
+/// thread reuses one buffer of the largest size for all its problems.
+///
+/// @param[in] jobvl
+///     Whether to compute left eigenvectors; 1 or batch entries.
+///     - lapack::Job::NoVec: not computed; VLarray entries can be null.
+///     - lapack::Job::Vec:   computed.
+///
+/// @param[in] jobvr
+///     Whether to compute right eigenvectors; 1 or batch entries.
+///     - lapack::Job::NoVec: not computed; VRarray entries can be null.
+///     - lapack::Job::Vec:   computed.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, overwritten.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[out] Warray
+///     Pointers to the batch vectors of eigenvalues of $A_i$, of length n_i.
+///     As in lapack::geev, W is complex even for real $A_i$.
+///
+/// @param[out] VLarray
+///     Pointers to the batch matrices of left eigenvectors, each stored
+///     in an ldvl_i-by-n_i array, as in lapack::geev.
+///
+/// @param[in] ldvl
+///     Leading dimension of each $VL_i$; ldvl_i >= max(1, n_i) if
+///     jobvl_i = Vec, else ldvl_i >= 1. 1 or batch entries.
+///
+/// @param[out] VRarray
+///     Pointers to the batch matrices of right eigenvectors, each stored
+///     in an ldvr_i-by-n_i array, as in lapack::geev.
+///
+/// @param[in] ldvr
+///     Leading dimension of each $VR_i$; ldvr_i >= max(1, n_i) if
+///     jobvr_i = Vec, else ldvr_i >= 1. 1 or batch entries.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::geev for $A_i$: 0 for success, or k > 0 if the
+///     QR algorithm failed to compute all the eigenvalues.
+///
+/// @ingroup geev
+template <typename scalar_t>
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::complex_type<scalar_t>* > const& Warray,
+    std::vector<scalar_t*> const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector<scalar_t*> const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( jobvl, batch );
+    internal::batch::check_arg_size( jobvr, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( ldvl, batch );
+    internal::batch::check_arg_size( ldvr, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Warray, batch );
+    internal::batch::check_array_size( VLarray, batch );
+    internal::batch::check_array_size( VRarray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+        geev_check_vec( extract( jobvl, i ), n_i, extract( ldvl, i ) );
+        geev_check_vec( extract( jobvr, i ), n_i, extract( ldvr, i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "geev_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), -1,
+        []() { return 0.0; } );
+
+    // query workspace, skipping problems with the same arguments
+    // as the previous one; the size depends only on these.
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( jobvl, i ) != extract( jobvl, i-1 )
+            || extract( jobvr, i ) != extract( jobvr, i-1 )
+            || extract( n, i )     != extract( n, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::geev_work_size_bytes(
+                extract( jobvl, i ), extract( jobvr, i ), extract( n, i ),
+                Aarray[ i ], extract( lda, i ), Warray[ i ],
+                VLarray[ i ], extract( ldvl, i ),
+                VRarray[ i ], extract( ldvr, i ),
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::geev(
+            extract( jobvl, i ), extract( jobvr, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ), Warray[ i ],
+            VLarray[ i ], extract( ldvl, i ),
+            VRarray[ i ], extract( ldvr, i ),
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes the eigenvalues and, optionally, the left and/or right
+/// eigenvectors of a batch of nonsymmetric matrices, strided variant.
+/// See lapack::geev.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] jobvl
+///     Whether to compute left eigenvectors.
+///     - lapack::Job::NoVec: not computed; VL can be null.
+///     - lapack::Job::Vec:   computed.
+///
+/// @param[in] jobvr
+///     Whether to compute right eigenvectors.
+///     - lapack::Job::NoVec: not computed; VR can be null.
+///     - lapack::Job::Vec:   computed.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, overwritten.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices $A_i$; strideA >= lda*n.
+///
+/// @param[out] W
+///     The batch vectors of eigenvalues, with those of $A_i$
+///     starting at W + i*strideW.
+///
+/// @param[in] strideW
+///     Distance between vectors; strideW >= n.
+///
+/// @param[out] VL
+///     If jobvl = Vec, the batch left eigenvector matrices, with $VL_i$
+///     stored in an ldvl-by-n array starting at VL + i*strideVL.
+///
+/// @param[in] ldvl
+///     Leading dimension of each $VL_i$; ldvl >= max(1, n) if jobvl = Vec,
+///     else ldvl >= 1.
+///
+/// @param[in] strideVL
+///     Distance between matrices $VL_i$; strideVL >= ldvl*n if jobvl = Vec.
+///
+/// @param[out] VR
+///     If jobvr = Vec, the batch right eigenvector matrices, with $VR_i$
+///     stored in an ldvr-by-n array starting at VR + i*strideVR.
+///
+/// @param[in] ldvr
+///     Leading dimension of each $VR_i$; ldvr >= max(1, n) if jobvr = Vec,
+///     else ldvr >= 1.
+///
+/// @param[in] strideVR
+///     Distance between matrices $VR_i$; strideVR >= ldvr*n if jobvr = Vec.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup geev
+template <typename scalar_t>
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::complex_type<scalar_t>* W, int64_t strideW,
+    scalar_t* VL, int64_t ldvl, int64_t strideVL,
+    scalar_t* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info )
+{
+    bool wantvl = (jobvl == Job::Vec);
+    bool wantvr = (jobvr == Job::Vec);
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    geev_check_vec( jobvl, n, ldvl );
+    geev_check_vec( jobvr, n, ldvr );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideW < n );
+    lapack_error_if( wantvl && strideVL < ldvl*n );
+    lapack_error_if( wantvr && strideVR < ldvr*n );
+
+    trace::internal::Block trace_block(
+        "geev_batch", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    size_t work_size;
+    lapack::geev_work_size_bytes( jobvl, jobvr, n, A, lda, W,
+                                  VL, ldvl, VR, ldvr, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    // if not computed, VL or VR may be null; don't offset a null pointer
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::geev(
+            jobvl, jobvr, n, &A[ i*strideA ], lda, &W[ i*strideW ],
+            wantvl ? &VL[ i*strideVL ] : VL, ldvl,
+            wantvr ? &VR[ i*strideVR ] : VR, ldvr,
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Warray,
+    std::vector<float*> const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector<float*> const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Warray,
+    std::vector<double*> const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector<double*> const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Warray,
+    std::vector< std::complex<float>* > const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector< std::complex<float>* > const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    std::vector<lapack::Job> const& jobvl,
+    std::vector<lapack::Job> const& jobvr,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Warray,
+    std::vector< std::complex<double>* > const& VLarray, std::vector<int64_t> const& ldvl,
+    std::vector< std::complex<double>* > const& VRarray, std::vector<int64_t> const& ldvr,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    std::complex<float>* W, int64_t strideW,
+    float* VL, int64_t ldvl, int64_t strideVL,
+    float* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    std::complex<double>* W, int64_t strideW,
+    double* VL, int64_t ldvl, int64_t strideVL,
+    double* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    std::complex<float>* W, int64_t strideW,
+    std::complex<float>* VL, int64_t ldvl, int64_t strideVL,
+    std::complex<float>* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geev_batch(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    std::complex<double>* W, int64_t strideW,
+    std::complex<double>* VL, int64_t ldvl, int64_t strideVL,
+    std::complex<double>* VR, int64_t ldvr, int64_t strideVR,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +31,11 @@ int64_t gehrd(
         lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gehrd", 's', -1, n, -1,
+        [&]() { return Gflop< float >::gehrd( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int ilo_ = (lapack_int) ilo;
     lapack_int ihi_ = (lapack_int) ihi;
@@ -49,7 +56,7 @@ int64_t gehrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgehrd(
         &n_, &ilo_, &ihi_,
@@ -76,6 +83,11 @@ int64_t gehrd(
         lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gehrd", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::gehrd( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int ilo_ = (lapack_int) ilo;
     lapack_int ihi_ = (lapack_int) ihi;
@@ -96,7 +108,7 @@ int64_t gehrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgehrd(
         &n_, &ilo_, &ihi_,
@@ -123,6 +135,11 @@ int64_t gehrd(
         lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gehrd", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::gehrd( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int ilo_ = (lapack_int) ilo;
     lapack_int ihi_ = (lapack_int) ihi;
@@ -143,7 +160,7 @@ int64_t gehrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgehrd(
         &n_, &ilo_, &ihi_,
@@ -247,6 +264,11 @@ int64_t gehrd(
         lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gehrd", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::gehrd( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int ilo_ = (lapack_int) ilo;
     lapack_int ihi_ = (lapack_int) ihi;
@@ -267,7 +289,7 @@ int64_t gehrd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgehrd(
         &n_, &ilo_, &ihi_,
@@ -280,4 +302,220 @@ int64_t gehrd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gehrd(
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    float* A, lapack_int lda,
+    float* tau,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgehrd(
+        &n, &ilo, &ihi,
+        A, &lda,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gehrd(
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    double* A, lapack_int lda,
+    double* tau,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgehrd(
+        &n, &ilo, &ihi,
+        A, &lda,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gehrd(
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgehrd(
+        &n, &ilo, &ihi,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_gehrd(
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgehrd(
+        &n, &ilo, &ihi,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gehrd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gehrd(
+        n_, ilo_, ihi_,
+        A, lda_,
+        tau,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gehrd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gehrd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gehrd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gehrd", trace::internal::precision< scalar_t >(), -1, n, -1,
+        [&]() { return Gflop< scalar_t >::gehrd( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gehrd(
+        n_, ilo_, ihi_,
+        A, lda_,
+        tau,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* work_size );
+
+template
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* work_size );
+
+template
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* work_size );
+
+template
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* work, size_t work_size );
+
 }  // namespace lapack
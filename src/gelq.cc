@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -30,6 +31,11 @@ int64_t gelq(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelq", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -50,7 +56,7 @@ int64_t gelq(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgelq(
         &m_, &n_,
@@ -76,6 +82,11 @@ int64_t gelq(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelq", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -96,7 +107,7 @@ int64_t gelq(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgelq(
         &m_, &n_,
@@ -122,6 +133,11 @@ int64_t gelq(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelq", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -142,7 +158,7 @@ int64_t gelq(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgelq(
         &m_, &n_,
@@ -168,6 +184,11 @@ int64_t gelq(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelq", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -188,7 +209,7 @@ int64_t gelq(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgelq(
         &m_, &n_,
@@ -201,6 +222,222 @@ int64_t gelq(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gelq(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* T, lapack_int tsize,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgelq(
+        &m, &n,
+        A, &lda,
+        T, &tsize,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelq(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* T, lapack_int tsize,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgelq(
+        &m, &n,
+        A, &lda,
+        T, &tsize,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelq(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* T, lapack_int tsize,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgelq(
+        &m, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) T, &tsize,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_gelq(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* T, lapack_int tsize,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgelq(
+        &m, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) T, &tsize,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gelq with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int tsize_ = (lapack_int) tsize;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gelq(
+        m_, n_,
+        A, lda_,
+        T, tsize_,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gelq, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gelq for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gelq_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gelq(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gelq", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int tsize_ = (lapack_int) tsize;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gelq(
+        m_, n_,
+        A, lda_,
+        T, tsize_,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* T, int64_t tsize,
+    size_t* work_size );
+
+template
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* T, int64_t tsize,
+    size_t* work_size );
+
+template
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t tsize,
+    size_t* work_size );
+
+template
+void gelq_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t tsize,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gelq(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* T, int64_t tsize,
+    void* work, size_t work_size );
+
+template
+int64_t gelq(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* T, int64_t tsize,
+    void* work, size_t work_size );
+
+template
+int64_t gelq(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t tsize,
+    void* work, size_t work_size );
+
+template
+int64_t gelq(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t tsize,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,6 +30,11 @@ int64_t gelqf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelqf", 's', m, n, -1,
+        [&]() { return Gflop< float >::gelqf( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -47,7 +54,7 @@ int64_t gelqf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgelqf(
         &m_, &n_,
@@ -73,6 +80,11 @@ int64_t gelqf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelqf", 'd', m, n, -1,
+        [&]() { return Gflop< double >::gelqf( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -92,7 +104,7 @@ int64_t gelqf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgelqf(
         &m_, &n_,
@@ -118,6 +130,11 @@ int64_t gelqf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelqf", 'c', m, n, -1,
+        [&]() { return Gflop< std::complex<float> >::gelqf( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -137,7 +154,7 @@ int64_t gelqf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgelqf(
         &m_, &n_,
@@ -212,6 +229,11 @@ int64_t gelqf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelqf", 'z', m, n, -1,
+        [&]() { return Gflop< std::complex<double> >::gelqf( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -231,7 +253,7 @@ int64_t gelqf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgelqf(
         &m_, &n_,
@@ -244,4 +266,216 @@ int64_t gelqf(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gelqf(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* tau,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgelqf(
+        &m, &n,
+        A, &lda,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelqf(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* tau,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgelqf(
+        &m, &n,
+        A, &lda,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelqf(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgelqf(
+        &m, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_gelqf(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgelqf(
+        &m, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gelqf with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gelqf(
+        m_, n_,
+        A, lda_,
+        tau,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gelqf, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gelqf for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gelqf_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gelqf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gelqf", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return Gflop< scalar_t >::gelqf( m, n ); } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gelqf(
+        m_, n_,
+        A, lda_,
+        tau,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* work_size );
+
+template
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* work_size );
+
+template
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* work_size );
+
+template
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* work, size_t work_size );
+
+template
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* work, size_t work_size );
+
 }  // namespace lapack
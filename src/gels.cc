@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -34,6 +36,11 @@ int64_t gels(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gels", 's', m, n, nrhs,
+        [&]() { return Gflop< float >::gels( m, n, nrhs ); } );
+
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -60,7 +67,7 @@ int64_t gels(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgels(
         &trans_, &m_, &n_, &nrhs_,
@@ -96,6 +103,11 @@ int64_t gels(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gels", 'd', m, n, nrhs,
+        [&]() { return Gflop< double >::gels( m, n, nrhs ); } );
+
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -122,7 +134,7 @@ int64_t gels(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgels(
         &trans_, &m_, &n_, &nrhs_,
@@ -154,6 +166,11 @@ int64_t gels(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gels", 'c', m, n, nrhs,
+        [&]() { return Gflop< std::complex<float> >::gels( m, n, nrhs ); } );
+
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -180,7 +197,7 @@ int64_t gels(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgels(
         &trans_, &m_, &n_, &nrhs_,
@@ -302,6 +319,11 @@ int64_t gels(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gels", 'z', m, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::gels( m, n, nrhs ); } );
+
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -328,7 +350,7 @@ int64_t gels(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgels(
         &trans_, &m_, &n_, &nrhs_,
@@ -345,4 +367,250 @@ int64_t gels(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gels(
+    char trans, lapack_int m, lapack_int n, lapack_int nrhs,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgels(
+        &trans, &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gels(
+    char trans, lapack_int m, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgels(
+        &trans, &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gels(
+    char trans, lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgels(
+        &trans, &m, &n, &nrhs,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gels(
+    char trans, lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgels(
+        &trans, &m, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gels with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size )
+{
+    // for real, map ConjTrans to Trans
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gels(
+        trans_, m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gels, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gels for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gels_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    // for real, map ConjTrans to Trans
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gels", trace::internal::precision< scalar_t >(), m, n, nrhs,
+        [&]() { return Gflop< scalar_t >::gels( m, n, nrhs ); } );
+
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gels(
+        trans_, m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    void* work, size_t work_size );
+
 }  // namespace lapack
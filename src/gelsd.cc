@@ -6,7 +6,9 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
+#include <cmath>
 #include <vector>
 
 namespace lapack {
@@ -32,6 +34,11 @@ int64_t gelsd(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsd", 's', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -58,8 +65,8 @@ int64_t gelsd(
     lapack_int liwork_ = qry_iwork[0];
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_sgelsd(
         &m_, &n_, &nrhs_,
@@ -92,6 +99,11 @@ int64_t gelsd(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsd", 'd', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -118,8 +130,8 @@ int64_t gelsd(
     lapack_int liwork_ = qry_iwork[0];
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_dgelsd(
         &m_, &n_, &nrhs_,
@@ -152,6 +164,11 @@ int64_t gelsd(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsd", 'c', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -181,9 +198,9 @@ int64_t gelsd(
     lapack_int liwork_ = qry_iwork[0];
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_cgelsd(
         &m_, &n_, &nrhs_,
@@ -298,6 +315,11 @@ int64_t gelsd(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsd", 'z', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -327,9 +349,9 @@ int64_t gelsd(
     lapack_int liwork_ = qry_iwork[0];
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zgelsd(
         &m_, &n_, &nrhs_,
@@ -346,4 +368,313 @@ int64_t gelsd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// rwork is not referenced in real precisions.
+static void fortran_gelsd(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* S, float rcond, lapack_int* rank,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sgelsd(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        S, &rcond, rank,
+        work, &lwork,
+        iwork, info );
+}
+
+//----------
+static void fortran_gelsd(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* S, double rcond, lapack_int* rank,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dgelsd(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        S, &rcond, rank,
+        work, &lwork,
+        iwork, info );
+}
+
+//----------
+static void fortran_gelsd(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    float* S, float rcond, lapack_int* rank,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_cgelsd(
+        &m, &n, &nrhs,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        S, &rcond, rank,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork, info );
+}
+
+//----------
+static void fortran_gelsd(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    double* S, double rcond, lapack_int* rank,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_zgelsd(
+        &m, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        S, &rcond, rank,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork, info );
+}
+
+//------------------------------------------------------------------------------
+// Queries sizes of work, rwork (complex only), and iwork for gelsd.
+// Some LAPACK versions don't return lrwork and liwork from the query,
+// so each is the max of the query and the minimum documented in
+// [sdcz]gelsd, taking SMLSIZ = 25, which ILAENV returns for gelsd.
+template <typename scalar_t>
+static void gelsd_query(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    scalar_t* A, lapack_int lda,
+    scalar_t* B, lapack_int ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    scalar_t qry_work[1] = { 0 };
+    real_t qry_rwork[1] = { 0 };
+    lapack_int qry_iwork[1] = { 0 };
+    lapack_int rank = 0;
+    lapack_int info = 0;
+    lapack_int ineg_one = -1;
+    fortran_gelsd(
+        m, n, nrhs,
+        A, lda,
+        B, ldb,
+        S, rcond, &rank,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, &info );
+    if (info < 0) {
+        throw Error();
+    }
+
+    const int64_t smlsiz = 25;
+    int64_t mn = min( m, n );
+    int64_t nlvl = 0;
+    if (mn > 0) {
+        // truncates toward zero, as Fortran INT does
+        nlvl = max( 0, int64_t( std::log2( double( mn ) / (smlsiz + 1) ) ) + 1 );
+    }
+    int64_t min_liwork = max( 1, 3*mn*nlvl + 11*mn );
+    int64_t min_lrwork = max( 1, 10*mn + 2*mn*smlsiz + 8*mn*nlvl + 3*smlsiz*nrhs
+                                 + max( (smlsiz + 1)*(smlsiz + 1),
+                                        mn*(1 + nrhs) + 2*nrhs ) );
+
+    *lwork  = int64_t( real( qry_work[0] ) );
+    *lrwork = max( int64_t( qry_rwork[0] ), min_lrwork );
+    *liwork = max( int64_t( qry_iwork[0] ), min_liwork );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gelsd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    int64_t lwork, lrwork, liwork;
+    gelsd_query( (lapack_int) m, (lapack_int) n, (lapack_int) nrhs,
+                 A, (lapack_int) lda, B, (lapack_int) ldb, S, rcond,
+                 &lwork, &lrwork, &liwork );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? lrwork : 0 );
+    buffer.take< lapack_int >( liwork );
+    buffer.take< scalar_t >( lwork );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Solves least squares as lapack::gelsd does, but with caller-provided
+/// workspace instead of allocating it.
+/// See lapack::gelsd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gelsd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gelsd", trace::internal::precision< scalar_t >(), m, n, nrhs,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = 0;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    int64_t lwork, lrwork, liwork;
+    gelsd_query( m_, n_, nrhs_, A, lda_, B, ldb_, S, rcond,
+                 &lwork, &lrwork, &liwork );
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? lrwork : 0 );
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gelsd(
+        m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        S, rcond, &rank_,
+        work_, lwork_,
+        rwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    size_t* work_size );
+
+template
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    size_t* work_size );
+
+template
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    size_t* work_size );
+
+template
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
 }  // namespace lapack
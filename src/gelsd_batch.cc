@@ -0,0 +1,337 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Computes minimum norm solutions of a batch of linear least squares
+/// problems, minimizing $|| B_i - A_i X_i ||_2$, using the SVD of $A_i$,
+/// pointer-array variant. See lapack::gelsd.
+///
+/// Workspace is queried once for each distinct set of dimensions, so once
+/// if all problems have the same dimensions, and each worker thread reuses
+/// one buffer of the largest size for all its problems.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$; 1 or batch entries.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$; 1 or batch entries.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, m_i).
+///     1 or batch entries.
+///
+/// @param[in,out] Barray
+///     Pointers to the batch right-hand sides $B_i$, each stored in an
+///     ldb_i-by-nrhs_i array. On exit, the solutions $X_i$,
+///     as in lapack::gelsd.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb_i >= max(1, m_i, n_i).
+///     1 or batch entries.
+///
+/// @param[out] Sarray
+///     Pointers to the batch vectors of singular values of $A_i$,
+///     of length min(m_i, n_i).
+///
+/// @param[in] rcond
+///     Singular values $s_j \le rcond \cdot s_1$ are treated as zero;
+///     1 or batch entries. If rcond < 0, machine precision is used.
+///
+/// @param[out] rank
+///     Resized to batch entries. rank[ i ] is the effective rank of $A_i$.
+///
+/// @param[in] batch
+///     Number of problems.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::gelsd for problem i: 0 for success, or k > 0 if the SVD
+///     failed to converge.
+///
+/// @ingroup gels
+template <typename scalar_t>
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< blas::real_type<scalar_t>* > const& Sarray,
+    std::vector< blas::real_type<scalar_t> > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( m, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( nrhs, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( ldb, batch );
+    internal::batch::check_arg_size( rcond, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Barray, batch );
+    internal::batch::check_array_size( Sarray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t m_i = extract( m, i );
+        int64_t n_i = extract( n, i );
+        lapack_error_if( m_i < 0 );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( nrhs, i ) < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, m_i ) );
+        lapack_error_if( extract( ldb, i ) < max( 1, m_i, n_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "gelsd_batch", trace::internal::precision< scalar_t >(),
+        internal::batch::trace_dim( m ),
+        internal::batch::trace_dim( n ),
+        internal::batch::trace_dim( nrhs ),
+        []() { return 0.0; } );
+
+    // query workspace, skipping problems with the same dimensions
+    // as the previous one
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( m, i )    != extract( m, i-1 )
+            || extract( n, i )    != extract( n, i-1 )
+            || extract( nrhs, i ) != extract( nrhs, i-1 )
+            || extract( lda, i )  != extract( lda, i-1 )
+            || extract( ldb, i )  != extract( ldb, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::gelsd_work_size_bytes(
+                extract( m, i ), extract( n, i ), extract( nrhs, i ),
+                Aarray[ i ], extract( lda, i ),
+                Barray[ i ], extract( ldb, i ),
+                Sarray[ i ], extract( rcond, i ),
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    rank.resize( batch );
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::gelsd(
+            extract( m, i ), extract( n, i ), extract( nrhs, i ),
+            Aarray[ i ], extract( lda, i ),
+            Barray[ i ], extract( ldb, i ),
+            Sarray[ i ], extract( rcond, i ), &rank[ i ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes minimum norm solutions of a batch of linear least squares
+/// problems, minimizing $|| B_i - A_i X_i ||_2$, using the SVD of $A_i$,
+/// strided variant. See lapack::gelsd.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, m).
+///
+/// @param[in] strideA
+///     Distance between matrices $A_i$; strideA >= lda*n.
+///
+/// @param[in,out] B
+///     The batch right-hand sides, with $B_i$ stored in an ldb-by-nrhs
+///     array starting at B + i*strideB. On exit, the solutions $X_i$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb >= max(1, m, n).
+///
+/// @param[in] strideB
+///     Distance between matrices $B_i$; strideB >= ldb*nrhs.
+///
+/// @param[out] S
+///     The batch vectors of singular values, with those of $A_i$
+///     starting at S + i*strideS.
+///
+/// @param[in] strideS
+///     Distance between vectors; strideS >= min(m, n).
+///
+/// @param[in] rcond
+///     Singular values $s_j \le rcond \cdot s_1$ are treated as zero.
+///     If rcond < 0, machine precision is used.
+///
+/// @param[out] rank
+///     Resized to batch entries. rank[ i ] is the effective rank of $A_i$.
+///
+/// @param[in] batch
+///     Number of problems.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup gels
+template <typename scalar_t>
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    blas::real_type<scalar_t>* S, int64_t strideS,
+    blas::real_type<scalar_t> rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldb < max( 1, m, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideB < ldb*nrhs );
+    lapack_error_if( strideS < min( m, n ) );
+
+    trace::internal::Block trace_block(
+        "gelsd_batch", trace::internal::precision< scalar_t >(), m, n, nrhs,
+        []() { return 0.0; } );
+
+    size_t work_size;
+    lapack::gelsd_work_size_bytes(
+        m, n, nrhs, A, lda, B, ldb, S, rcond, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    rank.resize( batch );
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::gelsd(
+            m, n, nrhs,
+            &A[ i*strideA ], lda,
+            &B[ i*strideB ], ldb,
+            &S[ i*strideS ], rcond, &rank[ i ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< float* > const& Sarray,
+    std::vector< float > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< double* > const& Sarray,
+    std::vector< double > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< float* > const& Sarray,
+    std::vector< float > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< double* > const& Sarray,
+    std::vector< double > const& rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda, int64_t strideA,
+    float* B, int64_t ldb, int64_t strideB,
+    float* S, int64_t strideS,
+    float rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda, int64_t strideA,
+    double* B, int64_t ldb, int64_t strideB,
+    double* S, int64_t strideS,
+    double rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    std::complex<float>* B, int64_t ldb, int64_t strideB,
+    float* S, int64_t strideS,
+    float rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gelsd_batch(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    std::complex<double>* B, int64_t ldb, int64_t strideB,
+    double* S, int64_t strideS,
+    double rcond,
+    std::vector<int64_t>& rank,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +33,11 @@ int64_t gelss(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelss", 's', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -55,7 +61,7 @@ int64_t gelss(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgelss(
         &m_, &n_, &nrhs_,
@@ -87,6 +93,11 @@ int64_t gelss(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelss", 'd', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -110,7 +121,7 @@ int64_t gelss(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgelss(
         &m_, &n_, &nrhs_,
@@ -142,6 +153,11 @@ int64_t gelss(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelss", 'c', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -167,8 +183,8 @@ int64_t gelss(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (5*min(m,n)) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (5*min(m,n)) );
 
     LAPACK_cgelss(
         &m_, &n_, &nrhs_,
@@ -268,6 +284,11 @@ int64_t gelss(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelss", 'z', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -293,8 +314,8 @@ int64_t gelss(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (5*min(m,n)) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (5*min(m,n)) );
 
     LAPACK_zgelss(
         &m_, &n_, &nrhs_,
@@ -310,4 +331,269 @@ int64_t gelss(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// For real precisions, rwork is not referenced.
+static void fortran_gelss(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* S, float rcond, lapack_int* rank,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgelss(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        S, &rcond, rank,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelss(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* S, double rcond, lapack_int* rank,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgelss(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        S, &rcond, rank,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelss(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    float* S, float rcond, lapack_int* rank,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgelss(
+        &m, &n, &nrhs,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        S, &rcond, rank,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info );
+}
+
+//----------
+static void fortran_gelss(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    double* S, double rcond, lapack_int* rank,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgelss(
+        &m, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        S, &rcond, rank,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gelss with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = 0;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int ineg_one = -1;
+    fortran_gelss(
+        m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        S, rcond, &rank_,
+        qry_work, ineg_one,
+        qry_rwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 5*min( m, n ) : 0 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Solves least squares as lapack::gelss does, but with caller-provided
+/// workspace instead of allocating it.
+/// See lapack::gelss for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gelss_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* S, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gelss", trace::internal::precision< scalar_t >(), m, n, nrhs,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = 0;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >(
+        blas::is_complex<scalar_t>::value ? 5*min( m, n ) : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gelss(
+        m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        S, rcond, &rank_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    size_t* work_size );
+
+template
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    size_t* work_size );
+
+template
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    size_t* work_size );
+
+template
+void gelss_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelss(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +33,11 @@ int64_t gelsy(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsy", 's', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -39,7 +45,7 @@ int64_t gelsy(
     lapack_int ldb_ = (lapack_int) ldb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -62,7 +68,7 @@ int64_t gelsy(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgelsy(
         &m_, &n_, &nrhs_,
@@ -97,6 +103,11 @@ int64_t gelsy(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsy", 'd', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -104,7 +115,7 @@ int64_t gelsy(
     lapack_int ldb_ = (lapack_int) ldb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -127,7 +138,7 @@ int64_t gelsy(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgelsy(
         &m_, &n_, &nrhs_,
@@ -162,6 +173,11 @@ int64_t gelsy(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsy", 'c', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -169,7 +185,7 @@ int64_t gelsy(
     lapack_int ldb_ = (lapack_int) ldb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -194,8 +210,8 @@ int64_t gelsy(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgelsy(
         &m_, &n_, &nrhs_,
@@ -330,6 +346,11 @@ int64_t gelsy(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gelsy", 'z', m, n, nrhs,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -337,7 +358,7 @@ int64_t gelsy(
     lapack_int ldb_ = (lapack_int) ldb;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -362,8 +383,8 @@ int64_t gelsy(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgelsy(
         &m_, &n_, &nrhs_,
@@ -382,4 +403,274 @@ int64_t gelsy(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gelsy(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    lapack_int* jpvt, float rcond, lapack_int* rank,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgelsy(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        jpvt, &rcond, rank,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelsy(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    lapack_int* jpvt, double rcond, lapack_int* rank,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgelsy(
+        &m, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        jpvt, &rcond, rank,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gelsy(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    lapack_int* jpvt, float rcond, lapack_int* rank,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgelsy(
+        &m, &n, &nrhs,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        jpvt, &rcond, rank,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info );
+}
+
+//----------
+static void fortran_gelsy(
+    lapack_int m, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    lapack_int* jpvt, double rcond, lapack_int* rank,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgelsy(
+        &m, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        jpvt, &rcond, rank,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gelsy with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> rcond,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = 0;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gelsy(
+        m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        nullptr, rcond, &rank_,
+        qry_work, ineg_one,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gelsy, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gelsy for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gelsy_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* jpvt, blas::real_type<scalar_t> rcond,
+    int64_t* rank,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gelsy", trace::internal::precision< scalar_t >(), m, n, nrhs,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* jpvt_ = buffer.take< lapack_int >( n );
+        std::copy( jpvt, jpvt + n, jpvt_ );
+        lapack_int* jpvt_ptr = jpvt_;
+    #else
+        lapack_int* jpvt_ptr = jpvt;
+    #endif
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gelsy(
+        m_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        jpvt_ptr, rcond, &rank_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    #ifndef LAPACK_ILP64
+        std::copy( jpvt_, jpvt_ + n, jpvt );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float rcond,
+    size_t* work_size );
+
+template
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double rcond,
+    size_t* work_size );
+
+template
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb, float rcond,
+    size_t* work_size );
+
+template
+void gelsy_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb, double rcond,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    int64_t* jpvt, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    int64_t* jpvt, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    int64_t* jpvt, float rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
+template
+int64_t gelsy(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    int64_t* jpvt, double rcond,
+    int64_t* rank,
+    void* work, size_t work_size );
+
 }  // namespace lapack
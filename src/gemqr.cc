@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -33,6 +34,11 @@ int64_t gemqr(
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gemqr", 's', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -62,7 +68,7 @@ int64_t gemqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgemqr(
         &side_, &trans_, &m_, &n_, &k_,
@@ -96,6 +102,11 @@ int64_t gemqr(
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gemqr", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -125,7 +136,7 @@ int64_t gemqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgemqr(
         &side_, &trans_, &m_, &n_, &k_,
@@ -159,6 +170,11 @@ int64_t gemqr(
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gemqr", 'c', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -188,7 +204,7 @@ int64_t gemqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgemqr(
         &side_, &trans_, &m_, &n_, &k_,
@@ -222,6 +238,11 @@ int64_t gemqr(
         lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gemqr", 'z', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -251,7 +272,7 @@ int64_t gemqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgemqr(
         &side_, &trans_, &m_, &n_, &k_,
@@ -269,6 +290,270 @@ int64_t gemqr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gemqr(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    float const* A, lapack_int lda,
+    float const* T, lapack_int tsize,
+    float* C, lapack_int ldc,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgemqr(
+        &side, &trans, &m, &n, &k,
+        A, &lda,
+        T, &tsize,
+        C, &ldc,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gemqr(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    double const* A, lapack_int lda,
+    double const* T, lapack_int tsize,
+    double* C, lapack_int ldc,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgemqr(
+        &side, &trans, &m, &n, &k,
+        A, &lda,
+        T, &tsize,
+        C, &ldc,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gemqr(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* T, lapack_int tsize,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgemqr(
+        &side, &trans, &m, &n, &k,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) T, &tsize,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gemqr(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* T, lapack_int tsize,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgemqr(
+        &side, &trans, &m, &n, &k,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) T, &tsize,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gemqr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int tsize_ = (lapack_int) tsize;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gemqr(
+        side_, trans_, m_, n_, k_,
+        A, lda_,
+        T, tsize_,
+        C, ldc_,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gemqr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gemqr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gemqr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(tsize) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gemqr", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int tsize_ = (lapack_int) tsize;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gemqr(
+        side_, trans_, m_, n_, k_,
+        A, lda_,
+        T, tsize_,
+        C, ldc_,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* T, int64_t tsize,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* T, int64_t tsize,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* T, int64_t tsize,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void gemqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* T, int64_t tsize,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* T, int64_t tsize,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* T, int64_t tsize,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* T, int64_t tsize,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t gemqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* T, int64_t tsize,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,13 +29,18 @@ int64_t geql2(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geql2", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (n) );
+    lapack::small_vector< float > work( (n) );
 
     LAPACK_sgeql2(
         &m_, &n_,
@@ -60,13 +66,18 @@ int64_t geql2(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geql2", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n) );
+    lapack::small_vector< double > work( (n) );
 
     LAPACK_dgeql2(
         &m_, &n_,
@@ -92,13 +103,18 @@ int64_t geql2(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geql2", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
 
     LAPACK_cgeql2(
         &m_, &n_,
@@ -178,13 +194,18 @@ int64_t geql2(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geql2", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
 
     LAPACK_zgeql2(
         &m_, &n_,
@@ -197,4 +218,198 @@ int64_t geql2(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_geql2(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* tau,
+    float* work, lapack_int* info )
+{
+    LAPACK_sgeql2(
+        &m, &n,
+        A, &lda,
+        tau,
+        work, info );
+}
+
+//----------
+static void fortran_geql2(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* tau,
+    double* work, lapack_int* info )
+{
+    LAPACK_dgeql2(
+        &m, &n,
+        A, &lda,
+        tau,
+        work, info );
+}
+
+//----------
+static void fortran_geql2(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_cgeql2(
+        &m, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_geql2(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zgeql2(
+        &m, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by geql2 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::geql2, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::geql2 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     geql2_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t geql2(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "geql2", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+
+    fortran_geql2(
+        m_, n_,
+        A, lda_,
+        tau,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* work_size );
+
+template
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* work_size );
+
+template
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* work_size );
+
+template
+void geql2_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t geql2(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geql2(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geql2(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geql2(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* work, size_t work_size );
+
 }  // namespace lapack
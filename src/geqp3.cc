@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,12 +29,17 @@ int64_t geqp3(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqp3", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -55,7 +61,7 @@ int64_t geqp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgeqp3(
         &m_, &n_,
@@ -85,12 +91,17 @@ int64_t geqp3(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqp3", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -112,7 +123,7 @@ int64_t geqp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgeqp3(
         &m_, &n_,
@@ -142,12 +153,17 @@ int64_t geqp3(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqp3", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -171,8 +187,8 @@ int64_t geqp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgeqp3(
         &m_, &n_,
@@ -203,12 +219,17 @@ int64_t geqp3(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqp3", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
+        lapack::small_vector< lapack_int > jpvt_( &jpvt[0], &jpvt[(n)] );
         lapack_int* jpvt_ptr = &jpvt_[0];
     #else
         lapack_int* jpvt_ptr = jpvt;
@@ -232,8 +253,8 @@ int64_t geqp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgeqp3(
         &m_, &n_,
@@ -251,4 +272,258 @@ int64_t geqp3(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_geqp3(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* jpvt,
+    float* tau,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgeqp3(
+        &m, &n,
+        A, &lda,
+        jpvt,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_geqp3(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* jpvt,
+    double* tau,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgeqp3(
+        &m, &n,
+        A, &lda,
+        jpvt,
+        tau,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_geqp3(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* jpvt,
+    std::complex<float>* tau,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgeqp3(
+        &m, &n,
+        (lapack_complex_float*) A, &lda,
+        jpvt,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info );
+}
+
+//----------
+static void fortran_geqp3(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* jpvt,
+    std::complex<double>* tau,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgeqp3(
+        &m, &n,
+        (lapack_complex_double*) A, &lda,
+        jpvt,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by geqp3 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_geqp3(
+        m_, n_,
+        A, lda_,
+        nullptr,
+        tau,
+        qry_work, ineg_one,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::geqp3, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::geqp3 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     geqp3_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t geqp3(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* jpvt,
+    scalar_t* tau,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "geqp3", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* jpvt_ = buffer.take< lapack_int >( n );
+        std::copy( jpvt, jpvt + n, jpvt_ );
+        lapack_int* jpvt_ptr = jpvt_;
+    #else
+        lapack_int* jpvt_ptr = jpvt;
+    #endif
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_geqp3(
+        m_, n_,
+        A, lda_,
+        jpvt_ptr,
+        tau,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( jpvt_, jpvt_ + n, jpvt );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* work_size );
+
+template
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* work_size );
+
+template
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* work_size );
+
+template
+void geqp3_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t geqp3(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    int64_t* jpvt,
+    float* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geqp3(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    int64_t* jpvt,
+    double* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geqp3(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* jpvt,
+    std::complex<float>* tau,
+    void* work, size_t work_size );
+
+template
+int64_t geqp3(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* jpvt,
+    std::complex<double>* tau,
+    void* work, size_t work_size );
+
 }  // namespace lapack
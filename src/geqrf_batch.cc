@@ -0,0 +1,246 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of matrices, $A_i = Q_i R_i$,
+/// pointer-array variant. See lapack::geqrf.
+///
+/// Workspace is queried once for each distinct (m_i, n_i, lda_i), so once
+/// if all problems have the same dimensions, and each worker thread reuses
+/// one buffer of the largest size for all its problems.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$; 1 or batch entries.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, $R_i$ and the Householder vectors,
+///     as in lapack::geqrf.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, m_i).
+///     1 or batch entries.
+///
+/// @param[out] tau_array
+///     Pointers to the batch vectors of scalar factors of the elementary
+///     reflectors, of length min(m_i, n_i).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::geqrf for $A_i$, which is 0.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& tau_array,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( m, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( tau_array, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t m_i = extract( m, i );
+        lapack_error_if( m_i < 0 );
+        lapack_error_if( extract( n, i ) < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, m_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "geqrf_batch", trace::internal::precision< scalar_t >(),
+        internal::batch::trace_dim( m ), internal::batch::trace_dim( n ), -1,
+        [&]() {
+            double gflop = 0;
+            for (size_t i = 0; i < batch; ++i)
+                gflop += Gflop< scalar_t >::geqrf(
+                    extract( m, i ),
+                    extract( n, i ) );
+            return gflop;
+        } );
+
+    // query workspace, skipping problems with the same dimensions
+    // as the previous one
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( m, i )   != extract( m, i-1 )
+            || extract( n, i )   != extract( n, i-1 )
+            || extract( lda, i ) != extract( lda, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::geqrf_work_size_bytes(
+                extract( m, i ), extract( n, i ),
+                Aarray[ i ], extract( lda, i ), tau_array[ i ],
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::geqrf(
+            extract( m, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ), tau_array[ i ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of matrices, $A_i = Q_i R_i$,
+/// strided variant. See lapack::geqrf.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, $R_i$ and the Householder
+///     vectors, as in lapack::geqrf.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, m).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[out] tau
+///     The batch vectors of scalar factors of the elementary reflectors,
+///     with $\tau_i$ of length min(m, n) starting at tau + i*stride_tau.
+///
+/// @param[in] stride_tau
+///     Distance between vectors; stride_tau >= min(m, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_tau < min( m, n ) );
+
+    trace::internal::Block trace_block(
+        "geqrf_batch", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::geqrf( m, n ); } );
+
+    size_t work_size;
+    lapack::geqrf_work_size_bytes( m, n, A, lda, tau, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::geqrf(
+            m, n, &A[ i*strideA ], lda, &tau[ i*stride_tau ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*> const& tau_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*> const& tau_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& tau_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& tau_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    int64_t m, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    int64_t m, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    std::complex<float>* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void geqrf_batch(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    std::complex<double>* tau, int64_t stride_tau,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
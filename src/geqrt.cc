@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30400  // >= 3.4
 
@@ -31,6 +33,11 @@ int64_t geqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqrt", 's', m, n, -1,
+        [&]() { return Gflop< float >::geqrt( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -39,7 +46,7 @@ int64_t geqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (nb*n) );
+    lapack::small_vector< float > work( (nb*n) );
 
     LAPACK_sgeqrt(
         &m_, &n_, &nb_,
@@ -66,6 +73,11 @@ int64_t geqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqrt", 'd', m, n, -1,
+        [&]() { return Gflop< double >::geqrt( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -74,7 +86,7 @@ int64_t geqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (nb*n) );
+    lapack::small_vector< double > work( (nb*n) );
 
     LAPACK_dgeqrt(
         &m_, &n_, &nb_,
@@ -101,6 +113,11 @@ int64_t geqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqrt", 'c', m, n, -1,
+        [&]() { return Gflop< std::complex<float> >::geqrt( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -109,7 +126,7 @@ int64_t geqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (nb*n) );
+    lapack::small_vector< std::complex<float> > work( (nb*n) );
 
     LAPACK_cgeqrt(
         &m_, &n_, &nb_,
@@ -136,6 +153,11 @@ int64_t geqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "geqrt", 'z', m, n, -1,
+        [&]() { return Gflop< std::complex<double> >::geqrt( m, n ); } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -144,7 +166,7 @@ int64_t geqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (nb*n) );
+    lapack::small_vector< std::complex<double> > work( (nb*n) );
 
     LAPACK_zgeqrt(
         &m_, &n_, &nb_,
@@ -157,6 +179,206 @@ int64_t geqrt(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_geqrt(
+    lapack_int m, lapack_int n, lapack_int nb,
+    float* A, lapack_int lda,
+    float* T, lapack_int ldt,
+    float* work, lapack_int* info )
+{
+    LAPACK_sgeqrt(
+        &m, &n, &nb,
+        A, &lda,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_geqrt(
+    lapack_int m, lapack_int n, lapack_int nb,
+    double* A, lapack_int lda,
+    double* T, lapack_int ldt,
+    double* work, lapack_int* info )
+{
+    LAPACK_dgeqrt(
+        &m, &n, &nb,
+        A, &lda,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_geqrt(
+    lapack_int m, lapack_int n, lapack_int nb,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_cgeqrt(
+        &m, &n, &nb,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_geqrt(
+    lapack_int m, lapack_int n, lapack_int nb,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zgeqrt(
+        &m, &n, &nb,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by geqrt with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( nb*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::geqrt, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::geqrt for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     geqrt_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "geqrt", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return Gflop< scalar_t >::geqrt( m, n ); } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nb_ = (lapack_int) nb;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( nb*n );
+
+    fortran_geqrt(
+        m_, n_, nb_,
+        A, lda_,
+        T, ldt_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    float* A, int64_t lda,
+    float* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    double* A, int64_t lda,
+    double* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void geqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t ldt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    float* A, int64_t lda,
+    float* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    double* A, int64_t lda,
+    double* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t geqrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t ldt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.4
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -36,6 +37,11 @@ int64_t gerfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfs", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -43,7 +49,7 @@ int64_t gerfs(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -53,8 +59,8 @@ int64_t gerfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgerfs(
         &trans_, &n_, &nrhs_,
@@ -98,6 +104,11 @@ int64_t gerfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfs", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -105,7 +116,7 @@ int64_t gerfs(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -115,8 +126,8 @@ int64_t gerfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgerfs(
         &trans_, &n_, &nrhs_,
@@ -160,6 +171,11 @@ int64_t gerfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfs", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -167,7 +183,7 @@ int64_t gerfs(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -177,8 +193,8 @@ int64_t gerfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cgerfs(
         &trans_, &n_, &nrhs_,
@@ -296,6 +312,11 @@ int64_t gerfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfs", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -303,7 +324,7 @@ int64_t gerfs(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -313,8 +334,8 @@ int64_t gerfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zgerfs(
         &trans_, &n_, &nrhs_,
@@ -337,4 +358,346 @@ int64_t gerfs(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gerfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    float const* A, lapack_int lda,
+    float const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgerfs(
+        &trans, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    double const* A, lapack_int lda,
+    double const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgerfs(
+        &trans, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgerfs(
+        &trans, &n, &nrhs,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) AF, &ldaf,
+        ipiv,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgerfs(
+        &trans, &n, &nrhs,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) AF, &ldaf,
+        ipiv,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gerfs with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gerfs, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gerfs for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gerfs_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gerfs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldaf_ = (lapack_int) ldaf;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_gerfs(
+        trans_, n_, nrhs_,
+        A, lda_,
+        AF, ldaf_,
+        ipiv_ptr,
+        B, ldb_,
+        X, ldx_,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gerfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gerfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #ifdef LAPACK_HAVE_XBLAS
 
@@ -45,6 +46,11 @@ int64_t gerfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfsx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -53,7 +59,7 @@ int64_t gerfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -65,8 +71,8 @@ int64_t gerfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgerfsx(
         &trans_, &equed_, &n_, &nrhs_,
@@ -121,6 +127,11 @@ int64_t gerfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfsx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -129,7 +140,7 @@ int64_t gerfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -141,8 +152,8 @@ int64_t gerfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgerfsx(
         &trans_, &equed_, &n_, &nrhs_,
@@ -197,6 +208,11 @@ int64_t gerfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfsx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -205,7 +221,7 @@ int64_t gerfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -217,8 +233,8 @@ int64_t gerfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgerfsx(
         &trans_, &equed_, &n_, &nrhs_,
@@ -545,6 +561,11 @@ int64_t gerfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gerfsx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -553,7 +574,7 @@ int64_t gerfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -565,8 +586,8 @@ int64_t gerfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgerfsx(
         &trans_, &equed_, &n_, &nrhs_,
@@ -593,6 +614,436 @@ int64_t gerfsx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gerfsx(
+    char trans, char equed, lapack_int n, lapack_int nrhs,
+    float const* A, lapack_int lda,
+    float const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    float const* R,
+    float const* C,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* berr, lapack_int n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, lapack_int nparams,
+    float* params,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgerfsx(
+        &trans, &equed, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfsx(
+    char trans, char equed, lapack_int n, lapack_int nrhs,
+    double const* A, lapack_int lda,
+    double const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    double const* R,
+    double const* C,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* berr, lapack_int n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, lapack_int nparams,
+    double* params,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgerfsx(
+        &trans, &equed, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfsx(
+    char trans, char equed, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    float const* R,
+    float const* C,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* berr, lapack_int n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, lapack_int nparams,
+    float* params,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgerfsx(
+        &trans, &equed, &n, &nrhs,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) AF, &ldaf,
+        ipiv,
+        R,
+        C,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gerfsx(
+    char trans, char equed, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    double const* R,
+    double const* C,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* berr, lapack_int n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, lapack_int nparams,
+    double* params,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgerfsx(
+        &trans, &equed, &n, &nrhs,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) AF, &ldaf,
+        ipiv,
+        R,
+        C,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gerfsx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t> const* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gerfsx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gerfsx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gerfsx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t> const* C,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gerfsx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    char equed_ = equed2char( equed );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldaf_ = (lapack_int) ldaf;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int n_err_bnds_ = (lapack_int) n_err_bnds;
+    lapack_int nparams_ = (lapack_int) nparams;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+
+    fortran_gerfsx(
+        trans_, equed_, n_, nrhs_,
+        A, lda_,
+        AF, ldaf_,
+        ipiv_ptr,
+        R,
+        C,
+        B, ldb_,
+        X, ldx_, rcond,
+        berr, n_err_bnds_,
+        err_bnds_norm,
+        err_bnds_comp, nparams_,
+        params,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    float const* R,
+    float const* C,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size );
+
+template
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    double const* R,
+    double const* C,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size );
+
+template
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    float const* R,
+    float const* C,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size );
+
+template
+void gerfsx_work_size_bytes(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    double const* R,
+    double const* C,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float const* R,
+    float const* C,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size );
+
+template
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double const* R,
+    double const* C,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size );
+
+template
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float const* R,
+    float const* C,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size );
+
+template
+int64_t gerfsx(
+    lapack::Op trans, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double const* R,
+    double const* C,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // HAVE_XBLAS
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +34,11 @@ int64_t gesdd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesdd", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -62,8 +69,8 @@ int64_t gesdd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (8*min(m,n)) );
 
     LAPACK_sgesdd(
         &jobz_, &m_, &n_,
@@ -100,6 +107,11 @@ int64_t gesdd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesdd", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -130,8 +142,8 @@ int64_t gesdd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (8*min(m,n)) );
 
     LAPACK_dgesdd(
         &jobz_, &m_, &n_,
@@ -168,6 +180,11 @@ int64_t gesdd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesdd", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -213,9 +230,9 @@ int64_t gesdd(
     }
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( (8*min(m,n)) );
 
     LAPACK_cgesdd(
         &jobz_, &m_, &n_,
@@ -359,6 +376,11 @@ int64_t gesdd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesdd", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -404,9 +426,9 @@ int64_t gesdd(
     }
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( (8*min(m,n)) );
 
     LAPACK_zgesdd(
         &jobz_, &m_, &n_,
@@ -427,4 +449,329 @@ int64_t gesdd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// rwork is not referenced in real precisions.
+static void fortran_gesdd(
+    char jobz, lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* S,
+    float* U, lapack_int ldu,
+    float* VT, lapack_int ldvt,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sgesdd(
+        &jobz, &m, &n,
+        A, &lda,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesdd(
+    char jobz, lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* S,
+    double* U, lapack_int ldu,
+    double* VT, lapack_int ldvt,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dgesdd(
+        &jobz, &m, &n,
+        A, &lda,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesdd(
+    char jobz, lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    float* S,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* VT, lapack_int ldvt,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_cgesdd(
+        &jobz, &m, &n,
+        (lapack_complex_float*) A, &lda,
+        S,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) VT, &ldvt,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesdd(
+    char jobz, lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    double* S,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* VT, lapack_int ldvt,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_zgesdd(
+        &jobz, &m, &n,
+        (lapack_complex_double*) A, &lda,
+        S,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) VT, &ldvt,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+// Length of rwork for complex gesdd. LAPACK < 3.7 doesn't return lrwork
+// from the workspace query, so use the formula from LAPACK 3.6,
+// which is an upper bound for later versions.
+static int64_t gesdd_lrwork( lapack::Job jobz, int64_t m, int64_t n )
+{
+    int64_t mx = max( m, n );
+    int64_t mn = min( m, n );
+    int64_t lrwork;
+    if (jobz == Job::NoVec) {
+        lrwork = 7*mn;
+    }
+    else {
+        lrwork = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
+    }
+    return max( 1, lrwork );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gesdd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_gesdd(
+        jobz_, m_, n_,
+        A, lda_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? gesdd_lrwork( jobz, m, n ) : 0 );
+    buffer.take< lapack_int >( 8*min( m, n ) );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Computes the SVD as lapack::gesdd does, but with caller-provided
+/// workspace instead of allocating it.
+/// See lapack::gesdd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gesdd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesdd", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? gesdd_lrwork( jobz, m, n ) : 0 );
+    lapack_int* iwork_ = buffer.take< lapack_int >( 8*min( m, n ) );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gesdd(
+        jobz_, m_, n_,
+        A, lda_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        work_, lwork_,
+        rwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
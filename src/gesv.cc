@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -30,12 +32,17 @@ int64_t gesv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 's', -1, n, nrhs,
+        [&]() { return Gflop< float >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -72,12 +79,17 @@ int64_t gesv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -114,12 +126,17 @@ int64_t gesv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 'c', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<float> >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -205,12 +222,17 @@ int64_t gesv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -249,12 +271,17 @@ int64_t gesv(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -265,8 +292,8 @@ int64_t gesv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n)*(nrhs) );
-    lapack::vector< float > swork( (n*(n+nrhs)) );
+    lapack::small_vector< double > work( (n)*(nrhs) );
+    lapack::small_vector< float > swork( (n*(n+nrhs)) );
 
     LAPACK_dsgesv(
         &n_, &nrhs_,
@@ -303,12 +330,17 @@ int64_t gesv(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::gesv( n, nrhs ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -319,9 +351,9 @@ int64_t gesv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n)*(nrhs) );
-    lapack::vector< std::complex<float> > swork( (n*(n+nrhs)) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (n)*(nrhs) );
+    lapack::small_vector< std::complex<float> > swork( (n*(n+nrhs)) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zcgesv(
         &n_, &nrhs_,
@@ -342,4 +374,450 @@ int64_t gesv(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Only double and complex<double>, which factor in single precision
+// (swork); real precision doesn't reference rwork.
+static void fortran_gesv(
+    lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    lapack_int* ipiv,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    double* work, float* swork, double* rwork,
+    lapack_int* iter, lapack_int* info )
+{
+    LAPACK_dsgesv(
+        &n, &nrhs,
+        A, &lda,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        work,
+        swork, iter, info
+    );
+}
+
+//----------
+static void fortran_gesv(
+    lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    std::complex<double>* work, std::complex<float>* swork, double* rwork,
+    lapack_int* iter, lapack_int* info )
+{
+    LAPACK_zcgesv(
+        &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        ipiv,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) X, &ldx,
+        (lapack_complex_double*) work,
+        (lapack_complex_float*) swork,
+        rwork, iter, info
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by mixed-precision gesv
+/// with caller-provided workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    using single_t = typename std::conditional<
+        is_complex, std::complex<float>, float >::type;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( n*nrhs );
+    buffer.take< single_t >( n*(n+nrhs) );
+    buffer.take< real_t >( is_complex ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gesv, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gesv for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gesv_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    using single_t = typename std::conditional<
+        is_complex, std::complex<float>, float >::type;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return Gflop< scalar_t >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        lapack_int* ipiv_ptr = ipiv_;
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( n*nrhs );
+    single_t* swork_ = buffer.take< single_t >( n*(n+nrhs) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? n : 0 );
+
+    fortran_gesv(
+        n_, nrhs_,
+        A, lda_,
+        ipiv_ptr,
+        B, ldb_,
+        X, ldx_,
+        work_, swork_, rwork_, &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_, ipiv_ + n, ipiv );
+    #endif
+    *iter = iter_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    size_t* work_size );
+
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
+template
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are passed directly to LAPACK, without a 32-bit copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 's', -1, n, nrhs,
+        [&]() { return Gflop< float >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_sgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_dgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 'c', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<float> >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_cgesv(
+        &n_, &nrhs_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_zgesv(
+        &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // allocate workspace
+    lapack::small_vector< double > work( (n)*(nrhs) );
+    lapack::small_vector< float > swork( (n*(n+nrhs)) );
+
+    LAPACK_dsgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_,
+        X, &ldx_,
+        &work[0],
+        &swork[0], &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *iter = iter_;
+    return info_;
+}
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::gesv( n, nrhs ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // allocate workspace
+    lapack::small_vector< std::complex<double> > work( (n)*(nrhs) );
+    lapack::small_vector< std::complex<float> > swork( (n*(n+nrhs)) );
+    lapack::small_vector< double > rwork( (n) );
+
+    LAPACK_zcgesv(
+        &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_,
+        (lapack_complex_double*) X, &ldx_,
+        (lapack_complex_double*) &work[0],
+        (lapack_complex_float*) &swork[0],
+        &rwork[0], &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *iter = iter_;
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +34,11 @@ int64_t gesvd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvd", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     lapack_int m_ = (lapack_int) m;
@@ -61,7 +68,7 @@ int64_t gesvd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    std::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -97,6 +104,11 @@ int64_t gesvd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvd", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     lapack_int m_ = (lapack_int) m;
@@ -126,7 +138,7 @@ int64_t gesvd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    std::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -162,6 +174,11 @@ int64_t gesvd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvd", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     lapack_int m_ = (lapack_int) m;
@@ -193,8 +210,8 @@ int64_t gesvd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    std::vector< std::complex<float> > work( lwork_ );
-    std::vector< float > rwork( (5*min(m,n)) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (5*min(m,n)) );
 
     LAPACK_cgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -340,6 +357,11 @@ int64_t gesvd(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvd", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     lapack_int m_ = (lapack_int) m;
@@ -371,8 +393,8 @@ int64_t gesvd(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    std::vector< std::complex<double> > work( lwork_ );
-    std::vector< double > rwork( (5*min(m,n)) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (5*min(m,n)) );
 
     LAPACK_zgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -392,4 +414,302 @@ int64_t gesvd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// rwork is not referenced in real precisions.
+static void fortran_gesvd(
+    char jobu, char jobvt, lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    float* S,
+    float* U, lapack_int ldu,
+    float* VT, lapack_int ldvt,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgesvd(
+        &jobu, &jobvt, &m, &n,
+        A, &lda,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvd(
+    char jobu, char jobvt, lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    double* S,
+    double* U, lapack_int ldu,
+    double* VT, lapack_int ldvt,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgesvd(
+        &jobu, &jobvt, &m, &n,
+        A, &lda,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvd(
+    char jobu, char jobvt, lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    float* S,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* VT, lapack_int ldvt,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgesvd(
+        &jobu, &jobvt, &m, &n,
+        (lapack_complex_float*) A, &lda,
+        S,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) VT, &ldvt,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvd(
+    char jobu, char jobvt, lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    double* S,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* VT, lapack_int ldvt,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgesvd(
+        &jobu, &jobvt, &m, &n,
+        (lapack_complex_double*) A, &lda,
+        S,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) VT, &ldvt,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gesvd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int ineg_one = -1;
+    fortran_gesvd(
+        jobu_, jobvt_, m_, n_,
+        A, lda_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        qry_work, ineg_one,
+        qry_rwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 5*min( m, n ) : 0 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gesvd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gesvd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gesvd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesvd", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 5*min( m, n ) : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gesvd(
+        jobu_, jobvt_, m_, n_,
+        A, lda_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -0,0 +1,375 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+// Checks jobu, jobvt, ldu, and ldvt of one gesvd problem, as LAPACK does.
+// Sets ucol and vtcol to the number of columns of U and VT referenced,
+// for checking strides; 0 if not referenced.
+static void gesvd_check_uvt(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    int64_t ldu, int64_t ldvt,
+    int64_t* ucol, int64_t* vtcol )
+{
+    lapack_error_if( jobu != Job::NoVec && jobu != Job::AllVec
+                     && jobu != Job::SomeVec && jobu != Job::OverwriteVec );
+    lapack_error_if( jobvt != Job::NoVec && jobvt != Job::AllVec
+                     && jobvt != Job::SomeVec && jobvt != Job::OverwriteVec );
+    lapack_error_if( jobu == Job::OverwriteVec && jobvt == Job::OverwriteVec );
+    int64_t minmn = min( m, n );
+    int64_t ldu_min = 1, ldvt_min = 1;
+    *ucol  = 0;
+    *vtcol = 0;
+    if (jobu == Job::AllVec || jobu == Job::SomeVec) {
+        ldu_min = m;
+        *ucol = (jobu == Job::AllVec ? m : minmn);
+    }
+    if (jobvt == Job::AllVec || jobvt == Job::SomeVec) {
+        ldvt_min = (jobvt == Job::AllVec ? n : minmn);
+        *vtcol = n;
+    }
+    lapack_error_if( ldu  < max( 1, ldu_min ) );
+    lapack_error_if( ldvt < max( 1, ldvt_min ) );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the singular value decomposition (SVD) of a batch of matrices,
+/// pointer-array variant. See lapack::gesvd.
+///
+/// Workspace is queried once for each distinct (jobu_i, jobvt_i, m_i, n_i),
+/// so once if all problems have the same arguments, and each worker
+/// thread reuses one buffer of the largest size for all its problems.
+///
+/// @param[in] jobu
+///     Which left singular vectors to compute; 1 or batch entries.
+///     See lapack::gesvd. If NoVec or OverwriteVec, $U_i$ is not
+///     referenced, so Uarray entries can be null.
+///
+/// @param[in] jobvt
+///     Which right singular vectors to compute; 1 or batch entries.
+///     See lapack::gesvd. If NoVec or OverwriteVec, $V_i^H$ is not
+///     referenced, so VTarray entries can be null.
+///     jobu and jobvt cannot both be OverwriteVec.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$; 1 or batch entries.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, overwritten as in lapack::gesvd.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, m_i).
+///     1 or batch entries.
+///
+/// @param[out] Sarray
+///     Pointers to the batch vectors of singular values of $A_i$,
+///     of length min(m_i, n_i), in descending order.
+///
+/// @param[out] Uarray
+///     Pointers to the batch matrices $U_i$, as in lapack::gesvd.
+///
+/// @param[in] ldu
+///     Leading dimension of each $U_i$; 1 or batch entries.
+///
+/// @param[out] VTarray
+///     Pointers to the batch matrices $V_i^H$, as in lapack::gesvd.
+///
+/// @param[in] ldvt
+///     Leading dimension of each $V_i^H$; 1 or batch entries.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::gesvd for $A_i$: 0 for success, or > 0 if the
+///     algorithm failed to converge.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Sarray,
+    std::vector<scalar_t*> const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector<scalar_t*> const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( jobu, batch );
+    internal::batch::check_arg_size( jobvt, batch );
+    internal::batch::check_arg_size( m, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( ldu, batch );
+    internal::batch::check_arg_size( ldvt, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Sarray, batch );
+    internal::batch::check_array_size( Uarray, batch );
+    internal::batch::check_array_size( VTarray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t m_i = extract( m, i );
+        int64_t n_i = extract( n, i );
+        int64_t ucol, vtcol;
+        lapack_error_if( m_i < 0 );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, m_i ) );
+        gesvd_check_uvt( extract( jobu, i ), extract( jobvt, i ), m_i, n_i,
+                         extract( ldu, i ), extract( ldvt, i ),
+                         &ucol, &vtcol );
+    }
+
+    trace::internal::Block trace_block(
+        "gesvd_batch", trace::internal::precision< scalar_t >(),
+        internal::batch::trace_dim( m ), internal::batch::trace_dim( n ), -1,
+        []() { return 0.0; } );
+
+    // query workspace, skipping problems with the same arguments
+    // as the previous one; the size depends only on these.
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( jobu, i )  != extract( jobu, i-1 )
+            || extract( jobvt, i ) != extract( jobvt, i-1 )
+            || extract( m, i )     != extract( m, i-1 )
+            || extract( n, i )     != extract( n, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::gesvd_work_size_bytes(
+                extract( jobu, i ), extract( jobvt, i ),
+                extract( m, i ), extract( n, i ),
+                Aarray[ i ], extract( lda, i ), Sarray[ i ],
+                Uarray[ i ], extract( ldu, i ),
+                VTarray[ i ], extract( ldvt, i ),
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::gesvd(
+            extract( jobu, i ), extract( jobvt, i ),
+            extract( m, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ), Sarray[ i ],
+            Uarray[ i ], extract( ldu, i ),
+            VTarray[ i ], extract( ldvt, i ),
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes the singular value decomposition (SVD) of a batch of matrices,
+/// strided variant. See lapack::gesvd.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] jobu
+///     Which left singular vectors to compute. See lapack::gesvd.
+///     If NoVec or OverwriteVec, U is not referenced, so can be null.
+///
+/// @param[in] jobvt
+///     Which right singular vectors to compute. See lapack::gesvd.
+///     If NoVec or OverwriteVec, VT is not referenced, so can be null.
+///     jobu and jobvt cannot both be OverwriteVec.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, overwritten as in lapack::gesvd.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, m).
+///
+/// @param[in] strideA
+///     Distance between matrices $A_i$; strideA >= lda*n.
+///
+/// @param[out] S
+///     The batch vectors of singular values, with those of $A_i$
+///     starting at S + i*strideS, in descending order.
+///
+/// @param[in] strideS
+///     Distance between vectors; strideS >= min(m, n).
+///
+/// @param[out] U
+///     The batch matrices $U_i$, each stored in an ldu-by-ucol array
+///     starting at U + i*strideU, where ucol is as in lapack::gesvd.
+///
+/// @param[in] ldu
+///     Leading dimension of each $U_i$.
+///
+/// @param[in] strideU
+///     Distance between matrices $U_i$; strideU >= ldu*ucol.
+///
+/// @param[out] VT
+///     The batch matrices $V_i^H$, each stored in an ldvt-by-n array
+///     starting at VT + i*strideVT, if referenced.
+///
+/// @param[in] ldvt
+///     Leading dimension of each $V_i^H$.
+///
+/// @param[in] strideVT
+///     Distance between matrices $V_i^H$; strideVT >= ldvt*n if referenced.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* S, int64_t strideS,
+    scalar_t* U, int64_t ldu, int64_t strideU,
+    scalar_t* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info )
+{
+    int64_t ucol, vtcol;
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    gesvd_check_uvt( jobu, jobvt, m, n, ldu, ldvt, &ucol, &vtcol );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideS < min( m, n ) );
+    lapack_error_if( strideU < ldu*ucol );
+    lapack_error_if( strideVT < ldvt*vtcol );
+
+    trace::internal::Block trace_block(
+        "gesvd_batch", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    size_t work_size;
+    lapack::gesvd_work_size_bytes( jobu, jobvt, m, n, A, lda, S,
+                                   U, ldu, VT, ldvt, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    // if not referenced, U or VT may be null; don't offset a null pointer
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::gesvd(
+            jobu, jobvt, m, n, &A[ i*strideA ], lda, &S[ i*strideS ],
+            ucol  > 0 ? &U[ i*strideU ]   : U,  ldu,
+            vtcol > 0 ? &VT[ i*strideVT ] : VT, ldvt,
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float* > const& Sarray,
+    std::vector<float*> const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector<float*> const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double* > const& Sarray,
+    std::vector<double*> const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector<double*> const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float* > const& Sarray,
+    std::vector< std::complex<float>* > const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector< std::complex<float>* > const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    std::vector<lapack::Job> const& jobu,
+    std::vector<lapack::Job> const& jobvt,
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double* > const& Sarray,
+    std::vector< std::complex<double>* > const& Uarray, std::vector<int64_t> const& ldu,
+    std::vector< std::complex<double>* > const& VTarray, std::vector<int64_t> const& ldvt,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float* S, int64_t strideS,
+    float* U, int64_t ldu, int64_t strideU,
+    float* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double* S, int64_t strideS,
+    double* U, int64_t ldu, int64_t strideU,
+    double* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    float* S, int64_t strideS,
+    std::complex<float>* U, int64_t ldu, int64_t strideU,
+    std::complex<float>* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void gesvd_batch(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    double* S, int64_t strideS,
+    std::complex<double>* U, int64_t ldu, int64_t strideU,
+    std::complex<double>* VT, int64_t ldvt, int64_t strideVT,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
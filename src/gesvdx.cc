@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30600  // >= v3.6
 
@@ -37,6 +38,11 @@ int64_t gesvdx(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvdx", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     char range_ = range2char( range );
@@ -72,8 +78,8 @@ int64_t gesvdx(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (12*min(m,n)) );
 
     LAPACK_sgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
@@ -114,6 +120,11 @@ int64_t gesvdx(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvdx", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     char range_ = range2char( range );
@@ -149,8 +160,8 @@ int64_t gesvdx(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (12*min(m,n)) );
 
     LAPACK_dgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
@@ -191,6 +202,11 @@ int64_t gesvdx(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvdx", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     char range_ = range2char( range );
@@ -231,9 +247,9 @@ int64_t gesvdx(
     int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (max( 1, lrwork )) );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (max( 1, lrwork )) );
+    lapack::small_vector< lapack_int > iwork( (12*min(m,n)) );
 
     LAPACK_cgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
@@ -402,6 +418,11 @@ int64_t gesvdx(
         lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvdx", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = job2char( jobu );
     char jobvt_ = job2char( jobvt );
     char range_ = range2char( range );
@@ -442,9 +463,9 @@ int64_t gesvdx(
     int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (max( 1, lrwork )) );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (max( 1, lrwork )) );
+    lapack::small_vector< lapack_int > iwork( (12*min(m,n)) );
 
     LAPACK_zgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
@@ -466,6 +487,350 @@ int64_t gesvdx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gesvdx(
+    char jobu, char jobvt, char range, lapack_int m, lapack_int n,
+    float* A, lapack_int lda, float vl, float vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    float* S,
+    float* U, lapack_int ldu,
+    float* VT, lapack_int ldvt,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sgesvdx(
+        &jobu, &jobvt, &range, &m, &n,
+        A, &lda, &vl, &vu, &il, &iu, nfound,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvdx(
+    char jobu, char jobvt, char range, lapack_int m, lapack_int n,
+    double* A, lapack_int lda, double vl, double vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    double* S,
+    double* U, lapack_int ldu,
+    double* VT, lapack_int ldvt,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dgesvdx(
+        &jobu, &jobvt, &range, &m, &n,
+        A, &lda, &vl, &vu, &il, &iu, nfound,
+        S,
+        U, &ldu,
+        VT, &ldvt,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvdx(
+    char jobu, char jobvt, char range, lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda, float vl, float vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    float* S,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* VT, lapack_int ldvt,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_cgesvdx(
+        &jobu, &jobvt, &range, &m, &n,
+        (lapack_complex_float*) A, &lda, &vl, &vu, &il, &iu, nfound,
+        S,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) VT, &ldvt,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvdx(
+    char jobu, char jobvt, char range, lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda, double vl, double vu, lapack_int il, lapack_int iu, lapack_int* nfound,
+    double* S,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* VT, lapack_int ldvt,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_zgesvdx(
+        &jobu, &jobvt, &range, &m, &n,
+        (lapack_complex_double*) A, &lda, &vl, &vu, &il, &iu, nfound,
+        S,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) VT, &ldvt,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gesvdx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gesvdx(
+        jobu_, jobvt_, range_, m_, n_,
+        A, lda_, vl, vu, il_, iu_, &nfound_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        qry_work, ineg_one,
+        nullptr,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? max( 1, (min(m,n)*(min(m,n)*2 + 15*min(m,n))) ) : 0 );
+    buffer.take< lapack_int >( 12*min(m,n) );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gesvdx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gesvdx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gesvdx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesvdx", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? max( 1, (min(m,n)*(min(m,n)*2 + 15*min(m,n))) ) : 0 );
+    lapack_int* iwork_ = buffer.take< lapack_int >( 12*min(m,n) );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gesvdx(
+        jobu_, jobvt_, range_, m_, n_,
+        A, lda_, vl, vu, il_, iu_, &nfound_,
+        S,
+        U, ldu_,
+        VT, ldvt_,
+        work_, lwork_,
+        rwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    float* A, int64_t lda, float vl,
+    float vu, int64_t il, int64_t iu,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    double* A, int64_t lda, double vl,
+    double vu, int64_t il, int64_t iu,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    std::complex<float>* A, int64_t lda, float vl,
+    float vu, int64_t il, int64_t iu,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* work_size );
+
+template
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    std::complex<double>* A, int64_t lda, double vl,
+    double vu, int64_t il, int64_t iu,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    float* A, int64_t lda, float vl,
+    float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    double* A, int64_t lda, double vl,
+    double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    std::complex<float>* A, int64_t lda, float vl,
+    float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
+template
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n,
+    std::complex<double>* A, int64_t lda, double vl,
+    double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= v3.6
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -41,6 +42,11 @@ int64_t gesvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     char equed_ = equed2char( *equed );
@@ -50,7 +56,7 @@ int64_t gesvx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -60,8 +66,8 @@ int64_t gesvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgesvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -118,6 +124,11 @@ int64_t gesvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     char equed_ = equed2char( *equed );
@@ -127,7 +138,7 @@ int64_t gesvx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -137,8 +148,8 @@ int64_t gesvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (4*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgesvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -195,6 +206,11 @@ int64_t gesvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     char equed_ = equed2char( *equed );
@@ -204,7 +220,7 @@ int64_t gesvx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -214,8 +230,8 @@ int64_t gesvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cgesvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -483,6 +499,11 @@ int64_t gesvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gesvx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     char equed_ = equed2char( *equed );
@@ -492,7 +513,7 @@ int64_t gesvx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -502,8 +523,8 @@ int64_t gesvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zgesvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -534,4 +555,413 @@ int64_t gesvx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gesvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    float* A, lapack_int lda,
+    float* AF, lapack_int ldaf,
+    lapack_int* ipiv, char* equed,
+    float* R,
+    float* C,
+    float* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgesvx(
+        &fact, &trans, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv, equed,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* AF, lapack_int ldaf,
+    lapack_int* ipiv, char* equed,
+    double* R,
+    double* C,
+    double* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgesvx(
+        &fact, &trans, &n, &nrhs,
+        A, &lda,
+        AF, &ldaf,
+        ipiv, equed,
+        R,
+        C,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* AF, lapack_int ldaf,
+    lapack_int* ipiv, char* equed,
+    float* R,
+    float* C,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgesvx(
+        &fact, &trans, &n, &nrhs,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) AF, &ldaf,
+        ipiv, equed,
+        R,
+        C,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gesvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* AF, lapack_int ldaf,
+    lapack_int* ipiv, char* equed,
+    double* R,
+    double* C,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgesvx(
+        &fact, &trans, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) AF, &ldaf,
+        ipiv, equed,
+        R,
+        C,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gesvx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gesvx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gesvx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gesvx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* R,
+    blas::real_type<scalar_t>* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    blas::real_type<scalar_t>* rpivotgrowth,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gesvx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char fact_ = factored2char( fact );
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldaf_ = (lapack_int) ldaf;
+    char equed_ = equed2char( *equed );
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int* ipiv_ptr = ipiv_;
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 4*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+
+    fortran_gesvx(
+        fact_, trans_, n_, nrhs_,
+        A, lda_,
+        AF, ldaf_,
+        ipiv_ptr, &equed_,
+        R,
+        C,
+        B, ldb_,
+        X, ldx_, rcond,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    // reciprocal pivot growth factor is returned in work or rwork
+    *rpivotgrowth = blas::is_complex<scalar_t>::value
+                  ? rwork_[0] : real( work_[0] );
+    *equed = char2equed( equed_ );
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_, ipiv_ + n, ipiv );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    float* R,
+    float* C,
+    float* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    double* R,
+    double* C,
+    double* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    float* R,
+    float* C,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gesvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* AF, int64_t ldaf,
+    lapack::Equed* equed,
+    double* R,
+    double* C,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    float* R,
+    float* C,
+    float* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    float* rpivotgrowth,
+    void* work, size_t work_size );
+
+template
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    double* R,
+    double* C,
+    double* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    double* rpivotgrowth,
+    void* work, size_t work_size );
+
+template
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    float* R,
+    float* C,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    float* rpivotgrowth,
+    void* work, size_t work_size );
+
+template
+int64_t gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    double* R,
+    double* C,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    double* rpivotgrowth,
+    void* work, size_t work_size );
+
 }  // namespace lapack
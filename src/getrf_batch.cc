@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations of a batch of general m-by-n matrices,
+/// $A_i = P_i L_i U_i$, pointer-array variant. See lapack::getrf.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$; 1 or batch entries.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, the factors $L_i$ and $U_i$.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, m_i).
+///     1 or batch entries.
+///
+/// @param[out] ipiv_array
+///     Pointers to the batch pivot vectors, of length min(m_i, n_i).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::getrf for $A_i$: 0 for success, or k > 0 if $U_i(k,k)$
+///     is exactly zero.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( m, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( ipiv_array, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t m_i = extract( m, i );
+        lapack_error_if( m_i < 0 );
+        lapack_error_if( extract( n, i ) < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, m_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "getrf_batch", trace::internal::precision< scalar_t >(),
+        internal::batch::trace_dim( m ), internal::batch::trace_dim( n ), -1,
+        [&]() {
+            double gflop = 0;
+            for (size_t i = 0; i < batch; ++i)
+                gflop += Gflop< scalar_t >::getrf(
+                    extract( m, i ),
+                    extract( n, i ) );
+            return gflop;
+        } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::getrf(
+            extract( m, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ),
+            ipiv_array[ i ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations of a batch of general m-by-n matrices,
+/// $A_i = P_i L_i U_i$, strided variant. See lapack::getrf.
+///
+/// @param[in] m
+///     Number of rows of each $A_i$.
+///
+/// @param[in] n
+///     Number of columns of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, the factors $L_i$ and $U_i$.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, m).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[out] ipiv
+///     The batch pivot vectors, of length min(m, n), with $A_i$'s
+///     starting at ipiv + i*stride_ipiv.
+///
+/// @param[in] stride_ipiv
+///     Distance between pivot vectors; stride_ipiv >= min(m, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_ipiv < min( m, n ) );
+
+    trace::internal::Block trace_block(
+        "getrf_batch", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::getrf( m, n ); } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::getrf(
+            m, n, &A[ i*strideA ], lda, &ipiv[ i*stride_ipiv ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray,
+    std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    std::vector<int64_t> const& m,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray,
+    std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    int64_t m, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    int64_t m, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf_batch(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,11 +29,16 @@ int64_t getri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "getri", 's', -1, n, -1,
+        [&]() { return Gflop< float >::getri( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         std::copy( &ipiv[0], &ipiv[(n)], ipiv_.begin() );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
@@ -53,7 +60,7 @@ int64_t getri(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgetri(
         &n_,
@@ -78,11 +85,16 @@ int64_t getri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "getri", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::getri( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         std::copy( &ipiv[0], &ipiv[(n)], ipiv_.begin() );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
@@ -104,7 +116,7 @@ int64_t getri(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgetri(
         &n_,
@@ -129,11 +141,16 @@ int64_t getri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "getri", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::getri( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         std::copy( &ipiv[0], &ipiv[(n)], ipiv_.begin() );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
@@ -155,7 +172,7 @@ int64_t getri(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgetri(
         &n_,
@@ -212,11 +229,16 @@ int64_t getri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "getri", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::getri( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( max( 1, (n) ) );
+        lapack::small_vector< lapack_int > ipiv_( max( 1, (n) ) );
         std::copy( &ipiv[0], &ipiv[(n)], ipiv_.begin() );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
@@ -238,7 +260,7 @@ int64_t getri(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgetri(
         &n_,
@@ -251,4 +273,410 @@ int64_t getri(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_getri(
+    lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* ipiv,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgetri(
+        &n,
+        A, &lda,
+        ipiv,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_getri(
+    lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* ipiv,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgetri(
+        &n,
+        A, &lda,
+        ipiv,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_getri(
+    lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* ipiv,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgetri(
+        &n,
+        (lapack_complex_float*) A, &lda,
+        ipiv,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_getri(
+    lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* ipiv,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgetri(
+        &n,
+        (lapack_complex_double*) A, &lda,
+        ipiv,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by getri with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void getri_work_size_bytes(
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_getri(
+        n_,
+        A, lda_,
+        nullptr,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( max( 1, (n) ) );
+    #endif
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::getri, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::getri for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     getri_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t getri(
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "getri", trace::internal::precision< scalar_t >(), -1, n, -1,
+        [&]() { return Gflop< scalar_t >::getri( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( max( 1, (n) ) );
+        lapack_int* ipiv_ptr = ipiv_;
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_getri(
+        n_,
+        A, lda_,
+        ipiv_ptr,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_, ipiv_ + (max( 1, (n) )), ipiv );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getri_work_size_bytes(
+    int64_t n,
+    float* A, int64_t lda,
+    size_t* work_size );
+
+template
+void getri_work_size_bytes(
+    int64_t n,
+    double* A, int64_t lda,
+    size_t* work_size );
+
+template
+void getri_work_size_bytes(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    size_t* work_size );
+
+template
+void getri_work_size_bytes(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t getri(
+    int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+template
+int64_t getri(
+    int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+template
+int64_t getri(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+template
+int64_t getri(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    void* work, size_t work_size );
+
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are passed directly to LAPACK, without a 32-bit copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+/// @ingroup gesv_computational
+int64_t getri(
+    int64_t n,
+    float* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "getri", 's', -1, n, -1,
+        [&]() { return Gflop< float >::getri( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::small_vector< float > work( lwork_ );
+
+    LAPACK_sgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t getri(
+    int64_t n,
+    double* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "getri", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::getri( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::small_vector< double > work( lwork_ );
+
+    LAPACK_dgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t getri(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "getri", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::getri( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgetri(
+        &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+
+    LAPACK_cgetri(
+        &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t getri(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "getri", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::getri( n ); } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgetri(
+        &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+
+    LAPACK_zgetri(
+        &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems $op(A_i) X_i = B_i$, using the LU factors
+/// computed by getrf_batch, pointer-array variant. See lapack::getrs.
+///
+/// @param[in] trans
+///     Form of each system, $op(A_i)$; 1 or batch entries.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$; 1 or batch entries.
+///
+/// @param[in] Aarray
+///     Pointers to the batch LU factors of $A_i$, each stored in an
+///     lda_i-by-n_i array.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in] ipiv_array
+///     Pointers to the batch pivot vectors, of length n_i.
+///
+/// @param[in,out] Barray
+///     Pointers to the batch right-hand sides $B_i$, each stored in an
+///     ldb_i-by-nrhs_i array. On exit, the solutions $X_i$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in] batch
+///     Number of systems.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::getrs for system i, which is 0.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( trans, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( nrhs, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( ldb, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( ipiv_array, batch );
+    internal::batch::check_array_size( Barray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( nrhs, i ) < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+        lapack_error_if( extract( ldb, i ) < max( 1, n_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "getrs_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), internal::batch::trace_dim( nrhs ),
+        [&]() {
+            double gflop = 0;
+            for (size_t i = 0; i < batch; ++i)
+                gflop += Gflop< scalar_t >::getrs(
+                    extract( n, i ),
+                    extract( nrhs, i ) );
+            return gflop;
+        } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::getrs(
+            extract( trans, i ), extract( n, i ), extract( nrhs, i ),
+            Aarray[ i ], extract( lda, i ),
+            ipiv_array[ i ],
+            Barray[ i ], extract( ldb, i ) );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems $op(A_i) X_i = B_i$, using the LU factors
+/// computed by getrf_batch, strided variant. See lapack::getrs.
+///
+/// @param[in] trans
+///     Form of the systems, $op(A_i)$.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$.
+///
+/// @param[in] A
+///     The batch LU factors, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[in] ipiv
+///     The batch pivot vectors, of length n, starting at
+///     ipiv + i*stride_ipiv.
+///
+/// @param[in] stride_ipiv
+///     Distance between pivot vectors; stride_ipiv >= n.
+///
+/// @param[in,out] B
+///     The batch right-hand sides, with $B_i$ stored in an ldb-by-nrhs
+///     array starting at B + i*strideB. On exit, the solutions $X_i$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb >= max(1, n).
+///
+/// @param[in] strideB
+///     Distance between right-hand sides; strideB >= ldb*nrhs.
+///
+/// @param[in] batch
+///     Number of systems.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_ipiv < n );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( strideB < ldb*nrhs );
+
+    trace::internal::Block trace_block(
+        "getrs_batch", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return batch * Gflop< scalar_t >::getrs( n, nrhs ); } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::getrs(
+            trans, n, nrhs,
+            &A[ i*strideA ], lda,
+            &ipiv[ i*stride_ipiv ],
+            &B[ i*strideB ], ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector<float*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector<double*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<float>* > const& Aarray,
+    std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector< std::complex<float>* > const& Barray,
+    std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    std::vector<lapack::Op> const& trans,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<double>* > const& Aarray,
+    std::vector<int64_t> const& lda,
+    std::vector<int64_t*> const& ipiv_array,
+    std::vector< std::complex<double>* > const& Barray,
+    std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    float* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    double* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<float>* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<double>* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
@@ -29,6 +29,11 @@ int64_t ggbak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbak", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -68,6 +73,11 @@ int64_t ggbak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbak", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -107,6 +117,11 @@ int64_t ggbak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbak", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -146,6 +161,11 @@ int64_t ggbak(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbak", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     char side_ = side2char( side );
     lapack_int n_ = (lapack_int) n;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t ggbal(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbal", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -43,7 +49,7 @@ int64_t ggbal(
     int64_t lwork = (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1);
 
     // allocate workspace
-    lapack::vector< float > work( (lwork) );
+    lapack::small_vector< float > work( (lwork) );
 
     LAPACK_sggbal(
         &balance_, &n_,
@@ -80,6 +86,11 @@ int64_t ggbal(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbal", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -92,7 +103,7 @@ int64_t ggbal(
     int64_t lwork = (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1);
 
     // allocate workspace
-    lapack::vector< double > work( (lwork) );
+    lapack::small_vector< double > work( (lwork) );
 
     LAPACK_dggbal(
         &balance_, &n_,
@@ -129,6 +140,11 @@ int64_t ggbal(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbal", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -141,7 +157,7 @@ int64_t ggbal(
     int64_t lwork = (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1);
 
     // allocate workspace
-    lapack::vector< float > work( (lwork) );
+    lapack::small_vector< float > work( (lwork) );
 
     LAPACK_cggbal(
         &balance_, &n_,
@@ -178,6 +194,11 @@ int64_t ggbal(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggbal", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char balance_ = balance2char( balance );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -190,7 +211,7 @@ int64_t ggbal(
     int64_t lwork = (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1);
 
     // allocate workspace
-    lapack::vector< double > work( (lwork) );
+    lapack::small_vector< double > work( (lwork) );
 
     LAPACK_zggbal(
         &balance_, &n_,
@@ -211,4 +232,271 @@ int64_t ggbal(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ggbal(
+    char balance, lapack_int n,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb, lapack_int* ilo, lapack_int* ihi,
+    float* lscale,
+    float* rscale,
+    float* work, lapack_int* info )
+{
+    LAPACK_sggbal(
+        &balance, &n,
+        A, &lda,
+        B, &ldb, ilo, ihi,
+        lscale,
+        rscale,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggbal(
+    char balance, lapack_int n,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb, lapack_int* ilo, lapack_int* ihi,
+    double* lscale,
+    double* rscale,
+    double* work, lapack_int* info )
+{
+    LAPACK_dggbal(
+        &balance, &n,
+        A, &lda,
+        B, &ldb, ilo, ihi,
+        lscale,
+        rscale,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggbal(
+    char balance, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb, lapack_int* ilo, lapack_int* ihi,
+    float* lscale,
+    float* rscale,
+    float* work, lapack_int* info )
+{
+    LAPACK_cggbal(
+        &balance, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, ilo, ihi,
+        lscale,
+        rscale,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggbal(
+    char balance, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb, lapack_int* ilo, lapack_int* ihi,
+    double* lscale,
+    double* rscale,
+    double* work, lapack_int* info )
+{
+    LAPACK_zggbal(
+        &balance, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, ilo, ihi,
+        lscale,
+        rscale,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggbal with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* lscale,
+    blas::real_type<scalar_t>* rscale,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggbal, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggbal for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggbal_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    blas::real_type<scalar_t>* lscale,
+    blas::real_type<scalar_t>* rscale,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggbal", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char balance_ = balance2char( balance );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ilo_ = (lapack_int) *ilo;
+    lapack_int ihi_ = (lapack_int) *ihi;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( (balance == Balance::Scale || balance == Balance::Both ? max( 1, 6*n ) : 1) );
+
+    fortran_ggbal(
+        balance_, n_,
+        A, lda_,
+        B, ldb_, &ilo_, &ihi_,
+        lscale,
+        rscale,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *ilo = ilo_;
+    *ihi = ihi_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* lscale,
+    float* rscale,
+    size_t* work_size );
+
+template
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* lscale,
+    double* rscale,
+    size_t* work_size );
+
+template
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* lscale,
+    float* rscale,
+    size_t* work_size );
+
+template
+void ggbal_work_size_bytes(
+    lapack::Balance balance, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* lscale,
+    double* rscale,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    float* lscale,
+    float* rscale,
+    void* work, size_t work_size );
+
+template
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    double* lscale,
+    double* rscale,
+    void* work, size_t work_size );
+
+template
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    float* lscale,
+    float* rscale,
+    void* work, size_t work_size );
+
+template
+int64_t ggbal(
+    lapack::Balance balance, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    int64_t* ilo,
+    int64_t* ihi,
+    double* lscale,
+    double* rscale,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -35,6 +36,11 @@ int64_t gges(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gges", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -47,8 +53,8 @@ int64_t gges(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > alphar( max( 1, n ) );
-    lapack::vector< float > alphai( max( 1, n ) );
+    lapack::small_vector< float > alphar( max( 1, n ) );
+    lapack::small_vector< float > alphai( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -76,8 +82,8 @@ int64_t gges(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_sgges(
         &jobvsl_, &jobvsr_, &sort_,
@@ -126,6 +132,11 @@ int64_t gges(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gges", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -138,8 +149,8 @@ int64_t gges(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > alphar( max( 1, n ) );
-    lapack::vector< double > alphai( max( 1, n ) );
+    lapack::small_vector< double > alphar( max( 1, n ) );
+    lapack::small_vector< double > alphai( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -167,8 +178,8 @@ int64_t gges(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_dgges(
         &jobvsl_, &jobvsr_, &sort_,
@@ -217,6 +228,11 @@ int64_t gges(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gges", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -255,9 +271,9 @@ int64_t gges(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (8*n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (8*n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_cgges(
         &jobvsl_, &jobvsr_, &sort_,
@@ -302,6 +318,11 @@ int64_t gges(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gges", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -340,9 +361,9 @@ int64_t gges(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (8*n) );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (8*n) );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_zgges(
         &jobvsl_, &jobvsr_, &sort_,
@@ -367,4 +388,406 @@ int64_t gges(
     return info_;
 }
 
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions use split-complex alphar and alphai instead of alpha,
+// and don't reference rwork; complex precisions use alpha, and don't
+// reference alphar or alphai.
+static void fortran_gges(
+    char jobvsl, char jobvsr, char sort,
+    lapack_s_select3 select, lapack_int n,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    float* beta,
+    float* VSL, lapack_int ldvsl,
+    float* VSR, lapack_int ldvsr,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_sgges(
+        &jobvsl, &jobvsr, &sort,
+        select, &n,
+        A, &lda,
+        B, &ldb, sdim,
+        alphar,
+        alphai,
+        beta,
+        VSL, &ldvsl,
+        VSR, &ldvsr,
+        work, &lwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gges(
+    char jobvsl, char jobvsr, char sort,
+    lapack_d_select3 select, lapack_int n,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    double* beta,
+    double* VSL, lapack_int ldvsl,
+    double* VSR, lapack_int ldvsr,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_dgges(
+        &jobvsl, &jobvsr, &sort,
+        select, &n,
+        A, &lda,
+        B, &ldb, sdim,
+        alphar,
+        alphai,
+        beta,
+        VSL, &ldvsl,
+        VSR, &ldvsr,
+        work, &lwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gges(
+    char jobvsl, char jobvsr, char sort,
+    lapack_c_select2 select, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, lapack_int ldvsl,
+    std::complex<float>* VSR, lapack_int ldvsr,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_cgges(
+        &jobvsl, &jobvsr, &sort,
+        (LAPACK_C_SELECT2) select, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, sdim,
+        (lapack_complex_float*) alpha,
+        (lapack_complex_float*) beta,
+        (lapack_complex_float*) VSL, &ldvsl,
+        (lapack_complex_float*) VSR, &ldvsr,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gges(
+    char jobvsl, char jobvsr, char sort,
+    lapack_z_select2 select, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, lapack_int ldvsl,
+    std::complex<double>* VSR, lapack_int ldvsr,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_zgges(
+        &jobvsl, &jobvsr, &sort,
+        (LAPACK_Z_SELECT2) select, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, sdim,
+        (lapack_complex_double*) alpha,
+        (lapack_complex_double*) beta,
+        (lapack_complex_double*) VSL, &ldvsl,
+        (lapack_complex_double*) VSR, &ldvsr,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gges with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvsl_ = job2char( jobvsl );
+    char jobvsr_ = job2char( jobvsr );
+    char sort_ = sort2char( sort );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int sdim_ = 0;
+    lapack_int ldvsl_ = (lapack_int) ldvsl;
+    lapack_int ldvsr_ = (lapack_int) ldvsr;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    real_t qry_alphar[1], qry_alphai[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_gges(
+        jobvsl_, jobvsr_, sort_,
+        select, n_,
+        A, lda_,
+        B, ldb_, &sdim_,
+        alpha, qry_alphar, qry_alphai,
+        beta,
+        VSL, ldvsl_,
+        VSR, ldvsr_,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : n );  // alphar
+    buffer.take< real_t >( is_complex ? 0 : n );  // alphai
+    buffer.take< real_t >( is_complex ? 8*n : 0 );  // rwork
+    buffer.take< lapack_int >( n );  // bwork
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gges, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gges for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gges_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gges", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvsl_ = job2char( jobvsl );
+    char jobvsr_ = job2char( jobvsr );
+    char sort_ = sort2char( sort );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int sdim_ = (lapack_int) *sdim;
+    lapack_int ldvsl_ = (lapack_int) ldvsl;
+    lapack_int ldvsr_ = (lapack_int) ldvsr;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* alphar_ = buffer.take< real_t >( is_complex ? 0 : n );
+    real_t* alphai_ = buffer.take< real_t >( is_complex ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? 8*n : 0 );
+    lapack_int* bwork_ = buffer.take< lapack_int >( n );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gges(
+        jobvsl_, jobvsr_, sort_,
+        select, n_,
+        A, lda_,
+        B, ldb_, &sdim_,
+        alpha, alphar_, alphai_,
+        beta,
+        VSL, ldvsl_,
+        VSR, ldvsr_,
+        work_, lwork_,
+        rwork_,
+        bwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *sdim = sdim_;
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            alpha[i] = complex_t( alphar_[i], alphai_[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_s_select3 select, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VSL, int64_t ldvsl,
+    float* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_d_select3 select, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VSL, int64_t ldvsl,
+    double* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_c_select2 select, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, int64_t ldvsl,
+    std::complex<float>* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void gges_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_z_select2 select, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, int64_t ldvsl,
+    std::complex<double>* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_s_select3 select, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VSL, int64_t ldvsl,
+    float* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
+template
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_d_select3 select, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VSL, int64_t ldvsl,
+    double* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
+template
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_c_select2 select, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, int64_t ldvsl,
+    std::complex<float>* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
+template
+int64_t gges(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_z_select2 select, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, int64_t ldvsl,
+    std::complex<double>* VSR, int64_t ldvsr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -37,6 +38,11 @@ int64_t ggesx(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggesx", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -50,8 +56,8 @@ int64_t ggesx(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > alphar( max( 1, n ) );
-    lapack::vector< float > alphai( max( 1, n ) );
+    lapack::small_vector< float > alphar( max( 1, n ) );
+    lapack::small_vector< float > alphai( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -84,9 +90,9 @@ int64_t ggesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_sggesx(
         &jobvsl_, &jobvsr_, &sort_,
@@ -140,6 +146,11 @@ int64_t ggesx(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggesx", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -153,8 +164,8 @@ int64_t ggesx(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > alphar( max( 1, n ) );
-    lapack::vector< double > alphai( max( 1, n ) );
+    lapack::small_vector< double > alphar( max( 1, n ) );
+    lapack::small_vector< double > alphai( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -187,9 +198,9 @@ int64_t ggesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_dggesx(
         &jobvsl_, &jobvsr_, &sort_,
@@ -243,6 +254,11 @@ int64_t ggesx(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggesx", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -287,10 +303,10 @@ int64_t ggesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (8*n) );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (8*n) );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_cggesx(
         &jobvsl_, &jobvsr_, &sort_,
@@ -340,6 +356,11 @@ int64_t ggesx(
         lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggesx", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvsl_ = job2char( jobvsl );
     char jobvsr_ = job2char( jobvsr );
     char sort_ = sort2char( sort );
@@ -384,10 +405,10 @@ int64_t ggesx(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (8*n) );
-    lapack::vector< lapack_int > iwork( liwork_ );
-    lapack::vector< lapack_int > bwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (8*n) );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< lapack_int > bwork( (n) );
 
     LAPACK_zggesx(
         &jobvsl_, &jobvsr_, &sort_,
@@ -415,4 +436,484 @@ int64_t ggesx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions use split-complex alphar and alphai instead of alpha,
+// and don't reference rwork; complex precisions use alpha, and don't
+// reference alphar or alphai.
+static void fortran_ggesx(
+    char jobvsl, char jobvsr, char sort,
+    lapack_s_select3 select, char sense, lapack_int n,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    float* beta,
+    float* VSL, lapack_int ldvsl,
+    float* VSR, lapack_int ldvsr,
+    float* rconde, float* rcondv,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_sggesx(
+        &jobvsl, &jobvsr, &sort,
+        select, &sense, &n,
+        A, &lda,
+        B, &ldb, sdim,
+        alphar,
+        alphai,
+        beta,
+        VSL, &ldvsl,
+        VSR, &ldvsr,
+        rconde,
+        rcondv,
+        work, &lwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggesx(
+    char jobvsl, char jobvsr, char sort,
+    lapack_d_select3 select, char sense, lapack_int n,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    double* beta,
+    double* VSL, lapack_int ldvsl,
+    double* VSR, lapack_int ldvsr,
+    double* rconde, double* rcondv,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_dggesx(
+        &jobvsl, &jobvsr, &sort,
+        select, &sense, &n,
+        A, &lda,
+        B, &ldb, sdim,
+        alphar,
+        alphai,
+        beta,
+        VSL, &ldvsl,
+        VSR, &ldvsr,
+        rconde,
+        rcondv,
+        work, &lwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggesx(
+    char jobvsl, char jobvsr, char sort,
+    lapack_c_select2 select, char sense, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, lapack_int ldvsl,
+    std::complex<float>* VSR, lapack_int ldvsr,
+    float* rconde, float* rcondv,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_cggesx(
+        &jobvsl, &jobvsr, &sort,
+        (LAPACK_C_SELECT2) select, &sense, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, sdim,
+        (lapack_complex_float*) alpha,
+        (lapack_complex_float*) beta,
+        (lapack_complex_float*) VSL, &ldvsl,
+        (lapack_complex_float*) VSR, &ldvsr,
+        rconde,
+        rcondv,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggesx(
+    char jobvsl, char jobvsr, char sort,
+    lapack_z_select2 select, char sense, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    lapack_int* sdim,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, lapack_int ldvsl,
+    std::complex<double>* VSR, lapack_int ldvsr,
+    double* rconde, double* rcondv,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int liwork,
+    lapack_int* bwork, lapack_int* info )
+{
+    LAPACK_zggesx(
+        &jobvsl, &jobvsr, &sort,
+        (LAPACK_Z_SELECT2) select, &sense, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, sdim,
+        (lapack_complex_double*) alpha,
+        (lapack_complex_double*) beta,
+        (lapack_complex_double*) VSL, &ldvsl,
+        (lapack_complex_double*) VSR, &ldvsr,
+        rconde,
+        rcondv,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork, &liwork,
+        bwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggesx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvsl_ = job2char( jobvsl );
+    char jobvsr_ = job2char( jobvsr );
+    char sort_ = sort2char( sort );
+    char sense_ = sense2char( sense );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int sdim_ = 0;
+    lapack_int ldvsl_ = (lapack_int) ldvsl;
+    lapack_int ldvsr_ = (lapack_int) ldvsr;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    real_t rconde_[2], rcondv_[2];
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    real_t qry_alphar[1], qry_alphai[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_ggesx(
+        jobvsl_, jobvsr_, sort_,
+        select, sense_, n_,
+        A, lda_,
+        B, ldb_, &sdim_,
+        alpha, qry_alphar, qry_alphai,
+        beta,
+        VSL, ldvsl_,
+        VSR, ldvsr_,
+        rconde_, rcondv_,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, ineg_one,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int liwork_ = qry_iwork[0];
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : n );  // alphar
+    buffer.take< real_t >( is_complex ? 0 : n );  // alphai
+    buffer.take< real_t >( is_complex ? 8*n : 0 );  // rwork
+    buffer.take< lapack_int >( n );  // bwork
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggesx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggesx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggesx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    typename internal::gges_select< scalar_t >::type select,
+    lapack::Sense sense, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    blas::real_type<scalar_t>* rconde,
+    blas::real_type<scalar_t>* rcondv,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvsr) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggesx", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvsl_ = job2char( jobvsl );
+    char jobvsr_ = job2char( jobvsr );
+    char sort_ = sort2char( sort );
+    char sense_ = sense2char( sense );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int sdim_ = (lapack_int) *sdim;
+    lapack_int ldvsl_ = (lapack_int) ldvsl;
+    lapack_int ldvsr_ = (lapack_int) ldvsr;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* alphar_ = buffer.take< real_t >( is_complex ? 0 : n );
+    real_t* alphai_ = buffer.take< real_t >( is_complex ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? 8*n : 0 );
+    lapack_int* bwork_ = buffer.take< lapack_int >( n );
+
+    // query for size of iwork
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    real_t qry_alphar[1], qry_alphai[1];
+    lapack_int qry_bwork[1];
+    lapack_int ineg_one = -1;
+    fortran_ggesx(
+        jobvsl_, jobvsr_, sort_,
+        select, sense_, n_,
+        A, lda_,
+        B, ldb_, &sdim_,
+        alpha, qry_alphar, qry_alphai,
+        beta,
+        VSL, ldvsl_,
+        VSR, ldvsr_,
+        rconde, rcondv,
+        qry_work, ineg_one,
+        qry_rwork,
+        qry_iwork, ineg_one,
+        qry_bwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int liwork_ = qry_iwork[0];
+
+    // work gets the rest
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggesx(
+        jobvsl_, jobvsr_, sort_,
+        select, sense_, n_,
+        A, lda_,
+        B, ldb_, &sdim_,
+        alpha, alphar_, alphai_,
+        beta,
+        VSL, ldvsl_,
+        VSR, ldvsr_,
+        rconde, rcondv,
+        work_, lwork_,
+        rwork_,
+        iwork_, liwork_,
+        bwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *sdim = sdim_;
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            alpha[i] = complex_t( alphar_[i], alphai_[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_s_select3 select,
+    lapack::Sense sense, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VSL, int64_t ldvsl,
+    float* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_d_select3 select,
+    lapack::Sense sense, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VSL, int64_t ldvsl,
+    double* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_c_select2 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, int64_t ldvsl,
+    std::complex<float>* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+template
+void ggesx_work_size_bytes(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_z_select2 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, int64_t ldvsl,
+    std::complex<double>* VSR, int64_t ldvsr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_s_select3 select,
+    lapack::Sense sense, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VSL, int64_t ldvsl,
+    float* VSR, int64_t ldvsr,
+    float* rconde,
+    float* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_d_select3 select,
+    lapack::Sense sense, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VSL, int64_t ldvsl,
+    double* VSR, int64_t ldvsr,
+    double* rconde,
+    double* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_c_select2 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VSL, int64_t ldvsl,
+    std::complex<float>* VSR, int64_t ldvsr,
+    float* rconde,
+    float* rcondv,
+    void* work, size_t work_size );
+
+template
+int64_t ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    lapack_z_select2 select,
+    lapack::Sense sense, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    int64_t* sdim,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VSL, int64_t ldvsl,
+    std::complex<double>* VSR, int64_t ldvsr,
+    double* rconde,
+    double* rcondv,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30600  // >= v3.6
 
@@ -35,6 +36,11 @@ int64_t ggev3(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggev3", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -45,8 +51,8 @@ int64_t ggev3(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > alphar( max( 1, n ) );
-    lapack::vector< float > alphai( max( 1, n ) );
+    lapack::small_vector< float > alphar( max( 1, n ) );
+    lapack::small_vector< float > alphai( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -70,7 +76,7 @@ int64_t ggev3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sggev3(
         &jobvl_, &jobvr_, &n_,
@@ -113,6 +119,11 @@ int64_t ggev3(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggev3", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -123,8 +134,8 @@ int64_t ggev3(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > alphar( max( 1, n ) );
-    lapack::vector< double > alphai( max( 1, n ) );
+    lapack::small_vector< double > alphar( max( 1, n ) );
+    lapack::small_vector< double > alphai( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -148,7 +159,7 @@ int64_t ggev3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dggev3(
         &jobvl_, &jobvr_, &n_,
@@ -191,6 +202,11 @@ int64_t ggev3(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggev3", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -224,8 +240,8 @@ int64_t ggev3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (8*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (8*n) );
 
     LAPACK_cggev3(
         &jobvl_, &jobvr_, &n_,
@@ -265,6 +281,11 @@ int64_t ggev3(
         lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggev3", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobvl_ = job2char( jobvl );
     char jobvr_ = job2char( jobvr );
     lapack_int n_ = (lapack_int) n;
@@ -298,8 +319,8 @@ int64_t ggev3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (8*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (8*n) );
 
     LAPACK_zggev3(
         &jobvl_, &jobvr_, &n_,
@@ -321,6 +342,358 @@ int64_t ggev3(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (alphar, alphai)
+// and don't reference alpha or rwork; complex precisions return alpha
+// directly and don't reference alphar or alphai.
+static void fortran_ggev3(
+    char jobvl, char jobvr, lapack_int n,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    float* beta,
+    float* VL, lapack_int ldvl,
+    float* VR, lapack_int ldvr,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sggev3(
+        &jobvl, &jobvr, &n,
+        A, &lda,
+        B, &ldb,
+        alphar, alphai,
+        beta,
+        VL, &ldvl,
+        VR, &ldvr,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggev3(
+    char jobvl, char jobvr, lapack_int n,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    double* beta,
+    double* VL, lapack_int ldvl,
+    double* VR, lapack_int ldvr,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dggev3(
+        &jobvl, &jobvr, &n,
+        A, &lda,
+        B, &ldb,
+        alphar, alphai,
+        beta,
+        VL, &ldvl,
+        VR, &ldvr,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggev3(
+    char jobvl, char jobvr, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    std::complex<float>* beta,
+    std::complex<float>* VL, lapack_int ldvl,
+    std::complex<float>* VR, lapack_int ldvr,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cggev3(
+        &jobvl, &jobvr, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) alpha,
+        (lapack_complex_float*) beta,
+        (lapack_complex_float*) VL, &ldvl,
+        (lapack_complex_float*) VR, &ldvr,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggev3(
+    char jobvl, char jobvr, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    std::complex<double>* beta,
+    std::complex<double>* VL, lapack_int ldvl,
+    std::complex<double>* VR, lapack_int ldvr,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zggev3(
+        &jobvl, &jobvr, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) alpha,
+        (lapack_complex_double*) beta,
+        (lapack_complex_double*) VL, &ldvl,
+        (lapack_complex_double*) VR, &ldvr,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggev3 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    real_t qry_alphar[1], qry_alphai[1];
+    lapack_int ineg_one = -1;
+    fortran_ggev3(
+        jobvl_, jobvr_, n_,
+        A, lda_,
+        B, ldb_,
+        alpha, qry_alphar, qry_alphai,
+        beta,
+        VL, ldvl_,
+        VR, ldvr_,
+        qry_work, ineg_one,
+        qry_rwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // alphar
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // alphai
+    buffer.take< real_t >( is_complex ? 8*n : 0 );  // rwork
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggev3, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggev3 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggev3_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggev3", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* alphar_ = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* alphai_ = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? 8*n : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggev3(
+        jobvl_, jobvr_, n_,
+        A, lda_,
+        B, ldb_,
+        alpha, alphar_, alphai_,
+        beta,
+        VL, ldvl_,
+        VR, ldvr_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            alpha[i] = complex_t( alphar_[i], alphai_[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    size_t* work_size );
+
+template
+void ggev3_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    std::complex<float>* alpha,
+    float* beta,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    std::complex<double>* alpha,
+    double* beta,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
+template
+int64_t ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= v3.6
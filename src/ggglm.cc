@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -33,6 +34,11 @@ int64_t ggglm(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggglm", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -57,7 +63,7 @@ int64_t ggglm(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sggglm(
         &n_, &m_, &p_,
@@ -91,6 +97,11 @@ int64_t ggglm(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggglm", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -115,7 +126,7 @@ int64_t ggglm(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dggglm(
         &n_, &m_, &p_,
@@ -149,6 +160,11 @@ int64_t ggglm(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggglm", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -173,7 +189,7 @@ int64_t ggglm(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cggglm(
         &n_, &m_, &p_,
@@ -291,6 +307,11 @@ int64_t ggglm(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggglm", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -315,7 +336,7 @@ int64_t ggglm(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zggglm(
         &n_, &m_, &p_,
@@ -331,4 +352,284 @@ int64_t ggglm(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ggglm(
+    lapack_int n, lapack_int m, lapack_int p,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* D,
+    float* X,
+    float* Y,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sggglm(
+        &n, &m, &p,
+        A, &lda,
+        B, &ldb,
+        D,
+        X,
+        Y,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_ggglm(
+    lapack_int n, lapack_int m, lapack_int p,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* D,
+    double* X,
+    double* Y,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dggglm(
+        &n, &m, &p,
+        A, &lda,
+        B, &ldb,
+        D,
+        X,
+        Y,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_ggglm(
+    lapack_int n, lapack_int m, lapack_int p,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    std::complex<float>* Y,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cggglm(
+        &n, &m, &p,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) D,
+        (lapack_complex_float*) X,
+        (lapack_complex_float*) Y,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_ggglm(
+    lapack_int n, lapack_int m, lapack_int p,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    std::complex<double>* Y,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zggglm(
+        &n, &m, &p,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) D,
+        (lapack_complex_double*) X,
+        (lapack_complex_double*) Y,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggglm with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* D,
+    scalar_t* X,
+    scalar_t* Y,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_ggglm(
+        n_, m_, p_,
+        A, lda_,
+        B, ldb_,
+        D,
+        X,
+        Y,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggglm, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggglm for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggglm_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* D,
+    scalar_t* X,
+    scalar_t* Y,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggglm", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggglm(
+        n_, m_, p_,
+        A, lda_,
+        B, ldb_,
+        D,
+        X,
+        Y,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* D,
+    float* X,
+    float* Y,
+    size_t* work_size );
+
+template
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* D,
+    double* X,
+    double* Y,
+    size_t* work_size );
+
+template
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    std::complex<float>* Y,
+    size_t* work_size );
+
+template
+void ggglm_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    std::complex<double>* Y,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* D,
+    float* X,
+    float* Y,
+    void* work, size_t work_size );
+
+template
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* D,
+    double* X,
+    double* Y,
+    void* work, size_t work_size );
+
+template
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    std::complex<float>* Y,
+    void* work, size_t work_size );
+
+template
+int64_t ggglm(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    std::complex<double>* Y,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -32,6 +32,11 @@ int64_t gghrd(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gghrd", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -77,6 +82,11 @@ int64_t gghrd(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gghrd", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -122,6 +132,11 @@ int64_t gghrd(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gghrd", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -167,6 +182,11 @@ int64_t gghrd(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gghrd", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -33,6 +34,11 @@ int64_t gglse(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gglse", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int p_ = (lapack_int) p;
@@ -57,7 +63,7 @@ int64_t gglse(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sgglse(
         &m_, &n_, &p_,
@@ -91,6 +97,11 @@ int64_t gglse(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gglse", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int p_ = (lapack_int) p;
@@ -115,7 +126,7 @@ int64_t gglse(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dgglse(
         &m_, &n_, &p_,
@@ -149,6 +160,11 @@ int64_t gglse(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gglse", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int p_ = (lapack_int) p;
@@ -173,7 +189,7 @@ int64_t gglse(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgglse(
         &m_, &n_, &p_,
@@ -298,6 +314,11 @@ int64_t gglse(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gglse", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int p_ = (lapack_int) p;
@@ -322,7 +343,7 @@ int64_t gglse(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgglse(
         &m_, &n_, &p_,
@@ -338,4 +359,284 @@ int64_t gglse(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gglse(
+    lapack_int m, lapack_int n, lapack_int p,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* C,
+    float* D,
+    float* X,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgglse(
+        &m, &n, &p,
+        A, &lda,
+        B, &ldb,
+        C,
+        D,
+        X,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gglse(
+    lapack_int m, lapack_int n, lapack_int p,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* C,
+    double* D,
+    double* X,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgglse(
+        &m, &n, &p,
+        A, &lda,
+        B, &ldb,
+        C,
+        D,
+        X,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_gglse(
+    lapack_int m, lapack_int n, lapack_int p,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* C,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgglse(
+        &m, &n, &p,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) C,
+        (lapack_complex_float*) D,
+        (lapack_complex_float*) X,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_gglse(
+    lapack_int m, lapack_int n, lapack_int p,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* C,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgglse(
+        &m, &n, &p,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) C,
+        (lapack_complex_double*) D,
+        (lapack_complex_double*) X,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gglse with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* C,
+    scalar_t* D,
+    scalar_t* X,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_gglse(
+        m_, n_, p_,
+        A, lda_,
+        B, ldb_,
+        C,
+        D,
+        X,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gglse, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gglse for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gglse_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* C,
+    scalar_t* D,
+    scalar_t* X,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gglse", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_gglse(
+        m_, n_, p_,
+        A, lda_,
+        B, ldb_,
+        C,
+        D,
+        X,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* C,
+    float* D,
+    float* X,
+    size_t* work_size );
+
+template
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* C,
+    double* D,
+    double* X,
+    size_t* work_size );
+
+template
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* C,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    size_t* work_size );
+
+template
+void gglse_work_size_bytes(
+    int64_t m, int64_t n, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* C,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* C,
+    float* D,
+    float* X,
+    void* work, size_t work_size );
+
+template
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* C,
+    double* D,
+    double* X,
+    void* work, size_t work_size );
+
+template
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* C,
+    std::complex<float>* D,
+    std::complex<float>* X,
+    void* work, size_t work_size );
+
+template
+int64_t gglse(
+    int64_t m, int64_t n, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* C,
+    std::complex<double>* D,
+    std::complex<double>* X,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t ggqrf(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggqrf", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -54,7 +60,7 @@ int64_t ggqrf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sggqrf(
         &n_, &m_, &p_,
@@ -85,6 +91,11 @@ int64_t ggqrf(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggqrf", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -108,7 +119,7 @@ int64_t ggqrf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dggqrf(
         &n_, &m_, &p_,
@@ -139,6 +150,11 @@ int64_t ggqrf(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggqrf", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -162,7 +178,7 @@ int64_t ggqrf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cggqrf(
         &n_, &m_, &p_,
@@ -193,6 +209,11 @@ int64_t ggqrf(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggqrf", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     lapack_int p_ = (lapack_int) p;
@@ -216,7 +237,7 @@ int64_t ggqrf(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zggqrf(
         &n_, &m_, &p_,
@@ -231,4 +252,264 @@ int64_t ggqrf(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ggqrf(
+    lapack_int n, lapack_int m, lapack_int p,
+    float* A, lapack_int lda,
+    float* taua,
+    float* B, lapack_int ldb,
+    float* taub,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sggqrf(
+        &n, &m, &p,
+        A, &lda,
+        taua,
+        B, &ldb,
+        taub,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_ggqrf(
+    lapack_int n, lapack_int m, lapack_int p,
+    double* A, lapack_int lda,
+    double* taua,
+    double* B, lapack_int ldb,
+    double* taub,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dggqrf(
+        &n, &m, &p,
+        A, &lda,
+        taua,
+        B, &ldb,
+        taub,
+        work, &lwork, info );
+}
+
+//----------
+static void fortran_ggqrf(
+    lapack_int n, lapack_int m, lapack_int p,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* taua,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* taub,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cggqrf(
+        &n, &m, &p,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) taua,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) taub,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+//----------
+static void fortran_ggqrf(
+    lapack_int n, lapack_int m, lapack_int p,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* taua,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* taub,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zggqrf(
+        &n, &m, &p,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) taua,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) taub,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggqrf with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_ggqrf(
+        n_, m_, p_,
+        A, lda_,
+        taua,
+        B, ldb_,
+        taub,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggqrf, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggqrf for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggqrf_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggqrf", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggqrf(
+        n_, m_, p_,
+        A, lda_,
+        taua,
+        B, ldb_,
+        taub,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    float* A, int64_t lda,
+    float* taua,
+    float* B, int64_t ldb,
+    float* taub,
+    size_t* work_size );
+
+template
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    double* A, int64_t lda,
+    double* taua,
+    double* B, int64_t ldb,
+    double* taub,
+    size_t* work_size );
+
+template
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* taua,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* taub,
+    size_t* work_size );
+
+template
+void ggqrf_work_size_bytes(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* taua,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* taub,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    float* A, int64_t lda,
+    float* taua,
+    float* B, int64_t ldb,
+    float* taub,
+    void* work, size_t work_size );
+
+template
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    double* A, int64_t lda,
+    double* taua,
+    double* B, int64_t ldb,
+    double* taub,
+    void* work, size_t work_size );
+
+template
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* taua,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* taub,
+    void* work, size_t work_size );
+
+template
+int64_t ggqrf(
+    int64_t n, int64_t m, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* taua,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* taub,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30600  // >= 3.6
 
@@ -41,6 +42,11 @@ int64_t ggsvd3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvd3", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -81,8 +87,8 @@ int64_t ggsvd3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sggsvd3(
         &jobu_, &jobv_, &jobq_, &m_, &n_, &p_, &k_, &l_,
@@ -131,6 +137,11 @@ int64_t ggsvd3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvd3", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -171,8 +182,8 @@ int64_t ggsvd3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dggsvd3(
         &jobu_, &jobv_, &jobq_, &m_, &n_, &p_, &k_, &l_,
@@ -221,6 +232,11 @@ int64_t ggsvd3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvd3", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -263,9 +279,9 @@ int64_t ggsvd3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (2*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (2*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_cggsvd3(
         &jobu_, &jobv_, &jobq_, &m_, &n_, &p_, &k_, &l_,
@@ -315,6 +331,11 @@ int64_t ggsvd3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvd3", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -357,9 +378,9 @@ int64_t ggsvd3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (2*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (2*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_zggsvd3(
         &jobu_, &jobv_, &jobq_, &m_, &n_, &p_, &k_, &l_,
@@ -385,6 +406,412 @@ int64_t ggsvd3(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ggsvd3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int n, lapack_int p, lapack_int* k, lapack_int* l,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* alpha,
+    float* beta,
+    float* U, lapack_int ldu,
+    float* V, lapack_int ldv,
+    float* Q, lapack_int ldq,
+    float* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sggsvd3(
+        &jobu, &jobv, &jobq, &m, &n, &p, k, l,
+        A, &lda,
+        B, &ldb,
+        alpha,
+        beta,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvd3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int n, lapack_int p, lapack_int* k, lapack_int* l,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* alpha,
+    double* beta,
+    double* U, lapack_int ldu,
+    double* V, lapack_int ldv,
+    double* Q, lapack_int ldq,
+    double* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dggsvd3(
+        &jobu, &jobv, &jobq, &m, &n, &p, k, l,
+        A, &lda,
+        B, &ldb,
+        alpha,
+        beta,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvd3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int n, lapack_int p, lapack_int* k, lapack_int* l,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* V, lapack_int ldv,
+    std::complex<float>* Q, lapack_int ldq,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_cggsvd3(
+        &jobu, &jobv, &jobq, &m, &n, &p, k, l,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        alpha,
+        beta,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) V, &ldv,
+        (lapack_complex_float*) Q, &ldq,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvd3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int n, lapack_int p, lapack_int* k, lapack_int* l,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* V, lapack_int ldv,
+    std::complex<double>* Q, lapack_int ldq,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_zggsvd3(
+        &jobu, &jobv, &jobq, &m, &n, &p, k, l,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        alpha,
+        beta,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) V, &ldv,
+        (lapack_complex_double*) Q, &ldq,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggsvd3 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = jobu2char( jobu );
+    char jobv_ = job2char( jobv );
+    char jobq_ = jobq2char( jobq );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int k_ = 0;
+    lapack_int l_ = 0;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_ggsvd3(
+        jobu_, jobv_, jobq_, m_, n_, p_, &k_, &l_,
+        A, lda_,
+        B, ldb_,
+        alpha,
+        beta,
+        U, ldu_,
+        V, ldv_,
+        Q, ldq_,
+        qry_work, ineg_one,
+        nullptr,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    buffer.take< lapack_int >( n );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggsvd3, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggsvd3 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggsvd3_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggsvd3", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char jobu_ = jobu2char( jobu );
+    char jobv_ = job2char( jobv );
+    char jobq_ = jobq2char( jobq );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int k_ = (lapack_int) *k;
+    lapack_int l_ = (lapack_int) *l;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    lapack_int* iwork_ = buffer.take< lapack_int >( n );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggsvd3(
+        jobu_, jobv_, jobq_, m_, n_, p_, &k_, &l_,
+        A, lda_,
+        B, ldb_,
+        alpha,
+        beta,
+        U, ldu_,
+        V, ldv_,
+        Q, ldq_,
+        work_, lwork_,
+        rwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *k = k_;
+    *l = l_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* alpha,
+    float* beta,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* alpha,
+    double* beta,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void ggsvd3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* alpha,
+    float* beta,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* alpha,
+    double* beta,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvd3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t n, int64_t p,
+    int64_t* k,
+    int64_t* l,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.6
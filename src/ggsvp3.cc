@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30600  // >= v3.6
 
@@ -40,6 +41,11 @@ int64_t ggsvp3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvp3", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -79,8 +85,8 @@ int64_t ggsvp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< lapack_int > iwork( (n) );
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sggsvp3(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_,
@@ -127,6 +133,11 @@ int64_t ggsvp3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvp3", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -166,8 +177,8 @@ int64_t ggsvp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< lapack_int > iwork( (n) );
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dggsvp3(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_,
@@ -214,6 +225,11 @@ int64_t ggsvp3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvp3", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -255,9 +271,9 @@ int64_t ggsvp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< lapack_int > iwork( (n) );
-    lapack::vector< float > rwork( (2*n) );
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cggsvp3(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_,
@@ -305,6 +321,11 @@ int64_t ggsvp3(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ggsvp3", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char jobu_ = jobu2char( jobu );
     char jobv_ = job2char( jobv );
     char jobq_ = jobq2char( jobq );
@@ -346,9 +367,9 @@ int64_t ggsvp3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< lapack_int > iwork( (n) );
-    lapack::vector< double > rwork( (2*n) );
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zggsvp3(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_,
@@ -373,6 +394,402 @@ int64_t ggsvp3(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ggsvp3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb, float tola, float tolb, lapack_int* k, lapack_int* l,
+    float* U, lapack_int ldu,
+    float* V, lapack_int ldv,
+    float* Q, lapack_int ldq,
+    lapack_int* iwork,
+    float* rwork,
+    float* tau,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sggsvp3(
+        &jobu, &jobv, &jobq, &m, &p, &n,
+        A, &lda,
+        B, &ldb, &tola, &tolb, k, l,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        iwork,
+        tau,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvp3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb, double tola, double tolb, lapack_int* k, lapack_int* l,
+    double* U, lapack_int ldu,
+    double* V, lapack_int ldv,
+    double* Q, lapack_int ldq,
+    lapack_int* iwork,
+    double* rwork,
+    double* tau,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dggsvp3(
+        &jobu, &jobv, &jobq, &m, &p, &n,
+        A, &lda,
+        B, &ldb, &tola, &tolb, k, l,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        iwork,
+        tau,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvp3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb, float tola, float tolb, lapack_int* k, lapack_int* l,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* V, lapack_int ldv,
+    std::complex<float>* Q, lapack_int ldq,
+    lapack_int* iwork,
+    float* rwork,
+    std::complex<float>* tau,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cggsvp3(
+        &jobu, &jobv, &jobq, &m, &p, &n,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, &tola, &tolb, k, l,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) V, &ldv,
+        (lapack_complex_float*) Q, &ldq,
+        iwork,
+        rwork,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ggsvp3(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb, double tola, double tolb, lapack_int* k, lapack_int* l,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* V, lapack_int ldv,
+    std::complex<double>* Q, lapack_int ldq,
+    lapack_int* iwork,
+    double* rwork,
+    std::complex<double>* tau,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zggsvp3(
+        &jobu, &jobv, &jobq, &m, &p, &n,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, &tola, &tolb, k, l,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) V, &ldv,
+        (lapack_complex_double*) Q, &ldq,
+        iwork,
+        rwork,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ggsvp3 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* tau,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = jobu2char( jobu );
+    char jobv_ = job2char( jobv );
+    char jobq_ = jobq2char( jobq );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int k_ = 0;
+    lapack_int l_ = 0;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_ggsvp3(
+        jobu_, jobv_, jobq_, m_, p_, n_,
+        A, lda_,
+        B, ldb_, tola, tolb, &k_, &l_,
+        U, ldu_,
+        V, ldv_,
+        Q, ldq_,
+        nullptr,
+        nullptr,
+        tau,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_int >( n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ggsvp3, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ggsvp3 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ggsvp3_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    int64_t* k,
+    int64_t* l,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* tau,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ggsvp3", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char jobu_ = jobu2char( jobu );
+    char jobv_ = job2char( jobv );
+    char jobq_ = jobq2char( jobq );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int k_ = (lapack_int) *k;
+    lapack_int l_ = (lapack_int) *l;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int* iwork_ = buffer.take< lapack_int >( n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 2*n : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ggsvp3(
+        jobu_, jobv_, jobq_, m_, p_, n_,
+        A, lda_,
+        B, ldb_, tola, tolb, &k_, &l_,
+        U, ldu_,
+        V, ldv_,
+        Q, ldq_,
+        iwork_,
+        rwork_,
+        tau,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *k = k_;
+    *l = l_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float tola,
+    float tolb,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    float* tau,
+    size_t* work_size );
+
+template
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double tola,
+    double tolb,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    double* tau,
+    size_t* work_size );
+
+template
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb, float tola,
+    float tolb,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* tau,
+    size_t* work_size );
+
+template
+void ggsvp3_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb, double tola,
+    double tolb,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* tau,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float tola,
+    float tolb,
+    int64_t* k,
+    int64_t* l,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    float* tau,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double tola,
+    double tolb,
+    int64_t* k,
+    int64_t* l,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    double* tau,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb, float tola,
+    float tolb,
+    int64_t* k,
+    int64_t* l,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* tau,
+    void* work, size_t work_size );
+
+template
+int64_t ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb, double tola,
+    double tolb,
+    int64_t* k,
+    int64_t* l,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* tau,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= v3.6
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -30,11 +31,16 @@ int64_t gtcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtcon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -42,8 +48,8 @@ int64_t gtcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (2*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgtcon(
         &norm_, &n_,
@@ -79,11 +85,16 @@ int64_t gtcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtcon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -91,8 +102,8 @@ int64_t gtcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (2*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgtcon(
         &norm_, &n_,
@@ -128,11 +139,16 @@ int64_t gtcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -140,7 +156,7 @@ int64_t gtcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_cgtcon(
         &norm_, &n_,
@@ -231,11 +247,16 @@ int64_t gtcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -243,7 +264,7 @@ int64_t gtcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_zgtcon(
         &norm_, &n_,
@@ -263,4 +284,285 @@ int64_t gtcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gtcon(
+    char norm, lapack_int n,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DU2,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sgtcon(
+        &norm, &n,
+        DL,
+        D,
+        DU,
+        DU2,
+        ipiv, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtcon(
+    char norm, lapack_int n,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DU2,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dgtcon(
+        &norm, &n,
+        DL,
+        D,
+        DU,
+        DU2,
+        ipiv, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtcon(
+    char norm, lapack_int n,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DU2,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_cgtcon(
+        &norm, &n,
+        (lapack_complex_float const*) DL,
+        (lapack_complex_float const*) D,
+        (lapack_complex_float const*) DU,
+        (lapack_complex_float const*) DU2,
+        ipiv, &anorm, rcond,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtcon(
+    char norm, lapack_int n,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DU2,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_zgtcon(
+        &norm, &n,
+        (lapack_complex_double const*) DL,
+        (lapack_complex_double const*) D,
+        (lapack_complex_double const*) DU,
+        (lapack_complex_double const*) DU2,
+        ipiv, &anorm, rcond,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gtcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DU2, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( 2*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gtcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gtcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gtcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DU2,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gtcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+
+    fortran_gtcon(
+        norm_, n_,
+        DL,
+        D,
+        DU,
+        DU2,
+        ipiv_ptr, anorm, rcond,
+        work_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DU2, float anorm,
+    size_t* work_size );
+
+template
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DU2, double anorm,
+    size_t* work_size );
+
+template
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DU2, float anorm,
+    size_t* work_size );
+
+template
+void gtcon_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DU2, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DU2,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DU2,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DU2,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t gtcon(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DU2,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
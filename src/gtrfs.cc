@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -39,12 +40,17 @@ int64_t gtrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtrfs", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -54,8 +60,8 @@ int64_t gtrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgtrfs(
         &trans_, &n_, &nrhs_,
@@ -107,12 +113,17 @@ int64_t gtrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtrfs", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -122,8 +133,8 @@ int64_t gtrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgtrfs(
         &trans_, &n_, &nrhs_,
@@ -175,12 +186,17 @@ int64_t gtrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtrfs", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -190,8 +206,8 @@ int64_t gtrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cgtrfs(
         &trans_, &n_, &nrhs_,
@@ -334,12 +350,17 @@ int64_t gtrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtrfs", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -349,8 +370,8 @@ int64_t gtrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zgtrfs(
         &trans_, &n_, &nrhs_,
@@ -378,4 +399,435 @@ int64_t gtrfs(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gtrfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DLF,
+    float const* DF,
+    float const* DUF,
+    float const* DU2,
+    lapack_int const* ipiv,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgtrfs(
+        &trans, &n, &nrhs,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtrfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DLF,
+    double const* DF,
+    double const* DUF,
+    double const* DU2,
+    lapack_int const* ipiv,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgtrfs(
+        &trans, &n, &nrhs,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtrfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DLF,
+    std::complex<float> const* DF,
+    std::complex<float> const* DUF,
+    std::complex<float> const* DU2,
+    lapack_int const* ipiv,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgtrfs(
+        &trans, &n, &nrhs,
+        (lapack_complex_float const*) DL,
+        (lapack_complex_float const*) D,
+        (lapack_complex_float const*) DU,
+        (lapack_complex_float const*) DLF,
+        (lapack_complex_float const*) DF,
+        (lapack_complex_float const*) DUF,
+        (lapack_complex_float const*) DU2,
+        ipiv,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtrfs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DLF,
+    std::complex<double> const* DF,
+    std::complex<double> const* DUF,
+    std::complex<double> const* DU2,
+    lapack_int const* ipiv,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgtrfs(
+        &trans, &n, &nrhs,
+        (lapack_complex_double const*) DL,
+        (lapack_complex_double const*) D,
+        (lapack_complex_double const*) DU,
+        (lapack_complex_double const*) DLF,
+        (lapack_complex_double const*) DF,
+        (lapack_complex_double const*) DUF,
+        (lapack_complex_double const*) DU2,
+        ipiv,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gtrfs with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DLF,
+    scalar_t const* DF,
+    scalar_t const* DUF,
+    scalar_t const* DU2,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gtrfs, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gtrfs for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gtrfs_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t const* DLF,
+    scalar_t const* DF,
+    scalar_t const* DUF,
+    scalar_t const* DU2,
+    int64_t const* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gtrfs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_gtrfs(
+        trans_, n_, nrhs_,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv_ptr,
+        B, ldb_,
+        X, ldx_,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DLF,
+    float const* DF,
+    float const* DUF,
+    float const* DU2,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DLF,
+    double const* DF,
+    double const* DUF,
+    double const* DU2,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DLF,
+    std::complex<float> const* DF,
+    std::complex<float> const* DUF,
+    std::complex<float> const* DU2,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gtrfs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DLF,
+    std::complex<double> const* DF,
+    std::complex<double> const* DUF,
+    std::complex<double> const* DU2,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float const* DLF,
+    float const* DF,
+    float const* DUF,
+    float const* DU2,
+    int64_t const* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double const* DLF,
+    double const* DF,
+    double const* DUF,
+    double const* DU2,
+    int64_t const* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float> const* DLF,
+    std::complex<float> const* DF,
+    std::complex<float> const* DUF,
+    std::complex<float> const* DU2,
+    int64_t const* ipiv,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtrfs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double> const* DLF,
+    std::complex<double> const* DF,
+    std::complex<double> const* DUF,
+    std::complex<double> const* DU2,
+    int64_t const* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -40,13 +41,18 @@ int64_t gtsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtsvx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -56,8 +62,8 @@ int64_t gtsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sgtsvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -113,13 +119,18 @@ int64_t gtsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtsvx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -129,8 +140,8 @@ int64_t gtsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dgtsvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -186,13 +197,18 @@ int64_t gtsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtsvx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -202,8 +218,8 @@ int64_t gtsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cgtsvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -415,13 +431,18 @@ int64_t gtsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gtsvx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char trans_ = op2char( trans );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -431,8 +452,8 @@ int64_t gtsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zgtsvx(
         &fact_, &trans_, &n_, &nrhs_,
@@ -463,4 +484,444 @@ int64_t gtsvx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_gtsvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float* DLF,
+    float* DF,
+    float* DUF,
+    float* DU2,
+    lapack_int* ipiv,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sgtsvx(
+        &fact, &trans, &n, &nrhs,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtsvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double* DLF,
+    double* DF,
+    double* DUF,
+    double* DU2,
+    lapack_int* ipiv,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dgtsvx(
+        &fact, &trans, &n, &nrhs,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtsvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float>* DLF,
+    std::complex<float>* DF,
+    std::complex<float>* DUF,
+    std::complex<float>* DU2,
+    lapack_int* ipiv,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cgtsvx(
+        &fact, &trans, &n, &nrhs,
+        (lapack_complex_float const*) DL,
+        (lapack_complex_float const*) D,
+        (lapack_complex_float const*) DU,
+        (lapack_complex_float*) DLF,
+        (lapack_complex_float*) DF,
+        (lapack_complex_float*) DUF,
+        (lapack_complex_float*) DU2,
+        ipiv,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_gtsvx(
+    char fact, char trans, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double>* DLF,
+    std::complex<double>* DF,
+    std::complex<double>* DUF,
+    std::complex<double>* DU2,
+    lapack_int* ipiv,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zgtsvx(
+        &fact, &trans, &n, &nrhs,
+        (lapack_complex_double const*) DL,
+        (lapack_complex_double const*) D,
+        (lapack_complex_double const*) DU,
+        (lapack_complex_double*) DLF,
+        (lapack_complex_double*) DF,
+        (lapack_complex_double*) DUF,
+        (lapack_complex_double*) DU2,
+        ipiv,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by gtsvx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t* DLF,
+    scalar_t* DF,
+    scalar_t* DUF,
+    scalar_t* DU2,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::gtsvx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::gtsvx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     gtsvx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* DL,
+    scalar_t const* D,
+    scalar_t const* DU,
+    scalar_t* DLF,
+    scalar_t* DF,
+    scalar_t* DUF,
+    scalar_t* DU2,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gtsvx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char fact_ = factored2char( fact );
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int* ipiv_ptr = ipiv_;
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_gtsvx(
+        fact_, trans_, n_, nrhs_,
+        DL,
+        D,
+        DU,
+        DLF,
+        DF,
+        DUF,
+        DU2,
+        ipiv_ptr,
+        B, ldb_,
+        X, ldx_, rcond,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_, ipiv_ + n, ipiv );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float* DLF,
+    float* DF,
+    float* DUF,
+    float* DU2,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double* DLF,
+    double* DF,
+    double* DUF,
+    double* DU2,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float>* DLF,
+    std::complex<float>* DF,
+    std::complex<float>* DUF,
+    std::complex<float>* DU2,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void gtsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double>* DLF,
+    std::complex<double>* DF,
+    std::complex<double>* DUF,
+    std::complex<double>* DU2,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* DL,
+    float const* D,
+    float const* DU,
+    float* DLF,
+    float* DF,
+    float* DUF,
+    float* DU2,
+    int64_t* ipiv,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* DL,
+    double const* D,
+    double const* DU,
+    double* DLF,
+    double* DF,
+    double* DUF,
+    double* DU2,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* DL,
+    std::complex<float> const* D,
+    std::complex<float> const* DU,
+    std::complex<float>* DLF,
+    std::complex<float>* DF,
+    std::complex<float>* DUF,
+    std::complex<float>* DU2,
+    int64_t* ipiv,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t gtsvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* DL,
+    std::complex<double> const* D,
+    std::complex<double> const* DU,
+    std::complex<double>* DLF,
+    std::complex<double>* DF,
+    std::complex<double>* DUF,
+    std::complex<double>* DU2,
+    int64_t* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
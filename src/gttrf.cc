@@ -29,10 +29,15 @@ int64_t gttrf(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gttrf", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
+        lapack::small_vector< lapack_int > ipiv_( (n) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -69,10 +74,15 @@ int64_t gttrf(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
+        lapack::small_vector< lapack_int > ipiv_( (n) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -109,10 +119,15 @@ int64_t gttrf(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
+        lapack::small_vector< lapack_int > ipiv_( (n) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -205,10 +220,15 @@ int64_t gttrf(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
+        lapack::small_vector< lapack_int > ipiv_( (n) );
         lapack_int* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int* ipiv_ptr = ipiv;
@@ -231,4 +251,143 @@ int64_t gttrf(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are passed directly to LAPACK, without a 32-bit copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+/// @ingroup gtsv_computational
+int64_t gttrf(
+    int64_t n,
+    float* DL,
+    float* D,
+    float* DU,
+    float* DU2,
+    lapack_int* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gttrf", 's', -1, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    LAPACK_sgttrf(
+        &n_,
+        DL,
+        D,
+        DU,
+        DU2,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gttrf(
+    int64_t n,
+    double* DL,
+    double* D,
+    double* DU,
+    double* DU2,
+    lapack_int* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    LAPACK_dgttrf(
+        &n_,
+        DL,
+        D,
+        DU,
+        DU2,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gttrf(
+    int64_t n,
+    std::complex<float>* DL,
+    std::complex<float>* D,
+    std::complex<float>* DU,
+    std::complex<float>* DU2,
+    lapack_int* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    LAPACK_cgttrf(
+        &n_,
+        (lapack_complex_float*) DL,
+        (lapack_complex_float*) D,
+        (lapack_complex_float*) DU,
+        (lapack_complex_float*) DU2,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+int64_t gttrf(
+    int64_t n,
+    std::complex<double>* DL,
+    std::complex<double>* D,
+    std::complex<double>* DU,
+    std::complex<double>* DU2,
+    lapack_int* ipiv )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "gttrf", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    LAPACK_zgttrf(
+        &n_,
+        (lapack_complex_double*) DL,
+        (lapack_complex_double*) D,
+        (lapack_complex_double*) DU,
+        (lapack_complex_double*) DU2,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
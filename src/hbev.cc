@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +30,11 @@ int64_t hbev(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbev", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -38,8 +44,8 @@ int64_t hbev(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
-    lapack::vector< float > rwork( (max( 1, 3*n-2 )) );
+    lapack::small_vector< std::complex<float> > work( (n) );
+    lapack::small_vector< float > rwork( (max( 1, 3*n-2 )) );
 
     LAPACK_chbev(
         &jobz_, &uplo_, &n_, &kd_,
@@ -72,6 +78,11 @@ int64_t hbev(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbev", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -81,8 +92,8 @@ int64_t hbev(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
-    lapack::vector< double > rwork( (max( 1, 3*n-2 )) );
+    lapack::small_vector< std::complex<double> > work( (n) );
+    lapack::small_vector< double > rwork( (max( 1, 3*n-2 )) );
 
     LAPACK_zhbev(
         &jobz_, &uplo_, &n_, &kd_,
@@ -101,4 +112,177 @@ int64_t hbev(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbev(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    std::complex<float>* AB, lapack_int ldab,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_chbev(
+        &jobz, &uplo, &n, &kd,
+        (lapack_complex_float*) AB, &ldab,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbev(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    std::complex<double>* AB, lapack_int ldab,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zhbev(
+        &jobz, &uplo, &n, &kd,
+        (lapack_complex_double*) AB, &ldab,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbev with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    buffer.take< real_t >( max( 1, 3*n-2 ) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbev, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbev for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbev_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbev", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+    real_t* rwork_ = buffer.take< real_t >( max( 1, 3*n-2 ) );
+
+    fortran_hbev(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        W,
+        Z, ldz_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
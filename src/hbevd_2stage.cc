@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -31,6 +32,11 @@ int64_t hbevd_2stage(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbevd_2stage", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -64,9 +70,9 @@ int64_t hbevd_2stage(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_chbevd_2stage(
         &jobz_, &uplo_, &n_, &kd_,
@@ -100,6 +106,11 @@ int64_t hbevd_2stage(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbevd_2stage", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -133,9 +144,9 @@ int64_t hbevd_2stage(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zhbevd_2stage(
         &jobz_, &uplo_, &n_, &kd_,
@@ -155,6 +166,233 @@ int64_t hbevd_2stage(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbevd_2stage(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    std::complex<float>* AB, lapack_int ldab,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_chbevd_2stage(
+        &jobz, &uplo, &n, &kd,
+        (lapack_complex_float*) AB, &ldab,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbevd_2stage(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    std::complex<double>* AB, lapack_int ldab,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_zhbevd_2stage(
+        &jobz, &uplo, &n, &kd,
+        (lapack_complex_double*) AB, &ldab,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbevd_2stage with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_hbevd_2stage(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        W,
+        Z, ldz_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+    lapack_int lrwork_ = max( 1, lapack_int( real(qry_rwork[0]) ) );
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( lrwork_ );
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbevd_2stage, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbevd_2stage for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbevd_2stage_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbevd_2stage", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for size of rwork, iwork
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_hbevd_2stage(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        W,
+        Z, ldz_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lrwork_ = max( 1, lapack_int( real(qry_rwork[0]) ) );
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( lrwork_ );
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_hbevd_2stage(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        W,
+        Z, ldz_,
+        work_, lwork_,
+        rwork_, lrwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbevd_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7
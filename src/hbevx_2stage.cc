@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -37,6 +38,11 @@ int64_t hbevx_2stage(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbevx_2stage", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -50,7 +56,7 @@ int64_t hbevx_2stage(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (n) );
+        lapack::small_vector< lapack_int > ifail_( (n) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -82,9 +88,9 @@ int64_t hbevx_2stage(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (7*n) );
-    lapack::vector< lapack_int > iwork( (5*n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (7*n) );
+    lapack::small_vector< lapack_int > iwork( (5*n) );
 
     LAPACK_chbevx_2stage(
         &jobz_, &range_, &uplo_, &n_, &kd_,
@@ -132,6 +138,11 @@ int64_t hbevx_2stage(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbevx_2stage", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -145,7 +156,7 @@ int64_t hbevx_2stage(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (n) );
+        lapack::small_vector< lapack_int > ifail_( (n) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -177,9 +188,9 @@ int64_t hbevx_2stage(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (7*n) );
-    lapack::vector< lapack_int > iwork( (5*n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (7*n) );
+    lapack::small_vector< lapack_int > iwork( (5*n) );
 
     LAPACK_zhbevx_2stage(
         &jobz_, &range_, &uplo_, &n_, &kd_,
@@ -207,6 +218,283 @@ int64_t hbevx_2stage(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbevx_2stage(
+    char jobz, char range, char uplo, lapack_int n, lapack_int kd,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float>* Q, lapack_int ldq, float vl, float vu, lapack_int il, lapack_int iu, float abstol, lapack_int* m,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_chbevx_2stage(
+        &jobz, &range, &uplo, &n, &kd,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float*) Q, &ldq, &vl, &vu, &il, &iu, &abstol, m,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work, &lwork,
+        rwork,
+        iwork,
+        ifail, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbevx_2stage(
+    char jobz, char range, char uplo, lapack_int n, lapack_int kd,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double>* Q, lapack_int ldq, double vl, double vu, lapack_int il, lapack_int iu, double abstol, lapack_int* m,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_zhbevx_2stage(
+        &jobz, &range, &uplo, &n, &kd,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double*) Q, &ldq, &vl, &vu, &il, &iu, &abstol, m,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work, &lwork,
+        rwork,
+        iwork,
+        ifail, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbevx_2stage with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int m_ = 0;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_hbevx_2stage(
+        jobz_, range_, uplo_, n_, kd_,
+        AB, ldab_,
+        Q, ldq_, vl, vu, il_, iu_, abstol, &m_,
+        W,
+        Z, ldz_,
+        qry_work, ineg_one,
+        nullptr,
+        nullptr,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< real_t >( 7*n );
+    buffer.take< lapack_int >( 5*n );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbevx_2stage, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbevx_2stage for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbevx_2stage_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbevx_2stage", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ifail_ = buffer.take< lapack_int >( n );
+        lapack_int* ifail_ptr = ifail_;
+    #else
+        lapack_int* ifail_ptr = ifail;
+    #endif
+    real_t* rwork_ = buffer.take< real_t >( 7*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( 5*n );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_hbevx_2stage(
+        jobz_, range_, uplo_, n_, kd_,
+        AB, ldab_,
+        Q, ldq_, vl, vu, il_, iu_, abstol, &m_,
+        W,
+        Z, ldz_,
+        work_, lwork_,
+        rwork_,
+        iwork_,
+        ifail_ptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    #ifndef LAPACK_ILP64
+        if (jobz != Job::NoVec) {
+            std::copy( &ifail_[ 0 ], &ifail_[ m_ ], ifail );
+        }
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* Q, int64_t ldq, float vl,
+    float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbevx_2stage_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* Q, int64_t ldq, double vl,
+    double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* Q, int64_t ldq, float vl,
+    float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+template
+int64_t hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* Q, int64_t ldq, double vl,
+    double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7
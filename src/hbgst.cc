@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t hbgst(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgst", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -42,8 +48,8 @@ int64_t hbgst(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_chbgst(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -78,6 +84,11 @@ int64_t hbgst(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgst", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -89,8 +100,8 @@ int64_t hbgst(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zhbgst(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -109,4 +120,183 @@ int64_t hbgst(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbgst(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float> const* BB, lapack_int ldbb,
+    std::complex<float>* X, lapack_int ldx,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_chbgst(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float const*) BB, &ldbb,
+        (lapack_complex_float*) X, &ldx,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbgst(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double> const* BB, lapack_int ldbb,
+    std::complex<double>* X, lapack_int ldx,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zhbgst(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double const*) BB, &ldbb,
+        (lapack_complex_double*) X, &ldx,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbgst with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    buffer.take< real_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbgst, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbgst for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbgst_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbgst", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+    real_t* rwork_ = buffer.take< real_t >( n );
+
+    fortran_hbgst(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        X, ldx_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float> const* BB, int64_t ldbb,
+    std::complex<float>* X, int64_t ldx,
+    size_t* work_size );
+
+template
+void hbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double> const* BB, int64_t ldbb,
+    std::complex<double>* X, int64_t ldx,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float> const* BB, int64_t ldbb,
+    std::complex<float>* X, int64_t ldx,
+    void* work, size_t work_size );
+
+template
+int64_t hbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double> const* BB, int64_t ldbb,
+    std::complex<double>* X, int64_t ldx,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +33,11 @@ int64_t hbgv(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgv", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -43,8 +49,8 @@ int64_t hbgv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
-    lapack::vector< float > rwork( (3*n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
+    lapack::small_vector< float > rwork( (3*n) );
 
     LAPACK_chbgv(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -81,6 +87,11 @@ int64_t hbgv(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgv", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -92,8 +103,8 @@ int64_t hbgv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
-    lapack::vector< double > rwork( (3*n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
+    lapack::small_vector< double > rwork( (3*n) );
 
     LAPACK_zhbgv(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -113,4 +124,194 @@ int64_t hbgv(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbgv(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float>* BB, lapack_int ldbb,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_chbgv(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float*) BB, &ldbb,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbgv(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double>* BB, lapack_int ldbb,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zhbgv(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double*) BB, &ldbb,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbgv with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    buffer.take< real_t >( 3*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbgv, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbgv for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbgv_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbgv", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+    real_t* rwork_ = buffer.take< real_t >( 3*n );
+
+    fortran_hbgv(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        W,
+        Z, ldz_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbgv_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hbgv(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +33,11 @@ int64_t hbgvd(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgvd", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -71,9 +77,9 @@ int64_t hbgvd(
     lrwork_ = max( lrwork_, 2*n_ );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_chbgvd(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -111,6 +117,11 @@ int64_t hbgvd(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgvd", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -150,9 +161,9 @@ int64_t hbgvd(
     lrwork_ = max( lrwork_, 2*n_ );
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zhbgvd(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -173,4 +184,252 @@ int64_t hbgvd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbgvd(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float>* BB, lapack_int ldbb,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_chbgvd(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float*) BB, &ldbb,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbgvd(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double>* BB, lapack_int ldbb,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_zhbgvd(
+        &jobz, &uplo, &n, &ka, &kb,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double*) BB, &ldbb,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbgvd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_hbgvd(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        W,
+        Z, ldz_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+    lapack_int lrwork_ = max( 1, lapack_int( real(qry_rwork[0]) ) );
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( lrwork_ );
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbgvd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbgvd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbgvd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbgvd", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for size of rwork, iwork
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_hbgvd(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        W,
+        Z, ldz_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lrwork_ = max( 1, lapack_int( real(qry_rwork[0]) ) );
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( lrwork_ );
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_hbgvd(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        W,
+        Z, ldz_,
+        work_, lwork_,
+        rwork_, lrwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbgvd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
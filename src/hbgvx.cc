@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -38,6 +39,11 @@ int64_t hbgvx(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgvx", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -53,7 +59,7 @@ int64_t hbgvx(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (n) );
+        lapack::small_vector< lapack_int > ifail_( (n) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -61,9 +67,9 @@ int64_t hbgvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
-    lapack::vector< float > rwork( (7*n) );
-    lapack::vector< lapack_int > iwork( (5*n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
+    lapack::small_vector< float > rwork( (7*n) );
+    lapack::small_vector< lapack_int > iwork( (5*n) );
 
     LAPACK_chbgvx(
         &jobz_, &range_, &uplo_, &n_, &ka_, &kb_,
@@ -115,6 +121,11 @@ int64_t hbgvx(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hbgvx", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -130,7 +141,7 @@ int64_t hbgvx(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (n) );
+        lapack::small_vector< lapack_int > ifail_( (n) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -138,9 +149,9 @@ int64_t hbgvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
-    lapack::vector< double > rwork( (7*n) );
-    lapack::vector< lapack_int > iwork( (5*n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
+    lapack::small_vector< double > rwork( (7*n) );
+    lapack::small_vector< lapack_int > iwork( (5*n) );
 
     LAPACK_zhbgvx(
         &jobz_, &range_, &uplo_, &n_, &ka_, &kb_,
@@ -169,4 +180,267 @@ int64_t hbgvx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hbgvx(
+    char jobz, char range, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float>* BB, lapack_int ldbb,
+    std::complex<float>* Q, lapack_int ldq, float vl, float vu, lapack_int il, lapack_int iu, float abstol, lapack_int* m,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work,
+    float* rwork,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_chbgvx(
+        &jobz, &range, &uplo, &n, &ka, &kb,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float*) BB, &ldbb,
+        (lapack_complex_float*) Q, &ldq, &vl, &vu, &il, &iu, &abstol, m,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work,
+        rwork,
+        iwork,
+        ifail, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hbgvx(
+    char jobz, char range, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double>* BB, lapack_int ldbb,
+    std::complex<double>* Q, lapack_int ldq, double vl, double vu, lapack_int il, lapack_int iu, double abstol, lapack_int* m,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work,
+    double* rwork,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_zhbgvx(
+        &jobz, &range, &uplo, &n, &ka, &kb,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double*) BB, &ldbb,
+        (lapack_complex_double*) Q, &ldq, &vl, &vu, &il, &iu, &abstol, m,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work,
+        rwork,
+        iwork,
+        ifail, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hbgvx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( n );
+    buffer.take< real_t >( 7*n );
+    buffer.take< lapack_int >( 5*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hbgvx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hbgvx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hbgvx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    scalar_t* Q, int64_t ldq, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t> abstol,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hbgvx", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ifail_ = buffer.take< lapack_int >( n );
+        lapack_int* ifail_ptr = ifail_;
+    #else
+        lapack_int* ifail_ptr = ifail;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+    real_t* rwork_ = buffer.take< real_t >( 7*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( 5*n );
+
+    fortran_hbgvx(
+        jobz_, range_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        Q, ldq_, vl, vu, il_, iu_, abstol, &m_,
+        W,
+        Z, ldz_,
+        work_,
+        rwork_,
+        iwork_,
+        ifail_ptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    #ifndef LAPACK_ILP64
+        if (jobz != Job::NoVec) {
+            std::copy( &ifail_[ 0 ], &ifail_[ m_ ], ifail );
+        }
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    std::complex<float>* Q, int64_t ldq, float vl,
+    float vu, int64_t il, int64_t iu,
+    float abstol,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hbgvx_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    std::complex<double>* Q, int64_t ldq, double vl,
+    double vu, int64_t il, int64_t iu,
+    double abstol,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* BB, int64_t ldbb,
+    std::complex<float>* Q, int64_t ldq, float vl,
+    float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* m,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+template
+int64_t hbgvx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t ka, int64_t kb,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* BB, int64_t ldbb,
+    std::complex<double>* Q, int64_t ldq, double vl,
+    double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* m,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -31,12 +32,17 @@ int64_t hecon_rk(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hecon_rk", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -44,7 +50,7 @@ int64_t hecon_rk(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_checon_3(
         &uplo_, &n_,
@@ -154,12 +160,17 @@ int64_t hecon_rk(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hecon_rk", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -167,7 +178,7 @@ int64_t hecon_rk(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_zhecon_3(
         &uplo_, &n_,
@@ -186,6 +197,171 @@ int64_t hecon_rk(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hecon_rk(
+    char uplo, lapack_int n,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* E,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_checon_3(
+        &uplo, &n,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) E,
+        ipiv, &anorm, rcond,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hecon_rk(
+    char uplo, lapack_int n,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* E,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zhecon_3(
+        &uplo, &n,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) E,
+        ipiv, &anorm, rcond,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hecon_rk with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hecon_rk, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hecon_rk for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hecon_rk_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hecon_rk", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_hecon_rk(
+        uplo_, n_,
+        A, lda_,
+        E,
+        ipiv_ptr, anorm, rcond,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* E, float anorm,
+    size_t* work_size );
+
+template
+void hecon_rk_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* E, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* E,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t hecon_rk(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* E,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7
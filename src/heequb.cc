@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,13 +30,18 @@ int64_t heequb(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heequb", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_cheequb(
         &uplo_, &n_,
@@ -111,13 +117,18 @@ int64_t heequb(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heequb", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_zheequb(
         &uplo_, &n_,
@@ -134,4 +145,154 @@ int64_t heequb(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_heequb(
+    char uplo, lapack_int n,
+    std::complex<float> const* A, lapack_int lda,
+    float* S, float* scond, float* amax,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_cheequb(
+        &uplo, &n,
+        (lapack_complex_float const*) A, &lda,
+        S, scond, amax,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heequb(
+    char uplo, lapack_int n,
+    std::complex<double> const* A, lapack_int lda,
+    double* S, double* scond, double* amax,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zheequb(
+        &uplo, &n,
+        (lapack_complex_double const*) A, &lda,
+        S, scond, amax,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by heequb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::heequb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::heequb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     heequb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* S,
+    blas::real_type<scalar_t>* scond,
+    blas::real_type<scalar_t>* amax,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "heequb", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_heequb(
+        uplo_, n_,
+        A, lda_,
+        S, scond, amax,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    float* S,
+    size_t* work_size );
+
+template
+void heequb_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    double* S,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    float* S,
+    float* scond,
+    float* amax,
+    void* work, size_t work_size );
+
+template
+int64_t heequb(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    double* S,
+    double* scond,
+    double* amax,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,6 +29,11 @@ int64_t heevd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heevd", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -57,9 +64,9 @@ int64_t heevd(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_cheevd(
         &jobz_, &uplo_, &n_,
@@ -149,6 +156,11 @@ int64_t heevd(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heevd", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -179,9 +191,9 @@ int64_t heevd(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zheevd(
         &jobz_, &uplo_, &n_,
@@ -200,4 +212,292 @@ int64_t heevd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions call syevd; rwork is not referenced.
+static void fortran_heevd(
+    char jobz, char uplo, lapack_int n,
+    float* A, lapack_int lda,
+    float* W,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_ssyevd(
+        &jobz, &uplo, &n,
+        A, &lda,
+        W,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevd(
+    char jobz, char uplo, lapack_int n,
+    double* A, lapack_int lda,
+    double* W,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_dsyevd(
+        &jobz, &uplo, &n,
+        A, &lda,
+        W,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevd(
+    char jobz, char uplo, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    float* W,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_cheevd(
+        &jobz, &uplo, &n,
+        (lapack_complex_float*) A, &lda,
+        W,
+        (lapack_complex_float*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevd(
+    char jobz, char uplo, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    double* W,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_zheevd(
+        &jobz, &uplo, &n,
+        (lapack_complex_double*) A, &lda,
+        W,
+        (lapack_complex_double*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+// Lengths of rwork (complex only) and iwork for heevd and syevd.
+// These are the minimum lengths, which LAPACK's query also returns.
+static void heevd_lrwork_liwork(
+    bool is_complex, lapack::Job jobz, int64_t n,
+    int64_t* lrwork, int64_t* liwork )
+{
+    if (n <= 1) {
+        *lrwork = 1;
+        *liwork = 1;
+    }
+    else if (jobz == Job::NoVec) {
+        *lrwork = n;
+        *liwork = 1;
+    }
+    else {
+        *lrwork = 1 + 5*n + 2*n*n;
+        *liwork = 3 + 5*n;
+    }
+    if (! is_complex)
+        *lrwork = 0;
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by heevd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_heevd(
+        jobz_, uplo_, n_,
+        A, lda_,
+        W,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    int64_t lrwork, liwork;
+    heevd_lrwork_liwork( blas::is_complex<scalar_t>::value, jobz, n,
+                         &lrwork, &liwork );
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( lrwork );
+    buffer.take< lapack_int >( liwork );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::heevd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::heevd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     heevd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t>* W,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "heevd", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    int64_t lrwork, liwork;
+    heevd_lrwork_liwork( blas::is_complex<scalar_t>::value, jobz, n,
+                         &lrwork, &liwork );
+    lapack_int lrwork_ = (lapack_int) lrwork;
+    lapack_int liwork_ = (lapack_int) liwork;
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* rwork_ = buffer.take< real_t >( lrwork );
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_heevd(
+        jobz_, uplo_, n_,
+        A, lda_,
+        W,
+        work_, lwork_,
+        rwork_, lrwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* work_size );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* work_size );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    size_t* work_size );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* work, size_t work_size );
+
+template
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* work, size_t work_size );
+
+template
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    void* work, size_t work_size );
+
+template
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    void* work, size_t work_size );
+
 }  // namespace lapack
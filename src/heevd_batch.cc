@@ -0,0 +1,256 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a batch of
+/// Hermitian matrices, using divide and conquer, pointer-array variant.
+/// For real matrices, this is syevd_batch. See lapack::heevd.
+///
+/// Workspace is queried once for each distinct (jobz_i, uplo_i, n_i, lda_i),
+/// so once if all problems have the same arguments, and each worker
+/// thread reuses one buffer of the largest size for all its problems.
+///
+/// @param[in] jobz
+///     Whether to compute eigenvectors; 1 or batch entries.
+///     - lapack::Job::NoVec: eigenvalues only;
+///     - lapack::Job::Vec:   eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored;
+///     1 or batch entries.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, if jobz_i = Vec, the orthonormal
+///     eigenvectors of $A_i$; otherwise, the stored triangle is destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[out] Warray
+///     Pointers to the batch vectors of eigenvalues of $A_i$, of length n_i,
+///     in ascending order.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::heevd for $A_i$: 0 for success, or k > 0 if the
+///     algorithm failed to converge.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( jobz, batch );
+    internal::batch::check_arg_size( uplo, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Warray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "heevd_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), -1,
+        []() { return 0.0; } );
+
+    // query workspace, skipping problems with the same arguments
+    // as the previous one
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( jobz, i ) != extract( jobz, i-1 )
+            || extract( uplo, i ) != extract( uplo, i-1 )
+            || extract( n, i )    != extract( n, i-1 )
+            || extract( lda, i )  != extract( lda, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::heevd_work_size_bytes(
+                extract( jobz, i ), extract( uplo, i ), extract( n, i ),
+                Aarray[ i ], extract( lda, i ), Warray[ i ],
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::heevd(
+            extract( jobz, i ), extract( uplo, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ), Warray[ i ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a batch of
+/// Hermitian matrices, using divide and conquer, strided variant.
+/// For real matrices, this is syevd_batch. See lapack::heevd.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] jobz
+///     Whether to compute eigenvectors.
+///     - lapack::Job::NoVec: eigenvalues only;
+///     - lapack::Job::Vec:   eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, if jobz = Vec, the
+///     eigenvectors; otherwise, the stored triangle is destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[out] W
+///     The batch vectors of eigenvalues, with those of $A_i$
+///     starting at W + i*strideW, in ascending order.
+///
+/// @param[in] strideW
+///     Distance between vectors; strideW >= n.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideW < n );
+
+    trace::internal::Block trace_block(
+        "heevd_batch", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    size_t work_size;
+    lapack::heevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::heevd(
+            jobz, uplo, n, &A[ i*strideA ], lda, &W[ i*strideW ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float* > const& Warray,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double* > const& Warray,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float* > const& Warray,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double* > const& Warray,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    float* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    double* W, int64_t strideW,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
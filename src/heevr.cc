@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -33,6 +34,11 @@ int64_t heevr(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heevr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -44,7 +50,7 @@ int64_t heevr(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -77,9 +83,9 @@ int64_t heevr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_cheevr(
         &jobz_, &range_, &uplo_, &n_,
@@ -315,6 +321,11 @@ int64_t heevr(
         lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heevr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     char uplo_ = uplo2char( uplo );
@@ -326,7 +337,7 @@ int64_t heevr(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -359,9 +370,9 @@ int64_t heevr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zheevr(
         &jobz_, &range_, &uplo_, &n_,
@@ -386,4 +397,371 @@ int64_t heevr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions call syevr; rwork is not referenced.
+static void fortran_heevr(
+    char jobz, char range, char uplo, lapack_int n,
+    float* A, lapack_int lda,
+    float vl, float vu, lapack_int il, lapack_int iu, float abstol,
+    lapack_int* nfound,
+    float* W,
+    float* Z, lapack_int ldz,
+    lapack_int* isuppz,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_ssyevr(
+        &jobz, &range, &uplo, &n,
+        A, &lda, &vl, &vu, &il, &iu, &abstol, nfound,
+        W,
+        Z, &ldz,
+        isuppz,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevr(
+    char jobz, char range, char uplo, lapack_int n,
+    double* A, lapack_int lda,
+    double vl, double vu, lapack_int il, lapack_int iu, double abstol,
+    lapack_int* nfound,
+    double* W,
+    double* Z, lapack_int ldz,
+    lapack_int* isuppz,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_dsyevr(
+        &jobz, &range, &uplo, &n,
+        A, &lda, &vl, &vu, &il, &iu, &abstol, nfound,
+        W,
+        Z, &ldz,
+        isuppz,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevr(
+    char jobz, char range, char uplo, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    float vl, float vu, lapack_int il, lapack_int iu, float abstol,
+    lapack_int* nfound,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz,
+    lapack_int* isuppz,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_cheevr(
+        &jobz, &range, &uplo, &n,
+        (lapack_complex_float*) A, &lda, &vl, &vu, &il, &iu, &abstol, nfound,
+        W,
+        (lapack_complex_float*) Z, &ldz,
+        isuppz,
+        (lapack_complex_float*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_heevr(
+    char jobz, char range, char uplo, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    double vl, double vu, lapack_int il, lapack_int iu, double abstol,
+    lapack_int* nfound,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz,
+    lapack_int* isuppz,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_zheevr(
+        &jobz, &range, &uplo, &n,
+        (lapack_complex_double*) A, &lda, &vl, &vu, &il, &iu, &abstol, nfound,
+        W,
+        (lapack_complex_double*) Z, &ldz,
+        isuppz,
+        (lapack_complex_double*) work, &lwork,
+        rwork, &lrwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+// Lengths of rwork (complex only) and iwork for heevr and syevr.
+// These are the minimum lengths, which LAPACK's query also returns.
+static void heevr_lrwork_liwork(
+    bool is_complex, int64_t n,
+    int64_t* lrwork, int64_t* liwork )
+{
+    *lrwork = is_complex ? max( 1, 24*n ) : 0;
+    *liwork = max( 1, 10*n );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by heevr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_heevr(
+        jobz_, range_, uplo_, n_,
+        A, lda_, vl, vu, il_, iu_, abstol, &nfound_,
+        W,
+        Z, ldz_,
+        nullptr,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    int64_t lrwork, liwork;
+    heevr_lrwork_liwork( blas::is_complex<scalar_t>::value, n,
+                         &lrwork, &liwork );
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( 2*max( 1, n ) );
+    #endif
+    buffer.take< real_t >( lrwork );
+    buffer.take< lapack_int >( liwork );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::heevr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::heevr for the other arguments.
+/// isuppz is referenced only if jobz = Vec, so can be null otherwise.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     heevr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    int64_t* nfound,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "heevr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    int64_t lrwork, liwork;
+    heevr_lrwork_liwork( blas::is_complex<scalar_t>::value, n,
+                         &lrwork, &liwork );
+    lapack_int lrwork_ = (lapack_int) lrwork;
+    lapack_int liwork_ = (lapack_int) liwork;
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* isuppz_ptr = buffer.take< lapack_int >( 2*max( 1, n ) );
+    #else
+        lapack_int* isuppz_ptr = isuppz;
+    #endif
+    real_t* rwork_ = buffer.take< real_t >( lrwork );
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_heevr(
+        jobz_, range_, uplo_, n_,
+        A, lda_, vl, vu, il_, iu_, abstol, &nfound_,
+        W,
+        Z, ldz_,
+        isuppz_ptr,
+        work_, lwork_,
+        rwork_, lrwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    #ifndef LAPACK_ILP64
+        if (jobz == Job::Vec)
+            std::copy( isuppz_ptr, isuppz_ptr + 2*nfound_, isuppz );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float vl, float vu, int64_t il, int64_t iu, float abstol,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double vl, double vu, int64_t il, int64_t iu, double abstol,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float vl, float vu, int64_t il, int64_t iu, float abstol,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double vl, double vu, int64_t il, int64_t iu, double abstol,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+template
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+template
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
+template
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
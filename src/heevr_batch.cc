@@ -0,0 +1,485 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/work.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+// Checks range arguments of one heevr problem, as LAPACK does.
+template <typename real_t>
+static void heevr_check_range(
+    lapack::Range range, int64_t n,
+    real_t vl, real_t vu, int64_t il, int64_t iu )
+{
+    if (range == Range::Value) {
+        lapack_error_if( n > 0 && vu <= vl );
+    }
+    else if (range == Range::Index) {
+        lapack_error_if( il < 1 || il > max( 1, n ) );
+        lapack_error_if( iu < min( n, il ) || iu > n );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Max number of eigenvalues found by one heevr problem.
+static int64_t heevr_max_found(
+    lapack::Range range, int64_t n, int64_t il, int64_t iu )
+{
+    return range == Range::Index ? iu - il + 1 : n;
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a batch
+/// of Hermitian matrices, using Relatively Robust Representations,
+/// pointer-array variant. For real matrices, this is syevr_batch.
+/// See lapack::heevr.
+///
+/// Workspace is queried once for each distinct (jobz_i, uplo_i, n_i),
+/// so once if all problems have the same arguments, and each worker
+/// thread reuses one buffer of the largest size for all its problems.
+///
+/// @param[in] jobz
+///     Whether to compute eigenvectors; 1 or batch entries.
+///     - lapack::Job::NoVec: eigenvalues only; Z and isuppz are not
+///       referenced, so Zarray and isuppz_array can hold null pointers.
+///     - lapack::Job::Vec:   eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     Which eigenvalues to find; 1 or batch entries.
+///     - lapack::Range::All:   all eigenvalues;
+///     - lapack::Range::Value: eigenvalues in the half-open interval (vl_i, vu_i];
+///     - lapack::Range::Index: the il_i-th through iu_i-th eigenvalues.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored;
+///     1 or batch entries.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, the stored triangle is destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in] vl
+///     Lower bound of interval, if range_i = Value; 1 or batch entries.
+///
+/// @param[in] vu
+///     Upper bound of interval, if range_i = Value; vu_i > vl_i.
+///     1 or batch entries.
+///
+/// @param[in] il
+///     Index of smallest eigenvalue to find, if range_i = Index;
+///     1 or batch entries.
+///
+/// @param[in] iu
+///     Index of largest eigenvalue to find, if range_i = Index;
+///     1 <= il_i <= iu_i <= n_i, or il_i = 1 and iu_i = 0 if n_i = 0.
+///     1 or batch entries.
+///
+/// @param[in] abstol
+///     Absolute error tolerance for eigenvalues; 1 or batch entries.
+///     See lapack::heevr.
+///
+/// @param[out] nfound
+///     Resized to batch entries. nfound[ i ] is the number of eigenvalues
+///     found for $A_i$.
+///
+/// @param[out] Warray
+///     Pointers to the batch vectors of eigenvalues, of length n_i.
+///     The first nfound[ i ] entries are the selected eigenvalues,
+///     in ascending order.
+///
+/// @param[out] Zarray
+///     Pointers to the batch eigenvector matrices $Z_i$, if jobz_i = Vec,
+///     each stored in an ldz_i-by-max(1, m_i) array, where m_i is n_i, or
+///     iu_i - il_i + 1 if range_i = Index.
+///
+/// @param[in] ldz
+///     Leading dimension of each $Z_i$; ldz_i >= max(1, n_i) if
+///     jobz_i = Vec, else ldz_i >= 1. 1 or batch entries.
+///
+/// @param[out] isuppz_array
+///     Pointers to the batch support vectors, of length 2*max(1, m_i),
+///     if jobz_i = Vec. See lapack::heevr.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::heevr for $A_i$: 0 for success, or > 0 for an
+///     internal error.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< blas::real_type<scalar_t> > const& vl,
+    std::vector< blas::real_type<scalar_t> > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< blas::real_type<scalar_t> > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< blas::real_type<scalar_t>* > const& Warray,
+    std::vector<scalar_t*> const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( jobz, batch );
+    internal::batch::check_arg_size( range, batch );
+    internal::batch::check_arg_size( uplo, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( vl, batch );
+    internal::batch::check_arg_size( vu, batch );
+    internal::batch::check_arg_size( il, batch );
+    internal::batch::check_arg_size( iu, batch );
+    internal::batch::check_arg_size( abstol, batch );
+    internal::batch::check_arg_size( ldz, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Warray, batch );
+    internal::batch::check_array_size( Zarray, batch );
+    internal::batch::check_array_size( isuppz_array, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+        heevr_check_range( extract( range, i ), n_i,
+                           extract( vl, i ), extract( vu, i ),
+                           extract( il, i ), extract( iu, i ) );
+        if (extract( jobz, i ) == Job::Vec)
+            lapack_error_if( extract( ldz, i ) < max( 1, n_i ) );
+        else
+            lapack_error_if( extract( ldz, i ) < 1 );
+    }
+
+    trace::internal::Block trace_block(
+        "heevr_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), -1,
+        []() { return 0.0; } );
+
+    // query workspace, skipping problems with the same arguments
+    // as the previous one; the size depends only on these.
+    size_t work_size = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        if (i == 0
+            || extract( jobz, i ) != extract( jobz, i-1 )
+            || extract( uplo, i ) != extract( uplo, i-1 )
+            || extract( n, i )    != extract( n, i-1 ))
+        {
+            size_t work_size_i;
+            lapack::heevr_work_size_bytes(
+                extract( jobz, i ), extract( range, i ), extract( uplo, i ),
+                extract( n, i ), Aarray[ i ], extract( lda, i ),
+                extract( vl, i ), extract( vu, i ),
+                extract( il, i ), extract( iu, i ), extract( abstol, i ),
+                Warray[ i ], Zarray[ i ], extract( ldz, i ),
+                &work_size_i );
+            work_size = max( work_size, work_size_i );
+        }
+    }
+    internal::batch::WorkerWorkspace work( work_size );
+
+    nfound.resize( batch );
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::heevr(
+            extract( jobz, i ), extract( range, i ), extract( uplo, i ),
+            extract( n, i ), Aarray[ i ], extract( lda, i ),
+            extract( vl, i ), extract( vu, i ),
+            extract( il, i ), extract( iu, i ), extract( abstol, i ),
+            &nfound[ i ], Warray[ i ], Zarray[ i ], extract( ldz, i ),
+            isuppz_array[ i ],
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a batch
+/// of Hermitian matrices, using Relatively Robust Representations,
+/// strided variant. For real matrices, this is syevr_batch.
+/// See lapack::heevr.
+///
+/// Workspace is queried once for the batch, and each worker thread
+/// reuses one buffer for all its problems.
+///
+/// @param[in] jobz
+///     Whether to compute eigenvectors.
+///     - lapack::Job::NoVec: eigenvalues only; Z and isuppz are not
+///       referenced, so can be null.
+///     - lapack::Job::Vec:   eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     Which eigenvalues to find.
+///     - lapack::Range::All:   all eigenvalues;
+///     - lapack::Range::Value: eigenvalues in the half-open interval (vl, vu];
+///     - lapack::Range::Index: the il-th through iu-th eigenvalues.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, the stored triangle is destroyed.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices $A_i$; strideA >= lda*n.
+///
+/// @param[in] vl
+///     Lower bound of interval, if range = Value.
+///
+/// @param[in] vu
+///     Upper bound of interval, if range = Value; vu > vl.
+///
+/// @param[in] il
+///     Index of smallest eigenvalue to find, if range = Index.
+///
+/// @param[in] iu
+///     Index of largest eigenvalue to find, if range = Index;
+///     1 <= il <= iu <= n, or il = 1 and iu = 0 if n = 0.
+///
+/// @param[in] abstol
+///     Absolute error tolerance for eigenvalues. See lapack::heevr.
+///
+/// @param[out] nfound
+///     Resized to batch entries. nfound[ i ] is the number of eigenvalues
+///     found for $A_i$.
+///
+/// @param[out] W
+///     The batch vectors of eigenvalues, with those of $A_i$ starting at
+///     W + i*strideW. The first nfound[ i ] entries are the selected
+///     eigenvalues, in ascending order.
+///
+/// @param[in] strideW
+///     Distance between vectors; strideW >= n.
+///
+/// @param[out] Z
+///     If jobz = Vec, the batch eigenvector matrices, with $Z_i$ stored in
+///     an ldz-by-m array starting at Z + i*strideZ, where m is n, or
+///     iu - il + 1 if range = Index.
+///
+/// @param[in] ldz
+///     Leading dimension of each $Z_i$; ldz >= max(1, n) if jobz = Vec,
+///     else ldz >= 1.
+///
+/// @param[in] strideZ
+///     Distance between matrices $Z_i$; strideZ >= ldz*m if jobz = Vec.
+///
+/// @param[out] isuppz
+///     If jobz = Vec, the batch support vectors, with that of $Z_i$ of
+///     length 2*max(1, m) starting at isuppz + i*stride_isuppz.
+///
+/// @param[in] stride_isuppz
+///     Distance between support vectors;
+///     stride_isuppz >= 2*max(1, m) if jobz = Vec.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu, blas::real_type<scalar_t> abstol,
+    std::vector<int64_t>& nfound,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    scalar_t* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideW < n );
+    heevr_check_range( range, n, vl, vu, il, iu );
+    if (jobz == Job::Vec) {
+        int64_t m = heevr_max_found( range, n, il, iu );
+        lapack_error_if( ldz < max( 1, n ) );
+        lapack_error_if( strideZ < ldz*m );
+        lapack_error_if( stride_isuppz < 2*max( 1, m ) );
+    }
+    else {
+        lapack_error_if( ldz < 1 );
+    }
+
+    trace::internal::Block trace_block(
+        "heevr_batch", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    size_t work_size;
+    lapack::heevr_work_size_bytes(
+        jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol,
+        W, Z, ldz, &work_size );
+    internal::batch::WorkerWorkspace work( work_size );
+
+    bool wantz = (jobz == Job::Vec);
+    nfound.resize( batch );
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::heevr(
+            jobz, range, uplo, n, &A[ i*strideA ], lda,
+            vl, vu, il, iu, abstol,
+            &nfound[ i ], &W[ i*strideW ],
+            wantz ? &Z[ i*strideZ ] : Z, ldz,
+            wantz ? &isuppz[ i*stride_isuppz ] : isuppz,
+            work.get( worker ), work.size() );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float > const& vl,
+    std::vector< float > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< float > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< float* > const& Warray,
+    std::vector<float*> const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double > const& vl,
+    std::vector< double > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< double > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< double* > const& Warray,
+    std::vector<double*> const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< float > const& vl,
+    std::vector< float > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< float > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< float* > const& Warray,
+    std::vector< std::complex<float>* > const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    std::vector<lapack::Job> const& jobz,
+    std::vector<lapack::Range> const& range,
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< double > const& vl,
+    std::vector< double > const& vu,
+    std::vector<int64_t> const& il,
+    std::vector<int64_t> const& iu,
+    std::vector< double > const& abstol,
+    std::vector<int64_t>& nfound,
+    std::vector< double* > const& Warray,
+    std::vector< std::complex<double>* > const& Zarray, std::vector<int64_t> const& ldz,
+    std::vector<int64_t*> const& isuppz_array,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float vl, float vu,
+    int64_t il, int64_t iu, float abstol,
+    std::vector<int64_t>& nfound,
+    float* W, int64_t strideW,
+    float* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double vl, double vu,
+    int64_t il, int64_t iu, double abstol,
+    std::vector<int64_t>& nfound,
+    double* W, int64_t strideW,
+    double* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    float vl, float vu,
+    int64_t il, int64_t iu, float abstol,
+    std::vector<int64_t>& nfound,
+    float* W, int64_t strideW,
+    std::complex<float>* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void heevr_batch(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    double vl, double vu,
+    int64_t il, int64_t iu, double abstol,
+    std::vector<int64_t>& nfound,
+    double* W, int64_t strideW,
+    std::complex<double>* Z, int64_t ldz, int64_t strideZ,
+    int64_t* isuppz, int64_t stride_isuppz,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
@@ -27,6 +27,11 @@ int64_t hegst(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hegst", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int itype_ = (lapack_int) itype;
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -61,6 +66,11 @@ int64_t hegst(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hegst", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int itype_ = (lapack_int) itype;
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
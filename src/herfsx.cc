@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #ifdef LAPACK_HAVE_XBLAS
 
@@ -44,6 +45,11 @@ int64_t herfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "herfsx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -52,7 +58,7 @@ int64_t herfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -64,8 +70,8 @@ int64_t herfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (2*n) );
 
     LAPACK_cherfsx(
         &uplo_, &equed_, &n_, &nrhs_,
@@ -390,6 +396,11 @@ int64_t herfsx(
         lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "herfsx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( equed );
     lapack_int n_ = (lapack_int) n;
@@ -398,7 +409,7 @@ int64_t herfsx(
     lapack_int ldaf_ = (lapack_int) ldaf;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -410,8 +421,8 @@ int64_t herfsx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (2*n) );
 
     LAPACK_zherfsx(
         &uplo_, &equed_, &n_, &nrhs_,
@@ -437,6 +448,278 @@ int64_t herfsx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_herfsx(
+    char uplo, char equed, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    float* S,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* berr, lapack_int n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, lapack_int nparams,
+    float* params,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cherfsx(
+        &uplo, &equed, &n, &nrhs,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) AF, &ldaf,
+        ipiv,
+        S,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_herfsx(
+    char uplo, char equed, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* AF, lapack_int ldaf,
+    lapack_int const* ipiv,
+    double* S,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* berr, lapack_int n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, lapack_int nparams,
+    double* params,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zherfsx(
+        &uplo, &equed, &n, &nrhs,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) AF, &ldaf,
+        ipiv,
+        S,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        berr, &n_err_bnds,
+        err_bnds_norm,
+        err_bnds_comp, &nparams,
+        params,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by herfsx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( 2*n );
+    buffer.take< real_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::herfsx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::herfsx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     herfsx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    blas::real_type<scalar_t>* S,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* berr, int64_t n_err_bnds,
+    blas::real_type<scalar_t>* err_bnds_norm,
+    blas::real_type<scalar_t>* err_bnds_comp, int64_t nparams,
+    blas::real_type<scalar_t>* params,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldaf) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n_err_bnds) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nparams) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "herfsx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    char equed_ = equed2char( equed );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldaf_ = (lapack_int) ldaf;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int n_err_bnds_ = (lapack_int) n_err_bnds;
+    lapack_int nparams_ = (lapack_int) nparams;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+    real_t* rwork_ = buffer.take< real_t >( 2*n );
+
+    fortran_herfsx(
+        uplo_, equed_, n_, nrhs_,
+        A, lda_,
+        AF, ldaf_,
+        ipiv_ptr,
+        S,
+        B, ldb_,
+        X, ldx_, rcond,
+        berr, n_err_bnds_,
+        err_bnds_norm,
+        err_bnds_comp, nparams_,
+        params,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    float* S,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    size_t* work_size );
+
+template
+void herfsx_work_size_bytes(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    double* S,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    float* S,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* berr, int64_t n_err_bnds,
+    float* err_bnds_norm,
+    float* err_bnds_comp, int64_t nparams,
+    float* params,
+    void* work, size_t work_size );
+
+template
+int64_t herfsx(
+    lapack::Uplo uplo, lapack::Equed equed, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* AF, int64_t ldaf,
+    int64_t const* ipiv,
+    double* S,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* berr, int64_t n_err_bnds,
+    double* err_bnds_norm,
+    double* err_bnds_comp, int64_t nparams,
+    double* params,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // HAVE_XBLAS
@@ -29,6 +29,11 @@ void heswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heswapr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -87,6 +92,11 @@ void heswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "heswapr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -26,6 +26,11 @@ void hfrk(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hfrk", 'c', -1, n, k,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
@@ -55,6 +60,11 @@ void hfrk(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hfrk", 'z', -1, n, k,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
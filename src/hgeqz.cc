@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -35,6 +36,11 @@ int64_t hgeqz(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hgeqz", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
@@ -48,8 +54,8 @@ int64_t hgeqz(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > alphar( max( 1, n ) );
-    lapack::vector< float > alphai( max( 1, n ) );
+    lapack::small_vector< float > alphar( max( 1, n ) );
+    lapack::small_vector< float > alphai( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -74,7 +80,7 @@ int64_t hgeqz(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_shgeqz(
         &jobschur_, &compq_, &compz_, &n_, &ilo_, &ihi_,
@@ -120,6 +126,11 @@ int64_t hgeqz(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hgeqz", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
@@ -133,8 +144,8 @@ int64_t hgeqz(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > alphar( max( 1, n ) );
-    lapack::vector< double > alphai( max( 1, n ) );
+    lapack::small_vector< double > alphar( max( 1, n ) );
+    lapack::small_vector< double > alphai( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -159,7 +170,7 @@ int64_t hgeqz(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dhgeqz(
         &jobschur_, &compq_, &compz_, &n_, &ilo_, &ihi_,
@@ -205,6 +216,11 @@ int64_t hgeqz(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hgeqz", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
@@ -241,8 +257,8 @@ int64_t hgeqz(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_chgeqz(
         &jobschur_, &compq_, &compz_, &n_, &ilo_, &ihi_,
@@ -284,6 +300,11 @@ int64_t hgeqz(
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hgeqz", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compq_ = job_comp2char( compq );
     char compz_ = job_comp2char( compz );
@@ -320,8 +341,8 @@ int64_t hgeqz(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zhgeqz(
         &jobschur_, &compq_, &compz_, &n_, &ilo_, &ihi_,
@@ -343,4 +364,380 @@ int64_t hgeqz(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (alphar, alphai)
+// and don't reference alpha or rwork; complex precisions return alpha
+// directly and don't reference alphar or alphai.
+static void fortran_hgeqz(
+    char jobschur, char compq, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    float* H, lapack_int ldh,
+    float* T, lapack_int ldt,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    float* beta,
+    float* Q, lapack_int ldq,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_shgeqz(
+        &jobschur, &compq, &compz, &n, &ilo, &ihi,
+        H, &ldh,
+        T, &ldt,
+        alphar, alphai,
+        beta,
+        Q, &ldq,
+        Z, &ldz,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hgeqz(
+    char jobschur, char compq, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    double* H, lapack_int ldh,
+    double* T, lapack_int ldt,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    double* beta,
+    double* Q, lapack_int ldq,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dhgeqz(
+        &jobschur, &compq, &compz, &n, &ilo, &ihi,
+        H, &ldh,
+        T, &ldt,
+        alphar, alphai,
+        beta,
+        Q, &ldq,
+        Z, &ldz,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hgeqz(
+    char jobschur, char compq, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<float>* H, lapack_int ldh,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* alpha, float* alphar, float* alphai,
+    std::complex<float>* beta,
+    std::complex<float>* Q, lapack_int ldq,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_chgeqz(
+        &jobschur, &compq, &compz, &n, &ilo, &ihi,
+        (lapack_complex_float*) H, &ldh,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) alpha,
+        (lapack_complex_float*) beta,
+        (lapack_complex_float*) Q, &ldq,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hgeqz(
+    char jobschur, char compq, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<double>* H, lapack_int ldh,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* alpha, double* alphar, double* alphai,
+    std::complex<double>* beta,
+    std::complex<double>* Q, lapack_int ldq,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zhgeqz(
+        &jobschur, &compq, &compz, &n, &ilo, &ihi,
+        (lapack_complex_double*) H, &ldh,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) alpha,
+        (lapack_complex_double*) beta,
+        (lapack_complex_double*) Q, &ldq,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work, &lwork,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hgeqz with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    scalar_t* T, int64_t ldt,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobschur_ = jobschur2char( jobschur );
+    char compq_ = job_comp2char( compq );
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int ldh_ = (lapack_int) ldh;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    real_t qry_alphar[1], qry_alphai[1];
+    lapack_int ineg_one = -1;
+    fortran_hgeqz(
+        jobschur_, compq_, compz_, n_, ilo_, ihi_,
+        H, ldh_,
+        T, ldt_,
+        alpha, qry_alphar, qry_alphai,
+        beta,
+        Q, ldq_,
+        Z, ldz_,
+        qry_work, ineg_one,
+        qry_rwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // alphar
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // alphai
+    buffer.take< real_t >( is_complex ? n : 0 );  // rwork
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hgeqz, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hgeqz for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hgeqz_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    scalar_t* T, int64_t ldt,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hgeqz", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobschur_ = jobschur2char( jobschur );
+    char compq_ = job_comp2char( compq );
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int ldh_ = (lapack_int) ldh;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* alphar_ = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* alphai_ = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? n : 0 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_hgeqz(
+        jobschur_, compq_, compz_, n_, ilo_, ihi_,
+        H, ldh_,
+        T, ldt_,
+        alpha, alphar_, alphai_,
+        beta,
+        Q, ldq_,
+        Z, ldz_,
+        work_, lwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            alpha[i] = complex_t( alphar_[i], alphai_[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* H, int64_t ldh,
+    float* T, int64_t ldt,
+    std::complex<float>* alpha,
+    float* beta,
+    float* Q, int64_t ldq,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* H, int64_t ldh,
+    double* T, int64_t ldt,
+    std::complex<double>* alpha,
+    double* beta,
+    double* Q, int64_t ldq,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* H, int64_t ldh,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hgeqz_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* H, int64_t ldh,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* H, int64_t ldh,
+    float* T, int64_t ldt,
+    std::complex<float>* alpha,
+    float* beta,
+    float* Q, int64_t ldq,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* H, int64_t ldh,
+    double* T, int64_t ldt,
+    std::complex<double>* alpha,
+    double* beta,
+    double* Q, int64_t ldq,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* H, int64_t ldh,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* alpha,
+    std::complex<float>* beta,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* H, int64_t ldh,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* alpha,
+    std::complex<double>* beta,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -26,11 +27,16 @@ int64_t hpcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hpcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -38,7 +44,7 @@ int64_t hpcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_chpcon(
         &uplo_, &n_,
@@ -66,11 +72,16 @@ int64_t hpcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hpcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -78,7 +89,7 @@ int64_t hpcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_zhpcon(
         &uplo_, &n_,
@@ -95,4 +106,155 @@ int64_t hpcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hpcon(
+    char uplo, lapack_int n,
+    std::complex<float> const* AP,
+    lapack_int const* ipiv, float anorm, float* rcond,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_chpcon(
+        &uplo, &n,
+        (lapack_complex_float const*) AP,
+        ipiv, &anorm, rcond,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hpcon(
+    char uplo, lapack_int n,
+    std::complex<double> const* AP,
+    lapack_int const* ipiv, double anorm, double* rcond,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zhpcon(
+        &uplo, &n,
+        (lapack_complex_double const*) AP,
+        ipiv, &anorm, rcond,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hpcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hpcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hpcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hpcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    int64_t const* ipiv, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hpcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_hpcon(
+        uplo_, n_,
+        AP,
+        ipiv_ptr, anorm, rcond,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP, float anorm,
+    size_t* work_size );
+
+template
+void hpcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP,
+    int64_t const* ipiv, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t hpcon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP,
+    int64_t const* ipiv, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
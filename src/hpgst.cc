@@ -25,6 +25,11 @@ int64_t hpgst(
         lapack_error_if( std::abs(itype) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hpgst", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int itype_ = (lapack_int) itype;
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -55,6 +60,11 @@ int64_t hpgst(
         lapack_error_if( std::abs(itype) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hpgst", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int itype_ = (lapack_int) itype;
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
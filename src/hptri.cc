@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -25,11 +26,16 @@ int64_t hptri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hptri", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -37,7 +43,7 @@ int64_t hptri(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
 
     LAPACK_chptri(
         &uplo_, &n_,
@@ -64,11 +70,16 @@ int64_t hptri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hptri", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
+        lapack::small_vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(n)] );
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -76,7 +87,7 @@ int64_t hptri(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
 
     LAPACK_zhptri(
         &uplo_, &n_,
@@ -93,4 +104,152 @@ int64_t hptri(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_hptri(
+    char uplo, lapack_int n,
+    std::complex<float>* AP,
+    lapack_int const* ipiv,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_chptri(
+        &uplo, &n,
+        (lapack_complex_float*) AP,
+        ipiv,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hptri(
+    char uplo, lapack_int n,
+    std::complex<double>* AP,
+    lapack_int const* ipiv,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zhptri(
+        &uplo, &n,
+        (lapack_complex_double*) AP,
+        ipiv,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hptri with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< scalar_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hptri, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hptri for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hptri_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hptri", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* ipiv_ = buffer.take< lapack_int >( n );
+        std::copy( ipiv, ipiv + n, ipiv_ );
+        lapack_int const* ipiv_ptr = ipiv_;
+    #else
+        lapack_int const* ipiv_ptr = ipiv;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+
+    fortran_hptri(
+        uplo_, n_,
+        AP,
+        ipiv_ptr,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* AP,
+    size_t* work_size );
+
+template
+void hptri_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* AP,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
+template
+int64_t hptri(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* AP,
+    int64_t const* ipiv,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t hseqr(
         lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hseqr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -41,8 +47,8 @@ int64_t hseqr(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
+    lapack::small_vector< float > WR( max( 1, n ) );
+    lapack::small_vector< float > WI( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -64,7 +70,7 @@ int64_t hseqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_shseqr(
         &jobschur_, &compz_, &n_, &ilo_, &ihi_,
@@ -103,6 +109,11 @@ int64_t hseqr(
         lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hseqr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -113,8 +124,8 @@ int64_t hseqr(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
+    lapack::small_vector< double > WR( max( 1, n ) );
+    lapack::small_vector< double > WI( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -136,7 +147,7 @@ int64_t hseqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dhseqr(
         &jobschur_, &compz_, &n_, &ilo_, &ihi_,
@@ -154,7 +165,7 @@ int64_t hseqr(
     }
     // merge split-complex representation
     for (int64_t i = 0; i < n; ++i) {
-        W[i] = std::complex<float>( WR[i], WI[i] );
+        W[i] = std::complex<double>( WR[i], WI[i] );
     }
     return info_;
 }
@@ -175,6 +186,11 @@ int64_t hseqr(
         lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hseqr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -203,7 +219,7 @@ int64_t hseqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_chseqr(
         &jobschur_, &compz_, &n_, &ilo_, &ihi_,
@@ -364,6 +380,11 @@ int64_t hseqr(
         lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "hseqr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobschur_ = jobschur2char( jobschur );
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
@@ -392,7 +413,7 @@ int64_t hseqr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zhseqr(
         &jobschur_, &compz_, &n_, &ilo_, &ihi_,
@@ -410,4 +431,299 @@ int64_t hseqr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (WR, WI)
+// and don't reference W; complex precisions return W directly
+// and don't reference WR or WI.
+static void fortran_hseqr(
+    char jobschur, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    float* H, lapack_int ldh,
+    std::complex<float>* W, float* WR, float* WI,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_shseqr(
+        &jobschur, &compz, &n, &ilo, &ihi,
+        H, &ldh,
+        WR, WI,
+        Z, &ldz,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hseqr(
+    char jobschur, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    double* H, lapack_int ldh,
+    std::complex<double>* W, double* WR, double* WI,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dhseqr(
+        &jobschur, &compz, &n, &ilo, &ihi,
+        H, &ldh,
+        WR, WI,
+        Z, &ldz,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hseqr(
+    char jobschur, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<float>* H, lapack_int ldh,
+    std::complex<float>* W, float* WR, float* WI,
+    std::complex<float>* Z, lapack_int ldz,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_chseqr(
+        &jobschur, &compz, &n, &ilo, &ihi,
+        (lapack_complex_float*) H, &ldh,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) Z, &ldz,
+        (lapack_complex_float*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_hseqr(
+    char jobschur, char compz,
+    lapack_int n, lapack_int ilo, lapack_int ihi,
+    std::complex<double>* H, lapack_int ldh,
+    std::complex<double>* W, double* WR, double* WI,
+    std::complex<double>* Z, lapack_int ldz,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zhseqr(
+        &jobschur, &compz, &n, &ilo, &ihi,
+        (lapack_complex_double*) H, &ldh,
+        (lapack_complex_double*) W,
+        (lapack_complex_double*) Z, &ldz,
+        (lapack_complex_double*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by hseqr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobschur_ = jobschur2char( jobschur );
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int ldh_ = (lapack_int) ldh;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int ineg_one = -1;
+    fortran_hseqr(
+        jobschur_, compz_, n_, ilo_, ihi_,
+        H, ldh_,
+        W, qry_WR, qry_WI,
+        Z, ldz_,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WR
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WI
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::hseqr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::hseqr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     hseqr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    scalar_t* H, int64_t ldh,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldh) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "hseqr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobschur_ = jobschur2char( jobschur );
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int ldh_ = (lapack_int) ldh;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* WR = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* WI = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_hseqr(
+        jobschur_, compz_, n_, ilo_, ihi_,
+        H, ldh_,
+        W, WR, WI,
+        Z, ldz_,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            W[i] = complex_t( WR[i], WI[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* H, int64_t ldh,
+    std::complex<float>* W,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* H, int64_t ldh,
+    std::complex<double>* W,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* H, int64_t ldh,
+    std::complex<float>* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void hseqr_work_size_bytes(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* H, int64_t ldh,
+    std::complex<double>* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* H, int64_t ldh,
+    std::complex<float>* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* H, int64_t ldh,
+    std::complex<double>* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* H, int64_t ldh,
+    std::complex<float>* W,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* H, int64_t ldh,
+    std::complex<double>* W,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
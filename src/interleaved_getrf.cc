@@ -0,0 +1,409 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "lapack/interleaved.hh"
+#include "interleaved_kernels.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+namespace interleaved {
+
+//------------------------------------------------------------------------------
+// LU factorization with partial pivoting of one group, right-looking and
+// unblocked, as in getf2, with each operation done on all W lanes.
+// Pivots are chosen per lane with the same rule as LAPACK (first entry of
+// largest |Re| + |Im|), so they match getrf's. Pivots of lane l are stored
+// at ipiv + l*stride_ipiv, for lanes l < nlanes. Sets info[ l ] for each lane.
+template <typename scalar_t>
+LAPACK_SIMD_CLONES
+void getrf_group(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t* info )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    constexpr int64_t W = lapack::interleaved::lanes<scalar_t>();
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t sfmin = std::numeric_limits< real_t >::min();
+    int64_t minmn = std::min( m, n );
+
+    // W lanes of element (i, j)
+    #define A(i_, j_) (&A[ ((i_) + (j_)*lda)*W ])
+
+    real_t amax[ W ];
+    int64_t piv[ W ];
+    scalar_t inv[ W ];
+    bool tiny[ W ];
+
+    for (int64_t l = 0; l < W; ++l)
+        info[ l ] = 0;
+
+    for (int64_t k = 0; k < minmn; ++k) {
+        // find pivot in column k, per lane
+        scalar_t const* Akk = A( k, k );
+        LAPACK_LANES
+        for (int64_t l = 0; l < W; ++l) {
+            amax[ l ] = abs1( Akk[ l ] );
+            piv[ l ] = k;
+        }
+        for (int64_t i = k+1; i < m; ++i) {
+            scalar_t const* Aik = A( i, k );
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l) {
+                real_t a = abs1( Aik[ l ] );
+                bool larger = a > amax[ l ];
+                amax[ l ] = larger ? a : amax[ l ];
+                piv[ l ]  = larger ? i : piv[ l ];
+            }
+        }
+        for (int64_t l = 0; l < nlanes; ++l)
+            ipiv[ l*stride_ipiv + k ] = piv[ l ] + 1;  // 1-based
+
+        // swap rows k and piv, lane by lane
+        for (int64_t l = 0; l < W; ++l) {
+            if (piv[ l ] != k) {
+                for (int64_t j = 0; j < n; ++j)
+                    std::swap( A( k, j )[ l ], A( piv[ l ], j )[ l ] );
+            }
+        }
+
+        // scale column k below the diagonal; for a zero pivot, set info
+        // and don't scale, as getf2 does. As in getf2, multiply by the
+        // reciprocal unless |pivot| < sfmin, where it could overflow;
+        // then divide, in a separate pass so the common case stays
+        // vectorized.
+        bool any_tiny = false;
+        for (int64_t l = 0; l < W; ++l) {
+            tiny[ l ] = false;
+            if (Akk[ l ] == zero) {
+                if (info[ l ] == 0)
+                    info[ l ] = k + 1;
+                inv[ l ] = one;
+            }
+            else if (std::abs( Akk[ l ] ) < sfmin) {
+                tiny[ l ] = true;
+                any_tiny = true;
+                inv[ l ] = one;
+            }
+            else {
+                inv[ l ] = one / Akk[ l ];
+            }
+        }
+        for (int64_t i = k+1; i < m; ++i) {
+            scalar_t* Aik = A( i, k );
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                Aik[ l ] *= inv[ l ];
+        }
+        if (any_tiny) {
+            for (int64_t l = 0; l < W; ++l) {
+                if (tiny[ l ]) {
+                    for (int64_t i = k+1; i < m; ++i)
+                        A( i, k )[ l ] /= Akk[ l ];
+                }
+            }
+        }
+
+        // rank-1 update of trailing matrix
+        for (int64_t j = k+1; j < n; ++j) {
+            scalar_t const* Akj = A( k, j );
+            for (int64_t i = k+1; i < m; ++i) {
+                scalar_t const* Aik = A( i, k );
+                scalar_t* Aij = A( i, j );
+                LAPACK_LANES
+                for (int64_t l = 0; l < W; ++l)
+                    Aij[ l ] -= Aik[ l ] * Akj[ l ];
+            }
+        }
+    }
+
+    #undef A
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_group(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t* info );
+
+template
+void getrf_group(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t* info );
+
+template
+void getrf_group(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t* info );
+
+template
+void getrf_group(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t* info );
+
+}  // namespace interleaved
+}  // namespace internal
+
+//==============================================================================
+namespace interleaved {
+
+using blas::max;
+using blas::min;
+using internal::interleaved::num_groups;
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations with partial pivoting of a batch of matrices
+/// in interleaved storage, using native SIMD kernels that factor W
+/// matrices at once:
+/// \[
+///     A_k = P_k L_k U_k.
+/// \]
+/// Pivots are chosen as in lapack::getrf, so they match getrf_batch's.
+/// See lapack::getrf.
+///
+/// @param[in] m
+///     Number of rows of each $A_k$.
+///
+/// @param[in] n
+///     Number of columns of each $A_k$.
+///
+/// @param[in,out] A
+///     Interleaved batch of m-by-n matrices.
+///     On exit, the factors L and U; the unit diagonal of L is not stored.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, m).
+///
+/// @param[out] ipiv
+///     The pivot vectors, not interleaved: those of $A_k$ are the
+///     min(m, n) entries starting at ipiv + k*stride_ipiv. Row i of $A_k$
+///     was interchanged with row ipiv(i). Indices are 1-based.
+///
+/// @param[in] stride_ipiv
+///     Distance between pivot vectors; stride_ipiv >= min(m, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ k ] = 0 for success, or i > 0 if
+///     $U_k(i, i)$ is exactly zero.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( stride_ipiv < min( m, n ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_getrf", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::getrf( m, n ); } );
+
+    const int64_t W = lanes<scalar_t>();
+    info.resize( batch );
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        int64_t info_g[ W ];
+        int64_t nlanes = min( W, int64_t( batch ) - g*W );
+        internal::interleaved::getrf_group(
+            m, n, &A[ g*lda*n*W ], lda,
+            &ipiv[ g*W*stride_ipiv ], stride_ipiv, nlanes, info_g );
+        std::copy( info_g, info_g + nlanes, &info[ g*W ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves systems of linear equations for a batch in interleaved storage,
+/// using the LU factorizations from interleaved::getrf:
+/// \[
+///     op(A_k) X_k = B_k.
+/// \]
+/// See lapack::getrs.
+///
+/// @param[in] trans
+///     The form of op(A): NoTrans, Trans, or ConjTrans.
+///
+/// @param[in] n
+///     Order of each $A_k$.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_k$.
+///
+/// @param[in] A
+///     Interleaved batch of LU factors from interleaved::getrf.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, n).
+///
+/// @param[in] ipiv
+///     The pivot vectors from interleaved::getrf; those of $A_k$ start
+///     at ipiv + k*stride_ipiv.
+///
+/// @param[in] stride_ipiv
+///     Distance between pivot vectors; stride_ipiv >= n.
+///
+/// @param[in,out] B
+///     Interleaved batch of n-by-nrhs right-hand side matrices.
+///     On exit, the solutions $X_k$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_k$; ldb >= max(1, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, all 0, as lapack::getrs returns.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Diag;
+
+    lapack_error_if( trans != Op::NoTrans && trans != Op::Trans
+                     && trans != Op::ConjTrans );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( stride_ipiv < n );
+    lapack_error_if( ldb < max( 1, n ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_getrs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return batch * Gflop< scalar_t >::getrs( n, nrhs ); } );
+
+    const int64_t W = lanes<scalar_t>();
+    const scalar_t one = 1;
+    info.assign( batch, 0 );
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        scalar_t const* A_g = &A[ g*lda*n*W ];
+        int64_t const* ipiv_g = &ipiv[ g*W*stride_ipiv ];
+        int64_t nlanes = min( W, int64_t( batch ) - g*W );
+        scalar_t* B_g = &B[ g*ldb*nrhs*W ];
+        if (trans == Op::NoTrans) {
+            // solve L U X = P^T B
+            internal::interleaved::laswp_group(
+                nrhs, B_g, ldb, 0, n, ipiv_g, stride_ipiv, nlanes, 1 );
+            internal::interleaved::trsm_group(
+                Side::Left, Uplo::Lower, Op::NoTrans, Diag::Unit,
+                n, nrhs, one, A_g, lda, B_g, ldb );
+            internal::interleaved::trsm_group(
+                Side::Left, Uplo::Upper, Op::NoTrans, Diag::NonUnit,
+                n, nrhs, one, A_g, lda, B_g, ldb );
+        }
+        else {
+            // solve U^T L^T P^T X = B, or with ^H
+            internal::interleaved::trsm_group(
+                Side::Left, Uplo::Upper, trans, Diag::NonUnit,
+                n, nrhs, one, A_g, lda, B_g, ldb );
+            internal::interleaved::trsm_group(
+                Side::Left, Uplo::Lower, trans, Diag::Unit,
+                n, nrhs, one, A_g, lda, B_g, ldb );
+            internal::interleaved::laswp_group(
+                nrhs, B_g, ldb, 0, n, ipiv_g, stride_ipiv, nlanes, -1 );
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv, int64_t stride_ipiv,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    float* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    double* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<float>* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<double>* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace interleaved
+}  // namespace lapack
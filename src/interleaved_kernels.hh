@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_INTERLEAVED_KERNELS_HH
+#define LAPACK_INTERLEAVED_KERNELS_HH
+
+#include "lapack/interleaved.hh"
+#include "simd.hh"
+
+#include <cmath>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+namespace interleaved {
+
+//------------------------------------------------------------------------------
+// |Re(x)| + |Im(x)|, as used by LAPACK's i?amax for pivoting.
+template <typename real_t>
+inline real_t abs1( real_t x )
+{
+    return std::abs( x );
+}
+
+template <typename real_t>
+inline real_t abs1( std::complex<real_t> x )
+{
+    return std::abs( x.real() ) + std::abs( x.imag() );
+}
+
+//------------------------------------------------------------------------------
+// Number of groups of W lanes holding batch matrices.
+template <typename scalar_t>
+inline int64_t num_groups( size_t batch )
+{
+    int64_t W = lapack::interleaved::lanes<scalar_t>();
+    return (int64_t( batch ) + W - 1) / W;
+}
+
+//------------------------------------------------------------------------------
+// Kernels on one group of W matrices in interleaved storage.
+// lda and ldb are in elements of one matrix, as in the public routines.
+
+template <typename scalar_t>
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb );
+
+// Applies row interchanges ipiv( k1 : k2-1 ) to the n columns of B,
+// forward if incr = 1, backward if incr = -1, as in laswp.
+// Pivots of lane l are at ipiv + l*stride_ipiv, for lanes l < nlanes;
+// padding lanes are not swapped.
+template <typename scalar_t>
+void laswp_group(
+    int64_t n, scalar_t* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr );
+
+}  // namespace interleaved
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_INTERLEAVED_KERNELS_HH
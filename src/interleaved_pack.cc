@@ -0,0 +1,368 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "lapack/interleaved.hh"
+#include "interleaved_kernels.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+namespace interleaved {
+
+using blas::max;
+using internal::interleaved::num_groups;
+
+//------------------------------------------------------------------------------
+// Copies matrices to interleaved storage, one group per task.
+// A( k ) returns the column-major matrix k, for k < batch.
+// Padding lanes get the identity.
+template <typename scalar_t, typename matrix_k>
+static void pack_groups(
+    int64_t m, int64_t n, matrix_k A, int64_t lda,
+    scalar_t* Ai, int64_t ldai, size_t batch )
+{
+    const int64_t W = lanes<scalar_t>();
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        scalar_t* Ai_g = &Ai[ g*ldai*n*W ];
+        int64_t nlanes = std::min( W, int64_t( batch ) - g*W );
+        for (int64_t l = 0; l < W; ++l) {
+            if (l < nlanes) {
+                scalar_t const* A_k = A( g*W + l );
+                for (int64_t j = 0; j < n; ++j)
+                    for (int64_t i = 0; i < m; ++i)
+                        Ai_g[ (i + j*ldai)*W + l ] = A_k[ i + j*lda ];
+            }
+            else {
+                for (int64_t j = 0; j < n; ++j)
+                    for (int64_t i = 0; i < m; ++i)
+                        Ai_g[ (i + j*ldai)*W + l ] = scalar_t( i == j ? 1 : 0 );
+            }
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Copies matrices from interleaved storage, one group per task.
+// A( k ) returns the column-major matrix k, for k < batch.
+template <typename scalar_t, typename matrix_k>
+static void unpack_groups(
+    int64_t m, int64_t n, scalar_t const* Ai, int64_t ldai,
+    matrix_k A, int64_t lda, size_t batch )
+{
+    const int64_t W = lanes<scalar_t>();
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        scalar_t const* Ai_g = &Ai[ g*ldai*n*W ];
+        int64_t nlanes = std::min( W, int64_t( batch ) - g*W );
+        for (int64_t l = 0; l < nlanes; ++l) {
+            scalar_t* A_k = A( g*W + l );
+            for (int64_t j = 0; j < n; ++j)
+                for (int64_t i = 0; i < m; ++i)
+                    A_k[ i + j*lda ] = Ai_g[ (i + j*ldai)*W + l ];
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Copies a batch of column-major matrices to interleaved storage,
+/// pointer-array variant.
+///
+/// @param[in] m
+///     Number of rows of each $A_k$.
+///
+/// @param[in] n
+///     Number of columns of each $A_k$.
+///
+/// @param[in] Aarray
+///     Pointers to the batch matrices $A_k$, each stored in an
+///     lda-by-n array.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, m).
+///
+/// @param[out] Ai
+///     The interleaved storage, of size( ldai, n, batch ) elements.
+///     Padding matrices in the last group are set to the identity.
+///
+/// @param[in] ldai
+///     Leading dimension of the interleaved matrices; ldai >= max(1, m).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void pack(
+    int64_t m, int64_t n,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    scalar_t* Ai, int64_t ldai,
+    size_t batch )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldai < max( 1, m ) );
+    internal::batch::check_array_size( Aarray, batch );
+
+    trace::internal::Block trace_block(
+        "interleaved_pack", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; },
+        [&]() {
+            return batch * Gbyte< scalar_t >::lacpy( MatrixType::General, m, n );
+        } );
+
+    pack_groups( m, n, [&]( int64_t k ) { return Aarray[ k ]; }, lda,
+                 Ai, ldai, batch );
+}
+
+//------------------------------------------------------------------------------
+/// Copies a batch of column-major matrices to interleaved storage,
+/// strided variant.
+///
+/// @param[in] A
+///     The batch matrices, with $A_k$ stored in an lda-by-n array
+///     starting at A + k*strideA.
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// See the pointer-array variant for the other arguments.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void pack(
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t* Ai, int64_t ldai,
+    size_t batch )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( ldai < max( 1, m ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_pack", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; },
+        [&]() {
+            return batch * Gbyte< scalar_t >::lacpy( MatrixType::General, m, n );
+        } );
+
+    pack_groups( m, n, [&]( int64_t k ) { return &A[ k*strideA ]; }, lda,
+                 Ai, ldai, batch );
+}
+
+//------------------------------------------------------------------------------
+/// Copies a batch of matrices from interleaved storage to column-major,
+/// pointer-array variant.
+///
+/// @param[in] m
+///     Number of rows of each $A_k$.
+///
+/// @param[in] n
+///     Number of columns of each $A_k$.
+///
+/// @param[in] Ai
+///     The interleaved storage.
+///
+/// @param[in] ldai
+///     Leading dimension of the interleaved matrices; ldai >= max(1, m).
+///
+/// @param[out] Aarray
+///     Pointers to the batch matrices $A_k$, each stored in an
+///     lda-by-n array.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, m).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void unpack(
+    int64_t m, int64_t n,
+    scalar_t const* Ai, int64_t ldai,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    size_t batch )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldai < max( 1, m ) );
+    lapack_error_if( lda < max( 1, m ) );
+    internal::batch::check_array_size( Aarray, batch );
+
+    trace::internal::Block trace_block(
+        "interleaved_unpack", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; },
+        [&]() {
+            return batch * Gbyte< scalar_t >::lacpy( MatrixType::General, m, n );
+        } );
+
+    unpack_groups( m, n, Ai, ldai,
+                   [&]( int64_t k ) { return Aarray[ k ]; }, lda, batch );
+}
+
+//------------------------------------------------------------------------------
+/// Copies a batch of matrices from interleaved storage to column-major,
+/// strided variant.
+///
+/// @param[out] A
+///     The batch matrices, with $A_k$ stored in an lda-by-n array
+///     starting at A + k*strideA.
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// See the pointer-array variant for the other arguments.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void unpack(
+    int64_t m, int64_t n,
+    scalar_t const* Ai, int64_t ldai,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    size_t batch )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldai < max( 1, m ) );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+
+    trace::internal::Block trace_block(
+        "interleaved_unpack", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; },
+        [&]() {
+            return batch * Gbyte< scalar_t >::lacpy( MatrixType::General, m, n );
+        } );
+
+    unpack_groups( m, n, Ai, ldai,
+                   [&]( int64_t k ) { return &A[ k*strideA ]; }, lda, batch );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pack(
+    int64_t m, int64_t n,
+    std::vector<float*> const& Aarray, int64_t lda,
+    float* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    std::vector<double*> const& Aarray, int64_t lda,
+    double* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    std::vector< std::complex<float>* > const& Aarray, int64_t lda,
+    std::complex<float>* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    std::vector< std::complex<double>* > const& Aarray, int64_t lda,
+    std::complex<double>* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    float const* A, int64_t lda, int64_t strideA,
+    float* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    double const* A, int64_t lda, int64_t strideA,
+    double* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float>* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void pack(
+    int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double>* Ai, int64_t ldai,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    float const* Ai, int64_t ldai,
+    std::vector<float*> const& Aarray, int64_t lda,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    double const* Ai, int64_t ldai,
+    std::vector<double*> const& Aarray, int64_t lda,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    std::complex<float> const* Ai, int64_t ldai,
+    std::vector< std::complex<float>* > const& Aarray, int64_t lda,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    std::complex<double> const* Ai, int64_t ldai,
+    std::vector< std::complex<double>* > const& Aarray, int64_t lda,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    float const* Ai, int64_t ldai,
+    float* A, int64_t lda, int64_t strideA,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    double const* Ai, int64_t ldai,
+    double* A, int64_t lda, int64_t strideA,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    std::complex<float> const* Ai, int64_t ldai,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    size_t batch );
+
+template
+void unpack(
+    int64_t m, int64_t n,
+    std::complex<double> const* Ai, int64_t ldai,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    size_t batch );
+
+}  // namespace interleaved
+}  // namespace lapack
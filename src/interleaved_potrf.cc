@@ -0,0 +1,333 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "lapack/interleaved.hh"
+#include "interleaved_kernels.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+namespace interleaved {
+
+//------------------------------------------------------------------------------
+// Cholesky factorization of one group, left-looking and unblocked, as in
+// potf2, with each operation done on all W lanes. Lanes can't stop
+// independently, so a lane that is not positive definite records
+// info[ l ] = j+1 at its first bad column and continues with ajj = 1.
+template <typename scalar_t>
+LAPACK_SIMD_CLONES
+void potrf_group(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* info )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    constexpr int64_t W = lapack::interleaved::lanes<scalar_t>();
+    bool lower = (uplo == Uplo::Lower);
+
+    // W lanes of element (i, j)
+    #define A(i_, j_) (&A[ ((i_) + (j_)*lda)*W ])
+
+    real_t ajj[ W ];
+    scalar_t sum[ W ];
+
+    for (int64_t l = 0; l < W; ++l)
+        info[ l ] = 0;
+
+    for (int64_t j = 0; j < n; ++j) {
+        // diagonal: ajj = A(j, j) - sum_k |L(j, k)|^2, or U(k, j)
+        scalar_t* Ajj = A( j, j );
+        LAPACK_LANES
+        for (int64_t l = 0; l < W; ++l)
+            ajj[ l ] = std::real( Ajj[ l ] );
+        for (int64_t k = 0; k < j; ++k) {
+            scalar_t const* Ajk = (lower ? A( j, k ) : A( k, j ));
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                ajj[ l ] -= std::real( Ajk[ l ] * blas::conj( Ajk[ l ] ) );
+        }
+        for (int64_t l = 0; l < W; ++l) {
+            // also catches NaN
+            if (! (ajj[ l ] > 0)) {
+                if (info[ l ] == 0)
+                    info[ l ] = j + 1;
+                ajj[ l ] = 1;
+            }
+        }
+        LAPACK_LANES
+        for (int64_t l = 0; l < W; ++l) {
+            ajj[ l ] = std::sqrt( ajj[ l ] );
+            Ajj[ l ] = ajj[ l ];
+        }
+
+        // off-diagonal, column j of L or row j of U
+        for (int64_t i = j+1; i < n; ++i) {
+            scalar_t* Aij = (lower ? A( i, j ) : A( j, i ));
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                sum[ l ] = Aij[ l ];
+            for (int64_t k = 0; k < j; ++k) {
+                if (lower) {
+                    scalar_t const* Aik = A( i, k );
+                    scalar_t const* Ajk = A( j, k );
+                    LAPACK_LANES
+                    for (int64_t l = 0; l < W; ++l)
+                        sum[ l ] -= Aik[ l ] * blas::conj( Ajk[ l ] );
+                }
+                else {
+                    scalar_t const* Aki = A( k, i );
+                    scalar_t const* Akj = A( k, j );
+                    LAPACK_LANES
+                    for (int64_t l = 0; l < W; ++l)
+                        sum[ l ] -= blas::conj( Akj[ l ] ) * Aki[ l ];
+                }
+            }
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                Aij[ l ] = sum[ l ] / ajj[ l ];
+        }
+    }
+
+    #undef A
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_group(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* info );
+
+template
+void potrf_group(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* info );
+
+template
+void potrf_group(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* info );
+
+template
+void potrf_group(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* info );
+
+}  // namespace interleaved
+}  // namespace internal
+
+//==============================================================================
+namespace interleaved {
+
+using blas::max;
+using blas::min;
+using internal::interleaved::num_groups;
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices in interleaved storage, using native SIMD kernels that
+/// factor W matrices at once:
+/// \[
+///     A_k = U_k^H U_k \text{ or } A_k = L_k L_k^H.
+/// \]
+/// See lapack::potrf.
+///
+/// Unlike lapack::potrf, the factorization of a matrix that is not
+/// positive definite continues past the failed column (all W matrices in a
+/// group are factored together), so the contents of $A_k$ are unspecified
+/// when info[ k ] > 0.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of each $A_k$ is stored;
+///     - lapack::Uplo::Lower: Lower triangle of each $A_k$ is stored.
+///
+/// @param[in] n
+///     Order of each $A_k$.
+///
+/// @param[in,out] A
+///     Interleaved batch of n-by-n matrices.
+///     On exit, if info[ k ] = 0, the factor $U_k$ or $L_k$.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ k ] = 0 for success, or i > 0 if
+///     the leading minor of order i of $A_k$ is not positive definite.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_potrf", trace::internal::precision< scalar_t >(), -1, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::potrf( n ); } );
+
+    const int64_t W = lanes<scalar_t>();
+    info.resize( batch );
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        int64_t info_g[ W ];
+        internal::interleaved::potrf_group(
+            uplo, n, &A[ g*lda*n*W ], lda, info_g );
+        int64_t nlanes = min( W, int64_t( batch ) - g*W );
+        std::copy( info_g, info_g + nlanes, &info[ g*W ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves systems of linear equations for a batch in interleaved storage,
+/// using the Cholesky factorizations from interleaved::potrf:
+/// \[
+///     A_k X_k = B_k.
+/// \]
+/// See lapack::potrs.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of each $A_k$ is stored;
+///     - lapack::Uplo::Lower: Lower triangle of each $A_k$ is stored.
+///
+/// @param[in] n
+///     Order of each $A_k$.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_k$.
+///
+/// @param[in] A
+///     Interleaved batch of Cholesky factors from interleaved::potrf.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, n).
+///
+/// @param[in,out] B
+///     Interleaved batch of n-by-nrhs right-hand side matrices.
+///     On exit, the solutions $X_k$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_k$; ldb >= max(1, n).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, all 0, as lapack::potrs returns.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using blas::Side;
+    using blas::Diag;
+
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_potrs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return batch * Gflop< scalar_t >::potrs( n, nrhs ); } );
+
+    const int64_t W = lanes<scalar_t>();
+    const scalar_t one = 1;
+    // solve L L^H X = B, or U^H U X = B
+    Op trans1 = (uplo == Uplo::Lower ? Op::NoTrans   : Op::ConjTrans);
+    Op trans2 = (uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans);
+    info.assign( batch, 0 );
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        scalar_t const* A_g = &A[ g*lda*n*W ];
+        scalar_t* B_g = &B[ g*ldb*nrhs*W ];
+        internal::interleaved::trsm_group(
+            Side::Left, uplo, trans1, Diag::NonUnit,
+            n, nrhs, one, A_g, lda, B_g, ldb );
+        internal::interleaved::trsm_group(
+            Side::Left, uplo, trans2, Diag::NonUnit,
+            n, nrhs, one, A_g, lda, B_g, ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace interleaved
+}  // namespace lapack
@@ -0,0 +1,409 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "lapack/interleaved.hh"
+#include "interleaved_kernels.hh"
+#include "ThreadPool.hh"
+
+#include <utility>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+namespace interleaved {
+
+//------------------------------------------------------------------------------
+// Triangular solve on one group, following the loop order of the
+// reference BLAS trsm, with each operation done on all W lanes.
+// For op(A) = A^H, elements of A are conjugated into a, per lane,
+// before use.
+template <typename scalar_t>
+LAPACK_SIMD_CLONES
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Op;
+
+    constexpr int64_t W = lapack::interleaved::lanes<scalar_t>();
+    const scalar_t one = 1;
+    bool nonunit = (diag == blas::Diag::NonUnit);
+    bool conj_A  = (trans == Op::ConjTrans);
+
+    // W lanes of element (i, j)
+    #define A(i_, j_) (&A[ ((i_) + (j_)*lda)*W ])
+    #define B(i_, j_) (&B[ ((i_) + (j_)*ldb)*W ])
+
+    // a = op(A(i, j)) in each lane
+    scalar_t a[ W ];
+    auto load_a = [&]( int64_t i, int64_t j ) {
+        scalar_t const* Aij = A( i, j );
+        if (conj_A) {
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                a[ l ] = blas::conj( Aij[ l ] );
+        }
+        else {
+            LAPACK_LANES
+            for (int64_t l = 0; l < W; ++l)
+                a[ l ] = Aij[ l ];
+        }
+    };
+    // column j of B *= alpha
+    auto scale_col = [&]( int64_t j ) {
+        if (alpha != one) {
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t* Bij = B( i, j );
+                LAPACK_LANES
+                for (int64_t l = 0; l < W; ++l)
+                    Bij[ l ] *= alpha;
+            }
+        }
+    };
+
+    if (side == Side::Left) {
+        if (trans == Op::NoTrans) {
+            // B = alpha A^{-1} B, column by column
+            for (int64_t j = 0; j < n; ++j) {
+                scale_col( j );
+                for (int64_t kk = 0; kk < m; ++kk) {
+                    int64_t k = (uplo == Uplo::Upper ? m-1 - kk : kk);
+                    scalar_t* Bkj = B( k, j );
+                    if (nonunit) {
+                        scalar_t const* Akk = A( k, k );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bkj[ l ] /= Akk[ l ];
+                    }
+                    int64_t ibegin = (uplo == Uplo::Upper ? 0 : k+1);
+                    int64_t iend   = (uplo == Uplo::Upper ? k : m);
+                    for (int64_t i = ibegin; i < iend; ++i) {
+                        scalar_t const* Aik = A( i, k );
+                        scalar_t* Bij = B( i, j );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bij[ l ] -= Bkj[ l ] * Aik[ l ];
+                    }
+                }
+            }
+        }
+        else {
+            // B = alpha A^{-T} B or alpha A^{-H} B, by dot products
+            scalar_t t[ W ];
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t ii = 0; ii < m; ++ii) {
+                    int64_t i = (uplo == Uplo::Upper ? ii : m-1 - ii);
+                    scalar_t* Bij = B( i, j );
+                    LAPACK_LANES
+                    for (int64_t l = 0; l < W; ++l)
+                        t[ l ] = alpha * Bij[ l ];
+                    int64_t kbegin = (uplo == Uplo::Upper ? 0 : i+1);
+                    int64_t kend   = (uplo == Uplo::Upper ? i : m);
+                    for (int64_t k = kbegin; k < kend; ++k) {
+                        load_a( k, i );
+                        scalar_t const* Bkj = B( k, j );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            t[ l ] -= a[ l ] * Bkj[ l ];
+                    }
+                    if (nonunit) {
+                        load_a( i, i );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            t[ l ] /= a[ l ];
+                    }
+                    LAPACK_LANES
+                    for (int64_t l = 0; l < W; ++l)
+                        Bij[ l ] = t[ l ];
+                }
+            }
+        }
+    }
+    else {
+        if (trans == Op::NoTrans) {
+            // B = alpha B A^{-1}, column by column
+            for (int64_t jj = 0; jj < n; ++jj) {
+                int64_t j = (uplo == Uplo::Upper ? jj : n-1 - jj);
+                scale_col( j );
+                int64_t kbegin = (uplo == Uplo::Upper ? 0 : j+1);
+                int64_t kend   = (uplo == Uplo::Upper ? j : n);
+                for (int64_t k = kbegin; k < kend; ++k) {
+                    scalar_t const* Akj = A( k, j );
+                    for (int64_t i = 0; i < m; ++i) {
+                        scalar_t const* Bik = B( i, k );
+                        scalar_t* Bij = B( i, j );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bij[ l ] -= Akj[ l ] * Bik[ l ];
+                    }
+                }
+                if (nonunit) {
+                    scalar_t const* Ajj = A( j, j );
+                    for (int64_t i = 0; i < m; ++i) {
+                        scalar_t* Bij = B( i, j );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bij[ l ] /= Ajj[ l ];
+                    }
+                }
+            }
+        }
+        else {
+            // B = alpha B A^{-T} or alpha B A^{-H}
+            for (int64_t kk = 0; kk < n; ++kk) {
+                int64_t k = (uplo == Uplo::Upper ? n-1 - kk : kk);
+                if (nonunit) {
+                    load_a( k, k );
+                    for (int64_t i = 0; i < m; ++i) {
+                        scalar_t* Bik = B( i, k );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bik[ l ] /= a[ l ];
+                    }
+                }
+                int64_t jbegin = (uplo == Uplo::Upper ? 0 : k+1);
+                int64_t jend   = (uplo == Uplo::Upper ? k : n);
+                for (int64_t j = jbegin; j < jend; ++j) {
+                    load_a( j, k );
+                    for (int64_t i = 0; i < m; ++i) {
+                        scalar_t const* Bik = B( i, k );
+                        scalar_t* Bij = B( i, j );
+                        LAPACK_LANES
+                        for (int64_t l = 0; l < W; ++l)
+                            Bij[ l ] -= a[ l ] * Bik[ l ];
+                    }
+                }
+                scale_col( k );
+            }
+        }
+    }
+
+    #undef A
+    #undef B
+}
+
+//------------------------------------------------------------------------------
+// Row interchanges on one group. Each lane has its own pivots, so swaps
+// are done lane by lane; this is O(n) per pivot, versus O(n^2) flops per
+// column in getrf and getrs.
+template <typename scalar_t>
+void laswp_group(
+    int64_t n, scalar_t* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr )
+{
+    constexpr int64_t W = lapack::interleaved::lanes<scalar_t>();
+    int64_t kbegin = (incr > 0 ? k1   : k2-1);
+    int64_t kend   = (incr > 0 ? k2   : k1-1);
+    for (int64_t k = kbegin; k != kend; k += incr) {
+        for (int64_t l = 0; l < nlanes; ++l) {
+            int64_t p = ipiv[ l*stride_ipiv + k ] - 1;  // 0-based
+            if (p != k) {
+                for (int64_t j = 0; j < n; ++j)
+                    std::swap( B[ (k + j*ldb)*W + l ], B[ (p + j*ldb)*W + l ] );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda,
+    float* B, int64_t ldb );
+
+template
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda,
+    double* B, int64_t ldb );
+
+template
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb );
+
+template
+void trsm_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb );
+
+template
+void laswp_group(
+    int64_t n, float* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr );
+
+template
+void laswp_group(
+    int64_t n, double* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr );
+
+template
+void laswp_group(
+    int64_t n, std::complex<float>* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr );
+
+template
+void laswp_group(
+    int64_t n, std::complex<double>* B, int64_t ldb,
+    int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t nlanes,
+    int64_t incr );
+
+}  // namespace interleaved
+}  // namespace internal
+
+//==============================================================================
+namespace interleaved {
+
+using blas::max;
+using internal::interleaved::num_groups;
+
+//------------------------------------------------------------------------------
+/// Solves a triangular matrix equation for a batch in interleaved storage,
+/// using native SIMD kernels that solve W systems at once:
+/// \[
+///     op(A_k) X_k = \alpha B_k \text{ or } X_k op(A_k) = \alpha B_k,
+/// \]
+/// overwriting $B_k$ with $X_k$. See blas::trsm.
+///
+/// @param[in] side
+///     Whether op(A) is on the left or right of X.
+///
+/// @param[in] uplo
+///     Whether each $A_k$ is upper or lower triangular.
+///
+/// @param[in] trans
+///     The form of op(A): NoTrans, Trans, or ConjTrans.
+///
+/// @param[in] diag
+///     Whether each $A_k$ has unit diagonal.
+///
+/// @param[in] m
+///     Number of rows of each $B_k$.
+///
+/// @param[in] n
+///     Number of columns of each $B_k$.
+///
+/// @param[in] alpha
+///     Scalar alpha.
+///
+/// @param[in] A
+///     Interleaved batch of triangular matrices, each ka-by-ka, where
+///     ka = m if side = Left, or ka = n if side = Right.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_k$; lda >= max(1, ka).
+///
+/// @param[in,out] B
+///     Interleaved batch of m-by-n matrices.
+///     On exit, overwritten by the solutions $X_k$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_k$; ldb >= max(1, m).
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @ingroup interleaved
+template <typename scalar_t>
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t batch )
+{
+    int64_t ka = (side == blas::Side::Left ? m : n);
+    lapack_error_if( side != blas::Side::Left && side != blas::Side::Right );
+    lapack_error_if( uplo != blas::Uplo::Lower && uplo != blas::Uplo::Upper );
+    lapack_error_if( trans != blas::Op::NoTrans && trans != blas::Op::Trans
+                     && trans != blas::Op::ConjTrans );
+    lapack_error_if( diag != blas::Diag::NonUnit && diag != blas::Diag::Unit );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, ka ) );
+    lapack_error_if( ldb < max( 1, m ) );
+
+    trace::internal::Block trace_block(
+        "interleaved_trsm", trace::internal::precision< scalar_t >(), m, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::trsm( side, m, n ); } );
+
+    const int64_t W = lanes<scalar_t>();
+    internal::parallel_for( num_groups<scalar_t>( batch ),
+                            [&]( int64_t g, int worker ) {
+        internal::interleaved::trsm_group(
+            side, uplo, trans, diag, m, n, alpha,
+            &A[ g*lda*ka*W ], lda, &B[ g*ldb*n*W ], ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t batch );
+
+template
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t batch );
+
+template
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t batch );
+
+template
+void trsm(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t batch );
+
+}  // namespace interleaved
+}  // namespace lapack
@@ -25,6 +25,11 @@ void lacgv(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lacgv", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -62,6 +67,11 @@ void lacgv(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lacgv", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
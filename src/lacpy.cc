@@ -4,16 +4,11 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "copy_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
 /// @ingroup initialize
 void lacpy(
@@ -21,27 +16,12 @@ void lacpy(
     float const* A, int64_t lda,
     float* B, int64_t ldb )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldb_ = (lapack_int) ldb;
-
-    LAPACK_slacpy(
-        &matrixtype_, &m_, &n_,
-        A, &lda_,
-        B, &ldb_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    trace::internal::Block trace_block(
+        "lacpy", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, Op::NoTrans, m, n, float( 1 ), A, lda, B, ldb );
 }
 
 // -----------------------------------------------------------------------------
@@ -51,27 +31,12 @@ void lacpy(
     double const* A, int64_t lda,
     double* B, int64_t ldb )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldb_ = (lapack_int) ldb;
-
-    LAPACK_dlacpy(
-        &matrixtype_, &m_, &n_,
-        A, &lda_,
-        B, &ldb_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    trace::internal::Block trace_block(
+        "lacpy", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, Op::NoTrans, m, n, double( 1 ), A, lda, B, ldb );
 }
 
 // -----------------------------------------------------------------------------
@@ -81,27 +46,12 @@ void lacpy(
     std::complex<float> const* A, int64_t lda,
     std::complex<float>* B, int64_t ldb )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldb_ = (lapack_int) ldb;
-
-    LAPACK_clacpy(
-        &matrixtype_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) B, &ldb_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    trace::internal::Block trace_block(
+        "lacpy", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, Op::NoTrans, m, n, std::complex<float>( 1 ), A, lda, B, ldb );
 }
 
 // -----------------------------------------------------------------------------
@@ -145,27 +95,123 @@ void lacpy(
     std::complex<double> const* A, int64_t lda,
     std::complex<double>* B, int64_t ldb )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldb_ = (lapack_int) ldb;
-
-    LAPACK_zlacpy(
-        &matrixtype_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) B, &ldb_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    trace::internal::Block trace_block(
+        "lacpy", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, Op::NoTrans, m, n, std::complex<double>( 1 ), A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup initialize
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    float alpha, float const* A, int64_t lda,
+    float* B, int64_t ldb )
+{
+    trace::internal::Block trace_block(
+        "lacpy", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup initialize
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    double alpha, double const* A, int64_t lda,
+    double* B, int64_t ldb )
+{
+    trace::internal::Block trace_block(
+        "lacpy", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup initialize
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<float> alpha, std::complex<float> const* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb )
+{
+    trace::internal::Block trace_block(
+        "lacpy", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// Copies all or part of a two-dimensional matrix A to another
+/// matrix B, scaling and transposing it on the fly:
+/// $B = \alpha op(A)$.
+/// This fuses lacpy with a following scaling or transpose, so the data is
+/// read and written once.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] matrixtype
+///     Specifies the part of the matrix A to be copied to B.
+///     - lapack::MatrixType::Upper: Upper triangular part
+///     - lapack::MatrixType::Lower: Lower triangular part
+///     - lapack::MatrixType::General: All of the matrix A
+///
+/// @param[in] trans
+///     The operation op(A):
+///     - lapack::Op::NoTrans:   $op(A) = A$;
+///     - lapack::Op::Trans:     $op(A) = A^T$;
+///     - lapack::Op::ConjTrans: $op(A) = A^H$.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha. If alpha = 1, elements are copied exactly.
+///
+/// @param[in] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     - If matrixtype = Upper, only the upper trapezium is accessed;
+///     - if matrixtype = Lower, only the lower trapezium is accessed.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] B
+///     - If trans = NoTrans, the m-by-n matrix B, stored in an ldb-by-n array;
+///     - otherwise, the n-by-m matrix B, stored in an ldb-by-m array.
+///
+///     On exit, $B = \alpha op(A)$ in the locations specified by
+///     matrixtype, transposed if trans != NoTrans. For instance, with
+///     matrixtype = Upper and trans = Trans, the lower trapezium of B is set.
+///
+/// @param[in] ldb
+///     The leading dimension of the array B.
+///     - If trans = NoTrans, ldb >= max(1,m);
+///     - otherwise,          ldb >= max(1,n).
+///
+/// @ingroup initialize
+void lacpy(
+    lapack::MatrixType matrixtype, lapack::Op trans, int64_t m, int64_t n,
+    std::complex<double> alpha, std::complex<double> const* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb )
+{
+    trace::internal::Block trace_block(
+        "lacpy", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lacpy( matrixtype, m, n ); } );
+
+    internal::lacpy( matrixtype, trans, m, n, alpha, A, lda, B, ldb );
 }
 
 }  // namespace lapack
@@ -28,6 +28,11 @@ int64_t laed4(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "laed4", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int i_ = (lapack_int) i + 1;  // change to 1-based
     lapack_int info_ = 0;
@@ -109,6 +114,11 @@ int64_t laed4(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "laed4", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int i_ = (lapack_int) i + 1;  // change to 1-based
     lapack_int info_ = 0;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #ifdef LAPACK_HAVE_MATGEN
 
@@ -32,6 +33,11 @@ int64_t lagge(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagge", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -39,7 +45,7 @@ int64_t lagge(
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -47,7 +53,7 @@ int64_t lagge(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (m+n) );
+    lapack::small_vector< float > work( (m+n) );
 
     LAPACK_slagge(
         &m_, &n_, &kl_, &ku_,
@@ -79,6 +85,11 @@ int64_t lagge(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagge", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -86,7 +97,7 @@ int64_t lagge(
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -94,7 +105,7 @@ int64_t lagge(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (m+n) );
+    lapack::small_vector< double > work( (m+n) );
 
     LAPACK_dlagge(
         &m_, &n_, &kl_, &ku_,
@@ -126,6 +137,11 @@ int64_t lagge(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagge", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -133,7 +149,7 @@ int64_t lagge(
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -141,7 +157,7 @@ int64_t lagge(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (m+n) );
+    lapack::small_vector< std::complex<float> > work( (m+n) );
 
     LAPACK_clagge(
         &m_, &n_, &kl_, &ku_,
@@ -173,6 +189,11 @@ int64_t lagge(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagge", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -180,7 +201,7 @@ int64_t lagge(
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -188,7 +209,7 @@ int64_t lagge(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (m+n) );
+    lapack::small_vector< std::complex<double> > work( (m+n) );
 
     LAPACK_zlagge(
         &m_, &n_, &kl_, &ku_,
@@ -205,6 +226,233 @@ int64_t lagge(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_lagge(
+    lapack_int m, lapack_int n, lapack_int kl, lapack_int ku,
+    float const* D,
+    float* A, lapack_int lda,
+    lapack_int* iseed,
+    float* work, lapack_int* info )
+{
+    LAPACK_slagge(
+        &m, &n, &kl, &ku,
+        D,
+        A, &lda,
+        iseed,
+        work, info );
+}
+
+//----------
+static void fortran_lagge(
+    lapack_int m, lapack_int n, lapack_int kl, lapack_int ku,
+    double const* D,
+    double* A, lapack_int lda,
+    lapack_int* iseed,
+    double* work, lapack_int* info )
+{
+    LAPACK_dlagge(
+        &m, &n, &kl, &ku,
+        D,
+        A, &lda,
+        iseed,
+        work, info );
+}
+
+//----------
+static void fortran_lagge(
+    lapack_int m, lapack_int n, lapack_int kl, lapack_int ku,
+    float const* D,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* iseed,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_clagge(
+        &m, &n, &kl, &ku,
+        D,
+        (lapack_complex_float*) A, &lda,
+        iseed,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_lagge(
+    lapack_int m, lapack_int n, lapack_int kl, lapack_int ku,
+    double const* D,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* iseed,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zlagge(
+        &m, &n, &kl, &ku,
+        D,
+        (lapack_complex_double*) A, &lda,
+        iseed,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lagge with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( 4 );
+    #endif
+    buffer.take< scalar_t >( m+n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lagge, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lagge for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lagge_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lagge", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* iseed_ = buffer.take< lapack_int >( 4 );
+        std::copy( iseed, iseed + 4, iseed_ );
+        lapack_int* iseed_ptr = iseed_;
+    #else
+        lapack_int* iseed_ptr = iseed;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( m+n );
+
+    fortran_lagge(
+        m_, n_, kl_, ku_,
+        D,
+        A, lda_,
+        iseed_ptr,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( iseed_, iseed_ + 4, iseed );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float const* D,
+    float* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double const* D,
+    double* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float const* D,
+    std::complex<float>* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagge_work_size_bytes(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double const* D,
+    std::complex<double>* A, int64_t lda,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float const* D,
+    float* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double const* D,
+    double* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float const* D,
+    std::complex<float>* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagge(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double const* D,
+    std::complex<double>* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK_HAVE_MATGEN
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #ifdef LAPACK_HAVE_MATGEN
 
@@ -30,12 +31,17 @@ int64_t lagsy(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagsy", 's', -1, n, k,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int k_ = (lapack_int) k;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -43,7 +49,7 @@ int64_t lagsy(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_slagsy(
         &n_, &k_,
@@ -73,12 +79,17 @@ int64_t lagsy(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagsy", 'd', -1, n, k,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int k_ = (lapack_int) k;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -86,7 +97,7 @@ int64_t lagsy(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_dlagsy(
         &n_, &k_,
@@ -116,12 +127,17 @@ int64_t lagsy(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagsy", 'c', -1, n, k,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int k_ = (lapack_int) k;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -129,7 +145,7 @@ int64_t lagsy(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_clagsy(
         &n_, &k_,
@@ -159,12 +175,17 @@ int64_t lagsy(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lagsy", 'z', -1, n, k,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int k_ = (lapack_int) k;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -172,7 +193,7 @@ int64_t lagsy(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_zlagsy(
         &n_, &k_,
@@ -189,6 +210,227 @@ int64_t lagsy(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_lagsy(
+    lapack_int n, lapack_int k,
+    float const* D,
+    float* A, lapack_int lda,
+    lapack_int* iseed,
+    float* work, lapack_int* info )
+{
+    LAPACK_slagsy(
+        &n, &k,
+        D,
+        A, &lda,
+        iseed,
+        work, info );
+}
+
+//----------
+static void fortran_lagsy(
+    lapack_int n, lapack_int k,
+    double const* D,
+    double* A, lapack_int lda,
+    lapack_int* iseed,
+    double* work, lapack_int* info )
+{
+    LAPACK_dlagsy(
+        &n, &k,
+        D,
+        A, &lda,
+        iseed,
+        work, info );
+}
+
+//----------
+static void fortran_lagsy(
+    lapack_int n, lapack_int k,
+    float const* D,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* iseed,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_clagsy(
+        &n, &k,
+        D,
+        (lapack_complex_float*) A, &lda,
+        iseed,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_lagsy(
+    lapack_int n, lapack_int k,
+    double const* D,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* iseed,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_zlagsy(
+        &n, &k,
+        D,
+        (lapack_complex_double*) A, &lda,
+        iseed,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lagsy with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( 4 );
+    #endif
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lagsy, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lagsy for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lagsy_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t lagsy(
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> const* D,
+    scalar_t* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lagsy", trace::internal::precision< scalar_t >(), -1, n, k,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* iseed_ = buffer.take< lapack_int >( 4 );
+        std::copy( iseed, iseed + 4, iseed_ );
+        lapack_int* iseed_ptr = iseed_;
+    #else
+        lapack_int* iseed_ptr = iseed;
+    #endif
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_lagsy(
+        n_, k_,
+        D,
+        A, lda_,
+        iseed_ptr,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( iseed_, iseed_ + 4, iseed );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    float const* D,
+    float* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    double const* D,
+    double* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    float const* D,
+    std::complex<float>* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lagsy_work_size_bytes(
+    int64_t n, int64_t k,
+    double const* D,
+    std::complex<double>* A, int64_t lda,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t lagsy(
+    int64_t n, int64_t k,
+    float const* D,
+    float* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagsy(
+    int64_t n, int64_t k,
+    double const* D,
+    double* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagsy(
+    int64_t n, int64_t k,
+    float const* D,
+    std::complex<float>* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
+template
+int64_t lagsy(
+    int64_t n, int64_t k,
+    double const* D,
+    std::complex<double>* A, int64_t lda,
+    int64_t* iseed,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK_HAVE_MATGEN
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,6 +29,11 @@ float langb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langb", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -38,7 +44,7 @@ float langb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slangb(
         &norm_, &n_, &kl_, &ku_,
@@ -63,6 +69,11 @@ double langb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langb", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -73,7 +84,7 @@ double langb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlangb(
         &norm_, &n_, &kl_, &ku_,
@@ -98,6 +109,11 @@ float langb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langb", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -108,7 +124,7 @@ float langb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clangb(
         &norm_, &n_, &kl_, &ku_,
@@ -167,6 +183,11 @@ double langb(
         lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langb", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int kl_ = (lapack_int) kl;
@@ -177,7 +198,7 @@ double langb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlangb(
         &norm_, &n_, &kl_, &ku_,
@@ -189,4 +210,198 @@ double langb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_langb(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    float const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_slangb(
+        &norm, &n, &kl, &ku,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_langb(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    double const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_dlangb(
+        &norm, &n, &kl, &ku,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_langb(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    std::complex<float> const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_clangb(
+        &norm, &n, &kl, &ku,
+        (lapack_complex_float const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_langb(
+    char norm, lapack_int n, lapack_int kl, lapack_int ku,
+    std::complex<double> const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_zlangb(
+        &norm, &n, &kl, &ku,
+        (lapack_complex_double const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by langb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::langb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::langb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     langb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "langb", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kl_ = (lapack_int) kl;
+    lapack_int ku_ = (lapack_int) ku;
+    lapack_int ldab_ = (lapack_int) ldab;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+
+    return fortran_langb(
+        norm_, n_, kl_, ku_,
+        AB, ldab_,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    float const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    double const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float> const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void langb_work_size_bytes(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double> const* AB, int64_t ldab,
+    size_t* work_size );
+
+//--------------------
+template
+float langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    float const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    double const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+float langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double langb(
+    lapack::Norm norm, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -4,48 +4,23 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "norm_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
 /// @ingroup norm
 float lange(
     lapack::Norm norm, int64_t m, int64_t n,
     float const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
+    trace::internal::Block trace_block(
+        "lange", 's', m, n, -1,
+        [&]() { return Gflop< float >::lange( norm, m, n ); },
+        [&]() { return Gbyte< float >::lange( m, n ); } );
 
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
-
-    return LAPACK_slange(
-        &norm_, &m_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    return internal::lange( norm, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -54,31 +29,12 @@ double lange(
     lapack::Norm norm, int64_t m, int64_t n,
     double const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
+    trace::internal::Block trace_block(
+        "lange", 'd', m, n, -1,
+        [&]() { return Gflop< double >::lange( norm, m, n ); },
+        [&]() { return Gbyte< double >::lange( m, n ); } );
 
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
-
-    return LAPACK_dlange(
-        &norm_, &m_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    return internal::lange( norm, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -87,31 +43,12 @@ float lange(
     lapack::Norm norm, int64_t m, int64_t n,
     std::complex<float> const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
+    trace::internal::Block trace_block(
+        "lange", 'c', m, n, -1,
+        [&]() { return Gflop< std::complex<float> >::lange( norm, m, n ); },
+        [&]() { return Gbyte< std::complex<float> >::lange( m, n ); } );
 
-    return LAPACK_clange(
-        &norm_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    return internal::lange( norm, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -147,31 +84,12 @@ double lange(
     lapack::Norm norm, int64_t m, int64_t n,
     std::complex<double> const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
+    trace::internal::Block trace_block(
+        "lange", 'z', m, n, -1,
+        [&]() { return Gflop< std::complex<double> >::lange( norm, m, n ); },
+        [&]() { return Gbyte< std::complex<double> >::lange( m, n ); } );
 
-    return LAPACK_zlange(
-        &norm_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
+    return internal::lange( norm, m, n, A, lda );
 }
 
 }  // namespace lapack
@@ -26,6 +26,11 @@ float langt(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langt", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
 
@@ -52,6 +57,11 @@ double langt(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langt", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
 
@@ -78,6 +88,11 @@ float langt(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langt", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
 
@@ -134,6 +149,11 @@ double langt(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "langt", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
 
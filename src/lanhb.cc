@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,6 +28,11 @@ float lanhb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhb", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -37,7 +43,7 @@ float lanhb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clanhb(
         &norm_, &uplo_, &n_, &kd_,
@@ -104,6 +110,11 @@ double lanhb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhb", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -114,7 +125,7 @@ double lanhb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlanhb(
         &norm_, &uplo_, &n_, &kd_,
@@ -126,4 +137,140 @@ double lanhb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lanhb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    std::complex<float> const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_clanhb(
+        &norm, &uplo, &n, &kd,
+        (lapack_complex_float const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lanhb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    std::complex<double> const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_zlanhb(
+        &norm, &uplo, &n, &kd,
+        (lapack_complex_double const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lanhb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lanhb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lanhb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lanhb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lanhb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lanhb", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+
+    return fortran_lanhb(
+        norm_, uplo_, n_, kd_,
+        AB, ldab_,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lanhb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lanhb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab,
+    size_t* work_size );
+
+//--------------------
+template
+float lanhb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double lanhb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -25,6 +26,11 @@ float lanhp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhp", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -33,7 +39,7 @@ float lanhp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clanhp(
         &norm_, &uplo_, &n_,
@@ -91,6 +97,11 @@ double lanhp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhp", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -99,7 +110,7 @@ double lanhp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlanhp(
         &norm_, &uplo_, &n_,
@@ -111,4 +122,134 @@ double lanhp(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lanhp(
+    char norm, char uplo, lapack_int n,
+    std::complex<float> const* AP,
+    float* work )
+{
+    return LAPACK_clanhp(
+        &norm, &uplo, &n,
+        (lapack_complex_float const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lanhp(
+    char norm, char uplo, lapack_int n,
+    std::complex<double> const* AP,
+    double* work )
+{
+    return LAPACK_zlanhp(
+        &norm, &uplo, &n,
+        (lapack_complex_double const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lanhp with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lanhp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lanhp, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lanhp for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lanhp_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lanhp", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+
+    return fortran_lanhp(
+        norm_, uplo_, n_,
+        AP,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lanhp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP,
+    size_t* work_size );
+
+template
+void lanhp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP,
+    size_t* work_size );
+
+//--------------------
+template
+float lanhp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP,
+    void* work, size_t work_size );
+
+template
+double lanhp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -26,6 +27,11 @@ float lanhs(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhs", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -34,7 +40,7 @@ float lanhs(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slanhs(
         &norm_, &n_,
@@ -57,6 +63,11 @@ double lanhs(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhs", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -65,7 +76,7 @@ double lanhs(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlanhs(
         &norm_, &n_,
@@ -88,6 +99,11 @@ float lanhs(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhs", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -96,7 +112,7 @@ float lanhs(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clanhs(
         &norm_, &n_,
@@ -145,6 +161,11 @@ double lanhs(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lanhs", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -153,7 +174,7 @@ double lanhs(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlanhs(
         &norm_, &n_,
@@ -165,4 +186,192 @@ double lanhs(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lanhs(
+    char norm, lapack_int n,
+    float const* A, lapack_int lda,
+    float* work )
+{
+    return LAPACK_slanhs(
+        &norm, &n,
+        A, &lda,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lanhs(
+    char norm, lapack_int n,
+    double const* A, lapack_int lda,
+    double* work )
+{
+    return LAPACK_dlanhs(
+        &norm, &n,
+        A, &lda,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_lanhs(
+    char norm, lapack_int n,
+    std::complex<float> const* A, lapack_int lda,
+    float* work )
+{
+    return LAPACK_clanhs(
+        &norm, &n,
+        (lapack_complex_float const*) A, &lda,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lanhs(
+    char norm, lapack_int n,
+    std::complex<double> const* A, lapack_int lda,
+    double* work )
+{
+    return LAPACK_zlanhs(
+        &norm, &n,
+        (lapack_complex_double const*) A, &lda,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lanhs with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lanhs, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lanhs for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lanhs_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lanhs(
+    lapack::Norm norm, int64_t n,
+    scalar_t const* A, int64_t lda,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lanhs", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+
+    return fortran_lanhs(
+        norm_, n_,
+        A, lda_,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    float const* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    double const* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    size_t* work_size );
+
+template
+void lanhs_work_size_bytes(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    size_t* work_size );
+
+//--------------------
+template
+float lanhs(
+    lapack::Norm norm, int64_t n,
+    float const* A, int64_t lda,
+    void* work, size_t work_size );
+
+template
+double lanhs(
+    lapack::Norm norm, int64_t n,
+    double const* A, int64_t lda,
+    void* work, size_t work_size );
+
+template
+float lanhs(
+    lapack::Norm norm, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    void* work, size_t work_size );
+
+template
+double lanhs(
+    lapack::Norm norm, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,6 +28,11 @@ float lansb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansb", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -37,7 +43,7 @@ float lansb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slansb(
         &norm_, &uplo_, &n_, &kd_,
@@ -61,6 +67,11 @@ double lansb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansb", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -71,7 +82,7 @@ double lansb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlansb(
         &norm_, &uplo_, &n_, &kd_,
@@ -95,6 +106,11 @@ float lansb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansb", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -105,7 +121,7 @@ float lansb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clansb(
         &norm_, &uplo_, &n_, &kd_,
@@ -170,6 +186,11 @@ double lansb(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansb", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -180,7 +201,7 @@ double lansb(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlansb(
         &norm_, &uplo_, &n_, &kd_,
@@ -192,4 +213,196 @@ double lansb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lansb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    float const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_slansb(
+        &norm, &uplo, &n, &kd,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lansb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    double const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_dlansb(
+        &norm, &uplo, &n, &kd,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_lansb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    std::complex<float> const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_clansb(
+        &norm, &uplo, &n, &kd,
+        (lapack_complex_float const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lansb(
+    char norm, char uplo, lapack_int n, lapack_int kd,
+    std::complex<double> const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_zlansb(
+        &norm, &uplo, &n, &kd,
+        (lapack_complex_double const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lansb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lansb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lansb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lansb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lansb", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+
+    return fortran_lansb(
+        norm_, uplo_, n_, kd_,
+        AB, ldab_,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lansb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab,
+    size_t* work_size );
+
+//--------------------
+template
+float lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+float lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double lansb(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -25,6 +26,11 @@ float lansp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansp", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -33,7 +39,7 @@ float lansp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slansp(
         &norm_, &uplo_, &n_,
@@ -55,6 +61,11 @@ double lansp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansp", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -63,7 +74,7 @@ double lansp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlansp(
         &norm_, &uplo_, &n_,
@@ -85,6 +96,11 @@ float lansp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansp", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -93,7 +109,7 @@ float lansp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clansp(
         &norm_, &uplo_, &n_,
@@ -149,6 +165,11 @@ double lansp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lansp", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -157,7 +178,7 @@ double lansp(
     int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlansp(
         &norm_, &uplo_, &n_,
@@ -169,4 +190,190 @@ double lansp(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lansp(
+    char norm, char uplo, lapack_int n,
+    float const* AP,
+    float* work )
+{
+    return LAPACK_slansp(
+        &norm, &uplo, &n,
+        AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lansp(
+    char norm, char uplo, lapack_int n,
+    double const* AP,
+    double* work )
+{
+    return LAPACK_dlansp(
+        &norm, &uplo, &n,
+        AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_lansp(
+    char norm, char uplo, lapack_int n,
+    std::complex<float> const* AP,
+    float* work )
+{
+    return LAPACK_clansp(
+        &norm, &uplo, &n,
+        (lapack_complex_float const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lansp(
+    char norm, char uplo, lapack_int n,
+    std::complex<double> const* AP,
+    double* work )
+{
+    return LAPACK_zlansp(
+        &norm, &uplo, &n,
+        (lapack_complex_double const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lansp with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lansp, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lansp for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lansp_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lansp", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf || norm == Norm::One ? n : 1)) );
+
+    return fortran_lansp(
+        norm_, uplo_, n_,
+        AP,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    size_t* work_size );
+
+template
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    size_t* work_size );
+
+template
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP,
+    size_t* work_size );
+
+template
+void lansp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP,
+    size_t* work_size );
+
+//--------------------
+template
+float lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    void* work, size_t work_size );
+
+template
+double lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    void* work, size_t work_size );
+
+template
+float lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP,
+    void* work, size_t work_size );
+
+template
+double lansp(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -4,47 +4,23 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "norm_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
 /// @ingroup norm
 float lansy(
     lapack::Norm norm, lapack::Uplo uplo, int64_t n,
     float const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
+    trace::internal::Block trace_block(
+        "lansy", 's', -1, n, -1,
+        [&]() { return Gflop< float >::lansy( norm, n ); },
+        [&]() { return Gbyte< float >::lansy( n ); } );
 
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
-
-    return LAPACK_slansy(
-        &norm_, &uplo_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
+    return internal::lansy( norm, uplo, n, A, lda, false );
 }
 
 // -----------------------------------------------------------------------------
@@ -53,30 +29,12 @@ double lansy(
     lapack::Norm norm, lapack::Uplo uplo, int64_t n,
     double const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
+    trace::internal::Block trace_block(
+        "lansy", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::lansy( norm, n ); },
+        [&]() { return Gbyte< double >::lansy( n ); } );
 
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
-
-    return LAPACK_dlansy(
-        &norm_, &uplo_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
+    return internal::lansy( norm, uplo, n, A, lda, false );
 }
 
 // -----------------------------------------------------------------------------
@@ -85,30 +43,12 @@ float lansy(
     lapack::Norm norm, lapack::Uplo uplo, int64_t n,
     std::complex<float> const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
-
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
+    trace::internal::Block trace_block(
+        "lansy", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::lansy( norm, n ); },
+        [&]() { return Gbyte< std::complex<float> >::lansy( n ); } );
 
-    return LAPACK_clansy(
-        &norm_, &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
+    return internal::lansy( norm, uplo, n, A, lda, false );
 }
 
 // -----------------------------------------------------------------------------
@@ -159,30 +99,12 @@ double lansy(
     lapack::Norm norm, lapack::Uplo uplo, int64_t n,
     std::complex<double> const* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf || norm == Norm::One ? n : 1);
-
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
+    trace::internal::Block trace_block(
+        "lansy", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::lansy( norm, n ); },
+        [&]() { return Gbyte< std::complex<double> >::lansy( n ); } );
 
-    return LAPACK_zlansy(
-        &norm_, &uplo_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
+    return internal::lansy( norm, uplo, n, A, lda, false );
 }
 
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,6 +28,11 @@ float lantb(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantb", 's', -1, n, k,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -38,7 +44,7 @@ float lantb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slantb(
         &norm_, &uplo_, &diag_, &n_, &k_,
@@ -62,6 +68,11 @@ double lantb(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantb", 'd', -1, n, k,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -73,7 +84,7 @@ double lantb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlantb(
         &norm_, &uplo_, &diag_, &n_, &k_,
@@ -97,6 +108,11 @@ float lantb(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantb", 'c', -1, n, k,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -108,7 +124,7 @@ float lantb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clantb(
         &norm_, &uplo_, &diag_, &n_, &k_,
@@ -179,6 +195,11 @@ double lantb(
         lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantb", 'z', -1, n, k,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -190,7 +211,7 @@ double lantb(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlantb(
         &norm_, &uplo_, &diag_, &n_, &k_,
@@ -202,4 +223,207 @@ double lantb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lantb(
+    char norm, char uplo, char diag, lapack_int n, lapack_int k,
+    float const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_slantb(
+        &norm, &uplo, &diag, &n, &k,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lantb(
+    char norm, char uplo, char diag, lapack_int n, lapack_int k,
+    double const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_dlantb(
+        &norm, &uplo, &diag, &n, &k,
+        AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_lantb(
+    char norm, char uplo, char diag, lapack_int n, lapack_int k,
+    std::complex<float> const* AB, lapack_int ldab,
+    float* work )
+{
+    return LAPACK_clantb(
+        &norm, &uplo, &diag, &n, &k,
+        (lapack_complex_float const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lantb(
+    char norm, char uplo, char diag, lapack_int n, lapack_int k,
+    std::complex<double> const* AB, lapack_int ldab,
+    double* work )
+{
+    return LAPACK_zlantb(
+        &norm, &uplo, &diag, &n, &k,
+        (lapack_complex_double const*) AB, &ldab,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lantb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    scalar_t const* AB, int64_t ldab,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lantb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lantb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lantb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    scalar_t const* AB, int64_t ldab,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lantb", trace::internal::precision< scalar_t >(), -1, n, k,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    char diag_ = diag2char( diag );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int ldab_ = (lapack_int) ldab;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+
+    return fortran_lantb(
+        norm_, uplo_, diag_, n_, k_,
+        AB, ldab_,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    float const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    double const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    std::complex<float> const* AB, int64_t ldab,
+    size_t* work_size );
+
+template
+void lantb_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    std::complex<double> const* AB, int64_t ldab,
+    size_t* work_size );
+
+//--------------------
+template
+float lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    float const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    double const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+float lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    std::complex<float> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
+template
+double lantb(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    int64_t k,
+    std::complex<double> const* AB, int64_t ldab,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -25,6 +26,11 @@ float lantp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantp", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -34,7 +40,7 @@ float lantp(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_slantp(
         &norm_, &uplo_, &diag_, &n_,
@@ -56,6 +62,11 @@ double lantp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantp", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -65,7 +76,7 @@ double lantp(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_dlantp(
         &norm_, &uplo_, &diag_, &n_,
@@ -87,6 +98,11 @@ float lantp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantp", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -96,7 +112,7 @@ float lantp(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< float > work( max(1,lwork) );
+    lapack::small_vector< float > work( max(1,lwork) );
 
     return LAPACK_clantp(
         &norm_, &uplo_, &diag_, &n_,
@@ -157,6 +173,11 @@ double lantp(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "lantp", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char norm_ = norm2char( norm );
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
@@ -166,7 +187,7 @@ double lantp(
     int64_t lwork = (norm == Norm::Inf ? n : 1);
 
     // allocate workspace
-    lapack::vector< double > work( max(1,lwork) );
+    lapack::small_vector< double > work( max(1,lwork) );
 
     return LAPACK_zlantp(
         &norm_, &uplo_, &diag_, &n_,
@@ -178,4 +199,191 @@ double lantp(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static float fortran_lantp(
+    char norm, char uplo, char diag, lapack_int n,
+    float const* AP,
+    float* work )
+{
+    return LAPACK_slantp(
+        &norm, &uplo, &diag, &n,
+        AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lantp(
+    char norm, char uplo, char diag, lapack_int n,
+    double const* AP,
+    double* work )
+{
+    return LAPACK_dlantp(
+        &norm, &uplo, &diag, &n,
+        AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static float fortran_lantp(
+    char norm, char uplo, char diag, lapack_int n,
+    std::complex<float> const* AP,
+    float* work )
+{
+    return LAPACK_clantp(
+        &norm, &uplo, &diag, &n,
+        (lapack_complex_float const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static double fortran_lantp(
+    char norm, char uplo, char diag, lapack_int n,
+    std::complex<double> const* AP,
+    double* work )
+{
+    return LAPACK_zlantp(
+        &norm, &uplo, &diag, &n,
+        (lapack_complex_double const*) AP,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by lantp with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::lantp, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::lantp for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     lantp_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+blas::real_type<scalar_t> lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    scalar_t const* AP,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "lantp", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char norm_ = norm2char( norm );
+    char uplo_ = uplo2char( uplo );
+    char diag_ = diag2char( diag );
+    lapack_int n_ = (lapack_int) n;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max(1,(norm == Norm::Inf ? n : 1)) );
+
+    return fortran_lantp(
+        norm_, uplo_, diag_, n_,
+        AP,
+        work_ );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    float const* AP,
+    size_t* work_size );
+
+template
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    double const* AP,
+    size_t* work_size );
+
+template
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    std::complex<float> const* AP,
+    size_t* work_size );
+
+template
+void lantp_work_size_bytes(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    std::complex<double> const* AP,
+    size_t* work_size );
+
+//--------------------
+template
+float lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    float const* AP,
+    void* work, size_t work_size );
+
+template
+double lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    double const* AP,
+    void* work, size_t work_size );
+
+template
+float lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    std::complex<float> const* AP,
+    void* work, size_t work_size );
+
+template
+double lantp(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t n,
+    std::complex<double> const* AP,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -4,16 +4,12 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "norm_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
 using blas::min;
-using blas::real;
 
 // -----------------------------------------------------------------------------
 /// @ingroup norm
@@ -21,6 +17,11 @@ float lantr(
     lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t m, int64_t n,
     float const* A, int64_t lda )
 {
+    trace::internal::Block trace_block(
+        "lantr", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lantr( uplo, m, n ); } );
+
     lapack_error_if( lda < m );
 
     // Safeguard m, n.
@@ -29,33 +30,7 @@ float lantr(
     else
         m = min( m, n );
 
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    char diag_ = diag2char( diag );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
-
-    return LAPACK_slantr(
-        &norm_, &uplo_, &diag_, &m_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1, 1
-        #endif
-    );
+    return internal::lantr( norm, uplo, diag, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -64,6 +39,11 @@ double lantr(
     lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t m, int64_t n,
     double const* A, int64_t lda )
 {
+    trace::internal::Block trace_block(
+        "lantr", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lantr( uplo, m, n ); } );
+
     lapack_error_if( lda < m );
 
     // Safeguard m, n.
@@ -72,33 +52,7 @@ double lantr(
     else
         m = min( m, n );
 
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    char diag_ = diag2char( diag );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
-
-    return LAPACK_dlantr(
-        &norm_, &uplo_, &diag_, &m_, &n_,
-        A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1, 1
-        #endif
-    );
+    return internal::lantr( norm, uplo, diag, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -107,6 +61,11 @@ float lantr(
     lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t m, int64_t n,
     std::complex<float> const* A, int64_t lda )
 {
+    trace::internal::Block trace_block(
+        "lantr", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lantr( uplo, m, n ); } );
+
     lapack_error_if( lda < m );
 
     // Safeguard m, n.
@@ -115,33 +74,7 @@ float lantr(
     else
         m = min( m, n );
 
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    char diag_ = diag2char( diag );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< float > work( max( 1, lwork ) );
-
-    return LAPACK_clantr(
-        &norm_, &uplo_, &diag_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1, 1
-        #endif
-    );
+    return internal::lantr( norm, uplo, diag, m, n, A, lda );
 }
 
 // -----------------------------------------------------------------------------
@@ -207,6 +140,11 @@ double lantr(
     lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag, int64_t m, int64_t n,
     std::complex<double> const* A, int64_t lda )
 {
+    trace::internal::Block trace_block(
+        "lantr", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lantr( uplo, m, n ); } );
+
     lapack_error_if( lda < m );
 
     // Safeguard m, n.
@@ -215,33 +153,7 @@ double lantr(
     else
         m = min( m, n );
 
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char norm_ = norm2char( norm );
-    char uplo_ = uplo2char( uplo );
-    char diag_ = diag2char( diag );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-
-    // from docs
-    int64_t lwork = (norm == Norm::Inf ? m : 1);
-
-    // allocate workspace
-    lapack::vector< double > work( max( 1, lwork ) );
-
-    return LAPACK_zlantr(
-        &norm_, &uplo_, &diag_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        &work[0]
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1, 1
-        #endif
-    );
+    return internal::lantr( norm, uplo, diag, m, n, A, lda );
 }
 
 }  // namespace lapack
@@ -4,151 +4,208 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
-
-#if LAPACK_VERSION >= 30300  // >= v3.3
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "permute_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmr(
     bool forwrd, int64_t m, int64_t n,
     float* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(m)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_slapmr(
-        &forwrd_, &m_, &n_,
-        X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmr", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmr(
     bool forwrd, int64_t m, int64_t n,
     double* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(m)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_dlapmr(
-        &forwrd_, &m_, &n_,
-        X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmr", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmr(
     bool forwrd, int64_t m, int64_t n,
     std::complex<float>* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(m)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_clapmr(
-        &forwrd_, &m_, &n_,
-        (lapack_complex_float*) X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmr", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// Rearranges the rows of the m-by-n matrix X as specified by the
+/// permutation K(1), K(2), ..., K(m) of the integers 1, ..., m.
+/// - If forwrd = true,  forward permutation:
+///   X(K(i), *) is moved to X(i, *) for i = 1, 2, ..., m.
+/// - If forwrd = false, backward permutation:
+///   X(i, *) is moved to X(K(i), *) for i = 1, 2, ..., m.
+///
+/// The permutation is split into cycles, and rows are moved along each
+/// cycle in place, one column at a time, with columns spread over
+/// threads. Rows not moved by K are not touched.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] forwrd
+///     - true:  forward permutation
+///     - false: backward permutation
+///
+/// @param[in] m
+///     The number of rows of the matrix X. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix X. n >= 0.
+///
+/// @param[in,out] X
+///     The m-by-n matrix X, stored in an ldx-by-n array.
+///     On entry, the m-by-n matrix X.
+///     On exit, X contains the permuted matrix X.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X, ldx >= max(1,m).
+///
+/// @param[in] K
+///     The vector K of length m.
+///     On entry, K contains the permutation vector. Unlike LAPACK's
+///     lapmr, K is not used as workspace; it must be a permutation of
+///     1, ..., m, otherwise an exception is thrown.
+///
+/// @ingroup auxiliary
 void lapmr(
     bool forwrd, int64_t m, int64_t n,
     std::complex<double>* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(m)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_zlapmr(
-        &forwrd_, &m_, &n_,
-        (lapack_complex_double*) X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmr", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K );
 }
 
-}  // namespace lapack
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmr", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmr", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmr", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K, Y, ldy );
+}
 
-#endif  // LAPACK >= v3.3
+// -----------------------------------------------------------------------------
+/// Copies the m-by-n matrix X to Y, rearranging its rows as specified by
+/// the permutation K(1), K(2), ..., K(m) of the integers 1, ..., m.
+/// This out-of-place version gathers each column of Y from X in one pass.
+/// - If forwrd = true,  forward permutation:
+///   Y(i, *) = X(K(i), *) for i = 1, 2, ..., m.
+/// - If forwrd = false, backward permutation:
+///   Y(K(i), *) = X(i, *) for i = 1, 2, ..., m.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] forwrd
+///     - true:  forward permutation
+///     - false: backward permutation
+///
+/// @param[in] m
+///     The number of rows of the matrices X and Y. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrices X and Y. n >= 0.
+///
+/// @param[in] X
+///     The m-by-n matrix X, stored in an ldx-by-n array.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X, ldx >= max(1,m).
+///
+/// @param[in] K
+///     The permutation vector K of length m.
+///
+/// @param[out] Y
+///     The m-by-n matrix Y, stored in an ldy-by-n array.
+///     On exit, Y contains the permuted matrix X. Y must not overlap X.
+///
+/// @param[in] ldy
+///     The leading dimension of the array Y, ldy >= max(1,m).
+///
+/// @ingroup auxiliary
+void lapmr(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmr", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lapmr( m, n ); } );
+
+    internal::lapmr( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+}  // namespace lapack
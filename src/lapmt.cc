@@ -4,147 +4,208 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "permute_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmt(
     bool forwrd, int64_t m, int64_t n,
     float* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(n)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_slapmt(
-        &forwrd_, &m_, &n_,
-        X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmt", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmt(
     bool forwrd, int64_t m, int64_t n,
     double* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(n)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_dlapmt(
-        &forwrd_, &m_, &n_,
-        X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmt", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// @ingroup auxiliary
 void lapmt(
     bool forwrd, int64_t m, int64_t n,
     std::complex<float>* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(n)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_clapmt(
-        &forwrd_, &m_, &n_,
-        (lapack_complex_float*) X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmt", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K );
 }
 
 // -----------------------------------------------------------------------------
+/// Rearranges the columns of the m-by-n matrix X as specified by the
+/// permutation K(1), K(2), ..., K(n) of the integers 1, ..., n.
+/// - If forwrd = true,  forward permutation:
+///   X(*, K(j)) is moved to X(*, j) for j = 1, 2, ..., n.
+/// - If forwrd = false, backward permutation:
+///   X(*, j) is moved to X(*, K(j)) for j = 1, 2, ..., n.
+///
+/// The permutation is split into cycles, and columns are moved along each
+/// cycle in place. Rows are split into strips, and strips and groups of
+/// cycles are spread over threads. Columns not moved by K are not touched.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] forwrd
+///     - true:  forward permutation
+///     - false: backward permutation
+///
+/// @param[in] m
+///     The number of rows of the matrix X. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix X. n >= 0.
+///
+/// @param[in,out] X
+///     The m-by-n matrix X, stored in an ldx-by-n array.
+///     On entry, the m-by-n matrix X.
+///     On exit, X contains the permuted matrix X.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X, ldx >= max(1,m).
+///
+/// @param[in] K
+///     The vector K of length n.
+///     On entry, K contains the permutation vector. Unlike LAPACK's
+///     lapmt, K is not used as workspace; it must be a permutation of
+///     1, ..., n, otherwise an exception is thrown.
+///
+/// @ingroup auxiliary
 void lapmt(
     bool forwrd, int64_t m, int64_t n,
     std::complex<double>* X, int64_t ldx,
     int64_t* K )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int forwrd_ = (lapack_int) forwrd;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ldx_ = (lapack_int) ldx;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > K_( &K[0], &K[(n)] );
-        lapack_int* K_ptr = &K_[0];
-    #else
-        lapack_int* K_ptr = K;
-    #endif
-
-    LAPACK_zlapmt(
-        &forwrd_, &m_, &n_,
-        (lapack_complex_double*) X, &ldx_,
-        K_ptr );
-    #ifndef LAPACK_ILP64
-        std::copy( K_.begin(), K_.end(), K );
-    #endif
+    trace::internal::Block trace_block(
+        "lapmt", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmt", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmt", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup auxiliary
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmt", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K, Y, ldy );
+}
+
+// -----------------------------------------------------------------------------
+/// Copies the m-by-n matrix X to Y, rearranging its columns as specified
+/// by the permutation K(1), K(2), ..., K(n) of the integers 1, ..., n.
+/// This out-of-place version copies each column once.
+/// - If forwrd = true,  forward permutation:
+///   Y(*, j) = X(*, K(j)) for j = 1, 2, ..., n.
+/// - If forwrd = false, backward permutation:
+///   Y(*, K(j)) = X(*, j) for j = 1, 2, ..., n.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] forwrd
+///     - true:  forward permutation
+///     - false: backward permutation
+///
+/// @param[in] m
+///     The number of rows of the matrices X and Y. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrices X and Y. n >= 0.
+///
+/// @param[in] X
+///     The m-by-n matrix X, stored in an ldx-by-n array.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X, ldx >= max(1,m).
+///
+/// @param[in] K
+///     The permutation vector K of length n.
+///
+/// @param[out] Y
+///     The m-by-n matrix Y, stored in an ldy-by-n array.
+///     On exit, Y contains the permuted matrix X. Y must not overlap X.
+///
+/// @param[in] ldy
+///     The leading dimension of the array Y, ldy >= max(1,m).
+///
+/// @ingroup auxiliary
+void lapmt(
+    bool forwrd, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy )
+{
+    trace::internal::Block trace_block(
+        "lapmt", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lapmt( m, n ); } );
+
+    internal::lapmt( forwrd, m, n, X, ldx, K, Y, ldy );
 }
 
 }  // namespace lapack
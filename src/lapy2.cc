@@ -19,6 +19,10 @@ using blas::real;
 float lapy2(
     float x, float y )
 {
+    trace::internal::Block trace_block(
+        "lapy2", 's', -1, -1, -1,
+        []() { return 0.0; } );
+
     return LAPACK_slapy2( &x, &y );
 }
 
@@ -38,6 +42,10 @@ float lapy2(
 double lapy2(
     double x, double y )
 {
+    trace::internal::Block trace_block(
+        "lapy2", 'd', -1, -1, -1,
+        []() { return 0.0; } );
+
     return LAPACK_dlapy2( &x, &y );
 }
 
@@ -19,6 +19,10 @@ using blas::real;
 float lapy3(
     float x, float y, float z )
 {
+    trace::internal::Block trace_block(
+        "lapy3", 's', -1, -1, -1,
+        []() { return 0.0; } );
+
     return LAPACK_slapy3( &x, &y, &z );
 }
 
@@ -40,6 +44,10 @@ float lapy3(
 double lapy3(
     double x, double y, double z )
 {
+    trace::internal::Block trace_block(
+        "lapy3", 'd', -1, -1, -1,
+        []() { return 0.0; } );
+
     return LAPACK_dlapy3( &x, &y, &z );
 }
 
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +30,11 @@ void larf(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larf", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -39,7 +45,7 @@ void larf(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< float > work( lwork );
+    lapack::small_vector< float > work( lwork );
 
     LAPACK_slarf(
         &side_, &m_, &n_,
@@ -66,6 +72,11 @@ void larf(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larf", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -76,7 +87,7 @@ void larf(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< double > work( lwork );
+    lapack::small_vector< double > work( lwork );
 
     LAPACK_dlarf(
         &side_, &m_, &n_,
@@ -103,6 +114,11 @@ void larf(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larf", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -113,7 +129,7 @@ void larf(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork );
+    lapack::small_vector< std::complex<float> > work( lwork );
 
     LAPACK_clarf(
         &side_, &m_, &n_,
@@ -185,6 +201,11 @@ void larf(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larf", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -195,7 +216,7 @@ void larf(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork );
+    lapack::small_vector< std::complex<double> > work( lwork );
 
     LAPACK_zlarf(
         &side_, &m_, &n_,
@@ -208,4 +229,218 @@ void larf(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_larf(
+    char side, lapack_int m, lapack_int n,
+    float const* v, lapack_int incv, float tau,
+    float* C, lapack_int ldc,
+    float* work )
+{
+    LAPACK_slarf(
+        &side, &m, &n,
+        v, &incv, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larf(
+    char side, lapack_int m, lapack_int n,
+    double const* v, lapack_int incv, double tau,
+    double* C, lapack_int ldc,
+    double* work )
+{
+    LAPACK_dlarf(
+        &side, &m, &n,
+        v, &incv, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larf(
+    char side, lapack_int m, lapack_int n,
+    std::complex<float> const* v, lapack_int incv, std::complex<float> tau,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work )
+{
+    LAPACK_clarf(
+        &side, &m, &n,
+        (lapack_complex_float const*) v, &incv, (lapack_complex_float*) &tau,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larf(
+    char side, lapack_int m, lapack_int n,
+    std::complex<double> const* v, lapack_int incv, std::complex<double> tau,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work )
+{
+    LAPACK_zlarf(
+        &side, &m, &n,
+        (lapack_complex_double const*) v, &incv, (lapack_complex_double*) &tau,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by larf with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( side == Side::Left ? n : m );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::larf, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::larf for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     larf_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "larf", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int incv_ = (lapack_int) incv;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( side == Side::Left ? n : m );
+
+    fortran_larf(
+        side_, m_, n_,
+        v, incv_, tau,
+        C, ldc_,
+        work_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    float const* v, int64_t incv, float tau,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    double const* v, int64_t incv, double tau,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<float> const* v, int64_t incv, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larf_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<double> const* v, int64_t incv, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    float const* v, int64_t incv, float tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    double const* v, int64_t incv, double tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<float> const* v, int64_t incv, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larf(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<double> const* v, int64_t incv, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
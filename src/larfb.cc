@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -34,6 +35,11 @@ void larfb(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfb", 's', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -49,7 +55,7 @@ void larfb(
     lapack_int ldwork_ = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< float > work( ldwork_ * k );
+    lapack::small_vector< float > work( ldwork_ * k );
 
     LAPACK_slarfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_,
@@ -81,6 +87,11 @@ void larfb(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfb", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -96,7 +107,7 @@ void larfb(
     lapack_int ldwork_ = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< double > work( ldwork_ * k );
+    lapack::small_vector< double > work( ldwork_ * k );
 
     LAPACK_dlarfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_,
@@ -129,6 +140,11 @@ void larfb(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfb", 'c', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -144,7 +160,7 @@ void larfb(
     lapack_int ldwork_ = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( ldwork_ * k );
+    lapack::small_vector< std::complex<float> > work( ldwork_ * k );
 
     LAPACK_clarfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_,
@@ -273,6 +289,11 @@ void larfb(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfb", 'z', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -288,7 +309,7 @@ void larfb(
     lapack_int ldwork_ = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( ldwork_ * k );
+    lapack::small_vector< std::complex<double> > work( ldwork_ * k );
 
     LAPACK_zlarfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_,
@@ -302,4 +323,257 @@ void larfb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_larfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k,
+    float const* V, lapack_int ldv,
+    float const* T, lapack_int ldt,
+    float* C, lapack_int ldc,
+    float* work, lapack_int ldwork )
+{
+    LAPACK_slarfb(
+        &side, &trans, &direction, &storev, &m, &n, &k,
+        V, &ldv,
+        T, &ldt,
+        C, &ldc,
+        work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k,
+    double const* V, lapack_int ldv,
+    double const* T, lapack_int ldt,
+    double* C, lapack_int ldc,
+    double* work, lapack_int ldwork )
+{
+    LAPACK_dlarfb(
+        &side, &trans, &direction, &storev, &m, &n, &k,
+        V, &ldv,
+        T, &ldt,
+        C, &ldc,
+        work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k,
+    std::complex<float> const* V, lapack_int ldv,
+    std::complex<float> const* T, lapack_int ldt,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work, lapack_int ldwork )
+{
+    LAPACK_clarfb(
+        &side, &trans, &direction, &storev, &m, &n, &k,
+        (lapack_complex_float const*) V, &ldv,
+        (lapack_complex_float const*) T, &ldt,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k,
+    std::complex<double> const* V, lapack_int ldv,
+    std::complex<double> const* T, lapack_int ldt,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work, lapack_int ldwork )
+{
+    LAPACK_zlarfb(
+        &side, &trans, &direction, &storev, &m, &n, &k,
+        (lapack_complex_double const*) V, &ldv,
+        (lapack_complex_double const*) T, &ldt,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by larfb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( (side == Side::Left ? n : m) * k );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::larfb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::larfb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     larfb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "larfb", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    char direction_ = direction2char( direction );
+    char storev_ = storev2char( storev );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int ldwork_ = (lapack_int) (side == Side::Left ? n : m);
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( (side == Side::Left ? n : m) * k );
+
+    fortran_larfb(
+        side_, trans_, direction_, storev_, m_, n_, k_,
+        V, ldv_,
+        T, ldt_,
+        C, ldc_,
+        work_, ldwork_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
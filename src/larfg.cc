@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 
 #include <vector>
 
@@ -27,6 +28,11 @@ void larfg(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfg", 's', -1, n, -1,
+        [&]() { return Gflop< float >::larfg( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -48,6 +54,11 @@ void larfg(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfg", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::larfg( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -69,6 +80,11 @@ void larfg(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfg", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::larfg( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -146,6 +162,11 @@ void larfg(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfg", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::larfg( n ); } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
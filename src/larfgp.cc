@@ -29,6 +29,11 @@ void larfgp(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfgp", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -50,6 +55,11 @@ void larfgp(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfgp", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -71,6 +81,11 @@ void larfgp(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfgp", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
@@ -148,6 +163,11 @@ void larfgp(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfgp", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int incx_ = (lapack_int) incx;
 
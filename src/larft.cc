@@ -30,6 +30,11 @@ void larft(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larft", 's', -1, n, k,
+        []() { return 0.0; } );
+
     char direction_ = direction2char( direction );
     char storev_ = storev2char( storev );
     lapack_int n_ = (lapack_int) n;
@@ -64,6 +69,11 @@ void larft(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larft", 'd', -1, n, k,
+        []() { return 0.0; } );
+
     char direction_ = direction2char( direction );
     char storev_ = storev2char( storev );
     lapack_int n_ = (lapack_int) n;
@@ -98,6 +108,11 @@ void larft(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larft", 'c', -1, n, k,
+        []() { return 0.0; } );
+
     char direction_ = direction2char( direction );
     char storev_ = storev2char( storev );
     lapack_int n_ = (lapack_int) n;
@@ -224,6 +239,11 @@ void larft(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larft", 'z', -1, n, k,
+        []() { return 0.0; } );
+
     char direction_ = direction2char( direction );
     char storev_ = storev2char( storev );
     lapack_int n_ = (lapack_int) n;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,6 +29,11 @@ void larfx(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfx", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -37,7 +43,7 @@ void larfx(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< float > work( lwork );
+    lapack::small_vector< float > work( lwork );
 
     LAPACK_slarfx(
         &side_, &m_, &n_,
@@ -63,6 +69,11 @@ void larfx(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfx", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -72,7 +83,7 @@ void larfx(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< double > work( lwork );
+    lapack::small_vector< double > work( lwork );
 
     LAPACK_dlarfx(
         &side_, &m_, &n_,
@@ -98,6 +109,11 @@ void larfx(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfx", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -107,7 +123,7 @@ void larfx(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork );
+    lapack::small_vector< std::complex<float> > work( lwork );
 
     LAPACK_clarfx(
         &side_, &m_, &n_,
@@ -174,6 +190,11 @@ void larfx(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfx", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
@@ -183,7 +204,7 @@ void larfx(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork );
+    lapack::small_vector< std::complex<double> > work( lwork );
 
     LAPACK_zlarfx(
         &side_, &m_, &n_,
@@ -196,4 +217,215 @@ void larfx(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_larfx(
+    char side, lapack_int m, lapack_int n,
+    float const* v, float tau,
+    float* C, lapack_int ldc,
+    float* work )
+{
+    LAPACK_slarfx(
+        &side, &m, &n,
+        v, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfx(
+    char side, lapack_int m, lapack_int n,
+    double const* v, double tau,
+    double* C, lapack_int ldc,
+    double* work )
+{
+    LAPACK_dlarfx(
+        &side, &m, &n,
+        v, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfx(
+    char side, lapack_int m, lapack_int n,
+    std::complex<float> const* v, std::complex<float> tau,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work )
+{
+    LAPACK_clarfx(
+        &side, &m, &n,
+        (lapack_complex_float const*) v, (lapack_complex_float*) &tau,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfx(
+    char side, lapack_int m, lapack_int n,
+    std::complex<double> const* v, std::complex<double> tau,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work )
+{
+    LAPACK_zlarfx(
+        &side, &m, &n,
+        (lapack_complex_double const*) v, (lapack_complex_double*) &tau,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by larfx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( side == Side::Left ? n : m );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::larfx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::larfx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     larfx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    scalar_t const* v, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "larfx", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( side == Side::Left ? n : m );
+
+    fortran_larfx(
+        side_, m_, n_,
+        v, tau,
+        C, ldc_,
+        work_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    float const* v, float tau,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    double const* v, double tau,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<float> const* v, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfx_work_size_bytes(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<double> const* v, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    float const* v, float tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    double const* v, double tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<float> const* v, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfx(
+    lapack::Side side, int64_t m, int64_t n,
+    std::complex<double> const* v, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7.0
 
@@ -30,13 +31,18 @@ void larfy(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfy", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int incv_ = (lapack_int) incv;
     lapack_int ldc_ = (lapack_int) ldc;
 
     // allocate workspace
-    lapack::vector< float > work( (n) );
+    lapack::small_vector< float > work( (n) );
 
     LAPACK_slarfy(
         &uplo_, &n_,
@@ -62,13 +68,18 @@ void larfy(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfy", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int incv_ = (lapack_int) incv;
     lapack_int ldc_ = (lapack_int) ldc;
 
     // allocate workspace
-    lapack::vector< double > work( (n) );
+    lapack::small_vector< double > work( (n) );
 
     LAPACK_dlarfy(
         &uplo_, &n_,
@@ -94,13 +105,18 @@ void larfy(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfy", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int incv_ = (lapack_int) incv;
     lapack_int ldc_ = (lapack_int) ldc;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
 
     LAPACK_clarfy(
         &uplo_, &n_,
@@ -169,13 +185,18 @@ void larfy(
         lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larfy", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int incv_ = (lapack_int) incv;
     lapack_int ldc_ = (lapack_int) ldc;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
 
     LAPACK_zlarfy(
         &uplo_, &n_,
@@ -188,6 +209,217 @@ void larfy(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_larfy(
+    char uplo, lapack_int n,
+    float const* V, lapack_int incv, float tau,
+    float* C, lapack_int ldc,
+    float* work )
+{
+    LAPACK_slarfy(
+        &uplo, &n,
+        V, &incv, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfy(
+    char uplo, lapack_int n,
+    double const* V, lapack_int incv, double tau,
+    double* C, lapack_int ldc,
+    double* work )
+{
+    LAPACK_dlarfy(
+        &uplo, &n,
+        V, &incv, &tau,
+        C, &ldc,
+        work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfy(
+    char uplo, lapack_int n,
+    std::complex<float> const* V, lapack_int incv, std::complex<float> tau,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float>* work )
+{
+    LAPACK_clarfy(
+        &uplo, &n,
+        (lapack_complex_float const*) V, &incv, (lapack_complex_float*) &tau,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_larfy(
+    char uplo, lapack_int n,
+    std::complex<double> const* V, lapack_int incv, std::complex<double> tau,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double>* work )
+{
+    LAPACK_zlarfy(
+        &uplo, &n,
+        (lapack_complex_double const*) V, &incv, (lapack_complex_double*) &tau,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double*) work
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by larfy with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* V, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::larfy, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::larfy for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     larfy_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* V, int64_t incv, scalar_t tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "larfy", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int incv_ = (lapack_int) incv;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+
+    fortran_larfy(
+        uplo_, n_,
+        V, incv_, tau,
+        C, ldc_,
+        work_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* V, int64_t incv, float tau,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* V, int64_t incv, double tau,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* V, int64_t incv, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void larfy_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* V, int64_t incv, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    float const* V, int64_t incv, float tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    double const* V, int64_t incv, double tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* V, int64_t incv, std::complex<float> tau,
+    std::complex<float>* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t larfy(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* V, int64_t incv, std::complex<double> tau,
+    std::complex<double>* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7.0
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
 
 #include <vector>
 
@@ -26,10 +27,15 @@ void larnv(
         lapack_error_if( std::abs(idist) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larnv", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int idist_ = (lapack_int) idist;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -57,10 +63,15 @@ void larnv(
         lapack_error_if( std::abs(idist) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larnv", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int idist_ = (lapack_int) idist;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -88,10 +99,15 @@ void larnv(
         lapack_error_if( std::abs(idist) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larnv", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int idist_ = (lapack_int) idist;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
@@ -155,10 +171,15 @@ void larnv(
         lapack_error_if( std::abs(idist) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "larnv", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int idist_ = (lapack_int) idist;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
+        lapack::small_vector< lapack_int > iseed_( &iseed[0], &iseed[(4)] );
         lapack_int* iseed_ptr = &iseed_[0];
     #else
         lapack_int* iseed_ptr = iseed;
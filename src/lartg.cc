@@ -3,6 +3,7 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "lapack.hh"
 #include "lapack/fortran.h"
 
 namespace lapack {
@@ -14,6 +15,9 @@ void lartg(
     float* sn,
     float* r )
 {
+    trace::internal::Block trace_block(
+        "lartg", 's', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_slartg(
         &f, &g, cs, sn, r );
@@ -26,6 +30,9 @@ void lartg(
     double* sn,
     double* r )
 {
+    trace::internal::Block trace_block(
+        "lartg", 'd', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_dlartg(
         &f, &g, cs, sn, r );
@@ -38,6 +45,9 @@ void lartg(
     std::complex<float>* sn,
     std::complex<float>* r )
 {
+    trace::internal::Block trace_block(
+        "lartg", 'c', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_clartg(
         (lapack_complex_float*) &f,
@@ -54,6 +64,9 @@ void lartg(
     std::complex<double>* sn,
     std::complex<double>* r )
 {
+    trace::internal::Block trace_block(
+        "lartg", 'z', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_zlartg(
         (lapack_complex_double*) &f,
@@ -23,6 +23,9 @@ void lartgp(
     float* sn,
     float* r )
 {
+    trace::internal::Block trace_block(
+        "lartgp", 's', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_slartgp(
         &f, &g, cs, sn, r );
@@ -35,6 +38,9 @@ void lartgp(
     double* sn,
     double* r )
 {
+    trace::internal::Block trace_block(
+        "lartgp", 'd', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_dlartgp(
         &f, &g, cs, sn, r );
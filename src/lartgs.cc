@@ -22,6 +22,9 @@ void lartgs(
     float* cs,
     float* sn )
 {
+    trace::internal::Block trace_block(
+        "lartgs", 's', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_slartgs(
         &x, &y, &sigma, cs, sn );
@@ -33,6 +36,9 @@ void lartgs(
     double* cs,
     double* sn )
 {
+    trace::internal::Block trace_block(
+        "lartgs", 'd', -1, -1, -1,
+        []() { return 0.0; } );
 
     LAPACK_dlartgs(
         &x, &y, &sigma, cs, sn );
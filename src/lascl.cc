@@ -4,49 +4,24 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-
-#include <vector>
+#include "lapack/flops.hh"
+#include "copy_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
 /// @ingroup auxiliary
 int64_t lascl(
     lapack::MatrixType matrixtype, int64_t kl, int64_t ku, float cfrom, float cto, int64_t m, int64_t n,
     float* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int kl_ = (lapack_int) kl;
-    lapack_int ku_ = (lapack_int) ku;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
+    trace::internal::Block trace_block(
+        "lascl", 's', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::lascl( matrixtype, m, n ); } );
 
-    LAPACK_slascl(
-        &matrixtype_, &kl_, &ku_, &cfrom, &cto, &m_, &n_,
-        A, &lda_, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    internal::lascl( matrixtype, kl, ku, cfrom, cto, m, n, A, lda );
+    return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -55,33 +30,13 @@ int64_t lascl(
     lapack::MatrixType matrixtype, int64_t kl, int64_t ku, double cfrom, double cto, int64_t m, int64_t n,
     double* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int kl_ = (lapack_int) kl;
-    lapack_int ku_ = (lapack_int) ku;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
+    trace::internal::Block trace_block(
+        "lascl", 'd', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::lascl( matrixtype, m, n ); } );
 
-    LAPACK_dlascl(
-        &matrixtype_, &kl_, &ku_, &cfrom, &cto, &m_, &n_,
-        A, &lda_, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    internal::lascl( matrixtype, kl, ku, cfrom, cto, m, n, A, lda );
+    return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -90,33 +45,13 @@ int64_t lascl(
     lapack::MatrixType matrixtype, int64_t kl, int64_t ku, float cfrom, float cto, int64_t m, int64_t n,
     std::complex<float>* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int kl_ = (lapack_int) kl;
-    lapack_int ku_ = (lapack_int) ku;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
+    trace::internal::Block trace_block(
+        "lascl", 'c', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::lascl( matrixtype, m, n ); } );
 
-    LAPACK_clascl(
-        &matrixtype_, &kl_, &ku_, &cfrom, &cto, &m_, &n_,
-        (lapack_complex_float*) A, &lda_, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    internal::lascl( matrixtype, kl, ku, cfrom, cto, m, n, A, lda );
+    return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -198,33 +133,13 @@ int64_t lascl(
     lapack::MatrixType matrixtype, int64_t kl, int64_t ku, double cfrom, double cto, int64_t m, int64_t n,
     std::complex<double>* A, int64_t lda )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(kl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ku) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char matrixtype_ = matrixtype2char( matrixtype );
-    lapack_int kl_ = (lapack_int) kl;
-    lapack_int ku_ = (lapack_int) ku;
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
+    trace::internal::Block trace_block(
+        "lascl", 'z', m, n, -1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::lascl( matrixtype, m, n ); } );
 
-    LAPACK_zlascl(
-        &matrixtype_, &kl_, &ku_, &cfrom, &cto, &m_, &n_,
-        (lapack_complex_double*) A, &lda_, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    internal::lascl( matrixtype, kl, ku, cfrom, cto, m, n, A, lda );
+    return 0;
 }
 
 }  // namespace lapack
@@ -4,16 +4,10 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-
-#include <vector>
+#include "norm_kernels.hh"
 
 namespace lapack {
 
-using blas::max;
-using blas::min;
-using blas::real;
-
 // -----------------------------------------------------------------------------
 /// @ingroup auxiliary
 void lassq(
@@ -22,17 +16,11 @@ void lassq(
     float* scale,
     float* sumsq )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "lassq", 's', -1, n, -1,
+        []() { return 0.0; } );
 
-    LAPACK_slassq(
-        &n_,
-        x, &incx_, scale, sumsq );
+    internal::lassq( n, x, incx, scale, sumsq );
 }
 
 // -----------------------------------------------------------------------------
@@ -43,17 +31,11 @@ void lassq(
     double* scale,
     double* sumsq )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "lassq", 'd', -1, n, -1,
+        []() { return 0.0; } );
 
-    LAPACK_dlassq(
-        &n_,
-        x, &incx_, scale, sumsq );
+    internal::lassq( n, x, incx, scale, sumsq );
 }
 
 // -----------------------------------------------------------------------------
@@ -64,17 +46,11 @@ void lassq(
     float* scale,
     float* sumsq )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "lassq", 'c', -1, n, -1,
+        []() { return 0.0; } );
 
-    LAPACK_classq(
-        &n_,
-        (lapack_complex_float*) x, &incx_, scale, sumsq );
+    internal::lassq( n, x, incx, scale, sumsq );
 }
 
 // -----------------------------------------------------------------------------
@@ -84,19 +60,14 @@ void lassq(
 ///     scl^2 ssq = x_1^2 + \dots + x_n^2 + scale^2 sumsq,
 /// \]
 /// where $x_i = | x( 1 + ( i - 1 )*incx ) |, 1 \le i \le n.$
-/// The value of sumsq is
-/// assumed to be at least unity and the value of ssq will then satisfy
-///
-///     1.0 <= ssq <= ( sumsq + 2*n ).
-///
-/// scale is assumed to be non-negative and scl returns the value
-/// \[
-///     scl = \max( scale, |real( x_i )|, |imag( x_i )| ).
-/// \]
-/// scale and sumsq must be supplied in scale and sumsq respectively.
-/// scale and sumsq are overwritten by scl and ssq respectively.
+/// For complex x, the real and imaginary parts are separate terms.
 ///
-/// The routine makes only one pass through the vector x.
+/// Uses Blue's algorithm, as LAPACK >= 3.10 does: values are accumulated
+/// in three sums of squares, for small, mid-range, and large values, with
+/// the small and large ones scaled by powers of two, so it makes only one
+/// pass through x and neither overflows nor underflows unnecessarily.
+/// With incx = 1, it is vectorized and threaded. If scale or sumsq is NaN
+/// on entry, returns immediately.
 ///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
@@ -109,7 +80,7 @@ void lassq(
 ///
 /// @param[in] incx
 ///     The increment between successive values of the vector x.
-///     incx > 0.
+///     If incx < 0, x is traversed backwards, as in LAPACK.
 ///
 /// @param[in,out] scale
 ///     On entry, the value scale in the equation above.
@@ -126,17 +97,11 @@ void lassq(
     double* scale,
     double* sumsq )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "lassq", 'z', -1, n, -1,
+        []() { return 0.0; } );
 
-    LAPACK_zlassq(
-        &n_,
-        (lapack_complex_double*) x, &incx_, scale, sumsq );
+    internal::lassq( n, x, incx, scale, sumsq );
 }
 
 }  // namespace lapack
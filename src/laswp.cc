@@ -4,8 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
-#include "lapack/fortran.h"
-#include "NoConstructAllocator.hh"
+#include "lapack/flops.hh"
+#include "ThreadPool.hh"
 
 #include <vector>
 
@@ -13,117 +13,210 @@ namespace lapack {
 
 using blas::max;
 using blas::min;
-using blas::real;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Column blocks are sized so each moves about this many elements; blocks
+// are spread over the thread pool.
+static const int64_t laswp_block_elems = 16384;
+
+// With SwapMethod::Auto, pivots are composed only if there are at least
+// this many actual interchanges.
+static const int64_t laswp_compose_min = 4;
+
+//------------------------------------------------------------------------------
+// Native laswp. The interchanges are first listed in the order LAPACK
+// applies them, then applied to column blocks in parallel, each column
+// once, while it is in cache:
+// - Swap applies the interchanges in sequence, as LAPACK does;
+// - Compose applies them to an index vector, giving a permutation, then
+//   gathers the moved rows of each column into a buffer and scatters them
+//   back, so each moved element is read and written once, instead of
+//   twice per interchange it takes part in.
+//
+template <typename scalar_t, typename int_t>
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    scalar_t* A, int64_t lda, int64_t k1, int64_t k2,
+    int_t const* ipiv, int64_t incx )
+{
+    lapack_error_if( method != SwapMethod::Auto
+                     && method != SwapMethod::Swap
+                     && method != SwapMethod::Compose );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < 1 );
+    lapack_error_if( k1 < 1 );
+
+    if (n == 0 || k2 < k1 || incx == 0)
+        return;
+
+    // List interchanges (i, ip), 0-based, in the order LAPACK applies
+    // them, skipping trivial ones; rows [rmin, rmax] are involved.
+    int64_t npiv = k2 - k1 + 1;
+    std::vector< int64_t > rows_i, rows_ip;
+    rows_i.reserve( npiv );
+    rows_ip.reserve( npiv );
+    int64_t rmin = k2, rmax = -1;
+    int64_t ix = (incx > 0 ? k1 : k1 + (k1 - k2)*incx) - 1;
+    for (int64_t k = 0; k < npiv; ++k) {
+        int64_t i  = (incx > 0 ? k1 + k : k2 - k) - 1;
+        int64_t ip = int64_t( ipiv[ ix ] ) - 1;
+        lapack_error_if( ip < 0 || ip >= lda );
+        if (ip != i) {
+            rows_i.push_back( i );
+            rows_ip.push_back( ip );
+            rmin = min( rmin, min( i, ip ) );
+            rmax = max( rmax, max( i, ip ) );
+        }
+        ix += incx;
+    }
+    int64_t nswaps = rows_i.size();
+    if (nswaps == 0)
+        return;
+
+    // Compose the interchanges: row rmin + dst[ t ] of the result is
+    // row rmin + src[ t ] of A.
+    int64_t nrange = rmax - rmin + 1;
+    std::vector< int64_t > src, dst;
+    if (method != SwapMethod::Swap) {
+        std::vector< int64_t > perm( nrange );
+        for (int64_t r = 0; r < nrange; ++r)
+            perm[ r ] = r;
+        for (int64_t k = 0; k < nswaps; ++k)
+            std::swap( perm[ rows_i[ k ] - rmin ], perm[ rows_ip[ k ] - rmin ] );
+        for (int64_t r = 0; r < nrange; ++r) {
+            if (perm[ r ] != r) {
+                dst.push_back( r );
+                src.push_back( perm[ r ] );
+            }
+        }
+        if (src.empty())
+            return;  // interchanges cancel out
+    }
+    int64_t ncompose = src.size();
+
+    // If most rows in [rmin, rmax] move, as after an LU panel, Compose
+    // copies the range contiguously, then scatters it. Otherwise it
+    // gathers rows, which pays off only if rows move fewer times in the
+    // permutation than in the interchanges.
+    bool dense = (2*ncompose >= nrange);
+    if (method == SwapMethod::Auto) {
+        method = (nswaps >= laswp_compose_min && (dense || ncompose < nswaps)
+                  ? SwapMethod::Compose : SwapMethod::Swap);
+    }
+
+    int64_t nmoved = (method == SwapMethod::Compose ? ncompose : 2*nswaps);
+    int64_t nb = max( int64_t( 1 ), laswp_block_elems / nmoved );
+    int64_t nblocks = (n + nb - 1) / nb;
+
+    parallel_for( nblocks, [&]( int64_t b, int worker ) {
+        int64_t j1 = b*nb;
+        int64_t j2 = min( n, j1 + nb );
+        if (method == SwapMethod::Compose) {
+            int64_t const* src_ = src.data();
+            int64_t const* dst_ = dst.data();
+            if (dense) {
+                // Copy rows [rmin, rmax] contiguously, then scatter.
+                std::vector< scalar_t > tmp( nrange );
+                for (int64_t j = j1; j < j2; ++j) {
+                    scalar_t* Aj = &A[ rmin + j*lda ];
+                    std::copy( Aj, Aj + nrange, tmp.data() );
+                    for (int64_t t = 0; t < nmoved; ++t)
+                        Aj[ dst_[ t ] ] = tmp[ src_[ t ] ];
+                }
+            }
+            else {
+                std::vector< scalar_t > tmp( nmoved );
+                for (int64_t j = j1; j < j2; ++j) {
+                    scalar_t* Aj = &A[ rmin + j*lda ];
+                    for (int64_t t = 0; t < nmoved; ++t)
+                        tmp[ t ] = Aj[ src_[ t ] ];
+                    for (int64_t t = 0; t < nmoved; ++t)
+                        Aj[ dst_[ t ] ] = tmp[ t ];
+                }
+            }
+        }
+        else {
+            for (int64_t j = j1; j < j2; ++j) {
+                scalar_t* Aj = &A[ j*lda ];
+                for (int64_t k = 0; k < nswaps; ++k)
+                    std::swap( Aj[ rows_i[ k ] ], Aj[ rows_ip[ k ] ] );
+            }
+        }
+    });
+}
+
+}  // namespace internal
 
 // -----------------------------------------------------------------------------
 /// @ingroup gesv_computational
 void laswp(
-    int64_t n,
+    lapack::SwapMethod method, int64_t n,
     float* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int k1_ = (lapack_int) k1;
-    lapack_int k2_ = (lapack_int) k2;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
-        lapack_int const* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int const* ipiv_ptr = ipiv;
-    #endif
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "laswp", 's', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::laswp( n, k2 - k1 + 1 ); } );
 
-    LAPACK_slaswp(
-        &n_,
-        A, &lda_, &k1_, &k2_,
-        ipiv_ptr, &incx_ );
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gesv_computational
 void laswp(
-    int64_t n,
+    lapack::SwapMethod method, int64_t n,
     double* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int k1_ = (lapack_int) k1;
-    lapack_int k2_ = (lapack_int) k2;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
-        lapack_int const* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int const* ipiv_ptr = ipiv;
-    #endif
-    lapack_int incx_ = (lapack_int) incx;
+    trace::internal::Block trace_block(
+        "laswp", 'd', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::laswp( n, k2 - k1 + 1 ); } );
 
-    LAPACK_dlaswp(
-        &n_,
-        A, &lda_, &k1_, &k2_,
-        ipiv_ptr, &incx_ );
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gesv_computational
 void laswp(
-    int64_t n,
+    lapack::SwapMethod method, int64_t n,
     std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int k1_ = (lapack_int) k1;
-    lapack_int k2_ = (lapack_int) k2;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
-        lapack_int const* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int const* ipiv_ptr = ipiv;
-    #endif
-    lapack_int incx_ = (lapack_int) incx;
-
-    LAPACK_claswp(
-        &n_,
-        (lapack_complex_float*) A, &lda_, &k1_, &k2_,
-        ipiv_ptr, &incx_ );
+    trace::internal::Block trace_block(
+        "laswp", 'c', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
 }
 
 // -----------------------------------------------------------------------------
 /// Performs a series of row interchanges on the matrix A.
 /// One row interchange is initiated for each of rows k1 through k2 of A.
 ///
+/// This is a native implementation. Columns are split into blocks that
+/// are permuted in parallel, each column while it is in cache.
+/// With method = Compose, the interchanges are first composed into one
+/// permutation, which is applied to each column as a gather and scatter
+/// of the rows that move, so rows interchanged several times, as in
+/// LU factorization, are moved only once.
+///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
+/// @param[in] method
+///     How interchanges are applied; the result is the same.
+///     - lapack::SwapMethod::Auto:    Compose if there are several
+///                                    interchanges, otherwise Swap.
+///     - lapack::SwapMethod::Swap:    apply interchanges in sequence,
+///                                    as LAPACK does.
+///     - lapack::SwapMethod::Compose: compose interchanges into one
+///                                    permutation, then gather rows.
+///
 /// @param[in] n
 ///     The number of columns of the matrix A.
 ///
@@ -139,7 +232,7 @@ void laswp(
 ///
 /// @param[in] k1
 ///     The first element of ipiv for which a row interchange will
-///     be done.
+///     be done. k1 >= 1.
 ///
 /// @param[in] k2
 ///     (k2-k1+1) is the number of elements of ipiv for which a row
@@ -150,43 +243,223 @@ void laswp(
 ///     The vector of pivot indices. Only the elements in positions
 ///     k1 through k1+(k2-k1)*abs(incx) of ipiv are accessed.
 ///     ipiv(k1+($K-$k1)*abs(incx)) = L implies rows K and L are to be
-///     interchanged.
+///     interchanged. 1 <= L <= lda.
 ///
 /// @param[in] incx
 ///     The increment between successive values of ipiv. If incx
 ///     is negative, the pivots are applied in reverse order.
 ///
 /// @ingroup gesv_computational
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'z', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 's', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'd', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'c', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// Performs a series of row interchanges on the matrix A.
+/// One row interchange is initiated for each of rows k1 through k2 of A.
+/// Same as lapack::laswp with method = lapack::SwapMethod::Auto.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @ingroup gesv_computational
 void laswp(
     int64_t n,
     std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int k1_ = (lapack_int) k1;
-    lapack_int k2_ = (lapack_int) k2;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
-        lapack_int const* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int const* ipiv_ptr = ipiv;
-    #endif
-    lapack_int incx_ = (lapack_int) incx;
-
-    LAPACK_zlaswp(
-        &n_,
-        (lapack_complex_double*) A, &lda_, &k1_, &k2_,
-        ipiv_ptr, &incx_ );
+    trace::internal::Block trace_block(
+        "laswp", 'z', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 's', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'd', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'c', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are used directly, without a copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+/// @ingroup gesv_computational
+void laswp(
+    lapack::SwapMethod method, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'z', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( method, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 's', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< float >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'd', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< double >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'c', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<float> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are used directly, without a copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    trace::internal::Block trace_block(
+        "laswp", 'z', -1, n, k2 - k1 + 1,
+        []() { return 0.0; },
+        [&]() { return Gbyte< std::complex<double> >::laswp( n, k2 - k1 + 1 ); } );
+
+    internal::laswp( SwapMethod::Auto, n, A, lda, k1, k2, ipiv, incx );
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
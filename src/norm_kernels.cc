@@ -0,0 +1,902 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "norm_kernels.hh"
+#include "simd.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+// Matrices are split into chunks of about this many elements, which are
+// spread over the thread pool.
+static const int64_t chunk_elems = 32768;
+
+// Complex elements are converted to absolute values in blocks of this size.
+static const int64_t abs_block = 256;
+
+//------------------------------------------------------------------------------
+// Max with LAPACK's NaN rule, as in lange: x replaces value if
+// value < x or x is NaN, so NaN propagates.
+template <typename real_t>
+inline real_t nan_max( real_t value, real_t x )
+{
+    return (value < x || x != x ? x : value);
+}
+
+//------------------------------------------------------------------------------
+// Blue's thresholds and scaling constants, as in LAPACK's la_constants:
+// values in [tsml, tbig] are squared directly; smaller ones are scaled up
+// by ssml and larger ones down by sbig before squaring.
+template <typename real_t>
+struct Blue {
+    using limits = std::numeric_limits< real_t >;
+    static real_t tsml() {
+        return std::ldexp( real_t( 1 ), int( std::ceil( (limits::min_exponent - 1) * 0.5 ) ) );
+    }
+    static real_t tbig() {
+        return std::ldexp( real_t( 1 ), int( std::floor( (limits::max_exponent - limits::digits + 1) * 0.5 ) ) );
+    }
+    static real_t ssml() {
+        return std::ldexp( real_t( 1 ), -int( std::floor( (limits::min_exponent - limits::digits) * 0.5 ) ) );
+    }
+    static real_t sbig() {
+        return std::ldexp( real_t( 1 ), -int( std::ceil( (limits::max_exponent + limits::digits - 1) * 0.5 ) ) );
+    }
+};
+
+//------------------------------------------------------------------------------
+// Blue's three accumulators of squares: small values scaled by ssml,
+// mid-range values, and big values scaled by sbig. Partial sums from
+// different chunks or threads are combined by adding.
+template <typename real_t>
+struct SumSq {
+    real_t asml = 0, amed = 0, abig = 0;
+
+    void operator += ( SumSq const& other )
+    {
+        asml += other.asml;
+        amed += other.amed;
+        abig += other.abig;
+    }
+
+    // Adds one value, for strided and diagonal elements.
+    void add( real_t x )
+    {
+        real_t ax = std::abs( x );
+        if (ax > Blue<real_t>::tbig()) {
+            ax *= Blue<real_t>::sbig();
+            abig += ax*ax;
+        }
+        else if (ax < Blue<real_t>::tsml()) {
+            ax *= Blue<real_t>::ssml();
+            asml += ax*ax;
+        }
+        else {
+            amed += ax*ax;
+        }
+    }
+
+    void add( std::complex<real_t> x )
+    {
+        add( std::real( x ) );
+        add( std::imag( x ) );
+    }
+};
+
+//------------------------------------------------------------------------------
+// Folds the accumulators into scale and sumsq, which on entry hold an
+// existing sum scale^2 sumsq, exactly as LAPACK's lassq does after its
+// loop. scale and sumsq must already be normalized, as lassq does on entry.
+template <typename real_t>
+void sumsq_finish( SumSq<real_t> acc, real_t* scale, real_t* sumsq )
+{
+    const real_t zero = 0;
+    const real_t one  = 1;
+    const real_t tbig = Blue<real_t>::tbig();
+    const real_t tsml = Blue<real_t>::tsml();
+    const real_t sbig = Blue<real_t>::sbig();
+    const real_t ssml = Blue<real_t>::ssml();
+
+    // Once a big value is seen, small values are negligible.
+    bool notbig = ! (acc.abig > zero);
+
+    // Put the existing sum of squares into one of the accumulators.
+    if (*sumsq > zero) {
+        real_t ax = *scale * std::sqrt( *sumsq );
+        if (ax > tbig) {
+            if (*scale > one) {
+                *scale *= sbig;
+                acc.abig += *scale * (*scale * *sumsq);
+            }
+            else {
+                acc.abig += *scale * (*scale * (sbig * (sbig * *sumsq)));
+            }
+        }
+        else if (ax < tsml) {
+            if (notbig) {
+                if (*scale < one) {
+                    *scale *= ssml;
+                    acc.asml += *scale * (*scale * *sumsq);
+                }
+                else {
+                    acc.asml += *scale * (*scale * (ssml * (ssml * *sumsq)));
+                }
+            }
+        }
+        else {
+            acc.amed += *scale * (*scale * *sumsq);
+        }
+    }
+
+    // Combine abig and amed, or amed and asml, if more than one
+    // accumulator was used.
+    if (acc.abig > zero) {
+        if (acc.amed > zero || std::isnan( acc.amed ))
+            acc.abig += (acc.amed*sbig)*sbig;
+        *scale = one / sbig;
+        *sumsq = acc.abig;
+    }
+    else if (acc.asml > zero) {
+        if (acc.amed > zero || std::isnan( acc.amed )) {
+            real_t amed = std::sqrt( acc.amed );
+            real_t asml = std::sqrt( acc.asml ) / ssml;
+            // as LAPACK, so NaN in amed propagates to ymax
+            real_t ymin = (asml > amed ? amed : asml);
+            real_t ymax = (asml > amed ? asml : amed);
+            *scale = one;
+            *sumsq = ymax*ymax*( one + (ymin/ymax)*(ymin/ymax) );
+        }
+        else {
+            *scale = one / ssml;
+            *sumsq = acc.asml;
+        }
+    }
+    else {
+        // Otherwise all values are mid-range or zero.
+        *scale = one;
+        *sumsq = acc.amed;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Kernels on contiguous real vectors. Each keeps W = simd_width partial
+// results, one per SIMD lane, since the compiler can't reorder a
+// floating-point reduction itself.
+
+// max_i |x_i|, with NaN propagating.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+real_t max_abs( int64_t n, real_t const* x )
+{
+    constexpr int W = simd_width<real_t>();
+    real_t v[ W ] = {};
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            v[ l ] = nan_max( v[ l ], std::abs( x[ i + l ] ) );
+    }
+    real_t value = 0;
+    for (; i < n; ++i)
+        value = nan_max( value, std::abs( x[ i ] ) );
+    for (int l = 0; l < W; ++l)
+        value = nan_max( value, v[ l ] );
+    return value;
+}
+
+// sum_i |x_i|.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+real_t sum_abs( int64_t n, real_t const* x )
+{
+    constexpr int W = simd_width<real_t>();
+    real_t v[ W ] = {};
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            v[ l ] += std::abs( x[ i + l ] );
+    }
+    real_t sum = 0;
+    for (; i < n; ++i)
+        sum += std::abs( x[ i ] );
+    for (int l = 0; l < W; ++l)
+        sum += v[ l ];
+    return sum;
+}
+
+// y_i += |x_i|, returning sum_i |x_i|, for symmetric one norms, where
+// each element adds to both its row and column sums.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+real_t sum_add_abs( int64_t n, real_t const* x, real_t* y )
+{
+    constexpr int W = simd_width<real_t>();
+    real_t v[ W ] = {};
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l) {
+            real_t ax = std::abs( x[ i + l ] );
+            v[ l ] += ax;
+            y[ i + l ] += ax;
+        }
+    }
+    real_t sum = 0;
+    for (; i < n; ++i) {
+        real_t ax = std::abs( x[ i ] );
+        sum += ax;
+        y[ i ] += ax;
+    }
+    for (int l = 0; l < W; ++l)
+        sum += v[ l ];
+    return sum;
+}
+
+// y_i += |x_i|.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+void add_abs( int64_t n, real_t const* x, real_t* y )
+{
+    constexpr int W = simd_width<real_t>();
+    int64_t i = 0;
+    for (; i + W <= n; i += W) {
+        LAPACK_LANES
+        for (int l = 0; l < W; ++l)
+            y[ i + l ] += std::abs( x[ i + l ] );
+    }
+    for (; i < n; ++i)
+        y[ i ] += std::abs( x[ i ] );
+}
+
+// acc += Blue's sum of squares of x.
+// Usually every nonzero |x_i| is mid-range, in [tsml, tbig], so only amed
+// is needed. Each block sums ax^2 while tracking the largest and smallest
+// nonzero |x_i|, all of which vectorize; a block with any small, big, or
+// NaN value is redone with the three accumulators, one value at a time.
+// (Selecting between three squares per element doesn't vectorize, as the
+// compiler won't speculate the multiplies while preserving FP traps.)
+template <typename real_t>
+LAPACK_SIMD_CLONES
+void sum_squares( int64_t n, real_t const* x, SumSq<real_t>& acc )
+{
+    constexpr int W = simd_width<real_t>();
+    const real_t zero = 0;
+    const real_t tbig = Blue<real_t>::tbig();
+    const real_t tsml = Blue<real_t>::tsml();
+
+    for (int64_t ib = 0; ib < n; ib += abs_block) {
+        int64_t nb = min( abs_block, n - ib );
+        real_t const* xb = &x[ ib ];
+        real_t amed[ W ] = {}, amax[ W ] = {}, amin[ W ];
+        for (int l = 0; l < W; ++l)
+            amin[ l ] = tbig;
+        int64_t i = 0;
+        for (; i + W <= nb; i += W) {
+            LAPACK_LANES
+            for (int l = 0; l < W; ++l) {
+                real_t ax = std::abs( xb[ i + l ] );
+                amed[ l ] += ax*ax;
+                amax[ l ] = nan_max( amax[ l ], ax );
+                amin[ l ] = ((ax < amin[ l ]) & (ax != zero) ? ax : amin[ l ]);
+            }
+        }
+        real_t sum = 0, vmax = 0, vmin = tbig;
+        for (int l = 0; l < W; ++l) {
+            sum += amed[ l ];
+            vmax = nan_max( vmax, amax[ l ] );
+            vmin = min( vmin, amin[ l ] );
+        }
+        if (vmax <= tbig && vmin >= tsml) {
+            acc.amed += sum;
+        }
+        else {
+            i = 0;
+        }
+        for (; i < nb; ++i)
+            acc.add( xb[ i ] );
+    }
+}
+
+// y_i = |x_i| for complex x, as sqrt( re^2 + im^2 ), which vectorizes.
+// If any re^2 + im^2 overflows or loses accuracy to underflow, redoes the
+// block with std::abs, which scales.
+template <typename real_t>
+LAPACK_SIMD_CLONES
+void abs_complex( int64_t n, std::complex<real_t> const* x, real_t* y )
+{
+    const real_t zero = 0;
+    const real_t safmin = std::numeric_limits< real_t >::min();
+    const real_t safmax = std::numeric_limits< real_t >::max();
+    real_t const* xr = reinterpret_cast< real_t const* >( x );
+
+    int bad = 0;
+    LAPACK_LANES
+    for (int64_t i = 0; i < n; ++i) {
+        real_t re = xr[ 2*i ];
+        real_t im = xr[ 2*i + 1 ];
+        real_t s = re*re + im*im;
+        y[ i ] = std::sqrt( s );
+        bad |= int( s > safmax )
+               | (int( s < safmin ) & (int( re != zero ) | int( im != zero )));
+    }
+    if (bad) {
+        for (int64_t i = 0; i < n; ++i)
+            y[ i ] = std::abs( x[ i ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Column segment operations for real and complex elements. Complex
+// elements are converted to absolute values a block at a time, then use
+// the real kernels.
+
+template <typename real_t>
+inline real_t seg_max( int64_t n, real_t const* x )
+{
+    return max_abs( n, x );
+}
+
+template <typename real_t>
+real_t seg_max( int64_t n, std::complex<real_t> const* x )
+{
+    real_t tmp[ abs_block ];
+    real_t value = 0;
+    for (int64_t i = 0; i < n; i += abs_block) {
+        int64_t nb = min( abs_block, n - i );
+        abs_complex( nb, &x[ i ], tmp );
+        value = nan_max( value, max_abs( nb, tmp ) );
+    }
+    return value;
+}
+
+template <typename real_t>
+inline real_t seg_sum( int64_t n, real_t const* x )
+{
+    return sum_abs( n, x );
+}
+
+template <typename real_t>
+real_t seg_sum( int64_t n, std::complex<real_t> const* x )
+{
+    real_t tmp[ abs_block ];
+    real_t sum = 0;
+    for (int64_t i = 0; i < n; i += abs_block) {
+        int64_t nb = min( abs_block, n - i );
+        abs_complex( nb, &x[ i ], tmp );
+        sum += sum_abs( nb, tmp );
+    }
+    return sum;
+}
+
+template <typename real_t>
+inline real_t seg_sum_add( int64_t n, real_t const* x, real_t* y )
+{
+    return sum_add_abs( n, x, y );
+}
+
+template <typename real_t>
+real_t seg_sum_add( int64_t n, std::complex<real_t> const* x, real_t* y )
+{
+    real_t tmp[ abs_block ];
+    real_t sum = 0;
+    for (int64_t i = 0; i < n; i += abs_block) {
+        int64_t nb = min( abs_block, n - i );
+        abs_complex( nb, &x[ i ], tmp );
+        sum += sum_add_abs( nb, tmp, &y[ i ] );
+    }
+    return sum;
+}
+
+template <typename real_t>
+inline void seg_add( int64_t n, real_t const* x, real_t* y )
+{
+    add_abs( n, x, y );
+}
+
+template <typename real_t>
+void seg_add( int64_t n, std::complex<real_t> const* x, real_t* y )
+{
+    real_t tmp[ abs_block ];
+    for (int64_t i = 0; i < n; i += abs_block) {
+        int64_t nb = min( abs_block, n - i );
+        abs_complex( nb, &x[ i ], tmp );
+        add_abs( nb, tmp, &y[ i ] );
+    }
+}
+
+template <typename real_t>
+inline void seg_sumsq( int64_t n, real_t const* x, SumSq<real_t>& acc )
+{
+    sum_squares( n, x, acc );
+}
+
+// As in LAPACK's zlassq, real and imaginary parts are separate elements.
+template <typename real_t>
+inline void seg_sumsq(
+    int64_t n, std::complex<real_t> const* x, SumSq<real_t>& acc )
+{
+    sum_squares( 2*n, reinterpret_cast< real_t const* >( x ), acc );
+}
+
+//------------------------------------------------------------------------------
+// |a_jj| of a diagonal element; for Hermitian, only the real part.
+template <typename scalar_t>
+inline blas::real_type<scalar_t> diag_abs( scalar_t ajj, bool hermitian )
+{
+    return hermitian ? std::abs( std::real( ajj ) ) : std::abs( ajj );
+}
+
+//------------------------------------------------------------------------------
+// Splits columns [0, n) into about nchunks chunks of equal work, where
+// column j of a triangle has about j elements (upper) or n - j (lower).
+// Returns boundaries, starting with 0 and ending with n.
+static std::vector< int64_t > triangle_chunks(
+    lapack::Uplo uplo, int64_t n, int64_t nchunks )
+{
+    std::vector< int64_t > bounds( 1, 0 );
+    for (int64_t k = 1; k < nchunks; ++k) {
+        double f = double( k ) / nchunks;
+        int64_t j = (uplo == Uplo::Upper
+                     ? int64_t( n * std::sqrt( f ) )
+                     : n - int64_t( n * std::sqrt( 1 - f ) ));
+        if (j > bounds.back() && j < n)
+            bounds.push_back( j );
+    }
+    bounds.push_back( n );
+    return bounds;
+}
+
+//------------------------------------------------------------------------------
+// Number of chunks of chunk_elems for nelems elements, but at most max_chunks.
+static int64_t num_chunks( int64_t nelems, int64_t max_chunks )
+{
+    return max( int64_t( 1 ),
+                min( max_chunks, (nelems + chunk_elems - 1) / chunk_elems ) );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type<scalar_t> lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    lapack_error_if( norm != Norm::Max && norm != Norm::One
+                     && norm != Norm::Inf && norm != Norm::Fro );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < m );
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    if (norm == Norm::Inf) {
+        // Row sums; split rows so each chunk owns its sums. Chunks are
+        // long column segments, so use one per thread.
+        int64_t nchunks = num_chunks( m*n, min( num_threads(), m / 64 ) );
+        int64_t mb = (m + nchunks - 1) / nchunks;
+        std::vector< real_t > values( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            int64_t i1 = c*mb;
+            int64_t mc = min( mb, m - i1 );
+            std::vector< real_t > work( mc, real_t( 0 ) );
+            for (int64_t j = 0; j < n; ++j)
+                seg_add( mc, &A[ i1 + j*lda ], work.data() );
+            real_t value = 0;
+            for (int64_t i = 0; i < mc; ++i)
+                value = nan_max( value, work[ i ] );
+            values[ c ] = value;
+        });
+        real_t value = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            value = nan_max( value, values[ c ] );
+        return value;
+    }
+
+    // Max, One, and Fro split columns.
+    int64_t nb = max( int64_t( 1 ), chunk_elems / m );
+    int64_t nchunks = (n + nb - 1) / nb;
+
+    if (norm == Norm::Fro) {
+        std::vector< SumSq<real_t> > accs( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            int64_t j2 = min( n, (c + 1)*nb );
+            for (int64_t j = c*nb; j < j2; ++j)
+                seg_sumsq( m, &A[ j*lda ], accs[ c ] );
+        });
+        SumSq<real_t> acc;
+        for (int64_t c = 0; c < nchunks; ++c)
+            acc += accs[ c ];
+        real_t scale = 1, sumsq = 0;
+        sumsq_finish( acc, &scale, &sumsq );
+        return scale * std::sqrt( sumsq );
+    }
+
+    std::vector< real_t > values( nchunks );
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        int64_t j2 = min( n, (c + 1)*nb );
+        real_t value = 0;
+        for (int64_t j = c*nb; j < j2; ++j) {
+            value = nan_max( value, norm == Norm::Max
+                                    ? seg_max( m, &A[ j*lda ] )
+                                    : seg_sum( m, &A[ j*lda ] ) );
+        }
+        values[ c ] = value;
+    });
+    real_t value = 0;
+    for (int64_t c = 0; c < nchunks; ++c)
+        value = nan_max( value, values[ c ] );
+    return value;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type<scalar_t> lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, bool hermitian )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    lapack_error_if( norm != Norm::Max && norm != Norm::One
+                     && norm != Norm::Inf && norm != Norm::Fro );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < n );
+
+    if (n == 0)
+        return 0;
+
+    bool upper = (uplo == Uplo::Upper);
+    int64_t nthreads = num_threads();
+    int64_t nelems = n*(n + 1)/2;
+
+    // Off-diagonal part of column j in the stored triangle.
+    auto offdiag = [&]( int64_t j, int64_t* len ) {
+        *len = (upper ? j : n - j - 1);
+        return (upper ? &A[ j*lda ] : &A[ (j + 1) + j*lda ]);
+    };
+
+    if (norm == Norm::One || norm == Norm::Inf) {
+        // Row sums equal column sums; each off-diagonal element adds to
+        // both its row and column. Each chunk accumulates into its own
+        // work vector, summed in order afterwards.
+        int64_t nchunks = num_chunks( nelems, nthreads );
+        std::vector< int64_t > bounds = triangle_chunks( uplo, n, nchunks );
+        nchunks = bounds.size() - 1;
+        std::vector< real_t > work( nchunks*n, real_t( 0 ) );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            real_t* work_c = &work[ c*n ];
+            for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+                int64_t len;
+                scalar_t const* x = offdiag( j, &len );
+                real_t* y = (upper ? work_c : &work_c[ j + 1 ]);
+                work_c[ j ] += seg_sum_add( len, x, y )
+                               + diag_abs( A[ j + j*lda ], hermitian );
+            }
+        });
+        real_t value = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t sum = 0;
+            for (int64_t c = 0; c < nchunks; ++c)
+                sum += work[ i + c*n ];
+            value = nan_max( value, sum );
+        }
+        return value;
+    }
+
+    int64_t nchunks = num_chunks( nelems, max( int64_t( 1 ), nelems / 1024 ) );
+    std::vector< int64_t > bounds = triangle_chunks( uplo, n, nchunks );
+    nchunks = bounds.size() - 1;
+
+    if (norm == Norm::Fro) {
+        // Off-diagonal elements count twice.
+        std::vector< SumSq<real_t> > accs( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+                int64_t len;
+                scalar_t const* x = offdiag( j, &len );
+                seg_sumsq( len, x, accs[ c ] );
+            }
+        });
+        SumSq<real_t> acc;
+        for (int64_t c = 0; c < nchunks; ++c)
+            acc += accs[ c ];
+        acc.asml *= 2;
+        acc.amed *= 2;
+        acc.abig *= 2;
+        for (int64_t j = 0; j < n; ++j) {
+            if (hermitian)
+                acc.add( std::real( A[ j + j*lda ] ) );
+            else
+                acc.add( A[ j + j*lda ] );
+        }
+        real_t scale = 1, sumsq = 0;
+        sumsq_finish( acc, &scale, &sumsq );
+        return scale * std::sqrt( sumsq );
+    }
+
+    // Max
+    std::vector< real_t > values( nchunks );
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        real_t value = 0;
+        for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+            int64_t len;
+            scalar_t const* x = offdiag( j, &len );
+            value = nan_max( value, seg_max( len, x ) );
+            value = nan_max( value, diag_abs( A[ j + j*lda ], hermitian ) );
+        }
+        values[ c ] = value;
+    });
+    real_t value = 0;
+    for (int64_t c = 0; c < nchunks; ++c)
+        value = nan_max( value, values[ c ] );
+    return value;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type<scalar_t> lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    lapack_error_if( norm != Norm::Max && norm != Norm::One
+                     && norm != Norm::Inf && norm != Norm::Fro );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( diag != Diag::NonUnit && diag != Diag::Unit );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < m );
+
+    if (min( m, n ) == 0)
+        return 0;
+
+    bool upper = (uplo == Uplo::Upper);
+    bool unit  = (diag == Diag::Unit);
+
+    // Rows [ *i1, *i2 ) of column j are referenced; with unit diagonal,
+    // the diagonal is excluded and taken as 1, as in LAPACK's lantr.
+    auto rows = [&]( int64_t j, int64_t* i1, int64_t* i2 ) {
+        if (upper) {
+            *i1 = 0;
+            *i2 = min( m, unit ? j : j + 1 );
+        }
+        else {
+            *i1 = min( m, unit ? j + 1 : j );
+            *i2 = m;
+        }
+    };
+
+    int64_t nelems = m*n / 2 + 1;
+
+    if (norm == Norm::Inf) {
+        // Row sums; split rows so each chunk owns its sums.
+        int64_t nchunks = num_chunks( nelems, min( num_threads(), m / 64 ) );
+        int64_t mb = (m + nchunks - 1) / nchunks;
+        std::vector< real_t > values( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            int64_t r1 = c*mb;
+            int64_t r2 = min( m, r1 + mb );
+            std::vector< real_t > work( r2 - r1 );
+            for (int64_t i = r1; i < r2; ++i) {
+                // LAPACK counts the unit diagonal as 1 in every row for
+                // upper, and in the first min( m, n ) rows for lower.
+                work[ i - r1 ] = (unit && (upper || i < n) ? 1 : 0);
+            }
+            for (int64_t j = 0; j < n; ++j) {
+                int64_t i1, i2;
+                rows( j, &i1, &i2 );
+                i1 = max( i1, r1 );
+                i2 = min( i2, r2 );
+                if (i1 < i2)
+                    seg_add( i2 - i1, &A[ i1 + j*lda ], &work[ i1 - r1 ] );
+            }
+            real_t value = 0;
+            for (int64_t i = r1; i < r2; ++i)
+                value = nan_max( value, work[ i - r1 ] );
+            values[ c ] = value;
+        });
+        real_t value = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            value = nan_max( value, values[ c ] );
+        return value;
+    }
+
+    int64_t nchunks = num_chunks( nelems, max( int64_t( 1 ), n / 4 ) );
+    std::vector< int64_t > bounds = triangle_chunks( uplo, n, nchunks );
+    nchunks = bounds.size() - 1;
+
+    if (norm == Norm::Fro) {
+        std::vector< SumSq<real_t> > accs( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+                int64_t i1, i2;
+                rows( j, &i1, &i2 );
+                if (i1 < i2)
+                    seg_sumsq( i2 - i1, &A[ i1 + j*lda ], accs[ c ] );
+            }
+        });
+        SumSq<real_t> acc;
+        for (int64_t c = 0; c < nchunks; ++c)
+            acc += accs[ c ];
+        // unit diagonal contributes min( m, n ) ones
+        real_t scale = 1;
+        real_t sumsq = (unit ? real_t( min( m, n ) ) : real_t( 0 ));
+        sumsq_finish( acc, &scale, &sumsq );
+        return scale * std::sqrt( sumsq );
+    }
+
+    // Max or One. For One, LAPACK counts the unit diagonal as 1 in each
+    // column j < m; upper columns j >= m are entirely off-diagonal.
+    std::vector< real_t > values( nchunks );
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        real_t value = (unit ? 1 : 0);
+        for (int64_t j = bounds[ c ]; j < bounds[ c+1 ]; ++j) {
+            int64_t i1, i2;
+            rows( j, &i1, &i2 );
+            int64_t len = max( int64_t( 0 ), i2 - i1 );
+            if (norm == Norm::Max) {
+                value = nan_max( value, seg_max( len, &A[ i1 + j*lda ] ) );
+            }
+            else {
+                real_t sum = (unit && j < m ? 1 : 0)
+                             + seg_sum( len, &A[ i1 + j*lda ] );
+                value = nan_max( value, sum );
+            }
+        }
+        values[ c ] = value;
+    });
+    real_t value = 0;
+    for (int64_t c = 0; c < nchunks; ++c)
+        value = nan_max( value, values[ c ] );
+    return value;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lassq(
+    int64_t n, scalar_t const* x, int64_t incx,
+    blas::real_type<scalar_t>* scale,
+    blas::real_type<scalar_t>* sumsq )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // As LAPACK's lassq: quick return if either is NaN, then normalize.
+    if (std::isnan( *scale ) || std::isnan( *sumsq ))
+        return;
+    if (*sumsq == 0)
+        *scale = 1;
+    if (*scale == 0) {
+        *scale = 1;
+        *sumsq = 0;
+    }
+    if (n <= 0)
+        return;
+
+    SumSq<real_t> acc;
+    if (incx == 1) {
+        int64_t nchunks = num_chunks( n, n );
+        int64_t nb = (n + nchunks - 1) / nchunks;
+        std::vector< SumSq<real_t> > accs( nchunks );
+        parallel_for( nchunks, [&]( int64_t c, int worker ) {
+            int64_t i1 = c*nb;
+            seg_sumsq( min( nb, n - i1 ), &x[ i1 ], accs[ c ] );
+        });
+        for (int64_t c = 0; c < nchunks; ++c)
+            acc += accs[ c ];
+    }
+    else {
+        int64_t ix = (incx < 0 ? (1 - n)*incx : 0);
+        for (int64_t i = 0; i < n; ++i) {
+            acc.add( x[ ix ] );
+            ix += incx;
+        }
+    }
+    sumsq_finish( acc, scale, sumsq );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+float lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    float const* A, int64_t lda );
+
+template
+double lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    double const* A, int64_t lda );
+
+template
+float lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    std::complex<float> const* A, int64_t lda );
+
+template
+double lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda );
+
+template
+float lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda, bool hermitian );
+
+template
+double lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda, bool hermitian );
+
+template
+float lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda, bool hermitian );
+
+template
+double lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda, bool hermitian );
+
+template
+float lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    float const* A, int64_t lda );
+
+template
+double lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    double const* A, int64_t lda );
+
+template
+float lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> const* A, int64_t lda );
+
+template
+double lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda );
+
+template
+void lassq(
+    int64_t n, float const* x, int64_t incx,
+    float* scale, float* sumsq );
+
+template
+void lassq(
+    int64_t n, double const* x, int64_t incx,
+    double* scale, double* sumsq );
+
+template
+void lassq(
+    int64_t n, std::complex<float> const* x, int64_t incx,
+    float* scale, float* sumsq );
+
+template
+void lassq(
+    int64_t n, std::complex<double> const* x, int64_t incx,
+    double* scale, double* sumsq );
+
+}  // namespace internal
+}  // namespace lapack
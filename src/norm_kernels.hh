@@ -0,0 +1,50 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_NORM_KERNELS_HH
+#define LAPACK_NORM_KERNELS_HH
+
+#include "lapack/util.hh"
+
+#include "blas.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Native, vectorized and threaded norms, used by lange, lansy, lanhe,
+// lantr, and lassq in place of the reference LAPACK loops. Results match
+// LAPACK's up to rounding: NaN propagates, and the Frobenius norm uses
+// Blue's scaled sum of squares, as lassq does, so it neither overflows nor
+// underflows unnecessarily.
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lange(
+    lapack::Norm norm, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda );
+
+// For lanhe, hermitian = true: the imaginary parts of the diagonal are
+// ignored, as for lapack::lanhe.
+template <typename scalar_t>
+blas::real_type<scalar_t> lansy(
+    lapack::Norm norm, lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, bool hermitian );
+
+template <typename scalar_t>
+blas::real_type<scalar_t> lantr(
+    lapack::Norm norm, lapack::Uplo uplo, lapack::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda );
+
+template <typename scalar_t>
+void lassq(
+    int64_t n, scalar_t const* x, int64_t incx,
+    blas::real_type<scalar_t>* scale,
+    blas::real_type<scalar_t>* sumsq );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_NORM_KERNELS_HH
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,13 +28,18 @@ int64_t opgtr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "opgtr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldq_ = (lapack_int) ldq;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (n-1) );
+    lapack::small_vector< float > work( (n-1) );
 
     LAPACK_sopgtr(
         &uplo_, &n_,
@@ -63,13 +69,18 @@ int64_t opgtr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "opgtr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldq_ = (lapack_int) ldq;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n-1) );
+    lapack::small_vector< double > work( (n-1) );
 
     LAPACK_dopgtr(
         &uplo_, &n_,
@@ -87,4 +98,159 @@ int64_t opgtr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_opgtr(
+    char uplo, lapack_int n,
+    float const* AP,
+    float const* tau,
+    float* Q, lapack_int ldq,
+    float* work, lapack_int* info )
+{
+    LAPACK_sopgtr(
+        &uplo, &n,
+        AP,
+        tau,
+        Q, &ldq,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_opgtr(
+    char uplo, lapack_int n,
+    double const* AP,
+    double const* tau,
+    double* Q, lapack_int ldq,
+    double* work, lapack_int* info )
+{
+    LAPACK_dopgtr(
+        &uplo, &n,
+        AP,
+        tau,
+        Q, &ldq,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by opgtr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void opgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n-1 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::opgtr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::opgtr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     opgtr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t opgtr(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "opgtr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n-1 );
+
+    fortran_opgtr(
+        uplo_, n_,
+        AP,
+        tau,
+        Q, ldq_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void opgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    float const* tau,
+    float* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void opgtr_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    double const* tau,
+    double* Q, int64_t ldq,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t opgtr(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP,
+    float const* tau,
+    float* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+template
+int64_t opgtr(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP,
+    double const* tau,
+    double* Q, int64_t ldq,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,6 +33,11 @@ int64_t opmtr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "opmtr", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
@@ -44,7 +50,7 @@ int64_t opmtr(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< float > work( lwork );
+    lapack::small_vector< float > work( lwork );
 
     LAPACK_sopmtr(
         &side_, &uplo_, &trans_, &m_, &n_,
@@ -79,6 +85,11 @@ int64_t opmtr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "opmtr", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
@@ -91,7 +102,7 @@ int64_t opmtr(
     int64_t lwork = (side == Side::Left ? n : m);
 
     // allocate workspace
-    lapack::vector< double > work( lwork );
+    lapack::small_vector< double > work( lwork );
 
     LAPACK_dopmtr(
         &side_, &uplo_, &trans_, &m_, &n_,
@@ -109,4 +120,170 @@ int64_t opmtr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_opmtr(
+    char side, char uplo, char trans, lapack_int m, lapack_int n,
+    float const* AP,
+    float const* tau,
+    float* C, lapack_int ldc,
+    float* work, lapack_int* info )
+{
+    LAPACK_sopmtr(
+        &side, &uplo, &trans, &m, &n,
+        AP,
+        tau,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_opmtr(
+    char side, char uplo, char trans, lapack_int m, lapack_int n,
+    double const* AP,
+    double const* tau,
+    double* C, lapack_int ldc,
+    double* work, lapack_int* info )
+{
+    LAPACK_dopmtr(
+        &side, &uplo, &trans, &m, &n,
+        AP,
+        tau,
+        C, &ldc,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by opmtr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void opmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( side == Side::Left ? n : m );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::opmtr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::opmtr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     opmtr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t opmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    scalar_t const* AP,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "opmtr", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    char uplo_ = uplo2char( uplo );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( side == Side::Left ? n : m );
+
+    fortran_opmtr(
+        side_, uplo_, trans_, m_, n_,
+        AP,
+        tau,
+        C, ldc_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void opmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* AP,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void opmtr_work_size_bytes(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* AP,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t opmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    float const* AP,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t opmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n,
+    double const* AP,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30500  // >= 3.5
 
@@ -38,6 +39,11 @@ int64_t orcsd2by1(
         lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "orcsd2by1", 's', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -75,8 +81,8 @@ int64_t orcsd2by1(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m - min( p, min( m-p, min( q, m-q )))) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m - min( p, min( m-p, min( q, m-q )))) );
 
     LAPACK_sorcsd2by1(
         &jobu1_, &jobu2_, &jobv1t_, &m_, &p_, &q_,
@@ -119,6 +125,11 @@ int64_t orcsd2by1(
         lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "orcsd2by1", 'd', m, -1, -1,
+        []() { return 0.0; } );
+
     char jobu1_ = job_csd2char( jobu1 );
     char jobu2_ = job_csd2char( jobu2 );
     char jobv1t_ = job_csd2char( jobv1t );
@@ -156,8 +167,8 @@ int64_t orcsd2by1(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m - min( p, min( m-p, min( q, m-q )))) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m - min( p, min( m-p, min( q, m-q )))) );
 
     LAPACK_dorcsd2by1(
         &jobu1_, &jobu2_, &jobv1t_, &m_, &p_, &q_,
@@ -179,6 +190,258 @@ int64_t orcsd2by1(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_orcsd2by1(
+    char jobu1, char jobu2, char jobv1t, lapack_int m, lapack_int p, lapack_int q,
+    float* X11, lapack_int ldx11,
+    float* X21, lapack_int ldx21,
+    float* theta,
+    float* U1, lapack_int ldu1,
+    float* U2, lapack_int ldu2,
+    float* V1T, lapack_int ldv1t,
+    float* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_sorcsd2by1(
+        &jobu1, &jobu2, &jobv1t, &m, &p, &q,
+        X11, &ldx11,
+        X21, &ldx21,
+        theta,
+        U1, &ldu1,
+        U2, &ldu2,
+        V1T, &ldv1t,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_orcsd2by1(
+    char jobu1, char jobu2, char jobv1t, lapack_int m, lapack_int p, lapack_int q,
+    double* X11, lapack_int ldx11,
+    double* X21, lapack_int ldx21,
+    double* theta,
+    double* U1, lapack_int ldu1,
+    double* U2, lapack_int ldu2,
+    double* V1T, lapack_int ldv1t,
+    double* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dorcsd2by1(
+        &jobu1, &jobu2, &jobv1t, &m, &p, &q,
+        X11, &ldx11,
+        X21, &ldx21,
+        theta,
+        U1, &ldu1,
+        U2, &ldu2,
+        V1T, &ldv1t,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by orcsd2by1 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void orcsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    scalar_t* X11, int64_t ldx11,
+    scalar_t* X21, int64_t ldx21,
+    scalar_t* theta,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(q) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx11) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx21) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu1_ = job_csd2char( jobu1 );
+    char jobu2_ = job_csd2char( jobu2 );
+    char jobv1t_ = job_csd2char( jobv1t );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int q_ = (lapack_int) q;
+    lapack_int ldx11_ = (lapack_int) ldx11;
+    lapack_int ldx21_ = (lapack_int) ldx21;
+    lapack_int ldu1_ = (lapack_int) ldu1;
+    lapack_int ldu2_ = (lapack_int) ldu2;
+    lapack_int ldv1t_ = (lapack_int) ldv1t;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_orcsd2by1(
+        jobu1_, jobu2_, jobv1t_, m_, p_, q_,
+        X11, ldx11_,
+        X21, ldx21_,
+        theta,
+        U1, ldu1_,
+        U2, ldu2_,
+        V1T, ldv1t_,
+        qry_work, ineg_one,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_int >( m - min( p, min( m-p, min( q, m-q ))) );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::orcsd2by1, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::orcsd2by1 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     orcsd2by1_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t orcsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    scalar_t* X11, int64_t ldx11,
+    scalar_t* X21, int64_t ldx21,
+    scalar_t* theta,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(q) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx11) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx21) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv1t) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "orcsd2by1", trace::internal::precision< scalar_t >(), m, -1, -1,
+        []() { return 0.0; } );
+
+    char jobu1_ = job_csd2char( jobu1 );
+    char jobu2_ = job_csd2char( jobu2 );
+    char jobv1t_ = job_csd2char( jobv1t );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int q_ = (lapack_int) q;
+    lapack_int ldx11_ = (lapack_int) ldx11;
+    lapack_int ldx21_ = (lapack_int) ldx21;
+    lapack_int ldu1_ = (lapack_int) ldu1;
+    lapack_int ldu2_ = (lapack_int) ldu2;
+    lapack_int ldv1t_ = (lapack_int) ldv1t;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int* iwork_ = buffer.take< lapack_int >( m - min( p, min( m-p, min( q, m-q ))) );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_orcsd2by1(
+        jobu1_, jobu2_, jobv1t_, m_, p_, q_,
+        X11, ldx11_,
+        X21, ldx21_,
+        theta,
+        U1, ldu1_,
+        U2, ldu2_,
+        V1T, ldv1t_,
+        work_, lwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void orcsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    float* X11, int64_t ldx11,
+    float* X21, int64_t ldx21,
+    float* theta,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    size_t* work_size );
+
+template
+void orcsd2by1_work_size_bytes(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    double* X11, int64_t ldx11,
+    double* X21, int64_t ldx21,
+    double* theta,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t orcsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    float* X11, int64_t ldx11,
+    float* X21, int64_t ldx21,
+    float* theta,
+    float* U1, int64_t ldu1,
+    float* U2, int64_t ldu2,
+    float* V1T, int64_t ldv1t,
+    void* work, size_t work_size );
+
+template
+int64_t orcsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q,
+    double* X11, int64_t ldx11,
+    double* X21, int64_t ldx21,
+    double* theta,
+    double* U1, int64_t ldu1,
+    double* U2, int64_t ldu2,
+    double* V1T, int64_t ldv1t,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.5.0
@@ -33,6 +33,11 @@ int64_t orhr_col(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
     lapack_error_if(m < n);
+
+    trace::internal::Block trace_block(
+        "orhr_col", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -152,6 +157,11 @@ int64_t orhr_col(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "orhr_col", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int nb_ = (lapack_int) nb;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -35,6 +36,11 @@ int64_t ormbr(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ormbr", 's', m, n, k,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     char side_ = side2char( side );
     char trans_ = op2char( trans );
@@ -64,7 +70,7 @@ int64_t ormbr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_sormbr(
         &vect_, &side_, &trans_, &m_, &n_, &k_,
@@ -103,6 +109,11 @@ int64_t ormbr(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ormbr", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char vect_ = vect2char( vect );
     char side_ = side2char( side );
     char trans_ = op2char( trans );
@@ -132,7 +143,7 @@ int64_t ormbr(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dormbr(
         &vect_, &side_, &trans_, &m_, &n_, &k_,
@@ -150,4 +161,200 @@ int64_t ormbr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ormbr(
+    char vect, char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    float const* A, lapack_int lda,
+    float const* tau,
+    float* C, lapack_int ldc,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sormbr(
+        &vect, &side, &trans, &m, &n, &k,
+        A, &lda,
+        tau,
+        C, &ldc,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ormbr(
+    char vect, char side, char trans, lapack_int m, lapack_int n, lapack_int k,
+    double const* A, lapack_int lda,
+    double const* tau,
+    double* C, lapack_int ldc,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dormbr(
+        &vect, &side, &trans, &m, &n, &k,
+        A, &lda,
+        tau,
+        C, &ldc,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ormbr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ormbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char vect_ = vect2char( vect );
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_ormbr(
+        vect_, side_, trans_, m_, n_, k_,
+        A, lda_,
+        tau,
+        C, ldc_,
+        qry_work, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ormbr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ormbr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ormbr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ormbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ormbr", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char vect_ = vect2char( vect );
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_ormbr(
+        vect_, side_, trans_, m_, n_, k_,
+        A, lda_,
+        tau,
+        C, ldc_,
+        work_, lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ormbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* work_size );
+
+template
+void ormbr_work_size_bytes(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ormbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* work, size_t work_size );
+
+template
+int64_t ormbr(
+    lapack::Vect vect, lapack::Side side, lapack::Op trans, int64_t m,
+    int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* work, size_t work_size );
+
 }  // namespace lapack
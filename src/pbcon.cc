@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -28,6 +29,11 @@ int64_t pbcon(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbcon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int kd_ = (lapack_int) kd;
@@ -35,8 +41,8 @@ int64_t pbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_spbcon(
         &uplo_, &n_, &kd_,
@@ -66,6 +72,11 @@ int64_t pbcon(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbcon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int kd_ = (lapack_int) kd;
@@ -73,8 +84,8 @@ int64_t pbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dpbcon(
         &uplo_, &n_, &kd_,
@@ -104,6 +115,11 @@ int64_t pbcon(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int kd_ = (lapack_int) kd;
@@ -111,8 +127,8 @@ int64_t pbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cpbcon(
         &uplo_, &n_, &kd_,
@@ -187,6 +203,11 @@ int64_t pbcon(
         lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int kd_ = (lapack_int) kd;
@@ -194,8 +215,8 @@ int64_t pbcon(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zpbcon(
         &uplo_, &n_, &kd_,
@@ -212,4 +233,223 @@ int64_t pbcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_pbcon(
+    char uplo, lapack_int n, lapack_int kd,
+    float const* AB, lapack_int ldab, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_spbcon(
+        &uplo, &n, &kd,
+        AB, &ldab, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbcon(
+    char uplo, lapack_int n, lapack_int kd,
+    double const* AB, lapack_int ldab, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dpbcon(
+        &uplo, &n, &kd,
+        AB, &ldab, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbcon(
+    char uplo, lapack_int n, lapack_int kd,
+    std::complex<float> const* AB, lapack_int ldab, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cpbcon(
+        &uplo, &n, &kd,
+        (lapack_complex_float const*) AB, &ldab, &anorm, rcond,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbcon(
+    char uplo, lapack_int n, lapack_int kd,
+    std::complex<double> const* AB, lapack_int ldab, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zpbcon(
+        &uplo, &n, &kd,
+        (lapack_complex_double const*) AB, &ldab, &anorm, rcond,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by pbcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::pbcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::pbcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     pbcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t const* AB, int64_t ldab, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "pbcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_pbcon(
+        uplo_, n_, kd_,
+        AB, ldab_, anorm, rcond,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    float const* AB, int64_t ldab, float anorm,
+    size_t* work_size );
+
+template
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    double const* AB, int64_t ldab, double anorm,
+    size_t* work_size );
+
+template
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab, float anorm,
+    size_t* work_size );
+
+template
+void pbcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    float const* AB, int64_t ldab, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    double const* AB, int64_t ldab, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<float> const* AB, int64_t ldab, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pbcon(
+    lapack::Uplo uplo, int64_t n, int64_t kd,
+    std::complex<double> const* AB, int64_t ldab, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -39,6 +40,11 @@ int64_t pbsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbsvx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( *equed );
@@ -52,8 +58,8 @@ int64_t pbsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_spbsvx(
         &fact_, &uplo_, &n_, &kd_, &nrhs_,
@@ -102,6 +108,11 @@ int64_t pbsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbsvx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( *equed );
@@ -115,8 +126,8 @@ int64_t pbsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dpbsvx(
         &fact_, &uplo_, &n_, &kd_, &nrhs_,
@@ -165,6 +176,11 @@ int64_t pbsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbsvx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( *equed );
@@ -178,8 +194,8 @@ int64_t pbsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cpbsvx(
         &fact_, &uplo_, &n_, &kd_, &nrhs_,
@@ -426,6 +442,11 @@ int64_t pbsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pbsvx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     char uplo_ = uplo2char( uplo );
     char equed_ = equed2char( *equed );
@@ -439,8 +460,8 @@ int64_t pbsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zpbsvx(
         &fact_, &uplo_, &n_, &kd_, &nrhs_,
@@ -465,4 +486,372 @@ int64_t pbsvx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_pbsvx(
+    char fact, char uplo, lapack_int n, lapack_int kd, lapack_int nrhs,
+    float* AB, lapack_int ldab,
+    float* AFB, lapack_int ldafb, char* equed,
+    float* S,
+    float* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_spbsvx(
+        &fact, &uplo, &n, &kd, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb, equed,
+        S,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbsvx(
+    char fact, char uplo, lapack_int n, lapack_int kd, lapack_int nrhs,
+    double* AB, lapack_int ldab,
+    double* AFB, lapack_int ldafb, char* equed,
+    double* S,
+    double* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dpbsvx(
+        &fact, &uplo, &n, &kd, &nrhs,
+        AB, &ldab,
+        AFB, &ldafb, equed,
+        S,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbsvx(
+    char fact, char uplo, lapack_int n, lapack_int kd, lapack_int nrhs,
+    std::complex<float>* AB, lapack_int ldab,
+    std::complex<float>* AFB, lapack_int ldafb, char* equed,
+    float* S,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cpbsvx(
+        &fact, &uplo, &n, &kd, &nrhs,
+        (lapack_complex_float*) AB, &ldab,
+        (lapack_complex_float*) AFB, &ldafb, equed,
+        S,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pbsvx(
+    char fact, char uplo, lapack_int n, lapack_int kd, lapack_int nrhs,
+    std::complex<double>* AB, lapack_int ldab,
+    std::complex<double>* AFB, lapack_int ldafb, char* equed,
+    double* S,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zpbsvx(
+        &fact, &uplo, &n, &kd, &nrhs,
+        (lapack_complex_double*) AB, &ldab,
+        (lapack_complex_double*) AFB, &ldafb, equed,
+        S,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by pbsvx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::pbsvx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::pbsvx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     pbsvx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    blas::real_type<scalar_t>* S,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldafb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "pbsvx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char fact_ = factored2char( fact );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldafb_ = (lapack_int) ldafb;
+    char equed_ = equed2char( *equed );
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_pbsvx(
+        fact_, uplo_, n_, kd_, nrhs_,
+        AB, ldab_,
+        AFB, ldafb_, &equed_,
+        S,
+        B, ldb_,
+        X, ldx_, rcond,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *equed = char2equed( equed_ );
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    float* AB, int64_t ldab,
+    float* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    float* S,
+    float* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    double* AB, int64_t ldab,
+    double* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    double* S,
+    double* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    float* S,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void pbsvx_work_size_bytes(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    double* S,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    float* AB, int64_t ldab,
+    float* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    float* S,
+    float* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    double* AB, int64_t ldab,
+    double* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    double* S,
+    double* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    float* S,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t pbsvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t kd,
+    int64_t nrhs,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* AFB, int64_t ldafb,
+    lapack::Equed* equed,
+    double* S,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
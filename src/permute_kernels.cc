@@ -0,0 +1,353 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "permute_kernels.hh"
+#include "ThreadPool.hh"
+
+#include <cstring>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+// Work is split into chunks of about this many elements moved, which are
+// spread over the thread pool.
+static const int64_t chunk_elems = 65536;
+
+// Column permutations split rows into strips of at least this many rows.
+static const int64_t min_strip = 256;
+
+//------------------------------------------------------------------------------
+// Returns the 0-based source of each destination: destination i takes
+// source src[i]. Throws if K is not a permutation of 1, ..., n.
+inline std::vector< int64_t > permutation_sources(
+    bool forward, int64_t n, int64_t const* K )
+{
+    std::vector< int64_t > src( n, -1 );
+    for (int64_t i = 0; i < n; ++i) {
+        int64_t k = K[ i ] - 1;
+        lapack_error_if( k < 0 || k >= n );
+        if (forward)
+            src[ i ] = k;
+        else
+            src[ k ] = i;
+    }
+    // each source must be used exactly once
+    std::vector< char > used( n, false );
+    for (int64_t i = 0; i < n; ++i) {
+        lapack_error_if( src[ i ] < 0 || used[ src[ i ] ] );
+        used[ src[ i ] ] = true;
+    }
+    return src;
+}
+
+//------------------------------------------------------------------------------
+// Cycles of length > 1 of a permutation. Cycle c is
+//     p_0, ..., p_{k-1} = index[ offset[ c ] : offset[ c+1 ] ],
+// with p_{t+1} = src[ p_t ], so applying it moves p_{t+1} to p_t, and p_0
+// to p_{k-1}.
+struct Cycles {
+    std::vector< int64_t > index;
+    std::vector< int64_t > offset;
+
+    int64_t size() const
+        { return offset.size() - 1; }
+
+    explicit Cycles( std::vector< int64_t > const& src )
+    {
+        int64_t n = src.size();
+        std::vector< char > visited( n, false );
+        offset.push_back( 0 );
+        for (int64_t i = 0; i < n; ++i) {
+            if (visited[ i ] || src[ i ] == i)
+                continue;
+            for (int64_t p = i; ! visited[ p ]; p = src[ p ]) {
+                visited[ p ] = true;
+                index.push_back( p );
+            }
+            offset.push_back( index.size() );
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+// Applies the cycles to the vector x.
+template <typename scalar_t>
+inline void apply_cycles( Cycles const& cycles, scalar_t* x )
+{
+    int64_t const* index = cycles.index.data();
+    for (int64_t c = 0; c < cycles.size(); ++c) {
+        int64_t t1 = cycles.offset[ c ];
+        int64_t t2 = cycles.offset[ c+1 ];
+        scalar_t tmp = x[ index[ t1 ] ];
+        for (int64_t t = t1; t < t2 - 1; ++t)
+            x[ index[ t ] ] = x[ index[ t+1 ] ];
+        x[ index[ t2 - 1 ] ] = tmp;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    scalar_t* X, int64_t ldx,
+    int64_t const* K )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldx < m );
+
+    if (m <= 1 || n == 0)
+        return;
+
+    Cycles cycles( permutation_sources( forward, m, K ) );
+    int64_t moved = cycles.index.size();
+    if (moved == 0)
+        return;
+
+    // Each column is permuted independently, with its cycles in cache.
+    // Chunks of columns are spread over the thread pool.
+    int64_t nb = max( int64_t( 1 ), chunk_elems / moved );
+    int64_t nchunks = (n + nb - 1) / nb;
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        int64_t j2 = min( n, (c + 1)*nb );
+        for (int64_t j = c*nb; j < j2; ++j)
+            apply_cycles( cycles, &X[ j*ldx ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    scalar_t const* X, int64_t ldx,
+    int64_t const* K,
+    scalar_t* Y, int64_t ldy )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldx < m );
+    lapack_error_if( ldy < m );
+
+    if (m == 0 || n == 0)
+        return;
+
+    std::vector< int64_t > src = permutation_sources( forward, m, K );
+    int64_t const* s = src.data();
+
+    int64_t nb = max( int64_t( 1 ), chunk_elems / m );
+    int64_t nchunks = (n + nb - 1) / nb;
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        int64_t j2 = min( n, (c + 1)*nb );
+        for (int64_t j = c*nb; j < j2; ++j) {
+            scalar_t const* x = &X[ j*ldx ];
+            scalar_t* y = &Y[ j*ldy ];
+            for (int64_t i = 0; i < m; ++i)
+                y[ i ] = x[ s[ i ] ];
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    scalar_t* X, int64_t ldx,
+    int64_t const* K )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldx < m );
+
+    if (m == 0 || n <= 1)
+        return;
+
+    Cycles cycles( permutation_sources( forward, n, K ) );
+    int64_t ncycles = cycles.size();
+    if (ncycles == 0)
+        return;
+
+    // Tasks are a strip of rows by a group of cycles; every column move
+    // within a strip is a contiguous copy through a per-worker buffer.
+    // Strips are used first, as they split the work evenly; if there are
+    // too few, cycles are split into groups of about equal length.
+    int threads = num_threads();
+    int64_t nstrips = max( int64_t( 1 ), min( int64_t( threads ), m / min_strip ) );
+    int64_t mb = (m + nstrips - 1) / nstrips;
+    int64_t ngroups = min( ncycles, max( int64_t( 1 ), threads / nstrips ) );
+    int64_t moved = cycles.index.size();
+    std::vector< int64_t > group( 1, 0 );
+    for (int64_t c = 0; c < ncycles; ++c) {
+        if (cycles.offset[ c+1 ] * ngroups >= moved * int64_t( group.size() ))
+            group.push_back( c + 1 );
+    }
+    if (group.back() != ncycles)
+        group.push_back( ncycles );
+    ngroups = group.size() - 1;
+
+    std::vector< std::vector< scalar_t > > tmp( threads );
+    parallel_for( nstrips * ngroups, [&]( int64_t task, int worker ) {
+        int64_t i1 = (task % nstrips) * mb;
+        int64_t g  =  task / nstrips;
+        int64_t ib = min( mb, m - i1 );
+        size_t bytes = ib * sizeof(scalar_t);
+        std::vector< scalar_t >& buf = tmp[ worker ];
+        buf.resize( ib );
+        int64_t const* index = cycles.index.data();
+        for (int64_t c = group[ g ]; c < group[ g+1 ]; ++c) {
+            int64_t t1 = cycles.offset[ c ];
+            int64_t t2 = cycles.offset[ c+1 ];
+            std::memcpy( buf.data(), &X[ i1 + index[ t1 ]*ldx ], bytes );
+            for (int64_t t = t1; t < t2 - 1; ++t) {
+                std::memcpy( &X[ i1 + index[ t   ]*ldx ],
+                             &X[ i1 + index[ t+1 ]*ldx ], bytes );
+            }
+            std::memcpy( &X[ i1 + index[ t2 - 1 ]*ldx ], buf.data(), bytes );
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    scalar_t const* X, int64_t ldx,
+    int64_t const* K,
+    scalar_t* Y, int64_t ldy )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldx < m );
+    lapack_error_if( ldy < m );
+
+    if (m == 0 || n == 0)
+        return;
+
+    std::vector< int64_t > src = permutation_sources( forward, n, K );
+
+    int64_t nb = max( int64_t( 1 ), chunk_elems / m );
+    int64_t nchunks = (n + nb - 1) / nb;
+    parallel_for( nchunks, [&]( int64_t c, int worker ) {
+        int64_t j2 = min( n, (c + 1)*nb );
+        for (int64_t j = c*nb; j < j2; ++j) {
+            std::memcpy( &Y[ j*ldy ], &X[ src[ j ]*ldx ],
+                         m * sizeof(scalar_t) );
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    float* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    double* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    std::complex<float>* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    std::complex<double>* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy );
+
+template
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    float* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    double* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    std::complex<float>* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    std::complex<double>* X, int64_t ldx,
+    int64_t const* K );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    float const* X, int64_t ldx,
+    int64_t const* K,
+    float* Y, int64_t ldy );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    double const* X, int64_t ldx,
+    int64_t const* K,
+    double* Y, int64_t ldy );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    std::complex<float> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<float>* Y, int64_t ldy );
+
+template
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    std::complex<double> const* X, int64_t ldx,
+    int64_t const* K,
+    std::complex<double>* Y, int64_t ldy );
+
+}  // namespace internal
+}  // namespace lapack
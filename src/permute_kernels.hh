@@ -0,0 +1,55 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_PERMUTE_KERNELS_HH
+#define LAPACK_PERMUTE_KERNELS_HH
+
+#include "lapack/util.hh"
+
+#include "blas.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Native, threaded row and column permutations, used by lapmr and lapmt in
+// place of the reference LAPACK loops. The permutation K is 1-based, as
+// in LAPACK, and is not modified. In-place versions split the permutation
+// into cycles once and move each element only if its cycle has length > 1.
+// Out-of-place versions gather X into Y:
+//     forward:  Y( i, : ) = X( K(i), : ) for lapmr,
+//               Y( :, j ) = X( :, K(j) ) for lapmt;
+//     backward: the inverse permutation.
+
+template <typename scalar_t>
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    scalar_t* X, int64_t ldx,
+    int64_t const* K );
+
+template <typename scalar_t>
+void lapmr(
+    bool forward, int64_t m, int64_t n,
+    scalar_t const* X, int64_t ldx,
+    int64_t const* K,
+    scalar_t* Y, int64_t ldy );
+
+template <typename scalar_t>
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    scalar_t* X, int64_t ldx,
+    int64_t const* K );
+
+template <typename scalar_t>
+void lapmt(
+    bool forward, int64_t m, int64_t n,
+    scalar_t const* X, int64_t ldx,
+    int64_t const* K,
+    scalar_t* Y, int64_t ldy );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_PERMUTE_KERNELS_HH
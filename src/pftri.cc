@@ -23,6 +23,11 @@ int64_t pftri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftri", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -50,6 +55,11 @@ int64_t pftri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftri", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -77,6 +87,11 @@ int64_t pftri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftri", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -104,6 +119,11 @@ int64_t pftri(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftri", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
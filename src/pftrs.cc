@@ -26,6 +26,11 @@ int64_t pftrs(
         lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftrs", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -59,6 +64,11 @@ int64_t pftrs(
         lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftrs", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -92,6 +102,11 @@ int64_t pftrs(
         lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftrs", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -125,6 +140,11 @@ int64_t pftrs(
         lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pftrs", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30300  // >= 3.3
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for bbcsd, querying and allocating its workspace.
+/// See lapack::bbcsd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+bbcsd< scalar_t >::bbcsd(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t,
+    lapack::Job jobv2t, lapack::Op trans, int64_t m, int64_t p, int64_t q )
+    : jobu1_( jobu1 ),
+      jobu2_( jobu2 ),
+      jobv1t_( jobv1t ),
+      jobv2t_( jobv2t ),
+      trans_( trans ),
+      m_( m ),
+      p_( p ),
+      q_( q )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldu1 = max( 1, p );
+    int64_t ldu2 = max( 1, m-p );
+    int64_t ldv1t = max( 1, q );
+    int64_t ldv2t = max( 1, m-q );
+    size_t work_size;
+    lapack::bbcsd_work_size_bytes(
+        jobu1, jobu2, jobv1t, jobv2t, trans, m, p, q,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldu1,
+        (scalar_t*) nullptr, ldu2,
+        (scalar_t*) nullptr, ldv1t,
+        (scalar_t*) nullptr, ldv2t,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the CS decomposition of a bidiagonal-block matrix
+/// using the plan's workspace; see lapack::bbcsd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t bbcsd< scalar_t >::execute(
+    real_t* theta,
+    real_t* phi,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t,
+    scalar_t* V2T, int64_t ldv2t,
+    real_t* B11D,
+    real_t* B11E,
+    real_t* B12D,
+    real_t* B12E,
+    real_t* B21D,
+    real_t* B21E,
+    real_t* B22D,
+    real_t* B22E )
+{
+    return lapack::bbcsd(
+        jobu1_, jobu2_, jobv1t_, jobv2t_, trans_, m_, p_, q_,
+        theta,
+        phi,
+        U1, ldu1,
+        U2, ldu2,
+        V1T, ldv1t,
+        V2T, ldv2t,
+        B11D,
+        B11E,
+        B12D,
+        B12E,
+        B21D,
+        B21E,
+        B22D,
+        B22E,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class bbcsd< float >;
+template class bbcsd< double >;
+template class bbcsd< std::complex<float> >;
+template class bbcsd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.3.0
@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gebrd, querying and allocating its workspace.
+/// See lapack::gebrd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gebrd< scalar_t >::gebrd(
+    int64_t m, int64_t n )
+    : m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::gebrd_work_size_bytes(
+        m, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a general matrix to bidiagonal form
+/// using the plan's workspace; see lapack::gebrd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gebrd< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* D,
+    real_t* E,
+    scalar_t* tauq,
+    scalar_t* taup )
+{
+    return lapack::gebrd(
+        m_, n_,
+        A, lda,
+        D,
+        E,
+        tauq,
+        taup,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gebrd< float >;
+template class gebrd< double >;
+template class gebrd< std::complex<float> >;
+template class gebrd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
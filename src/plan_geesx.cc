@@ -0,0 +1,76 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for geesx, querying and allocating its workspace.
+/// See lapack::geesx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+geesx< scalar_t >::geesx(
+    lapack::Job jobvs, lapack::Sort sort, select_t select,
+    lapack::Sense sense, int64_t n )
+    : jobvs_( jobvs ),
+      sort_( sort ),
+      select_( select ),
+      sense_( sense ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldvs = max( 1, n );
+    size_t work_size;
+    lapack::geesx_work_size_bytes(
+        jobvs, sort, select, sense, n,
+        (scalar_t*) nullptr, lda,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr, ldvs,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the Schur factorization, with condition numbers,
+/// using the plan's workspace; see lapack::geesx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t geesx< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VS, int64_t ldvs,
+    real_t* rconde,
+    real_t* rcondv )
+{
+    return lapack::geesx(
+        jobvs_, sort_, select_, sense_, n_,
+        A, lda,
+        sdim,
+        W,
+        VS, ldvs,
+        rconde,
+        rcondv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class geesx< float >;
+template class geesx< double >;
+template class geesx< std::complex<float> >;
+template class geesx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for geev, querying and allocating its workspace.
+/// See lapack::geev for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+geev< scalar_t >::geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n )
+    : jobvl_( jobvl ),
+      jobvr_( jobvr ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldvl = max( 1, n );
+    int64_t ldvr = max( 1, n );
+    size_t work_size;
+    lapack::geev_work_size_bytes(
+        jobvl, jobvr, n,
+        (scalar_t*) nullptr, lda,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr, ldvl,
+        (scalar_t*) nullptr, ldvr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvalues and, optionally, eigenvectors using the plan's
+/// workspace; see lapack::geev.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t geev< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr )
+{
+    return lapack::geev(
+        jobvl_, jobvr_, n_,
+        A, lda,
+        W,
+        VL, ldvl,
+        VR, ldvr,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class geev< float >;
+template class geev< double >;
+template class geev< std::complex<float> >;
+template class geev< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gehrd, querying and allocating its workspace.
+/// See lapack::gehrd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gehrd< scalar_t >::gehrd(
+    int64_t n, int64_t ilo, int64_t ihi )
+    : n_( n ),
+      ilo_( ilo ),
+      ihi_( ihi )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::gehrd_work_size_bytes(
+        n, ilo, ihi,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a general matrix to upper Hessenberg form
+/// using the plan's workspace; see lapack::gehrd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gehrd< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* tau )
+{
+    return lapack::gehrd(
+        n_, ilo_, ihi_,
+        A, lda,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gehrd< float >;
+template class gehrd< double >;
+template class gehrd< std::complex<float> >;
+template class gehrd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,67 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gelq, querying and allocating its workspace.
+/// See lapack::gelq for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gelq< scalar_t >::gelq(
+    int64_t m, int64_t n, int64_t tsize )
+    : m_( m ),
+      n_( n ),
+      tsize_( tsize )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::gelq_work_size_bytes(
+        m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, tsize,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the LQ factorization, with tall-skinny LQ,
+/// using the plan's workspace; see lapack::gelq.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gelq< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* T )
+{
+    return lapack::gelq(
+        m_, n_,
+        A, lda,
+        T, tsize_,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gelq< float >;
+template class gelq< double >;
+template class gelq< std::complex<float> >;
+template class gelq< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gels, querying and allocating its workspace.
+/// See lapack::gels for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gels< scalar_t >::gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs )
+    : trans_( trans ),
+      m_( m ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, m, n );
+    size_t work_size;
+    lapack::gels_work_size_bytes(
+        trans, m, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves the least squares problem
+/// using the plan's workspace; see lapack::gels.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gels< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    return lapack::gels(
+        trans_, m_, n_, nrhs_,
+        A, lda,
+        B, ldb,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gels< float >;
+template class gels< double >;
+template class gels< std::complex<float> >;
+template class gels< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
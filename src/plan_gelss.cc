@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gelss, querying and allocating its workspace.
+/// See lapack::gelss for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gelss< scalar_t >::gelss(
+    int64_t m, int64_t n, int64_t nrhs )
+    : m_( m ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query;
+    // rcond doesn't affect the workspace
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, m, n );
+    size_t work_size;
+    lapack::gelss_work_size_bytes(
+        m, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (real_t*) nullptr, real_t( -1 ),
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves the least squares problem by the SVD using the plan's workspace;
+/// see lapack::gelss.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gelss< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    real_t* S, real_t rcond,
+    int64_t* rank )
+{
+    return lapack::gelss(
+        m_, n_, nrhs_,
+        A, lda,
+        B, ldb,
+        S, rcond,
+        rank,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gelss< float >;
+template class gelss< double >;
+template class gelss< std::complex<float> >;
+template class gelss< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
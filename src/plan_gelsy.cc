@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gelsy, querying and allocating its workspace.
+/// See lapack::gelsy for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gelsy< scalar_t >::gelsy(
+    int64_t m, int64_t n, int64_t nrhs )
+    : m_( m ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, m, n );
+    size_t work_size;
+    lapack::gelsy_work_size_bytes(
+        m, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb, real_t( -1 ),
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves a least squares problem by complete orthogonal factorization,
+/// using the plan's workspace; see lapack::gelsy.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gelsy< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* jpvt, real_t rcond,
+    int64_t* rank )
+{
+    return lapack::gelsy(
+        m_, n_, nrhs_,
+        A, lda,
+        B, ldb,
+        jpvt, rcond,
+        rank,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gelsy< float >;
+template class gelsy< double >;
+template class gelsy< std::complex<float> >;
+template class gelsy< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
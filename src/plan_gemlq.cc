@@ -0,0 +1,75 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gemlq, querying and allocating its workspace.
+/// See lapack::gemlq for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gemlq< scalar_t >::gemlq(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t tsize )
+    : side_( side ),
+      trans_( trans ),
+      m_( m ),
+      n_( n ),
+      k_( k ),
+      tsize_( tsize )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, k );
+    int64_t ldc = max( 1, m );
+    size_t work_size;
+    lapack::gemlq_work_size_bytes(
+        side, trans, m, n, k,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, tsize,
+        (scalar_t*) nullptr, ldc,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies by the matrix Q from gelq
+/// using the plan's workspace; see lapack::gemlq.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gemlq< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T,
+    scalar_t* C, int64_t ldc )
+{
+    return lapack::gemlq(
+        side_, trans_, m_, n_, k_,
+        A, lda,
+        T, tsize_,
+        C, ldc,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gemlq< float >;
+template class gemlq< double >;
+template class gemlq< std::complex<float> >;
+template class gemlq< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
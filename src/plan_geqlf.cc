@@ -0,0 +1,61 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for geqlf, querying and allocating its workspace.
+/// See lapack::geqlf for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+geqlf< scalar_t >::geqlf(
+    int64_t m, int64_t n )
+    : m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::geqlf_work_size_bytes(
+        m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the QL factorization using the plan's workspace; see lapack::geqlf.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t geqlf< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* tau )
+{
+    return lapack::geqlf(
+        m_, n_,
+        A, lda,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class geqlf< float >;
+template class geqlf< double >;
+template class geqlf< std::complex<float> >;
+template class geqlf< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
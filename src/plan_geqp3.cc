@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for geqp3, querying and allocating its workspace.
+/// See lapack::geqp3 for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+geqp3< scalar_t >::geqp3(
+    int64_t m, int64_t n )
+    : m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::geqp3_work_size_bytes(
+        m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the QR factorization with column pivoting
+/// using the plan's workspace; see lapack::geqp3.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t geqp3< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* jpvt,
+    scalar_t* tau )
+{
+    return lapack::geqp3(
+        m_, n_,
+        A, lda,
+        jpvt,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class geqp3< float >;
+template class geqp3< double >;
+template class geqp3< std::complex<float> >;
+template class geqp3< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30202  // >= v3.2.2
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for geqrfp, querying and allocating its workspace.
+/// See lapack::geqrfp for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+geqrfp< scalar_t >::geqrfp(
+    int64_t m, int64_t n )
+    : m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::geqrfp_work_size_bytes(
+        m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the QR factorization, with nonnegative diagonal R,
+/// using the plan's workspace; see lapack::geqrfp.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t geqrfp< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* tau )
+{
+    return lapack::geqrfp(
+        m_, n_,
+        A, lda,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class geqrfp< float >;
+template class geqrfp< double >;
+template class geqrfp< std::complex<float> >;
+template class geqrfp< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= v3.2.2
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gesdd, querying and allocating its workspace.
+/// See lapack::gesdd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gesdd< scalar_t >::gesdd(
+    lapack::Job jobz, int64_t m, int64_t n )
+    : jobz_( jobz ),
+      m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldu = max( 1, m );
+    int64_t ldvt = max( 1, n );
+    size_t work_size;
+    lapack::gesdd_work_size_bytes(
+        jobz, m, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldu,
+        (scalar_t*) nullptr, ldvt,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the SVD using the plan's workspace; see lapack::gesdd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gesdd< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt )
+{
+    return lapack::gesdd(
+        jobz_, m_, n_,
+        A, lda,
+        S,
+        U, ldu,
+        VT, ldvt,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gesdd< float >;
+template class gesdd< double >;
+template class gesdd< std::complex<float> >;
+template class gesdd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
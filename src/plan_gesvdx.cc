@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30600  // >= v3.6
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gesvdx, querying and allocating its workspace.
+/// See lapack::gesvdx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gesvdx< scalar_t >::gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m,
+    int64_t n )
+    : jobu_( jobu ),
+      jobvt_( jobvt ),
+      range_( range ),
+      m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldu = max( 1, m );
+    int64_t ldvt = max( 1, n );
+    size_t work_size;
+    lapack::gesvdx_work_size_bytes(
+        jobu, jobvt, range, m, n,
+        (scalar_t*) nullptr, lda, real_t( 0 ), real_t( 1 ), 1, std::min( m, n ),
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldu,
+        (scalar_t*) nullptr, ldvt,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected singular values and vectors
+/// using the plan's workspace; see lapack::gesvdx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gesvdx< scalar_t >::execute(
+    scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    real_t* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt )
+{
+    return lapack::gesvdx(
+        jobu_, jobvt_, range_, m_, n_,
+        A, lda, vl, vu, il, iu, nfound,
+        S,
+        U, ldu,
+        VT, ldvt,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gesvdx< float >;
+template class gesvdx< double >;
+template class gesvdx< std::complex<float> >;
+template class gesvdx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= v3.6
@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for getri, querying and allocating its workspace.
+/// See lapack::getri for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+getri< scalar_t >::getri(
+    int64_t n )
+    : n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::getri_work_size_bytes(
+        n,
+        (scalar_t*) nullptr, lda,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the inverse from the LU factorization
+/// using the plan's workspace; see lapack::getri.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t getri< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv )
+{
+    return lapack::getri(
+        n_,
+        A, lda,
+        ipiv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class getri< float >;
+template class getri< double >;
+template class getri< std::complex<float> >;
+template class getri< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
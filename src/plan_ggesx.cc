@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ggesx, querying and allocating its workspace.
+/// See lapack::ggesx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ggesx< scalar_t >::ggesx(
+    lapack::Job jobvsl, lapack::Job jobvsr, lapack::Sort sort,
+    select_t select, lapack::Sense sense, int64_t n )
+    : jobvsl_( jobvsl ),
+      jobvsr_( jobvsr ),
+      sort_( sort ),
+      select_( select ),
+      sense_( sense ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    int64_t ldvsl = max( 1, n );
+    int64_t ldvsr = max( 1, n );
+    size_t work_size;
+    lapack::ggesx_work_size_bytes(
+        jobvsl, jobvsr, sort, select, sense, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldvsl,
+        (scalar_t*) nullptr, ldvsr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the generalized Schur factorization, with condition numbers,
+/// using the plan's workspace; see lapack::ggesx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ggesx< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t* sdim,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VSL, int64_t ldvsl,
+    scalar_t* VSR, int64_t ldvsr,
+    real_t* rconde,
+    real_t* rcondv )
+{
+    return lapack::ggesx(
+        jobvsl_, jobvsr_, sort_, select_, sense_, n_,
+        A, lda,
+        B, ldb,
+        sdim,
+        alpha,
+        beta,
+        VSL, ldvsl,
+        VSR, ldvsr,
+        rconde,
+        rcondv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ggesx< float >;
+template class ggesx< double >;
+template class ggesx< std::complex<float> >;
+template class ggesx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
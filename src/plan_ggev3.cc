@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30600  // >= v3.6
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ggev3, querying and allocating its workspace.
+/// See lapack::ggev3 for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ggev3< scalar_t >::ggev3(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n )
+    : jobvl_( jobvl ),
+      jobvr_( jobvr ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    int64_t ldvl = max( 1, n );
+    int64_t ldvr = max( 1, n );
+    size_t work_size;
+    lapack::ggev3_work_size_bytes(
+        jobvl, jobvr, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldvl,
+        (scalar_t*) nullptr, ldvr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes generalized eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::ggev3.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ggev3< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr )
+{
+    return lapack::ggev3(
+        jobvl_, jobvr_, n_,
+        A, lda,
+        B, ldb,
+        alpha,
+        beta,
+        VL, ldvl,
+        VR, ldvr,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ggev3< float >;
+template class ggev3< double >;
+template class ggev3< std::complex<float> >;
+template class ggev3< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= v3.6
@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for gglse, querying and allocating its workspace.
+/// See lapack::gglse for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+gglse< scalar_t >::gglse(
+    int64_t m, int64_t n, int64_t p )
+    : m_( m ),
+      n_( n ),
+      p_( p )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, p );
+    size_t work_size;
+    lapack::gglse_work_size_bytes(
+        m, n, p,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves a linear equality-constrained least squares problem
+/// using the plan's workspace; see lapack::gglse.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t gglse< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* C,
+    scalar_t* D,
+    scalar_t* X )
+{
+    return lapack::gglse(
+        m_, n_, p_,
+        A, lda,
+        B, ldb,
+        C,
+        D,
+        X,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class gglse< float >;
+template class gglse< double >;
+template class gglse< std::complex<float> >;
+template class gglse< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
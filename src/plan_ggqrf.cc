@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ggqrf, querying and allocating its workspace.
+/// See lapack::ggqrf for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ggqrf< scalar_t >::ggqrf(
+    int64_t n, int64_t m, int64_t p )
+    : n_( n ),
+      m_( m ),
+      p_( p )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    size_t work_size;
+    lapack::ggqrf_work_size_bytes(
+        n, m, p,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldb,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the generalized QR factorization
+/// using the plan's workspace; see lapack::ggqrf.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ggqrf< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub )
+{
+    return lapack::ggqrf(
+        n_, m_, p_,
+        A, lda,
+        taua,
+        B, ldb,
+        taub,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ggqrf< float >;
+template class ggqrf< double >;
+template class ggqrf< std::complex<float> >;
+template class ggqrf< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ggrqf, querying and allocating its workspace.
+/// See lapack::ggrqf for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ggrqf< scalar_t >::ggrqf(
+    int64_t m, int64_t p, int64_t n )
+    : m_( m ),
+      p_( p ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, p );
+    size_t work_size;
+    lapack::ggrqf_work_size_bytes(
+        m, p, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldb,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the generalized RQ factorization
+/// using the plan's workspace; see lapack::ggrqf.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ggrqf< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* taua,
+    scalar_t* B, int64_t ldb,
+    scalar_t* taub )
+{
+    return lapack::ggrqf(
+        m_, p_, n_,
+        A, lda,
+        taua,
+        B, ldb,
+        taub,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ggrqf< float >;
+template class ggrqf< double >;
+template class ggrqf< std::complex<float> >;
+template class ggrqf< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30600  // >= v3.6
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ggsvp3, querying and allocating its workspace.
+/// See lapack::ggsvp3 for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ggsvp3< scalar_t >::ggsvp3(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq, int64_t m,
+    int64_t p, int64_t n )
+    : jobu_( jobu ),
+      jobv_( jobv ),
+      jobq_( jobq ),
+      m_( m ),
+      p_( p ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, p );
+    int64_t ldu = max( 1, m );
+    int64_t ldv = max( 1, p );
+    int64_t ldq = max( 1, n );
+    size_t work_size;
+    lapack::ggsvp3_work_size_bytes(
+        jobu, jobv, jobq, m, p, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb, real_t( 0 ), real_t( 0 ),
+        (scalar_t*) nullptr, ldu,
+        (scalar_t*) nullptr, ldv,
+        (scalar_t*) nullptr, ldq,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the preprocessing for the generalized SVD
+/// using the plan's workspace; see lapack::ggsvp3.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ggsvp3< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, real_t tola, real_t tolb,
+    int64_t* k,
+    int64_t* l,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* tau )
+{
+    return lapack::ggsvp3(
+        jobu_, jobv_, jobq_, m_, p_, n_,
+        A, lda,
+        B, ldb, tola, tolb, k, l,
+        U, ldu,
+        V, ldv,
+        Q, ldq,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ggsvp3< float >;
+template class ggsvp3< double >;
+template class ggsvp3< std::complex<float> >;
+template class ggsvp3< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= v3.6
@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hbevd_2stage (or sbevd_2stage), querying and
+/// allocating its workspace.
+/// See lapack::hbevd_2stage for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hbevd_2stage< scalar_t >::hbevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n ),
+      kd_( kd )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldab = max( 1, kd+1 );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hbevd_2stage_work_size_bytes(
+        jobz, uplo, n, kd,
+        (scalar_t*) nullptr, ldab,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes band eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::hbevd_2stage.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hbevd_2stage< scalar_t >::execute(
+    scalar_t* AB, int64_t ldab,
+    real_t* W,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hbevd_2stage(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab,
+        W,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hbevd_2stage< float >;
+template class hbevd_2stage< double >;
+template class hbevd_2stage< std::complex<float> >;
+template class hbevd_2stage< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hbevx_2stage (or sbevx_2stage), querying and
+/// allocating its workspace.
+/// See lapack::hbevx_2stage for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hbevx_2stage< scalar_t >::hbevx_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    int64_t kd )
+    : jobz_( jobz ),
+      range_( range ),
+      uplo_( uplo ),
+      n_( n ),
+      kd_( kd )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldab = max( 1, kd+1 );
+    int64_t ldq = max( 1, n );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hbevx_2stage_work_size_bytes(
+        jobz, range, uplo, n, kd,
+        (scalar_t*) nullptr, ldab,
+        (scalar_t*) nullptr, ldq, real_t( 0 ), real_t( 1 ), 1, n, real_t( 0 ),
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected band eigenvalues and, optionally, eigenvectors,
+/// using the plan's workspace; see lapack::hbevx_2stage.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hbevx_2stage< scalar_t >::execute(
+    scalar_t* AB, int64_t ldab,
+    scalar_t* Q, int64_t ldq, real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* m,
+    real_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    return lapack::hbevx_2stage(
+        jobz_, range_, uplo_, n_, kd_,
+        AB, ldab,
+        Q, ldq, vl, vu, il, iu, abstol, m,
+        W,
+        Z, ldz,
+        ifail,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hbevx_2stage< float >;
+template class hbevx_2stage< double >;
+template class hbevx_2stage< std::complex<float> >;
+template class hbevx_2stage< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hbgvd (or sbgvd), querying and allocating its workspace.
+/// See lapack::hbgvd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hbgvd< scalar_t >::hbgvd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n ),
+      ka_( ka ),
+      kb_( kb )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldab = max( 1, ka+1 );
+    int64_t ldbb = max( 1, kb+1 );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hbgvd_work_size_bytes(
+        jobz, uplo, n, ka, kb,
+        (scalar_t*) nullptr, ldab,
+        (scalar_t*) nullptr, ldbb,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes generalized band eigenvalues and, optionally, eigenvectors,
+/// using the plan's workspace; see lapack::hbgvd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hbgvd< scalar_t >::execute(
+    scalar_t* AB, int64_t ldab,
+    scalar_t* BB, int64_t ldbb,
+    real_t* W,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hbgvd(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab,
+        BB, ldbb,
+        W,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hbgvd< float >;
+template class hbgvd< double >;
+template class hbgvd< std::complex<float> >;
+template class hbgvd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
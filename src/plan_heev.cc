@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for heev (or syev), querying and allocating its workspace.
+/// See lapack::heev for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+heev< scalar_t >::heev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::heev_work_size_bytes(
+        jobz, uplo, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::heev.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t heev< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* W )
+{
+    return lapack::heev(
+        jobz_, uplo_, n_,
+        A, lda,
+        W,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class heev< float >;
+template class heev< double >;
+template class heev< std::complex<float> >;
+template class heev< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for heevd_2stage (or syevd_2stage), querying and
+/// allocating its workspace.
+/// See lapack::heevd_2stage for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+heevd_2stage< scalar_t >::heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::heevd_2stage_work_size_bytes(
+        jobz, uplo, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::heevd_2stage.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t heevd_2stage< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* W )
+{
+    return lapack::heevd_2stage(
+        jobz_, uplo_, n_,
+        A, lda,
+        W,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class heevd_2stage< float >;
+template class heevd_2stage< double >;
+template class heevd_2stage< std::complex<float> >;
+template class heevd_2stage< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for heevx (or syevx), querying and allocating its workspace.
+/// See lapack::heevx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+heevx< scalar_t >::heevx(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n )
+    : jobz_( jobz ),
+      range_( range ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::heevx_work_size_bytes(
+        jobz, range, uplo, n,
+        (scalar_t*) nullptr, lda, real_t( 0 ), real_t( 1 ), 1, n, real_t( 0 ),
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::heevx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t heevx< scalar_t >::execute(
+    scalar_t* A, int64_t lda, real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* nfound,
+    real_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    return lapack::heevx(
+        jobz_, range_, uplo_, n_,
+        A, lda, vl, vu, il, iu, abstol, nfound,
+        W,
+        Z, ldz,
+        ifail,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class heevx< float >;
+template class heevx< double >;
+template class heevx< std::complex<float> >;
+template class heevx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
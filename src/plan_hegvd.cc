@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hegvd (or sygvd), querying and allocating its workspace.
+/// See lapack::hegvd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hegvd< scalar_t >::hegvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n )
+    : itype_( itype ),
+      jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    size_t work_size;
+    lapack::hegvd_work_size_bytes(
+        itype, jobz, uplo, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (real_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes generalized eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::hegvd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hegvd< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    real_t* W )
+{
+    return lapack::hegvd(
+        itype_, jobz_, uplo_, n_,
+        A, lda,
+        B, ldb,
+        W,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hegvd< float >;
+template class hegvd< double >;
+template class hegvd< std::complex<float> >;
+template class hegvd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hegvx (or sygvx), querying and allocating its workspace.
+/// See lapack::hegvx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hegvx< scalar_t >::hegvx(
+    int64_t itype, lapack::Job jobz, lapack::Range range, lapack::Uplo uplo,
+    int64_t n )
+    : itype_( itype ),
+      jobz_( jobz ),
+      range_( range ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hegvx_work_size_bytes(
+        itype, jobz, range, uplo, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb, real_t( 0 ), real_t( 1 ), 1, n, real_t( 0 ),
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected generalized eigenvalues and, optionally, eigenvectors,
+/// using the plan's workspace; see lapack::hegvx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hegvx< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* m,
+    real_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    return lapack::hegvx(
+        itype_, jobz_, range_, uplo_, n_,
+        A, lda,
+        B, ldb, vl, vu, il, iu, abstol, m,
+        W,
+        Z, ldz,
+        ifail,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hegvx< float >;
+template class hegvx< double >;
+template class hegvx< std::complex<float> >;
+template class hegvx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
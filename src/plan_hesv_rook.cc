@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30500  // >= 3.5
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hesv_rook, querying and allocating its workspace.
+/// See lapack::hesv_rook for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hesv_rook< scalar_t >::hesv_rook(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs )
+    : uplo_( uplo ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    size_t work_size;
+    lapack::hesv_rook_work_size_bytes(
+        uplo, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves a Hermitian indefinite system with rook pivoting,
+/// using the plan's workspace; see lapack::hesv_rook.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hesv_rook< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb )
+{
+    return lapack::hesv_rook(
+        uplo_, n_, nrhs_,
+        A, lda,
+        ipiv,
+        B, ldb,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hesv_rook< float >;
+template class hesv_rook< double >;
+template class hesv_rook< std::complex<float> >;
+template class hesv_rook< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.5
@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hetrd (or sytrd), querying and allocating its workspace.
+/// See lapack::hetrd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hetrd< scalar_t >::hetrd(
+    lapack::Uplo uplo, int64_t n )
+    : uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::hetrd_work_size_bytes(
+        uplo, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a Hermitian matrix to tridiagonal form
+/// using the plan's workspace; see lapack::hetrd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hetrd< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* D,
+    real_t* E,
+    scalar_t* tau )
+{
+    return lapack::hetrd(
+        uplo_, n_,
+        A, lda,
+        D,
+        E,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hetrd< float >;
+template class hetrd< double >;
+template class hetrd< std::complex<float> >;
+template class hetrd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= v3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hetrd_2stage (or sytrd_2stage), querying and
+/// allocating its workspace.
+/// See lapack::hetrd_2stage for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hetrd_2stage< scalar_t >::hetrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t lhous2 )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n ),
+      lhous2_( lhous2 )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::hetrd_2stage_work_size_bytes(
+        jobz, uplo, n,
+        (scalar_t*) nullptr, lda,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, lhous2,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a Hermitian matrix to tridiagonal form in two stages
+/// using the plan's workspace; see lapack::hetrd_2stage.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hetrd_2stage< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    real_t* D,
+    real_t* E,
+    scalar_t* tau,
+    scalar_t* hous2 )
+{
+    return lapack::hetrd_2stage(
+        jobz_, uplo_, n_,
+        A, lda,
+        D,
+        E,
+        tau,
+        hous2, lhous2_,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hetrd_2stage< float >;
+template class hetrd_2stage< double >;
+template class hetrd_2stage< std::complex<float> >;
+template class hetrd_2stage< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= v3.7
@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hetrf_aa, querying and allocating its workspace.
+/// See lapack::hetrf_aa for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hetrf_aa< scalar_t >::hetrf_aa(
+    lapack::Uplo uplo, int64_t n )
+    : uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::hetrf_aa_work_size_bytes(
+        uplo, n,
+        (scalar_t*) nullptr, lda,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the Aasen factorization
+/// using the plan's workspace; see lapack::hetrf_aa.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hetrf_aa< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv )
+{
+    return lapack::hetrf_aa(
+        uplo_, n_,
+        A, lda,
+        ipiv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hetrf_aa< float >;
+template class hetrf_aa< double >;
+template class hetrf_aa< std::complex<float> >;
+template class hetrf_aa< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
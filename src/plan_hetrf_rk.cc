@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hetrf_rk, querying and allocating its workspace.
+/// See lapack::hetrf_rk for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hetrf_rk< scalar_t >::hetrf_rk(
+    lapack::Uplo uplo, int64_t n )
+    : uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::hetrf_rk_work_size_bytes(
+        uplo, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the bounded Bunch-Kaufman factorization
+/// using the plan's workspace; see lapack::hetrf_rk.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hetrf_rk< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv )
+{
+    return lapack::hetrf_rk(
+        uplo_, n_,
+        A, lda,
+        E,
+        ipiv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hetrf_rk< float >;
+template class hetrf_rk< double >;
+template class hetrf_rk< std::complex<float> >;
+template class hetrf_rk< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
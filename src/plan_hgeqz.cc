@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hgeqz, querying and allocating its workspace.
+/// See lapack::hgeqz for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hgeqz< scalar_t >::hgeqz(
+    lapack::JobSchur jobschur, lapack::Job compq, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi )
+    : jobschur_( jobschur ),
+      compq_( compq ),
+      compz_( compz ),
+      n_( n ),
+      ilo_( ilo ),
+      ihi_( ihi )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldh = max( 1, n );
+    int64_t ldt = max( 1, n );
+    int64_t ldq = max( 1, n );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hgeqz_work_size_bytes(
+        jobschur, compq, compz, n, ilo, ihi,
+        (scalar_t*) nullptr, ldh,
+        (scalar_t*) nullptr, ldt,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldq,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the generalized Schur form of a Hessenberg-triangular pair
+/// using the plan's workspace; see lapack::hgeqz.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hgeqz< scalar_t >::execute(
+    scalar_t* H, int64_t ldh,
+    scalar_t* T, int64_t ldt,
+    blas::complex_type<scalar_t>* alpha,
+    scalar_t* beta,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hgeqz(
+        jobschur_, compq_, compz_, n_, ilo_, ihi_,
+        H, ldh,
+        T, ldt,
+        alpha,
+        beta,
+        Q, ldq,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hgeqz< float >;
+template class hgeqz< double >;
+template class hgeqz< std::complex<float> >;
+template class hgeqz< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hpevd (or spevd), querying and allocating its workspace.
+/// See lapack::hpevd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hpevd< scalar_t >::hpevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n )
+    : jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hpevd_work_size_bytes(
+        jobz, uplo, n,
+        (scalar_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes packed eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::hpevd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hpevd< scalar_t >::execute(
+    scalar_t* AP,
+    real_t* W,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hpevd(
+        jobz_, uplo_, n_,
+        AP,
+        W,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hpevd< float >;
+template class hpevd< double >;
+template class hpevd< std::complex<float> >;
+template class hpevd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
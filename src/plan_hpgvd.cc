@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hpgvd (or spgvd), querying and allocating its workspace.
+/// See lapack::hpgvd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hpgvd< scalar_t >::hpgvd(
+    int64_t itype, lapack::Job jobz, lapack::Uplo uplo, int64_t n )
+    : itype_( itype ),
+      jobz_( jobz ),
+      uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hpgvd_work_size_bytes(
+        itype, jobz, uplo, n,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes generalized packed eigenvalues and, optionally, eigenvectors,
+/// using the plan's workspace; see lapack::hpgvd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hpgvd< scalar_t >::execute(
+    scalar_t* AP,
+    scalar_t* BP,
+    real_t* W,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hpgvd(
+        itype_, jobz_, uplo_, n_,
+        AP,
+        BP,
+        W,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hpgvd< float >;
+template class hpgvd< double >;
+template class hpgvd< std::complex<float> >;
+template class hpgvd< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
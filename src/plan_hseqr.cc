@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for hseqr, querying and allocating its workspace.
+/// See lapack::hseqr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+hseqr< scalar_t >::hseqr(
+    lapack::JobSchur jobschur, lapack::Job compz,
+    int64_t n, int64_t ilo, int64_t ihi )
+    : jobschur_( jobschur ),
+      compz_( compz ),
+      n_( n ),
+      ilo_( ilo ),
+      ihi_( ihi )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldh = max( 1, n );
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::hseqr_work_size_bytes(
+        jobschur, compz, n, ilo, ihi,
+        (scalar_t*) nullptr, ldh,
+        (blas::complex_type<scalar_t>*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvalues and, optionally, the Schur form of a Hessenberg matrix
+/// using the plan's workspace; see lapack::hseqr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t hseqr< scalar_t >::execute(
+    scalar_t* H, int64_t ldh,
+    blas::complex_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::hseqr(
+        jobschur_, compz_, n_, ilo_, ihi_,
+        H, ldh,
+        W,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class hseqr< float >;
+template class hseqr< double >;
+template class hseqr< std::complex<float> >;
+template class hseqr< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30500  // >= 3.5
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for orcsd2by1, querying and allocating its workspace.
+/// See lapack::orcsd2by1 for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+orcsd2by1< scalar_t >::orcsd2by1(
+    lapack::Job jobu1, lapack::Job jobu2, lapack::Job jobv1t, int64_t m,
+    int64_t p, int64_t q )
+    : jobu1_( jobu1 ),
+      jobu2_( jobu2 ),
+      jobv1t_( jobv1t ),
+      m_( m ),
+      p_( p ),
+      q_( q )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldx11 = max( 1, p );
+    int64_t ldx21 = max( 1, m-p );
+    int64_t ldu1 = max( 1, p );
+    int64_t ldu2 = max( 1, m-p );
+    int64_t ldv1t = max( 1, q );
+    size_t work_size;
+    lapack::orcsd2by1_work_size_bytes(
+        jobu1, jobu2, jobv1t, m, p, q,
+        (scalar_t*) nullptr, ldx11,
+        (scalar_t*) nullptr, ldx21,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldu1,
+        (scalar_t*) nullptr, ldu2,
+        (scalar_t*) nullptr, ldv1t,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the CS decomposition of a 2-by-1 block orthogonal matrix
+/// using the plan's workspace; see lapack::orcsd2by1.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t orcsd2by1< scalar_t >::execute(
+    scalar_t* X11, int64_t ldx11,
+    scalar_t* X21, int64_t ldx21,
+    scalar_t* theta,
+    scalar_t* U1, int64_t ldu1,
+    scalar_t* U2, int64_t ldu2,
+    scalar_t* V1T, int64_t ldv1t )
+{
+    return lapack::orcsd2by1(
+        jobu1_, jobu2_, jobv1t_, m_, p_, q_,
+        X11, ldx11,
+        X21, ldx21,
+        theta,
+        U1, ldu1,
+        U2, ldu2,
+        V1T, ldv1t,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class orcsd2by1< float >;
+template class orcsd2by1< double >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.5.0
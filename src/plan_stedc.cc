@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for stedc, querying and allocating its workspace.
+/// See lapack::stedc for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+stedc< scalar_t >::stedc(
+    lapack::Job compz, int64_t n )
+    : compz_( compz ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::stedc_work_size_bytes(
+        compz, n,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes tridiagonal eigenvalues and vectors by divide and conquer
+/// using the plan's workspace; see lapack::stedc.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t stedc< scalar_t >::execute(
+    real_t* D,
+    real_t* E,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::stedc(
+        compz_, n_,
+        D,
+        E,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class stedc< float >;
+template class stedc< double >;
+template class stedc< std::complex<float> >;
+template class stedc< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for stegr, querying and allocating its workspace.
+/// See lapack::stegr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+stegr< scalar_t >::stegr(
+    lapack::Job jobz, lapack::Range range, int64_t n )
+    : jobz_( jobz ),
+      range_( range ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::stegr_work_size_bytes(
+        jobz, range, n,
+        (real_t*) nullptr,
+        (real_t*) nullptr, real_t( 0 ), real_t( 1 ), 1, n, real_t( 0 ),
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected tridiagonal eigenvalues and vectors by MRRR
+/// using the plan's workspace; see lapack::stegr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t stegr< scalar_t >::execute(
+    real_t* D,
+    real_t* E, real_t vl, real_t vu, int64_t il, int64_t iu, real_t abstol,
+    int64_t* m,
+    real_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz )
+{
+    return lapack::stegr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il, iu, abstol, m,
+        W,
+        Z, ldz,
+        isuppz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class stegr< float >;
+template class stegr< double >;
+template class stegr< std::complex<float> >;
+template class stegr< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
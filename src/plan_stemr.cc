@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for stemr, querying and allocating its workspace.
+/// See lapack::stemr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+stemr< scalar_t >::stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n )
+    : jobz_( jobz ),
+      range_( range ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::stemr_work_size_bytes(
+        jobz, range, n,
+        (real_t*) nullptr,
+        (real_t*) nullptr, real_t( 0 ), real_t( 1 ), 1, n,
+        (real_t*) nullptr,
+        (scalar_t*) nullptr, ldz, n,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected tridiagonal eigenvalues and vectors by MRRR
+/// using the plan's workspace; see lapack::stemr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t stemr< scalar_t >::execute(
+    real_t* D,
+    real_t* E, real_t vl, real_t vu, int64_t il, int64_t iu,
+    int64_t* m,
+    real_t* W,
+    scalar_t* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac )
+{
+    return lapack::stemr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il, iu, m,
+        W,
+        Z, ldz, nzc,
+        isuppz, tryrac,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class stemr< float >;
+template class stemr< double >;
+template class stemr< std::complex<float> >;
+template class stemr< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
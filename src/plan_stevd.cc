@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for stevd, querying and allocating its workspace.
+/// See lapack::stevd for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+stevd< scalar_t >::stevd(
+    lapack::Job jobz, int64_t n )
+    : jobz_( jobz ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::stevd_work_size_bytes(
+        jobz, n,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes tridiagonal eigenvalues and, optionally, eigenvectors
+/// using the plan's workspace; see lapack::stevd.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t stevd< scalar_t >::execute(
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz )
+{
+    return lapack::stevd(
+        jobz_, n_,
+        D,
+        E,
+        Z, ldz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class stevd< float >;
+template class stevd< double >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for stevr, querying and allocating its workspace.
+/// See lapack::stevr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+stevr< scalar_t >::stevr(
+    lapack::Job jobz, lapack::Range range, int64_t n )
+    : jobz_( jobz ),
+      range_( range ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldz = max( 1, n );
+    size_t work_size;
+    lapack::stevr_work_size_bytes(
+        jobz, range, n,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, real_t( 0 ), real_t( 1 ), 1, n, real_t( 0 ),
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldz,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected tridiagonal eigenvalues and vectors by MRRR
+/// using the plan's workspace; see lapack::stevr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t stevr< scalar_t >::execute(
+    scalar_t* D,
+    scalar_t* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* m,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* isuppz )
+{
+    return lapack::stevr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il, iu, abstol, m,
+        W,
+        Z, ldz,
+        isuppz,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class stevr< float >;
+template class stevr< double >;
+
+}  // namespace plan
+}  // namespace lapack
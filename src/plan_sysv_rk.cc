@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for sysv_rk, querying and allocating its workspace.
+/// See lapack::sysv_rk for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+sysv_rk< scalar_t >::sysv_rk(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs )
+    : uplo_( uplo ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldb = max( 1, n );
+    size_t work_size;
+    lapack::sysv_rk_work_size_bytes(
+        uplo, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldb,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves a symmetric indefinite system with bounded Bunch-Kaufman pivoting,
+/// using the plan's workspace; see lapack::sysv_rk.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t sysv_rk< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t* E,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb )
+{
+    return lapack::sysv_rk(
+        uplo_, n_, nrhs_,
+        A, lda,
+        E,
+        ipiv,
+        B, ldb,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class sysv_rk< float >;
+template class sysv_rk< double >;
+template class sysv_rk< std::complex<float> >;
+template class sysv_rk< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
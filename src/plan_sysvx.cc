@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for sysvx, querying and allocating its workspace.
+/// See lapack::sysvx for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+sysvx< scalar_t >::sysvx(
+    lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs )
+    : fact_( fact ),
+      uplo_( uplo ),
+      n_( n ),
+      nrhs_( nrhs )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    int64_t ldaf = max( 1, n );
+    int64_t ldb = max( 1, n );
+    int64_t ldx = max( 1, n );
+    size_t work_size;
+    lapack::sysvx_work_size_bytes(
+        fact, uplo, n, nrhs,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldaf,
+        (scalar_t*) nullptr, ldb,
+        (scalar_t*) nullptr, ldx,
+        (real_t*) nullptr,
+        (real_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves a symmetric indefinite system, with error bounds,
+/// using the plan's workspace; see lapack::sysvx.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t sysvx< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    real_t* rcond,
+    real_t* ferr,
+    real_t* berr )
+{
+    return lapack::sysvx(
+        fact_, uplo_, n_, nrhs_,
+        A, lda,
+        AF, ldaf,
+        ipiv,
+        B, ldb,
+        X, ldx, rcond,
+        ferr,
+        berr,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class sysvx< float >;
+template class sysvx< double >;
+template class sysvx< std::complex<float> >;
+template class sysvx< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,61 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for sytrf, querying and allocating its workspace.
+/// See lapack::sytrf for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+sytrf< scalar_t >::sytrf(
+    lapack::Uplo uplo, int64_t n )
+    : uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::sytrf_work_size_bytes(
+        uplo, n,
+        (scalar_t*) nullptr, lda,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the Bunch-Kaufman factorization using the plan's workspace;
+/// see lapack::sytrf.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t sytrf< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv )
+{
+    return lapack::sytrf(
+        uplo_, n_,
+        A, lda,
+        ipiv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class sytrf< float >;
+template class sytrf< double >;
+template class sytrf< std::complex<float> >;
+template class sytrf< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30700  // >= 3.7
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for sytri_rk, querying and allocating its workspace.
+/// See lapack::sytri_rk for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+sytri_rk< scalar_t >::sytri_rk(
+    lapack::Uplo uplo, int64_t n )
+    : uplo_( uplo ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, n );
+    size_t work_size;
+    lapack::sytri_rk_work_size_bytes(
+        uplo, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the inverse from the bounded Bunch-Kaufman factorization
+/// using the plan's workspace; see lapack::sytri_rk.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t sytri_rk< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t const* E,
+    int64_t const* ipiv )
+{
+    return lapack::sytri_rk(
+        uplo_, n_,
+        A, lda,
+        E,
+        ipiv,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class sytri_rk< float >;
+template class sytri_rk< double >;
+template class sytri_rk< std::complex<float> >;
+template class sytri_rk< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.7
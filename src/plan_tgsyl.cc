@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for tgsyl, querying and allocating its workspace.
+/// See lapack::tgsyl for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+tgsyl< scalar_t >::tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n )
+    : trans_( trans ),
+      ijob_( ijob ),
+      m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    int64_t ldb = max( 1, n );
+    int64_t ldc = max( 1, m );
+    int64_t ldd = max( 1, m );
+    int64_t lde = max( 1, n );
+    int64_t ldf = max( 1, m );
+    size_t work_size;
+    lapack::tgsyl_work_size_bytes(
+        trans, ijob, m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr, ldb,
+        (scalar_t*) nullptr, ldc,
+        (scalar_t*) nullptr, ldd,
+        (scalar_t*) nullptr, lde,
+        (scalar_t*) nullptr, ldf,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Solves the generalized Sylvester equation
+/// using the plan's workspace; see lapack::tgsyl.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t tgsyl< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* C, int64_t ldc,
+    scalar_t const* D, int64_t ldd,
+    scalar_t const* E, int64_t lde,
+    scalar_t* F, int64_t ldf,
+    real_t* dif,
+    real_t* scale )
+{
+    return lapack::tgsyl(
+        trans_, ijob_, m_, n_,
+        A, lda,
+        B, ldb,
+        C, ldc,
+        D, ldd,
+        E, lde,
+        F, ldf, dif, scale,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class tgsyl< float >;
+template class tgsyl< double >;
+template class tgsyl< std::complex<float> >;
+template class tgsyl< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
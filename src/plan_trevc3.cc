@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#if LAPACK_VERSION >= 30601  // >= 3.6.1
+#ifndef BLAS_HAVE_MKL  // MKL 2018 lacks trevc3
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for trevc3, querying and allocating its workspace.
+/// See lapack::trevc3 for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+trevc3< scalar_t >::trevc3(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n, int64_t mm )
+    : sides_( sides ),
+      howmany_( howmany ),
+      n_( n ),
+      mm_( mm )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldt = max( 1, n );
+    int64_t ldvl = max( 1, n );
+    int64_t ldvr = max( 1, n );
+    size_t work_size;
+    lapack::trevc3_work_size_bytes(
+        sides, howmany, n,
+        (scalar_t*) nullptr, ldt,
+        (scalar_t*) nullptr, ldvl,
+        (scalar_t*) nullptr, ldvr, mm,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvectors of a triangular matrix
+/// using the plan's workspace; see lapack::trevc3.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t trevc3< scalar_t >::execute(
+    bool* select,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr,
+    int64_t* m )
+{
+    return lapack::trevc3(
+        sides_, howmany_,
+        select, n_,
+        T, ldt,
+        VL, ldvl,
+        VR, ldvr, mm_, m,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class trevc3< float >;
+template class trevc3< double >;
+template class trevc3< std::complex<float> >;
+template class trevc3< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
+
+#endif  // not HAVE_MKL
+#endif  // LAPACK >= 3.6.1
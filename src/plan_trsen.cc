@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+#include <memory>
+#include <vector>
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for trsen, querying and allocating its workspace.
+/// See lapack::trsen for a description of the arguments.
+///
+/// The workspace depends on the number m of selected eigenvalues, which
+/// isn't known until execute, so the plan allocates for the most,
+/// m = n/2. The query needs T for that: real trsen counts 2-by-2 blocks
+/// in T, so it uses a temporary zero T, which has none.
+///
+/// @ingroup plan
+template <typename scalar_t>
+trsen< scalar_t >::trsen(
+    lapack::Sense sense, lapack::Job compq, int64_t n )
+    : sense_( sense ),
+      compq_( compq ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t ldt = max( 1, n );
+    int64_t ldq = max( 1, n );
+    std::vector< scalar_t > T( ldt*n );
+    std::unique_ptr< bool[] > select( new bool[ max( 1, n ) ] );
+    for (int64_t i = 0; i < n; ++i)
+        select[ i ] = (i < n/2);
+    size_t work_size;
+    lapack::trsen_work_size_bytes(
+        sense, compq,
+        select.get(), n,
+        T.data(), ldt,
+        (scalar_t*) nullptr, ldq,
+        (blas::complex_type<scalar_t>*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Reorders the Schur factorization, with condition numbers,
+/// using the plan's workspace; see lapack::trsen.
+/// Arrays must match the options and dimensions the plan was created for;
+/// select may choose any eigenvalues.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t trsen< scalar_t >::execute(
+    bool const* select,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    blas::complex_type<scalar_t>* W,
+    int64_t* m,
+    real_t* s,
+    real_t* sep )
+{
+    return lapack::trsen(
+        sense_, compq_,
+        select, n_,
+        T, ldt,
+        Q, ldq,
+        W,
+        m,
+        s,
+        sep,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class trsen< float >;
+template class trsen< double >;
+template class trsen< std::complex<float> >;
+template class trsen< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
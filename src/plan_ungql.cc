@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for ungql (or orgql), querying and allocating its workspace.
+/// See lapack::ungql for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+ungql< scalar_t >::ungql(
+    int64_t m, int64_t n, int64_t k )
+    : m_( m ),
+      n_( n ),
+      k_( k )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m );
+    size_t work_size;
+    lapack::ungql_work_size_bytes(
+        m, n, k,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Generates the matrix Q of a QL factorization
+/// using the plan's workspace; see lapack::ungql.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t ungql< scalar_t >::execute(
+    scalar_t* A, int64_t lda,
+    scalar_t const* tau )
+{
+    return lapack::ungql(
+        m_, n_, k_,
+        A, lda,
+        tau,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class ungql< float >;
+template class ungql< double >;
+template class ungql< std::complex<float> >;
+template class ungql< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for unmqr (or ormqr), querying and allocating its workspace.
+/// See lapack::unmqr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+unmqr< scalar_t >::unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k )
+    : side_( side ),
+      trans_( trans ),
+      m_( m ),
+      n_( n ),
+      k_( k )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m, n );
+    int64_t ldc = max( 1, m );
+    size_t work_size;
+    lapack::unmqr_work_size_bytes(
+        side, trans, m, n, k,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldc,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies by the matrix Q of a QR factorization
+/// using the plan's workspace; see lapack::unmqr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t unmqr< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc )
+{
+    return lapack::unmqr(
+        side_, trans_, m_, n_, k_,
+        A, lda,
+        tau,
+        C, ldc,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class unmqr< float >;
+template class unmqr< double >;
+template class unmqr< std::complex<float> >;
+template class unmqr< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
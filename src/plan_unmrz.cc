@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for unmrz (or ormrz), querying and allocating its workspace.
+/// See lapack::unmrz for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+unmrz< scalar_t >::unmrz(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l )
+    : side_( side ),
+      trans_( trans ),
+      m_( m ),
+      n_( n ),
+      k_( k ),
+      l_( l )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, k );
+    int64_t ldc = max( 1, m );
+    size_t work_size;
+    lapack::unmrz_work_size_bytes(
+        side, trans, m, n, k, l,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldc,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies by the matrix Z from tzrzf
+/// using the plan's workspace; see lapack::unmrz.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t unmrz< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc )
+{
+    return lapack::unmrz(
+        side_, trans_, m_, n_, k_, l_,
+        A, lda,
+        tau,
+        C, ldc,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class unmrz< float >;
+template class unmrz< double >;
+template class unmrz< std::complex<float> >;
+template class unmrz< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
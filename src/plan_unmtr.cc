@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Creates a plan for unmtr (or ormtr), querying and allocating its workspace.
+/// See lapack::unmtr for a description of the arguments.
+///
+/// @ingroup plan
+template <typename scalar_t>
+unmtr< scalar_t >::unmtr(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, int64_t m,
+    int64_t n )
+    : side_( side ),
+      uplo_( uplo ),
+      trans_( trans ),
+      m_( m ),
+      n_( n )
+{
+    // smallest valid leading dimensions for the query
+    int64_t lda = max( 1, m, n );
+    int64_t ldc = max( 1, m );
+    size_t work_size;
+    lapack::unmtr_work_size_bytes(
+        side, uplo, trans, m, n,
+        (scalar_t*) nullptr, lda,
+        (scalar_t*) nullptr,
+        (scalar_t*) nullptr, ldc,
+        &work_size );
+    work_.resize( work_size );
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies by the matrix Q from hetrd
+/// using the plan's workspace; see lapack::unmtr.
+/// Arrays must match the options and dimensions the plan was created for.
+///
+/// @ingroup plan
+template <typename scalar_t>
+int64_t unmtr< scalar_t >::execute(
+    scalar_t const* A, int64_t lda,
+    scalar_t const* tau,
+    scalar_t* C, int64_t ldc )
+{
+    return lapack::unmtr(
+        side_, uplo_, trans_, m_, n_,
+        A, lda,
+        tau,
+        C, ldc,
+        work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class unmtr< float >;
+template class unmtr< double >;
+template class unmtr< std::complex<float> >;
+template class unmtr< std::complex<double> >;
+
+}  // namespace plan
+}  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,14 +28,19 @@ int64_t pocon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pocon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_spocon(
         &uplo_, &n_,
@@ -63,14 +69,19 @@ int64_t pocon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pocon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dpocon(
         &uplo_, &n_,
@@ -99,14 +110,19 @@ int64_t pocon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pocon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cpocon(
         &uplo_, &n_,
@@ -170,14 +186,19 @@ int64_t pocon(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pocon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zpocon(
         &uplo_, &n_,
@@ -194,4 +215,220 @@ int64_t pocon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_pocon(
+    char uplo, lapack_int n,
+    float const* A, lapack_int lda, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_spocon(
+        &uplo, &n,
+        A, &lda, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pocon(
+    char uplo, lapack_int n,
+    double const* A, lapack_int lda, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dpocon(
+        &uplo, &n,
+        A, &lda, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pocon(
+    char uplo, lapack_int n,
+    std::complex<float> const* A, lapack_int lda, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cpocon(
+        &uplo, &n,
+        (lapack_complex_float const*) A, &lda, &anorm, rcond,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pocon(
+    char uplo, lapack_int n,
+    std::complex<double> const* A, lapack_int lda, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zpocon(
+        &uplo, &n,
+        (lapack_complex_double const*) A, &lda, &anorm, rcond,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by pocon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::pocon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::pocon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     pocon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "pocon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_pocon(
+        uplo_, n_,
+        A, lda_, anorm, rcond,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda, float anorm,
+    size_t* work_size );
+
+template
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda, double anorm,
+    size_t* work_size );
+
+template
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda, float anorm,
+    size_t* work_size );
+
+template
+void pocon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    float const* A, int64_t lda, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    double const* A, int64_t lda, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* A, int64_t lda, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t pocon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* A, int64_t lda, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +31,11 @@ int64_t posv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 's', -1, n, nrhs,
+        [&]() { return Gflop< float >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -64,6 +71,11 @@ int64_t posv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -99,6 +111,11 @@ int64_t posv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 'c', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<float> >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -193,6 +210,11 @@ int64_t posv(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -230,6 +252,11 @@ int64_t posv(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 'd', -1, n, nrhs,
+        [&]() { return Gflop< double >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -240,8 +267,8 @@ int64_t posv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n)*(nrhs) );
-    lapack::vector< float > swork( (n*(n+nrhs)) );
+    lapack::small_vector< double > work( (n)*(nrhs) );
+    lapack::small_vector< float > swork( (n*(n+nrhs)) );
 
     LAPACK_dsposv(
         &uplo_, &n_, &nrhs_,
@@ -277,6 +304,11 @@ int64_t posv(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "posv", 'z', -1, n, nrhs,
+        [&]() { return Gflop< std::complex<double> >::posv( n, nrhs ); } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -287,9 +319,9 @@ int64_t posv(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n)*(nrhs) );
-    lapack::vector< std::complex<float> > swork( (n*(n+nrhs)) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (n)*(nrhs) );
+    lapack::small_vector< std::complex<float> > swork( (n*(n+nrhs)) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zcposv(
         &uplo_, &n_, &nrhs_,
@@ -310,4 +342,194 @@ int64_t posv(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Only double and complex<double>, which factor in single precision
+// (swork); real precision doesn't reference rwork.
+static void fortran_posv(
+    char uplo, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    double* work, float* swork, double* rwork,
+    lapack_int* iter, lapack_int* info )
+{
+    LAPACK_dsposv(
+        &uplo, &n, &nrhs,
+        A, &lda,
+        B, &ldb,
+        X, &ldx,
+        work,
+        swork, iter, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_posv(
+    char uplo, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    std::complex<double>* work, std::complex<float>* swork, double* rwork,
+    lapack_int* iter, lapack_int* info )
+{
+    LAPACK_zcposv(
+        &uplo, &n, &nrhs,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) X, &ldx,
+        (lapack_complex_double*) work,
+        (lapack_complex_float*) swork,
+        rwork, iter, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by mixed-precision posv
+/// with caller-provided workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void posv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    using single_t = typename std::conditional<
+        is_complex, std::complex<float>, float >::type;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n*nrhs );
+    buffer.take< single_t >( n*(n+nrhs) );
+    buffer.take< real_t >( is_complex ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::posv, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::posv for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     posv_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    using single_t = typename std::conditional<
+        is_complex, std::complex<float>, float >::type;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "posv", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return Gflop< scalar_t >::posv( n, nrhs ); } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n*nrhs );
+    single_t* swork_ = buffer.take< single_t >( n*(n+nrhs) );
+    real_t* rwork_ = buffer.take< real_t >( is_complex ? n : 0 );
+
+    fortran_posv(
+        uplo_, n_, nrhs_,
+        A, lda_,
+        B, ldb_,
+        X, ldx_,
+        work_, swork_, rwork_, &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *iter = iter_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void posv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    size_t* work_size );
+
+template
+void posv_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
+template
+int64_t posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices, pointer-array variant. See lapack::potrf.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored;
+///     1 or batch entries.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in,out] Aarray
+///     Pointers to the batch matrices $A_i$, each stored in an
+///     lda_i-by-n_i array. On exit, the Cholesky factors.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::potrf for $A_i$: 0 for success, or k > 0 if the leading
+///     minor of order k of $A_i$ is not positive definite.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( uplo, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "potrf_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), -1,
+        [&]() {
+            double gflop = 0;
+            for (size_t i = 0; i < batch; ++i)
+                gflop += Gflop< scalar_t >::potrf( extract( n, i ) );
+            return gflop;
+        } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::potrf(
+            extract( uplo, i ), extract( n, i ),
+            Aarray[ i ], extract( lda, i ) );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices, grouped variant. Problems in group g share
+/// uplo[ g ], n[ g ], and lda[ g ]. See lapack::potrf.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle is stored, per group.
+///
+/// @param[in] n
+///     Order of the matrices, per group.
+///
+/// @param[in,out] Aarray
+///     Pointers to the sum( group_size ) matrices, numbered
+///     consecutively across groups. On exit, the Cholesky factors.
+///
+/// @param[in] lda
+///     Leading dimension, per group; lda[ g ] >= max(1, n[ g ]).
+///
+/// @param[in] group_size
+///     Number of matrices in each group.
+///
+/// @param[out] info
+///     Resized to sum( group_size ) entries, as in the
+///     pointer-array variant.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info )
+{
+    internal::batch::Groups groups( group_size );
+    internal::batch::check_group_size( uplo, groups );
+    internal::batch::check_group_size( n, groups );
+    internal::batch::check_group_size( lda, groups );
+    internal::batch::check_array_size( Aarray, groups.batch() );
+    for (size_t g = 0; g < groups.count(); ++g) {
+        lapack_error_if( n[ g ] < 0 );
+        lapack_error_if( lda[ g ] < max( 1, n[ g ] ) );
+    }
+
+    trace::internal::Block trace_block(
+        "potrf_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), -1,
+        [&]() {
+            double gflop = 0;
+            for (size_t g = 0; g < groups.count(); ++g)
+                gflop += group_size[ g ] * Gflop< scalar_t >::potrf( n[ g ] );
+            return gflop;
+        } );
+
+    info.resize( groups.batch() );
+    internal::parallel_for( groups.batch(), [&]( int64_t i, int worker ) {
+        size_t g = groups.group( i );
+        info[ i ] = lapack::potrf( uplo[ g ], n[ g ], Aarray[ i ], lda[ g ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices, strided variant. See lapack::potrf.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ is stored.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in,out] A
+///     The batch matrices, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA. On exit, the Cholesky factors.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[in] batch
+///     Number of matrices.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+
+    trace::internal::Block trace_block(
+        "potrf_batch", trace::internal::precision< scalar_t >(), -1, n, -1,
+        [&]() { return batch * Gflop< scalar_t >::potrf( n ); } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::potrf( uplo, n, &A[ i*strideA ], lda );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
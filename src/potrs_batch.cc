@@ -0,0 +1,355 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "batch_common.hh"
+#include "ThreadPool.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems $A_i X_i = B_i$, using the Cholesky factors
+/// computed by potrf_batch, pointer-array variant. See lapack::potrs.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ holds the factor;
+///     1 or batch entries.
+///
+/// @param[in] n
+///     Order of each $A_i$; 1 or batch entries.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$; 1 or batch entries.
+///
+/// @param[in] Aarray
+///     Pointers to the batch Cholesky factors, each stored in an
+///     lda_i-by-n_i array.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in,out] Barray
+///     Pointers to the batch right-hand sides $B_i$, each stored in an
+///     ldb_i-by-nrhs_i array. On exit, the solutions $X_i$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb_i >= max(1, n_i).
+///     1 or batch entries.
+///
+/// @param[in] batch
+///     Number of systems.
+///
+/// @param[out] info
+///     Resized to batch entries. info[ i ] is the return value of
+///     lapack::potrs for system i, which is 0.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info )
+{
+    using internal::batch::extract;
+
+    internal::batch::check_arg_size( uplo, batch );
+    internal::batch::check_arg_size( n, batch );
+    internal::batch::check_arg_size( nrhs, batch );
+    internal::batch::check_arg_size( lda, batch );
+    internal::batch::check_arg_size( ldb, batch );
+    internal::batch::check_array_size( Aarray, batch );
+    internal::batch::check_array_size( Barray, batch );
+    for (size_t i = 0; i < batch; ++i) {
+        int64_t n_i = extract( n, i );
+        lapack_error_if( n_i < 0 );
+        lapack_error_if( extract( nrhs, i ) < 0 );
+        lapack_error_if( extract( lda, i ) < max( 1, n_i ) );
+        lapack_error_if( extract( ldb, i ) < max( 1, n_i ) );
+    }
+
+    trace::internal::Block trace_block(
+        "potrs_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), internal::batch::trace_dim( nrhs ),
+        [&]() {
+            double gflop = 0;
+            for (size_t i = 0; i < batch; ++i)
+                gflop += Gflop< scalar_t >::potrs(
+                    extract( n, i ),
+                    extract( nrhs, i ) );
+            return gflop;
+        } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::potrs(
+            extract( uplo, i ), extract( n, i ), extract( nrhs, i ),
+            Aarray[ i ], extract( lda, i ),
+            Barray[ i ], extract( ldb, i ) );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems $A_i X_i = B_i$, using the Cholesky factors
+/// computed by potrf_batch, grouped variant. Problems in group g share
+/// uplo[ g ], n[ g ], nrhs[ g ], lda[ g ], and ldb[ g ].
+/// See lapack::potrs.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle holds the factor, per group.
+///
+/// @param[in] n
+///     Order of the matrices, per group.
+///
+/// @param[in] nrhs
+///     Number of right-hand sides, per group.
+///
+/// @param[in] Aarray
+///     Pointers to the sum( group_size ) Cholesky factors, numbered
+///     consecutively across groups.
+///
+/// @param[in] lda
+///     Leading dimension of A, per group; lda[ g ] >= max(1, n[ g ]).
+///
+/// @param[in,out] Barray
+///     Pointers to the sum( group_size ) right-hand sides.
+///     On exit, the solutions.
+///
+/// @param[in] ldb
+///     Leading dimension of B, per group; ldb[ g ] >= max(1, n[ g ]).
+///
+/// @param[in] group_size
+///     Number of systems in each group.
+///
+/// @param[out] info
+///     Resized to sum( group_size ) entries, as in the
+///     pointer-array variant.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<scalar_t*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info )
+{
+    internal::batch::Groups groups( group_size );
+    internal::batch::check_group_size( uplo, groups );
+    internal::batch::check_group_size( n, groups );
+    internal::batch::check_group_size( nrhs, groups );
+    internal::batch::check_group_size( lda, groups );
+    internal::batch::check_group_size( ldb, groups );
+    internal::batch::check_array_size( Aarray, groups.batch() );
+    internal::batch::check_array_size( Barray, groups.batch() );
+    for (size_t g = 0; g < groups.count(); ++g) {
+        lapack_error_if( n[ g ] < 0 );
+        lapack_error_if( nrhs[ g ] < 0 );
+        lapack_error_if( lda[ g ] < max( 1, n[ g ] ) );
+        lapack_error_if( ldb[ g ] < max( 1, n[ g ] ) );
+    }
+
+    trace::internal::Block trace_block(
+        "potrs_batch", trace::internal::precision< scalar_t >(),
+        -1, internal::batch::trace_dim( n ), internal::batch::trace_dim( nrhs ),
+        [&]() {
+            double gflop = 0;
+            for (size_t g = 0; g < groups.count(); ++g)
+                gflop += group_size[ g ] * Gflop< scalar_t >::potrs(
+                    n[ g ],
+                    nrhs[ g ] );
+            return gflop;
+        } );
+
+    info.resize( groups.batch() );
+    internal::parallel_for( groups.batch(), [&]( int64_t i, int worker ) {
+        size_t g = groups.group( i );
+        info[ i ] = lapack::potrs(
+            uplo[ g ], n[ g ], nrhs[ g ],
+            Aarray[ i ], lda[ g ],
+            Barray[ i ], ldb[ g ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems $A_i X_i = B_i$, using the Cholesky factors
+/// computed by potrf_batch, strided variant. See lapack::potrs.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of each $A_i$ holds the factor.
+///
+/// @param[in] n
+///     Order of each $A_i$.
+///
+/// @param[in] nrhs
+///     Number of columns of each $B_i$.
+///
+/// @param[in] A
+///     The batch Cholesky factors, with $A_i$ stored in an lda-by-n array
+///     starting at A + i*strideA.
+///
+/// @param[in] lda
+///     Leading dimension of each $A_i$; lda >= max(1, n).
+///
+/// @param[in] strideA
+///     Distance between matrices; strideA >= lda*n.
+///
+/// @param[in,out] B
+///     The batch right-hand sides, with $B_i$ stored in an ldb-by-nrhs
+///     array starting at B + i*strideB. On exit, the solutions $X_i$.
+///
+/// @param[in] ldb
+///     Leading dimension of each $B_i$; ldb >= max(1, n).
+///
+/// @param[in] strideB
+///     Distance between right-hand sides; strideB >= ldb*nrhs.
+///
+/// @param[in] batch
+///     Number of systems.
+///
+/// @param[out] info
+///     Resized to batch entries, as in the pointer-array variant.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( strideB < ldb*nrhs );
+
+    trace::internal::Block trace_block(
+        "potrs_batch", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        [&]() { return batch * Gflop< scalar_t >::potrs( n, nrhs ); } );
+
+    info.resize( batch );
+    internal::parallel_for( batch, [&]( int64_t i, int worker ) {
+        info[ i ] = lapack::potrs(
+            uplo, n, nrhs,
+            &A[ i*strideA ], lda,
+            &B[ i*strideB ], ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*> const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Barray, std::vector<int64_t> const& ldb,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<float*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector<double*> const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*> const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    std::vector<lapack::Uplo> const& uplo,
+    std::vector<int64_t> const& n,
+    std::vector<int64_t> const& nrhs,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<int64_t> const& group_size, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda, int64_t strideA,
+    float* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda, int64_t strideA,
+    double* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float>* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+template
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double>* B, int64_t ldb, int64_t strideB,
+    size_t batch, std::vector<int64_t>& info );
+
+}  // namespace lapack
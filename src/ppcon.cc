@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -26,13 +27,18 @@ int64_t ppcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ppcon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sppcon(
         &uplo_, &n_,
@@ -60,13 +66,18 @@ int64_t ppcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ppcon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dppcon(
         &uplo_, &n_,
@@ -94,13 +105,18 @@ int64_t ppcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ppcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cppcon(
         &uplo_, &n_,
@@ -165,13 +181,18 @@ int64_t ppcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ppcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zppcon(
         &uplo_, &n_,
@@ -188,4 +209,217 @@ int64_t ppcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ppcon(
+    char uplo, lapack_int n,
+    float const* AP, float anorm, float* rcond,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sppcon(
+        &uplo, &n,
+        AP, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ppcon(
+    char uplo, lapack_int n,
+    double const* AP, double anorm, double* rcond,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dppcon(
+        &uplo, &n,
+        AP, &anorm, rcond,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ppcon(
+    char uplo, lapack_int n,
+    std::complex<float> const* AP, float anorm, float* rcond,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cppcon(
+        &uplo, &n,
+        (lapack_complex_float const*) AP, &anorm, rcond,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ppcon(
+    char uplo, lapack_int n,
+    std::complex<double> const* AP, double anorm, double* rcond,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zppcon(
+        &uplo, &n,
+        (lapack_complex_double const*) AP, &anorm, rcond,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ppcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ppcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ppcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ppcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* AP, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ppcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_ppcon(
+        uplo_, n_,
+        AP, anorm, rcond,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP, float anorm,
+    size_t* work_size );
+
+template
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP, double anorm,
+    size_t* work_size );
+
+template
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP, float anorm,
+    size_t* work_size );
+
+template
+void ppcon_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    float const* AP, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    double const* AP, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float> const* AP, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ppcon(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double> const* AP, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
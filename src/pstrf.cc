@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,12 +28,17 @@ int64_t pstrf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pstrf", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > piv_( (n) );
+        lapack::small_vector< lapack_int > piv_( (n) );
         lapack_int* piv_ptr = &piv_[0];
     #else
         lapack_int* piv_ptr = piv;
@@ -41,7 +47,7 @@ int64_t pstrf(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_spstrf(
         &uplo_, &n_,
@@ -74,12 +80,17 @@ int64_t pstrf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pstrf", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > piv_( (n) );
+        lapack::small_vector< lapack_int > piv_( (n) );
         lapack_int* piv_ptr = &piv_[0];
     #else
         lapack_int* piv_ptr = piv;
@@ -88,7 +99,7 @@ int64_t pstrf(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_dpstrf(
         &uplo_, &n_,
@@ -121,12 +132,17 @@ int64_t pstrf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pstrf", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > piv_( (n) );
+        lapack::small_vector< lapack_int > piv_( (n) );
         lapack_int* piv_ptr = &piv_[0];
     #else
         lapack_int* piv_ptr = piv;
@@ -135,7 +151,7 @@ int64_t pstrf(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_cpstrf(
         &uplo_, &n_,
@@ -168,12 +184,17 @@ int64_t pstrf(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pstrf", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > piv_( (n) );
+        lapack::small_vector< lapack_int > piv_( (n) );
         lapack_int* piv_ptr = &piv_[0];
     #else
         lapack_int* piv_ptr = piv;
@@ -182,7 +203,7 @@ int64_t pstrf(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_zpstrf(
         &uplo_, &n_,
@@ -203,4 +224,230 @@ int64_t pstrf(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_pstrf(
+    char uplo, lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* piv, lapack_int* rank, float tol,
+    float* work, lapack_int* info )
+{
+    LAPACK_spstrf(
+        &uplo, &n,
+        A, &lda,
+        piv, rank, &tol,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pstrf(
+    char uplo, lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* piv, lapack_int* rank, double tol,
+    double* work, lapack_int* info )
+{
+    LAPACK_dpstrf(
+        &uplo, &n,
+        A, &lda,
+        piv, rank, &tol,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pstrf(
+    char uplo, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* piv, lapack_int* rank, float tol,
+    float* work, lapack_int* info )
+{
+    LAPACK_cpstrf(
+        &uplo, &n,
+        (lapack_complex_float*) A, &lda,
+        piv, rank, &tol,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pstrf(
+    char uplo, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* piv, lapack_int* rank, double tol,
+    double* work, lapack_int* info )
+{
+    LAPACK_zpstrf(
+        &uplo, &n,
+        (lapack_complex_double*) A, &lda,
+        piv, rank, &tol,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by pstrf with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, blas::real_type<scalar_t> tol,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    buffer.take< real_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::pstrf, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::pstrf for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     pstrf_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, blas::real_type<scalar_t> tol,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "pstrf", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* piv_ = buffer.take< lapack_int >( n );
+        lapack_int* piv_ptr = piv_;
+    #else
+        lapack_int* piv_ptr = piv;
+    #endif
+    real_t* work_ = buffer.take< real_t >( 2*n );
+
+    fortran_pstrf(
+        uplo_, n_,
+        A, lda_,
+        piv_ptr, &rank_, tol,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    #ifndef LAPACK_ILP64
+        std::copy( piv_, piv_ + n, piv );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float tol,
+    size_t* work_size );
+
+template
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double tol,
+    size_t* work_size );
+
+template
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, float tol,
+    size_t* work_size );
+
+template
+void pstrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, double tol,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, float tol,
+    void* work, size_t work_size );
+
+template
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, double tol,
+    void* work, size_t work_size );
+
+template
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, float tol,
+    void* work, size_t work_size );
+
+template
+int64_t pstrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* piv,
+    int64_t* rank, double tol,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,11 +28,16 @@ int64_t ptcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptcon", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (n) );
+    lapack::small_vector< float > work( (n) );
 
     LAPACK_sptcon(
         &n_,
@@ -56,11 +62,16 @@ int64_t ptcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptcon", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n) );
+    lapack::small_vector< double > work( (n) );
 
     LAPACK_dptcon(
         &n_,
@@ -85,11 +96,16 @@ int64_t ptcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptcon", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cptcon(
         &n_,
@@ -158,11 +174,16 @@ int64_t ptcon(
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptcon", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zptcon(
         &n_,
@@ -175,4 +196,208 @@ int64_t ptcon(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ptcon(
+    lapack_int n,
+    float const* D,
+    float const* E, float anorm, float* rcond,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sptcon(
+        &n,
+        D,
+        E, &anorm, rcond,
+        work, info );
+}
+
+//----------
+static void fortran_ptcon(
+    lapack_int n,
+    double const* D,
+    double const* E, double anorm, double* rcond,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dptcon(
+        &n,
+        D,
+        E, &anorm, rcond,
+        work, info );
+}
+
+//----------
+static void fortran_ptcon(
+    lapack_int n,
+    float const* D,
+    std::complex<float> const* E, float anorm, float* rcond,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cptcon(
+        &n,
+        D,
+        (lapack_complex_float const*) E, &anorm, rcond,
+        rwork, info );
+}
+
+//----------
+static void fortran_ptcon(
+    lapack_int n,
+    double const* D,
+    std::complex<double> const* E, double anorm, double* rcond,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zptcon(
+        &n,
+        D,
+        (lapack_complex_double const*) E, &anorm, rcond,
+        rwork, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ptcon with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ptcon_work_size_bytes(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ptcon, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ptcon for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ptcon_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ptcon(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E, blas::real_type<scalar_t> anorm,
+    blas::real_type<scalar_t>* rcond,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ptcon", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_ptcon(
+        n_,
+        D,
+        E, anorm, rcond,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ptcon_work_size_bytes(
+    int64_t n,
+    float const* D,
+    float const* E, float anorm,
+    size_t* work_size );
+
+template
+void ptcon_work_size_bytes(
+    int64_t n,
+    double const* D,
+    double const* E, double anorm,
+    size_t* work_size );
+
+template
+void ptcon_work_size_bytes(
+    int64_t n,
+    float const* D,
+    std::complex<float> const* E, float anorm,
+    size_t* work_size );
+
+template
+void ptcon_work_size_bytes(
+    int64_t n,
+    double const* D,
+    std::complex<double> const* E, double anorm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ptcon(
+    int64_t n,
+    float const* D,
+    float const* E, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ptcon(
+    int64_t n,
+    double const* D,
+    double const* E, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ptcon(
+    int64_t n,
+    float const* D,
+    std::complex<float> const* E, float anorm,
+    float* rcond,
+    void* work, size_t work_size );
+
+template
+int64_t ptcon(
+    int64_t n,
+    double const* D,
+    std::complex<double> const* E, double anorm,
+    double* rcond,
+    void* work, size_t work_size );
+
 }  // namespace lapack
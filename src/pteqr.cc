@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,13 +28,18 @@ int64_t pteqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pteqr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
+    lapack::small_vector< float > work( (4*n) );
 
     LAPACK_spteqr(
         &compz_, &n_,
@@ -63,13 +69,18 @@ int64_t pteqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pteqr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
+    lapack::small_vector< double > work( (4*n) );
 
     LAPACK_dpteqr(
         &compz_, &n_,
@@ -99,13 +110,18 @@ int64_t pteqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pteqr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (4*n) );
+    lapack::small_vector< float > work( (4*n) );
 
     LAPACK_cpteqr(
         &compz_, &n_,
@@ -135,13 +151,18 @@ int64_t pteqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "pteqr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (4*n) );
+    lapack::small_vector< double > work( (4*n) );
 
     LAPACK_zpteqr(
         &compz_, &n_,
@@ -159,4 +180,235 @@ int64_t pteqr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_pteqr(
+    char compz, lapack_int n,
+    float* D,
+    float* E,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_spteqr(
+        &compz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pteqr(
+    char compz, lapack_int n,
+    double* D,
+    double* E,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_dpteqr(
+        &compz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pteqr(
+    char compz, lapack_int n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_cpteqr(
+        &compz, &n,
+        D,
+        E,
+        (lapack_complex_float*) Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_pteqr(
+    char compz, lapack_int n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_zpteqr(
+        &compz, &n,
+        D,
+        E,
+        (lapack_complex_double*) Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by pteqr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( 4*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::pteqr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::pteqr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     pteqr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "pteqr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( 4*n );
+
+    fortran_pteqr(
+        compz_, n_,
+        D,
+        E,
+        Z, ldz_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void pteqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t pteqr(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -36,6 +37,11 @@ int64_t ptsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptsvx", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -44,7 +50,7 @@ int64_t ptsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_sptsvx(
         &fact_, &n_, &nrhs_,
@@ -88,6 +94,11 @@ int64_t ptsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptsvx", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -96,7 +107,7 @@ int64_t ptsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_dptsvx(
         &fact_, &n_, &nrhs_,
@@ -140,6 +151,11 @@ int64_t ptsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptsvx", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -148,8 +164,8 @@ int64_t ptsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_cptsvx(
         &fact_, &n_, &nrhs_,
@@ -297,6 +313,11 @@ int64_t ptsvx(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "ptsvx", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char fact_ = factored2char( fact );
     lapack_int n_ = (lapack_int) n;
     lapack_int nrhs_ = (lapack_int) nrhs;
@@ -305,8 +326,8 @@ int64_t ptsvx(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_zptsvx(
         &fact_, &n_, &nrhs_,
@@ -330,4 +351,350 @@ int64_t ptsvx(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_ptsvx(
+    char fact, lapack_int n, lapack_int nrhs,
+    float const* D,
+    float const* E,
+    float* DF,
+    float* EF,
+    float const* B, lapack_int ldb,
+    float* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_sptsvx(
+        &fact, &n, &nrhs,
+        D,
+        E,
+        DF,
+        EF,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ptsvx(
+    char fact, lapack_int n, lapack_int nrhs,
+    double const* D,
+    double const* E,
+    double* DF,
+    double* EF,
+    double const* B, lapack_int ldb,
+    double* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dptsvx(
+        &fact, &n, &nrhs,
+        D,
+        E,
+        DF,
+        EF,
+        B, &ldb,
+        X, &ldx, rcond,
+        ferr,
+        berr,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ptsvx(
+    char fact, lapack_int n, lapack_int nrhs,
+    float const* D,
+    std::complex<float> const* E,
+    float* DF,
+    std::complex<float>* EF,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* X, lapack_int ldx, float* rcond,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_cptsvx(
+        &fact, &n, &nrhs,
+        D,
+        (lapack_complex_float const*) E,
+        DF,
+        (lapack_complex_float*) EF,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_ptsvx(
+    char fact, lapack_int n, lapack_int nrhs,
+    double const* D,
+    std::complex<double> const* E,
+    double* DF,
+    std::complex<double>* EF,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx, double* rcond,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_zptsvx(
+        &fact, &n, &nrhs,
+        D,
+        (lapack_complex_double const*) E,
+        DF,
+        (lapack_complex_double*) EF,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) X, &ldx, rcond,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by ptsvx with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t>* DF,
+    scalar_t* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? n : 2*n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::ptsvx, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::ptsvx for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     ptsvx_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    blas::real_type<scalar_t> const* D,
+    scalar_t const* E,
+    blas::real_type<scalar_t>* DF,
+    scalar_t* EF,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type<scalar_t>* rcond,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "ptsvx", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char fact_ = factored2char( fact );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? n : 2*n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_ptsvx(
+        fact_, n_, nrhs_,
+        D,
+        E,
+        DF,
+        EF,
+        B, ldb_,
+        X, ldx_, rcond,
+        ferr,
+        berr,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    float const* D,
+    float const* E,
+    float* DF,
+    float* EF,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    double const* D,
+    double const* E,
+    double* DF,
+    double* EF,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    float const* D,
+    std::complex<float> const* E,
+    float* DF,
+    std::complex<float>* EF,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void ptsvx_work_size_bytes(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    double const* D,
+    std::complex<double> const* E,
+    double* DF,
+    std::complex<double>* EF,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    float const* D,
+    float const* E,
+    float* DF,
+    float* EF,
+    float const* B, int64_t ldb,
+    float* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    double const* D,
+    double const* E,
+    double* DF,
+    double* EF,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    float const* D,
+    std::complex<float> const* E,
+    float* DF,
+    std::complex<float>* EF,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* X, int64_t ldx,
+    float* rcond,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t ptsvx(
+    lapack::Factored fact, int64_t n, int64_t nrhs,
+    double const* D,
+    std::complex<double> const* E,
+    double* DF,
+    std::complex<double>* EF,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    double* rcond,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -0,0 +1,94 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/device.hh"
+
+#include <algorithm>
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Allocates each workspace at exactly the size requested, like
+// blas::Queue::work_resize, so workspace_reserve can size the pool up
+// front for the largest problem, and later calls don't reallocate.
+void Queue::workspace_reserve( size_t dev_size, size_t host_size )
+{
+    dev_workspace_peak_  = std::max( dev_workspace_peak_,  dev_size );
+    host_workspace_peak_ = std::max( host_workspace_peak_, host_size );
+    if (dev_size <= dev_workspace_size_ && host_size <= host_workspace_size_)
+        return;
+
+    // Tasks in flight may still use the old workspace.
+    sync();
+
+    if (dev_size > dev_workspace_size_) {
+        #if defined(LAPACK_HAVE_HOST_DEVICE)
+            std::free( dev_workspace_ );
+            dev_workspace_ = nullptr;
+            dev_workspace_size_ = 0;
+            dev_workspace_ = std::malloc( dev_size );
+            if (dev_workspace_ == nullptr)
+                throw Error( "device memory allocation failed", __func__ );
+        #else
+            blas::set_device( device() );
+            blas::device_free( (char*) dev_workspace_ );
+            dev_workspace_ = nullptr;
+            dev_workspace_size_ = 0;
+            dev_workspace_ = blas::device_malloc< char >( dev_size );
+        #endif
+        dev_workspace_size_ = dev_size;
+    }
+
+    if (host_size > host_workspace_size_) {
+        #if defined(LAPACK_HAVE_HOST_DEVICE)
+            std::free( host_workspace_ );
+            host_workspace_ = nullptr;
+            host_workspace_size_ = 0;
+            host_workspace_ = std::malloc( host_size );
+            if (host_workspace_ == nullptr)
+                throw Error( "host memory allocation failed", __func__ );
+        #else
+            blas::set_device( device() );
+            blas::device_free_pinned( (char*) host_workspace_ );
+            host_workspace_ = nullptr;
+            host_workspace_size_ = 0;
+            host_workspace_ = blas::device_malloc_pinned< char >( host_size );
+        #endif
+        host_workspace_size_ = host_size;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Queue::workspace_release()
+{
+    // Tasks in flight may still use the workspace.
+    sync();
+    workspace_free();
+}
+
+//------------------------------------------------------------------------------
+// Frees the workspace pool without syncing. The destructor calls this,
+// on the host device after its worker thread finished; on GPUs, freeing
+// device memory waits for kernels using it.
+void Queue::workspace_free()
+{
+    #if defined(LAPACK_HAVE_HOST_DEVICE)
+        std::free( dev_workspace_ );
+        std::free( host_workspace_ );
+    #else
+        if (dev_workspace_ != nullptr || host_workspace_ != nullptr) {
+            blas::set_device( device() );
+            blas::device_free( (char*) dev_workspace_ );
+            blas::device_free_pinned( (char*) host_workspace_ );
+        }
+    #endif
+    dev_workspace_  = nullptr;
+    host_workspace_ = nullptr;
+    dev_workspace_size_  = 0;
+    host_workspace_size_ = 0;
+}
+
+} // namespace lapack
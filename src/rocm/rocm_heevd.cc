@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS)
+
+#include "lapack/device.hh"
+
+#include <rocsolver.h>
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+
+namespace blas {
+namespace device {
+
+rocblas_fill uplo2rocblas(blas::Uplo uplo);
+
+} // namespace device
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver workspace query.
+// rocSolver needs n reals for the off-diagonal of the tridiagonal matrix.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    *dev_work_size  = n * sizeof(blas::real_type<scalar_t>);
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_heevd(
+    rocblas_handle solver, rocblas_evect evect, rocblas_fill uplo,
+    rocblas_int n, float* dA, rocblas_int ldda,
+    float* dW, float* dE, rocblas_int* info )
+{
+    rocsolver_ssyevd(
+        solver, evect, uplo, n,
+        dA, ldda, dW, dE, info );
+}
+
+//----------
+void rocsolver_heevd(
+    rocblas_handle solver, rocblas_evect evect, rocblas_fill uplo,
+    rocblas_int n, double* dA, rocblas_int ldda,
+    double* dW, double* dE, rocblas_int* info )
+{
+    rocsolver_dsyevd(
+        solver, evect, uplo, n,
+        dA, ldda, dW, dE, info );
+}
+
+//----------
+void rocsolver_heevd(
+    rocblas_handle solver, rocblas_evect evect, rocblas_fill uplo,
+    rocblas_int n, std::complex<float>* dA, rocblas_int ldda,
+    float* dW, float* dE, rocblas_int* info )
+{
+    rocsolver_cheevd(
+        solver, evect, uplo, n,
+        (rocblas_float_complex*) dA, ldda, dW, dE, info );
+}
+
+//----------
+void rocsolver_heevd(
+    rocblas_handle solver, rocblas_evect evect, rocblas_fill uplo,
+    rocblas_int n, std::complex<double>* dA, rocblas_int ldda,
+    double* dW, double* dE, rocblas_int* info )
+{
+    rocsolver_zheevd(
+        solver, evect, uplo, n,
+        (rocblas_double_complex*) dA, ldda, dW, dE, info );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // todo: check for overflow
+    lapack_error_if( dev_work_size < n * sizeof(real_t) );
+    auto solver = queue.handle();
+    auto evect = (jobz == Job::Vec ? rocblas_evect_original
+                                   : rocblas_evect_none);
+    auto uplo_ = blas::device::uplo2rocblas( uplo );
+
+    blas::set_device( queue.device() );
+
+    rocsolver_heevd( solver, evect, uplo_, n, dA, ldda, dW,
+                     (real_t*) dev_work, dev_info );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* dA, int64_t ldda, float* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* dA, int64_t ldda, double* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* dA, int64_t ldda, float* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* dA, int64_t ldda, double* dW,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS
@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS)
+
+#include "lapack/device.hh"
+
+#include <rocsolver.h>
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver workspace query.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    *dev_work_size  = 0;
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_ungqr(
+    rocblas_handle solver, rocblas_int m, rocblas_int n, rocblas_int k,
+    float* dA, rocblas_int ldda, float const* dtau )
+{
+    rocsolver_sorgqr(
+        solver, m, n, k,
+        dA, ldda, (float*) dtau );
+}
+
+//----------
+void rocsolver_ungqr(
+    rocblas_handle solver, rocblas_int m, rocblas_int n, rocblas_int k,
+    double* dA, rocblas_int ldda, double const* dtau )
+{
+    rocsolver_dorgqr(
+        solver, m, n, k,
+        dA, ldda, (double*) dtau );
+}
+
+//----------
+void rocsolver_ungqr(
+    rocblas_handle solver, rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<float>* dA, rocblas_int ldda, std::complex<float> const* dtau )
+{
+    rocsolver_cungqr(
+        solver, m, n, k,
+        (rocblas_float_complex*) dA, ldda, (rocblas_float_complex*) dtau );
+}
+
+//----------
+void rocsolver_ungqr(
+    rocblas_handle solver, rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<double>* dA, rocblas_int ldda, std::complex<double> const* dtau )
+{
+    rocsolver_zungqr(
+        solver, m, n, k,
+        (rocblas_double_complex*) dA, ldda, (rocblas_double_complex*) dtau );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+// In rocSolver, the workspaces are ignored.
+// In rocSolver, there is no info; it is set to 0.
+template <typename scalar_t>
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda, scalar_t const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    auto solver = queue.handle();
+
+    blas::set_device( queue.device() );
+
+    rocsolver_ungqr( solver, m, n, k, dA, ldda, dtau );
+    device_memset( dev_info, 0, 1, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void ungqr_work_size_bytes(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    float* dA, int64_t ldda, float const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    double* dA, int64_t ldda, double const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float>* dA, int64_t ldda, std::complex<float> const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void ungqr(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double>* dA, int64_t ldda, std::complex<double> const* dtau,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS
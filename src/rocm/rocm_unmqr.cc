@@ -0,0 +1,195 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS)
+
+#include "lapack/device.hh"
+
+#include <rocsolver.h>
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+
+namespace blas {
+namespace device {
+
+rocblas_operation op2rocblas(blas::Op trans);
+rocblas_side side2rocblas(blas::Side side);
+
+} // namespace device
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver workspace query.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    *dev_work_size  = 0;
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    float const* dA, rocblas_int ldda, float const* dtau,
+    float* dC, rocblas_int lddc )
+{
+    rocsolver_sormqr(
+        solver, side, trans, m, n, k,
+        (float*) dA, ldda, (float*) dtau,
+        dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    double const* dA, rocblas_int ldda, double const* dtau,
+    double* dC, rocblas_int lddc )
+{
+    rocsolver_dormqr(
+        solver, side, trans, m, n, k,
+        (double*) dA, ldda, (double*) dtau,
+        dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<float> const* dA, rocblas_int ldda, std::complex<float> const* dtau,
+    std::complex<float>* dC, rocblas_int lddc )
+{
+    rocsolver_cunmqr(
+        solver, side, trans, m, n, k,
+        (rocblas_float_complex*) dA, ldda, (rocblas_float_complex*) dtau,
+        (rocblas_float_complex*) dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<double> const* dA, rocblas_int ldda, std::complex<double> const* dtau,
+    std::complex<double>* dC, rocblas_int lddc )
+{
+    rocsolver_zunmqr(
+        solver, side, trans, m, n, k,
+        (rocblas_double_complex*) dA, ldda, (rocblas_double_complex*) dtau,
+        (rocblas_double_complex*) dC, lddc );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver.
+// This is async. Once finished, the return info is in dev_info on the device.
+// In rocSolver, the workspaces are ignored.
+// In rocSolver, there is no info; it is set to 0.
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda, scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // For real, rocSolver ormqr takes Trans, not ConjTrans.
+    if (! blas::is_complex< scalar_t >::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // todo: check for overflow
+    auto solver = queue.handle();
+    auto side_  = blas::device::side2rocblas( side );
+    auto trans_ = blas::device::op2rocblas( trans );
+
+    blas::set_device( queue.device() );
+
+    rocsolver_unmqr( solver, side_, trans_, m, n, k, dA, ldda, dtau,
+                     dC, lddc );
+    device_memset( dev_info, 0, 1, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda, float const* dtau,
+    float* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda, double const* dtau,
+    double* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda, std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda, std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +30,11 @@ int64_t sbev(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbev", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -38,7 +44,7 @@ int64_t sbev(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (max( 1, 3*n-2 )) );
+    lapack::small_vector< float > work( (max( 1, 3*n-2 )) );
 
     LAPACK_ssbev(
         &jobz_, &uplo_, &n_, &kd_,
@@ -70,6 +76,11 @@ int64_t sbev(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbev", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -79,7 +90,7 @@ int64_t sbev(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (max( 1, 3*n-2 )) );
+    lapack::small_vector< double > work( (max( 1, 3*n-2 )) );
 
     LAPACK_dsbev(
         &jobz_, &uplo_, &n_, &kd_,
@@ -97,4 +108,166 @@ int64_t sbev(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_sbev(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    float* AB, lapack_int ldab,
+    float* W,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_ssbev(
+        &jobz, &uplo, &n, &kd,
+        AB, &ldab,
+        W,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_sbev(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    double* AB, lapack_int ldab,
+    double* W,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_dsbev(
+        &jobz, &uplo, &n, &kd,
+        AB, &ldab,
+        W,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by sbev with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void sbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( max( 1, 3*n-2 ) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::sbev, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::sbev for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     sbev_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t sbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "sbev", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( max( 1, 3*n-2 ) );
+
+    fortran_sbev(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        W,
+        Z, ldz_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void sbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void sbev_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t sbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* W,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t sbev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* W,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
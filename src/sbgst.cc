@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -31,6 +32,11 @@ int64_t sbgst(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbgst", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -42,7 +48,7 @@ int64_t sbgst(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_ssbgst(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -76,6 +82,11 @@ int64_t sbgst(
         lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbgst", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -87,7 +98,7 @@ int64_t sbgst(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_dsbgst(
         &jobz_, &uplo_, &n_, &ka_, &kb_,
@@ -105,4 +116,172 @@ int64_t sbgst(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_sbgst(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    float* AB, lapack_int ldab,
+    float const* BB, lapack_int ldbb,
+    float* X, lapack_int ldx,
+    float* work, lapack_int* info )
+{
+    LAPACK_ssbgst(
+        &jobz, &uplo, &n, &ka, &kb,
+        AB, &ldab,
+        BB, &ldbb,
+        X, &ldx,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_sbgst(
+    char jobz, char uplo, lapack_int n, lapack_int ka, lapack_int kb,
+    double* AB, lapack_int ldab,
+    double const* BB, lapack_int ldbb,
+    double* X, lapack_int ldx,
+    double* work, lapack_int* info )
+{
+    LAPACK_dsbgst(
+        &jobz, &uplo, &n, &ka, &kb,
+        AB, &ldab,
+        BB, &ldbb,
+        X, &ldx,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by sbgst with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void sbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::sbgst, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::sbgst for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     sbgst_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t sbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    scalar_t* AB, int64_t ldab,
+    scalar_t const* BB, int64_t ldbb,
+    scalar_t* X, int64_t ldx,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ka) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldbb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "sbgst", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ka_ = (lapack_int) ka;
+    lapack_int kb_ = (lapack_int) kb;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldbb_ = (lapack_int) ldbb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_sbgst(
+        jobz_, uplo_, n_, ka_, kb_,
+        AB, ldab_,
+        BB, ldbb_,
+        X, ldx_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void sbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float const* BB, int64_t ldbb,
+    float* X, int64_t ldx,
+    size_t* work_size );
+
+template
+void sbgst_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double const* BB, int64_t ldbb,
+    double* X, int64_t ldx,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t sbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    float* AB, int64_t ldab,
+    float const* BB, int64_t ldbb,
+    float* X, int64_t ldx,
+    void* work, size_t work_size );
+
+template
+int64_t sbgst(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t ka, int64_t kb,
+    double* AB, int64_t ldab,
+    double const* BB, int64_t ldbb,
+    double* X, int64_t ldx,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -30,6 +31,11 @@ int64_t sbtrd(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbtrd", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -39,7 +45,7 @@ int64_t sbtrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (n) );
+    lapack::small_vector< float > work( (n) );
 
     LAPACK_ssbtrd(
         &jobz_, &uplo_, &n_, &kd_,
@@ -73,6 +79,11 @@ int64_t sbtrd(
         lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "sbtrd", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
@@ -82,7 +93,7 @@ int64_t sbtrd(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n) );
+    lapack::small_vector< double > work( (n) );
 
     LAPACK_dsbtrd(
         &jobz_, &uplo_, &n_, &kd_,
@@ -101,4 +112,177 @@ int64_t sbtrd(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_sbtrd(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    float* AB, lapack_int ldab,
+    float* D,
+    float* E,
+    float* Q, lapack_int ldq,
+    float* work, lapack_int* info )
+{
+    LAPACK_ssbtrd(
+        &jobz, &uplo, &n, &kd,
+        AB, &ldab,
+        D,
+        E,
+        Q, &ldq,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_sbtrd(
+    char jobz, char uplo, lapack_int n, lapack_int kd,
+    double* AB, lapack_int ldab,
+    double* D,
+    double* E,
+    double* Q, lapack_int ldq,
+    double* work, lapack_int* info )
+{
+    LAPACK_dsbtrd(
+        &jobz, &uplo, &n, &kd,
+        AB, &ldab,
+        D,
+        E,
+        Q, &ldq,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by sbtrd with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void sbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::sbtrd, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::sbtrd for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     sbtrd_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t sbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Q, int64_t ldq,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "sbtrd", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+
+    fortran_sbtrd(
+        jobz_, uplo_, n_, kd_,
+        AB, ldab_,
+        D,
+        E,
+        Q, ldq_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void sbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void sbtrd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t sbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    float* AB, int64_t ldab,
+    float* D,
+    float* E,
+    float* Q, int64_t ldq,
+    void* work, size_t work_size );
+
+template
+int64_t sbtrd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
+    double* AB, int64_t ldab,
+    double* D,
+    double* E,
+    double* Q, int64_t ldq,
+    void* work, size_t work_size );
+
 }  // namespace lapack
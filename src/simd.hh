@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_SIMD_HH
+#define LAPACK_SIMD_HH
+
+// Portable SIMD support for native kernels. Kernels are written as loops
+// over independent lanes, which the compiler vectorizes, rather than with
+// ISA-specific intrinsics.
+
+//------------------------------------------------------------------------------
+// LAPACK_LANES precedes loops over lanes, telling the compiler the
+// iterations are independent, so it vectorizes them.
+#if defined( __clang__ )
+    #define LAPACK_LANES _Pragma( "clang loop vectorize(enable)" )
+#elif defined( __GNUC__ )
+    #define LAPACK_LANES _Pragma( "GCC ivdep" )
+#else
+    #define LAPACK_LANES
+#endif
+
+// LAPACK_SIMD_CLONES compiles a kernel for AVX-512, AVX2, and baseline,
+// selected at load time, so kernels use the widest SIMD available even
+// when the library is built for generic x86-64. It needs GCC's ifunc
+// support; define LAPACK_NO_SIMD_CLONES to disable it.
+#if defined( __GNUC__ ) && ! defined( __clang__ ) \
+    && ! defined( __INTEL_COMPILER ) && ! defined( __INTEL_LLVM_COMPILER ) \
+    && defined( __x86_64__ ) && defined( __linux__ ) \
+    && ! defined( LAPACK_NO_SIMD_CLONES )
+    #define LAPACK_SIMD_CLONES \
+        __attribute__(( target_clones( "avx512f", "avx2", "default" ) ))
+#else
+    #define LAPACK_SIMD_CLONES
+#endif
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Number of scalar_t elements in 64 bytes, one AVX-512 register.
+template <typename scalar_t>
+constexpr int simd_width()
+{
+    return 64 / sizeof(scalar_t);
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_SIMD_HH
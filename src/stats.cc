@@ -0,0 +1,505 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/stats.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lapack {
+namespace stats {
+namespace internal {
+
+std::atomic< bool > enabled( true );
+
+// reset increments generation; a thread zeros its counters for a routine
+// on its next call, and dump skips counters of older generations.
+static std::atomic< int64_t > generation( 0 );
+
+//------------------------------------------------------------------------------
+// @return log2 bucket of dimension d >= 0: 0 for d = 0,
+// else b such that 2^(b-1) <= d < 2^b, clamped to the last bucket.
+static int bucket( int64_t d )
+{
+    int b = 0;
+    while (d > 0 && b < num_buckets - 1) {
+        d >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+//------------------------------------------------------------------------------
+// Counters of one routine and precision in one thread. Only the owning
+// thread writes, so updates are relaxed load-add-store, without
+// read-modify-write; dump reads them concurrently.
+struct Entry {
+    Entry( char const* name_, char precision_ ):
+        name( name_ ),
+        precision( precision_ ),
+        generation( -1 )
+    {}
+
+    // Zeros counters, then marks them current for dump.
+    void zero( int64_t gen )
+    {
+        count.store( 0, std::memory_order_relaxed );
+        time.store( 0, std::memory_order_relaxed );
+        min_time.store( std::numeric_limits<double>::infinity(),
+                        std::memory_order_relaxed );
+        max_time.store( 0, std::memory_order_relaxed );
+        gflop.store( 0, std::memory_order_relaxed );
+        for (int b = 0; b < num_buckets; ++b) {
+            m_hist[ b ].store( 0, std::memory_order_relaxed );
+            n_hist[ b ].store( 0, std::memory_order_relaxed );
+        }
+        generation.store( gen, std::memory_order_release );
+    }
+
+    char const* name;
+    char precision;
+    std::atomic< int64_t > generation;
+    std::atomic< int64_t > count;
+    std::atomic< double > time;
+    std::atomic< double > min_time;
+    std::atomic< double > max_time;
+    std::atomic< double > gflop;
+    std::atomic< int64_t > m_hist[ num_buckets ];
+    std::atomic< int64_t > n_hist[ num_buckets ];
+};
+
+//------------------------------------------------------------------------------
+// Adds x to an atomic written only by the calling thread.
+template <typename T>
+static void add( std::atomic< T >& a, T x )
+{
+    a.store( a.load( std::memory_order_relaxed ) + x,
+             std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+// Open-addressing hash table of one thread's entries. Only the owning
+// thread inserts, publishing each entry with a release store, so dump
+// can walk the table without locks. Entries are never removed.
+// Calls to routines that don't fit in a full table are counted as dropped.
+class ThreadStats
+{
+public:
+    static const int num_slots = 256;
+
+    ThreadStats():
+        dropped_( 0 ),
+        dropped_generation_( -1 )
+    {
+        for (auto& slot : slots_)
+            slot.store( nullptr, std::memory_order_relaxed );
+    }
+
+    ~ThreadStats()
+    {
+        for (auto& slot : slots_)
+            delete slot.load( std::memory_order_relaxed );
+    }
+
+    // Disable copying.
+    ThreadStats( ThreadStats const& ) = delete;
+    ThreadStats& operator=( ThreadStats const& ) = delete;
+
+    // @return entry for name and precision, inserting it if needed;
+    // null if the table is full.
+    Entry* find( char const* name, char precision )
+    {
+        unsigned hash = (unsigned char) precision;
+        for (char const* c = name; *c != '\0'; ++c)
+            hash = hash*31 + (unsigned char) *c;
+        for (int i = 0; i < num_slots; ++i) {
+            std::atomic< Entry* >& slot = slots_[ (hash + i) % num_slots ];
+            Entry* entry = slot.load( std::memory_order_relaxed );
+            if (entry == nullptr) {
+                entry = new Entry( name, precision );
+                slot.store( entry, std::memory_order_release );
+                return entry;
+            }
+            if (entry->precision == precision
+                && (entry->name == name || strcmp( entry->name, name ) == 0))
+                return entry;
+        }
+        return nullptr;
+    }
+
+    // @return entry in slot i, or null.
+    Entry* slot( int i ) const
+    {
+        return slots_[ i ].load( std::memory_order_acquire );
+    }
+
+    // Counts a call dropped because the table is full, zeroing the count
+    // first if it is from an older generation, like Entry.
+    void drop( int64_t gen )
+    {
+        if (dropped_generation_.load( std::memory_order_relaxed ) != gen) {
+            dropped_.store( 0, std::memory_order_relaxed );
+            dropped_generation_.store( gen, std::memory_order_release );
+        }
+        add( dropped_, int64_t( 1 ) );
+    }
+
+    // @return calls dropped in generation gen.
+    int64_t dropped( int64_t gen ) const
+    {
+        if (dropped_generation_.load( std::memory_order_acquire ) != gen)
+            return 0;
+        return dropped_.load( std::memory_order_relaxed );
+    }
+
+private:
+    std::atomic< Entry* > slots_[ num_slots ];
+    std::atomic< int64_t > dropped_;
+    std::atomic< int64_t > dropped_generation_;
+};
+
+//------------------------------------------------------------------------------
+// Counters of one routine and precision, summed over threads.
+struct Summary {
+    std::string name;
+    int64_t count;
+    double time, min_time, max_time, gflop;
+    int64_t m_hist[ num_buckets ];
+    int64_t n_hist[ num_buckets ];
+};
+
+//------------------------------------------------------------------------------
+// Adds counters of the current generation gen in stats to summaries.
+// @return calls stats dropped in generation gen.
+static int64_t accumulate(
+    std::vector< Summary >& summaries, ThreadStats const& stats, int64_t gen )
+{
+    for (int i = 0; i < ThreadStats::num_slots; ++i) {
+        Entry* entry = stats.slot( i );
+        if (entry == nullptr
+            || entry->generation.load( std::memory_order_acquire ) != gen)
+            continue;
+
+        std::string name = entry->precision + std::string( entry->name );
+        auto iter = std::find_if(
+            summaries.begin(), summaries.end(),
+            [&name] (Summary const& s) { return s.name == name; });
+        if (iter == summaries.end()) {
+            Summary s;
+            s.name = name;
+            s.count = 0;
+            s.time = 0;
+            s.min_time = std::numeric_limits<double>::infinity();
+            s.max_time = 0;
+            s.gflop = 0;
+            std::fill( s.m_hist, s.m_hist + num_buckets, 0 );
+            std::fill( s.n_hist, s.n_hist + num_buckets, 0 );
+            summaries.push_back( s );
+            iter = summaries.end() - 1;
+        }
+        const auto relaxed = std::memory_order_relaxed;
+        iter->count += entry->count.load( relaxed );
+        iter->time  += entry->time.load( relaxed );
+        iter->gflop += entry->gflop.load( relaxed );
+        iter->min_time = std::min( iter->min_time, entry->min_time.load( relaxed ) );
+        iter->max_time = std::max( iter->max_time, entry->max_time.load( relaxed ) );
+        for (int b = 0; b < num_buckets; ++b) {
+            iter->m_hist[ b ] += entry->m_hist[ b ].load( relaxed );
+            iter->n_hist[ b ] += entry->n_hist[ b ].load( relaxed );
+        }
+    }
+    return stats.dropped( gen );
+}
+
+//------------------------------------------------------------------------------
+// Tables of running threads, registered on their first call. When a
+// thread exits, its counters fold into retired and its table is deleted,
+// so the registry doesn't grow with short-lived threads. retired holds
+// counters of retired_generation only; reset makes them stale.
+static std::mutex registry_mutex;
+static std::vector< ThreadStats* > registry;
+static std::vector< Summary > retired;
+static int64_t retired_dropped = 0;
+static int64_t retired_generation = -1;
+
+// This thread's table. The pointer is trivially destructible, so it
+// stays valid to test after the thread's ThreadExit is destroyed.
+static thread_local ThreadStats* thread_stats_ = nullptr;
+static thread_local bool thread_exited = false;
+
+//------------------------------------------------------------------------------
+// Folds this thread's counters into retired and deletes its table.
+static void retire_thread()
+{
+    std::lock_guard< std::mutex > lock( registry_mutex );
+    ThreadStats* stats = thread_stats_;
+    registry.erase( std::find( registry.begin(), registry.end(), stats ) );
+
+    int64_t gen = generation.load( std::memory_order_acquire );
+    if (retired_generation != gen) {
+        retired.clear();
+        retired_dropped = 0;
+        retired_generation = gen;
+    }
+    retired_dropped += accumulate( retired, *stats, gen );
+
+    delete stats;
+    thread_stats_ = nullptr;
+    thread_exited = true;
+}
+
+//------------------------------------------------------------------------------
+// Retires the thread's table when the thread exits.
+struct ThreadExit {
+    ~ThreadExit()
+    {
+        retire_thread();
+    }
+};
+
+//------------------------------------------------------------------------------
+// @return this thread's table, registering it on first use.
+// A thread that calls routines after its thread_local objects were
+// destroyed, e.g., from a static destructor, keeps its table registered.
+static ThreadStats& thread_stats()
+{
+    if (thread_stats_ == nullptr) {
+        {
+            std::lock_guard< std::mutex > lock( registry_mutex );
+            thread_stats_ = new ThreadStats();
+            registry.push_back( thread_stats_ );
+        }
+        if (! thread_exited) {
+            thread_local ThreadExit thread_exit;
+            (void) thread_exit;
+        }
+    }
+    return *thread_stats_;
+}
+
+//------------------------------------------------------------------------------
+void record(
+    char const* name, char precision,
+    int64_t m, int64_t n,
+    double time, double gflop )
+{
+    ThreadStats& stats = thread_stats();
+    int64_t gen = generation.load( std::memory_order_acquire );
+    Entry* entry = stats.find( name, precision );
+    if (entry == nullptr) {
+        stats.drop( gen );
+        return;
+    }
+
+    if (entry->generation.load( std::memory_order_relaxed ) != gen)
+        entry->zero( gen );
+
+    add( entry->count, int64_t( 1 ) );
+    add( entry->time, time );
+    add( entry->gflop, gflop );
+    if (time < entry->min_time.load( std::memory_order_relaxed ))
+        entry->min_time.store( time, std::memory_order_relaxed );
+    if (time > entry->max_time.load( std::memory_order_relaxed ))
+        entry->max_time.store( time, std::memory_order_relaxed );
+    if (m >= 0)
+        add( entry->m_hist[ bucket( m ) ], int64_t( 1 ) );
+    if (n >= 0)
+        add( entry->n_hist[ bucket( n ) ], int64_t( 1 ) );
+}
+
+//------------------------------------------------------------------------------
+// @return summaries of the current window, sorted by total time, descending.
+// Sets dropped to the number of calls not counted because a thread's
+// table was full.
+static std::vector< Summary > summarize( int64_t* dropped )
+{
+    std::vector< Summary > summaries;
+    int64_t gen = generation.load( std::memory_order_acquire );
+    *dropped = 0;
+
+    std::lock_guard< std::mutex > lock( registry_mutex );
+    if (retired_generation == gen) {
+        summaries = retired;
+        *dropped = retired_dropped;
+    }
+    for (auto stats : registry)
+        *dropped += accumulate( summaries, *stats, gen );
+
+    summaries.erase(
+        std::remove_if( summaries.begin(), summaries.end(),
+                        [] (Summary const& s) { return s.count == 0; }),
+        summaries.end() );
+    std::sort( summaries.begin(), summaries.end(),
+               [] (Summary const& a, Summary const& b) {
+                   return a.time > b.time;
+               });
+    return summaries;
+}
+
+//------------------------------------------------------------------------------
+// @return lower bound of sizes in bucket b.
+static long long bucket_lower( int b )
+{
+    return (b == 0 ? 0 : 1LL << (b - 1));
+}
+
+//------------------------------------------------------------------------------
+// Prints non-empty buckets of hist, as "lower-upper:count" in a table,
+// or "lower":count in JSON.
+static void print_hist(
+    FILE* stream, Format format, char const* label, int64_t const* hist )
+{
+    typedef long long lld;
+
+    if (format == Format::Table) {
+        bool empty = true;
+        for (int b = 0; b < num_buckets; ++b) {
+            if (hist[ b ] == 0)
+                continue;
+            if (empty)
+                fprintf( stream, "    %s sizes:", label );
+            empty = false;
+            if (b == 0)
+                fprintf( stream, " 0:%lld", (lld) hist[ b ] );
+            else if (b == num_buckets - 1)
+                fprintf( stream, " %lld+:%lld",
+                         bucket_lower( b ), (lld) hist[ b ] );
+            else
+                fprintf( stream, " %lld-%lld:%lld",
+                         bucket_lower( b ), bucket_lower( b + 1 ) - 1,
+                         (lld) hist[ b ] );
+        }
+        if (! empty)
+            fprintf( stream, "\n" );
+    }
+    else {
+        fprintf( stream, ",\"%s_hist\":{", label );
+        const char* sep = "";
+        for (int b = 0; b < num_buckets; ++b) {
+            if (hist[ b ] == 0)
+                continue;
+            fprintf( stream, "%s\"%lld\":%lld",
+                     sep, bucket_lower( b ), (lld) hist[ b ] );
+            sep = ",";
+        }
+        fprintf( stream, "}" );
+    }
+}
+
+}  // namespace internal
+
+using internal::Summary;
+
+//------------------------------------------------------------------------------
+void on()
+{
+    internal::enabled.store( true );
+}
+
+//------------------------------------------------------------------------------
+void off()
+{
+    internal::enabled.store( false );
+}
+
+//------------------------------------------------------------------------------
+void reset()
+{
+    internal::generation.fetch_add( 1 );
+}
+
+//------------------------------------------------------------------------------
+void dump( Format format, FILE* stream )
+{
+    typedef long long lld;
+
+    int64_t dropped;
+    std::vector< Summary > summaries = internal::summarize( &dropped );
+
+    if (format == Format::Table) {
+        fprintf( stream, "%-10s %10s %12s %12s %12s %12s %12s %10s\n",
+                 "routine", "calls", "time (s)", "avg (ms)", "min (ms)",
+                 "max (ms)", "Gflop", "Gflop/s" );
+        for (auto& s : summaries) {
+            fprintf( stream, "%-10s %10lld %12.6f %12.6f %12.6f %12.6f %12.4g %10.4g\n",
+                     s.name.c_str(), (lld) s.count, s.time,
+                     s.time / s.count * 1e3, s.min_time * 1e3, s.max_time * 1e3,
+                     s.gflop, (s.time > 0 ? s.gflop / s.time : 0) );
+            internal::print_hist( stream, format, "m", s.m_hist );
+            internal::print_hist( stream, format, "n", s.n_hist );
+        }
+        if (dropped > 0) {
+            fprintf( stream, "%lld calls dropped: more than %d routines "
+                     "in a thread\n",
+                     (lld) dropped, internal::ThreadStats::num_slots );
+        }
+    }
+    else {
+        fprintf( stream, "{\"stats\":[" );
+        for (size_t i = 0; i < summaries.size(); ++i) {
+            Summary const& s = summaries[ i ];
+            fprintf( stream,
+                     "%s\n{\"routine\":\"%s\",\"calls\":%lld,\"time\":%.9g,"
+                     "\"min_time\":%.9g,\"max_time\":%.9g,"
+                     "\"gflop\":%.9g,\"gflops\":%.9g",
+                     (i > 0 ? "," : ""), s.name.c_str(), (lld) s.count, s.time,
+                     s.min_time, s.max_time,
+                     s.gflop, (s.time > 0 ? s.gflop / s.time : 0) );
+            internal::print_hist( stream, format, "m", s.m_hist );
+            internal::print_hist( stream, format, "n", s.n_hist );
+            fprintf( stream, "}" );
+        }
+        fprintf( stream, "\n],\"dropped\":%lld}\n", (lld) dropped );
+    }
+    fflush( stream );
+}
+
+//------------------------------------------------------------------------------
+// Reads $LAPACKPP_STATS at startup: off turns statistics off; table or
+// json dumps them to stderr at exit. Defined after the registry, so it is
+// destroyed before the registry.
+class EnvStats
+{
+public:
+    EnvStats():
+        dump_( false ),
+        format_( Format::Table )
+    {
+        const char* env = std::getenv( "LAPACKPP_STATS" );
+        if (env == nullptr)
+            return;
+        std::string value( env );
+        if (value == "off" || value == "0") {
+            off();
+        }
+        else if (value == "table") {
+            dump_ = true;
+        }
+        else if (value == "json") {
+            dump_ = true;
+            format_ = Format::JSON;
+        }
+    }
+
+    ~EnvStats()
+    {
+        if (dump_)
+            dump( format_, stderr );
+    }
+
+private:
+    bool dump_;
+    Format format_;
+};
+
+static EnvStats env_stats;
+
+}  // namespace stats
+}  // namespace lapack
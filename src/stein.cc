@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,18 +33,23 @@ int64_t stein(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stein", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
+        lapack::small_vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
         lapack_int const* iblock_ptr = &iblock_[0];
     #else
         lapack_int const* iblock_ptr = iblock;
     #endif
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
+        lapack::small_vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
         lapack_int const* isplit_ptr = &isplit_[0];
     #else
         lapack_int const* isplit_ptr = isplit;
@@ -51,7 +57,7 @@ int64_t stein(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (m) );
+        lapack::small_vector< lapack_int > ifail_( (m) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -59,8 +65,8 @@ int64_t stein(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (5*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (5*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_sstein(
         &n_,
@@ -99,18 +105,23 @@ int64_t stein(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stein", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
+        lapack::small_vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
         lapack_int const* iblock_ptr = &iblock_[0];
     #else
         lapack_int const* iblock_ptr = iblock;
     #endif
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
+        lapack::small_vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
         lapack_int const* isplit_ptr = &isplit_[0];
     #else
         lapack_int const* isplit_ptr = isplit;
@@ -118,7 +129,7 @@ int64_t stein(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (m) );
+        lapack::small_vector< lapack_int > ifail_( (m) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -126,8 +137,8 @@ int64_t stein(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (5*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (5*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dstein(
         &n_,
@@ -166,18 +177,23 @@ int64_t stein(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stein", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
+        lapack::small_vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
         lapack_int const* iblock_ptr = &iblock_[0];
     #else
         lapack_int const* iblock_ptr = iblock;
     #endif
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
+        lapack::small_vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
         lapack_int const* isplit_ptr = &isplit_[0];
     #else
         lapack_int const* isplit_ptr = isplit;
@@ -185,7 +201,7 @@ int64_t stein(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (m) );
+        lapack::small_vector< lapack_int > ifail_( (m) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -193,8 +209,8 @@ int64_t stein(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (5*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (5*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_cstein(
         &n_,
@@ -233,18 +249,23 @@ int64_t stein(
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stein", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int n_ = (lapack_int) n;
     lapack_int m_ = (lapack_int) m;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
+        lapack::small_vector< lapack_int > iblock_( &iblock[0], &iblock[(n)] );
         lapack_int const* iblock_ptr = &iblock_[0];
     #else
         lapack_int const* iblock_ptr = iblock;
     #endif
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        std::vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
+        lapack::small_vector< lapack_int > isplit_( &isplit[0], &isplit[(n)] );
         lapack_int const* isplit_ptr = &isplit_[0];
     #else
         lapack_int const* isplit_ptr = isplit;
@@ -252,7 +273,7 @@ int64_t stein(
     lapack_int ldz_ = (lapack_int) ldz;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > ifail_( (m) );
+        lapack::small_vector< lapack_int > ifail_( (m) );
         lapack_int* ifail_ptr = &ifail_[0];
     #else
         lapack_int* ifail_ptr = ifail;
@@ -260,8 +281,8 @@ int64_t stein(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (5*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (5*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_zstein(
         &n_,
@@ -283,4 +304,325 @@ int64_t stein(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_stein(
+    lapack_int n,
+    float const* D,
+    float const* E, lapack_int m,
+    float const* W,
+    lapack_int const* iblock,
+    lapack_int const* isplit,
+    float* Z, lapack_int ldz,
+    float* work,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_sstein(
+        &n,
+        D,
+        E, &m,
+        W,
+        iblock,
+        isplit,
+        Z, &ldz,
+        work,
+        iwork,
+        ifail, info );
+}
+
+//----------
+static void fortran_stein(
+    lapack_int n,
+    double const* D,
+    double const* E, lapack_int m,
+    double const* W,
+    lapack_int const* iblock,
+    lapack_int const* isplit,
+    double* Z, lapack_int ldz,
+    double* work,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_dstein(
+        &n,
+        D,
+        E, &m,
+        W,
+        iblock,
+        isplit,
+        Z, &ldz,
+        work,
+        iwork,
+        ifail, info );
+}
+
+//----------
+static void fortran_stein(
+    lapack_int n,
+    float const* D,
+    float const* E, lapack_int m,
+    float const* W,
+    lapack_int const* iblock,
+    lapack_int const* isplit,
+    std::complex<float>* Z, lapack_int ldz,
+    float* work,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_cstein(
+        &n,
+        D,
+        E, &m,
+        W,
+        iblock,
+        isplit,
+        (lapack_complex_float*) Z, &ldz,
+        work,
+        iwork,
+        ifail, info );
+}
+
+//----------
+static void fortran_stein(
+    lapack_int n,
+    double const* D,
+    double const* E, lapack_int m,
+    double const* W,
+    lapack_int const* iblock,
+    lapack_int const* isplit,
+    std::complex<double>* Z, lapack_int ldz,
+    double* work,
+    lapack_int* iwork,
+    lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_zstein(
+        &n,
+        D,
+        E, &m,
+        W,
+        iblock,
+        isplit,
+        (lapack_complex_double*) Z, &ldz,
+        work,
+        iwork,
+        ifail, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by stein with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void stein_work_size_bytes(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    blas::real_type<scalar_t> const* E, int64_t m,
+    blas::real_type<scalar_t> const* W,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( n );
+    #endif
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( m );
+    #endif
+    buffer.take< real_t >( 5*n );
+    buffer.take< lapack_int >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::stein, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::stein for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     stein_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t stein(
+    int64_t n,
+    blas::real_type<scalar_t> const* D,
+    blas::real_type<scalar_t> const* E, int64_t m,
+    blas::real_type<scalar_t> const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "stein", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* iblock_ = buffer.take< lapack_int >( n );
+        std::copy( iblock, iblock + n, iblock_ );
+        lapack_int const* iblock_ptr = iblock_;
+    #else
+        lapack_int const* iblock_ptr = iblock;
+    #endif
+    #ifndef LAPACK_ILP64
+        lapack_int* isplit_ = buffer.take< lapack_int >( n );
+        std::copy( isplit, isplit + n, isplit_ );
+        lapack_int const* isplit_ptr = isplit_;
+    #else
+        lapack_int const* isplit_ptr = isplit;
+    #endif
+    #ifndef LAPACK_ILP64
+        lapack_int* ifail_ = buffer.take< lapack_int >( m );
+        lapack_int* ifail_ptr = ifail_;
+    #else
+        lapack_int* ifail_ptr = ifail;
+    #endif
+    real_t* work_ = buffer.take< real_t >( 5*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( n );
+
+    fortran_stein(
+        n_,
+        D,
+        E, m_,
+        W,
+        iblock_ptr,
+        isplit_ptr,
+        Z, ldz_,
+        work_,
+        iwork_,
+        ifail_ptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ifail_, ifail_ + m, ifail );
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stein_work_size_bytes(
+    int64_t n,
+    float const* D,
+    float const* E, int64_t m,
+    float const* W,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void stein_work_size_bytes(
+    int64_t n,
+    double const* D,
+    double const* E, int64_t m,
+    double const* W,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void stein_work_size_bytes(
+    int64_t n,
+    float const* D,
+    float const* E, int64_t m,
+    float const* W,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void stein_work_size_bytes(
+    int64_t n,
+    double const* D,
+    double const* E, int64_t m,
+    double const* W,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t stein(
+    int64_t n,
+    float const* D,
+    float const* E, int64_t m,
+    float const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    float* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+template
+int64_t stein(
+    int64_t n,
+    double const* D,
+    double const* E, int64_t m,
+    double const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    double* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+template
+int64_t stein(
+    int64_t n,
+    float const* D,
+    float const* E, int64_t m,
+    float const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
+template
+int64_t stein(
+    int64_t n,
+    double const* D,
+    double const* E, int64_t m,
+    double const* W,
+    int64_t const* iblock,
+    int64_t const* isplit,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* ifail,
+    void* work, size_t work_size );
+
 }  // namespace lapack
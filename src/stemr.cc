@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -34,6 +35,11 @@ int64_t stemr(
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stemr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     lapack_int n_ = (lapack_int) n;
@@ -44,7 +50,7 @@ int64_t stemr(
     lapack_int nzc_ = (lapack_int) nzc;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -76,8 +82,8 @@ int64_t stemr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_sstemr(
         &jobz_, &range_, &n_,
@@ -122,6 +128,11 @@ int64_t stemr(
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stemr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     lapack_int n_ = (lapack_int) n;
@@ -132,7 +143,7 @@ int64_t stemr(
     lapack_int nzc_ = (lapack_int) nzc;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -164,8 +175,8 @@ int64_t stemr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_dstemr(
         &jobz_, &range_, &n_,
@@ -210,6 +221,11 @@ int64_t stemr(
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stemr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     lapack_int n_ = (lapack_int) n;
@@ -220,7 +236,7 @@ int64_t stemr(
     lapack_int nzc_ = (lapack_int) nzc;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -252,8 +268,8 @@ int64_t stemr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_cstemr(
         &jobz_, &range_, &n_,
@@ -298,6 +314,11 @@ int64_t stemr(
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stemr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     char range_ = range2char( range );
     lapack_int n_ = (lapack_int) n;
@@ -308,7 +329,7 @@ int64_t stemr(
     lapack_int nzc_ = (lapack_int) nzc;
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
+        lapack::small_vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was m; n >= m
         lapack_int* isuppz_ptr = &isuppz_[0];
     #else
         lapack_int* isuppz_ptr = isuppz;
@@ -340,8 +361,8 @@ int64_t stemr(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_zstemr(
         &jobz_, &range_, &n_,
@@ -367,4 +388,373 @@ int64_t stemr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_stemr(
+    char jobz, char range, lapack_int n,
+    float* D,
+    float* E, float vl, float vu, lapack_int il, lapack_int iu, lapack_int* m,
+    float* W,
+    float* Z, lapack_int ldz, lapack_int nzc,
+    lapack_int* isuppz, lapack_int* tryrac,
+    float* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_sstemr(
+        &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, m,
+        W,
+        Z, &ldz, &nzc,
+        isuppz, tryrac,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_stemr(
+    char jobz, char range, lapack_int n,
+    double* D,
+    double* E, double vl, double vu, lapack_int il, lapack_int iu, lapack_int* m,
+    double* W,
+    double* Z, lapack_int ldz, lapack_int nzc,
+    lapack_int* isuppz, lapack_int* tryrac,
+    double* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_dstemr(
+        &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, m,
+        W,
+        Z, &ldz, &nzc,
+        isuppz, tryrac,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_stemr(
+    char jobz, char range, lapack_int n,
+    float* D,
+    float* E, float vl, float vu, lapack_int il, lapack_int iu, lapack_int* m,
+    float* W,
+    std::complex<float>* Z, lapack_int ldz, lapack_int nzc,
+    lapack_int* isuppz, lapack_int* tryrac,
+    float* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_cstemr(
+        &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, m,
+        W,
+        (lapack_complex_float*) Z, &ldz, &nzc,
+        isuppz, tryrac,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_stemr(
+    char jobz, char range, lapack_int n,
+    double* D,
+    double* E, double vl, double vu, lapack_int il, lapack_int iu, lapack_int* m,
+    double* W,
+    std::complex<double>* Z, lapack_int ldz, lapack_int nzc,
+    lapack_int* isuppz, lapack_int* tryrac,
+    double* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_zstemr(
+        &jobz, &range, &n,
+        D,
+        E, &vl, &vu, &il, &iu, m,
+        W,
+        (lapack_complex_double*) Z, &ldz, &nzc,
+        isuppz, tryrac,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by stemr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int m_ = 0;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nzc_ = (lapack_int) nzc;
+    lapack_int tryrac_ = 0;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    real_t qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_stemr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il_, iu_, &m_,
+        W,
+        Z, ldz_, nzc_,
+        nullptr, &tryrac_,
+        qry_work, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    internal::WorkBuffer buffer;
+    #ifndef LAPACK_ILP64
+        buffer.take< lapack_int >( 2*max( 1, n ) );
+    #endif
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< real_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::stemr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::stemr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     stemr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E, blas::real_type<scalar_t> vl,
+    blas::real_type<scalar_t> vu, int64_t il, int64_t iu,
+    int64_t* m,
+    blas::real_type<scalar_t>* W,
+    scalar_t* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nzc) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "stemr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nzc_ = (lapack_int) nzc;
+    lapack_int tryrac_ = (lapack_int) *tryrac;
+    lapack_int info_ = 0;
+
+    // query for size of iwork
+    real_t qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    fortran_stemr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il_, iu_, &m_,
+        W,
+        Z, ldz_, nzc_,
+        nullptr, &tryrac_,
+        qry_work, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int liwork_ = max( 1, qry_iwork[0] );
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    #ifndef LAPACK_ILP64
+        lapack_int* isuppz_ = buffer.take< lapack_int >( 2*max( 1, n ) );
+        lapack_int* isuppz_ptr = isuppz_;
+    #else
+        lapack_int* isuppz_ptr = isuppz;
+    #endif
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< real_t >();
+    real_t* work_ = buffer.take< real_t >( lwork_ );
+
+    fortran_stemr(
+        jobz_, range_, n_,
+        D,
+        E, vl, vu, il_, iu_, &m_,
+        W,
+        Z, ldz_, nzc_,
+        isuppz_ptr, &tryrac_,
+        work_, lwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    *tryrac = tryrac_;
+    #ifndef LAPACK_ILP64
+        std::copy( &isuppz_[0], &isuppz_[m_], isuppz );  // was begin to end
+    #endif
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float* D,
+    float* E, float vl,
+    float vu, int64_t il, int64_t iu,
+    float* W,
+    float* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size );
+
+template
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double* D,
+    double* E, double vl,
+    double vu, int64_t il, int64_t iu,
+    double* W,
+    double* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size );
+
+template
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float* D,
+    float* E, float vl,
+    float vu, int64_t il, int64_t iu,
+    float* W,
+    std::complex<float>* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size );
+
+template
+void stemr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double* D,
+    double* E, double vl,
+    double vu, int64_t il, int64_t iu,
+    double* W,
+    std::complex<double>* Z, int64_t ldz, int64_t nzc,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float* D,
+    float* E, float vl,
+    float vu, int64_t il, int64_t iu,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size );
+
+template
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double* D,
+    double* E, double vl,
+    double vu, int64_t il, int64_t iu,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size );
+
+template
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float* D,
+    float* E, float vl,
+    float vu, int64_t il, int64_t iu,
+    int64_t* m,
+    float* W,
+    std::complex<float>* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size );
+
+template
+int64_t stemr(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double* D,
+    double* E, double vl,
+    double vu, int64_t il, int64_t iu,
+    int64_t* m,
+    double* W,
+    std::complex<double>* Z, int64_t ldz, int64_t nzc,
+    int64_t* isuppz,
+    bool* tryrac,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,13 +28,18 @@ int64_t steqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "steqr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< float > work( (max( 1, 2*n-2 )) );
 
     LAPACK_ssteqr(
         &compz_, &n_,
@@ -63,13 +69,18 @@ int64_t steqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "steqr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< double > work( (max( 1, 2*n-2 )) );
 
     LAPACK_dsteqr(
         &compz_, &n_,
@@ -99,13 +110,18 @@ int64_t steqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "steqr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< float > work( (max( 1, 2*n-2 )) );
 
     LAPACK_csteqr(
         &compz_, &n_,
@@ -135,13 +151,18 @@ int64_t steqr(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "steqr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char compz_ = job_comp2char( compz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< double > work( (max( 1, 2*n-2 )) );
 
     LAPACK_zsteqr(
         &compz_, &n_,
@@ -159,4 +180,235 @@ int64_t steqr(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_steqr(
+    char compz, lapack_int n,
+    float* D,
+    float* E,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_ssteqr(
+        &compz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_steqr(
+    char compz, lapack_int n,
+    double* D,
+    double* E,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_dsteqr(
+        &compz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_steqr(
+    char compz, lapack_int n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_csteqr(
+        &compz, &n,
+        D,
+        E,
+        (lapack_complex_float*) Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_steqr(
+    char compz, lapack_int n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_zsteqr(
+        &compz, &n,
+        D,
+        E,
+        (lapack_complex_double*) Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by steqr with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< real_t >( max( 1, 2*n-2 ) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::steqr, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::steqr for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     steqr_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    blas::real_type<scalar_t>* D,
+    blas::real_type<scalar_t>* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "steqr", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char compz_ = job_comp2char( compz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    real_t* work_ = buffer.take< real_t >( max( 1, 2*n-2 ) );
+
+    fortran_steqr(
+        compz_, n_,
+        D,
+        E,
+        Z, ldz_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void steqr_work_size_bytes(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t steqr(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -27,13 +28,18 @@ int64_t stev(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stev", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< float > work( (max( 1, 2*n-2 )) );
 
     LAPACK_sstev(
         &jobz_, &n_,
@@ -63,13 +69,18 @@ int64_t stev(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "stev", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char jobz_ = job2char( jobz );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldz_ = (lapack_int) ldz;
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (max( 1, 2*n-2 )) );
+    lapack::small_vector< double > work( (max( 1, 2*n-2 )) );
 
     LAPACK_dstev(
         &jobz_, &n_,
@@ -87,4 +98,159 @@ int64_t stev(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_stev(
+    char jobz, lapack_int n,
+    float* D,
+    float* E,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int* info )
+{
+    LAPACK_sstev(
+        &jobz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_stev(
+    char jobz, lapack_int n,
+    double* D,
+    double* E,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int* info )
+{
+    LAPACK_dstev(
+        &jobz, &n,
+        D,
+        E,
+        Z, &ldz,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by stev with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void stev_work_size_bytes(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( max( 1, 2*n-2 ) );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::stev, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::stev for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     stev_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t stev(
+    lapack::Job jobz, int64_t n,
+    scalar_t* D,
+    scalar_t* E,
+    scalar_t* Z, int64_t ldz,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "stev", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char jobz_ = job2char( jobz );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( max( 1, 2*n-2 ) );
+
+    fortran_stev(
+        jobz_, n_,
+        D,
+        E,
+        Z, ldz_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stev_work_size_bytes(
+    lapack::Job jobz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    size_t* work_size );
+
+template
+void stev_work_size_bytes(
+    lapack::Job jobz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t stev(
+    lapack::Job jobz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    void* work, size_t work_size );
+
+template
+int64_t stev(
+    lapack::Job jobz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    void* work, size_t work_size );
+
 }  // namespace lapack
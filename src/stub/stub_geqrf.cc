@@ -8,6 +8,7 @@
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
 
 #include "lapack/device.hh"
+#include "lapack.hh"
 
 //==============================================================================
 namespace lapack {
@@ -22,13 +23,14 @@ void geqrf_work_size_bytes(
     size_t* dev_work_size, size_t* host_work_size,
     lapack::Queue& queue )
 {
-    *dev_work_size  = 0;
+    // LAPACK's workspace is in dev_work, which is host memory.
+    lapack::geqrf_work_size_bytes( m, n, dA, ldda, dA, dev_work_size );
     *host_work_size = 0;
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Host device: enqueues LAPACK geqrf on the queue's worker thread.
+// This is async. Once finished, the return info is in dev_info.
 template <typename scalar_t>
 void geqrf(
     int64_t m, int64_t n,
@@ -37,7 +39,19 @@ void geqrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+
+    size_t dev_size, host_size;
+    geqrf_work_size_bytes( m, n, dA, ldda, &dev_size, &host_size, queue );
+    lapack_error_if( dev_work_size < dev_size );
+    lapack_error_if( host_work_size < host_size );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::geqrf( m, n, dA, ldda, dtau,
+                                   dev_work, dev_work_size );
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+
+#include "lapack/device.hh"
+#include "lapack.hh"
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Wrapper around workspace query.
+// LAPACK's workspace is in dev_work, which is host memory.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    blas::real_type<scalar_t>* S = nullptr;
+    scalar_t* U  = nullptr;
+    scalar_t* VT = nullptr;
+    lapack::gesvd_work_size_bytes(
+        jobu, jobvt, m, n, dA, blas::max( 1, m ), S,
+        U, blas::max( 1, m ), VT, blas::max( 1, n ), dev_work_size );
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Host device: enqueues LAPACK gesvd on the queue's worker thread.
+// This is async. Once finished, the return info is in dev_info.
+template <typename scalar_t>
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, blas::real_type<scalar_t>* dS,
+    scalar_t* dU, int64_t lddu,
+    scalar_t* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    lapack_error_if( jobu  != Job::AllVec && jobu  != Job::SomeVec &&
+                     jobu  != Job::OverwriteVec && jobu  != Job::NoVec );
+    lapack_error_if( jobvt != Job::AllVec && jobvt != Job::SomeVec &&
+                     jobvt != Job::OverwriteVec && jobvt != Job::NoVec );
+    lapack_error_if( jobu == Job::OverwriteVec && jobvt == Job::OverwriteVec );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+    bool wantu  = (jobu  == Job::AllVec || jobu  == Job::SomeVec);
+    int64_t nvt = (jobvt == Job::AllVec ? n : blas::min( m, n ));
+    bool wantvt = (jobvt == Job::AllVec || jobvt == Job::SomeVec);
+    lapack_error_if( lddu  < 1 || (wantu  && lddu  < m) );
+    lapack_error_if( lddvt < 1 || (wantvt && lddvt < nvt) );
+
+    size_t dev_size, host_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, dA, ldda,
+                           &dev_size, &host_size, queue );
+    lapack_error_if( dev_work_size < dev_size );
+    lapack_error_if( host_work_size < host_size );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::gesvd( jobu, jobvt, m, n, dA, ldda, dS,
+                                   dU, lddu, dVT, lddvt,
+                                   dev_work, dev_work_size );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* dA, int64_t ldda, float* dS,
+    float* dU, int64_t lddu,
+    float* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* dA, int64_t ldda, double* dS,
+    double* dU, int64_t lddu,
+    double* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda, float* dS,
+    std::complex<float>* dU, int64_t lddu,
+    std::complex<float>* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda, double* dS,
+    std::complex<double>* dU, int64_t lddu,
+    std::complex<double>* dVT, int64_t lddvt,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_ONEMKL)
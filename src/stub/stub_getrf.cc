@@ -8,6 +8,9 @@
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
 
 #include "lapack/device.hh"
+#include "lapack.hh"
+
+#include <type_traits>
 
 //==============================================================================
 namespace lapack {
@@ -22,13 +25,18 @@ void getrf_work_size_bytes(
     size_t* dev_work_size, size_t* host_work_size,
     lapack::Queue& queue )
 {
-    *dev_work_size  = 0;
+    // LAPACK's pivots are computed in dev_work if their type differs
+    // from device_pivot_int, then converted.
+    if (std::is_same< pivot_t, device_pivot_int >::value)
+        *dev_work_size = 0;
+    else
+        *dev_work_size = blas::max( 0, blas::min( m, n ) ) * sizeof(pivot_t);
     *host_work_size = 0;
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Host device: enqueues LAPACK getrf on the queue's worker thread.
+// This is async. Once finished, the return info is in dev_info.
 template <typename scalar_t>
 void getrf(
     int64_t m, int64_t n,
@@ -37,7 +45,25 @@ void getrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+
+    size_t dev_size, host_size;
+    getrf_work_size_bytes( m, n, dA, ldda, &dev_size, &host_size, queue );
+    lapack_error_if( dev_work_size < dev_size );
+    lapack_error_if( host_work_size < host_size );
+
+    queue.enqueue( [=]() {
+        bool same = std::is_same< pivot_t, device_pivot_int >::value;
+        pivot_t* ipiv = same ? (pivot_t*) dipiv : (pivot_t*) dev_work;
+        int64_t info = lapack::getrf( m, n, dA, ldda, ipiv );
+        if (! same) {
+            for (int64_t i = 0; i < blas::min( m, n ); ++i)
+                dipiv[ i ] = ipiv[ i ];
+        }
+        *dev_info = info;
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+
+#include "lapack/device.hh"
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+void Queue::enqueue( std::function< void () > task )
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    tasks_.push_back( std::move( task ) );
+    if (! worker_.joinable())
+        worker_ = std::thread( &Queue::host_run, this );
+    cv_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+void Queue::sync()
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    cv_.wait( lock, [this] { return tasks_.empty() && ! busy_; } );
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception( error );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Worker thread: runs tasks in order until host_stop.
+// After a task throws, the rest still run, as later tasks (e.g., copies
+// back to the host) are independent; sync reports the first exception.
+void Queue::host_run()
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    while (true) {
+        cv_.wait( lock, [this] { return stop_ || ! tasks_.empty(); } );
+        if (tasks_.empty())
+            break;  // stop_ and drained
+
+        std::function< void () > task = std::move( tasks_.front() );
+        tasks_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        try {
+            task();
+        }
+        catch (...) {
+            lock.lock();
+            if (! error_)
+                error_ = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        busy_ = false;
+        if (tasks_.empty())
+            cv_.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Finishes enqueued tasks and joins the worker thread.
+// Exceptions from tasks are dropped, as destructors can't throw.
+void Queue::host_stop()
+{
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        stop_ = true;
+        cv_.notify_all();
+    }
+    if (worker_.joinable())
+        worker_.join();
+}
+
+} // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_ONEMKL)
@@ -5,7 +5,12 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
+#include "simd.hh"
+#include "sturm_kernels.hh"
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 namespace lapack {
@@ -100,6 +105,10 @@ template <typename scalar_t>
 int64_t sturm(int64_t const n, scalar_t const* diag, scalar_t const* offd,
                scalar_t const u)
 {
+    trace::internal::Block trace_block(
+        "sturm", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
     int64_t i, isneg=0;
     scalar_t s, w, v0, v1, Pm1_0, Pm1_1, phi, upsilon;
     if (n==0) return 0;
@@ -149,6 +158,170 @@ int64_t sturm(int64_t const n, scalar_t const* diag, scalar_t const* offd,
     return isneg;
 }
 
+//------------------------------------------------------------------------------
+// Scaled Sturm counts for one pass of nshifts_per_pass shifts u[ 0 : L-1 ].
+// Each lane runs exactly the scalar recurrence above, with the same
+// operations in the same order, so counts are identical; only the
+// branches become selects. Scaling by s = 1 when no scaling is needed is
+// exact. offd2[ i ] = offd[ i ]^2, precomputed once for all passes.
+// count_t is the same width as scalar_t so counts vectorize with values.
+// Unlike the interleaved kernels, this has no LAPACK_SIMD_CLONES: the
+// clones can round NaN and inf cases (offd^2 overflow) differently than the
+// scalar sturm compiled for the baseline target, which changes counts.
+namespace internal {
+
+template <typename scalar_t>
+constexpr int sturm_lanes()
+{
+    // Two registers of shifts per pass, to hide the latency of the
+    // dependent recurrence.
+    return 2 * simd_width<scalar_t>();
+}
+
+template <typename scalar_t>
+void sturm_pass(
+    int64_t n, scalar_t const* diag, scalar_t const* offd2,
+    scalar_t const* u, int64_t* count )
+{
+    using count_t = typename std::conditional<
+        sizeof(scalar_t) == 4, int32_t, int64_t >::type;
+    constexpr int L = sturm_lanes<scalar_t>();
+
+    const scalar_t phi = ((scalar_t)(((long long) 1)<<34));
+    const scalar_t one = 1.0;
+    const scalar_t upsilon = one/phi;
+
+    scalar_t Pm1_0[ L ], Pm1_1[ L ];
+    count_t isneg[ L ];
+
+    LAPACK_LANES
+    for (int l = 0; l < L; ++l) {
+        Pm1_1[ l ] = one;
+        Pm1_0[ l ] = (diag[ 0 ] - u[ l ]);
+        isneg[ l ] = (Pm1_0[ l ] < 0 ? 1 : 0);
+    }
+    for (int64_t i = 1; i < n; ++i) {
+        scalar_t d  = diag[ i ];
+        scalar_t o2 = offd2[ i-1 ];
+        LAPACK_LANES
+        for (int l = 0; l < L; ++l) {
+            scalar_t v0 = std::abs( Pm1_0[ l ] );
+            scalar_t v1 = std::abs( Pm1_1[ l ] );
+            scalar_t w = (v0 > v1 ? v0 : v1);
+
+            scalar_t s = Pm1_0[ l ];
+            scalar_t p0 = (d - u[ l ])*Pm1_0[ l ] - (o2*Pm1_1[ l ]);
+            scalar_t p1 = s;
+
+            s = (w > phi ? phi/w : (w < upsilon ? upsilon/w : one));
+            p0 *= s;
+            p1 *= s;
+
+            // Same test as the scalar code; with NaN, both are false.
+            count_t n0 = (p0 <  0), n1 = (p1 <  0);
+            count_t z0 = (p0 >= 0), z1 = (p1 >= 0);
+            isneg[ l ] += (n0 & z1) | (z0 & n1);
+            Pm1_0[ l ] = p0;
+            Pm1_1[ l ] = p1;
+        }
+    }
+    for (int l = 0; l < L; ++l)
+        count[ l ] = isneg[ l ];
+}
+
+//------------------------------------------------------------------------------
+// Runs sturm_pass over full blocks of L shifts, then a padded last block.
+template <typename scalar_t>
+void sturm_counts(
+    int64_t n, scalar_t const* diag, scalar_t const* offd2,
+    int64_t nshifts, scalar_t const* u, int64_t* count )
+{
+    constexpr int L = sturm_lanes<scalar_t>();
+    int64_t k = 0;
+    for (; k + L <= nshifts; k += L) {
+        sturm_pass( n, diag, offd2, &u[ k ], &count[ k ] );
+    }
+    if (k < nshifts) {
+        // last partial pass: pad with the last shift, discard its counts
+        scalar_t u_last[ L ];
+        int64_t count_last[ L ];
+        int64_t nlast = nshifts - k;
+        for (int l = 0; l < L; ++l)
+            u_last[ l ] = u[ k + std::min( int64_t( l ), nlast-1 ) ];
+        sturm_pass( n, diag, offd2, u_last, count_last );
+        std::copy( count_last, count_last + nlast, &count[ k ] );
+    }
+}
+
+template
+void sturm_counts(
+    int64_t n, float const* diag, float const* offd2,
+    int64_t nshifts, float const* u, int64_t* count );
+
+template
+void sturm_counts(
+    int64_t n, double const* diag, double const* offd2,
+    int64_t nshifts, double const* u, int64_t* count );
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @ingroup heev_computational
+/// Computes Scaled Sturm Sequence counts for many shifts against the same
+/// real symmetric tridiagonal matrix, as needed by bisection and spectrum
+/// slicing. Equivalent to
+///
+///     for (k = 0; k < nshifts; ++k)
+///         count[ k ] = sturm( n, diag, offd, u[ k ] );
+///
+/// and gives identical counts, but offd[i]^2 is computed once for all
+/// shifts, and each pass over diag and offd evaluates a block of shifts
+/// (32 float or 16 double), one per SIMD lane. Like the single-shift
+/// sturm, this is native code, not a LAPACK call.
+///
+/// @param[in] n
+///     The order of the matrix.
+///
+/// @param[in] diag
+///     The n diagonal elements.
+///
+/// @param[in] offd
+///     The n-1 off-diagonal elements.
+///
+/// @param[in] nshifts
+///     The number of shifts.
+///
+/// @param[in] u
+///     The nshifts shifts (sigma test points).
+///
+/// @param[out] count
+///     On exit, count[ k ] is the number of eigenvalues strictly less
+///     than u[ k ].
+///
+template <typename scalar_t>
+void sturm(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshifts, scalar_t const* u, int64_t* count )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nshifts < 0 );
+
+    trace::internal::Block trace_block(
+        "sturm", trace::internal::precision< scalar_t >(), -1, n, nshifts,
+        []() { return 0.0; } );
+
+    if (n == 0) {
+        std::fill( count, count + nshifts, 0 );
+        return;
+    }
+
+    lapack::small_vector< scalar_t > offd2( std::max( int64_t( 1 ), n-1 ) );
+    for (int64_t i = 0; i < n-1; ++i)
+        offd2[ i ] = offd[ i ]*offd[ i ];
+
+    internal::sturm_counts( n, diag, offd2.data(), nshifts, u, count );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -158,4 +331,14 @@ template
 int64_t sturm<double>(int64_t n, double const* diag, double const* offd,
                        double u);
 
+template
+void sturm<float>(
+    int64_t n, float const* diag, float const* offd,
+    int64_t nshifts, float const* u, int64_t* count );
+
+template
+void sturm<double>(
+    int64_t n, double const* diag, double const* offd,
+    int64_t nshifts, double const* u, int64_t* count );
+
 } // namespace lapack
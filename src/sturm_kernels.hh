@@ -0,0 +1,27 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_STURM_KERNELS_HH
+#define LAPACK_STURM_KERNELS_HH
+
+#include <cstdint>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Multi-shift scaled Sturm counts, as lapack::sturm with nshifts, but taking
+// offd2[ i ] = offd[ i ]^2 precomputed, so callers that evaluate many
+// batches of shifts against the same matrix, such as bisection, square the
+// off-diagonal once. Requires n > 0.
+template <typename scalar_t>
+void sturm_counts(
+    int64_t n, scalar_t const* diag, scalar_t const* offd2,
+    int64_t nshifts, scalar_t const* u, int64_t* count );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_STURM_KERNELS_HH
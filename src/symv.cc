@@ -8,6 +8,7 @@
 
 #include "lapack/fortran.h"
 #include "lapack.hh"
+#include "lapack/flops.hh"
 
 #include <limits>
 
@@ -46,6 +47,10 @@ void symv(
         lapack_error_if( std::abs(incy) > std::numeric_limits<lapack_int>::max() );
     }
 
+    lapack::trace::internal::Block trace_block(
+        "symv", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::symv( n ); } );
+
     lapack_int n_    = (lapack_int) n;
     lapack_int lda_  = (lapack_int) lda;
     lapack_int incx_ = (lapack_int) incx;
@@ -99,6 +104,10 @@ void symv(
         lapack_error_if( std::abs(incy) > std::numeric_limits<lapack_int>::max() );
     }
 
+    lapack::trace::internal::Block trace_block(
+        "symv", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::symv( n ); } );
+
     lapack_int n_    = (lapack_int) n;
     lapack_int lda_  = (lapack_int) lda;
     lapack_int incx_ = (lapack_int) incx;
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack.hh"
+#include "lapack/flops.hh"
 #include "lapack/fortran.h"
 
 // while [cz]syr are in LAPACK, [sd]syr are in BLAS,
@@ -40,6 +41,10 @@ void syr(
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
 
+    lapack::trace::internal::Block trace_block(
+        "syr", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::syr( n ); } );
+
     lapack_int n_    = (lapack_int) n;
     lapack_int lda_  = (lapack_int) lda;
     lapack_int incx_ = (lapack_int) incx;
@@ -86,6 +91,10 @@ void syr(
         lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
     }
 
+    lapack::trace::internal::Block trace_block(
+        "syr", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::syr( n ); } );
+
     lapack_int n_    = (lapack_int) n;
     lapack_int lda_  = (lapack_int) lda;
     lapack_int incx_ = (lapack_int) incx;
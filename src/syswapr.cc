@@ -29,6 +29,11 @@ void syswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "syswapr", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -57,6 +62,11 @@ void syswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "syswapr", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -85,6 +95,11 @@ void syswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "syswapr", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -143,6 +158,11 @@ void syswapr(
         lapack_error_if( std::abs(i1) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(i2) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "syswapr", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -33,6 +34,11 @@ int64_t tbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tbrfs", 's', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
     char diag_ = diag2char( diag );
@@ -45,8 +51,8 @@ int64_t tbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< float > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_stbrfs(
         &uplo_, &trans_, &diag_, &n_, &kd_, &nrhs_,
@@ -85,6 +91,11 @@ int64_t tbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tbrfs", 'd', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
     char diag_ = diag2char( diag );
@@ -97,8 +108,8 @@ int64_t tbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
-    lapack::vector< lapack_int > iwork( (n) );
+    lapack::small_vector< double > work( (3*n) );
+    lapack::small_vector< lapack_int > iwork( (n) );
 
     LAPACK_dtbrfs(
         &uplo_, &trans_, &diag_, &n_, &kd_, &nrhs_,
@@ -137,6 +148,11 @@ int64_t tbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tbrfs", 'c', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
     char diag_ = diag2char( diag );
@@ -149,8 +165,8 @@ int64_t tbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_ctbrfs(
         &uplo_, &trans_, &diag_, &n_, &kd_, &nrhs_,
@@ -189,6 +205,11 @@ int64_t tbrfs(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tbrfs", 'z', -1, n, nrhs,
+        []() { return 0.0; } );
+
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
     char diag_ = diag2char( diag );
@@ -201,8 +222,8 @@ int64_t tbrfs(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_ztbrfs(
         &uplo_, &trans_, &diag_, &n_, &kd_, &nrhs_,
@@ -223,4 +244,315 @@ int64_t tbrfs(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tbrfs(
+    char uplo, char trans, char diag, lapack_int n, lapack_int kd, lapack_int nrhs,
+    float const* AB, lapack_int ldab,
+    float const* B, lapack_int ldb,
+    float const* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    float* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_stbrfs(
+        &uplo, &trans, &diag, &n, &kd, &nrhs,
+        AB, &ldab,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tbrfs(
+    char uplo, char trans, char diag, lapack_int n, lapack_int kd, lapack_int nrhs,
+    double const* AB, lapack_int ldab,
+    double const* B, lapack_int ldb,
+    double const* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    double* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dtbrfs(
+        &uplo, &trans, &diag, &n, &kd, &nrhs,
+        AB, &ldab,
+        B, &ldb,
+        X, &ldx,
+        ferr,
+        berr,
+        work,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tbrfs(
+    char uplo, char trans, char diag, lapack_int n, lapack_int kd, lapack_int nrhs,
+    std::complex<float> const* AB, lapack_int ldab,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float> const* X, lapack_int ldx,
+    float* ferr,
+    float* berr,
+    std::complex<float>* work,
+    lapack_int* iwork,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_ctbrfs(
+        &uplo, &trans, &diag, &n, &kd, &nrhs,
+        (lapack_complex_float const*) AB, &ldab,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float const*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tbrfs(
+    char uplo, char trans, char diag, lapack_int n, lapack_int kd, lapack_int nrhs,
+    std::complex<double> const* AB, lapack_int ldab,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double> const* X, lapack_int ldx,
+    double* ferr,
+    double* berr,
+    std::complex<double>* work,
+    lapack_int* iwork,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_ztbrfs(
+        &uplo, &trans, &diag, &n, &kd, &nrhs,
+        (lapack_complex_double const*) AB, &ldab,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double const*) X, &ldx,
+        ferr,
+        berr,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tbrfs with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tbrfs, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tbrfs for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tbrfs_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    scalar_t const* AB, int64_t ldab,
+    scalar_t const* B, int64_t ldb,
+    scalar_t const* X, int64_t ldx,
+    blas::real_type<scalar_t>* ferr,
+    blas::real_type<scalar_t>* berr,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(kd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldab) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tbrfs", trace::internal::precision< scalar_t >(), -1, n, nrhs,
+        []() { return 0.0; } );
+
+    char uplo_ = uplo2char( uplo );
+    char trans_ = op2char( trans );
+    char diag_ = diag2char( diag );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int kd_ = (lapack_int) kd;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int ldab_ = (lapack_int) ldab;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? 0 : n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_tbrfs(
+        uplo_, trans_, diag_, n_, kd_, nrhs_,
+        AB, ldab_,
+        B, ldb_,
+        X, ldx_,
+        ferr,
+        berr,
+        work_,
+        iwork_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* B, int64_t ldb,
+    float const* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* B, int64_t ldb,
+    double const* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+template
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float> const* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    size_t* work_size );
+
+template
+void tbrfs_work_size_bytes(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double> const* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    float const* B, int64_t ldb,
+    float const* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    double const* B, int64_t ldb,
+    double const* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
+template
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float> const* X, int64_t ldx,
+    float* ferr,
+    float* berr,
+    void* work, size_t work_size );
+
+template
+int64_t tbrfs(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag, int64_t n,
+    int64_t kd, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double> const* X, int64_t ldx,
+    double* ferr,
+    double* berr,
+    void* work, size_t work_size );
+
 }  // namespace lapack
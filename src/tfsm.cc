@@ -26,6 +26,11 @@ void tfsm(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tfsm", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
@@ -57,6 +62,11 @@ void tfsm(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tfsm", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
@@ -88,6 +98,11 @@ void tfsm(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tfsm", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
@@ -120,6 +135,11 @@ void tfsm(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tfsm", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char transr_ = op2char( transr );
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
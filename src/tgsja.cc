@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -40,6 +41,11 @@ int64_t tgsja(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsja", 's', m, n, k,
+        []() { return 0.0; } );
+
     char jobu_ = job_compu2char( jobu );
     char jobv_ = job_comp2char( jobv );
     char jobq_ = job_compq2char( jobq );
@@ -57,7 +63,7 @@ int64_t tgsja(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (2*n) );
+    lapack::small_vector< float > work( (2*n) );
 
     LAPACK_stgsja(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_, &k_, &l_,
@@ -105,6 +111,11 @@ int64_t tgsja(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsja", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char jobu_ = job_compu2char( jobu );
     char jobv_ = job_comp2char( jobv );
     char jobq_ = job_compq2char( jobq );
@@ -122,7 +133,7 @@ int64_t tgsja(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (2*n) );
+    lapack::small_vector< double > work( (2*n) );
 
     LAPACK_dtgsja(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_, &k_, &l_,
@@ -170,6 +181,11 @@ int64_t tgsja(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsja", 'c', m, n, k,
+        []() { return 0.0; } );
+
     char jobu_ = job_compu2char( jobu );
     char jobv_ = job_comp2char( jobv );
     char jobq_ = job_compq2char( jobq );
@@ -187,7 +203,7 @@ int64_t tgsja(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
 
     LAPACK_ctgsja(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_, &k_, &l_,
@@ -235,6 +251,11 @@ int64_t tgsja(
         lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsja", 'z', m, n, k,
+        []() { return 0.0; } );
+
     char jobu_ = job_compu2char( jobu );
     char jobv_ = job_comp2char( jobv );
     char jobq_ = job_compq2char( jobq );
@@ -252,7 +273,7 @@ int64_t tgsja(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
 
     LAPACK_ztgsja(
         &jobu_, &jobv_, &jobq_, &m_, &p_, &n_, &k_, &l_,
@@ -275,4 +296,360 @@ int64_t tgsja(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tgsja(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n, lapack_int k, lapack_int l,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb, float tola, float tolb,
+    float* alpha,
+    float* beta,
+    float* U, lapack_int ldu,
+    float* V, lapack_int ldv,
+    float* Q, lapack_int ldq,
+    float* work, lapack_int* ncycle, lapack_int* info )
+{
+    LAPACK_stgsja(
+        &jobu, &jobv, &jobq, &m, &p, &n, &k, &l,
+        A, &lda,
+        B, &ldb, &tola, &tolb,
+        alpha,
+        beta,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        work, ncycle, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsja(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n, lapack_int k, lapack_int l,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb, double tola, double tolb,
+    double* alpha,
+    double* beta,
+    double* U, lapack_int ldu,
+    double* V, lapack_int ldv,
+    double* Q, lapack_int ldq,
+    double* work, lapack_int* ncycle, lapack_int* info )
+{
+    LAPACK_dtgsja(
+        &jobu, &jobv, &jobq, &m, &p, &n, &k, &l,
+        A, &lda,
+        B, &ldb, &tola, &tolb,
+        alpha,
+        beta,
+        U, &ldu,
+        V, &ldv,
+        Q, &ldq,
+        work, ncycle, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsja(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n, lapack_int k, lapack_int l,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb, float tola, float tolb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, lapack_int ldu,
+    std::complex<float>* V, lapack_int ldv,
+    std::complex<float>* Q, lapack_int ldq,
+    std::complex<float>* work, lapack_int* ncycle, lapack_int* info )
+{
+    LAPACK_ctgsja(
+        &jobu, &jobv, &jobq, &m, &p, &n, &k, &l,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, &tola, &tolb,
+        alpha,
+        beta,
+        (lapack_complex_float*) U, &ldu,
+        (lapack_complex_float*) V, &ldv,
+        (lapack_complex_float*) Q, &ldq,
+        (lapack_complex_float*) work, ncycle, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsja(
+    char jobu, char jobv, char jobq, lapack_int m, lapack_int p, lapack_int n, lapack_int k, lapack_int l,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb, double tola, double tolb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, lapack_int ldu,
+    std::complex<double>* V, lapack_int ldv,
+    std::complex<double>* Q, lapack_int ldq,
+    std::complex<double>* work, lapack_int* ncycle, lapack_int* info )
+{
+    LAPACK_ztgsja(
+        &jobu, &jobv, &jobq, &m, &p, &n, &k, &l,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, &tola, &tolb,
+        alpha,
+        beta,
+        (lapack_complex_double*) U, &ldu,
+        (lapack_complex_double*) V, &ldv,
+        (lapack_complex_double*) Q, &ldq,
+        (lapack_complex_double*) work, ncycle, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tgsja with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( 2*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tgsja, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tgsja for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tgsja_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb, blas::real_type<scalar_t> tola,
+    blas::real_type<scalar_t> tolb,
+    blas::real_type<scalar_t>* alpha,
+    blas::real_type<scalar_t>* beta,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    scalar_t* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(p) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tgsja", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char jobu_ = job_compu2char( jobu );
+    char jobv_ = job_comp2char( jobv );
+    char jobq_ = job_compq2char( jobq );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int p_ = (lapack_int) p;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int l_ = (lapack_int) l;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int ncycle_ = (lapack_int) *ncycle;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( 2*n );
+
+    fortran_tgsja(
+        jobu_, jobv_, jobq_, m_, p_, n_, k_, l_,
+        A, lda_,
+        B, ldb_, tola, tolb,
+        alpha,
+        beta,
+        U, ldu_,
+        V, ldv_,
+        Q, ldq_,
+        work_, &ncycle_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *ncycle = ncycle_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float tola,
+    float tolb,
+    float* alpha,
+    float* beta,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double tola,
+    double tolb,
+    double* alpha,
+    double* beta,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb, float tola,
+    float tolb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void tgsja_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb, double tola,
+    double tolb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    float* A, int64_t lda,
+    float* B, int64_t ldb, float tola,
+    float tolb,
+    float* alpha,
+    float* beta,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    float* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size );
+
+template
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    double* A, int64_t lda,
+    double* B, int64_t ldb, double tola,
+    double tolb,
+    double* alpha,
+    double* beta,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    double* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size );
+
+template
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb, float tola,
+    float tolb,
+    float* alpha,
+    float* beta,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    std::complex<float>* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size );
+
+template
+int64_t tgsja(
+    lapack::Job jobu, lapack::Job jobv, lapack::Job jobq,
+    int64_t m, int64_t p, int64_t n, int64_t k, int64_t l,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb, double tola,
+    double tolb,
+    double* alpha,
+    double* beta,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    std::complex<double>* Q, int64_t ldq,
+    int64_t* ncycle,
+    void* work, size_t work_size );
+
 }  // namespace lapack
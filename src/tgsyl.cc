@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -39,6 +40,11 @@ int64_t tgsyl(
         lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsyl", 's', m, n, -1,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int ijob_ = (lapack_int) ijob;
     lapack_int m_ = (lapack_int) m;
@@ -75,8 +81,8 @@ int64_t tgsyl(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m+n+6) );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m+n+6) );
 
     LAPACK_stgsyl(
         &trans_, &ijob_, &m_, &n_,
@@ -122,6 +128,11 @@ int64_t tgsyl(
         lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsyl", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int ijob_ = (lapack_int) ijob;
     lapack_int m_ = (lapack_int) m;
@@ -158,8 +169,8 @@ int64_t tgsyl(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m+n+6) );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m+n+6) );
 
     LAPACK_dtgsyl(
         &trans_, &ijob_, &m_, &n_,
@@ -205,6 +216,11 @@ int64_t tgsyl(
         lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsyl", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int ijob_ = (lapack_int) ijob;
     lapack_int m_ = (lapack_int) m;
@@ -241,8 +257,8 @@ int64_t tgsyl(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m+n+2) );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m+n+2) );
 
     LAPACK_ctgsyl(
         &trans_, &ijob_, &m_, &n_,
@@ -288,6 +304,11 @@ int64_t tgsyl(
         lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tgsyl", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     char trans_ = op2char( trans );
     lapack_int ijob_ = (lapack_int) ijob;
     lapack_int m_ = (lapack_int) m;
@@ -324,8 +345,8 @@ int64_t tgsyl(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (m+n+2) );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( (m+n+2) );
 
     LAPACK_ztgsyl(
         &trans_, &ijob_, &m_, &n_,
@@ -347,4 +368,364 @@ int64_t tgsyl(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tgsyl(
+    char trans, lapack_int ijob, lapack_int m, lapack_int n,
+    float const* A, lapack_int lda,
+    float const* B, lapack_int ldb,
+    float* C, lapack_int ldc,
+    float const* D, lapack_int ldd,
+    float const* E, lapack_int lde,
+    float* F, lapack_int ldf, float* dif, float* scale,
+    float* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_stgsyl(
+        &trans, &ijob, &m, &n,
+        A, &lda,
+        B, &ldb,
+        C, &ldc,
+        D, &ldd,
+        E, &lde,
+        F, &ldf, dif, scale,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsyl(
+    char trans, lapack_int ijob, lapack_int m, lapack_int n,
+    double const* A, lapack_int lda,
+    double const* B, lapack_int ldb,
+    double* C, lapack_int ldc,
+    double const* D, lapack_int ldd,
+    double const* E, lapack_int lde,
+    double* F, lapack_int ldf, double* dif, double* scale,
+    double* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_dtgsyl(
+        &trans, &ijob, &m, &n,
+        A, &lda,
+        B, &ldb,
+        C, &ldc,
+        D, &ldd,
+        E, &lde,
+        F, &ldf, dif, scale,
+        work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsyl(
+    char trans, lapack_int ijob, lapack_int m, lapack_int n,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float> const* B, lapack_int ldb,
+    std::complex<float>* C, lapack_int ldc,
+    std::complex<float> const* D, lapack_int ldd,
+    std::complex<float> const* E, lapack_int lde,
+    std::complex<float>* F, lapack_int ldf, float* dif, float* scale,
+    std::complex<float>* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_ctgsyl(
+        &trans, &ijob, &m, &n,
+        (lapack_complex_float const*) A, &lda,
+        (lapack_complex_float const*) B, &ldb,
+        (lapack_complex_float*) C, &ldc,
+        (lapack_complex_float const*) D, &ldd,
+        (lapack_complex_float const*) E, &lde,
+        (lapack_complex_float*) F, &ldf, dif, scale,
+        (lapack_complex_float*) work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tgsyl(
+    char trans, lapack_int ijob, lapack_int m, lapack_int n,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double> const* B, lapack_int ldb,
+    std::complex<double>* C, lapack_int ldc,
+    std::complex<double> const* D, lapack_int ldd,
+    std::complex<double> const* E, lapack_int lde,
+    std::complex<double>* F, lapack_int ldf, double* dif, double* scale,
+    std::complex<double>* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int* info )
+{
+    LAPACK_ztgsyl(
+        &trans, &ijob, &m, &n,
+        (lapack_complex_double const*) A, &lda,
+        (lapack_complex_double const*) B, &ldb,
+        (lapack_complex_double*) C, &ldc,
+        (lapack_complex_double const*) D, &ldd,
+        (lapack_complex_double const*) E, &lde,
+        (lapack_complex_double*) F, &ldf, dif, scale,
+        (lapack_complex_double*) work, &lwork,
+        iwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tgsyl with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* C, int64_t ldc,
+    scalar_t const* D, int64_t ldd,
+    scalar_t const* E, int64_t lde,
+    scalar_t* F, int64_t ldf,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(ijob) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int ijob_ = (lapack_int) ijob;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int ldd_ = (lapack_int) ldd;
+    lapack_int lde_ = (lapack_int) lde;
+    lapack_int ldf_ = (lapack_int) ldf;
+    real_t dif_;
+    real_t scale_;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    lapack_int ineg_one = -1;
+    fortran_tgsyl(
+        trans_, ijob_, m_, n_,
+        A, lda_,
+        B, ldb_,
+        C, ldc_,
+        D, ldd_,
+        E, lde_,
+        F, ldf_, &dif_, &scale_,
+        qry_work, ineg_one,
+        nullptr, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? m+n+2 : m+n+6 );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tgsyl, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tgsyl for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tgsyl_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* C, int64_t ldc,
+    scalar_t const* D, int64_t ldd,
+    scalar_t const* E, int64_t lde,
+    scalar_t* F, int64_t ldf,
+    blas::real_type<scalar_t>* dif,
+    blas::real_type<scalar_t>* scale,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(ijob) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldd) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lde) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldf) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tgsyl", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    char trans_ = op2char( trans );
+    lapack_int ijob_ = (lapack_int) ijob;
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int ldd_ = (lapack_int) ldd;
+    lapack_int lde_ = (lapack_int) lde;
+    lapack_int ldf_ = (lapack_int) ldf;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int* iwork_ = buffer.take< lapack_int >( blas::is_complex<scalar_t>::value ? m+n+2 : m+n+6 );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_tgsyl(
+        trans_, ijob_, m_, n_,
+        A, lda_,
+        B, ldb_,
+        C, ldc_,
+        D, ldd_,
+        E, lde_,
+        F, ldf_, dif, scale,
+        work_, lwork_,
+        iwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    float const* A, int64_t lda,
+    float const* B, int64_t ldb,
+    float* C, int64_t ldc,
+    float const* D, int64_t ldd,
+    float const* E, int64_t lde,
+    float* F, int64_t ldf,
+    size_t* work_size );
+
+template
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    double const* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* C, int64_t ldc,
+    double const* D, int64_t ldd,
+    double const* E, int64_t lde,
+    double* F, int64_t ldf,
+    size_t* work_size );
+
+template
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* C, int64_t ldc,
+    std::complex<float> const* D, int64_t ldd,
+    std::complex<float> const* E, int64_t lde,
+    std::complex<float>* F, int64_t ldf,
+    size_t* work_size );
+
+template
+void tgsyl_work_size_bytes(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* C, int64_t ldc,
+    std::complex<double> const* D, int64_t ldd,
+    std::complex<double> const* E, int64_t lde,
+    std::complex<double>* F, int64_t ldf,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    float const* A, int64_t lda,
+    float const* B, int64_t ldb,
+    float* C, int64_t ldc,
+    float const* D, int64_t ldd,
+    float const* E, int64_t lde,
+    float* F, int64_t ldf,
+    float* dif,
+    float* scale,
+    void* work, size_t work_size );
+
+template
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    double const* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* C, int64_t ldc,
+    double const* D, int64_t ldd,
+    double const* E, int64_t lde,
+    double* F, int64_t ldf,
+    double* dif,
+    double* scale,
+    void* work, size_t work_size );
+
+template
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* B, int64_t ldb,
+    std::complex<float>* C, int64_t ldc,
+    std::complex<float> const* D, int64_t ldd,
+    std::complex<float> const* E, int64_t lde,
+    std::complex<float>* F, int64_t ldf,
+    float* dif,
+    float* scale,
+    void* work, size_t work_size );
+
+template
+int64_t tgsyl(
+    lapack::Op trans, int64_t ijob, int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* C, int64_t ldc,
+    std::complex<double> const* D, int64_t ldd,
+    std::complex<double> const* E, int64_t lde,
+    std::complex<double>* F, int64_t ldf,
+    double* dif,
+    double* scale,
+    void* work, size_t work_size );
+
 }  // namespace lapack
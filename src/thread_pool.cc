@@ -0,0 +1,356 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/threads.hh"
+#include "lapack/util.hh"
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined( BLAS_HAVE_MKL )
+    // From mkl_service.h; declared here to avoid depending on MKL headers.
+    extern "C" int MKL_Set_Num_Threads_Local( int nthreads );
+#elif defined( _OPENMP )
+    #include <omp.h>
+#endif
+
+#if defined( BLAS_HAVE_OPENBLAS )
+    // From cblas.h; declared here to avoid depending on OpenBLAS headers.
+    extern "C" void openblas_set_num_threads( int nthreads );
+    extern "C" int openblas_get_num_threads();
+    #if defined( LAPACK_HAVE_OPENBLAS_THREADS_LOCAL )
+        // Since OpenBLAS 0.3.27.
+        extern "C" int openblas_set_num_threads_local( int nthreads );
+    #endif
+#elif defined( BLAS_HAVE_BLIS )
+    // From blis.h, where dim_t is a 64-bit integer.
+    extern "C" void bli_thread_set_num_threads( int64_t nthreads );
+    extern "C" int64_t bli_thread_get_num_threads();
+#endif
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+int set_blas_threads_local( int nthreads )
+{
+    #if defined( BLAS_HAVE_MKL )
+        // Returns previous local setting; 0 means use the global setting.
+        return MKL_Set_Num_Threads_Local( nthreads );
+    #elif defined( BLAS_HAVE_OPENBLAS ) \
+          && defined( LAPACK_HAVE_OPENBLAS_THREADS_LOCAL )
+        // Returns previous local setting.
+        return openblas_set_num_threads_local( nthreads );
+    #elif defined( _OPENMP )
+        int prev = omp_get_max_threads();
+        if (nthreads > 0)
+            omp_set_num_threads( nthreads );
+        return prev;
+    #else
+        return 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+// @return true if $LAPACKPP_BLAS_THREADS_GLOBAL is set to a positive number,
+// allowing set_blas_threads_global. Read once, on first use.
+static bool blas_threads_global_allowed()
+{
+    static const bool allowed = []() {
+        const char* env = std::getenv( "LAPACKPP_BLAS_THREADS_GLOBAL" );
+        return env != nullptr && std::atoi( env ) > 0;
+    }();
+    return allowed;
+}
+
+//------------------------------------------------------------------------------
+// Sets the number of BLAS threads for the whole process, for libraries
+// without a per-thread setting (OpenBLAS before 0.3.27, BLIS).
+// These libraries don't support changing it while other threads are in
+// BLAS calls, so this does nothing unless the application opts in via
+// $LAPACKPP_BLAS_THREADS_GLOBAL, promising that no other thread calls
+// BLAS while a LAPACK++ parallel loop runs.
+// @return previous setting, or 0 if not changed.
+static int set_blas_threads_global( int nthreads )
+{
+    if (! blas_threads_global_allowed())
+        return 0;
+
+    #if defined( BLAS_HAVE_OPENBLAS ) \
+        && ! defined( LAPACK_HAVE_OPENBLAS_THREADS_LOCAL )
+        int prev = openblas_get_num_threads();
+        if (nthreads > 0)
+            openblas_set_num_threads( nthreads );
+        return prev;
+    #elif defined( BLAS_HAVE_BLIS )
+        int prev = int( bli_thread_get_num_threads() );
+        if (nthreads > 0)
+            bli_thread_set_num_threads( nthreads );
+        return prev;
+    #else
+        return 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+// True on pool workers, and on the calling thread while it runs a
+// parallel_for, so nested parallel_for calls run serially.
+static thread_local bool in_parallel = false;
+
+//------------------------------------------------------------------------------
+// Fixed set of worker threads that wait for a loop to run.
+// One loop runs at a time; the caller is worker 0.
+class ThreadPool
+{
+public:
+    explicit ThreadPool( int nthreads ):
+        nthreads_( std::max( nthreads, 1 ) ),
+        generation_( 0 ),
+        pending_( 0 ),
+        stop_( false ),
+        body_( nullptr ),
+        n_( 0 ),
+        chunk_( 1 ),
+        next_( 0 )
+    {
+        for (int worker = 1; worker < nthreads_; ++worker)
+            threads_.emplace_back( &ThreadPool::worker_main, this, worker );
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    // Disable copying.
+    ThreadPool( ThreadPool const& ) = delete;
+    ThreadPool& operator=( ThreadPool const& ) = delete;
+
+    int size() const { return nthreads_; }
+
+    //----------------------------------------
+    void run( int64_t n, std::function< void (int64_t, int) > const& body )
+    {
+        int prev_global = set_blas_threads_global( 1 );
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            body_  = &body;
+            n_     = n;
+            // Several chunks per worker balances uneven sizes
+            // without contending on next_ for every iteration.
+            chunk_ = std::max( n / (4*nthreads_), int64_t( 1 ) );
+            next_.store( 0 );
+            error_ = nullptr;
+            pending_ = nthreads_ - 1;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        int prev = set_blas_threads_local( 1 );
+        in_parallel = true;
+        work( 0 );
+        in_parallel = false;
+        set_blas_threads_local( prev );
+
+        std::unique_lock< std::mutex > lock( mutex_ );
+        done_cv_.wait( lock, [this] { return pending_ == 0; } );
+        body_ = nullptr;
+        set_blas_threads_global( prev_global );
+        if (error_)
+            std::rethrow_exception( error_ );
+    }
+
+private:
+    //----------------------------------------
+    void worker_main( int worker )
+    {
+        set_blas_threads_local( 1 );
+        in_parallel = true;
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                start_cv_.wait( lock, [this, seen] {
+                    return stop_ || generation_ != seen;
+                });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+            work( worker );
+            {
+                std::lock_guard< std::mutex > lock( mutex_ );
+                if (--pending_ == 0)
+                    done_cv_.notify_one();
+            }
+        }
+    }
+
+    //----------------------------------------
+    // Takes chunks of iterations until none are left.
+    void work( int worker )
+    {
+        while (true) {
+            int64_t begin = next_.fetch_add( chunk_ );
+            if (begin >= n_)
+                return;
+            int64_t end = std::min( begin + chunk_, n_ );
+            try {
+                for (int64_t i = begin; i < end; ++i)
+                    (*body_)( i, worker );
+            }
+            catch (...) {
+                std::lock_guard< std::mutex > lock( mutex_ );
+                if (! error_)
+                    error_ = std::current_exception();
+                next_.store( n_ );  // skip remaining iterations
+                return;
+            }
+        }
+    }
+
+    int nthreads_;
+    std::vector< std::thread > threads_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_;  ///< incremented for each loop
+    int pending_;          ///< workers other than caller still in loop
+    bool stop_;
+
+    // Current loop.
+    std::function< void (int64_t, int) > const* body_;
+    int64_t n_;
+    int64_t chunk_;
+    std::atomic< int64_t > next_;  ///< first iteration not yet taken
+    std::exception_ptr error_;
+};
+
+//------------------------------------------------------------------------------
+// The pool is created on first use, and re-created by set_num_threads.
+// pool_mutex is held while a loop runs, so a second concurrent loop
+// (from another application thread) runs serially instead of waiting.
+static std::mutex pool_mutex;
+static std::unique_ptr< ThreadPool > pool;
+static std::atomic< int > pool_threads( 0 );  ///< 0 means default
+
+//------------------------------------------------------------------------------
+// @return $LAPACKPP_NUM_THREADS if set, else the number of hardware threads.
+// Read once, on first use, since parallel_for asks on every call.
+static int default_num_threads()
+{
+    static const int nthreads = []() {
+        const char* env = std::getenv( "LAPACKPP_NUM_THREADS" );
+        if (env != nullptr) {
+            int env_threads = std::atoi( env );
+            if (env_threads > 0)
+                return env_threads;
+        }
+        return std::max( int( std::thread::hardware_concurrency() ), 1 );
+    }();
+    return nthreads;
+}
+
+//------------------------------------------------------------------------------
+int num_threads()
+{
+    int nthreads = pool_threads.load();
+    return nthreads > 0 ? nthreads : default_num_threads();
+}
+
+//------------------------------------------------------------------------------
+void parallel_for(
+    int64_t n, std::function< void (int64_t i, int worker) > const& body )
+{
+    if (n <= 0)
+        return;
+
+    if (n > 1 && ! in_parallel && num_threads() > 1) {
+        std::unique_lock< std::mutex > lock( pool_mutex, std::try_to_lock );
+        if (lock.owns_lock()) {
+            if (pool == nullptr || pool->size() != num_threads())
+                pool.reset( new ThreadPool( num_threads() ) );
+            pool->run( n, body );
+            return;
+        }
+    }
+
+    // Serial, as worker 0.
+    bool nested = in_parallel;
+    in_parallel = true;
+    try {
+        for (int64_t i = 0; i < n; ++i)
+            body( i, 0 );
+    }
+    catch (...) {
+        in_parallel = nested;
+        throw;
+    }
+    in_parallel = nested;
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Sets the number of threads LAPACK++ uses to parallelize its own loops,
+/// such as across the matrices in batched routines (getrf_batch, etc.).
+/// This is separate from any threading inside the BLAS and LAPACK
+/// libraries. Within such loops, LAPACK++ limits BLAS to one thread per
+/// thread where the library has a per-thread setting: MKL, OpenMP, and
+/// OpenBLAS 0.3.27 or later.
+///
+/// Older OpenBLAS and BLIS have only a process-wide setting, which is
+/// unsafe to change while other threads call BLAS, so by default
+/// LAPACK++ leaves it alone. Their threads then multiply with LAPACK++'s
+/// threads and can oversubscribe cores; limit them with the library's
+/// environment variable (e.g., OPENBLAS_NUM_THREADS=1 or
+/// BLIS_NUM_THREADS=1). Alternatively, if no other application thread
+/// calls BLAS while LAPACK++ routines run, set
+/// $LAPACKPP_BLAS_THREADS_GLOBAL=1 to let LAPACK++ set them to one thread
+/// for the whole process during each loop. Other BLAS libraries keep
+/// their own threading; limit it likewise.
+///
+/// The default is $LAPACKPP_NUM_THREADS if set, otherwise the number of
+/// hardware threads; the variable is read once, on first use.
+/// Don't call this while LAPACK++ routines are running on other threads.
+///
+/// @param[in] nthreads
+///     Number of threads, including the calling thread. 1 runs loops
+///     serially on the calling thread. 0 restores the default.
+///
+/// @ingroup threads
+void set_num_threads( int nthreads )
+{
+    lapack_error_if( nthreads < 0 );
+    std::lock_guard< std::mutex > lock( internal::pool_mutex );
+    internal::pool.reset();
+    internal::pool_threads.store( nthreads );
+}
+
+//------------------------------------------------------------------------------
+/// @return number of threads LAPACK++ uses to parallelize its own loops;
+/// see set_num_threads().
+///
+/// @ingroup threads
+int get_num_threads()
+{
+    return internal::num_threads();
+}
+
+}  // namespace lapack
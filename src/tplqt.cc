@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7.0
 
@@ -35,6 +36,11 @@ int64_t tplqt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tplqt", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -45,7 +51,7 @@ int64_t tplqt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (mb*m) );
+    lapack::small_vector< float > work( (mb*m) );
 
     LAPACK_stplqt(
         &m_, &n_, &l_, &mb_,
@@ -77,6 +83,11 @@ int64_t tplqt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tplqt", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -87,7 +98,7 @@ int64_t tplqt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (mb*m) );
+    lapack::small_vector< double > work( (mb*m) );
 
     LAPACK_dtplqt(
         &m_, &n_, &l_, &mb_,
@@ -119,6 +130,11 @@ int64_t tplqt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tplqt", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -129,7 +145,7 @@ int64_t tplqt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (mb*m) );
+    lapack::small_vector< std::complex<float> > work( (mb*m) );
 
     LAPACK_ctplqt(
         &m_, &n_, &l_, &mb_,
@@ -257,6 +273,11 @@ int64_t tplqt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tplqt", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -267,7 +288,7 @@ int64_t tplqt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (mb*m) );
+    lapack::small_vector< std::complex<double> > work( (mb*m) );
 
     LAPACK_ztplqt(
         &m_, &n_, &l_, &mb_,
@@ -281,6 +302,231 @@ int64_t tplqt(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tplqt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int mb,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* T, lapack_int ldt,
+    float* work, lapack_int* info )
+{
+    LAPACK_stplqt(
+        &m, &n, &l, &mb,
+        A, &lda,
+        B, &ldb,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_tplqt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int mb,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* T, lapack_int ldt,
+    double* work, lapack_int* info )
+{
+    LAPACK_dtplqt(
+        &m, &n, &l, &mb,
+        A, &lda,
+        B, &ldb,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_tplqt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int mb,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_ctplqt(
+        &m, &n, &l, &mb,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_tplqt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int mb,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_ztplqt(
+        &m, &n, &l, &mb,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tplqt with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( mb*m );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tplqt, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tplqt for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tplqt_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tplqt", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int l_ = (lapack_int) l;
+    lapack_int mb_ = (lapack_int) mb;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( mb*m );
+
+    fortran_tplqt(
+        m_, n_, l_, mb_,
+        A, lda_,
+        B, ldb_,
+        T, ldt_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tplqt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* T, int64_t ldt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tplqt(
+    int64_t m, int64_t n, int64_t l, int64_t mb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* T, int64_t ldt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.7.0
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30400  // >= 3.4.0
 
@@ -42,6 +43,11 @@ int64_t tpmqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpmqrt", 's', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -57,7 +63,7 @@ int64_t tpmqrt(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? n*nb : m*nb);
-    lapack::vector< float > work( lwork );
+    lapack::small_vector< float > work( lwork );
 
     LAPACK_stpmqrt(
         &side_, &trans_, &m_, &n_, &k_, &l_, &nb_,
@@ -101,6 +107,11 @@ int64_t tpmqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpmqrt", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -116,7 +127,7 @@ int64_t tpmqrt(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? n*nb : m*nb);
-    lapack::vector< double > work( lwork );
+    lapack::small_vector< double > work( lwork );
 
     LAPACK_dtpmqrt(
         &side_, &trans_, &m_, &n_, &k_, &l_, &nb_,
@@ -156,6 +167,11 @@ int64_t tpmqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpmqrt", 'c', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -171,7 +187,7 @@ int64_t tpmqrt(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? n*nb : m*nb);
-    lapack::vector< std::complex<float> > work( lwork );
+    lapack::small_vector< std::complex<float> > work( lwork );
 
     LAPACK_ctpmqrt(
         &side_, &trans_, &m_, &n_, &k_, &l_, &nb_,
@@ -329,6 +345,11 @@ int64_t tpmqrt(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpmqrt", 'z', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     lapack_int m_ = (lapack_int) m;
@@ -344,7 +365,7 @@ int64_t tpmqrt(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? n*nb : m*nb);
-    lapack::vector< std::complex<double> > work( lwork );
+    lapack::small_vector< std::complex<double> > work( lwork );
 
     LAPACK_ztpmqrt(
         &side_, &trans_, &m_, &n_, &k_, &l_, &nb_,
@@ -363,6 +384,284 @@ int64_t tpmqrt(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tpmqrt(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k, lapack_int l, lapack_int nb,
+    float const* V, lapack_int ldv,
+    float const* T, lapack_int ldt,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* work, lapack_int* info )
+{
+    LAPACK_stpmqrt(
+        &side, &trans, &m, &n, &k, &l, &nb,
+        V, &ldv,
+        T, &ldt,
+        A, &lda,
+        B, &ldb,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tpmqrt(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k, lapack_int l, lapack_int nb,
+    double const* V, lapack_int ldv,
+    double const* T, lapack_int ldt,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* work, lapack_int* info )
+{
+    LAPACK_dtpmqrt(
+        &side, &trans, &m, &n, &k, &l, &nb,
+        V, &ldv,
+        T, &ldt,
+        A, &lda,
+        B, &ldb,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tpmqrt(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k, lapack_int l, lapack_int nb,
+    std::complex<float> const* V, lapack_int ldv,
+    std::complex<float> const* T, lapack_int ldt,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_ctpmqrt(
+        &side, &trans, &m, &n, &k, &l, &nb,
+        (lapack_complex_float const*) V, &ldv,
+        (lapack_complex_float const*) T, &ldt,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tpmqrt(
+    char side, char trans, lapack_int m, lapack_int n, lapack_int k, lapack_int l, lapack_int nb,
+    std::complex<double> const* V, lapack_int ldv,
+    std::complex<double> const* T, lapack_int ldt,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_ztpmqrt(
+        &side, &trans, &m, &n, &k, &l, &nb,
+        (lapack_complex_double const*) V, &ldv,
+        (lapack_complex_double const*) T, &ldt,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tpmqrt with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( side == Side::Left ? n*nb : m*nb );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tpmqrt, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tpmqrt for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tpmqrt_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tpmqrt", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int l_ = (lapack_int) l;
+    lapack_int nb_ = (lapack_int) nb;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( side == Side::Left ? n*nb : m*nb );
+
+    fortran_tpmqrt(
+        side_, trans_, m_, n_, k_, l_, nb_,
+        V, ldv_,
+        T, ldt_,
+        A, lda_,
+        B, ldb_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tpmqrt_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tpmqrt(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    int64_t l, int64_t nb,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.4.0
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30400  // >= 3.4
 
@@ -35,6 +36,11 @@ int64_t tpqrt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpqrt", 's', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -45,7 +51,7 @@ int64_t tpqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (nb*n) );
+    lapack::small_vector< float > work( (nb*n) );
 
     LAPACK_stpqrt(
         &m_, &n_, &l_, &nb_,
@@ -77,6 +83,11 @@ int64_t tpqrt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpqrt", 'd', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -87,7 +98,7 @@ int64_t tpqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (nb*n) );
+    lapack::small_vector< double > work( (nb*n) );
 
     LAPACK_dtpqrt(
         &m_, &n_, &l_, &nb_,
@@ -119,6 +130,11 @@ int64_t tpqrt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpqrt", 'c', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -129,7 +145,7 @@ int64_t tpqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (nb*n) );
+    lapack::small_vector< std::complex<float> > work( (nb*n) );
 
     LAPACK_ctpqrt(
         &m_, &n_, &l_, &nb_,
@@ -161,6 +177,11 @@ int64_t tpqrt(
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tpqrt", 'z', m, n, -1,
+        []() { return 0.0; } );
+
     lapack_int m_ = (lapack_int) m;
     lapack_int n_ = (lapack_int) n;
     lapack_int l_ = (lapack_int) l;
@@ -171,7 +192,7 @@ int64_t tpqrt(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (nb*n) );
+    lapack::small_vector< std::complex<double> > work( (nb*n) );
 
     LAPACK_ztpqrt(
         &m_, &n_, &l_, &nb_,
@@ -185,6 +206,231 @@ int64_t tpqrt(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tpqrt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int nb,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* T, lapack_int ldt,
+    float* work, lapack_int* info )
+{
+    LAPACK_stpqrt(
+        &m, &n, &l, &nb,
+        A, &lda,
+        B, &ldb,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_tpqrt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int nb,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* T, lapack_int ldt,
+    double* work, lapack_int* info )
+{
+    LAPACK_dtpqrt(
+        &m, &n, &l, &nb,
+        A, &lda,
+        B, &ldb,
+        T, &ldt,
+        work, info );
+}
+
+//----------
+static void fortran_tpqrt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int nb,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* work, lapack_int* info )
+{
+    LAPACK_ctpqrt(
+        &m, &n, &l, &nb,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) work, info );
+}
+
+//----------
+static void fortran_tpqrt(
+    lapack_int m, lapack_int n, lapack_int l, lapack_int nb,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* work, lapack_int* info )
+{
+    LAPACK_ztpqrt(
+        &m, &n, &l, &nb,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) work, info );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tpqrt with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( nb*n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tpqrt, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tpqrt for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tpqrt_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    scalar_t* T, int64_t ldt,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tpqrt", trace::internal::precision< scalar_t >(), m, n, -1,
+        []() { return 0.0; } );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int l_ = (lapack_int) l;
+    lapack_int nb_ = (lapack_int) nb;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( nb*n );
+
+    fortran_tpqrt(
+        m_, n_, l_, nb_,
+        A, lda_,
+        B, ldb_,
+        T, ldt_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* T, int64_t ldt,
+    size_t* work_size );
+
+template
+void tpqrt_work_size_bytes(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* T, int64_t ldt,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* T, int64_t ldt,
+    void* work, size_t work_size );
+
+template
+int64_t tpqrt(
+    int64_t m, int64_t n, int64_t l, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* T, int64_t ldt,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.4
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30400  // >= 3.4.0
 
@@ -39,6 +40,11 @@ void tprfb(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tprfb", 's', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -55,7 +61,7 @@ void tprfb(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? k*n : m*k);
-    lapack::vector< float > work( lwork );
+    lapack::small_vector< float > work( lwork );
 
     LAPACK_stprfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_, &l_,
@@ -92,6 +98,11 @@ void tprfb(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tprfb", 'd', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -108,7 +119,7 @@ void tprfb(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? k*n : m*k);
-    lapack::vector< double > work( lwork );
+    lapack::small_vector< double > work( lwork );
 
     LAPACK_dtprfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_, &l_,
@@ -145,6 +156,11 @@ void tprfb(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tprfb", 'c', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -161,7 +177,7 @@ void tprfb(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? k*n : m*k);
-    lapack::vector< std::complex<float> > work( lwork );
+    lapack::small_vector< std::complex<float> > work( lwork );
 
     LAPACK_ctprfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_, &l_,
@@ -364,6 +380,11 @@ void tprfb(
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "tprfb", 'z', m, n, k,
+        []() { return 0.0; } );
+
     char side_ = side2char( side );
     char trans_ = op2char( trans );
     char direction_ = direction2char( direction );
@@ -380,7 +401,7 @@ void tprfb(
 
     // allocate workspace
     int64_t lwork = (side == Side::Left ? k*n : m*k);
-    lapack::vector< std::complex<double> > work( lwork );
+    lapack::small_vector< std::complex<double> > work( lwork );
 
     LAPACK_ztprfb(
         &side_, &trans_, &direction_, &storev_, &m_, &n_, &k_, &l_,
@@ -395,6 +416,284 @@ void tprfb(
     );
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_tprfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k, lapack_int l,
+    float const* V, lapack_int ldv,
+    float const* T, lapack_int ldt,
+    float* A, lapack_int lda,
+    float* B, lapack_int ldb,
+    float* work, lapack_int ldwork )
+{
+    LAPACK_stprfb(
+        &side, &trans, &direction, &storev, &m, &n, &k, &l,
+        V, &ldv,
+        T, &ldt,
+        A, &lda,
+        B, &ldb,
+        work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tprfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k, lapack_int l,
+    double const* V, lapack_int ldv,
+    double const* T, lapack_int ldt,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* work, lapack_int ldwork )
+{
+    LAPACK_dtprfb(
+        &side, &trans, &direction, &storev, &m, &n, &k, &l,
+        V, &ldv,
+        T, &ldt,
+        A, &lda,
+        B, &ldb,
+        work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tprfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k, lapack_int l,
+    std::complex<float> const* V, lapack_int ldv,
+    std::complex<float> const* T, lapack_int ldt,
+    std::complex<float>* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb,
+    std::complex<float>* work, lapack_int ldwork )
+{
+    LAPACK_ctprfb(
+        &side, &trans, &direction, &storev, &m, &n, &k, &l,
+        (lapack_complex_float const*) V, &ldv,
+        (lapack_complex_float const*) T, &ldt,
+        (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb,
+        (lapack_complex_float*) work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_tprfb(
+    char side, char trans, char direction, char storev, lapack_int m, lapack_int n, lapack_int k, lapack_int l,
+    std::complex<double> const* V, lapack_int ldv,
+    std::complex<double> const* T, lapack_int ldt,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* work, lapack_int ldwork )
+{
+    LAPACK_ztprfb(
+        &side, &trans, &direction, &storev, &m, &n, &k, &l,
+        (lapack_complex_double const*) V, &ldv,
+        (lapack_complex_double const*) T, &ldt,
+        (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb,
+        (lapack_complex_double*) work, &ldwork
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1, 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by tprfb with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( side == Side::Left ? k*n : m*k );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::tprfb, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::tprfb for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     tprfb_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(l) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldv) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "tprfb", trace::internal::precision< scalar_t >(), m, n, k,
+        []() { return 0.0; } );
+
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    char direction_ = direction2char( direction );
+    char storev_ = storev2char( storev );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int l_ = (lapack_int) l;
+    lapack_int ldv_ = (lapack_int) ldv;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldwork_ = (lapack_int) (side == Side::Left ? k : m);
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( side == Side::Left ? k*n : m*k );
+
+    fortran_tprfb(
+        side_, trans_, direction_, storev_, m_, n_, k_, l_,
+        V, ldv_,
+        T, ldt_,
+        A, lda_,
+        B, ldb_,
+        work_, ldwork_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t* work_size );
+
+template
+void tprfb_work_size_bytes(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    float const* V, int64_t ldv,
+    float const* T, int64_t ldt,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    double const* V, int64_t ldv,
+    double const* T, int64_t ldt,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    std::complex<float> const* V, int64_t ldv,
+    std::complex<float> const* T, int64_t ldt,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    void* work, size_t work_size );
+
+template
+int64_t tprfb(
+    lapack::Side side, lapack::Op trans, lapack::Direction direction,
+    lapack::StoreV storev, int64_t m, int64_t n, int64_t k, int64_t l,
+    std::complex<double> const* V, int64_t ldv,
+    std::complex<double> const* T, int64_t ldt,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // LAPACK >= 3.4.0
@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/trace.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lapack {
+namespace trace {
+namespace internal {
+
+std::atomic< bool > enabled( false );
+
+//------------------------------------------------------------------------------
+struct Event {
+    char const* name;
+    char precision;
+    int64_t m, n, k;
+    double start, stop, gflop, gbyte;
+};
+
+//------------------------------------------------------------------------------
+// Events recorded by one thread. Only that thread appends, so its mutex
+// is contended only while finish, clear, or size reads the events.
+struct ThreadEvents {
+    explicit ThreadEvents( int id_ ):
+        id( id_ )
+    {}
+
+    int id;
+    std::mutex mutex;
+    std::vector< Event > events;
+};
+
+//------------------------------------------------------------------------------
+// Events of running threads, registered on their first record. When a
+// thread exits, its events move to retired and its entry is dropped, so
+// the registry doesn't grow with short-lived threads.
+static std::mutex registry_mutex;
+static std::vector< ThreadEvents* > registry;
+static std::vector< std::pair< int, Event > > retired;
+static int next_id = 0;
+
+static const std::chrono::steady_clock::time_point epoch
+    = std::chrono::steady_clock::now();
+
+// This thread's events. The pointer is trivially destructible, so it
+// stays valid to test after the thread's ThreadExit is destroyed.
+static thread_local ThreadEvents* thread_events_ = nullptr;
+static thread_local bool thread_exited = false;
+
+//------------------------------------------------------------------------------
+// Moves this thread's events to retired and drops its registry entry.
+static void retire_thread()
+{
+    std::lock_guard< std::mutex > lock( registry_mutex );
+    ThreadEvents* te = thread_events_;
+    registry.erase( std::find( registry.begin(), registry.end(), te ) );
+    for (auto& event : te->events)
+        retired.push_back( { te->id, event } );
+    delete te;
+    thread_events_ = nullptr;
+    thread_exited = true;
+}
+
+//------------------------------------------------------------------------------
+// Retires the thread's events when the thread exits.
+struct ThreadExit {
+    ~ThreadExit()
+    {
+        retire_thread();
+    }
+};
+
+//------------------------------------------------------------------------------
+// @return this thread's events, registering them on first use.
+// A thread that records after its thread_local objects were destroyed,
+// e.g., from a static destructor, keeps its events registered until exit.
+static ThreadEvents& thread_events()
+{
+    if (thread_events_ == nullptr) {
+        {
+            std::lock_guard< std::mutex > lock( registry_mutex );
+            thread_events_ = new ThreadEvents( next_id++ );
+            registry.push_back( thread_events_ );
+        }
+        if (! thread_exited) {
+            thread_local ThreadExit thread_exit;
+            (void) thread_exit;
+        }
+    }
+    return *thread_events_;
+}
+
+//------------------------------------------------------------------------------
+// @return seconds since the library was loaded.
+double now()
+{
+    using std::chrono::steady_clock;
+    return std::chrono::duration< double >( steady_clock::now() - epoch ).count();
+}
+
+//------------------------------------------------------------------------------
+void record(
+    char const* name, char precision,
+    int64_t m, int64_t n, int64_t k,
+    double start, double stop, double gflop, double gbyte )
+{
+    ThreadEvents& te = thread_events();
+    std::lock_guard< std::mutex > lock( te.mutex );
+    te.events.push_back(
+        Event{ name, precision, m, n, k, start, stop, gflop, gbyte } );
+}
+
+}  // namespace internal
+
+using internal::Event;
+using internal::ThreadEvents;
+using internal::registry;
+using internal::registry_mutex;
+using internal::retired;
+
+//------------------------------------------------------------------------------
+void on()
+{
+    internal::enabled.store( true );
+}
+
+//------------------------------------------------------------------------------
+void off()
+{
+    internal::enabled.store( false );
+}
+
+//------------------------------------------------------------------------------
+void clear()
+{
+    std::lock_guard< std::mutex > lock( registry_mutex );
+    for (auto& te : registry) {
+        std::lock_guard< std::mutex > te_lock( te->mutex );
+        te->events.clear();
+    }
+    retired.clear();
+}
+
+//------------------------------------------------------------------------------
+int64_t size()
+{
+    std::lock_guard< std::mutex > lock( registry_mutex );
+    int64_t count = retired.size();
+    for (auto& te : registry) {
+        std::lock_guard< std::mutex > te_lock( te->mutex );
+        count += te->events.size();
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+// Takes events from each thread, so recording continues while the file
+// is written, then writes them sorted by start time. Times in Chrome
+// trace format are in microseconds.
+void finish( const char* filename )
+{
+    typedef long long lld;
+
+    std::vector< std::pair< int, Event > > events;
+    {
+        std::lock_guard< std::mutex > lock( registry_mutex );
+        events.swap( retired );
+        for (auto& te : registry) {
+            std::vector< Event > te_events;
+            {
+                std::lock_guard< std::mutex > te_lock( te->mutex );
+                te_events.swap( te->events );
+            }
+            for (auto& event : te_events)
+                events.push_back( { te->id, event } );
+        }
+    }
+    std::stable_sort(
+        events.begin(), events.end(),
+        [] (std::pair< int, Event > const& a, std::pair< int, Event > const& b) {
+            return a.second.start < b.second.start;
+        });
+
+    FILE* file = std::fopen( filename, "w" );
+    if (file == nullptr) {
+        throw Error( "can't open trace file " + std::string( filename ) );
+    }
+
+    fprintf( file, "{\"traceEvents\":[\n" );
+    for (size_t i = 0; i < events.size(); ++i) {
+        int tid = events[ i ].first;
+        Event const& event = events[ i ].second;
+        double time = event.stop - event.start;
+        fprintf( file,
+                 "{\"name\":\"%c%s\",\"cat\":\"lapack\",\"ph\":\"X\","
+                 "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                 "\"args\":{\"precision\":\"%c\"",
+                 event.precision, event.name,
+                 event.start * 1e6, time * 1e6, tid,
+                 event.precision );
+        if (event.m >= 0)
+            fprintf( file, ",\"m\":%lld", (lld) event.m );
+        if (event.n >= 0)
+            fprintf( file, ",\"n\":%lld", (lld) event.n );
+        if (event.k >= 0)
+            fprintf( file, ",\"k\":%lld", (lld) event.k );
+        double gflops = (time > 0 ? event.gflop / time : 0);
+        fprintf( file, ",\"gflop\":%.6g,\"gflops\":%.6g",
+                 event.gflop, gflops );
+        if (event.gbyte > 0) {
+            double gbytes = (time > 0 ? event.gbyte / time : 0);
+            fprintf( file, ",\"gbyte\":%.6g,\"gbytes\":%.6g",
+                     event.gbyte, gbytes );
+        }
+        fprintf( file, "}}%s\n", (i + 1 < events.size() ? "," : "") );
+    }
+    fprintf( file, "],\n\"displayTimeUnit\":\"ms\"}\n" );
+
+    bool failed = (std::ferror( file ) != 0);
+    failed = (std::fclose( file ) != 0) || failed;
+    if (failed) {
+        throw Error( "can't write trace file " + std::string( filename ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+// If $LAPACKPP_TRACE is set, turns tracing on at startup, and writes the
+// trace to that file at exit. Defined after the registry, so it is
+// destroyed before the registry.
+class EnvTrace
+{
+public:
+    EnvTrace()
+    {
+        const char* env = std::getenv( "LAPACKPP_TRACE" );
+        if (env != nullptr && env[ 0 ] != '\0') {
+            filename_ = env;
+            on();
+        }
+    }
+
+    ~EnvTrace()
+    {
+        if (! filename_.empty()) {
+            try {
+                finish( filename_.c_str() );
+            }
+            catch (std::exception const& ex) {
+                fprintf( stderr, "lapackpp: %s\n", ex.what() );
+            }
+        }
+    }
+
+private:
+    std::string filename_;
+};
+
+static EnvTrace env_trace;
+
+}  // namespace trace
+}  // namespace lapack
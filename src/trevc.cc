@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -33,11 +34,16 @@ int64_t trevc(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -49,7 +55,7 @@ int64_t trevc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (3*n) );
+    lapack::small_vector< float > work( (3*n) );
 
     LAPACK_strevc(
         &sides_, &howmany_,
@@ -89,11 +95,16 @@ int64_t trevc(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -105,7 +116,7 @@ int64_t trevc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (3*n) );
+    lapack::small_vector< double > work( (3*n) );
 
     LAPACK_dtrevc(
         &sides_, &howmany_,
@@ -145,11 +156,16 @@ int64_t trevc(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -161,8 +177,8 @@ int64_t trevc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( (2*n) );
-    lapack::vector< float > rwork( (n) );
+    lapack::small_vector< std::complex<float> > work( (2*n) );
+    lapack::small_vector< float > rwork( (n) );
 
     LAPACK_ctrevc(
         &sides_, &howmany_,
@@ -323,11 +339,16 @@ int64_t trevc(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -339,8 +360,8 @@ int64_t trevc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( (2*n) );
-    lapack::vector< double > rwork( (n) );
+    lapack::small_vector< std::complex<double> > work( (2*n) );
+    lapack::small_vector< double > rwork( (n) );
 
     LAPACK_ztrevc(
         &sides_, &howmany_,
@@ -361,4 +382,280 @@ int64_t trevc(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_trevc(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    float* T, lapack_int ldt,
+    float* VL, lapack_int ldvl,
+    float* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    float* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_strevc(
+        &sides, &howmany,
+        select, &n,
+        T, &ldt,
+        VL, &ldvl,
+        VR, &ldvr, &mm, m,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    double* T, lapack_int ldt,
+    double* VL, lapack_int ldvl,
+    double* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    double* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_dtrevc(
+        &sides, &howmany,
+        select, &n,
+        T, &ldt,
+        VL, &ldvl,
+        VR, &ldvr, &mm, m,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* VL, lapack_int ldvl,
+    std::complex<float>* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    std::complex<float>* work,
+    float* rwork, lapack_int* info )
+{
+    LAPACK_ctrevc(
+        &sides, &howmany,
+        select, &n,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) VL, &ldvl,
+        (lapack_complex_float*) VR, &ldvr, &mm, m,
+        (lapack_complex_float*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* VL, lapack_int ldvl,
+    std::complex<double>* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    std::complex<double>* work,
+    double* rwork, lapack_int* info )
+{
+    LAPACK_ztrevc(
+        &sides, &howmany,
+        select, &n,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) VL, &ldvl,
+        (lapack_complex_double*) VR, &ldvr, &mm, m,
+        (lapack_complex_double*) work,
+        rwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by trevc with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_int >( n );
+    buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::trevc, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::trevc for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     trevc_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "trevc", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char sides_ = sides2char( sides );
+    char howmany_ = howmany2char( howmany );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int mm_ = (lapack_int) mm;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int* select_ = buffer.take< lapack_int >( n );
+    std::copy( select, select + n, select_ );
+    lapack_int* select_ptr = select_;
+    scalar_t* work_ = buffer.take< scalar_t >( blas::is_complex<scalar_t>::value ? 2*n : 3*n );
+    real_t* rwork_ = buffer.take< real_t >( blas::is_complex<scalar_t>::value ? n : 0 );
+
+    fortran_trevc(
+        sides_, howmany_,
+        select_ptr, n_,
+        T, ldt_,
+        VL, ldvl_,
+        VR, ldvr_, mm_, &m_,
+        work_,
+        rwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    std::copy( select_, select_ + n, select );
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    float* T, int64_t ldt,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    double* T, int64_t ldt,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    float* T, int64_t ldt,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    double* T, int64_t ldt,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
 }  // namespace lapack
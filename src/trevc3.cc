@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #if LAPACK_VERSION >= 30601  // >= 3.6.1
 #ifndef BLAS_HAVE_MKL  // MKL 2018 lacks trevc3
@@ -36,11 +37,16 @@ int64_t trevc3(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc3", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -71,7 +77,7 @@ int64_t trevc3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::small_vector< float > work( lwork_ );
 
     LAPACK_strevc3(
         &sides_, &howmany_,
@@ -111,11 +117,16 @@ int64_t trevc3(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc3", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -146,7 +157,7 @@ int64_t trevc3(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::small_vector< double > work( lwork_ );
 
     LAPACK_dtrevc3(
         &sides_, &howmany_,
@@ -186,11 +197,16 @@ int64_t trevc3(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc3", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -224,8 +240,8 @@ int64_t trevc3(
     lapack_int lrwork_ = real(qry_rwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< float > rwork( lrwork_ );
 
     LAPACK_ctrevc3(
         &sides_, &howmany_,
@@ -388,11 +404,16 @@ int64_t trevc3(
         lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trevc3", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char sides_ = sides2char( sides );
     char howmany_ = howmany2char( howmany );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -426,8 +447,8 @@ int64_t trevc3(
     lapack_int lrwork_ = real(qry_rwork[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< double > rwork( lrwork_ );
 
     LAPACK_ztrevc3(
         &sides_, &howmany_,
@@ -448,6 +469,327 @@ int64_t trevc3(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_trevc3(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    float* T, lapack_int ldt,
+    float* VL, lapack_int ldvl,
+    float* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    float* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork, lapack_int* info )
+{
+    LAPACK_strevc3(
+        &sides, &howmany,
+        select, &n,
+        T, &ldt,
+        VL, &ldvl,
+        VR, &ldvr, &mm, m,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc3(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    double* T, lapack_int ldt,
+    double* VL, lapack_int ldvl,
+    double* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    double* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork, lapack_int* info )
+{
+    LAPACK_dtrevc3(
+        &sides, &howmany,
+        select, &n,
+        T, &ldt,
+        VL, &ldvl,
+        VR, &ldvr, &mm, m,
+        work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc3(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* VL, lapack_int ldvl,
+    std::complex<float>* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    std::complex<float>* work, lapack_int lwork,
+    float* rwork, lapack_int lrwork, lapack_int* info )
+{
+    LAPACK_ctrevc3(
+        &sides, &howmany,
+        select, &n,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) VL, &ldvl,
+        (lapack_complex_float*) VR, &ldvr, &mm, m,
+        (lapack_complex_float*) work, &lwork,
+        rwork, &lrwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trevc3(
+    char sides, char howmany,
+    lapack_int* select, lapack_int n,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* VL, lapack_int ldvl,
+    std::complex<double>* VR, lapack_int ldvr, lapack_int mm, lapack_int* m,
+    std::complex<double>* work, lapack_int lwork,
+    double* rwork, lapack_int lrwork, lapack_int* info )
+{
+    LAPACK_ztrevc3(
+        &sides, &howmany,
+        select, &n,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) VL, &ldvl,
+        (lapack_complex_double*) VR, &ldvr, &mm, m,
+        (lapack_complex_double*) work, &lwork,
+        rwork, &lrwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by trevc3 with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
+    }
+    char sides_ = sides2char( sides );
+    char howmany_ = howmany2char( howmany );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int mm_ = (lapack_int) mm;
+    lapack_int m_ = 0;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int ineg_one = -1;
+    fortran_trevc3(
+        sides_, howmany_,
+        nullptr, n_,
+        T, ldt_,
+        VL, ldvl_,
+        VR, ldvr_, mm_, &m_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = max( 1, lapack_int( real(qry_work[0]) ) );
+    lapack_int lrwork_ = blas::is_complex<scalar_t>::value ? max( 1, lapack_int( real(qry_rwork[0]) ) ) : 0;
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_int >( n );
+    buffer.take< real_t >( lrwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::trevc3, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::trevc3 for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     trevc3_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(mm) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "trevc3", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char sides_ = sides2char( sides );
+    char howmany_ = howmany2char( howmany );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int mm_ = (lapack_int) mm;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int info_ = 0;
+
+    // query for size of rwork
+    scalar_t qry_work[1];
+    real_t qry_rwork[1];
+    lapack_int ineg_one = -1;
+    fortran_trevc3(
+        sides_, howmany_,
+        nullptr, n_,
+        T, ldt_,
+        VL, ldvl_,
+        VR, ldvr_, mm_, &m_,
+        qry_work, ineg_one,
+        qry_rwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lrwork_ = blas::is_complex<scalar_t>::value ? max( 1, lapack_int( real(qry_rwork[0]) ) ) : 0;
+
+    // carve workspace arrays from buffer; work gets the rest
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_int* select_ = buffer.take< lapack_int >( n );
+    std::copy( select, select + n, select_ );
+    lapack_int* select_ptr = select_;
+    real_t* rwork_ = buffer.take< real_t >( lrwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_trevc3(
+        sides_, howmany_,
+        select_ptr, n_,
+        T, ldt_,
+        VL, ldvl_,
+        VR, ldvr_, mm_, &m_,
+        work_, lwork_,
+        rwork_, lrwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    std::copy( select_, select_ + n, select );
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    float* T, int64_t ldt,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    double* T, int64_t ldt,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+template
+void trevc3_work_size_bytes(
+    lapack::Sides sides, lapack::HowMany howmany, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr, int64_t mm,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    float* T, int64_t ldt,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    double* T, int64_t ldt,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
+template
+int64_t trevc3(
+    lapack::Sides sides, lapack::HowMany howmany,
+    bool* select, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr, int64_t mm,
+    int64_t* m,
+    void* work, size_t work_size );
+
 }  // namespace lapack
 
 #endif  // not HAVE_MKL
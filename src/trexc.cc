@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -29,6 +30,11 @@ int64_t trexc(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trexc", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldt_ = (lapack_int) ldt;
@@ -38,7 +44,7 @@ int64_t trexc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< float > work( (n) );
+    lapack::small_vector< float > work( (n) );
 
     LAPACK_strexc(
         &compq_, &n_,
@@ -71,6 +77,11 @@ int64_t trexc(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trexc", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldt_ = (lapack_int) ldt;
@@ -80,7 +91,7 @@ int64_t trexc(
     lapack_int info_ = 0;
 
     // allocate workspace
-    lapack::vector< double > work( (n) );
+    lapack::small_vector< double > work( (n) );
 
     LAPACK_dtrexc(
         &compq_, &n_,
@@ -113,6 +124,11 @@ int64_t trexc(
         lapack_error_if( std::abs(ifst) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ilst) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trexc", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldt_ = (lapack_int) ldt;
@@ -149,6 +165,11 @@ int64_t trexc(
         lapack_error_if( std::abs(ifst) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ilst) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trexc", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char compq_ = job_comp2char( compq );
     lapack_int n_ = (lapack_int) n;
     lapack_int ldt_ = (lapack_int) ldt;
@@ -171,4 +192,161 @@ int64_t trexc(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+static void fortran_trexc(
+    char compq, lapack_int n,
+    float* T, lapack_int ldt,
+    float* Q, lapack_int ldq, lapack_int* ifst, lapack_int* ilst,
+    float* work, lapack_int* info )
+{
+    LAPACK_strexc(
+        &compq, &n,
+        T, &ldt,
+        Q, &ldq, ifst, ilst,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trexc(
+    char compq, lapack_int n,
+    double* T, lapack_int ldt,
+    double* Q, lapack_int ldq, lapack_int* ifst, lapack_int* ilst,
+    double* work, lapack_int* info )
+{
+    LAPACK_dtrexc(
+        &compq, &n,
+        T, &ldt,
+        Q, &ldq, ifst, ilst,
+        work, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by trexc with caller-provided
+/// workspace. Arrays are not referenced.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void trexc_work_size_bytes(
+    lapack::Job compq, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    size_t* work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    internal::WorkBuffer buffer;
+    buffer.take< scalar_t >( n );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::trexc, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::trexc for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     trexc_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t trexc(
+    lapack::Job compq, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    int64_t* ifst,
+    int64_t* ilst,
+    void* work, size_t work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "trexc", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char compq_ = job_comp2char( compq );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int ifst_ = (lapack_int) *ifst;
+    lapack_int ilst_ = (lapack_int) *ilst;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    scalar_t* work_ = buffer.take< scalar_t >( n );
+
+    fortran_trexc(
+        compq_, n_,
+        T, ldt_,
+        Q, ldq_, &ifst_, &ilst_,
+        work_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *ifst = ifst_;
+    *ilst = ilst_;
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trexc_work_size_bytes(
+    lapack::Job compq, int64_t n,
+    float* T, int64_t ldt,
+    float* Q, int64_t ldq,
+    size_t* work_size );
+
+template
+void trexc_work_size_bytes(
+    lapack::Job compq, int64_t n,
+    double* T, int64_t ldt,
+    double* Q, int64_t ldq,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t trexc(
+    lapack::Job compq, int64_t n,
+    float* T, int64_t ldt,
+    float* Q, int64_t ldq,
+    int64_t* ifst,
+    int64_t* ilst,
+    void* work, size_t work_size );
+
+template
+int64_t trexc(
+    lapack::Job compq, int64_t n,
+    double* T, int64_t ldt,
+    double* Q, int64_t ldq,
+    int64_t* ifst,
+    int64_t* ilst,
+    void* work, size_t work_size );
+
 }  // namespace lapack
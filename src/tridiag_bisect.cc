@@ -0,0 +1,532 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "NoConstructAllocator.hh"
+#include "ThreadPool.hh"
+#include "simd.hh"
+#include "sturm_kernels.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Half-open interval [a, b) holding the eigenvalues with indices
+// [ca, cb), where ca = sturm( a ) and cb = sturm( b ).
+template <typename real_t>
+struct BisectInterval {
+    real_t a, b;
+    int64_t ca, cb;
+};
+
+//------------------------------------------------------------------------------
+// Bisection settings and the matrix, shared by all threads.
+// T is split, as in stebz, into unreduced blocks
+// [ blocks[ j ], blocks[ j+1 ] ), so no Sturm sequence collapses to zero.
+template <typename real_t>
+struct BisectProblem {
+    int64_t n;
+    real_t const* D;
+    real_t const* E2;   // squared off-diagonal, for sturm_counts
+    std::vector< int64_t > blocks;
+    int64_t klo, khi;   // wanted eigenvalue indices [klo, khi), 0-based
+    real_t atol, rtol;
+    real_t* W;          // W[ k - klo ] is eigenvalue k
+};
+
+//------------------------------------------------------------------------------
+// Number of eigenvalues of T less than each shift u[ k ], summed over
+// blocks. tmp is workspace.
+template <typename real_t>
+void bisect_counts(
+    BisectProblem<real_t> const& prob,
+    int64_t nshifts, real_t const* u, int64_t* count,
+    std::vector< int64_t >& tmp )
+{
+    tmp.resize( nshifts );
+    std::fill( count, count + nshifts, 0 );
+    for (size_t j = 0; j + 1 < prob.blocks.size(); ++j) {
+        int64_t i1 = prob.blocks[ j ];
+        int64_t nb = prob.blocks[ j+1 ] - i1;
+        sturm_counts( nb, prob.D + i1, prob.E2 + i1, nshifts, u, tmp.data() );
+        for (int64_t k = 0; k < nshifts; ++k)
+            count[ k ] += tmp[ k ];
+    }
+}
+
+//------------------------------------------------------------------------------
+// One bisection step on all intervals in list, as in stebz. Intervals
+// narrower than max( atol, rtol max( |a|, |b| ) ), or with no floating
+// point number between a and b, are converged: their wanted eigenvalues
+// are set to the midpoint, they are appended to done if it isn't null,
+// and dropped. Others are split at their midpoint, with Sturm counts at
+// all midpoints computed in one multi-shift pass, keeping halves that hold
+// wanted eigenvalues. list stays sorted by a.
+// next, mid, count, and tmp are workspace.
+template <typename real_t>
+void bisect_step(
+    BisectProblem<real_t> const& prob,
+    std::vector< BisectInterval<real_t> >& list,
+    std::vector< BisectInterval<real_t> >* done,
+    std::vector< BisectInterval<real_t> >& next,
+    std::vector< real_t >& mid,
+    std::vector< int64_t >& count,
+    std::vector< int64_t >& tmp )
+{
+    const real_t half = 0.5;
+
+    size_t nactive = 0;
+    mid.clear();
+    for (auto const& iv : list) {
+        real_t c = half*iv.a + half*iv.b;
+        real_t tol = max( prob.atol,
+                          prob.rtol * max( std::abs( iv.a ), std::abs( iv.b ) ) );
+        if (iv.b - iv.a <= tol || c <= iv.a || c >= iv.b) {
+            int64_t k1 = max( iv.ca, prob.klo );
+            int64_t k2 = min( iv.cb, prob.khi );
+            for (int64_t k = k1; k < k2; ++k)
+                prob.W[ k - prob.klo ] = c;
+            if (done != nullptr)
+                done->push_back( iv );
+        }
+        else {
+            list[ nactive++ ] = iv;
+            mid.push_back( c );
+        }
+    }
+    list.resize( nactive );
+    if (nactive == 0)
+        return;
+
+    count.resize( nactive );
+    bisect_counts( prob, int64_t( nactive ), mid.data(), count.data(), tmp );
+
+    next.clear();
+    for (size_t i = 0; i < nactive; ++i) {
+        auto const& iv = list[ i ];
+        // Rounding in the counts can break monotonicity; clamp to the
+        // parent so children stay consistent.
+        int64_t cm = min( max( count[ i ], iv.ca ), iv.cb );
+        if (max( iv.ca, prob.klo ) < min( cm, prob.khi ))
+            next.push_back( { iv.a, mid[ i ], iv.ca, cm } );
+        if (max( cm, prob.klo ) < min( iv.cb, prob.khi ))
+            next.push_back( { mid[ i ], iv.b, cm, iv.cb } );
+    }
+    list.swap( next );
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @ingroup heev_computational
+/// Computes all eigenvalues, or those in an index or value range, and
+/// optionally eigenvectors, of a real symmetric tridiagonal matrix T by
+/// parallel bisection using Sturm counts. This is native code, similar to
+/// LAPACK's stebz followed by stein.
+///
+/// The Gershgorin interval is bisected until it splits into enough
+/// independent subintervals, which are then refined in parallel on the
+/// LAPACK++ thread pool (see lapack::set_num_threads), each thread
+/// evaluating the midpoints of all its subintervals with one multi-shift
+/// lapack::sturm pass. Eigenvectors are computed by inverse iteration
+/// (lapack::stein) in parallel over clusters of close eigenvalues, so
+/// vectors within a cluster are reorthogonalized as in stein.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     - lapack::Range::All:
+///         all eigenvalues will be found.
+///     - lapack::Range::Value:
+///         all eigenvalues in the half-open interval (vl, vu]
+///         will be found.
+///     - lapack::Range::Index:
+///         the il-th through iu-th eigenvalues will be found.
+///
+/// @param[in] n
+///     The order of the matrix T. n >= 0.
+///
+/// @param[in] D
+///     The vector D of length n.
+///     The n diagonal elements of T.
+///
+/// @param[in] E
+///     The vector E of length max(1, n-1).
+///     The n-1 off-diagonal elements of T.
+///
+/// @param[in] vl
+///     If range = Value, the lower bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] vu
+///     If range = Value, the upper bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] il
+///     If range = Index, the index of the
+///     smallest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] iu
+///     If range = Index, the index of the
+///     largest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] abstol
+///     The absolute error tolerance for the eigenvalues, as in stebz.
+///     If abstol <= 0, then eps*|T| will be used in its place, where
+///     |T| is the 1-norm of the tridiagonal matrix.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///     If range = All, nfound = n, and if range = Index,
+///     nfound = iu-il+1.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order. Eigenvalues in a cluster narrower than the
+///     tolerance are all set to the cluster's midpoint.
+///
+/// @param[out] Z
+///     The n-by-nfound matrix Z, stored in an ldz-by-nfound array.
+///     If jobz = Vec, the orthonormal eigenvectors, with the i-th column
+///     of Z holding the eigenvector associated with W(i).
+///     If jobz = NoVec, Z is not referenced.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1, and if
+///     jobz = Vec, ldz >= max(1,n).
+///
+/// @return = 0: successful exit.
+/// @return > 0: if info = i, then i eigenvectors failed to converge in
+///              inverse iteration; see lapack::stein.
+///
+template <typename scalar_t>
+int64_t tridiag_bisect(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D,
+    scalar_t const* E, scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    scalar_t abstol,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz )
+{
+    using real_t = scalar_t;
+    using internal::BisectInterval;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( range != Range::All && range != Range::Value
+                     && range != Range::Index );
+    lapack_error_if( n < 0 );
+    if (range == Range::Value) {
+        lapack_error_if( n > 0 && vu <= vl );
+    }
+    else if (range == Range::Index) {
+        lapack_error_if( il < 1 || il > max( 1, n ) );
+        lapack_error_if( iu < min( n, il ) || iu > n );
+    }
+    lapack_error_if( ldz < 1 || (jobz == Job::Vec && ldz < n) );
+
+    trace::internal::Block trace_block(
+        "tridiag_bisect", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    *nfound = 0;
+    if (n == 0)
+        return 0;
+
+    const real_t zero = 0;
+    const real_t one  = 1;
+    const real_t two  = 2;
+    const real_t eps    = std::numeric_limits< real_t >::epsilon();
+    const real_t safmin = std::numeric_limits< real_t >::min();
+    const real_t inf    = std::numeric_limits< real_t >::infinity();
+
+    // ---------- squared off-diagonal, Gershgorin interval [gl, gu],
+    // and split into unreduced blocks where E[ i ]^2 is negligible, as stebz
+    lapack::vector< real_t > E2( max( 1, n-1 ) );
+    std::vector< int64_t > blocks( 1, 0 );
+    real_t e2max = zero;
+    real_t gl = D[ 0 ], gu = D[ 0 ];
+    for (int64_t i = 0; i < n; ++i) {
+        real_t r = zero;
+        if (i > 0)
+            r += std::abs( E[ i-1 ] );
+        if (i < n-1) {
+            r += std::abs( E[ i ] );
+            E2[ i ] = E[ i ]*E[ i ];
+            e2max = max( e2max, E2[ i ] );
+            if (std::abs( D[ i ]*D[ i+1 ] )*eps*eps + safmin > E2[ i ])
+                blocks.push_back( i+1 );
+        }
+        gl = min( gl, D[ i ] - r );
+        gu = max( gu, D[ i ] + r );
+    }
+    blocks.push_back( n );
+    real_t tnorm = max( std::abs( gl ), std::abs( gu ) );
+    real_t pivmin = safmin * max( one, e2max );
+    // widen as stebz does, so Sturm counts at the ends are 0 and n
+    real_t fudge = two*tnorm*eps*n + two*two*pivmin;
+    gl -= fudge;
+    gu += fudge;
+
+    internal::BisectProblem< real_t > prob;
+    prob.n      = n;
+    prob.D      = D;
+    prob.E2     = E2.data();
+    prob.blocks = std::move( blocks );
+    prob.atol   = max( abstol > 0 ? abstol : eps*tnorm, pivmin );
+    prob.rtol   = two*eps;
+    prob.W      = W;
+
+    std::vector< int64_t > tmp;
+    auto sturm_count = [&]( real_t u ) {
+        int64_t c;
+        internal::bisect_counts( prob, 1, &u, &c, tmp );
+        return c;
+    };
+
+    // ---------- wanted indices [klo, khi) and starting interval [lo, hi)
+    real_t lo = gl, hi = gu;
+    if (range == Range::Index) {
+        prob.klo = il - 1;
+        prob.khi = iu;
+    }
+    else if (range == Range::Value) {
+        // eigenvalues in (vl, vu] are those with vl < lambda <= vu,
+        // so count eigenvalues < next float after vl and vu
+        prob.klo = (vl < gl ? 0 : (vl >= gu ? n
+                   : sturm_count( std::nextafter( vl, inf ) )));
+        prob.khi = (vu < gl ? 0 : (vu >= gu ? n
+                   : sturm_count( std::nextafter( vu, inf ) )));
+        lo = max( gl, vl );
+        hi = min( gu, std::nextafter( vu, inf ) );
+    }
+    else {
+        prob.klo = 0;
+        prob.khi = n;
+    }
+    int64_t m = max( int64_t( 0 ), prob.khi - prob.klo );
+    *nfound = m;
+    if (m == 0)
+        return 0;
+
+    // In case rounding puts eigenvalues outside [lo, hi), widen it.
+    int64_t clo = sturm_count( lo );
+    int64_t chi = sturm_count( hi );
+    for (int iter = 0; iter < 8 && (clo > prob.klo || chi < prob.khi); ++iter) {
+        real_t w = max( hi - lo, pivmin );
+        if (clo > prob.klo) {
+            lo -= w;
+            clo = sturm_count( lo );
+        }
+        if (chi < prob.khi) {
+            hi += w;
+            chi = sturm_count( hi );
+        }
+    }
+    lapack_error_if_msg( clo > prob.klo || chi < prob.khi,
+                         "Sturm counts not consistent at interval ends" );
+
+    // ---------- split into independent subintervals
+    // Enough tasks to balance threads, but enough eigenvalues per task
+    // to fill the SIMD lanes of each Sturm pass.
+    // Converged intervals are kept in done to assign eigenvectors to blocks.
+    bool wantz = (jobz == Job::Vec);
+    const int64_t L = 2 * internal::simd_width< real_t >();
+    int64_t nthreads = internal::num_threads();
+    int64_t ntasks = max( int64_t( 1 ), min( 4*nthreads, m / (2*L) ) );
+
+    std::vector< BisectInterval<real_t> > list, next, done;
+    std::vector< real_t > mid;
+    std::vector< int64_t > count;
+    list.push_back( { lo, hi, clo, chi } );
+    while (! list.empty() && int64_t( list.size() ) < ntasks) {
+        internal::bisect_step( prob, list, wantz ? &done : nullptr,
+                               next, mid, count, tmp );
+    }
+
+    // Group consecutive subintervals into tasks of about m / ntasks
+    // wanted eigenvalues each; task t holds list[ first[t] : first[t+1] ).
+    std::vector< size_t > first( 1, 0 );
+    if (! list.empty()) {
+        int64_t per_task = (m + ntasks - 1) / ntasks;
+        int64_t sum = 0;
+        for (size_t i = 0; i < list.size(); ++i) {
+            sum += min( list[ i ].cb, prob.khi ) - max( list[ i ].ca, prob.klo );
+            if (sum >= per_task) {
+                first.push_back( i + 1 );
+                sum = 0;
+            }
+        }
+        if (first.back() != list.size())
+            first.push_back( list.size() );
+    }
+    ntasks = first.size() - 1;
+
+    // ---------- refine each task's subintervals in parallel
+    std::vector< std::vector< BisectInterval<real_t> > > done_task( ntasks );
+    internal::parallel_for( ntasks, [&]( int64_t t, int worker ) {
+        std::vector< BisectInterval<real_t> > list_t(
+            list.begin() + first[ t ], list.begin() + first[ t+1 ] );
+        std::vector< BisectInterval<real_t> > next_t;
+        std::vector< real_t > mid_t;
+        std::vector< int64_t > count_t, tmp_t;
+        while (! list_t.empty()) {
+            internal::bisect_step( prob, list_t,
+                                   wantz ? &done_task[ t ] : nullptr,
+                                   next_t, mid_t, count_t, tmp_t );
+        }
+    });
+
+    if (! wantz)
+        return 0;
+
+    // ---------- assign eigenvalues to blocks
+    // Within each converged interval, block j holds
+    // sturm_j( b ) - sturm_j( a ) of its eigenvalues; ties are given to
+    // blocks in order. member[ j ] lists wanted indices k - klo in block j.
+    for (auto const& done_t : done_task)
+        done.insert( done.end(), done_t.begin(), done_t.end() );
+    int64_t ndone = done.size();
+    int64_t nblocks = prob.blocks.size() - 1;
+
+    std::vector< real_t > ends( 2*ndone );
+    std::vector< int64_t > next_k( ndone );
+    for (int64_t i = 0; i < ndone; ++i) {
+        ends[ 2*i   ] = done[ i ].a;
+        ends[ 2*i+1 ] = done[ i ].b;
+        next_k[ i ] = done[ i ].ca;
+    }
+    std::vector< std::vector< int64_t > > member( nblocks );
+    count.resize( 2*ndone );
+    for (int64_t j = 0; j < nblocks; ++j) {
+        int64_t i1 = prob.blocks[ j ];
+        int64_t nb = prob.blocks[ j+1 ] - i1;
+        internal::sturm_counts( nb, D + i1, E2.data() + i1, 2*ndone,
+                                ends.data(), count.data() );
+        for (int64_t i = 0; i < ndone; ++i) {
+            int64_t k2 = min( next_k[ i ] + count[ 2*i+1 ] - count[ 2*i ],
+                              done[ i ].cb );
+            for (int64_t k = next_k[ i ]; k < k2; ++k) {
+                if (prob.klo <= k && k < prob.khi)
+                    member[ j ].push_back( k - prob.klo );
+            }
+            next_k[ i ] = max( next_k[ i ], k2 );
+        }
+    }
+    for (auto& member_j : member)
+        std::sort( member_j.begin(), member_j.end() );
+
+    // ---------- eigenvectors by inverse iteration
+    // In each block, stein reorthogonalizes vectors whose eigenvalues are
+    // within 1e-3 |T_j| of each other; split where gaps are larger than
+    // that, so clusters are independent and can run in parallel.
+    struct Cluster {
+        int64_t block;
+        size_t j1, j2;  // member[ block ][ j1 : j2 ]
+    };
+    std::vector< Cluster > clusters;
+    for (int64_t j = 0; j < nblocks; ++j) {
+        if (member[ j ].empty())
+            continue;
+        int64_t i1 = prob.blocks[ j ];
+        int64_t i2 = prob.blocks[ j+1 ];
+        real_t onenrm = zero;
+        for (int64_t i = i1; i < i2; ++i) {
+            real_t r = std::abs( D[ i ] );
+            if (i > i1)
+                r += std::abs( E[ i-1 ] );
+            if (i < i2-1)
+                r += std::abs( E[ i ] );
+            onenrm = max( onenrm, r );
+        }
+        real_t ortol = real_t( 1e-3 ) * onenrm;
+
+        auto const& mj = member[ j ];
+        size_t c1 = 0;
+        for (size_t c = 1; c <= mj.size(); ++c) {
+            if (c == mj.size() || W[ mj[ c ] ] - W[ mj[ c-1 ] ] > ortol) {
+                clusters.push_back( { j, c1, c } );
+                c1 = c;
+            }
+        }
+    }
+    int64_t nclusters = clusters.size();
+
+    // Vectors are zero outside their block.
+    lapack::laset( MatrixType::General, n, m, zero, zero, Z, ldz );
+
+    std::vector< int64_t > info( nclusters );
+    internal::parallel_for( nclusters, [&]( int64_t c, int worker ) {
+        auto const& cl = clusters[ c ];
+        auto const& mj = member[ cl.block ];
+        int64_t i1 = prob.blocks[ cl.block ];
+        int64_t nb = prob.blocks[ cl.block+1 ] - i1;
+        int64_t mc = cl.j2 - cl.j1;
+
+        lapack::vector< real_t > Wc( mc ), Zc( nb*mc );
+        std::vector< int64_t > iblock( nb, 1 ), isplit( nb, 0 ), ifail( mc );
+        isplit[ 0 ] = nb;
+        for (int64_t k = 0; k < mc; ++k)
+            Wc[ k ] = W[ mj[ cl.j1 + k ] ];
+
+        info[ c ] = lapack::stein(
+            nb, D + i1, E + i1,
+            mc, Wc.data(), iblock.data(), isplit.data(),
+            Zc.data(), nb, ifail.data() );
+
+        for (int64_t k = 0; k < mc; ++k) {
+            int64_t col = mj[ cl.j1 + k ];
+            std::copy( &Zc[ k*nb ], &Zc[ k*nb ] + nb, &Z[ i1 + col*ldz ] );
+        }
+    });
+
+    int64_t nfailed = 0;
+    for (int64_t c = 0; c < nclusters; ++c)
+        nfailed += info[ c ];
+    return nfailed;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t tridiag_bisect(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float const* D,
+    float const* E, float vl, float vu, int64_t il, int64_t iu,
+    float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz );
+
+template
+int64_t tridiag_bisect(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double const* D,
+    double const* E, double vl, double vu, int64_t il, int64_t iu,
+    double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz );
+
+}  // namespace lapack
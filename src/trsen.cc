@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 #include <vector>
 
@@ -32,11 +33,16 @@ int64_t trsen(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trsen", 's', -1, n, -1,
+        []() { return 0.0; } );
+
     char sense_ = sense2char( sense );
     char compq_ = job_comp2char( compq );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -46,8 +52,8 @@ int64_t trsen(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
+    lapack::small_vector< float > WR( max( 1, n ) );
+    lapack::small_vector< float > WI( max( 1, n ) );
 
     // query for workspace size
     float qry_work[1];
@@ -74,8 +80,8 @@ int64_t trsen(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< float > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_strsen(
         &sense_, &compq_,
@@ -119,11 +125,16 @@ int64_t trsen(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trsen", 'd', -1, n, -1,
+        []() { return 0.0; } );
+
     char sense_ = sense2char( sense );
     char compq_ = job_comp2char( compq );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -133,8 +144,8 @@ int64_t trsen(
     lapack_int info_ = 0;
 
     // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
+    lapack::small_vector< double > WR( max( 1, n ) );
+    lapack::small_vector< double > WI( max( 1, n ) );
 
     // query for workspace size
     double qry_work[1];
@@ -161,8 +172,8 @@ int64_t trsen(
     lapack_int liwork_ = real(qry_iwork[0]);
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::small_vector< double > work( lwork_ );
+    lapack::small_vector< lapack_int > iwork( liwork_ );
 
     LAPACK_dtrsen(
         &sense_, &compq_,
@@ -206,11 +217,16 @@ int64_t trsen(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trsen", 'c', -1, n, -1,
+        []() { return 0.0; } );
+
     char sense_ = sense2char( sense );
     char compq_ = job_comp2char( compq );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -239,7 +255,7 @@ int64_t trsen(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::small_vector< std::complex<float> > work( lwork_ );
 
     LAPACK_ctrsen(
         &sense_, &compq_,
@@ -276,11 +292,16 @@ int64_t trsen(
         lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trsen", 'z', -1, n, -1,
+        []() { return 0.0; } );
+
     char sense_ = sense2char( sense );
     char compq_ = job_comp2char( compq );
 
     // lapack_logical (32 or 64-bit) copy
-    std::vector< lapack_logical > select_( &select[0], &select[(n)] );
+    lapack::small_vector< lapack_logical > select_( &select[0], &select[(n)] );
     lapack_logical const* select_ptr = &select_[0];
 
     lapack_int n_ = (lapack_int) n;
@@ -309,7 +330,7 @@ int64_t trsen(
     lapack_int lwork_ = real(qry_work[0]);
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::small_vector< std::complex<double> > work( lwork_ );
 
     LAPACK_ztrsen(
         &sense_, &compq_,
@@ -329,4 +350,365 @@ int64_t trsen(
     return info_;
 }
 
+//------------------------------------------------------------------------------
+// Intermediate wrappers around LAPACK to deal with precisions.
+// Real precisions return eigenvalues in split-complex (WR, WI)
+// and don't reference W; complex precisions return W directly,
+// and don't reference WR, WI, or iwork.
+static void fortran_trsen(
+    char sense, char compq,
+    lapack_logical const* select, lapack_int n,
+    float* T, lapack_int ldt,
+    float* Q, lapack_int ldq,
+    std::complex<float>* W, float* WR, float* WI,
+    lapack_int* m, float* s, float* sep,
+    float* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_strsen(
+        &sense, &compq,
+        select, &n,
+        T, &ldt,
+        Q, &ldq,
+        WR, WI,
+        m, s, sep,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trsen(
+    char sense, char compq,
+    lapack_logical const* select, lapack_int n,
+    double* T, lapack_int ldt,
+    double* Q, lapack_int ldq,
+    std::complex<double>* W, double* WR, double* WI,
+    lapack_int* m, double* s, double* sep,
+    double* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_dtrsen(
+        &sense, &compq,
+        select, &n,
+        T, &ldt,
+        Q, &ldq,
+        WR, WI,
+        m, s, sep,
+        work, &lwork,
+        iwork, &liwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trsen(
+    char sense, char compq,
+    lapack_logical const* select, lapack_int n,
+    std::complex<float>* T, lapack_int ldt,
+    std::complex<float>* Q, lapack_int ldq,
+    std::complex<float>* W, float* WR, float* WI,
+    lapack_int* m, float* s, float* sep,
+    std::complex<float>* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_ctrsen(
+        &sense, &compq,
+        select, &n,
+        (lapack_complex_float*) T, &ldt,
+        (lapack_complex_float*) Q, &ldq,
+        (lapack_complex_float*) W, m, s, sep,
+        (lapack_complex_float*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//----------
+static void fortran_trsen(
+    char sense, char compq,
+    lapack_logical const* select, lapack_int n,
+    std::complex<double>* T, lapack_int ldt,
+    std::complex<double>* Q, lapack_int ldq,
+    std::complex<double>* W, double* WR, double* WI,
+    lapack_int* m, double* s, double* sep,
+    std::complex<double>* work, lapack_int lwork,
+    lapack_int* iwork, lapack_int liwork, lapack_int* info )
+{
+    LAPACK_ztrsen(
+        &sense, &compq,
+        select, &n,
+        (lapack_complex_double*) T, &ldt,
+        (lapack_complex_double*) Q, &ldq,
+        (lapack_complex_double*) W, m, s, sep,
+        (lapack_complex_double*) work, &lwork, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//------------------------------------------------------------------------------
+/// Computes the size of workspace needed by trsen with caller-provided
+/// workspace. Only select is referenced, since the workspace depends
+/// on the number of selected eigenvalues.
+///
+/// @param[out] work_size
+///     Size of workspace, in bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    blas::complex_type<scalar_t>* W,
+    size_t* work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+    char sense_ = sense2char( sense );
+    char compq_ = job_comp2char( compq );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int m_ = 0;
+    lapack_int info_ = 0;
+
+    // workspace depends on the number of selected eigenvalues
+    lapack::small_vector< lapack_logical > select_vec( select, select + n );
+    lapack_logical* select_ = select_vec.data();
+
+    // query for workspace size
+    real_t s_, sep_;
+    scalar_t qry_work[1];
+    lapack_int qry_iwork[1] = { 0 };
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int ineg_one = -1;
+    fortran_trsen(
+        sense_, compq_,
+        select_, n_,
+        T, ldt_,
+        Q, ldq_,
+        W, qry_WR, qry_WI,
+        &m_, &s_, &sep_,
+        qry_work, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int liwork_ = is_complex ? 0 : qry_iwork[0];
+
+    internal::WorkBuffer buffer;
+    buffer.take< lapack_logical >( n );  // select
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WR
+    buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );  // WI
+    buffer.take< lapack_int >( liwork_ );
+    buffer.take< scalar_t >( lwork_ );
+    *work_size = buffer.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// Same as lapack::trsen, but with caller-provided workspace
+/// instead of allocating it.
+/// See lapack::trsen for the other arguments.
+///
+/// @param[in] work
+///     Workspace buffer of work_size bytes.
+///
+/// @param[in] work_size
+///     Size of work, in bytes, at least that returned by
+///     trsen_work_size_bytes.
+///
+/// @ingroup work
+template <typename scalar_t>
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    scalar_t* T, int64_t ldt,
+    scalar_t* Q, int64_t ldq,
+    blas::complex_type<scalar_t>* W,
+    int64_t* m,
+    blas::real_type<scalar_t>* s,
+    blas::real_type<scalar_t>* sep,
+    void* work, size_t work_size )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using complex_t = blas::complex_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldq) > std::numeric_limits<lapack_int>::max() );
+    }
+
+    trace::internal::Block trace_block(
+        "trsen", trace::internal::precision< scalar_t >(), -1, n, -1,
+        []() { return 0.0; } );
+
+    char sense_ = sense2char( sense );
+    char compq_ = job_comp2char( compq );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldt_ = (lapack_int) ldt;
+    lapack_int ldq_ = (lapack_int) ldq;
+    lapack_int m_ = (lapack_int) *m;
+    lapack_int info_ = 0;
+
+    // carve workspace arrays from buffer
+    internal::WorkBuffer buffer( work, work_size );
+    lapack_logical* select_ = buffer.take< lapack_logical >( n );
+    std::copy( select, select + n, select_ );
+    real_t* WR = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+    real_t* WI = buffer.take< real_t >( is_complex ? 0 : max( 1, n ) );
+
+    // query for size of iwork
+    scalar_t qry_work[1];
+    lapack_int qry_iwork[1] = { 0 };
+    real_t qry_WR[1], qry_WI[1];
+    lapack_int ineg_one = -1;
+    fortran_trsen(
+        sense_, compq_,
+        select_, n_,
+        T, ldt_,
+        Q, ldq_,
+        W, qry_WR, qry_WI,
+        &m_, s, sep,
+        qry_work, ineg_one,
+        qry_iwork, ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int liwork_ = is_complex ? 0 : qry_iwork[0];
+
+    // work gets the rest
+    lapack_int* iwork_ = buffer.take< lapack_int >( liwork_ );
+    lapack_int lwork_ = buffer.remaining< scalar_t >();
+    scalar_t* work_ = buffer.take< scalar_t >( lwork_ );
+
+    fortran_trsen(
+        sense_, compq_,
+        select_, n_,
+        T, ldt_,
+        Q, ldq_,
+        W, WR, WI,
+        &m_, s, sep,
+        work_, lwork_,
+        iwork_, liwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *m = m_;
+    if (! is_complex) {
+        // merge split-complex representation
+        for (int64_t i = 0; i < n; ++i) {
+            W[i] = complex_t( WR[i], WI[i] );
+        }
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    float* T, int64_t ldt,
+    float* Q, int64_t ldq,
+    std::complex<float>* W,
+    size_t* work_size );
+
+template
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    double* T, int64_t ldt,
+    double* Q, int64_t ldq,
+    std::complex<double>* W,
+    size_t* work_size );
+
+template
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* W,
+    size_t* work_size );
+
+template
+void trsen_work_size_bytes(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* W,
+    size_t* work_size );
+
+//--------------------
+template
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    float* T, int64_t ldt,
+    float* Q, int64_t ldq,
+    std::complex<float>* W,
+    int64_t* m,
+    float* s,
+    float* sep,
+    void* work, size_t work_size );
+
+template
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    double* T, int64_t ldt,
+    double* Q, int64_t ldq,
+    std::complex<double>* W,
+    int64_t* m,
+    double* s,
+    double* sep,
+    void* work, size_t work_size );
+
+template
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    std::complex<float>* T, int64_t ldt,
+    std::complex<float>* Q, int64_t ldq,
+    std::complex<float>* W,
+    int64_t* m,
+    float* s,
+    float* sep,
+    void* work, size_t work_size );
+
+template
+int64_t trsen(
+    lapack::Sense sense, lapack::Job compq,
+    bool const* select, int64_t n,
+    std::complex<double>* T, int64_t ldt,
+    std::complex<double>* Q, int64_t ldq,
+    std::complex<double>* W,
+    int64_t* m,
+    double* s,
+    double* sep,
+    void* work, size_t work_size );
+
 }  // namespace lapack
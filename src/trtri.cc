@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
 
 #include <vector>
 
@@ -24,6 +25,11 @@ int64_t trtri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trtri", 's', -1, n, -1,
+        [&]() { return Gflop< float >::trtri( n ); } );
+
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
     lapack_int n_ = (lapack_int) n;
@@ -53,6 +59,11 @@ int64_t trtri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trtri", 'd', -1, n, -1,
+        [&]() { return Gflop< double >::trtri( n ); } );
+
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
     lapack_int n_ = (lapack_int) n;
@@ -82,6 +93,11 @@ int64_t trtri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trtri", 'c', -1, n, -1,
+        [&]() { return Gflop< std::complex<float> >::trtri( n ); } );
+
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
     lapack_int n_ = (lapack_int) n;
@@ -111,6 +127,11 @@ int64_t trtri(
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
         lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
     }
+
+    trace::internal::Block trace_block(
+        "trtri", 'z', -1, n, -1,
+        [&]() { return Gflop< std::complex<double> >::trtri( n ); } );
+
     char uplo_ = uplo2char( uplo );
     char diag_ = diag2char( diag );
     lapack_int n_ = (lapack_int) n;
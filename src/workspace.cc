@@ -0,0 +1,333 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/workspace.hh"
+#include "lapack/allocator.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace lapack {
+namespace internal {
+
+workspace::Allocator* current_allocator();  // see allocator.cc
+
+//------------------------------------------------------------------------------
+// All workspace is aligned to, and sized in multiples of, a cache line.
+const size_t workspace_align = 64;
+
+// Zero-byte requests get one cache line, so every block has a unique address.
+inline size_t workspace_roundup( size_t bytes )
+{
+    bytes = std::max( bytes, size_t( 1 ) );
+    return (bytes + workspace_align - 1) / workspace_align * workspace_align;
+}
+
+//------------------------------------------------------------------------------
+/// Allocates bytes from the heap, aligned to 64 bytes.
+/// @throws std::bad_alloc if allocation fails.
+void* aligned_malloc( size_t bytes )
+{
+    void* ptr = nullptr;
+    #if defined( _WIN32 ) || defined( _WIN64 )
+        ptr = _aligned_malloc( bytes, workspace_align );
+        if (ptr != nullptr)
+            return ptr;
+    #else
+        int err = posix_memalign( &ptr, workspace_align, bytes );
+        if (err == 0)
+            return ptr;
+    #endif
+    throw std::bad_alloc();
+}
+
+//------------------------------------------------------------------------------
+/// Frees memory allocated by aligned_malloc.
+void aligned_free( void* ptr ) noexcept
+{
+    #if defined( _WIN32 ) || defined( _WIN64 )
+        _aligned_free( ptr );
+    #else
+        free( ptr );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+// Blocks from an allocator are preceded by a header, one cache line so the
+// block stays aligned, that holds the allocator. The block is freed by that
+// allocator even if the current allocator changed meanwhile.
+const size_t header_bytes = workspace_align;
+
+inline workspace::Allocator*& header_allocator( char* block )
+{
+    return *reinterpret_cast< workspace::Allocator** >( block );
+}
+
+//------------------------------------------------------------------------------
+// Thread-local stack allocator. Allocations that fit are carved off the top
+// of one contiguous buffer; those that don't fit go to the current
+// allocator (see workspace::set_allocator), with a header, and the
+// buffer is grown to the high-water mark once nothing is outstanding.
+// Wrappers release workspace in reverse order of allocation, so top_
+// usually drops back with each deallocation; in any case it is reset
+// when the last outstanding block is returned.
+class Arena
+{
+public:
+    Arena():
+        buffer_( nullptr ),
+        buffer_allocator_( nullptr ),
+        capacity_( 0 ),
+        top_( 0 ),
+        live_( 0 ),
+        used_( 0 ),
+        high_water_( 0 ),
+        enabled_( false ),
+        release_pending_( false )
+    {}
+
+    ~Arena()
+    {
+        resize( 0 );
+    }
+
+    // Disable copying.
+    Arena( Arena const& ) = delete;
+    Arena& operator=( Arena const& ) = delete;
+
+    //----------------------------------------
+    void* allocate( size_t bytes, const char* routine )
+    {
+        bytes = workspace_roundup( bytes );
+        if (used_ == 0 && capacity_ < high_water_ && enabled_)
+            resize( high_water_ );
+
+        void* ptr;
+        if (enabled_ && top_ + bytes <= capacity_) {
+            ptr = buffer_ + top_;
+            top_ += bytes;
+            live_ += 1;
+        }
+        else {
+            workspace::Allocator* alloc = current_allocator();
+            char* block = static_cast<char*>(
+                alloc->allocate( header_bytes + bytes, routine ) );
+            header_allocator( block ) = alloc;
+            ptr = block + header_bytes;
+        }
+        // Track high-water even while disabled, so reserve() can be sized
+        // from a trial run.
+        used_ += bytes;
+        high_water_ = std::max( high_water_, used_ );
+        return ptr;
+    }
+
+    //----------------------------------------
+    void deallocate( void* ptr, size_t bytes ) noexcept
+    {
+        bytes = workspace_roundup( bytes );
+        char* p = static_cast<char*>( ptr );
+        if (buffer_ != nullptr && p >= buffer_ && p < buffer_ + capacity_) {
+            live_ -= 1;
+            if (p + bytes == buffer_ + top_)
+                top_ = p - buffer_;  // pop top of stack
+            if (live_ == 0) {
+                top_ = 0;
+                if (release_pending_)
+                    resize( 0 );
+            }
+        }
+        else {
+            char* block = p - header_bytes;
+            header_allocator( block )->deallocate( block, header_bytes + bytes );
+        }
+        used_ -= std::min( used_, bytes );
+    }
+
+    //----------------------------------------
+    // Re-allocates buffer with given capacity; requires live_ == 0.
+    void resize( size_t bytes )
+    {
+        if (buffer_ != nullptr)
+            buffer_allocator_->deallocate( buffer_, capacity_ );
+        buffer_   = nullptr;
+        buffer_allocator_ = nullptr;
+        capacity_ = 0;
+        release_pending_ = false;
+        if (bytes > 0) {
+            workspace::Allocator* alloc = current_allocator();
+            buffer_   = static_cast<char*>( alloc->allocate( bytes, "arena" ) );
+            buffer_allocator_ = alloc;
+            capacity_ = bytes;
+        }
+    }
+
+    //----------------------------------------
+    void reserve( size_t bytes )
+    {
+        bytes = workspace_roundup( bytes );
+        high_water_ = std::max( high_water_, bytes );
+        if (live_ == 0 && capacity_ < bytes)
+            resize( bytes );
+    }
+
+    //----------------------------------------
+    void release()
+    {
+        high_water_ = used_;
+        if (live_ == 0)
+            resize( 0 );
+        else
+            release_pending_ = true;
+    }
+
+    void   enable( bool enabled ) { enabled_ = enabled; }
+    bool   enabled()    const { return enabled_;    }
+    size_t size()       const { return capacity_;   }
+    size_t high_water() const { return high_water_; }
+
+private:
+    char*  buffer_;
+    workspace::Allocator* buffer_allocator_;  ///< allocator of buffer_
+    size_t capacity_;         ///< bytes in buffer_
+    size_t top_;              ///< offset of first free byte in buffer_
+    size_t live_;             ///< number of blocks outstanding in buffer_
+    size_t used_;             ///< bytes outstanding, in buffer_ or heap
+    size_t high_water_;       ///< max of used_
+    bool   enabled_;
+    bool   release_pending_;  ///< free buffer_ when live_ drops to 0
+};
+
+//------------------------------------------------------------------------------
+std::atomic< size_t > stack_threshold( LAPACK_SMALL_BUFFER_BYTES );
+
+//------------------------------------------------------------------------------
+/// @return this thread's workspace arena.
+Arena& thread_arena()
+{
+    static thread_local Arena arena;
+    return arena;
+}
+
+//------------------------------------------------------------------------------
+/// Allocates workspace for lapack::vector. Uses the thread's workspace arena
+/// if it is enabled, otherwise the current allocator.
+/// routine is the name of the calling LAPACK++ routine, or nullptr.
+void* workspace_allocate( size_t bytes, const char* routine )
+{
+    return thread_arena().allocate( bytes, routine );
+}
+
+//------------------------------------------------------------------------------
+/// Frees workspace allocated by workspace_allocate.
+void workspace_deallocate( void* ptr, size_t bytes ) noexcept
+{
+    thread_arena().deallocate( ptr, bytes );
+}
+
+}  // namespace internal
+
+namespace workspace {
+
+//------------------------------------------------------------------------------
+/// Enables or disables the workspace arena on the calling thread.
+/// Disabling it does not free the arena's memory; see release().
+///
+/// @param[in] enabled
+///     Whether LAPACK++ routines called on this thread take
+///     workspace from the arena (true) or from the heap (false).
+///
+/// @ingroup workspace
+void enable( bool enabled )
+{
+    internal::thread_arena().enable( enabled );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if the workspace arena is enabled on the calling thread.
+///
+/// @ingroup workspace
+bool enabled()
+{
+    return internal::thread_arena().enabled();
+}
+
+//------------------------------------------------------------------------------
+/// @return size, in bytes, of the calling thread's arena buffer.
+///
+/// @ingroup workspace
+size_t size()
+{
+    return internal::thread_arena().size();
+}
+
+//------------------------------------------------------------------------------
+/// @return high-water mark, in bytes, of workspace simultaneously in use
+/// by LAPACK++ routines on the calling thread, since the thread started
+/// or since the last release(). This is tracked even when the arena is
+/// disabled, so it can be used to size reserve().
+///
+/// @ingroup workspace
+size_t high_water()
+{
+    return internal::thread_arena().high_water();
+}
+
+//------------------------------------------------------------------------------
+/// Ensures the calling thread's arena has at least the given capacity,
+/// so that subsequent calls needing that much workspace do no heap
+/// allocation, even on the first call.
+///
+/// @param[in] bytes
+///     Capacity to reserve, in bytes.
+///
+/// @ingroup workspace
+void reserve( size_t bytes )
+{
+    internal::thread_arena().reserve( bytes );
+}
+
+//------------------------------------------------------------------------------
+/// Frees the calling thread's arena buffer and resets its high-water mark.
+/// If workspace is still in use (i.e., called from within a LAPACK++
+/// routine), the buffer is freed once that workspace is returned.
+///
+/// @ingroup workspace
+void release()
+{
+    internal::thread_arena().release();
+}
+
+//------------------------------------------------------------------------------
+/// Sets the size below which wrappers put workspace arrays (work, iwork,
+/// rwork, and 32-bit copies of integer arrays) in an on-stack buffer
+/// instead of allocating them, so tiny problems do no heap allocation.
+/// This applies to all threads. It is limited to the compile-time capacity
+/// LAPACK_SMALL_BUFFER_BYTES (default 1024 bytes); setting it to 0 always
+/// allocates, e.g., to measure the difference.
+///
+/// @param[in] bytes
+///     Arrays of at most this many bytes go on the stack.
+///
+/// @ingroup workspace
+void set_stack_threshold( size_t bytes )
+{
+    internal::stack_threshold.store(
+        std::min( bytes, size_t( LAPACK_SMALL_BUFFER_BYTES ) ) );
+}
+
+//------------------------------------------------------------------------------
+/// @return size below which workspace arrays go on the stack;
+/// see set_stack_threshold().
+///
+/// @ingroup workspace
+size_t stack_threshold()
+{
+    return internal::stack_threshold.load();
+}
+
+}  // namespace workspace
+}  // namespace lapack
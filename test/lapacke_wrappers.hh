@@ -6189,6 +6189,139 @@ inline lapack_int LAPACKE_larfy(
 }
 #endif // 30700
 
+// -----------------------------------------------------------------------------
+inline lapack_int LAPACKE_lapmr(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_slapmr(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmr(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_dlapmr(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmr(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_clapmr(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        (lapack_complex_float*) A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmr(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_zlapmr(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        (lapack_complex_double*) A, lda,
+        K );
+}
+
+// -----------------------------------------------------------------------------
+inline lapack_int LAPACKE_lapmt(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_slapmt(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmt(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_dlapmt(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmt(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_clapmt(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        (lapack_complex_float*) A, lda,
+        K );
+}
+
+inline lapack_int LAPACKE_lapmt(
+    lapack_logical forwrd, lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* K )
+{
+    return LAPACKE_zlapmt(
+        LAPACK_COL_MAJOR, forwrd, m, n,
+        (lapack_complex_double*) A, lda,
+        K );
+}
+
+// -----------------------------------------------------------------------------
+#if LAPACK_VERSION >= 30600  // >= 3.6.0
+inline lapack_int LAPACKE_lascl(
+    char type, lapack_int kl, lapack_int ku, float cfrom, float cto,
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda )
+{
+    return LAPACKE_slascl(
+        LAPACK_COL_MAJOR, type, kl, ku, cfrom, cto, m, n,
+        A, lda );
+}
+
+inline lapack_int LAPACKE_lascl(
+    char type, lapack_int kl, lapack_int ku, double cfrom, double cto,
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda )
+{
+    return LAPACKE_dlascl(
+        LAPACK_COL_MAJOR, type, kl, ku, cfrom, cto, m, n,
+        A, lda );
+}
+
+inline lapack_int LAPACKE_lascl(
+    char type, lapack_int kl, lapack_int ku, float cfrom, float cto,
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda )
+{
+    return LAPACKE_clascl(
+        LAPACK_COL_MAJOR, type, kl, ku, cfrom, cto, m, n,
+        (lapack_complex_float*) A, lda );
+}
+
+inline lapack_int LAPACKE_lascl(
+    char type, lapack_int kl, lapack_int ku, double cfrom, double cto,
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda )
+{
+    return LAPACKE_zlascl(
+        LAPACK_COL_MAJOR, type, kl, ku, cfrom, cto, m, n,
+        (lapack_complex_double*) A, lda );
+}
+#endif // 30600
+
 // -----------------------------------------------------------------------------
 inline lapack_int LAPACKE_laset(
     char uplo, lapack_int m, lapack_int n, float alpha, float beta,
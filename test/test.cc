@@ -43,6 +43,8 @@ enum Section {
     blas2,
     blas3,
     gpu,
+    fixed,
+    util,
     num_sections,  // last
 };
 
@@ -66,6 +68,8 @@ const char* section_names[] = {
    "Level 2 BLAS (additional)",
    "Level 3 BLAS (additional)",
    "GPU device functions",
+   "fixed-size kernels",
+   "workspace and instrumentation",
 };
 
 // { "", nullptr, Section::newline } entries force newline in help
@@ -95,6 +99,12 @@ std::vector< testsweeper::routines_t > routines = {
     { "getri",              test_getri,     Section::gesv },    // lawn 41 test
     { "",                   nullptr,        Section::newline },
 
+    { "gesv_tiny",          test_gesv_tiny, Section::gesv },    // per-call overhead
+    { "getrf_batch",        test_getrf_batch, Section::gesv },  // matrices/s
+    { "getrf_async",        test_getrf_async, Section::gesv },  // overlap
+    { "getrf_interleaved",  test_getrf_interleaved, Section::gesv },  // matrices/s
+    { "",                   nullptr,        Section::newline },
+
     { "gecon",              test_gecon,     Section::gesv },
     { "gbcon",              test_gbcon,     Section::gesv },
     { "gtcon",              test_gtcon,     Section::gesv },
@@ -133,6 +143,10 @@ std::vector< testsweeper::routines_t > routines = {
     { "pptri",              test_pptri,     Section::posv },
     { "",                   nullptr,        Section::newline },
 
+    { "potrf_batch",        test_potrf_batch, Section::posv },  // matrices/s
+    { "potrf_interleaved",  test_potrf_interleaved, Section::posv },  // matrices/s
+    { "",                   nullptr,        Section::newline },
+
     { "pocon",              test_pocon,     Section::posv },
     { "ppcon",              test_ppcon,     Section::posv },
     { "pbcon",              test_pbcon,     Section::posv },
@@ -231,6 +245,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "gelsy",              test_gelsy,     Section::gels }, // tested via LAPACKE using gcc/MKL TODO jpvt[i]=i rcond=0
     { "gelsd",              test_gelsd,     Section::gels }, // TODO: Segfaults for some Z sizes. src/gelsd.cc:275 lrwork_ too small?
     { "gelss",              test_gelss,     Section::gels }, // tested via LAPACKE using gcc/MKL TODO rcond=n
+    { "gels_batch",         test_gels_batch,  Section::gels },  // matrices/s
+    { "gelsd_batch",        test_gelsd_batch, Section::gels },  // matrices/s
     { "getsls",             test_getsls,    Section::gels }, // tested via LAPACKE using gcc/MKL
     { "",                   nullptr,        Section::newline },
 
@@ -242,6 +258,7 @@ std::vector< testsweeper::routines_t > routines = {
     // QR, LQ, RQ, QL
     { "geqr",               test_geqr,      Section::qr }, // tested numerically
     { "geqrf",              test_geqrf,     Section::qr }, // tested numerically
+    { "geqrf_batch",        test_geqrf_batch, Section::qr },  // matrices/s
     { "gelqf",              test_gelqf,     Section::qr }, // tested numerically
     { "geqlf",              test_geqlf,     Section::qr }, // tested numerically
     { "gerqf",              test_gerqf,     Section::qr }, // tested numerically; R, Q are full sizeof(A), could be smaller
@@ -289,6 +306,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "hpev",               test_hpev,      Section::heev }, // tested via LAPACKE
     { "hbev",               test_hbev,      Section::heev }, // tested via LAPACKE
     { "sturm",              test_sturm,     Section::heev },
+    { "sturm_multi",        test_sturm_multi, Section::heev },
+    { "tridiag_bisect",     test_tridiag_bisect, Section::heev },
     { "",                   nullptr,        Section::newline },
 
     { "heevx",              test_heevx,     Section::heev }, // tested via LAPACKE
@@ -299,9 +318,11 @@ std::vector< testsweeper::routines_t > routines = {
     { "heevd",              test_heevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "hpevd",              test_hpevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "hbevd",              test_hbevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
+    { "heevd_batch",        test_heevd_batch, Section::heev },  // matrices/s
     { "",                   nullptr,        Section::newline },
 
     { "heevr",              test_heevr,     Section::heev }, // tested via LAPACKE using gcc/MKL
+    { "heevr_batch",        test_heevr_batch, Section::heev },  // matrices/s
     { "",                   nullptr,        Section::newline },
 
     { "hetrd",              test_hetrd,     Section::heev }, // tested via LAPACKE using gcc/MKL
@@ -345,6 +366,7 @@ std::vector< testsweeper::routines_t > routines = {
     // non-symmetric eigenvalues
     { "geev",               test_geev,      Section::geev },
     { "ggev",               test_ggev,      Section::geev }, // tested via LAPACKE using gcc/MKL. NOTE: No doxygen in src/ggev.cc
+    { "geev_batch",         test_geev_batch, Section::geev },  // matrices/s
     { "",                   nullptr,        Section::newline },
 
   //{ "geevx",              test_geevx,     Section::geev }, // TODO No src
@@ -369,10 +391,12 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // driver: singular value decomposition
     { "gesvd",              test_gesvd,         Section::svd },
+    { "gesvd_batch",        test_gesvd_batch,   Section::svd },  // matrices/s
   //{ "gesvd_2stage",       test_gesvd_2stage,  Section::svd }, // TODO No src
     { "",                   nullptr,            Section::newline },
 
     { "gesdd",              test_gesdd,         Section::svd },
+    { "gesdd_batch",        test_gesdd_batch,   Section::svd },  // matrices/s
   //{ "gesdd_2stage",       test_gesdd_2stage,  Section::svd }, // TODO No src
     { "",                   nullptr,            Section::newline },
 
@@ -388,6 +412,9 @@ std::vector< testsweeper::routines_t > routines = {
     // auxiliary
     { "lacpy",              test_lacpy,     Section::aux },
     { "laed4",              test_laed4,     Section::aux },
+    { "lapmr",              test_lapmr,     Section::aux },
+    { "lapmt",              test_lapmt,     Section::aux },
+    { "lascl",              test_lascl,     Section::aux },
     { "laset",              test_laset,     Section::aux },
     { "laswp",              test_laswp,     Section::aux },
     { "",                   nullptr,        Section::newline },
@@ -447,6 +474,30 @@ std::vector< testsweeper::routines_t > routines = {
     { "dev-potrf",          test_potrf_device,  Section::gpu },
     { "dev-getrf",          test_getrf_device,  Section::gpu },
     { "dev-geqrf",          test_geqrf_device,  Section::gpu },
+    { "dev-potrs",          test_potrs_device,  Section::gpu },
+    { "dev-getrs",          test_getrs_device,  Section::gpu },
+    { "dev-unmqr",          test_unmqr_device,  Section::gpu },
+    { "dev-ungqr",          test_ungqr_device,  Section::gpu },
+    { "dev-heevd",          test_heevd_device,  Section::gpu },
+    { "dev-gesvd",          test_gesvd_device,  Section::gpu },
+    { "dev-workspace",      test_workspace_device, Section::gpu },
+    { "",                   nullptr,            Section::newline },
+
+    //----------------------------------------
+    // fixed-size kernels
+    { "gesv_fixed",         test_gesv_fixed,    Section::fixed },  // us/call
+    { "posv_fixed",         test_posv_fixed,    Section::fixed },  // us/call
+    { "heev_fixed",         test_heev_fixed,    Section::fixed },  // us/call
+    { "",                   nullptr,            Section::newline },
+
+    //----------------------------------------
+    // workspace and instrumentation
+    { "allocator",          test_allocator,     Section::util },
+    { "plan",               test_plan,          Section::util },
+    { "stats",              test_stats,         Section::util },
+    { "trace",              test_trace,         Section::util },
+    { "work",               test_work,          Section::util },
+    { "workspace",          test_workspace,     Section::util },
     { "",                   nullptr,            Section::newline },
 };
 
@@ -467,6 +518,7 @@ Params::Params():
     check     ( "check",   0,    ParamType::Value, 'y', "ny",  "check the results" ),
     error_exit( "error-exit", 0, ParamType::Value, 'n', "ny",  "check error exits" ),
     ref       ( "ref",     0,    ParamType::Value, 'n', "ny",  "run reference; sometimes check implies ref" ),
+    trace     ( "trace",   0,    ParamType::Value, 'n', "ny",  "trace LAPACK++ calls to trace-<routine>.json" ),
 
     //          name,      w, p, type,             def, min,  max, help
     tol       ( "tol",     0, 0, ParamType::Value,  50,   1, 1000, "tolerance (e.g., error < tol*epsilon to pass)" ),
@@ -502,6 +554,7 @@ Params::Params():
                 "matrix type: g=general, l=lower, u=upper, h=Hessenberg, z=band-general, b=band-lower, q=band-upper" ),
     factored  ( "factored",    11,    ParamType::List, lapack::Factored::NotFactored, lapack::char2factored, lapack::factored2char, lapack::factored2str, "f=Factored, n=NotFactored, e=Equilibrate" ),
     equed  ( "equed",    9,    ParamType::List, lapack::Equed::None, lapack::char2equed, lapack::equed2char, lapack::equed2str, "n=None, r=Row, c=Col, b=Both, y=Yes" ),
+    method    ( "method",  7,    ParamType::List, lapack::SwapMethod::Auto, lapack::char2swapmethod, lapack::swapmethod2char, lapack::swapmethod2str, "laswp method: a=auto, s=swap, c=compose" ),
 
 
     //          name,      w, p, type,            def,   min,     max, help
@@ -515,6 +568,8 @@ Params::Params():
     ku        ( "ku",      6,    ParamType::List, 100,     0, 1000000, "upper bandwidth" ),
     nrhs      ( "nrhs",    6,    ParamType::List,  10,     0, 1000000, "number of right hand sides" ),
     nb        ( "nb",      4,    ParamType::List,  64,     0, 1000000, "block size" ),
+    batch     ( "batch",   7,    ParamType::List, 1000,    0, 100000000, "number of matrices in batch" ),
+    queues    ( "queues",  6,    ParamType::List,   4,     1, 1000000, "number of async queues" ),
     vl        ( "vl",      7, 2, ParamType::List, -inf, -inf,     inf, "lower bound of eigen/singular values to find" ),
     vu        ( "vu",      7, 2, ParamType::List,  inf, -inf,     inf, "upper bound of eigen/singular values to find" ),
 
@@ -557,6 +612,13 @@ Params::Params():
     ref_gbytes( "Ref.\nGbyte/s",         11, 4, ParamType::Output, testsweeper::no_data_flag,   0,   0, "reference Gbyte/s rate" ),
     ref_iters ( "Ref.\niters",            6,    ParamType::Output,                     0,   0,   0, "reference iterations to solution" ),
 
+    time_call    ( "LAPACK++\nus/call",  10, 3, ParamType::Output, testsweeper::no_data_flag,   0,   0, "time per call, in microseconds" ),
+    ref_time_call( "Ref.\nus/call",      10, 3, ParamType::Output, testsweeper::no_data_flag,   0,   0, "reference time per call, in microseconds" ),
+    stack_time_call( "Stack\nus/call",   10, 3, ParamType::Output, testsweeper::no_data_flag,   0,   0, "time per call of regular wrappers with on-stack workspace, in microseconds" ),
+
+    matrices_per_sec    ( "LAPACK++\nmatrices/s", 12, 0, ParamType::Output, testsweeper::no_data_flag, 0, 0, "batch throughput, matrices per second" ),
+    ref_matrices_per_sec( "Ref.\nmatrices/s",     12, 0, ParamType::Output, testsweeper::no_data_flag, 0, 0, "reference (serial loop) throughput, matrices per second" ),
+
     // default -1 means "no check"
     //          name,     w, type,              def, min, max, help
     okay      ( "status", 6, ParamType::Output,  -1,   0,   0, "success indicator" ),
@@ -576,6 +638,7 @@ Params::Params():
     check();
     error_exit();
     ref();
+    trace();
     repeat();
     verbose();
     cache();
@@ -746,6 +809,10 @@ int main( int argc, char** argv )
             params.align.width( 5 );
         }
 
+        if (params.trace() == 'y') {
+            lapack::trace::on();
+        }
+
         // run tests
         int repeat = params.repeat();
         testsweeper::DataType last = params.datatype();
@@ -780,6 +847,13 @@ int main( int argc, char** argv )
             }
         } while(params.next());
 
+        if (params.trace() == 'y') {
+            lapack::trace::off();
+            std::string filename = std::string( "trace-" ) + routine + ".json";
+            lapack::trace::finish( filename.c_str() );
+            printf( "Wrote trace to %s\n", filename.c_str() );
+        }
+
         if (status) {
             printf( "%d tests FAILED for %s.\n", status, routine );
         }
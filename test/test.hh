@@ -46,6 +46,7 @@ public:
     testsweeper::ParamChar   check;
     testsweeper::ParamChar   error_exit;
     testsweeper::ParamChar   ref;
+    testsweeper::ParamChar   trace;
     testsweeper::ParamDouble tol;
     testsweeper::ParamInt    repeat;
     testsweeper::ParamInt    verbose;
@@ -73,6 +74,7 @@ public:
     testsweeper::ParamEnum< lapack::MatrixType > matrixtype;
     testsweeper::ParamEnum< lapack::Factored >  factored;
     testsweeper::ParamEnum< lapack::Equed >     equed;
+    testsweeper::ParamEnum< lapack::SwapMethod > method;  // laswp
 
     testsweeper::ParamInt3   dim;
     testsweeper::ParamInt    i;
@@ -84,6 +86,8 @@ public:
     testsweeper::ParamInt    ku;
     testsweeper::ParamInt    nrhs;
     testsweeper::ParamInt    nb;
+    testsweeper::ParamInt    batch;
+    testsweeper::ParamInt    queues;
     testsweeper::ParamDouble vl;
     testsweeper::ParamDouble vu;
     testsweeper::ParamInt    il;
@@ -120,6 +124,13 @@ public:
     testsweeper::ParamDouble     ref_gbytes;
     testsweeper::ParamInt        ref_iters;
 
+    testsweeper::ParamDouble     time_call;
+    testsweeper::ParamDouble     ref_time_call;
+    testsweeper::ParamDouble     stack_time_call;
+
+    testsweeper::ParamDouble     matrices_per_sec;
+    testsweeper::ParamDouble     ref_matrices_per_sec;
+
     testsweeper::ParamOkay       okay;
     testsweeper::ParamString     msg;
 };
@@ -164,6 +175,10 @@ void require_( bool cond, const char* condstr, const char* file, int line )
 // LAPACK
 // LU, general
 void test_gesv  ( Params& params, bool run );
+void test_gesv_tiny( Params& params, bool run );
+void test_getrf_batch( Params& params, bool run );
+void test_getrf_async( Params& params, bool run );
+void test_getrf_interleaved( Params& params, bool run );
 void test_gesvx ( Params& params, bool run );
 void test_getrf ( Params& params, bool run );
 void test_getri ( Params& params, bool run );
@@ -194,6 +209,8 @@ void test_gtequ ( Params& params, bool run );
 void test_posv  ( Params& params, bool run );
 void test_posvx ( Params& params, bool run );
 void test_potrf ( Params& params, bool run );
+void test_potrf_batch( Params& params, bool run );
+void test_potrf_interleaved( Params& params, bool run );
 void test_potri ( Params& params, bool run );
 void test_potrs ( Params& params, bool run );
 void test_pocon ( Params& params, bool run );
@@ -285,6 +302,8 @@ void test_gels  ( Params& params, bool run );
 void test_gelsy ( Params& params, bool run );
 void test_gelsd ( Params& params, bool run );
 void test_gelss ( Params& params, bool run );
+void test_gels_batch  ( Params& params, bool run );
+void test_gelsd_batch ( Params& params, bool run );
 void test_getsls( Params& params, bool run );
 void test_gglse ( Params& params, bool run );
 void test_ggglm ( Params& params, bool run );
@@ -292,6 +311,7 @@ void test_ggglm ( Params& params, bool run );
 // QR, LQ, QL, RQ
 void test_geqr  ( Params& params, bool run );
 void test_geqrf ( Params& params, bool run );
+void test_geqrf_batch ( Params& params, bool run );
 void test_gelqf ( Params& params, bool run );
 void test_geqlf ( Params& params, bool run );
 void test_gerqf ( Params& params, bool run );
@@ -328,9 +348,13 @@ void test_tprfb ( Params& params, bool run );
 void test_heev  ( Params& params, bool run );
 void test_heevx ( Params& params, bool run );
 void test_heevd ( Params& params, bool run );
+void test_heevd_batch ( Params& params, bool run );
 void test_heevr ( Params& params, bool run );
+void test_heevr_batch ( Params& params, bool run );
 void test_hetrd ( Params& params, bool run );
 void test_sturm ( Params& params, bool run );
+void test_sturm_multi ( Params& params, bool run );
+void test_tridiag_bisect ( Params& params, bool run );
 void test_ungtr ( Params& params, bool run );
 void test_unmtr ( Params& params, bool run );
 
@@ -374,6 +398,7 @@ void test_hgeqz ( Params& params, bool run );
 
 // nonsymmetric eigenvalues
 void test_geev  ( Params& params, bool run );
+void test_geev_batch ( Params& params, bool run );
 void test_geevx ( Params& params, bool run );
 void test_gees  ( Params& params, bool run );
 void test_geesx ( Params& params, bool run );
@@ -391,7 +416,9 @@ void test_ggesx ( Params& params, bool run );
 
 // SVD
 void test_gesvd ( Params& params, bool run );
+void test_gesvd_batch ( Params& params, bool run );
 void test_gesdd ( Params& params, bool run );
+void test_gesdd_batch ( Params& params, bool run );
 void test_gesvdx( Params& params, bool run );
 void test_gesvd_2stage ( Params& params, bool run );
 void test_gesdd_2stage ( Params& params, bool run );
@@ -402,6 +429,9 @@ void test_gesvj ( Params& params, bool run );
 // auxiliary
 void test_lacpy ( Params& params, bool run );
 void test_laed4 ( Params& params, bool run );
+void test_lapmr ( Params& params, bool run );
+void test_lapmt ( Params& params, bool run );
+void test_lascl ( Params& params, bool run );
 void test_laset ( Params& params, bool run );
 void test_laswp ( Params& params, bool run );
 
@@ -452,5 +482,27 @@ void test_symv  ( Params& params, bool run );
 void test_potrf_device ( Params& params, bool run );
 void test_getrf_device ( Params& params, bool run );
 void test_geqrf_device ( Params& params, bool run );
+void test_potrs_device ( Params& params, bool run );
+void test_getrs_device ( Params& params, bool run );
+void test_unmqr_device ( Params& params, bool run );
+void test_ungqr_device ( Params& params, bool run );
+void test_heevd_device ( Params& params, bool run );
+void test_gesvd_device ( Params& params, bool run );
+void test_workspace_device ( Params& params, bool run );
+
+//----------------------------------------
+// fixed-size kernels
+void test_gesv_fixed ( Params& params, bool run );
+void test_posv_fixed ( Params& params, bool run );
+void test_heev_fixed ( Params& params, bool run );
+
+//----------------------------------------
+// workspace and instrumentation
+void test_allocator ( Params& params, bool run );
+void test_plan      ( Params& params, bool run );
+void test_stats     ( Params& params, bool run );
+void test_trace     ( Params& params, bool run );
+void test_work      ( Params& params, bool run );
+void test_workspace ( Params& params, bool run );
 
 #endif  //  #ifndef TEST_HH
@@ -0,0 +1,293 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/allocator.hh"
+#include "lapack/workspace.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace workspace = lapack::workspace;
+
+// -----------------------------------------------------------------------------
+// Upstream allocator that always fails.
+class FailingAllocator: public workspace::Allocator
+{
+public:
+    virtual void* allocate( size_t bytes, const char* routine ) override
+    {
+        throw std::bad_alloc();
+    }
+
+    virtual void deallocate( void* ptr, size_t bytes ) noexcept override
+    {}
+};
+
+// -----------------------------------------------------------------------------
+// @return true if ptr is aligned to 64 bytes.
+static bool is_aligned( void* ptr )
+{
+    return uintptr_t( ptr ) % 64 == 0;
+}
+
+// -----------------------------------------------------------------------------
+// Allocates blocks of each size from alloc, writes them, and frees them.
+// @return true if every block is non-null and aligned to 64 bytes.
+static bool check_blocks(
+    workspace::Allocator& alloc, std::vector< size_t > const& sizes )
+{
+    bool okay = true;
+    for (size_t bytes : sizes) {
+        void* ptr = alloc.allocate( bytes, "test" );
+        okay = okay && (ptr != nullptr || bytes == 0) && is_aligned( ptr );
+        if (ptr != nullptr)
+            std::memset( ptr, 0xff, bytes );
+        alloc.deallocate( ptr, bytes );
+    }
+    return okay;
+}
+
+// -----------------------------------------------------------------------------
+// @return number of allocations counted for routine.
+static int64_t count_of(
+    workspace::CountingAllocator const& counter, std::string const& routine )
+{
+    auto counts = counter.counts();
+    auto iter = counts.find( routine );
+    return iter == counts.end() ? 0 : iter->second.count;
+}
+
+// -----------------------------------------------------------------------------
+// Checks the workspace allocators and switching between them:
+// - Heap and HugePage allocators return aligned, writable blocks;
+// - PoolAllocator reuses freed blocks, passes large blocks through,
+//   and release() returns cached blocks upstream;
+// - CountingAllocator counts calls, bytes, current, and peak per routine,
+//   and counts nothing when upstream fails;
+// - set_thread_allocator overrides set_allocator, and LAPACK++ routines
+//   (gesdd) draw workspace from the current allocator.
+// Time is gesdd with the pool, ref. time is gesdd with the heap.
+template< typename scalar_t >
+void test_allocator_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    std::string msg;
+    auto expect = [&msg]( bool cond, const char* what ) {
+        if (! cond && msg.empty())
+            msg = what;
+    };
+
+    // Each allocator here is set only on this thread; restore the default.
+    workspace::set_thread_allocator( nullptr );
+    workspace::enable( false );
+    workspace::release();
+
+    std::vector< size_t > sizes = { 0, 1, 63, 64, 100, 4096, 1000000 };
+
+    //--------------------
+    // Heap
+    {
+        workspace::HeapAllocator heap;
+        expect( check_blocks( heap, sizes ), "heap block not aligned" );
+    }
+
+    //--------------------
+    // HugePage, with a small threshold so large sizes take the mmap path.
+    {
+        workspace::HugePageAllocator huge( 4096 );
+        sizes.push_back( workspace::HugePageAllocator::page_size + 1 );
+        expect( check_blocks( huge, sizes ), "huge page block not aligned" );
+        sizes.pop_back();
+    }
+
+    //--------------------
+    // Pool over a counting upstream.
+    {
+        workspace::CountingAllocator upstream;
+        {
+            workspace::PoolAllocator pool( 1024*1024, &upstream );
+            expect( check_blocks( pool, sizes ), "pool block not aligned" );
+
+            // Freed block of the same size class is reused.
+            upstream.reset();
+            void* p1 = pool.allocate( 1000, "test" );
+            pool.deallocate( p1, 1000 );
+            expect( pool.cached() >= 1000, "pool didn't cache block" );
+            void* p2 = pool.allocate( 1020, "test" );
+            expect( p1 == p2 && count_of( upstream, "test" ) <= 1,
+                    "pool didn't reuse block" );
+            pool.deallocate( p2, 1020 );
+
+            // Blocks larger than max_bytes aren't cached.
+            size_t big = 2*1024*1024;
+            upstream.reset();
+            for (int i = 0; i < 3; ++i) {
+                void* p = pool.allocate( big, "big" );
+                pool.deallocate( p, big );
+            }
+            expect( count_of( upstream, "big" ) == 3,
+                    "pool cached block larger than max_bytes" );
+
+            pool.release();
+            expect( pool.cached() == 0, "pool release didn't free blocks" );
+        }
+        expect( upstream.counts()[ "test" ].current == 0,
+                "pool leaked blocks" );
+    }
+
+    //--------------------
+    // Counting
+    {
+        workspace::CountingAllocator counter;
+        void* p1 = counter.allocate( 100, "alpha" );
+        void* p2 = counter.allocate( 200, "alpha" );
+        void* p3 = counter.allocate( 300, nullptr );
+        counter.deallocate( p1, 100 );
+        auto counts = counter.counts();
+        auto& alpha = counts[ "alpha" ];
+        expect( alpha.count == 2 && alpha.bytes == 300
+                && alpha.current == 200 && alpha.peak == 300,
+                "wrong counts" );
+        expect( counts[ "unknown" ].count == 1, "unknown routine not counted" );
+
+        // reset keeps live blocks as current and peak.
+        counter.reset();
+        counts = counter.counts();
+        expect( counts[ "alpha" ].count == 0
+                && counts[ "alpha" ].current == 200
+                && counts[ "alpha" ].peak == 200,
+                "wrong counts after reset" );
+        counter.deallocate( p2, 200 );
+        counter.deallocate( p3, 300 );
+        expect( counter.counts()[ "alpha" ].current == 0, "current not freed" );
+
+        // Failed upstream allocation propagates and isn't counted.
+        FailingAllocator failing;
+        workspace::CountingAllocator failing_counter( &failing );
+        bool threw = false;
+        try {
+            failing_counter.allocate( 100, "alpha" );
+        }
+        catch (std::bad_alloc const&) {
+            threw = true;
+        }
+        expect( threw && failing_counter.counts()[ "alpha" ].count == 0,
+                "failed allocation counted" );
+    }
+
+    //--------------------
+    // Switching allocators, with gesdd drawing workspace.
+    int64_t minmn = blas::min( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    std::vector< scalar_t > A( lda*n ), A_tst( lda*n );
+    std::vector< real_t > S( minmn );
+    scalar_t U[1], VT[1];
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    auto call = [&]() {
+        A_tst = A;
+        lapack::gesdd( lapack::Job::NoVec, m, n, &A_tst[0], lda, &S[0],
+                       U, 1, VT, 1 );
+    };
+
+    {
+        workspace::CountingAllocator global, thread;
+        workspace::PoolAllocator pool;
+        workspace::HeapAllocator* heap = nullptr;
+
+        workspace::set_allocator( &global );
+        expect( workspace::allocator() == &global, "set_allocator ignored" );
+        workspace::set_thread_allocator( &thread );
+        expect( workspace::allocator() == &thread,
+                "set_thread_allocator ignored" );
+
+        // Workspace that overflows the stack buffer comes from the thread's
+        // allocator, not the global one. The arena, disabled, records the
+        // high-water mark of such workspace.
+        call();
+        bool allocates = (workspace::high_water() > 0);
+        if (verbose >= 1) {
+            printf( "\ngesdd workspace high-water %lld bytes\n",
+                    (long long) workspace::high_water() );
+            thread.print();
+        }
+        expect( ! allocates || count_of( thread, "gesdd" ) > 0,
+                "gesdd didn't use thread allocator" );
+        expect( count_of( global, "gesdd" ) == 0,
+                "gesdd used global allocator" );
+
+        workspace::set_thread_allocator( nullptr );
+        expect( workspace::allocator() == &global,
+                "thread allocator not cleared" );
+        call();
+        expect( ! allocates || count_of( global, "gesdd" ) > 0,
+                "gesdd didn't use global allocator" );
+
+        workspace::set_allocator( nullptr );
+        heap = dynamic_cast< workspace::HeapAllocator* >( workspace::allocator() );
+        expect( heap != nullptr, "default allocator isn't heap" );
+
+        // Time gesdd with the heap (ref) and with the pool.
+        double time = testsweeper::get_wtime();
+        call();
+        params.ref_time() = testsweeper::get_wtime() - time;
+
+        workspace::set_thread_allocator( &pool );
+        call();  // warm up the pool
+        time = testsweeper::get_wtime();
+        call();
+        params.time() = testsweeper::get_wtime() - time;
+        workspace::set_thread_allocator( nullptr );
+    }
+
+    params.okay() = msg.empty();
+    params.msg() = msg;
+}
+
+// -----------------------------------------------------------------------------
+void test_allocator( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_allocator_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_allocator_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_allocator_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_allocator_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
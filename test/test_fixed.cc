@@ -0,0 +1,261 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/fixed.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Microbenchmark of the fixed-size kernels in lapack::fixed against the
+// generic wrappers, for n in { 1, ..., 8, 12, 16 }: times many calls of
+//   gesv_fixed: getrf + getrs;
+//   posv_fixed: potrf + potrs;
+//   heev_fixed: heev (syev);
+// reported in microseconds per call.
+// Checks
+//   error:  difference from the generic wrappers of the solution X, or of
+//           the eigenvalues W;
+//   error2: for heev_fixed with --jobz v, ||A V - V W|| / (n ||A||).
+// For gesv_fixed, pivots must also match.
+enum class Fixed { gesv, posv, heev };
+
+template< int64_t N, typename scalar_t >
+void test_fixed_run( Params& params, Fixed routine )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // Enough calls to time reliably.
+    const int64_t ncalls = 10000;
+
+    // ---------- setup
+    int64_t lda = roundup( N, align );
+    int64_t ldb = roundup( N, align );
+    size_t size_A = (size_t) lda * N;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A0( size_A ), A_tst( size_A ), A_ref( size_A );
+    std::vector< scalar_t > B0( size_B ), B_tst( size_B ), B_ref( size_B );
+    std::vector< int64_t > ipiv_tst( N ), ipiv_ref( N );
+    std::vector< real_t > W_tst( N ), W_ref( N );
+
+    lapack::generate_matrix( params.matrix, N, N, &A0[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B0.size(), &B0[0] );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld\n"
+                "B n=%5lld, nrhs=%5lld, ldb=%5lld\n",
+                (lld) N, (lld) lda, (lld) N, (lld) nrhs, (lld) ldb );
+    }
+
+    // ---------- run reference: generic wrappers
+    int64_t info_ref = 0;
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < ncalls; ++i) {
+        A_ref = A0;
+        B_ref = B0;
+        switch (routine) {
+            case Fixed::gesv:
+                info_ref = lapack::getrf( N, N, &A_ref[0], lda, &ipiv_ref[0] );
+                lapack::getrs( lapack::Op::NoTrans, N, nrhs, &A_ref[0], lda,
+                               &ipiv_ref[0], &B_ref[0], ldb );
+                break;
+            case Fixed::posv:
+                info_ref = lapack::potrf( uplo, N, &A_ref[0], lda );
+                lapack::potrs( uplo, N, nrhs, &A_ref[0], lda, &B_ref[0], ldb );
+                break;
+            case Fixed::heev:
+                info_ref = lapack::heev( jobz, uplo, N, &A_ref[0], lda, &W_ref[0] );
+                break;
+        }
+    }
+    time = testsweeper::get_wtime() - time;
+    params.ref_time() = time;
+    params.ref_time_call() = time / ncalls * 1e6;
+
+    // ---------- run test: fixed-size kernels
+    int64_t info_tst = 0;
+    time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < ncalls; ++i) {
+        A_tst = A0;
+        B_tst = B0;
+        switch (routine) {
+            case Fixed::gesv:
+                info_tst = lapack::fixed::getrf<N>( &A_tst[0], lda, &ipiv_tst[0] );
+                lapack::fixed::getrs<N>( lapack::Op::NoTrans, nrhs, &A_tst[0], lda,
+                                         &ipiv_tst[0], &B_tst[0], ldb );
+                break;
+            case Fixed::posv:
+                info_tst = lapack::fixed::potrf<N>( uplo, &A_tst[0], lda );
+                lapack::fixed::potrs<N>( uplo, nrhs, &A_tst[0], lda, &B_tst[0], ldb );
+                break;
+            case Fixed::heev:
+                info_tst = lapack::fixed::heev<N>( jobz, uplo, &A_tst[0], lda, &W_tst[0] );
+                break;
+        }
+    }
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.time_call() = time / ncalls * 1e6;
+
+    if (info_tst != info_ref) {
+        fprintf( stderr, "lapack::fixed returned info %lld, generic returned %lld\n",
+                 (lld) info_tst, (lld) info_ref );
+    }
+
+    if (verbose >= 2) {
+        if (routine == Fixed::heev) {
+            printf( "W_tst = " ); print_vector( N, &W_tst[0], 1 );
+            printf( "W_ref = " ); print_vector( N, &W_ref[0], 1 );
+        }
+        else {
+            printf( "X_tst = " ); print_matrix( N, nrhs, &B_tst[0], ldb );
+            printf( "X_ref = " ); print_matrix( N, nrhs, &B_ref[0], ldb );
+        }
+    }
+
+    if (params.check() == 'y') {
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (routine == Fixed::heev) {
+            error = rel_error( W_tst, W_ref );
+
+            if (jobz == lapack::Job::Vec) {
+                // ||A V - V W|| / (n ||A||), with A0 made Hermitian
+                std::vector< scalar_t > R( size_A );
+                real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, N, &A0[0], lda );
+                for (int64_t j = 0; j < N; ++j) {
+                    for (int64_t i = 0; i < N; ++i)
+                        R[ i + j*lda ] = W_tst[ j ] * A_tst[ i + j*lda ];
+                }
+                blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                            N, N,
+                             1.0, &A0[0], lda,
+                                  &A_tst[0], lda,
+                            -1.0, &R[0], lda );
+                real_t Rnorm = lapack::lange( lapack::Norm::One, N, N, &R[0], lda );
+                params.error2() = (Anorm > 0 ? Rnorm / (N * Anorm) : Rnorm);
+            }
+        }
+        else {
+            error = rel_error( B_tst, B_ref );
+            if (routine == Fixed::gesv && ipiv_tst != ipiv_ref)
+                error = 1;
+        }
+        params.error() = error;
+        params.okay() = (error < tol) && (info_tst == info_ref);
+        if (routine == Fixed::heev && jobz == lapack::Job::Vec)
+            params.okay() = params.okay() && (params.error2() < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_fixed_work( Params& params, bool run, Fixed routine )
+{
+    // mark input values
+    if (routine == Fixed::heev) {
+        params.jobz();
+    }
+    else {
+        params.nrhs();
+    }
+    if (routine != Fixed::gesv)
+        params.uplo();
+    int64_t n = params.dim.n();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.time_call();
+    params.ref_time_call();
+    if (routine == Fixed::heev)
+        params.error2();
+    params.msg();
+
+    if (! run) {
+        if (routine == Fixed::posv)
+            params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // N must be a compile-time constant, so instantiate common sizes.
+    switch (n) {
+        case  1: test_fixed_run<  1, scalar_t >( params, routine ); break;
+        case  2: test_fixed_run<  2, scalar_t >( params, routine ); break;
+        case  3: test_fixed_run<  3, scalar_t >( params, routine ); break;
+        case  4: test_fixed_run<  4, scalar_t >( params, routine ); break;
+        case  5: test_fixed_run<  5, scalar_t >( params, routine ); break;
+        case  6: test_fixed_run<  6, scalar_t >( params, routine ); break;
+        case  7: test_fixed_run<  7, scalar_t >( params, routine ); break;
+        case  8: test_fixed_run<  8, scalar_t >( params, routine ); break;
+        case 12: test_fixed_run< 12, scalar_t >( params, routine ); break;
+        case 16: test_fixed_run< 16, scalar_t >( params, routine ); break;
+        default:
+            params.msg() = "skipping: n must be 1, ..., 8, 12, or 16";
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+static void test_fixed_dispatch( Params& params, bool run, Fixed routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_fixed_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_fixed_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_fixed_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_fixed_work< std::complex<double> >( params, run, routine );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesv_fixed( Params& params, bool run )
+{
+    test_fixed_dispatch( params, run, Fixed::gesv );
+}
+
+// -----------------------------------------------------------------------------
+void test_posv_fixed( Params& params, bool run )
+{
+    test_fixed_dispatch( params, run, Fixed::posv );
+}
+
+// -----------------------------------------------------------------------------
+void test_heev_fixed( Params& params, bool run )
+{
+    test_fixed_dispatch( params, run, Fixed::heev );
+}
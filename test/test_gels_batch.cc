@@ -0,0 +1,278 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "check_gels.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Throughput of batched QR and least squares: runs the strided geqrf_batch,
+// gels_batch, or gelsd_batch on batch m-by-n problems.
+// Ref. is a serial loop of lapack::geqrf, gels, or gelsd.
+// Checks
+//   geqrf: error is the difference from serial geqrf;
+//   gels, gelsd: error and error2 are the max over the batch of check_gels.
+// For all, the pointer-array variant must match the strided variant.
+enum class BatchLS { geqrf, gels, gelsd };
+
+template< typename scalar_t >
+void test_gels_batch_work( Params& params, bool run, BatchLS routine )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Op trans = lapack::Op::NoTrans;
+    if (routine == BatchLS::gels)
+        trans = params.trans();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = 0;
+    if (routine != BatchLS::geqrf)
+        nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    if (routine != BatchLS::geqrf)
+        params.error2();
+    if (routine != BatchLS::gelsd)
+        params.gflops();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = roundup( blas::max( 1, m, n ), align );
+    real_t rcond = -1;  // use machine epsilon
+    int64_t strideA = lda * n;
+    int64_t strideB = ldb * nrhs;
+    int64_t strideS = minmn;
+    size_t size_A = (size_t) strideA * batch;
+    size_t size_B = (size_t) strideB * batch;
+    size_t size_S = (size_t) strideS * batch;
+
+    std::vector< scalar_t > A_tst( size_A ), A_ref( size_A ), A_ptr( size_A );
+    std::vector< scalar_t > B_tst( size_B ), B_ref( size_B ), B_ptr( size_B );
+    std::vector< scalar_t > tau_tst( size_S ), tau_ref( size_S ), tau_ptr( size_S );
+    std::vector< real_t > S_tst( size_S ), S_ref( size_S ), S_ptr( size_S );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*strideA ], lda );
+    }
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    if (size_B > 0)
+        lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    A_ref = A_tst;
+    A_ptr = A_tst;
+    B_ref = B_tst;
+    B_ptr = B_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, batch=%lld, threads=%d\n",
+                (lld) m, (lld) n, (lld) lda, (lld) batch,
+                lapack::get_num_threads() );
+    }
+
+    // ---------- run test
+    std::vector< int64_t > info_tst, rank_tst;
+    double time = testsweeper::get_wtime();
+    switch (routine) {
+        case BatchLS::geqrf:
+            lapack::geqrf_batch( m, n, &A_tst[0], lda, strideA,
+                                 tau_tst.data(), strideS, batch, info_tst );
+            break;
+        case BatchLS::gels:
+            lapack::gels_batch( trans, m, n, nrhs,
+                                &A_tst[0], lda, strideA,
+                                &B_tst[0], ldb, strideB, batch, info_tst );
+            break;
+        case BatchLS::gelsd:
+            lapack::gelsd_batch( m, n, nrhs,
+                                 &A_tst[0], lda, strideA,
+                                 &B_tst[0], ldb, strideB,
+                                 S_tst.data(), strideS, rcond, rank_tst,
+                                 batch, info_tst );
+            break;
+    }
+    time = testsweeper::get_wtime() - time;
+    int64_t nfailed = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0)
+            ++nfailed;
+    }
+    if (nfailed != 0) {
+        fprintf( stderr, "batch routine returned error for %lld problems\n",
+                 (lld) nfailed );
+    }
+
+    params.time() = time;
+    params.matrices_per_sec() = batch / time;
+    double gflop = 0;
+    if (routine == BatchLS::geqrf)
+        gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+    else if (routine == BatchLS::gels)
+        gflop = batch * lapack::Gflop< scalar_t >::gels( m, n, nrhs );
+    if (routine != BatchLS::gelsd)
+        params.gflops() = gflop / time;
+
+    if (params.check() == 'y') {
+        // ---------- run pointer-array variant, which should match
+        std::vector< scalar_t* > Aarray( batch ), Barray( batch ), tau_array( batch );
+        std::vector< real_t* > Sarray( batch );
+        for (int64_t i = 0; i < batch; ++i) {
+            Aarray[ i ]    = &A_ptr[ i*strideA ];
+            Barray[ i ]    = &B_ptr[ i*strideB ];
+            tau_array[ i ] = &tau_ptr[ i*strideS ];
+            Sarray[ i ]    = &S_ptr[ i*strideS ];
+        }
+        std::vector< int64_t > info_ptr, rank_ptr;
+        bool same = true;
+        switch (routine) {
+            case BatchLS::geqrf:
+                lapack::geqrf_batch( { m }, { n }, Aarray, { lda }, tau_array,
+                                     batch, info_ptr );
+                same = (A_ptr == A_tst && tau_ptr == tau_tst);
+                break;
+            case BatchLS::gels:
+                lapack::gels_batch( { trans }, { m }, { n }, { nrhs },
+                                    Aarray, { lda }, Barray, { ldb },
+                                    batch, info_ptr );
+                same = (B_ptr == B_tst);
+                break;
+            case BatchLS::gelsd:
+                lapack::gelsd_batch( { m }, { n }, { nrhs },
+                                     Aarray, { lda }, Barray, { ldb },
+                                     Sarray, { rcond }, rank_ptr,
+                                     batch, info_ptr );
+                same = (B_ptr == B_tst && rank_ptr == rank_tst);
+                break;
+        }
+        if (! same) {
+            fprintf( stderr, "pointer-array and strided variants differ\n" );
+        }
+
+        // ---------- check error
+        real_t error = 0, error2 = 0;
+        if (routine == BatchLS::geqrf) {
+            // compare with serial geqrf
+            std::vector< scalar_t > A_chk = A_ref;
+            std::vector< scalar_t > tau_chk( size_S );
+            for (int64_t i = 0; i < batch; ++i) {
+                lapack::geqrf( m, n, &A_chk[ i*strideA ], lda,
+                               &tau_chk[ i*strideS ] );
+            }
+            error = blas::max( rel_error( A_tst, A_chk ),
+                               rel_error( tau_tst, tau_chk ) );
+        }
+        else {
+            for (int64_t i = 0; i < batch; ++i) {
+                real_t error_i[2];
+                check_gels( false, trans, m, n, nrhs,
+                            &A_ref[ i*strideA ], lda,  // original A
+                            &B_tst[ i*strideB ], ldb,  // X
+                            &B_ref[ i*strideB ], ldb,  // original B
+                            error_i );
+                error  = blas::max( error,  error_i[0] );
+                error2 = blas::max( error2, error_i[1] );
+            }
+            params.error2() = error2;
+        }
+        params.error() = error;
+        params.okay() = (error < tol && error2 < tol && same);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference: serial loop
+        // A_ref and B_ref are still the original data.
+        int64_t rank_ref;
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            switch (routine) {
+                case BatchLS::geqrf:
+                    lapack::geqrf( m, n, &A_ref[ i*strideA ], lda,
+                                   &tau_ref[ i*strideS ] );
+                    break;
+                case BatchLS::gels:
+                    lapack::gels( trans, m, n, nrhs,
+                                  &A_ref[ i*strideA ], lda,
+                                  &B_ref[ i*strideB ], ldb );
+                    break;
+                case BatchLS::gelsd:
+                    lapack::gelsd( m, n, nrhs,
+                                   &A_ref[ i*strideA ], lda,
+                                   &B_ref[ i*strideB ], ldb,
+                                   &S_ref[ i*strideS ], rcond, &rank_ref );
+                    break;
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+static void test_gels_batch_dispatch(
+    Params& params, bool run, BatchLS routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_gels_batch_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gels_batch_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gels_batch_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gels_batch_work< std::complex<double> >( params, run, routine );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_batch( Params& params, bool run )
+{
+    test_gels_batch_dispatch( params, run, BatchLS::geqrf );
+}
+
+// -----------------------------------------------------------------------------
+void test_gels_batch( Params& params, bool run )
+{
+    test_gels_batch_dispatch( params, run, BatchLS::gels );
+}
+
+// -----------------------------------------------------------------------------
+void test_gelsd_batch( Params& params, bool run )
+{
+    test_gels_batch_dispatch( params, run, BatchLS::gelsd );
+}
@@ -0,0 +1,342 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "check_svd.hh"
+#include "check_geev.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Throughput of batched SVD and nonsymmetric eigensolvers: runs the strided
+// gesdd_batch, gesvd_batch, or geev_batch on batch matrices;
+// --jobu n (and --jobvt n, or --jobvl n --jobvr n) is values only.
+// Ref. is a serial loop of lapack::gesdd, gesvd, or geev.
+// Checks
+//   error:  max over the batch of check_svd or check_geev errors,
+//           if vectors are computed;
+//   error2: difference of singular values or eigenvalues from the
+//           serial loop.
+// For both, the pointer-array variant must match the strided variant.
+enum class BatchSVD { gesdd, gesvd, geev };
+
+template< typename scalar_t >
+void test_gesdd_batch_work( Params& params, bool run, BatchSVD routine )
+{
+    using real_t = blas::real_type< scalar_t >;
+    using complex_t = blas::complex_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    // For gesdd, jobu is jobz; for geev, jobu is jobvl and jobvt is jobvr.
+    lapack::Job jobu, jobvt;
+    int64_t m, n;
+    if (routine == BatchSVD::geev) {
+        jobu  = params.jobvl();
+        jobvt = params.jobvr();
+        n = params.dim.n();
+        m = n;
+    }
+    else {
+        jobu  = params.jobu();
+        jobvt = jobu;
+        if (routine == BatchSVD::gesvd)
+            jobvt = params.jobvt();
+        m = params.dim.m();
+        n = params.dim.n();
+    }
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.error2();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run)
+        return;
+
+    if (jobu == lapack::Job::OverwriteVec || jobvt == lapack::Job::OverwriteVec) {
+        params.msg() = "skipping: OverwriteVec not supported by batch tester";
+        return;
+    }
+
+    // ---------- setup
+    // ucol columns of U (or VL) and vrow rows of VT (or columns of VR)
+    int64_t minmn = blas::min( m, n );
+    int64_t ucol = 0, vrow = 0;
+    if (routine == BatchSVD::geev) {
+        ucol = (jobu  == lapack::Job::Vec ? n : 0);
+        vrow = (jobvt == lapack::Job::Vec ? n : 0);
+    }
+    else {
+        if (jobu == lapack::Job::AllVec)
+            ucol = m;
+        else if (jobu == lapack::Job::SomeVec)
+            ucol = minmn;
+        if (jobvt == lapack::Job::AllVec)
+            vrow = n;
+        else if (jobvt == lapack::Job::SomeVec)
+            vrow = minmn;
+    }
+    int64_t lda  = roundup( blas::max( 1, m ), align );
+    int64_t ldu  = (ucol > 0 ? roundup( blas::max( 1, m ), align ) : 1);
+    int64_t ldvt = 1;
+    if (vrow > 0) {
+        // geev's VR is n-by-n, stored like U
+        ldvt = roundup( blas::max( 1, vrow ), align );
+    }
+    int64_t strideA  = lda * n;
+    int64_t strideS  = (routine == BatchSVD::geev ? n : minmn);
+    int64_t strideU  = ldu * ucol;
+    int64_t strideVT = (vrow > 0 ? ldvt * n : 0);
+    size_t size_A  = (size_t) strideA  * batch;
+    size_t size_S  = (size_t) strideS  * batch;
+    size_t size_U  = (size_t) strideU  * batch;
+    size_t size_VT = (size_t) strideVT * batch;
+
+    std::vector< scalar_t > A( size_A ), A_tst( size_A ), A_ptr( size_A );
+    std::vector< scalar_t > U_tst( size_U ), U_ptr( size_U );
+    std::vector< scalar_t > VT_tst( size_VT ), VT_ptr( size_VT );
+    // S for SVD, W for geev
+    std::vector< real_t > S_tst, S_ptr, S_ref;
+    std::vector< complex_t > W_tst, W_ptr, W_ref;
+    if (routine == BatchSVD::geev) {
+        W_tst.resize( size_S );
+        W_ptr.resize( size_S );
+        W_ref.resize( size_S );
+    }
+    else {
+        S_tst.resize( size_S );
+        S_ptr.resize( size_S );
+        S_ref.resize( size_S );
+    }
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A[ i*strideA ], lda );
+    }
+    A_tst = A;
+    A_ptr = A;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, batch=%lld, threads=%d\n",
+                (lld) m, (lld) n, (lld) lda, (lld) batch,
+                lapack::get_num_threads() );
+    }
+
+    // ---------- run test
+    std::vector< int64_t > info_tst;
+    double time = testsweeper::get_wtime();
+    switch (routine) {
+        case BatchSVD::gesdd:
+            lapack::gesdd_batch( jobu, m, n, &A_tst[0], lda, strideA,
+                                 S_tst.data(), strideS,
+                                 U_tst.data(), ldu, strideU,
+                                 VT_tst.data(), ldvt, strideVT,
+                                 batch, info_tst );
+            break;
+        case BatchSVD::gesvd:
+            lapack::gesvd_batch( jobu, jobvt, m, n, &A_tst[0], lda, strideA,
+                                 S_tst.data(), strideS,
+                                 U_tst.data(), ldu, strideU,
+                                 VT_tst.data(), ldvt, strideVT,
+                                 batch, info_tst );
+            break;
+        case BatchSVD::geev:
+            lapack::geev_batch( jobu, jobvt, n, &A_tst[0], lda, strideA,
+                                W_tst.data(), strideS,
+                                U_tst.data(), ldu, strideU,
+                                VT_tst.data(), ldvt, strideVT,
+                                batch, info_tst );
+            break;
+    }
+    time = testsweeper::get_wtime() - time;
+    int64_t nfailed = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0)
+            ++nfailed;
+    }
+    if (nfailed != 0) {
+        fprintf( stderr, "batch routine returned error for %lld matrices\n",
+                 (lld) nfailed );
+    }
+
+    params.time() = time;
+    params.matrices_per_sec() = batch / time;
+
+    if (params.check() == 'y') {
+        // ---------- run pointer-array variant, which should match
+        std::vector< scalar_t* > Aarray( batch ), Uarray( batch, nullptr ),
+                                 VTarray( batch, nullptr );
+        std::vector< real_t* > Sarray( batch );
+        std::vector< complex_t* > Warray( batch );
+        for (int64_t i = 0; i < batch; ++i) {
+            Aarray[ i ] = &A_ptr[ i*strideA ];
+            if (routine == BatchSVD::geev)
+                Warray[ i ] = &W_ptr[ i*strideS ];
+            else
+                Sarray[ i ] = &S_ptr[ i*strideS ];
+            if (ucol > 0)
+                Uarray[ i ] = &U_ptr[ i*strideU ];
+            if (vrow > 0)
+                VTarray[ i ] = &VT_ptr[ i*strideVT ];
+        }
+        std::vector< int64_t > info_ptr;
+        switch (routine) {
+            case BatchSVD::gesdd:
+                lapack::gesdd_batch( { jobu }, { m }, { n }, Aarray, { lda },
+                                     Sarray, Uarray, { ldu }, VTarray, { ldvt },
+                                     batch, info_ptr );
+                break;
+            case BatchSVD::gesvd:
+                lapack::gesvd_batch( { jobu }, { jobvt }, { m }, { n },
+                                     Aarray, { lda },
+                                     Sarray, Uarray, { ldu }, VTarray, { ldvt },
+                                     batch, info_ptr );
+                break;
+            case BatchSVD::geev:
+                lapack::geev_batch( { jobu }, { jobvt }, { n }, Aarray, { lda },
+                                    Warray, Uarray, { ldu }, VTarray, { ldvt },
+                                    batch, info_ptr );
+                break;
+        }
+        bool same = (S_ptr == S_tst && W_ptr == W_tst
+                     && U_ptr == U_tst && VT_ptr == VT_tst);
+        if (! same) {
+            fprintf( stderr, "pointer-array and strided variants differ\n" );
+        }
+
+        // ---------- check error
+        // max over batch of check_svd errors 0-2 (backward error and
+        // orthogonality of U and VT), or of check_geev errors for VL and VR.
+        real_t error = 0;
+        for (int64_t i = 0; i < batch; ++i) {
+            scalar_t* A_i  = &A[ i*strideA ];
+            scalar_t* U_i  = (ucol > 0 ? &U_tst[ i*strideU ] : nullptr);
+            scalar_t* VT_i = (vrow > 0 ? &VT_tst[ i*strideVT ] : nullptr);
+            real_t errors[4] = { 0, 0, 0, 0 };
+            if (routine == BatchSVD::geev) {
+                complex_t* W_i = &W_tst[ i*strideS ];
+                if (ucol > 0) {
+                    check_geev( blas::Op::ConjTrans, n, A_i, lda, W_i,
+                                U_i, ldu, verbose, &errors[0] );
+                }
+                if (vrow > 0) {
+                    check_geev( blas::Op::NoTrans, n, A_i, lda, W_i,
+                                VT_i, ldvt, verbose, &errors[2] );
+                }
+            }
+            else if (ucol > 0 || vrow > 0) {
+                check_svd( jobu, jobvt, m, n, A_i, lda, &S_tst[ i*strideS ],
+                           U_i, ldu, VT_i, ldvt, errors );
+                errors[3] = 0;  // sorting of S is checked by error2
+            }
+            error = blas::max( error, errors[0], errors[1],
+                               blas::max( errors[2], errors[3] ) );
+        }
+        params.error() = error;
+        params.okay() = (error < tol && same);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference: serial loop
+        std::vector< scalar_t > A_ref = A;
+        std::vector< scalar_t > U_ref( size_U ), VT_ref( size_VT );
+        int64_t info_ref = 0;
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            scalar_t* U_i  = (ucol > 0 ? &U_ref[ i*strideU ] : nullptr);
+            scalar_t* VT_i = (vrow > 0 ? &VT_ref[ i*strideVT ] : nullptr);
+            switch (routine) {
+                case BatchSVD::gesdd:
+                    info_ref = lapack::gesdd(
+                        jobu, m, n, &A_ref[ i*strideA ], lda,
+                        &S_ref[ i*strideS ], U_i, ldu, VT_i, ldvt );
+                    break;
+                case BatchSVD::gesvd:
+                    info_ref = lapack::gesvd(
+                        jobu, jobvt, m, n, &A_ref[ i*strideA ], lda,
+                        &S_ref[ i*strideS ], U_i, ldu, VT_i, ldvt );
+                    break;
+                case BatchSVD::geev:
+                    info_ref = lapack::geev(
+                        jobu, jobvt, n, &A_ref[ i*strideA ], lda,
+                        &W_ref[ i*strideS ], U_i, ldu, VT_i, ldvt );
+                    break;
+            }
+            if (info_ref != 0) {
+                fprintf( stderr, "serial loop returned error %lld\n",
+                         (lld) info_ref );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+
+        // ---------- check error compared to reference
+        real_t error2 = (routine == BatchSVD::geev
+                         ? rel_error( W_tst, W_ref )
+                         : rel_error( S_tst, S_ref ));
+        params.error2() = error2;
+        params.okay() = params.okay() && (error2 < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+static void test_gesdd_batch_dispatch(
+    Params& params, bool run, BatchSVD routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_gesdd_batch_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesdd_batch_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesdd_batch_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesdd_batch_work< std::complex<double> >( params, run, routine );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesdd_batch( Params& params, bool run )
+{
+    test_gesdd_batch_dispatch( params, run, BatchSVD::gesdd );
+}
+
+// -----------------------------------------------------------------------------
+void test_gesvd_batch( Params& params, bool run )
+{
+    test_gesdd_batch_dispatch( params, run, BatchSVD::gesvd );
+}
+
+// -----------------------------------------------------------------------------
+void test_geev_batch( Params& params, bool run )
+{
+    test_gesdd_batch_dispatch( params, run, BatchSVD::geev );
+}
@@ -10,6 +10,7 @@
 #include "error.hh"
 #include "lapacke_wrappers.hh"
 
+#include <algorithm>
 #include <vector>
 
 // -----------------------------------------------------------------------------
@@ -35,6 +36,7 @@ void test_gesv_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.gflops();
+    params.msg();
 
     if (! run)
         return;
@@ -103,6 +105,22 @@ void test_gesv_work( Params& params, bool run )
         print_matrix( n, nrhs, &B_tst[0], ldb );
     }
 
+    // ---------- run lapack_int pivot version, in LP64 builds
+    // It passes ipiv to LAPACK without a 32-bit copy; results must be identical.
+    bool pivots_okay = true;
+    #ifndef LAPACK_ILP64
+        if (params.check() == 'y') {
+            std::vector< scalar_t > A_lp = A_ref;  // original A
+            std::vector< scalar_t > B_lp = B_ref;  // original B
+            std::vector< lapack_int > ipiv_lp( blas::max( 1, n ) );
+            int64_t info_lp = lapack::gesv( n, nrhs, &A_lp[0], lda, &ipiv_lp[0],
+                                            &B_lp[0], ldb );
+            pivots_okay = (info_lp == info_tst && A_lp == A_tst && B_lp == B_tst
+                           && std::equal( ipiv_tst.begin(), ipiv_tst.end(),
+                                          ipiv_lp.begin() ));
+        }
+    #endif
+
     if (params.check() == 'y') {
         // ---------- check error
         // Relative backwards error = ||b - Ax|| / (n * ||A|| * ||x||).
@@ -149,6 +167,11 @@ void test_gesv_work( Params& params, bool run )
             print_matrix( n, nrhs, &B_ref[0], ldb );
         }
     }
+
+    if (! pivots_okay) {
+        params.okay() = false;
+        params.msg() = "lapack_int pivot version differs";
+    }
 }
 
 // -----------------------------------------------------------------------------
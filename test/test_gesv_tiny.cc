@@ -0,0 +1,162 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/tiny.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Microbenchmark of per-call overhead for tiny problems: times many
+// getrf + getrs calls with
+//   - Ref.:     lapack::getrf, getrs with int64_t pivots and the on-stack
+//               workspace disabled, so pivots are copied to and from a
+//               heap-allocated 32-bit array (in LP64 builds);
+//   - Stack:    the same regular wrappers with the on-stack workspace
+//               enabled, so pivots are copied to and from a small_vector
+//               on the stack;
+//   - LAPACK++: lapack::tiny::getrf, getrs with lapack_int pivots,
+//               inline, with no conversion or allocation.
+// The solutions must be identical.
+template< typename scalar_t >
+void test_gesv_tiny_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.time_call();
+    params.ref_time_call();
+    params.stack_time_call();
+
+    if (! run)
+        return;
+
+    // Enough calls to time reliably.
+    const int64_t ncalls = 10000;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A0( size_A ), A( size_A );
+    std::vector< scalar_t > B0( size_B ), B_tst( size_B ), B_ref( size_B );
+    std::vector< scalar_t > B_stack( size_B );
+    std::vector< lapack::pivot_t > ipiv_tst( n );
+    std::vector< int64_t > ipiv_ref( n ), ipiv_stack( n );
+
+    lapack::generate_matrix( params.matrix, n, n, &A0[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B0.size(), &B0[0] );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld\n"
+                "B n=%5lld, nrhs=%5lld, ldb=%5lld\n",
+                (lld) n, (lld) lda, (lld) n, (lld) nrhs, (lld) ldb );
+    }
+
+    // ---------- run reference: int64_t pivots, heap workspace
+    size_t threshold = lapack::workspace::stack_threshold();
+    lapack::workspace::set_stack_threshold( 0 );
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < ncalls; ++i) {
+        A = A0;
+        B_ref = B0;
+        lapack::getrf( n, n, &A[0], lda, &ipiv_ref[0] );
+        lapack::getrs( lapack::Op::NoTrans, n, nrhs, &A[0], lda, &ipiv_ref[0],
+                       &B_ref[0], ldb );
+    }
+    time = testsweeper::get_wtime() - time;
+    lapack::workspace::set_stack_threshold( threshold );
+    params.ref_time() = time;
+    params.ref_time_call() = time / ncalls * 1e6;
+
+    // ---------- run regular wrappers: int64_t pivots, on-stack workspace
+    time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < ncalls; ++i) {
+        A = A0;
+        B_stack = B0;
+        lapack::getrf( n, n, &A[0], lda, &ipiv_stack[0] );
+        lapack::getrs( lapack::Op::NoTrans, n, nrhs, &A[0], lda, &ipiv_stack[0],
+                       &B_stack[0], ldb );
+    }
+    time = testsweeper::get_wtime() - time;
+    params.stack_time_call() = time / ncalls * 1e6;
+
+    // ---------- run test: native pivots, inline
+    int64_t info_tst = 0;
+    time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < ncalls; ++i) {
+        A = A0;
+        B_tst = B0;
+        info_tst = lapack::tiny::getrf( n, n, &A[0], lda, &ipiv_tst[0] );
+        lapack::tiny::getrs( lapack::Op::NoTrans, n, nrhs, &A[0], lda, &ipiv_tst[0],
+                             &B_tst[0], ldb );
+    }
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiny::getrf returned error %lld\n", (lld) info_tst );
+    }
+    params.time() = time;
+    params.time_call() = time / ncalls * 1e6;
+
+    if (verbose >= 2) {
+        printf( "X_tst = " ); print_matrix( n, nrhs, &B_tst[0], ldb );
+        printf( "X_ref = " ); print_matrix( n, nrhs, &B_ref[0], ldb );
+    }
+
+    if (params.check() == 'y') {
+        // ---------- check error compared to reference
+        real_t error = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            if (ipiv_tst[ i ] != ipiv_ref[ i ] || ipiv_stack[ i ] != ipiv_ref[ i ])
+                error = 1;
+        }
+        error += rel_error( B_tst, B_ref ) + rel_error( B_stack, B_ref );
+        params.error() = error;
+        params.okay() = (error == 0);  // same LAPACK calls
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesv_tiny( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_gesv_tiny_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesv_tiny_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesv_tiny_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesv_tiny_work< std::complex<double> >( params, run );
+            break;
+    }
+}
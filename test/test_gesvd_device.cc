@@ -0,0 +1,244 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Computes singular values with the device gesvd and compares them with the
+// host gesvd. Singular vectors are unique only up to a unit scaling, so
+// instead the vectors computed in U or VT are checked for orthogonality.
+template< typename scalar_t >
+void test_gesvd_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobu = params.jobu();
+    lapack::Job jobvt = params.jobvt();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho_U();
+    params.ortho_V();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // skip invalid options
+    if (jobu  == lapack::Job::OverwriteVec &&
+        jobvt == lapack::Job::OverwriteVec)
+    {
+        params.msg() = "skipping: jobu and jobvt cannot both be overwrite.";
+        return;
+    }
+    #if defined(LAPACK_HAVE_CUBLAS)
+        if (m < n) {
+            params.msg() = "skipping: cuSolver requires m >= n";
+            return;
+        }
+    #endif
+
+    if (lapack::get_device_count() == 0) {
+        params.msg() = "skipping: no devices";
+        return;
+    }
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    int64_t u_ncol = (jobu == lapack::Job::AllVec ? m : minmn);
+    int64_t v_nrow = (jobvt == lapack::Job::AllVec ? n : minmn);
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldu = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, v_nrow ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_S = (size_t) blas::max( 1, minmn );
+    size_t size_U = (size_t) ldu * blas::max( 1, u_ncol );
+    size_t size_VT = (size_t) ldvt * blas::max( 1, n );
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< real_t > S_tst( size_S );
+    std::vector< real_t > S_ref( size_S );
+    std::vector< scalar_t > U_tst( size_U );
+    std::vector< scalar_t > U_ref( size_U );
+    std::vector< scalar_t > VT_tst( size_VT );
+    std::vector< scalar_t > VT_ref( size_VT );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    // Allocate and copy to device.
+    lapack::Queue queue( device, 0 );
+    scalar_t*        dA_tst  = lapack::device_malloc< scalar_t >( size_A, queue );
+    real_t*          dS_tst  = lapack::device_malloc< real_t >( size_S, queue );
+    scalar_t*        dU_tst  = lapack::device_malloc< scalar_t >( size_U, queue );
+    scalar_t*        dVT_tst = lapack::device_malloc< scalar_t >( size_VT, queue );
+    device_info_int* d_info  = lapack::device_malloc< device_info_int >( 1, queue );
+    lapack::device_setmatrix( m, n, A_tst.data(), lda, dA_tst, lda, queue );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld\n",
+                (lld) m, (lld) n, (lld) lda );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( m, n, &A_tst[0], lda );
+    }
+
+    // Allocate workspace
+    size_t d_size, h_size;
+    lapack::gesvd_work_size_bytes( jobu, jobvt, m, n, dA_tst, lda, &d_size, &h_size, queue );
+    char* d_work = lapack::device_malloc< char >( d_size, queue );
+    std::vector<char> h_work_vector( h_size );
+    char* h_work = h_work_vector.data();
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        assert_throw( lapack::gesvd( Job(0), jobvt,  m,  n, dA_tst, lda, dS_tst, dU_tst, ldu, dVT_tst, ldvt, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::gesvd( jobu,   Job(0), m,  n, dA_tst, lda, dS_tst, dU_tst, ldu, dVT_tst, ldvt, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::gesvd( jobu,   jobvt, -1,  n, dA_tst, lda, dS_tst, dU_tst, ldu, dVT_tst, ldvt, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::gesvd( jobu,   jobvt,  m, -1, dA_tst, lda, dS_tst, dU_tst, ldu, dVT_tst, ldvt, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::gesvd( jobu,   jobvt,  m,  n, dA_tst, m-1, dS_tst, dU_tst, ldu, dVT_tst, ldvt, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::gesvd( jobu, jobvt, m, n, dA_tst, lda, dS_tst,
+                   dU_tst, ldu, dVT_tst, ldvt,
+                   d_work, d_size, h_work, h_size, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    lapack::device_getmatrix( m, n, dA_tst, lda, A_tst.data(), lda, queue );
+    lapack::device_memcpy( S_tst.data(), dS_tst, size_S, queue );
+    lapack::device_memcpy( U_tst.data(), dU_tst, size_U, queue );
+    lapack::device_memcpy( VT_tst.data(), dVT_tst, size_VT, queue );
+    lapack::device_memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gesvd returned error %lld\n", (lld) info_tst );
+    }
+
+    // Cleanup device memory.
+    lapack::device_free( dA_tst,  queue );
+    lapack::device_free( dS_tst,  queue );
+    lapack::device_free( dU_tst,  queue );
+    lapack::device_free( dVT_tst, queue );
+    lapack::device_free( d_info,  queue );
+    lapack::device_free( d_work,  queue );
+
+    if (verbose >= 2) {
+        printf( "S = " ); print_vector( minmn, &S_tst[0], 1 );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gesvd( jobu, jobvt, m, n, &A_ref[0], lda, &S_ref[0],
+                                          &U_ref[0], ldu, &VT_ref[0], ldvt );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gesvd returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        if (verbose >= 2) {
+            printf( "Sref = " ); print_vector( minmn, &S_ref[0], 1 );
+        }
+
+        // ---------- check error compared to host
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        if (minmn > 0 && S_ref[0] > 0)
+            error += rel_error( S_tst, S_ref );
+        params.error() = error;
+
+        // ---------- check orthogonality, || I - U^H U || / m, || I - V^H V || / n
+        // U is in A for jobu = overwrite; VT is in A for jobvt = overwrite.
+        real_t ortho_U = 0, ortho_V = 0;
+        if (jobu != lapack::Job::NoVec && minmn > 0) {
+            scalar_t* U = (jobu == lapack::Job::OverwriteVec ? &A_tst[0] : &U_tst[0]);
+            int64_t ldU = (jobu == lapack::Job::OverwriteVec ? lda : ldu);
+            int64_t ncol = (jobu == lapack::Job::OverwriteVec ? minmn : u_ncol);
+            std::vector< scalar_t > R( ncol * ncol );
+            lapack::laset( lapack::MatrixType::Upper, ncol, ncol, 0.0, 1.0, &R[0], ncol );
+            blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                        ncol, m, -1.0, U, ldU, 1.0, &R[0], ncol );
+            ortho_U = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, ncol, &R[0], ncol ) / m;
+        }
+        if (jobvt != lapack::Job::NoVec && minmn > 0) {
+            scalar_t* VT = (jobvt == lapack::Job::OverwriteVec ? &A_tst[0] : &VT_tst[0]);
+            int64_t ldV = (jobvt == lapack::Job::OverwriteVec ? lda : ldvt);
+            int64_t nrow = (jobvt == lapack::Job::OverwriteVec ? minmn : v_nrow);
+            std::vector< scalar_t > R( nrow * nrow );
+            lapack::laset( lapack::MatrixType::Upper, nrow, nrow, 0.0, 1.0, &R[0], nrow );
+            blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::NoTrans,
+                        nrow, n, -1.0, VT, ldV, 1.0, &R[0], nrow );
+            ortho_V = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, nrow, &R[0], nrow ) / n;
+        }
+        params.ortho_U() = ortho_U;
+        params.ortho_V() = ortho_V;
+        params.okay() = (error < tol) && (ortho_U < tol) && (ortho_V < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesvd_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gesvd_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesvd_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesvd_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesvd_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -10,6 +10,7 @@
 #include "error.hh"
 #include "lapacke_wrappers.hh"
 
+#include <algorithm>
 #include <vector>
 
 // -----------------------------------------------------------------------------
@@ -33,6 +34,7 @@ void test_getrf_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.gflops();
+    params.msg();
 
     if (! run)
         return;
@@ -83,6 +85,20 @@ void test_getrf_work( Params& params, bool run )
         printf( "A_factor = " ); print_matrix( m, n, &A_tst[0], lda );
     }
 
+    // ---------- run lapack_int pivot version, in LP64 builds
+    // It passes ipiv to LAPACK without a 32-bit copy; results must be identical.
+    bool pivots_okay = true;
+    #ifndef LAPACK_ILP64
+        if (params.check() == 'y') {
+            std::vector< scalar_t > A_lp = A_ref;  // original A
+            std::vector< lapack_int > ipiv_lp( blas::max( 1, size_ipiv ) );
+            int64_t info_lp = lapack::getrf( m, n, &A_lp[0], lda, &ipiv_lp[0] );
+            pivots_okay = (info_lp == info_tst && A_lp == A_tst
+                           && std::equal( ipiv_tst.begin(), ipiv_tst.end(),
+                                          ipiv_lp.begin() ));
+        }
+    #endif
+
     if (params.check() == 'y' && m == n) {
         // ---------- check error
         // Relative backwards error = ||b - Ax|| / (n * ||A|| * ||x||).
@@ -137,6 +153,11 @@ void test_getrf_work( Params& params, bool run )
             printf( "Aref_factor = " ); print_matrix( m, n, &A_ref[0], lda );
         }
     }
+
+    if (! pivots_okay) {
+        params.okay() = false;
+        params.msg() = "lapack_int pivot version differs";
+    }
 }
 
 // -----------------------------------------------------------------------------
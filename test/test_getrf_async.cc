@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Overlap of asynchronous LU: submits batch independent n-by-n getrf calls
+// round-robin to the given number of async queues, then waits for all.
+// time is the total; us/call is the caller's time per submit, during which
+// it is blocked, so the rest of time is free for other work (I/O, etc.).
+// Ref. is a serial loop of lapack::getrf. Checks the max over the batch of
+// the backward error ||b - Ax|| / (n ||A|| ||x||), solving with async getrs
+// on the same queue as each factorization, relying on in-order execution.
+template< typename scalar_t >
+void test_getrf_async_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t nqueues = params.queues();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.gflops();
+    params.time_call();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t nrhs = 1;
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    int64_t strideA = lda * n;
+    int64_t strideB = ldb * nrhs;
+    int64_t stride_ipiv = blas::max( 1, n );
+    size_t size_A = (size_t) strideA * batch;
+    size_t size_B = (size_t) strideB * batch;
+    size_t size_ipiv = (size_t) stride_ipiv * batch;
+
+    std::vector< scalar_t > A_tst( size_A ), A_ref( size_A );
+    std::vector< scalar_t > B_tst( size_B ), B_ref( size_B );
+    std::vector< int64_t > ipiv_tst( size_ipiv ), ipiv_ref( size_ipiv );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*strideA ], lda );
+    }
+    A_ref = A_tst;
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    B_ref = B_tst;
+
+    std::vector< lapack::async::Queue > queues( nqueues );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%lld, queues=%lld, threads=%d\n",
+                (lld) n, (lld) lda, (lld) batch, (lld) nqueues,
+                lapack::get_num_threads() );
+    }
+
+    // test error exits, which are thrown by get
+    if (params.error_exit() == 'y') {
+        lapack::async::Queue& queue = queues[ 0 ];
+        auto f1 = lapack::async::getrf( -1,  n, &A_tst[0], lda, &ipiv_tst[0], queue );
+        auto f2 = lapack::async::getrf(  n, -1, &A_tst[0], lda, &ipiv_tst[0], queue );
+        auto f3 = lapack::async::getrf(  n,  n, &A_tst[0], n-1, &ipiv_tst[0], queue );
+        assert_throw( f1.get(), lapack::Error );
+        assert_throw( f2.get(), lapack::Error );
+        assert_throw( f3.get(), lapack::Error );
+
+        // cancelled tasks don't run, and their get throws;
+        // the first task holds the queue until after cancel
+        std::atomic< bool > go( false );
+        auto f4 = queue.submit( [&go] {
+            while (! go)
+                std::this_thread::yield();
+        });
+        auto f5 = queue.submit( [] { return 0; } );
+        int64_t ncancel = queue.cancel();
+        go = true;
+        f4.get();
+        assert_throw( f5.get(), lapack::Error );
+        if (ncancel != 1) {
+            fprintf( stderr, "async::Queue::cancel cancelled %lld tasks; expected 1\n",
+                     (lld) ncancel );
+        }
+    }
+
+    // ---------- run test
+    std::vector< lapack::async::Future< int64_t > > futures( batch );
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i) {
+        futures[ i ] = lapack::async::getrf(
+            n, n, &A_tst[ i*strideA ], lda, &ipiv_tst[ i*stride_ipiv ],
+            queues[ i % nqueues ] );
+    }
+    double time_submit = testsweeper::get_wtime() - time;
+    int64_t nsingular = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (futures[ i ].get() != 0)
+            ++nsingular;
+    }
+    time = testsweeper::get_wtime() - time;
+    if (nsingular != 0) {
+        fprintf( stderr, "lapack::async::getrf returned error for %lld matrices\n",
+                 (lld) nsingular );
+    }
+
+    params.time() = time;
+    double gflop = batch * lapack::Gflop< scalar_t >::getrf( n, n );
+    params.gflops() = gflop / time;
+    params.time_call() = time_submit / batch * 1e6;
+    params.matrices_per_sec() = batch / time;
+
+    if (params.check() == 'y') {
+        // ---------- solve, on the same queue as each factorization
+        for (int64_t i = 0; i < batch; ++i) {
+            futures[ i ] = lapack::async::getrs(
+                lapack::Op::NoTrans, n, nrhs,
+                &A_tst[ i*strideA ], lda, &ipiv_tst[ i*stride_ipiv ],
+                &B_tst[ i*strideB ], ldb, queues[ i % nqueues ] );
+        }
+        for (auto& queue : queues)
+            queue.sync();
+
+        // ---------- check error
+        // max over batch of ||b - Ax|| / (n ||A|| ||x||),
+        // with original A in A_ref and b in B_ref.
+        real_t error = 0;
+        for (int64_t i = 0; i < batch; ++i) {
+            scalar_t* A_i = &A_ref[ i*strideA ];
+            scalar_t* B_i = &B_ref[ i*strideB ];
+            scalar_t* X_i = &B_tst[ i*strideB ];
+            real_t Anorm = lapack::lange( lapack::Norm::One, n, n,    A_i, lda );
+            real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, X_i, ldb );
+            blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                        n, nrhs, n,
+                        -1.0, A_i, lda,
+                              X_i, ldb,
+                         1.0, B_i, ldb );
+            real_t Rnorm = lapack::lange( lapack::Norm::One, n, nrhs, B_i, ldb );
+            if (n > 0 && Anorm > 0 && Xnorm > 0)
+                error = blas::max( error, Rnorm / (n * Anorm * Xnorm) );
+        }
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference: serial loop
+        // A_ref was overwritten by the check; regenerate.
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::generate_matrix( params.matrix, n, n, &A_ref[ i*strideA ], lda );
+        }
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::getrf( n, n, &A_ref[ i*strideA ], lda, &ipiv_ref[ i*stride_ipiv ] );
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_getrf_async( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_async_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_async_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_async_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_async_work< std::complex<double> >( params, run );
+            break;
+    }
+}
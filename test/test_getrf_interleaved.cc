@@ -0,0 +1,262 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "lapack/interleaved.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Throughput of LU or Cholesky on interleaved storage: packs batch n-by-n
+// matrices, then factors them with interleaved::getrf or potrf.
+// Time excludes packing, which is printed with --verbose 1.
+// Ref. is the strided getrf_batch or potrf_batch on the same matrices.
+// Checks
+//   error:  max over the batch of ||b - Ax|| / (n ||A|| ||x||),
+//           solving with interleaved::getrs or potrs;
+//   error2: difference between unpacked factors and the reference.
+enum class Interleaved { getrf, potrf };
+
+template< typename scalar_t >
+void test_getrf_interleaved_work(
+    Params& params, bool run, Interleaved routine )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+    namespace il = lapack::interleaved;
+
+    // get & mark input values
+    lapack::Uplo uplo = lapack::Uplo::Lower;
+    if (routine == Interleaved::potrf)
+        uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.error2();
+    params.gflops();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run) {
+        if (routine == Interleaved::potrf)
+            params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t nrhs = 1;
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    int64_t strideA = lda * n;
+    int64_t strideB = ldb * nrhs;
+    int64_t stride_ipiv = n;
+    size_t size_A = (size_t) strideA * batch;
+    size_t size_B = (size_t) strideB * batch;
+    size_t size_ipiv = (size_t) stride_ipiv * batch;
+
+    // interleaved matrices use ld = n; padding doesn't help within a group
+    int64_t ldai = blas::max( 1, n );
+    std::vector< scalar_t > Ai( il::size< scalar_t >( ldai, n, batch ) );
+    std::vector< scalar_t > Bi( il::size< scalar_t >( ldai, nrhs, batch ) );
+
+    std::vector< scalar_t > A_tst( size_A ), A_ref( size_A );
+    std::vector< scalar_t > B_tst( size_B ), B_ref( size_B );
+    std::vector< int64_t > ipiv_tst( size_ipiv ), ipiv_ref( size_ipiv );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*strideA ], lda );
+    }
+    A_ref = A_tst;
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    B_ref = B_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%lld, lanes=%lld, threads=%d\n",
+                (lld) n, (lld) lda, (lld) batch,
+                (lld) il::lanes< scalar_t >(), lapack::get_num_threads() );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        std::vector< int64_t > info;
+        assert_throw( il::pack( n, n, &A_tst[0], n-1, strideA, &Ai[0], ldai, batch ), lapack::Error );
+        assert_throw( il::pack( n, n, &A_tst[0], lda, lda*n-1, &Ai[0], ldai, batch ), lapack::Error );
+        if (routine == Interleaved::getrf) {
+            assert_throw( il::getrf( -1,  n, &Ai[0], ldai, &ipiv_tst[0], stride_ipiv, batch, info ), lapack::Error );
+            assert_throw( il::getrf(  n, -1, &Ai[0], ldai, &ipiv_tst[0], stride_ipiv, batch, info ), lapack::Error );
+            assert_throw( il::getrf(  n,  n, &Ai[0], n-1,  &ipiv_tst[0], stride_ipiv, batch, info ), lapack::Error );
+            assert_throw( il::getrf(  n,  n, &Ai[0], ldai, &ipiv_tst[0], n-1, batch, info ), lapack::Error );
+        }
+        else {
+            assert_throw( il::potrf( uplo, -1, &Ai[0], ldai, batch, info ), lapack::Error );
+            assert_throw( il::potrf( uplo,  n, &Ai[0], n-1,  batch, info ), lapack::Error );
+        }
+    }
+
+    // ---------- run test
+    double time = testsweeper::get_wtime();
+    il::pack( n, n, &A_tst[0], lda, strideA, &Ai[0], ldai, batch );
+    time = testsweeper::get_wtime() - time;
+    if (verbose >= 1) {
+        printf( "pack time %.4f s\n", time );
+    }
+
+    std::vector< int64_t > info_tst;
+    double gflop;
+    time = testsweeper::get_wtime();
+    if (routine == Interleaved::getrf) {
+        il::getrf( n, n, &Ai[0], ldai, &ipiv_tst[0], stride_ipiv,
+                   batch, info_tst );
+        time = testsweeper::get_wtime() - time;
+        gflop = batch * lapack::Gflop< scalar_t >::getrf( n, n );
+    }
+    else {
+        il::potrf( uplo, n, &Ai[0], ldai, batch, info_tst );
+        time = testsweeper::get_wtime() - time;
+        gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    }
+    int64_t nfailed = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0)
+            ++nfailed;
+    }
+    if (nfailed != 0) {
+        fprintf( stderr, "lapack::interleaved returned error for %lld matrices\n",
+                 (lld) nfailed );
+    }
+
+    params.time() = time;
+    params.gflops() = gflop / time;
+    params.matrices_per_sec() = batch / time;
+
+    if (params.check() == 'y') {
+        // ---------- solve
+        il::pack( n, nrhs, &B_tst[0], ldb, strideB, &Bi[0], ldai, batch );
+        if (routine == Interleaved::getrf) {
+            il::getrs( lapack::Op::NoTrans, n, nrhs, &Ai[0], ldai,
+                       &ipiv_tst[0], stride_ipiv, &Bi[0], ldai,
+                       batch, info_tst );
+        }
+        else {
+            il::potrs( uplo, n, nrhs, &Ai[0], ldai, &Bi[0], ldai,
+                       batch, info_tst );
+        }
+        il::unpack( n, nrhs, &Bi[0], ldai, &B_tst[0], ldb, strideB, batch );
+
+        // ---------- check error
+        // max over batch of ||b - Ax|| / (n ||A|| ||x||),
+        // with original A in A_ref and b in B_ref.
+        real_t error = 0;
+        for (int64_t i = 0; i < batch; ++i) {
+            scalar_t* A_i = &A_ref[ i*strideA ];
+            scalar_t* B_i = &B_ref[ i*strideB ];
+            scalar_t* X_i = &B_tst[ i*strideB ];
+            real_t Anorm, Xnorm, Rnorm;
+            Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, X_i, ldb );
+            if (routine == Interleaved::getrf) {
+                Anorm = lapack::lange( lapack::Norm::One, n, n, A_i, lda );
+                blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                            n, nrhs, n,
+                            -1.0, A_i, lda,
+                                  X_i, ldb,
+                             1.0, B_i, ldb );
+            }
+            else {
+                Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, A_i, lda );
+                blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                            n, nrhs,
+                            -1.0, A_i, lda,
+                                  X_i, ldb,
+                             1.0, B_i, ldb );
+            }
+            Rnorm = lapack::lange( lapack::Norm::One, n, nrhs, B_i, ldb );
+            if (n > 0 && Anorm > 0 && Xnorm > 0)
+                error = blas::max( error, Rnorm / (n * Anorm * Xnorm) );
+        }
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference: strided batch
+        std::vector< int64_t > info_ref;
+        time = testsweeper::get_wtime();
+        if (routine == Interleaved::getrf) {
+            lapack::getrf_batch( n, n, &A_ref[0], lda, strideA,
+                                 &ipiv_ref[0], stride_ipiv, batch, info_ref );
+        }
+        else {
+            lapack::potrf_batch( uplo, n, &A_ref[0], lda, strideA,
+                                 batch, info_ref );
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+
+        // ---------- check factors compared to reference
+        // Pivots can differ only for ties, which random matrices don't have.
+        il::unpack( n, n, &Ai[0], ldai, &A_tst[0], lda, strideA, batch );
+        real_t error2 = rel_error( A_tst, A_ref );
+        if (routine == Interleaved::getrf && ipiv_tst != ipiv_ref)
+            error2 = 1;
+        params.error2() = error2;
+        params.okay() = params.okay() && (error2 < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+static void test_getrf_interleaved_dispatch(
+    Params& params, bool run, Interleaved routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_interleaved_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_interleaved_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_interleaved_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_interleaved_work< std::complex<double> >( params, run, routine );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_getrf_interleaved( Params& params, bool run )
+{
+    test_getrf_interleaved_dispatch( params, run, Interleaved::getrf );
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_interleaved( Params& params, bool run )
+{
+    test_getrf_interleaved_dispatch( params, run, Interleaved::potrf );
+}
@@ -98,6 +98,19 @@ void test_getrs_work( Params& params, bool run )
     }
 
     if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run lapack_int pivot version, in LP64 builds
+        // It passes ipiv to LAPACK without a 32-bit copy; B must be identical.
+        real_t error_lp = 0;
+        #ifndef LAPACK_ILP64
+            std::vector< scalar_t > B_lp = B_ref;  // original B
+            int64_t info_lp = lapack::getrs( trans, n, nrhs, &A[0], lda,
+                                             &ipiv_ref[0], &B_lp[0], ldb );
+            if (info_lp != info_tst) {
+                error_lp = 1;
+            }
+            error_lp += abs_error( B_lp, B_tst );
+        #endif
+
         // ---------- run reference
         testsweeper::flush_cache( params.cache() );
         time = testsweeper::get_wtime();
@@ -119,7 +132,7 @@ void test_getrs_work( Params& params, bool run )
         if (info_tst != info_ref) {
             error = 1;
         }
-        error += abs_error( B_tst, B_ref );
+        error += abs_error( B_tst, B_ref ) + error_lp;
         params.error() = error;
         params.okay() = (error == 0);  // expect lapackpp == lapacke
     }
@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <algorithm>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Solves with the device getrs, using an LU factorization computed on the
+// host, and compares X with the host getrs.
+template< typename scalar_t >
+void test_getrs_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Op trans = params.trans();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    if (lapack::get_device_count() == 0) {
+        params.msg() = "skipping: no devices";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > B_tst( size_B );
+    std::vector< scalar_t > B_ref( size_B );
+    std::vector< int64_t > ipiv( blas::max( 1, n ) );
+    std::vector< lapack::device_pivot_int > ipiv_dev( blas::max( 1, n ) );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    B_ref = B_tst;
+
+    // factor A into LU
+    int64_t info = lapack::getrf( n, n, &A[0], lda, &ipiv[0] );
+    if (info != 0) {
+        fprintf( stderr, "lapack::getrf returned error %lld\n", (lld) info );
+    }
+    std::copy( ipiv.begin(), ipiv.end(), ipiv_dev.begin() );
+
+    // Allocate and copy to device.
+    lapack::Queue queue( device, 0 );
+    scalar_t*        dA     = lapack::device_malloc< scalar_t >( size_A, queue );
+    scalar_t*        dB_tst = lapack::device_malloc< scalar_t >( size_B, queue );
+    device_info_int* d_info = lapack::device_malloc< device_info_int >( 1, queue );
+    lapack::device_pivot_int* d_ipiv
+        = lapack::device_malloc< lapack::device_pivot_int >( ipiv_dev.size(), queue );
+    lapack::device_memcpy( d_ipiv, ipiv_dev.data(), ipiv_dev.size(), queue );
+    lapack::device_setmatrix( n, n,    A.data(),     lda, dA,     lda, queue );
+    lapack::device_setmatrix( n, nrhs, B_tst.data(), ldb, dB_tst, ldb, queue );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld\n"
+                "B n=%5lld, nrhs=%5lld, ldb=%5lld\n",
+                (lld) n, (lld) lda,
+                (lld) n, (lld) nrhs, (lld) ldb );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A[0], lda );
+        printf( "B = " ); print_matrix( n, nrhs, &B_tst[0], ldb );
+    }
+
+    // Allocate workspace
+    size_t d_size, h_size;
+    lapack::getrs_work_size_bytes( trans, n, nrhs, dA, lda, &d_size, &h_size, queue );
+    char* d_work = lapack::device_malloc< char >( d_size, queue );
+    std::vector<char> h_work_vector( h_size );
+    char* h_work = h_work_vector.data();
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Op;
+        assert_throw( lapack::getrs( Op(0),  n, nrhs, dA, lda, d_ipiv, dB_tst, ldb, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::getrs( trans, -1, nrhs, dA, lda, d_ipiv, dB_tst, ldb, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::getrs( trans,  n,   -1, dA, lda, d_ipiv, dB_tst, ldb, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::getrs( trans,  n, nrhs, dA, n-1, d_ipiv, dB_tst, ldb, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::getrs( trans,  n, nrhs, dA, lda, d_ipiv, dB_tst, n-1, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::getrs( trans, n, nrhs, dA, lda, d_ipiv, dB_tst, ldb,
+                   d_work, d_size, h_work, h_size, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::getrs( n, nrhs );
+    params.gflops() = gflop / time;
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    lapack::device_getmatrix( n, nrhs, dB_tst, ldb, B_tst.data(), ldb, queue );
+    lapack::device_memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::getrs returned error %lld\n", (lld) info_tst );
+    }
+
+    // Cleanup device memory.
+    lapack::device_free( dA,     queue );
+    lapack::device_free( dB_tst, queue );
+    lapack::device_free( d_info, queue );
+    lapack::device_free( d_ipiv, queue );
+    lapack::device_free( d_work, queue );
+
+    if (verbose >= 2) {
+        printf( "X = " ); print_matrix( n, nrhs, &B_tst[0], ldb );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::getrs( trans, n, nrhs, &A[0], lda, &ipiv[0], &B_ref[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::getrs returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 2) {
+            printf( "Xref = " ); print_matrix( n, nrhs, &B_ref[0], ldb );
+        }
+
+        // ---------- check error compared to host
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        if (n > 0 && nrhs > 0)
+            error += rel_error( B_tst, B_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_getrs_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_getrs_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrs_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrs_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrs_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,280 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Throughput of batched Hermitian eigensolvers: runs the strided heevd_batch
+// or heevr_batch on batch n-by-n matrices; --jobz n is eigenvalues only.
+// Ref. is a serial loop of lapack::heevd or heevr.
+// Checks
+//   error:  if jobz = Vec, max over the batch of
+//           ||A Z - Z Lambda|| / (n ||A|| ||Z||);
+//   error2: difference of eigenvalues from the serial loop.
+// For both, the pointer-array variant must match the strided variant.
+enum class BatchEig { heevd, heevr };
+
+template< typename scalar_t >
+void test_heevd_batch_work( Params& params, bool run, BatchEig routine )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // get_range fills in range, il, iu, vl, vu
+    lapack::Range range = lapack::Range::All;
+    real_t  vl = 0, vu = 0;
+    int64_t il = 1, iu = n;
+    if (routine == BatchEig::heevr)
+        params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    // mark non-standard output values
+    params.error2();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run)
+        return;
+
+    // skip invalid ranges
+    if (il > iu) {
+        params.msg() = "skipping: requires 1 <= il <= iu <= n";
+        return;
+    }
+
+    // ---------- setup
+    bool wantz = (jobz == lapack::Job::Vec);
+    real_t abstol = 0;  // default value
+    // max number of eigenvalues found
+    int64_t m = (range == lapack::Range::Index ? iu - il + 1 : n);
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldz = lda;
+    int64_t strideA = lda * n;
+    int64_t strideW = n;
+    int64_t strideZ = 0;
+    int64_t stride_isuppz = 0;
+    if (routine == BatchEig::heevr && wantz) {
+        strideZ = ldz * blas::max( 1, m );
+        stride_isuppz = 2 * blas::max( 1, m );
+    }
+    else if (routine == BatchEig::heevr) {
+        ldz = 1;
+    }
+    size_t size_A = (size_t) strideA * batch;
+    size_t size_W = (size_t) strideW * batch;
+    size_t size_Z = (size_t) strideZ * batch;
+    size_t size_isuppz = (size_t) stride_isuppz * batch;
+
+    std::vector< scalar_t > A( size_A ), A_tst( size_A ), A_ptr( size_A );
+    std::vector< scalar_t > Z_tst( size_Z ), Z_ptr( size_Z );
+    std::vector< real_t > W_tst( size_W ), W_ptr( size_W ), W_ref( size_W );
+    std::vector< int64_t > isuppz_tst( size_isuppz ), isuppz_ptr( size_isuppz );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A[ i*strideA ], lda );
+    }
+    A_tst = A;
+    A_ptr = A;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%lld, threads=%d\n",
+                (lld) n, (lld) lda, (lld) batch, lapack::get_num_threads() );
+    }
+
+    // ---------- run test
+    std::vector< int64_t > info_tst, nfound_tst;
+    double time = testsweeper::get_wtime();
+    if (routine == BatchEig::heevd) {
+        lapack::heevd_batch( jobz, uplo, n, &A_tst[0], lda, strideA,
+                             W_tst.data(), strideW, batch, info_tst );
+    }
+    else {
+        lapack::heevr_batch( jobz, range, uplo, n, &A_tst[0], lda, strideA,
+                             vl, vu, il, iu, abstol, nfound_tst,
+                             W_tst.data(), strideW,
+                             Z_tst.data(), ldz, strideZ,
+                             isuppz_tst.data(), stride_isuppz,
+                             batch, info_tst );
+    }
+    time = testsweeper::get_wtime() - time;
+    int64_t nfailed = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0)
+            ++nfailed;
+    }
+    if (nfailed != 0) {
+        fprintf( stderr, "batch routine returned error for %lld matrices\n",
+                 (lld) nfailed );
+    }
+
+    params.time() = time;
+    params.matrices_per_sec() = batch / time;
+
+    if (params.check() == 'y') {
+        // ---------- run pointer-array variant, which should match
+        std::vector< scalar_t* > Aarray( batch ), Zarray( batch, nullptr );
+        std::vector< real_t* > Warray( batch );
+        std::vector< int64_t* > isuppz_array( batch, nullptr );
+        for (int64_t i = 0; i < batch; ++i) {
+            Aarray[ i ] = &A_ptr[ i*strideA ];
+            Warray[ i ] = &W_ptr[ i*strideW ];
+            if (size_Z > 0) {
+                Zarray[ i ] = &Z_ptr[ i*strideZ ];
+                isuppz_array[ i ] = &isuppz_ptr[ i*stride_isuppz ];
+            }
+        }
+        std::vector< int64_t > info_ptr, nfound_ptr;
+        bool same;
+        if (routine == BatchEig::heevd) {
+            lapack::heevd_batch( { jobz }, { uplo }, { n }, Aarray, { lda },
+                                 Warray, batch, info_ptr );
+            same = (W_ptr == W_tst && (! wantz || A_ptr == A_tst));
+        }
+        else {
+            lapack::heevr_batch( { jobz }, { range }, { uplo }, { n },
+                                 Aarray, { lda },
+                                 { vl }, { vu }, { il }, { iu }, { abstol },
+                                 nfound_ptr, Warray, Zarray, { ldz },
+                                 isuppz_array, batch, info_ptr );
+            same = (nfound_ptr == nfound_tst && W_ptr == W_tst
+                    && Z_ptr == Z_tst);
+        }
+        if (! same) {
+            fprintf( stderr, "pointer-array and strided variants differ\n" );
+        }
+
+        // ---------- check error
+        // max over batch of ||A Z - Z Lambda|| / (n ||A|| ||Z||)
+        real_t error = 0;
+        if (wantz) {
+            std::vector< scalar_t > R( (size_t) lda * n );
+            for (int64_t i = 0; i < batch; ++i) {
+                scalar_t* A_i = &A[ i*strideA ];
+                scalar_t* Z_i;
+                int64_t nz = n;
+                if (routine == BatchEig::heevd) {
+                    Z_i = &A_tst[ i*strideA ];  // vectors overwrite A
+                }
+                else {
+                    Z_i = &Z_tst[ i*strideZ ];
+                    nz = nfound_tst[ i ];
+                }
+                if (nz == 0)
+                    continue;
+                real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, A_i, lda );
+                real_t Znorm = lapack::lange( lapack::Norm::One, n, nz, Z_i, ldz );
+                // R = Z Lambda
+                lapack::lacpy( lapack::MatrixType::General, n, nz,
+                               Z_i, ldz, &R[0], lda );
+                col_scale( n, nz, &R[0], lda, &W_tst[ i*strideW ] );
+                // R = A Z - (Z Lambda)
+                blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                            n, nz,
+                             1.0, A_i, lda,
+                                  Z_i, ldz,
+                            -1.0, &R[0], lda );
+                real_t Rnorm = lapack::lange( lapack::Norm::One, n, nz, &R[0], lda );
+                if (Anorm > 0 && Znorm > 0)
+                    error = blas::max( error, Rnorm / (n * Anorm * Znorm) );
+            }
+        }
+        params.error() = error;
+        params.okay() = (error < tol && same);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference: serial loop
+        std::vector< scalar_t > A_ref = A;
+        std::vector< scalar_t > Z_ref( (size_t) ldz * blas::max( 1, m ) );
+        std::vector< int64_t > isuppz_ref( 2 * blas::max( 1, n ) );
+        int64_t info_ref = 0, nfound_ref = 0;
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            if (routine == BatchEig::heevd) {
+                info_ref = lapack::heevd(
+                    jobz, uplo, n, &A_ref[ i*strideA ], lda,
+                    &W_ref[ i*strideW ] );
+            }
+            else {
+                info_ref = lapack::heevr(
+                    jobz, range, uplo, n, &A_ref[ i*strideA ], lda,
+                    vl, vu, il, iu, abstol, &nfound_ref,
+                    &W_ref[ i*strideW ], &Z_ref[0], ldz, &isuppz_ref[0] );
+            }
+            if (info_ref != 0) {
+                fprintf( stderr, "serial loop returned error %lld\n",
+                         (lld) info_ref );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+
+        // ---------- check error compared to reference
+        real_t error2 = rel_error( W_tst, W_ref );
+        params.error2() = error2;
+        params.okay() = params.okay() && (error2 < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+static void test_heevd_batch_dispatch(
+    Params& params, bool run, BatchEig routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_heevd_batch_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_batch_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_batch_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_batch_work< std::complex<double> >( params, run, routine );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heevd_batch( Params& params, bool run )
+{
+    test_heevd_batch_dispatch( params, run, BatchEig::heevd );
+}
+
+// -----------------------------------------------------------------------------
+void test_heevr_batch( Params& params, bool run )
+{
+    test_heevd_batch_dispatch( params, run, BatchEig::heevr );
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Computes eigenvalues with the device heevd and compares them with the
+// host heevd. Eigenvectors are unique only up to a unit scaling, so
+// instead they are checked for orthogonality.
+template< typename scalar_t >
+void test_heevd_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    if (lapack::get_device_count() == 0) {
+        params.msg() = "skipping: no devices";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_W = (size_t) blas::max( 1, n );
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< real_t > W_tst( size_W );
+    std::vector< real_t > W_ref( size_W );
+
+    lapack::generate_matrix( params.matrix, n, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    // Allocate and copy to device.
+    lapack::Queue queue( device, 0 );
+    scalar_t*        dA_tst = lapack::device_malloc< scalar_t >( size_A, queue );
+    real_t*          dW_tst = lapack::device_malloc< real_t >( size_W, queue );
+    device_info_int* d_info = lapack::device_malloc< device_info_int >( 1, queue );
+    lapack::device_setmatrix( n, n, A_tst.data(), lda, dA_tst, lda, queue );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld\n",
+                (lld) n, (lld) lda );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A_tst[0], lda );
+    }
+
+    // Allocate workspace
+    size_t d_size, h_size;
+    lapack::heevd_work_size_bytes( jobz, uplo, n, dA_tst, lda, &d_size, &h_size, queue );
+    char* d_work = lapack::device_malloc< char >( d_size, queue );
+    std::vector<char> h_work_vector( h_size );
+    char* h_work = h_work_vector.data();
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        using lapack::Uplo;
+        assert_throw( lapack::heevd( Job(0), uplo,     n, dA_tst, lda, dW_tst, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::heevd( jobz,   Uplo(0),  n, dA_tst, lda, dW_tst, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::heevd( jobz,   uplo,    -1, dA_tst, lda, dW_tst, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+        assert_throw( lapack::heevd( jobz,   uplo,     n, dA_tst, n-1, dW_tst, d_work, d_size, h_work, h_size, d_info, queue ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::heevd( jobz, uplo, n, dA_tst, lda, dW_tst,
+                   d_work, d_size, h_work, h_size, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    lapack::device_getmatrix( n, n, dA_tst, lda, A_tst.data(), lda, queue );
+    lapack::device_memcpy( W_tst.data(), dW_tst, size_W, queue );
+    lapack::device_memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::heevd returned error %lld\n", (lld) info_tst );
+    }
+
+    // Cleanup device memory.
+    lapack::device_free( dA_tst, queue );
+    lapack::device_free( dW_tst, queue );
+    lapack::device_free( d_info, queue );
+    lapack::device_free( d_work, queue );
+
+    if (verbose >= 2) {
+        printf( "W = " ); print_vector( n, &W_tst[0], 1 );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevd( jobz, uplo, n, &A_ref[0], lda, &W_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevd returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        if (verbose >= 2) {
+            printf( "Wref = " ); print_vector( n, &W_ref[0], 1 );
+        }
+
+        // ---------- check error compared to host
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        if (n > 0 && lapack::lange( lapack::Norm::Fro, n, 1, &W_ref[0], n ) > 0)
+            error += rel_error( W_tst, W_ref );
+        params.error() = error;
+
+        // ---------- check orthogonality, || I - Z^H Z || / n
+        real_t ortho = 0;
+        if (jobz == lapack::Job::Vec && n > 0) {
+            std::vector< scalar_t > R( n * n );
+            lapack::laset( lapack::MatrixType::Upper, n, n, 0.0, 1.0, &R[0], n );
+            blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                        n, n, -1.0, &A_tst[0], lda, 1.0, &R[0], n );
+            ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, n, &R[0], n ) / n;
+        }
+        params.ortho() = ortho;
+        params.okay() = (error < tol) && (ortho < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heevd_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevd_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
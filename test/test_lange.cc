@@ -28,9 +28,9 @@ void test_lange_work( Params& params, bool run )
     params.matrix.mark();
 
     // mark non-standard output values
+    params.gbytes();
     params.ref_time();
-    //params.ref_gflops();
-    //params.gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -59,8 +59,8 @@ void test_lange_work( Params& params, bool run )
     time = testsweeper::get_wtime() - time;
 
     params.time() = time;
-    //double gflop = lapack::Gflop< scalar_t >::lange( norm, m, n );
-    //params.gflops() = gflop / time;
+    double gbyte = lapack::Gbyte< scalar_t >::lange( m, n );
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 1) {
         printf( "norm_tst = %.8e\n", norm_tst );
@@ -74,7 +74,7 @@ void test_lange_work( Params& params, bool run )
         time = testsweeper::get_wtime() - time;
 
         params.ref_time() = time;
-        //params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 1) {
             printf( "norm_ref = %.8e\n", norm_ref );
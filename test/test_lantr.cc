@@ -30,9 +30,9 @@ void test_lantr_work( Params& params, bool run )
     params.matrix.mark();
 
     // mark non-standard output values
+    params.gbytes();
     params.ref_time();
-    //params.ref_gflops();
-    //params.gflops();
+    params.ref_gbytes();
     params.msg();
 
     if (! run)
@@ -64,8 +64,8 @@ void test_lantr_work( Params& params, bool run )
     time = testsweeper::get_wtime() - time;
 
     params.time() = time;
-    //double gflop = lapack::Gflop< scalar_t >::lantr( norm, diag, m, n );
-    //params.gflops() = gflop / time;
+    double gbyte = lapack::Gbyte< scalar_t >::lantr( uplo, m, n );
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 1) {
         printf( "norm_tst = %.8e\n", norm_tst );
@@ -79,7 +79,7 @@ void test_lantr_work( Params& params, bool run )
         time = testsweeper::get_wtime() - time;
 
         params.ref_time() = time;
-        //params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 1) {
             printf( "norm_ref = %.8e\n", norm_ref );
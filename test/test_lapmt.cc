@@ -0,0 +1,151 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "lapacke_wrappers.hh"
+
+#include <algorithm>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Permutes the columns of X by a random permutation K. Checks the in-place
+// lapmt (error) and the out-of-place lapmt (error2) against LAPACKE.
+template< typename scalar_t >
+void test_lapmt_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    bool forwrd = (params.direction() == lapack::Direction::Forward);
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.gbytes();
+    params.ref_time();
+    params.ref_gbytes();
+    params.error2();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t ldx = roundup( blas::max( 1, m ), align );
+    size_t size_X = (size_t) ldx * n;
+
+    std::vector< scalar_t > X_tst( size_X );
+    std::vector< scalar_t > X_ref( size_X );
+    std::vector< scalar_t > X_in( size_X );
+    std::vector< scalar_t > Y_tst( size_X );
+    std::vector< int64_t > K_tst( n );
+    std::vector< lapack_int > K_ref( n );
+
+    lapack::generate_matrix( params.matrix, m, n, &X_tst[0], ldx );
+    X_ref = X_tst;
+    X_in  = X_tst;
+
+    // random permutation: sort indices by random keys
+    std::vector< real_t > keys( n );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, keys.size(), keys.data() );
+    for (int64_t i = 0; i < n; ++i)
+        K_tst[ i ] = i + 1;
+    std::sort( K_tst.begin(), K_tst.end(),
+               [&]( int64_t a, int64_t b ) { return keys[ a-1 ] < keys[ b-1 ]; } );
+    std::copy( K_tst.begin(), K_tst.end(), K_ref.begin() );
+
+    if (verbose >= 2) {
+        printf( "K = [" );
+        for (int64_t i = 0; i < n; ++i)
+            printf( " %lld", (lld) K_tst[ i ] );
+        printf( " ];\n" );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::lapmt( forwrd, m, n, &X_tst[0], ldx, &K_tst[0] );
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    double gbyte = lapack::Gbyte< scalar_t >::lapmt( m, n );
+    params.gbytes() = gbyte / time;
+
+    // ---------- run out-of-place version
+    double time2 = testsweeper::get_wtime();
+    lapack::lapmt( forwrd, m, n, (scalar_t const*) &X_in[0], ldx,
+                   (int64_t const*) &K_tst[0], &Y_tst[0], ldx );
+    time2 = testsweeper::get_wtime() - time2;
+    if (verbose >= 1) {
+        printf( "out-of-place time %.4f, %.2f GB/s\n", time2, gbyte / time2 );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = LAPACKE_lapmt( forwrd, m, n, &X_ref[0], ldx, &K_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "LAPACKE_lapmt returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gbytes() = gbyte / time;
+
+        // ---------- check error compared to reference
+        real_t error = abs_error( X_tst, X_ref );
+        for (int64_t i = 0; i < n; ++i) {
+            if (K_tst[ i ] != K_ref[ i ])
+                error += 1;
+        }
+        // compare only the m-by-n part of Y, as padding differs
+        real_t error2 = 0;
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                error2 = blas::max( error2, std::abs( Y_tst[ i + j*ldx ]
+                                                      - X_ref[ i + j*ldx ] ) );
+            }
+        }
+        params.error() = error;
+        params.error2() = error2;
+        params.okay() = (error == 0 && error2 == 0);  // expect lapackpp == lapacke
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_lapmt( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_lapmt_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_lapmt_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_lapmt_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_lapmt_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "lapacke_wrappers.hh"
+
+#include <vector>
+
+#if LAPACK_VERSION >= 30600  // >= 3.6.0
+
+// -----------------------------------------------------------------------------
+// Scales A by cto / cfrom, with cto = alpha and cfrom = beta.
+template< typename scalar_t >
+void test_lascl_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::MatrixType matrixtype = params.matrixtype();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    real_t cto = params.alpha();
+    real_t cfrom = params.beta();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gbytes();
+    params.gbytes();
+
+    if (! run)
+        return;
+
+    if (matrixtype == lapack::MatrixType::LowerBand
+        || matrixtype == lapack::MatrixType::UpperBand
+        || matrixtype == lapack::MatrixType::Band) {
+        params.msg() = "skipping: band types not yet supported";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::lascl( matrixtype, 0, 0, cfrom, cto, m, n, &A_tst[0], lda );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::lascl returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+    double gbyte = lapack::Gbyte< scalar_t >::lascl( matrixtype, m, n );
+    params.gbytes() = gbyte / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = LAPACKE_lascl( matrixtype2char(matrixtype), 0, 0, cfrom, cto, m, n, &A_ref[0], lda );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "LAPACKE_lascl returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gbytes() = gbyte / time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        error += abs_error( A_tst, A_ref );
+        params.error() = error;
+        params.okay() = (error == 0);  // expect lapackpp == lapacke
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_lascl( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_lascl_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_lascl_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_lascl_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_lascl_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+#else
+
+// -----------------------------------------------------------------------------
+void test_lascl( Params& params, bool run )
+{
+    fprintf( stderr, "lascl requires LAPACK >= 3.6.0\n\n" );
+    exit(0);
+}
+
+#endif  // LAPACK >= 3.6.0
@@ -30,8 +30,8 @@ void test_laset_work( Params& params, bool run )
 
     // mark non-standard output values
     params.ref_time();
-    //params.ref_gflops();
-    //params.gflops();
+    params.ref_gbytes();
+    params.gbytes();
 
     if (! run)
         return;
@@ -53,8 +53,8 @@ void test_laset_work( Params& params, bool run )
     time = testsweeper::get_wtime() - time;
 
     params.time() = time;
-    //double gflop = lapack::Gflop< scalar_t >::laset( m, n, alpha, beta );
-    //params.gflops() = gflop / time;
+    double gbyte = lapack::Gbyte< scalar_t >::laset( matrixtype, m, n );
+    params.gbytes() = gbyte / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         // ---------- run reference
@@ -67,7 +67,7 @@ void test_laset_work( Params& params, bool run )
         }
 
         params.ref_time() = time;
-        //params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // ---------- check error compared to reference
         real_t error = 0;
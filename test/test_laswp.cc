@@ -24,12 +24,13 @@ void test_laswp_work( Params& params, bool run )
     int64_t n = params.dim.n();
     int64_t incx = params.incx();
     int64_t align = params.align();
+    lapack::SwapMethod method = params.method();
     params.matrix.mark();
 
     // mark non-standard output values
+    params.gbytes();
     params.ref_time();
-    //params.ref_gflops();
-    //params.gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -60,12 +61,12 @@ void test_laswp_work( Params& params, bool run )
     // ---------- run test
     testsweeper::flush_cache( params.cache() );
     double time = testsweeper::get_wtime();
-    lapack::laswp( n, &A_tst[0], lda, k1, k2, &ipiv_tst[0], incx );
+    lapack::laswp( method, n, &A_tst[0], lda, k1, k2, &ipiv_tst[0], incx );
     time = testsweeper::get_wtime() - time;
 
     params.time() = time;
-    //double gflop = lapack::Gflop< scalar_t >::laswp( n );
-    //params.gflops() = gflop / time;
+    double gbyte = lapack::Gbyte< scalar_t >::laswp( n, k2 - k1 + 1 );
+    params.gbytes() = gbyte / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         // ---------- run reference
@@ -78,7 +79,7 @@ void test_laswp_work( Params& params, bool run )
         }
 
         params.ref_time() = time;
-        //params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // ---------- check error compared to reference
         real_t error = 0;
@@ -0,0 +1,924 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/plan.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <memory>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Sets error = max( error, relative error of x ), if xref is non-empty.
+template< typename T >
+static void max_rel_error(
+    std::vector< T >& x, std::vector< T >& xref,
+    blas::real_type< T >* error )
+{
+    if (xref.size() > 0)
+        *error = blas::max( *error, rel_error( x, xref ) );
+}
+
+// -----------------------------------------------------------------------------
+// Calls copy_input then execute twice, so the second execute reuses the
+// plan's workspace. Adds the time of the second execute to time.
+template< typename CopyInput, typename Execute >
+static void execute_twice( CopyInput copy_input, Execute execute, double* time )
+{
+    for (int iter = 0; iter < 2; ++iter) {
+        copy_input();
+        double t = testsweeper::get_wtime();
+        execute();
+        if (iter == 1)
+            *time += testsweeper::get_wtime() - t;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Executes plan p of sysv, hesv, or a variant on the lower triangle of C
+// and on B, and calls the regular wrapper via solve. Checks that the
+// factors, pivots, and solutions match.
+template< typename scalar_t, typename Plan, typename Solve >
+static void execute_indefinite_solve(
+    Plan& p, Solve solve, int64_t n,
+    std::vector< scalar_t > const& C, int64_t ldc,
+    std::vector< scalar_t > const& B, int64_t ldb,
+    double* time, double* ref_time,
+    blas::real_type< scalar_t >* error, bool* pivots_okay )
+{
+    std::vector< scalar_t > C_tst, C_ref = C, B_tst, B_ref = B;
+    std::vector< int64_t > ipiv_tst( blas::max( 1, n ) );
+    std::vector< int64_t > ipiv_ref( blas::max( 1, n ) );
+    execute_twice(
+        [&]() { C_tst = C; B_tst = B; },
+        [&]() { p.execute( &C_tst[0], ldc, &ipiv_tst[0], &B_tst[0], ldb ); },
+        time );
+
+    double t = testsweeper::get_wtime();
+    solve( &C_ref[0], &ipiv_ref[0], &B_ref[0] );
+    *ref_time += testsweeper::get_wtime() - t;
+
+    max_rel_error( C_tst, C_ref, error );
+    max_rel_error( B_tst, B_ref, error );
+    *pivots_okay = *pivots_okay && (ipiv_tst == ipiv_ref);
+}
+
+// -----------------------------------------------------------------------------
+// For each plan, executes it twice, reusing its workspace, and calls the
+// regular wrapper, on the same input. Checks that outputs match.
+// Time is the plans' second executes, ref. time is the regular wrappers.
+template< typename scalar_t >
+void test_plan_work( Params& params, bool run )
+{
+    namespace plan = lapack::plan;
+    using real_t = blas::real_type< scalar_t >;
+    using complex_t = blas::complex_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    // A is m-by-n, for QR, LQ, gels*, gebrd, and SVD; C and D are n-by-n,
+    // for gehrd, hetrd, eigenvalue routines, and indefinite solvers.
+    int64_t minmn = blas::min( m, n );
+    int64_t maxmn = blas::max( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = roundup( blas::max( 1, maxmn ), align );
+    int64_t ldc = roundup( blas::max( 1, n ), align );
+    int64_t ldu = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, minmn ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+    size_t size_C = (size_t) ldc * n;
+    size_t size_U = (size_t) ldu * minmn;
+    size_t size_VT = (size_t) ldvt * n;
+
+    std::vector< scalar_t > A( size_A ), B( size_B ), C( size_C ), D( size_C );
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, maxmn, nrhs, &B[0], ldb );
+    lapack::generate_matrix( params.matrix, n, n, &C[0], ldc );
+    lapack::generate_matrix( params.matrix, n, n, &D[0], ldc );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld\n"
+                "B m=%5lld, nrhs=%5lld, ldb=%5lld\n"
+                "C n=%5lld, ldc=%5lld\n",
+                (lld) m, (lld) n, (lld) lda,
+                (lld) maxmn, (lld) nrhs, (lld) ldb,
+                (lld) n, (lld) ldc );
+    }
+
+    real_t error = 0;
+    bool pivots_okay = true;
+    double time = 0, ref_time = 0, t;
+
+    //--------------------
+    // geqrf
+    {
+        std::vector< scalar_t > A_tst, A_ref = A;
+        std::vector< scalar_t > tau_tst( minmn ), tau_ref( minmn );
+        plan::geqrf< scalar_t > p( m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() { p.execute( &A_tst[0], lda, &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::geqrf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+    }
+
+    //--------------------
+    // gelqf, geqp3
+    {
+        std::vector< scalar_t > A_tst, A_ref = A;
+        std::vector< scalar_t > tau_tst( minmn ), tau_ref( minmn );
+        plan::gelqf< scalar_t > p( m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() { p.execute( &A_tst[0], lda, &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gelqf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+
+        // all columns free
+        A_ref = A;
+        std::vector< int64_t > jpvt_tst( n ), jpvt_ref( n, 0 );
+        plan::geqp3< scalar_t > p2( m, n );
+        execute_twice(
+            [&]() { A_tst = A; jpvt_tst.assign( n, 0 ); },
+            [&]() { p2.execute( &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::geqp3( m, n, &A_ref[0], lda, &jpvt_ref[0], &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+        pivots_okay = pivots_okay && (jpvt_tst == jpvt_ref);
+    }
+
+    //--------------------
+    // unmqr, ungqr: apply, then generate, the first minmn columns of Q
+    {
+        std::vector< scalar_t > QR = A, tau( minmn );
+        lapack::geqrf( m, n, &QR[0], lda, &tau[0] );
+
+        std::vector< scalar_t > B_tst, B_ref = B;
+        plan::unmqr< scalar_t > p( lapack::Side::Left, lapack::Op::NoTrans,
+                                   m, nrhs, minmn );
+        execute_twice(
+            [&]() { B_tst = B; },
+            [&]() { p.execute( &QR[0], lda, &tau[0], &B_tst[0], ldb ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::unmqr( lapack::Side::Left, lapack::Op::NoTrans, m, nrhs, minmn,
+                       &QR[0], lda, &tau[0], &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+
+        std::vector< scalar_t > Q_tst, Q_ref = QR;
+        plan::ungqr< scalar_t > p2( m, minmn, minmn );
+        execute_twice(
+            [&]() { Q_tst = QR; },
+            [&]() { p2.execute( &Q_tst[0], lda, &tau[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::ungqr( m, minmn, minmn, &Q_ref[0], lda, &tau[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( Q_tst, Q_ref, &error );
+    }
+
+    //--------------------
+    // gels
+    {
+        std::vector< scalar_t > A_tst, A_ref = A, B_tst, B_ref = B;
+        plan::gels< scalar_t > p( lapack::Op::NoTrans, m, n, nrhs );
+        execute_twice(
+            [&]() { A_tst = A; B_tst = B; },
+            [&]() { p.execute( &A_tst[0], lda, &B_tst[0], ldb ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gels( lapack::Op::NoTrans, m, n, nrhs,
+                      &A_ref[0], lda, &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+    }
+
+    //--------------------
+    // gelsd, gelss
+    {
+        std::vector< scalar_t > A_tst, A_ref = A, B_tst, B_ref = B;
+        std::vector< real_t > S_tst( minmn ), S_ref( minmn );
+        int64_t rank_tst, rank_ref;
+        real_t rcond = -1;
+        plan::gelsd< scalar_t > p( m, n, nrhs );
+        execute_twice(
+            [&]() { A_tst = A; B_tst = B; },
+            [&]() {
+                p.execute( &A_tst[0], lda, &B_tst[0], ldb, &S_tst[0], rcond,
+                           &rank_tst );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gelsd( m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb,
+                       &S_ref[0], rcond, &rank_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        max_rel_error( S_tst, S_ref, &error );
+        pivots_okay = pivots_okay && (rank_tst == rank_ref);
+
+        A_ref = A;
+        B_ref = B;
+        plan::gelss< scalar_t > p2( m, n, nrhs );
+        execute_twice(
+            [&]() { A_tst = A; B_tst = B; },
+            [&]() {
+                p2.execute( &A_tst[0], lda, &B_tst[0], ldb, &S_tst[0], rcond,
+                            &rank_tst );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gelss( m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb,
+                       &S_ref[0], rcond, &rank_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        max_rel_error( S_tst, S_ref, &error );
+        pivots_okay = pivots_okay && (rank_tst == rank_ref);
+    }
+
+    //--------------------
+    // gelsy, gglse
+    {
+        std::vector< scalar_t > A_tst, A_ref = A, B_tst, B_ref = B;
+        std::vector< int64_t > jpvt_tst( n ), jpvt_ref( n, 0 );
+        int64_t rank_tst, rank_ref;
+        real_t rcond = eps;
+        plan::gelsy< scalar_t > p( m, n, nrhs );
+        execute_twice(
+            [&]() { A_tst = A; B_tst = B; jpvt_tst.assign( n, 0 ); },
+            [&]() {
+                p.execute( &A_tst[0], lda, &B_tst[0], ldb, &jpvt_tst[0], rcond,
+                           &rank_tst );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gelsy( m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb,
+                       &jpvt_ref[0], rcond, &rank_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        pivots_okay = pivots_okay && (rank_tst == rank_ref)
+                      && (jpvt_tst == jpvt_ref);
+
+        // Minimize || A x - c || subject to E x = d, with E p-by-n;
+        // p <= n <= m + p.
+        int64_t p_ = blas::min( n, blas::max( n - m, nrhs ) );
+        int64_t lde = roundup( blas::max( 1, p_ ), align );
+        std::vector< scalar_t > E( lde * n ), c( blas::max( 1, m ) );
+        std::vector< scalar_t > d( blas::max( 1, p_ ) );
+        lapack::generate_matrix( params.matrix, p_, n, &E[0], lde );
+        lapack::generate_matrix( params.matrix, m, 1, &c[0], m );
+        lapack::generate_matrix( params.matrix, p_, 1, &d[0], p_ );
+        std::vector< scalar_t > E_tst, E_ref = E, c_tst, c_ref = c;
+        std::vector< scalar_t > d_tst, d_ref = d;
+        std::vector< scalar_t > x_tst( n ), x_ref( n );
+        A_ref = A;
+        plan::gglse< scalar_t > p2( m, n, p_ );
+        execute_twice(
+            [&]() { A_tst = A; E_tst = E; c_tst = c; d_tst = d; },
+            [&]() {
+                p2.execute( &A_tst[0], lda, &E_tst[0], lde, &c_tst[0],
+                            &d_tst[0], &x_tst[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gglse( m, n, p_, &A_ref[0], lda, &E_ref[0], lde, &c_ref[0],
+                       &d_ref[0], &x_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( x_tst, x_ref, &error );
+    }
+
+    //--------------------
+    // gebrd, gehrd
+    {
+        std::vector< scalar_t > A_tst, A_ref = A;
+        std::vector< real_t > D_tst( minmn ), D_ref( minmn );
+        std::vector< real_t > E_tst( minmn ), E_ref( minmn );
+        std::vector< scalar_t > tauq_tst( minmn ), tauq_ref( minmn );
+        std::vector< scalar_t > taup_tst( minmn ), taup_ref( minmn );
+        plan::gebrd< scalar_t > p( m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() {
+                p.execute( &A_tst[0], lda, &D_tst[0], &E_tst[0], &tauq_tst[0],
+                           &taup_tst[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gebrd( m, n, &A_ref[0], lda, &D_ref[0], &E_ref[0],
+                       &tauq_ref[0], &taup_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( D_tst, D_ref, &error );
+        max_rel_error( E_tst, E_ref, &error );
+
+        std::vector< scalar_t > C_tst, C_ref = C;
+        std::vector< scalar_t > tau_tst( n ), tau_ref( n );
+        plan::gehrd< scalar_t > p2( n, 1, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() { p2.execute( &C_tst[0], ldc, &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gehrd( n, 1, n, &C_ref[0], ldc, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+    }
+
+    //--------------------
+    // gesdd, gesvd
+    {
+        std::vector< scalar_t > A_tst, A_ref = A;
+        std::vector< real_t > S_tst( minmn ), S_ref( minmn );
+        std::vector< scalar_t > U_tst( size_U ), U_ref( size_U );
+        std::vector< scalar_t > VT_tst( size_VT ), VT_ref( size_VT );
+        plan::gesdd< scalar_t > p( lapack::Job::SomeVec, m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() {
+                p.execute( &A_tst[0], lda, &S_tst[0], &U_tst[0], ldu,
+                           &VT_tst[0], ldvt );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gesdd( lapack::Job::SomeVec, m, n, &A_ref[0], lda, &S_ref[0],
+                       &U_ref[0], ldu, &VT_ref[0], ldvt );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( S_tst, S_ref, &error );
+        max_rel_error( U_tst, U_ref, &error );
+        max_rel_error( VT_tst, VT_ref, &error );
+
+        A_ref = A;
+        plan::gesvd< scalar_t > p2( lapack::Job::SomeVec, lapack::Job::SomeVec,
+                                    m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() {
+                p2.execute( &A_tst[0], lda, &S_tst[0], &U_tst[0], ldu,
+                            &VT_tst[0], ldvt );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gesvd( lapack::Job::SomeVec, lapack::Job::SomeVec, m, n,
+                       &A_ref[0], lda, &S_ref[0], &U_ref[0], ldu,
+                       &VT_ref[0], ldvt );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( S_tst, S_ref, &error );
+        max_rel_error( U_tst, U_ref, &error );
+        max_rel_error( VT_tst, VT_ref, &error );
+    }
+
+    //--------------------
+    // heevd, heevr: lower triangle of C
+    {
+        std::vector< scalar_t > C_tst, C_ref = C;
+        std::vector< real_t > W_tst( n ), W_ref( n );
+        plan::heevd< scalar_t > p( lapack::Job::Vec, lapack::Uplo::Lower, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() { p.execute( &C_tst[0], ldc, &W_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                       &C_ref[0], ldc, &W_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( C_tst, C_ref, &error );
+
+        // Eigenvalues with index in [1, iu], which the query must accept.
+        C_ref = C;
+        int64_t iu = (n + 1) / 2;
+        std::vector< scalar_t > Z_tst( size_C ), Z_ref( size_C );
+        std::vector< int64_t > isuppz( 2*blas::max( 1, n ) );
+        int64_t nfound_tst, nfound_ref;
+        plan::heevr< scalar_t > p2( lapack::Job::Vec, lapack::Range::Index,
+                                    lapack::Uplo::Lower, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() {
+                p2.execute( &C_tst[0], ldc, real_t( 0 ), real_t( 0 ), 1, iu,
+                            real_t( 0 ), &nfound_tst, &W_tst[0], &Z_tst[0], ldc,
+                            &isuppz[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::heevr( lapack::Job::Vec, lapack::Range::Index,
+                       lapack::Uplo::Lower, n, &C_ref[0], ldc,
+                       real_t( 0 ), real_t( 0 ), 1, iu, real_t( 0 ),
+                       &nfound_ref, &W_ref[0], &Z_ref[0], ldc, &isuppz[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( Z_tst, Z_ref, &error );
+        pivots_okay = pivots_okay && (nfound_tst == nfound_ref);
+    }
+
+    //--------------------
+    // hetrd, heev: lower triangle of C
+    {
+        std::vector< scalar_t > C_tst, C_ref = C;
+        std::vector< real_t > D_tst( n ), D_ref( n ), E_tst( n ), E_ref( n );
+        std::vector< scalar_t > tau_tst( n ), tau_ref( n );
+        plan::hetrd< scalar_t > p( lapack::Uplo::Lower, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() {
+                p.execute( &C_tst[0], ldc, &D_tst[0], &E_tst[0], &tau_tst[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::hetrd( lapack::Uplo::Lower, n, &C_ref[0], ldc,
+                       &D_ref[0], &E_ref[0], &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        max_rel_error( D_tst, D_ref, &error );
+        max_rel_error( E_tst, E_ref, &error );
+
+        C_ref = C;
+        std::vector< real_t > W_tst( n ), W_ref( n );
+        plan::heev< scalar_t > p2( lapack::Job::Vec, lapack::Uplo::Lower, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() { p2.execute( &C_tst[0], ldc, &W_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::heev( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                      &C_ref[0], ldc, &W_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( C_tst, C_ref, &error );
+    }
+
+    //--------------------
+    // sytrf
+    {
+        std::vector< scalar_t > C_tst, C_ref = C;
+        std::vector< int64_t > ipiv_tst( blas::max( 1, n ) );
+        std::vector< int64_t > ipiv_ref( blas::max( 1, n ) );
+        plan::sytrf< scalar_t > p( lapack::Uplo::Lower, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() { p.execute( &C_tst[0], ldc, &ipiv_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::sytrf( lapack::Uplo::Lower, n, &C_ref[0], ldc, &ipiv_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        pivots_okay = pivots_okay && (ipiv_tst == ipiv_ref);
+    }
+
+    //--------------------
+    // sysv, hesv, and variants: lower triangle of C, first n rows of B
+    {
+        lapack::Uplo lower = lapack::Uplo::Lower;
+        plan::sysv< scalar_t > p_sysv( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_sysv,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::sysv( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+
+        plan::hesv< scalar_t > p_hesv( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_hesv,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::hesv( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+
+        plan::sysv_rook< scalar_t > p_sysv_rook( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_sysv_rook,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::sysv_rook( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+
+        plan::hesv_rook< scalar_t > p_hesv_rook( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_hesv_rook,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::hesv_rook( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+
+        plan::sysv_aa< scalar_t > p_sysv_aa( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_sysv_aa,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::sysv_aa( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+
+        plan::hesv_aa< scalar_t > p_hesv_aa( lower, n, nrhs );
+        execute_indefinite_solve(
+            p_hesv_aa,
+            [&]( scalar_t* A_, int64_t* ipiv_, scalar_t* B_ ) {
+                lapack::hesv_aa( lower, n, nrhs, A_, ldc, ipiv_, B_, ldb );
+            },
+            n, C, ldc, B, ldb, &time, &ref_time, &error, &pivots_okay );
+    }
+
+    //--------------------
+    // sysv_rk, hesv_rk: lower triangle of C, first n rows of B
+    {
+        lapack::Uplo lower = lapack::Uplo::Lower;
+        std::vector< scalar_t > C_tst, C_ref = C, B_tst, B_ref = B;
+        std::vector< scalar_t > E_tst( n ), E_ref( n );
+        std::vector< int64_t > ipiv_tst( blas::max( 1, n ) );
+        std::vector< int64_t > ipiv_ref( blas::max( 1, n ) );
+        plan::sysv_rk< scalar_t > p( lower, n, nrhs );
+        execute_twice(
+            [&]() { C_tst = C; B_tst = B; },
+            [&]() {
+                p.execute( &C_tst[0], ldc, &E_tst[0], &ipiv_tst[0],
+                           &B_tst[0], ldb );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::sysv_rk( lower, n, nrhs, &C_ref[0], ldc, &E_ref[0],
+                         &ipiv_ref[0], &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        max_rel_error( B_tst, B_ref, &error );
+        pivots_okay = pivots_okay && (ipiv_tst == ipiv_ref);
+
+        C_ref = C;
+        B_ref = B;
+        plan::hesv_rk< scalar_t > p2( lower, n, nrhs );
+        execute_twice(
+            [&]() { C_tst = C; B_tst = B; },
+            [&]() {
+                p2.execute( &C_tst[0], ldc, &E_tst[0], &ipiv_tst[0],
+                            &B_tst[0], ldb );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::hesv_rk( lower, n, nrhs, &C_ref[0], ldc, &E_ref[0],
+                         &ipiv_ref[0], &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        max_rel_error( B_tst, B_ref, &error );
+        pivots_okay = pivots_okay && (ipiv_tst == ipiv_ref);
+    }
+
+    //--------------------
+    // sysvx, hesvx: lower triangle of C, first n rows of B
+    {
+        lapack::Factored fact = lapack::Factored::NotFactored;
+        lapack::Uplo lower = lapack::Uplo::Lower;
+        int64_t ldx = ldc;
+        std::vector< scalar_t > AF( size_C ), X_tst( ldx * nrhs );
+        std::vector< scalar_t > X_ref( ldx * nrhs );
+        std::vector< int64_t > ipiv( blas::max( 1, n ) );
+        std::vector< real_t > ferr( nrhs ), berr( nrhs );
+        real_t rcond_tst, rcond_ref;
+        plan::sysvx< scalar_t > p( fact, lower, n, nrhs );
+        execute_twice(
+            [&]() {},
+            [&]() {
+                p.execute( &C[0], ldc, &AF[0], ldc, &ipiv[0], &B[0], ldb,
+                           &X_tst[0], ldx, &rcond_tst, &ferr[0], &berr[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::sysvx( fact, lower, n, nrhs, &C[0], ldc, &AF[0], ldc,
+                       &ipiv[0], &B[0], ldb, &X_ref[0], ldx, &rcond_ref,
+                       &ferr[0], &berr[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( X_tst, X_ref, &error );
+        pivots_okay = pivots_okay && (rcond_tst == rcond_ref);
+
+        plan::hesvx< scalar_t > p2( fact, lower, n, nrhs );
+        execute_twice(
+            [&]() {},
+            [&]() {
+                p2.execute( &C[0], ldc, &AF[0], ldc, &ipiv[0], &B[0], ldb,
+                            &X_tst[0], ldx, &rcond_tst, &ferr[0], &berr[0] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::hesvx( fact, lower, n, nrhs, &C[0], ldc, &AF[0], ldc,
+                       &ipiv[0], &B[0], ldb, &X_ref[0], ldx, &rcond_ref,
+                       &ferr[0], &berr[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( X_tst, X_ref, &error );
+        pivots_okay = pivots_okay && (rcond_tst == rcond_ref);
+    }
+
+    //--------------------
+    // geev, gges: eigenvalues only
+    {
+        std::vector< scalar_t > C_tst, C_ref = C, D_tst, D_ref = D;
+        std::vector< complex_t > W_tst( n ), W_ref( n );
+        scalar_t VL[1], VR[1];
+        plan::geev< scalar_t > p( lapack::Job::NoVec, lapack::Job::NoVec, n );
+        execute_twice(
+            [&]() { C_tst = C; },
+            [&]() { p.execute( &C_tst[0], ldc, &W_tst[0], VL, 1, VR, 1 ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::geev( lapack::Job::NoVec, lapack::Job::NoVec, n,
+                      &C_ref[0], ldc, &W_ref[0], VL, 1, VR, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+
+        C_ref = C;
+        std::vector< scalar_t > beta_tst( n ), beta_ref( n );
+        int64_t sdim_tst = 0, sdim_ref = 0;
+        plan::gges< scalar_t > p2( lapack::Job::NoVec, lapack::Job::NoVec,
+                                   lapack::Sort::NotSorted, nullptr, n );
+        execute_twice(
+            [&]() { C_tst = C; D_tst = D; },
+            [&]() {
+                p2.execute( &C_tst[0], ldc, &D_tst[0], ldc, &sdim_tst,
+                            &W_tst[0], &beta_tst[0], VL, 1, VR, 1 );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gges( lapack::Job::NoVec, lapack::Job::NoVec,
+                      lapack::Sort::NotSorted, nullptr, n,
+                      &C_ref[0], ldc, &D_ref[0], ldc, &sdim_ref,
+                      &W_ref[0], &beta_ref[0], VL, 1, VR, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( beta_tst, beta_ref, &error );
+    }
+
+    //--------------------
+    // gerqf, geqlf
+    {
+        std::vector< scalar_t > A_tst, A_ref = A;
+        std::vector< scalar_t > tau_tst( minmn ), tau_ref( minmn );
+        plan::gerqf< scalar_t > p( m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() { p.execute( &A_tst[0], lda, &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::gerqf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+
+        A_ref = A;
+        plan::geqlf< scalar_t > p2( m, n );
+        execute_twice(
+            [&]() { A_tst = A; },
+            [&]() { p2.execute( &A_tst[0], lda, &tau_tst[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::geqlf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+    }
+
+    //--------------------
+    // unmlq, unglq: apply Q to the first n rows of B, then generate the
+    // first minmn rows of Q. Real precisions call ormlq and orglq.
+    {
+        std::vector< scalar_t > LQ = A, tau( minmn );
+        lapack::gelqf( m, n, &LQ[0], lda, &tau[0] );
+
+        std::vector< scalar_t > B_tst, B_ref = B;
+        plan::unmlq< scalar_t > p( lapack::Side::Left, lapack::Op::NoTrans,
+                                   n, nrhs, minmn );
+        execute_twice(
+            [&]() { B_tst = B; },
+            [&]() { p.execute( &LQ[0], lda, &tau[0], &B_tst[0], ldb ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::unmlq( lapack::Side::Left, lapack::Op::NoTrans, n, nrhs, minmn,
+                       &LQ[0], lda, &tau[0], &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+
+        std::vector< scalar_t > Q_tst, Q_ref = LQ;
+        plan::unglq< scalar_t > p2( minmn, n, minmn );
+        execute_twice(
+            [&]() { Q_tst = LQ; },
+            [&]() { p2.execute( &Q_tst[0], lda, &tau[0] ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::unglq( minmn, n, minmn, &Q_ref[0], lda, &tau[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( Q_tst, Q_ref, &error );
+    }
+
+    //--------------------
+    // trevc3, trsen: T is the upper triangle of C;
+    // hseqr: H is the upper Hessenberg part of C
+    {
+        std::vector< scalar_t > T = C, H = C;
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = j + 1; i < n; ++i)
+                T[ i + j*ldc ] = 0;
+            for (int64_t i = j + 2; i < n; ++i)
+                H[ i + j*ldc ] = 0;
+        }
+        std::unique_ptr< bool[] > select( new bool[ blas::max( 1, n ) ] );
+        for (int64_t i = 0; i < n; ++i)
+            select[ i ] = (i % 3 == 0);
+
+        int64_t m_tst = 0, m_ref = 0;
+
+        #if LAPACK_VERSION >= 30601 && ! defined( BLAS_HAVE_MKL )
+        // all right eigenvectors; the plan takes n and mm
+        std::vector< scalar_t > VR_tst( size_C ), VR_ref( size_C );
+        scalar_t VL[1];
+        plan::trevc3< scalar_t > p( lapack::Sides::Right, lapack::HowMany::All,
+                                    n, n );
+        execute_twice(
+            [&]() {},
+            [&]() {
+                p.execute( select.get(), &T[0], ldc, VL, 1, &VR_tst[0], ldc,
+                           &m_tst );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::trevc3( lapack::Sides::Right, lapack::HowMany::All,
+                        select.get(), n, &T[0], ldc, VL, 1, &VR_ref[0], ldc,
+                        n, &m_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( VR_tst, VR_ref, &error );
+        pivots_okay = pivots_okay && (m_tst == m_ref);
+        #endif
+
+        // reorder selected eigenvalues to the top, updating Q = I;
+        // the plan's workspace is for the most selected, n/2
+        std::vector< scalar_t > Q( size_C );
+        lapack::laset( lapack::MatrixType::General, n, n,
+                       scalar_t( 0 ), scalar_t( 1 ), &Q[0], ldc );
+        std::vector< scalar_t > T_tst, T_ref = T, Q_tst, Q_ref = Q;
+        std::vector< complex_t > W_tst( n ), W_ref( n );
+        std::vector< real_t > cond_tst( 2 ), cond_ref( 2 );
+        plan::trsen< scalar_t > p2( lapack::Sense::Both,
+                                    lapack::Job::UpdateVec, n );
+        execute_twice(
+            [&]() { T_tst = T; Q_tst = Q; },
+            [&]() {
+                p2.execute( select.get(), &T_tst[0], ldc, &Q_tst[0], ldc,
+                            &W_tst[0], &m_tst, &cond_tst[0], &cond_tst[1] );
+            },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::trsen( lapack::Sense::Both, lapack::Job::UpdateVec,
+                       select.get(), n, &T_ref[0], ldc, &Q_ref[0], ldc,
+                       &W_ref[0], &m_ref, &cond_ref[0], &cond_ref[1] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( T_tst, T_ref, &error );
+        max_rel_error( Q_tst, Q_ref, &error );
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( cond_tst, cond_ref, &error );
+        pivots_okay = pivots_okay && (m_tst == m_ref);
+
+        // eigenvalues only
+        std::vector< scalar_t > H_tst, H_ref = H;
+        scalar_t Z[1];
+        plan::hseqr< scalar_t > p3( lapack::JobSchur::Eigenvalues,
+                                    lapack::Job::NoVec, n, 1, n );
+        execute_twice(
+            [&]() { H_tst = H; },
+            [&]() { p3.execute( &H_tst[0], ldc, &W_tst[0], Z, 1 ); },
+            &time );
+
+        t = testsweeper::get_wtime();
+        lapack::hseqr( lapack::JobSchur::Eigenvalues, lapack::Job::NoVec,
+                       n, 1, n, &H_ref[0], ldc, &W_ref[0], Z, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+    }
+
+    params.time() = time;
+    params.ref_time() = ref_time;
+    params.error() = error;
+    params.okay() = (error < tol) && pivots_okay;
+    if (! pivots_okay) {
+        params.msg() = "pivots, rank, nfound, rcond, or m differ";
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_plan( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_plan_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_plan_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_plan_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_plan_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,194 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Throughput of batched Cholesky: factors batch n-by-n matrices with the
+// strided potrf_batch. Ref. is a serial loop of lapack::potrf.
+// Checks
+//   error:  max over the batch of ||b - Ax|| / (n ||A|| ||x||),
+//           solving with the pointer-array potrs_batch;
+//   error2: difference between the grouped potri_batch, with the batch
+//           split into two groups, and a serial loop of lapack::potri.
+template< typename scalar_t >
+void test_potrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.error2();
+    params.gflops();
+    params.matrices_per_sec();
+    params.ref_time();
+    params.ref_matrices_per_sec();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t nrhs = 1;
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    int64_t strideA = lda * n;
+    int64_t strideB = ldb * nrhs;
+    size_t size_A = (size_t) strideA * batch;
+    size_t size_B = (size_t) strideB * batch;
+
+    std::vector< scalar_t > A_tst( size_A ), A_ref( size_A );
+    std::vector< scalar_t > B_tst( size_B ), B_ref( size_B );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*strideA ], lda );
+    }
+    A_ref = A_tst;
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    B_ref = B_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%lld, threads=%d\n",
+                (lld) n, (lld) lda, (lld) batch, lapack::get_num_threads() );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        std::vector< int64_t > info;
+        assert_throw( lapack::potrf_batch( uplo, -1, &A_tst[0], lda, strideA, batch, info ), lapack::Error );
+        assert_throw( lapack::potrf_batch( uplo,  n, &A_tst[0], n-1, strideA, batch, info ), lapack::Error );
+        assert_throw( lapack::potrf_batch( uplo,  n, &A_tst[0], lda, lda*n-1, batch, info ), lapack::Error );
+    }
+
+    // ---------- run test
+    std::vector< int64_t > info_tst;
+    double time = testsweeper::get_wtime();
+    lapack::potrf_batch( uplo, n, &A_tst[0], lda, strideA, batch, info_tst );
+    time = testsweeper::get_wtime() - time;
+    int64_t nfailed = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0)
+            ++nfailed;
+    }
+    if (nfailed != 0) {
+        fprintf( stderr, "lapack::potrf_batch returned error for %lld matrices\n",
+                 (lld) nfailed );
+    }
+
+    params.time() = time;
+    double gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    params.gflops() = gflop / time;
+    params.matrices_per_sec() = batch / time;
+
+    if (params.check() == 'y') {
+        // ---------- solve with pointer-array variant
+        std::vector< scalar_t* > Aarray( batch ), Barray( batch );
+        for (int64_t i = 0; i < batch; ++i) {
+            Aarray[ i ] = &A_tst[ i*strideA ];
+            Barray[ i ] = &B_tst[ i*strideB ];
+        }
+        lapack::potrs_batch( { uplo }, { n }, { nrhs }, Aarray, { lda },
+                             Barray, { ldb }, batch, info_tst );
+
+        // ---------- check error
+        // max over batch of ||b - Ax|| / (n ||A|| ||x||),
+        // with original A in A_ref and b in B_ref.
+        real_t error = 0;
+        for (int64_t i = 0; i < batch; ++i) {
+            scalar_t* A_i = &A_ref[ i*strideA ];
+            scalar_t* B_i = &B_ref[ i*strideB ];
+            scalar_t* X_i = &B_tst[ i*strideB ];
+            real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, A_i, lda );
+            real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, X_i, ldb );
+            blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                        n, nrhs,
+                        -1.0, A_i, lda,
+                              X_i, ldb,
+                         1.0, B_i, ldb );
+            real_t Rnorm = lapack::lange( lapack::Norm::One, n, nrhs, B_i, ldb );
+            if (n > 0 && Anorm > 0 && Xnorm > 0)
+                error = blas::max( error, Rnorm / (n * Anorm * Xnorm) );
+        }
+        params.error() = error;
+
+        // ---------- check grouped potri_batch against serial loop
+        std::vector< scalar_t > Ainv_tst = A_tst, Ainv_ref = A_tst;
+        for (int64_t i = 0; i < batch; ++i) {
+            Aarray[ i ] = &Ainv_tst[ i*strideA ];
+            lapack::potri( uplo, n, &Ainv_ref[ i*strideA ], lda );
+        }
+        int64_t half = batch / 2;
+        lapack::potri_batch( { uplo, uplo }, { n, n }, Aarray, { lda, lda },
+                             std::vector< int64_t >{ half, batch - half },
+                             info_tst );
+        real_t error2 = rel_error( Ainv_tst, Ainv_ref );
+        params.error2() = error2;
+
+        params.okay() = (error < tol && error2 < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference: serial loop
+        // A_ref was overwritten by the check; regenerate.
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::generate_matrix( params.matrix, n, n, &A_ref[ i*strideA ], lda );
+        }
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::potrf( uplo, n, &A_ref[ i*strideA ], lda );
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_matrices_per_sec() = batch / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_potrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_batch_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -42,8 +42,8 @@ void test_potrf_device_work( Params& params, bool run )
         return;
     }
 
-    if (blas::get_device_count() == 0) {
-        params.msg() = "skipping: no GPU devices or no GPU support";
+    if (lapack::get_device_count() == 0) {
+        params.msg() = "skipping: no devices";
         return;
     }
 
@@ -57,11 +57,11 @@ void test_potrf_device_work( Params& params, bool run )
     lapack::generate_matrix( params.matrix, n, n, &A_tst[0], lda );
     A_ref = A_tst;
 
-    // Allocate and copy to GPU.
+    // Allocate and copy to device.
     lapack::Queue queue( device, 0 );
-    scalar_t*        dA_tst = blas::device_malloc< scalar_t >( size_A );
-    device_info_int* d_info = blas::device_malloc< device_info_int >( 1 );
-    blas::device_setmatrix( n, n, A_tst.data(), lda, dA_tst, lda, queue );
+    scalar_t*        dA_tst = lapack::device_malloc< scalar_t >( size_A, queue );
+    device_info_int* d_info = lapack::device_malloc< device_info_int >( 1, queue );
+    lapack::device_setmatrix( n, n, A_tst.data(), lda, dA_tst, lda, queue );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -96,17 +96,17 @@ void test_potrf_device_work( Params& params, bool run )
 
     // Copy result back to CPU.
     device_info_int info_tst;
-    blas::device_getmatrix( n, n, dA_tst, lda, A_tst.data(), lda, queue );
-    blas::device_memcpy( &info_tst, d_info, 1, queue );
+    lapack::device_getmatrix( n, n, dA_tst, lda, A_tst.data(), lda, queue );
+    lapack::device_memcpy( &info_tst, d_info, 1, queue );
     queue.sync();
 
     if (info_tst != 0) {
         fprintf( stderr, "lapack::potrf returned error %lld\n", (lld) info_tst );
     }
 
-    // Cleanup GPU memory.
-    blas::device_free( dA_tst );
-    blas::device_free( d_info );
+    // Cleanup device memory.
+    lapack::device_free( dA_tst, queue );
+    lapack::device_free( d_info, queue );
 
     if (verbose >= 2) {
         printf( "A_factor = " ); print_matrix( n, n, &A_tst[0], lda );
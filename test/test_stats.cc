@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/stats.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stats = lapack::stats;
+
+// -----------------------------------------------------------------------------
+// @return statistics dumped in format, as a string.
+static std::string dump_string( stats::Format format )
+{
+    std::string str;
+    FILE* stream = std::tmpfile();
+    if (stream == nullptr)
+        return str;
+    stats::dump( format, stream );
+    std::rewind( stream );
+    char buf[ 4096 ];
+    size_t len;
+    while ((len = std::fread( buf, 1, sizeof(buf), stream )) > 0)
+        str.append( buf, len );
+    std::fclose( stream );
+    return str;
+}
+
+// -----------------------------------------------------------------------------
+// @return number of non-overlapping occurrences of pattern in str.
+static int64_t count_of( std::string const& str, std::string const& pattern )
+{
+    int64_t count = 0;
+    for (size_t pos = str.find( pattern ); pos != std::string::npos;
+         pos = str.find( pattern, pos + pattern.size() ))
+        ++count;
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// @return true if str contains pattern.
+static bool contains( std::string const& str, std::string const& pattern )
+{
+    return str.find( pattern ) != std::string::npos;
+}
+
+// -----------------------------------------------------------------------------
+// Checks call statistics, from dumps in both formats:
+// - gesv calls are counted, with n in its histogram bucket, and calls with
+//   statistics off are not;
+// - histogram buckets of sizes 0, 1, 4-7, 512-1023, and the last bucket;
+// - reset() starts an empty window, and counters of an older generation
+//   restart from zero;
+// - a thread calling more routines than its table holds counts the first
+//   256 and reports the rest as dropped. This runs in a new thread, so
+//   this thread's table is left with room;
+// - counters of threads that exited are summed.
+// Time is gesv with statistics on, ref. time with them off.
+template< typename scalar_t >
+void test_stats_work( Params& params, bool run )
+{
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A( size_A ), A_tst( size_A );
+    std::vector< scalar_t > B( size_B ), B_tst( size_B );
+    std::vector< int64_t > ipiv( blas::max( 1, n ) );
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, n, nrhs, &B[0], ldb );
+
+    auto call = [&]() {
+        A_tst = A;
+        B_tst = B;
+        lapack::gesv( n, nrhs, &A_tst[0], lda, &ipiv[0], &B_tst[0], ldb );
+    };
+
+    std::string msg;
+    auto expect = [&msg]( bool cond, const char* what ) {
+        if (! cond && msg.empty())
+            msg = what;
+    };
+
+    char prec = lapack::trace::internal::precision< scalar_t >();
+    std::string routine = std::string( "\"routine\":\"" ) + prec;
+
+    bool was_on = stats::is_on();
+    stats::on();
+    stats::reset();
+
+    //--------------------
+    // gesv calls, statistics on, then off
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i)
+        call();
+    params.time() = testsweeper::get_wtime() - time;
+
+    stats::off();
+    time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i)
+        call();
+    params.ref_time() = testsweeper::get_wtime() - time;
+    stats::on();
+
+    // n = 0 is bucket 0; else n is in bucket [2^(b-1), 2^b).
+    lld lower = 0, upper = 0;
+    if (n > 0) {
+        for (lower = 1; 2*lower <= n; lower *= 2) {}
+        upper = 2*lower - 1;
+    }
+    std::string json = dump_string( stats::Format::JSON );
+    std::string table = dump_string( stats::Format::Table );
+    if (verbose >= 1)
+        printf( "\n%s%s", table.c_str(), json.c_str() );
+
+    expect( contains( json, routine + "gesv\",\"calls\":"
+                            + std::to_string( (lld) batch ) + "," ),
+            "wrong gesv calls" );
+    expect( contains( json, "\"n_hist\":{\"" + std::to_string( lower ) + "\":"
+                            + std::to_string( (lld) batch ) + "}" ),
+            "wrong gesv n histogram" );
+    expect( contains( json, "\"m_hist\":{}" ), "gesv has m histogram" );
+    expect( contains( json, "],\"dropped\":0}" ), "calls dropped" );
+
+    std::string n_sizes = (n == 0 ? "0" : std::to_string( lower ) + "-"
+                                          + std::to_string( upper ));
+    expect( contains( table, std::string( "\n" ) + prec + "gesv " )
+            && contains( table, "    n sizes: " + n_sizes + ":"
+                                + std::to_string( (lld) batch ) + "\n" ),
+            "gesv missing from table" );
+
+    //--------------------
+    // histogram buckets, including the last bucket, and m or n of -1,
+    // which isn't counted.
+    const char* bucket_name = "stats_buckets";
+    stats::internal::record( bucket_name, prec, 0, 1, 1e-3, 1.0 );
+    stats::internal::record( bucket_name, prec, 5, 1000, 3e-3, 2.0 );
+    stats::internal::record( bucket_name, prec, int64_t( 1 ) << 40, -1,
+                             2e-3, 3.0 );
+    json = dump_string( stats::Format::JSON );
+    table = dump_string( stats::Format::Table );
+
+    std::string last = std::to_string(
+        1LL << (stats::internal::num_buckets - 2) );
+    expect( contains( json, routine + bucket_name + "\",\"calls\":3,"
+                            "\"time\":0.006," "\"min_time\":0.001,"
+                            "\"max_time\":0.003,\"gflop\":6," ),
+            "wrong counters" );
+    expect( contains( json, "\"m_hist\":{\"0\":1,\"4\":1,\"" + last + "\":1},"
+                            "\"n_hist\":{\"1\":1,\"512\":1}" ),
+            "wrong histogram in JSON" );
+    expect( contains( table, "    m sizes: 0:1 4-7:1 " + last + "+:1\n"
+                             "    n sizes: 1-1:1 512-1023:1\n" ),
+            "wrong histogram in table" );
+
+    //--------------------
+    // reset starts an empty window; the next call counts from zero.
+    stats::reset();
+    json = dump_string( stats::Format::JSON );
+    table = dump_string( stats::Format::Table );
+    expect( json == "{\"stats\":[\n],\"dropped\":0}\n", "reset didn't clear" );
+    expect( count_of( table, "\n" ) == 1, "reset didn't clear table" );
+
+    stats::internal::record( bucket_name, prec, 2, 2, 1e-3, 0.0 );
+    json = dump_string( stats::Format::JSON );
+    expect( contains( json, routine + bucket_name + "\",\"calls\":1," )
+            && contains( json, "\"m_hist\":{\"2\":1}" ),
+            "old generation counted" );
+    expect( ! contains( json, "gesv" ), "old generation dumped" );
+
+    //--------------------
+    // full table, in a new thread
+    const int num_slots = 256, num_dropped = 44;
+    static std::vector< std::string > names;  // outlive the thread's table
+    if (names.empty()) {
+        for (int i = 0; i < num_slots + num_dropped; ++i)
+            names.push_back( "stats_full_" + std::to_string( i ) );
+    }
+    stats::reset();
+    std::thread thread( [prec]() {
+        for (auto const& name : names)
+            stats::internal::record( name.c_str(), prec, 1, 1, 1e-6, 0.0 );
+    } );
+    thread.join();
+
+    json = dump_string( stats::Format::JSON );
+    table = dump_string( stats::Format::Table );
+    expect( count_of( json, routine + "stats_full_" ) == num_slots,
+            "full table has wrong number of routines" );
+    expect( contains( json, "],\"dropped\":"
+                            + std::to_string( num_dropped ) + "}" ),
+            "wrong dropped calls in JSON" );
+    expect( contains( table, std::to_string( num_dropped )
+                             + " calls dropped" ),
+            "wrong dropped calls in table" );
+
+    //--------------------
+    // threads that exited
+    const int num_threads = 4;
+    const char* exited_name = "stats_exited";
+    stats::reset();
+    for (int i = 0; i < num_threads; ++i) {
+        std::thread exited( [prec, exited_name]() {
+            stats::internal::record( exited_name, prec, 1, 1, 1e-6, 0.0 );
+        } );
+        exited.join();
+    }
+    json = dump_string( stats::Format::JSON );
+    expect( contains( json, routine + exited_name + "\",\"calls\":"
+                            + std::to_string( num_threads ) + "," ),
+            "exited threads not summed" );
+
+    stats::reset();
+    if (! was_on)
+        stats::off();
+
+    params.okay() = msg.empty();
+    params.msg() = msg;
+}
+
+// -----------------------------------------------------------------------------
+void test_stats( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_stats_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_stats_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_stats_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_stats_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
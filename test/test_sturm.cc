@@ -217,3 +217,104 @@ void test_sturm( Params& params, bool run )
             break;
     }
 }
+
+// -----------------------------------------------------------------------------
+// Throughput of the multi-shift sturm against a loop of the single-shift
+// sturm, on a random tridiagonal matrix of order n = dim.n() with
+// nshifts = dim.k() shifts evenly spaced over its Gershgorin interval.
+// Counts must be identical; error is the number that differ.
+// Gflop/s counts 6 flops per row per shift (2 subtract, 4 multiply).
+template< typename scalar_t >
+void test_sturm_multi_work( Params& params, bool run )
+{
+    using llong = long long;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nshifts = params.dim.k();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run) {
+        return;
+    }
+
+    // ---------- setup
+    std::vector< scalar_t > diag( (size_t) n );
+    std::vector< scalar_t > offd( (size_t) blas::max( 1, n-1 ) );
+    std::vector< scalar_t > u( (size_t) nshifts );
+    std::vector< int64_t > count_tst( (size_t) nshifts ), count_ref( (size_t) nshifts );
+
+    int64_t idist = 2;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, diag.size(), &diag[0] );
+    lapack::larnv( idist, iseed, offd.size(), &offd[0] );
+
+    // Gershgorin bound: all eigenvalues are in [-3, 3].
+    for (int64_t k = 0; k < nshifts; ++k)
+        u[ k ] = -3 + 6 * (k + 0.5) / nshifts;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "n=%5lld, nshifts=%5lld\n", llong( n ), llong( nshifts ) );
+    }
+
+    double gflop = 6e-9 * n * nshifts;
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::sturm( n, &diag[0], &offd[0], nshifts, &u[0], &count_tst[0] );
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    // ---------- run reference
+    testsweeper::flush_cache( params.cache() );
+    time = testsweeper::get_wtime();
+    for (int64_t k = 0; k < nshifts; ++k)
+        count_ref[ k ] = lapack::sturm( n, &diag[0], &offd[0], u[ k ] );
+    time = testsweeper::get_wtime() - time;
+
+    params.ref_time() = time;
+    params.ref_gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        for (int64_t k = 0; k < nshifts; ++k) {
+            printf( "u %12.4e  count %6lld  ref %6lld\n",
+                    u[ k ], llong( count_tst[ k ] ), llong( count_ref[ k ] ) );
+        }
+    }
+
+    // ---------- check counts are identical
+    int64_t error = 0;
+    for (int64_t k = 0; k < nshifts; ++k) {
+        if (count_tst[ k ] != count_ref[ k ])
+            ++error;
+    }
+    params.error() = error;
+    params.okay() = (error == 0);
+}
+
+// -----------------------------------------------------------------------------
+void test_sturm_multi( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_sturm_multi_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_sturm_multi_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
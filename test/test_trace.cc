@@ -0,0 +1,181 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/trace.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// @return number of non-overlapping occurrences of pattern in str.
+static int64_t count_of( std::string const& str, std::string const& pattern )
+{
+    int64_t count = 0;
+    for (size_t pos = str.find( pattern ); pos != std::string::npos;
+         pos = str.find( pattern, pos + pattern.size() ))
+        ++count;
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// Calls gesv batch times with tracing on, then off, and checks that:
+// - each traced call records one event, and untraced calls none;
+// - calls that throw, from argument checks or LAPACK's info < 0,
+//   record no event (with --error-exit);
+// - events of a thread that exited are kept;
+// - finish writes one event per call, with name, precision, and
+//   dimensions, in Chrome trace JSON, and clears the events.
+// Time is with tracing on, ref. time with tracing off.
+// Events recorded before the tester runs, e.g., with --trace, are
+// consumed by its checks.
+template< typename scalar_t >
+void test_trace_work( Params& params, bool run )
+{
+    namespace trace = lapack::trace;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A( size_A ), A_tst( size_A );
+    std::vector< scalar_t > B( size_B ), B_tst( size_B );
+    std::vector< int64_t > ipiv( blas::max( 1, n ) );
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, n, nrhs, &B[0], ldb );
+
+    auto call = [&]() {
+        A_tst = A;
+        B_tst = B;
+        lapack::gesv( n, nrhs, &A_tst[0], lda, &ipiv[0], &B_tst[0], ldb );
+    };
+
+    std::string msg;
+    auto expect = [&msg]( bool cond, const char* what ) {
+        if (! cond && msg.empty())
+            msg = what;
+    };
+
+    bool was_on = trace::is_on();
+    trace::clear();
+
+    // ---------- run test, tracing on
+    trace::on();
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i)
+        call();
+    params.time() = testsweeper::get_wtime() - time;
+    expect( trace::size() == batch, "wrong number of events" );
+
+    if (params.error_exit() == 'y') {
+        // LAPACK rejects lda < n, after the wrapper's argument checks.
+        if (n > 1) {
+            assert_throw(
+                lapack::gesv( n, nrhs, &A_tst[0], n-1, &ipiv[0],
+                              &B_tst[0], ldb ),
+                lapack::Error );
+        }
+        // Wrapper rejects n that overflows lapack_int, if it is 32-bit.
+        if (sizeof( int64_t ) > sizeof( lapack_int )) {
+            assert_throw(
+                lapack::gesv( int64_t( 1 ) << 40, nrhs, &A_tst[0], lda,
+                              &ipiv[0], &B_tst[0], ldb ),
+                lapack::Error );
+        }
+        expect( trace::size() == batch, "call that threw recorded event" );
+    }
+
+    // ---------- run reference, tracing off
+    trace::off();
+    time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i)
+        call();
+    params.ref_time() = testsweeper::get_wtime() - time;
+    expect( trace::size() == batch, "tracing off recorded events" );
+
+    // ---------- event of a thread that exited is kept
+    trace::on();
+    std::thread thread( call );
+    thread.join();
+    trace::off();
+    expect( trace::size() == batch + 1, "exited thread's event lost" );
+
+    // ---------- check file
+    const char* filename = "test_trace.json";
+    trace::finish( filename );
+    expect( trace::size() == 0, "finish didn't clear events" );
+
+    std::ifstream file( filename );
+    std::stringstream stream;
+    stream << file.rdbuf();
+    std::string json = stream.str();
+    std::remove( filename );
+
+    char prec = lapack::trace::internal::precision< scalar_t >();
+    std::string name = std::string( "\"name\":\"" ) + prec + "gesv\"";
+    std::string dims = ",\"n\":" + std::to_string( (lld) n )
+                     + ",\"k\":" + std::to_string( (lld) nrhs ) + ",";
+    expect( json.find( "{\"traceEvents\":[" ) == 0
+            && json.find( "\"displayTimeUnit\":\"ms\"}" ) != std::string::npos,
+            "file isn't Chrome trace JSON" );
+    expect( count_of( json, name ) == batch + 1, "wrong events in file" );
+    expect( count_of( json, dims ) == batch + 1, "wrong dimensions in file" );
+
+    if (was_on)
+        trace::on();
+
+    params.okay() = msg.empty();
+    params.msg() = msg;
+}
+
+// -----------------------------------------------------------------------------
+void test_trace( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_trace_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_trace_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_trace_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_trace_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
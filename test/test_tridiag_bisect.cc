@@ -0,0 +1,203 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Benchmark of the native bisection eigensolver tridiag_bisect against
+// stevr (which uses stemr for all eigenvalues, and stebz + stein for
+// subsets) on a random tridiagonal matrix with normally distributed D, E.
+// Checks
+//   error:  |nfound - nfound_ref| + difference of eigenvalues from stevr;
+//   error2: for --jobz v, max of ||T Z - Z W|| / (n ||T||) and
+//           ||I - Z^T Z|| / n.
+template< typename scalar_t >
+void test_tridiag_bisect_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // Constants
+    const real_t zero = 0;
+    const real_t one  = 1;
+    const real_t eps  = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+
+    // get_range fills in range, il, iu, vl, vu
+    real_t  vl, vu;
+    int64_t il, iu;
+    lapack::Range range;
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+
+    if (! run)
+        return;
+
+    // skip invalid ranges
+    if (il > iu) {
+        params.msg() = "skipping: requires 1 <= il <= iu <= n";
+        return;
+    }
+
+    // ---------- setup
+    real_t abstol = 0;  // default value
+    int64_t nfound_tst, nfound_ref;
+    int64_t ldz = (jobz == lapack::Job::Vec
+                   ? roundup( blas::max( 1, n ), align )
+                   : 1 );
+    size_t size_Z = (size_t) ldz * n;
+    size_t size_E = (size_t) blas::max( 1, n );
+
+    std::vector< real_t > D( n ), D_ref( n );
+    std::vector< real_t > E( size_E ), E_ref( size_E );
+    std::vector< real_t > W_tst( n ), W_ref( n );
+    std::vector< real_t > Z_tst( size_Z ), Z_ref( size_Z );
+    std::vector< int64_t > isuppz( 2*blas::max( 1, n ) );
+
+    int64_t idist = 3;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, D.size(), &D[0] );
+    lapack::larnv( idist, iseed, E.size(), &E[0] );
+    D_ref = D;
+    E_ref = E;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "n=%5lld, range %c, il %lld, iu %lld, vl %.4e, vu %.4e, threads %d\n",
+                (lld) n, range2char( range ), (lld) il, (lld) iu, vl, vu,
+                lapack::get_num_threads() );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tridiag_bisect(
+                           jobz, range, n, &D[0], &E[0],
+                           vl, vu, il, iu, abstol, &nfound_tst,
+                           &W_tst[0], &Z_tst[0], ldz );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tridiag_bisect returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "nfound = %lld\n", (lld) nfound_tst );
+        printf( "W = " );
+        print_vector( nfound_tst, &W_tst[0], 1 );
+    }
+
+    if (params.check() == 'y' && jobz == lapack::Job::Vec) {
+        // ---------- check residual and orthogonality
+        // T has 1-norm at most max_i |D_i| + |E_{i-1}| + |E_i|.
+        real_t Tnorm = zero;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t r = std::abs( D[ i ] );
+            if (i > 0)
+                r += std::abs( E[ i-1 ] );
+            if (i < n-1)
+                r += std::abs( E[ i ] );
+            Tnorm = blas::max( Tnorm, r );
+        }
+
+        // ||T Z - Z W||_1
+        real_t Rnorm = zero;
+        for (int64_t j = 0; j < nfound_tst; ++j) {
+            real_t const* z = &Z_tst[ j*ldz ];
+            real_t colsum = zero;
+            for (int64_t i = 0; i < n; ++i) {
+                real_t r = (D[ i ] - W_tst[ j ]) * z[ i ];
+                if (i > 0)
+                    r += E[ i-1 ] * z[ i-1 ];
+                if (i < n-1)
+                    r += E[ i ] * z[ i+1 ];
+                colsum += std::abs( r );
+            }
+            Rnorm = blas::max( Rnorm, colsum );
+        }
+
+        // ||I - Z^T Z||_1
+        std::vector< real_t > ZtZ( nfound_tst * nfound_tst );
+        int64_t ldztz = blas::max( 1, nfound_tst );
+        lapack::laset( lapack::MatrixType::General, nfound_tst, nfound_tst,
+                       zero, one, &ZtZ[0], ldztz );
+        blas::syrk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::Trans,
+                    nfound_tst, n,
+                    -one, &Z_tst[0], ldz,
+                     one, &ZtZ[0], ldztz );
+        real_t Onorm = lapack::lansy( lapack::Norm::One, lapack::Uplo::Upper,
+                                      nfound_tst, &ZtZ[0], ldztz );
+
+        real_t error2 = Onorm / n;
+        if (Tnorm > 0)
+            error2 = blas::max( error2, Rnorm / (n * Tnorm) );
+        params.error2() = error2;
+        params.okay() = (error2 < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::stevr(
+                               jobz, range, n, &D_ref[0], &E_ref[0],
+                               vl, vu, il, iu, abstol, &nfound_ref,
+                               &W_ref[0], &Z_ref[0], ldz, &isuppz[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::stevr returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        error += std::abs( nfound_tst - nfound_ref );
+        W_tst.resize( nfound_tst );
+        W_ref.resize( nfound_ref );
+        error += rel_error( W_tst, W_ref );
+        params.error() = error;
+        if (jobz == lapack::Job::Vec)
+            params.okay() = params.okay() && (error < tol);
+        else
+            params.okay() = (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tridiag_bisect( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tridiag_bisect_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tridiag_bisect_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
@@ -0,0 +1,494 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Buffer of work_size bytes for the caller-provided workspace overloads.
+// Its data is offset by one byte from the allocation, so it is not aligned,
+// to check that the overloads align the arrays they carve from it.
+class WorkBytes
+{
+public:
+    explicit WorkBytes( size_t work_size ):
+        bytes_( work_size + 1 ),
+        size_( work_size )
+    {}
+
+    void*  data() { return bytes_.data() + 1; }
+    size_t size() const { return size_; }
+
+private:
+    std::vector< char > bytes_;
+    size_t size_;
+};
+
+// -----------------------------------------------------------------------------
+// Sets error = max( error, relative error of x ), if xref is non-empty.
+template< typename T >
+static void max_rel_error(
+    std::vector< T >& x, std::vector< T >& xref,
+    blas::real_type< T >* error )
+{
+    if (xref.size() > 0)
+        *error = blas::max( *error, rel_error( x, xref ) );
+}
+
+// -----------------------------------------------------------------------------
+// Calls each routine with caller-provided workspace, sized by its
+// *_work_size_bytes query, and the regular wrapper that allocates
+// workspace, on the same input. Checks that outputs match; they may differ
+// slightly if a larger lwork changes the blocking. With --error-exit,
+// checks that an empty buffer is rejected with lapack::Error.
+// Ref. time is the regular wrappers.
+template< typename scalar_t >
+void test_work_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    using complex_t = blas::complex_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    // A is m-by-n, for geqrf, gels*, and SVD; C and D are n-by-n,
+    // for eigenvalue routines and sytrf.
+    int64_t minmn = blas::min( m, n );
+    int64_t maxmn = blas::max( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = roundup( blas::max( 1, maxmn ), align );
+    int64_t ldc = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+    size_t size_C = (size_t) ldc * n;
+
+    std::vector< scalar_t > A( size_A ), B( size_B ), C( size_C ), D( size_C );
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, maxmn, nrhs, &B[0], ldb );
+    lapack::generate_matrix( params.matrix, n, n, &C[0], ldc );
+    lapack::generate_matrix( params.matrix, n, n, &D[0], ldc );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld\n"
+                "B m=%5lld, nrhs=%5lld, ldb=%5lld\n"
+                "C n=%5lld, ldc=%5lld\n",
+                (lld) m, (lld) n, (lld) lda,
+                (lld) maxmn, (lld) nrhs, (lld) ldb,
+                (lld) n, (lld) ldc );
+    }
+
+    real_t error = 0;
+    bool pivots_okay = true;
+    double time = 0, ref_time = 0, t;
+
+    //--------------------
+    // geqrf
+    {
+        std::vector< scalar_t > A_tst = A, A_ref = A;
+        std::vector< scalar_t > tau_tst( minmn ), tau_ref( minmn );
+        size_t work_size;
+        lapack::geqrf_work_size_bytes( m, n, &A_tst[0], lda, &tau_tst[0],
+                                       &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::geqrf( m, n, &A_tst[0], lda, &tau_tst[0],
+                       work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::geqrf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( A_tst, A_ref, &error );
+        max_rel_error( tau_tst, tau_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::geqrf( m, n, &A_tst[0], lda, &tau_tst[0],
+                                         work.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // gels
+    {
+        std::vector< scalar_t > A_tst = A, A_ref = A, B_tst = B, B_ref = B;
+        size_t work_size;
+        lapack::gels_work_size_bytes( lapack::Op::NoTrans, m, n, nrhs,
+                                      &A_tst[0], lda, &B_tst[0], ldb,
+                                      &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gels( lapack::Op::NoTrans, m, n, nrhs,
+                      &A_tst[0], lda, &B_tst[0], ldb,
+                      work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gels( lapack::Op::NoTrans, m, n, nrhs,
+                      &A_ref[0], lda, &B_ref[0], ldb );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gels( lapack::Op::NoTrans, m, n, nrhs,
+                                        &A_tst[0], lda, &B_tst[0], ldb,
+                                        work.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // gelsd
+    {
+        std::vector< scalar_t > A_tst = A, A_ref = A, B_tst = B, B_ref = B;
+        std::vector< real_t > S_tst( minmn ), S_ref( minmn );
+        int64_t rank_tst, rank_ref;
+        real_t rcond = -1;
+        size_t work_size;
+        lapack::gelsd_work_size_bytes( m, n, nrhs, &A_tst[0], lda,
+                                       &B_tst[0], ldb, &S_tst[0], rcond,
+                                       &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gelsd( m, n, nrhs, &A_tst[0], lda, &B_tst[0], ldb,
+                       &S_tst[0], rcond, &rank_tst,
+                       work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gelsd( m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb,
+                       &S_ref[0], rcond, &rank_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        max_rel_error( S_tst, S_ref, &error );
+        pivots_okay = pivots_okay && (rank_tst == rank_ref);
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gelsd( m, n, nrhs, &A_tst[0], lda,
+                                         &B_tst[0], ldb, &S_tst[0], rcond,
+                                         &rank_tst, work.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // gelss
+    {
+        std::vector< scalar_t > A_tst = A, A_ref = A, B_tst = B, B_ref = B;
+        std::vector< real_t > S_tst( minmn ), S_ref( minmn );
+        int64_t rank_tst, rank_ref;
+        real_t rcond = -1;
+        size_t work_size;
+        lapack::gelss_work_size_bytes( m, n, nrhs, &A_tst[0], lda,
+                                       &B_tst[0], ldb, &S_tst[0], rcond,
+                                       &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gelss( m, n, nrhs, &A_tst[0], lda, &B_tst[0], ldb,
+                       &S_tst[0], rcond, &rank_tst,
+                       work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gelss( m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb,
+                       &S_ref[0], rcond, &rank_ref );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( B_tst, B_ref, &error );
+        max_rel_error( S_tst, S_ref, &error );
+        pivots_okay = pivots_okay && (rank_tst == rank_ref);
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gelss( m, n, nrhs, &A_tst[0], lda,
+                                         &B_tst[0], ldb, &S_tst[0], rcond,
+                                         &rank_tst, work.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // gesdd, gesvd: singular values only, which are unique
+    {
+        std::vector< scalar_t > A_tst = A, A_ref = A;
+        std::vector< real_t > S_tst( minmn ), S_ref( minmn );
+        scalar_t U[1], VT[1];
+        size_t work_size;
+        lapack::gesdd_work_size_bytes( lapack::Job::NoVec, m, n,
+                                       &A_tst[0], lda, &S_tst[0],
+                                       U, 1, VT, 1, &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gesdd( lapack::Job::NoVec, m, n, &A_tst[0], lda, &S_tst[0],
+                       U, 1, VT, 1, work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gesdd( lapack::Job::NoVec, m, n, &A_ref[0], lda, &S_ref[0],
+                       U, 1, VT, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( S_tst, S_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gesdd( lapack::Job::NoVec, m, n,
+                                         &A_tst[0], lda, &S_tst[0],
+                                         U, 1, VT, 1, work.data(), 0 ),
+                          lapack::Error );
+        }
+
+        A_tst = A;
+        A_ref = A;
+        lapack::gesvd_work_size_bytes( lapack::Job::NoVec, lapack::Job::NoVec,
+                                       m, n, &A_tst[0], lda, &S_tst[0],
+                                       U, 1, VT, 1, &work_size );
+        WorkBytes work2( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gesvd( lapack::Job::NoVec, lapack::Job::NoVec, m, n,
+                       &A_tst[0], lda, &S_tst[0], U, 1, VT, 1,
+                       work2.data(), work2.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gesvd( lapack::Job::NoVec, lapack::Job::NoVec, m, n,
+                       &A_ref[0], lda, &S_ref[0], U, 1, VT, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( S_tst, S_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gesvd( lapack::Job::NoVec, lapack::Job::NoVec,
+                                         m, n, &A_tst[0], lda, &S_tst[0],
+                                         U, 1, VT, 1, work2.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // heevd, heevr: eigenvalues of the lower triangle of C
+    {
+        std::vector< scalar_t > C_tst = C, C_ref = C;
+        std::vector< real_t > W_tst( n ), W_ref( n );
+        size_t work_size;
+        lapack::heevd_work_size_bytes( lapack::Job::Vec, lapack::Uplo::Lower,
+                                       n, &C_tst[0], ldc, &W_tst[0],
+                                       &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                       &C_tst[0], ldc, &W_tst[0], work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                       &C_ref[0], ldc, &W_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower,
+                                         n, &C_tst[0], ldc, &W_tst[0],
+                                         work.data(), 0 ),
+                          lapack::Error );
+        }
+
+        C_tst = C;
+        C_ref = C;
+        std::vector< scalar_t > Z( size_C );
+        std::vector< int64_t > isuppz( 2*blas::max( 1, n ) );
+        int64_t nfound_tst, nfound_ref;
+        lapack::heevr_work_size_bytes( lapack::Job::Vec, lapack::Range::All,
+                                       lapack::Uplo::Lower, n, &C_tst[0], ldc,
+                                       real_t( 0 ), real_t( 0 ), 0, 0,
+                                       real_t( 0 ), &W_tst[0], &Z[0], ldc,
+                                       &work_size );
+        WorkBytes work2( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::heevr( lapack::Job::Vec, lapack::Range::All,
+                       lapack::Uplo::Lower, n, &C_tst[0], ldc,
+                       real_t( 0 ), real_t( 0 ), 0, 0, real_t( 0 ),
+                       &nfound_tst, &W_tst[0], &Z[0], ldc, &isuppz[0],
+                       work2.data(), work2.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::heevr( lapack::Job::Vec, lapack::Range::All,
+                       lapack::Uplo::Lower, n, &C_ref[0], ldc,
+                       real_t( 0 ), real_t( 0 ), 0, 0, real_t( 0 ),
+                       &nfound_ref, &W_ref[0], &Z[0], ldc, &isuppz[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        pivots_okay = pivots_okay && (nfound_tst == nfound_ref);
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::heevr( lapack::Job::Vec, lapack::Range::All,
+                                         lapack::Uplo::Lower, n, &C_tst[0], ldc,
+                                         real_t( 0 ), real_t( 0 ), 0, 0,
+                                         real_t( 0 ), &nfound_tst, &W_tst[0],
+                                         &Z[0], ldc, &isuppz[0],
+                                         work2.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // sytrf
+    {
+        std::vector< scalar_t > C_tst = C, C_ref = C;
+        std::vector< int64_t > ipiv_tst( n ), ipiv_ref( n );
+        size_t work_size;
+        lapack::sytrf_work_size_bytes( lapack::Uplo::Lower, n,
+                                       &C_tst[0], ldc, &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::sytrf( lapack::Uplo::Lower, n, &C_tst[0], ldc, &ipiv_tst[0],
+                       work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::sytrf( lapack::Uplo::Lower, n, &C_ref[0], ldc, &ipiv_ref[0] );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( C_tst, C_ref, &error );
+        pivots_okay = pivots_okay && (ipiv_tst == ipiv_ref);
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::sytrf( lapack::Uplo::Lower, n, &C_tst[0], ldc,
+                                         &ipiv_tst[0], work.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    //--------------------
+    // geev, gges: eigenvalues only
+    {
+        std::vector< scalar_t > C_tst = C, C_ref = C, D_tst = D, D_ref = D;
+        std::vector< complex_t > W_tst( n ), W_ref( n );
+        scalar_t VL[1], VR[1];
+        size_t work_size;
+        lapack::geev_work_size_bytes( lapack::Job::NoVec, lapack::Job::NoVec,
+                                      n, &C_tst[0], ldc, &W_tst[0],
+                                      VL, 1, VR, 1, &work_size );
+        WorkBytes work( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::geev( lapack::Job::NoVec, lapack::Job::NoVec, n,
+                      &C_tst[0], ldc, &W_tst[0], VL, 1, VR, 1,
+                      work.data(), work.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::geev( lapack::Job::NoVec, lapack::Job::NoVec, n,
+                      &C_ref[0], ldc, &W_ref[0], VL, 1, VR, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::geev( lapack::Job::NoVec, lapack::Job::NoVec,
+                                        n, &C_tst[0], ldc, &W_tst[0],
+                                        VL, 1, VR, 1, work.data(), 0 ),
+                          lapack::Error );
+        }
+
+        C_tst = C;
+        C_ref = C;
+        std::vector< scalar_t > beta_tst( n ), beta_ref( n );
+        typename lapack::internal::gges_select< scalar_t >::type
+            select = nullptr;
+        int64_t sdim_tst = 0, sdim_ref = 0;
+        lapack::gges_work_size_bytes( lapack::Job::NoVec, lapack::Job::NoVec,
+                                      lapack::Sort::NotSorted, select, n,
+                                      &C_tst[0], ldc, &D_tst[0], ldc,
+                                      &W_tst[0], &beta_tst[0],
+                                      VL, 1, VR, 1, &work_size );
+        WorkBytes work2( work_size );
+
+        t = testsweeper::get_wtime();
+        lapack::gges( lapack::Job::NoVec, lapack::Job::NoVec,
+                      lapack::Sort::NotSorted, select, n,
+                      &C_tst[0], ldc, &D_tst[0], ldc, &sdim_tst,
+                      &W_tst[0], &beta_tst[0], VL, 1, VR, 1,
+                      work2.data(), work2.size() );
+        time += testsweeper::get_wtime() - t;
+
+        t = testsweeper::get_wtime();
+        lapack::gges( lapack::Job::NoVec, lapack::Job::NoVec,
+                      lapack::Sort::NotSorted, select, n,
+                      &C_ref[0], ldc, &D_ref[0], ldc, &sdim_ref,
+                      &W_ref[0], &beta_ref[0], VL, 1, VR, 1 );
+        ref_time += testsweeper::get_wtime() - t;
+
+        max_rel_error( W_tst, W_ref, &error );
+        max_rel_error( beta_tst, beta_ref, &error );
+        if (params.error_exit() == 'y') {
+            assert_throw( lapack::gges( lapack::Job::NoVec, lapack::Job::NoVec,
+                                        lapack::Sort::NotSorted, select, n,
+                                        &C_tst[0], ldc, &D_tst[0], ldc,
+                                        &sdim_tst, &W_tst[0], &beta_tst[0],
+                                        VL, 1, VR, 1, work2.data(), 0 ),
+                          lapack::Error );
+        }
+    }
+
+    params.time() = time;
+    params.ref_time() = ref_time;
+    params.error() = error;
+    params.okay() = (error < tol) && pivots_okay;
+    if (! pivots_okay) {
+        params.msg() = "pivots, rank, or nfound differ";
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_work( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_work_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_work_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_work_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_work_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/allocator.hh"
+#include "lapack/workspace.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// @return number of workspace allocations counted, excluding the arena's
+// own buffer if arena is false, or only the arena's buffer if arena is true.
+static int64_t num_allocs(
+    lapack::workspace::CountingAllocator const& counter, bool arena )
+{
+    int64_t count = 0;
+    for (auto const& iter : counter.counts()) {
+        if ((iter.first == "arena") == arena)
+            count += iter.second.count;
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// Calls gesdd repeatedly on the same matrix, with the workspace arena
+// disabled, then enabled. gesdd allocates work, plus rwork and iwork for
+// complex, so several blocks are nested in the arena. Checks that:
+// - with the arena disabled, every call allocates;
+// - the arena grows to the high-water mark on the first call after
+//   workspace overflowed it, and then calls don't allocate;
+// - reserve() allocates the arena up front, and release() frees it;
+// - results are bitwise identical with and without the arena.
+// Allocations are counted with a CountingAllocator on this thread.
+// If the workspace fits in the on-stack buffer, nothing is allocated,
+// so only results are checked.
+template< typename scalar_t >
+void test_workspace_work( Params& params, bool run )
+{
+    namespace workspace = lapack::workspace;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldu = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, minmn ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_S = (size_t) minmn;
+    size_t size_U = (size_t) ldu * minmn;
+    size_t size_VT = (size_t) ldvt * n;
+
+    std::vector< scalar_t > A( size_A ), A_tst( size_A );
+    std::vector< real_t > S_tst( size_S ), S_ref( size_S );
+    std::vector< scalar_t > U_tst( size_U ), U_ref( size_U );
+    std::vector< scalar_t > VT_tst( size_VT ), VT_ref( size_VT );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    // Calls gesdd on a copy of A; returns its info.
+    auto call = [&]() {
+        A_tst = A;
+        return lapack::gesdd( lapack::Job::SomeVec, m, n, &A_tst[0], lda,
+                              &S_tst[0], &U_tst[0], ldu, &VT_tst[0], ldvt );
+    };
+
+    // Start from a released, disabled arena, counting allocations.
+    workspace::CountingAllocator counter;
+    workspace::set_thread_allocator( &counter );
+    workspace::enable( false );
+    workspace::release();
+
+    std::string msg;
+    auto expect = [&msg]( bool cond, const char* what ) {
+        if (! cond && msg.empty())
+            msg = what;
+    };
+
+    // ---------- run reference, arena disabled
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_ref = 0;
+    for (int64_t i = 0; i < batch; ++i)
+        info_ref = call();
+    time = testsweeper::get_wtime() - time;
+    params.ref_time() = time;
+    if (info_ref != 0) {
+        fprintf( stderr, "lapack::gesdd returned error %lld\n", (lld) info_ref );
+    }
+    S_ref  = S_tst;
+    U_ref  = U_tst;
+    VT_ref = VT_tst;
+
+    // Workspace that overflows the stack buffer is allocated on every call.
+    size_t high_water = workspace::high_water();
+    bool allocates = (high_water > 0);
+    int64_t allocs_per_call = num_allocs( counter, false ) / blas::max( 1, batch );
+    expect( ! allocates || allocs_per_call > 0, "disabled arena didn't allocate" );
+    expect( workspace::size() == 0, "disabled arena grew" );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld; workspace high-water %lld bytes, "
+                "%lld allocations per call\n",
+                (lld) m, (lld) n, (lld) lda,
+                (lld) high_water, (lld) allocs_per_call );
+    }
+
+    // ---------- run test, arena enabled
+    // After the disabled trial run set the high-water mark, the first
+    // call grows the arena to it, then no calls allocate.
+    workspace::enable( true );
+    counter.reset();
+    testsweeper::flush_cache( params.cache() );
+    time = testsweeper::get_wtime();
+    int64_t info_tst = 0;
+    for (int64_t i = 0; i < batch; ++i)
+        info_tst = call();
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gesdd returned error %lld\n", (lld) info_tst );
+    }
+
+    if (verbose >= 1) {
+        printf( "arena %lld bytes, high-water %lld bytes\n",
+                (lld) workspace::size(), (lld) workspace::high_water() );
+        counter.print();
+    }
+
+    if (params.check() == 'y') {
+        // ---------- check results are bitwise identical
+        bool same = (info_tst == info_ref
+                     && S_tst  == S_ref
+                     && U_tst  == U_ref
+                     && VT_tst == VT_ref);
+        expect( same, "results differ with arena" );
+        params.error() = (same ? 0 : 1);
+
+        if (allocates) {
+            // ---------- check arena reused
+            expect( num_allocs( counter, true ) == 1,
+                    "arena didn't grow once to high-water" );
+            expect( num_allocs( counter, false ) == 0,
+                    "enabled arena allocated" );
+            expect( workspace::size() >= workspace::high_water()
+                    && workspace::high_water() == high_water,
+                    "wrong arena size" );
+
+            // ---------- check release
+            workspace::release();
+            expect( workspace::size() == 0 && workspace::high_water() == 0,
+                    "release didn't free arena" );
+
+            // ---------- check growth from empty arena
+            // First call overflows the empty arena to the allocator,
+            // second call grows it, later calls don't allocate.
+            counter.reset();
+            call();
+            expect( num_allocs( counter, false ) == allocs_per_call
+                    && num_allocs( counter, true ) == 0,
+                    "empty arena didn't overflow to allocator" );
+            counter.reset();
+            call();
+            expect( num_allocs( counter, false ) == 0
+                    && num_allocs( counter, true ) == 1,
+                    "arena didn't grow to high-water" );
+            counter.reset();
+            call();
+            expect( num_allocs( counter, false ) == 0
+                    && num_allocs( counter, true ) == 0,
+                    "grown arena allocated" );
+            expect( S_tst == S_ref && U_tst == U_ref && VT_tst == VT_ref,
+                    "results differ with grown arena" );
+
+            // ---------- check reserve
+            // Reserving twice the high-water allocates once, up front.
+            workspace::release();
+            counter.reset();
+            workspace::reserve( 2*high_water );
+            size_t reserved = workspace::size();
+            expect( reserved >= 2*high_water
+                    && num_allocs( counter, true ) == 1,
+                    "reserve didn't allocate arena" );
+            call();
+            expect( num_allocs( counter, false ) == 0
+                    && num_allocs( counter, true ) == 1
+                    && workspace::size() == reserved,
+                    "reserved arena allocated" );
+
+            // ---------- check disable
+            // Disabled arena keeps its buffer, but calls allocate again.
+            workspace::enable( false );
+            counter.reset();
+            call();
+            expect( num_allocs( counter, false ) == allocs_per_call
+                    && workspace::size() == reserved,
+                    "disabled arena didn't allocate" );
+        }
+        params.okay() = msg.empty();
+    }
+    params.msg() = msg;
+
+    // Restore defaults; counter is destroyed on return.
+    workspace::enable( false );
+    workspace::release();
+    workspace::set_thread_allocator( nullptr );
+}
+
+// -----------------------------------------------------------------------------
+void test_workspace( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_workspace_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_workspace_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_workspace_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_workspace_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,226 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Streams batch device getrf and geqrf calls, alternating, using the queue's
+// workspace pool. Ref. does the same, allocating and freeing workspace for
+// each call, as callers of the explicit-workspace routines do.
+// Checks that results match, and that the pool's peak is the largest
+// workspace queried.
+template< typename scalar_t >
+void test_workspace_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.time_call();
+    params.ref_time();
+    params.ref_time_call();
+    params.msg();
+
+    if (! run)
+        return;
+
+    if (lapack::get_device_count() == 0) {
+        params.msg() = "skipping: no devices";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_tau = (size_t) blas::max( 1, blas::min( m, n ) );
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > LU_tst( size_A ), LU_ref( size_A );
+    std::vector< scalar_t > QR_tst( size_A ), QR_ref( size_A );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    // Allocate and copy to device.
+    lapack::Queue queue( device, 0 );
+    scalar_t*         dA     = lapack::device_malloc< scalar_t >( size_A, queue );
+    scalar_t*         d_tau  = lapack::device_malloc< scalar_t >( size_tau, queue );
+    device_pivot_int* d_ipiv = lapack::device_malloc< device_pivot_int >( size_tau, queue );
+    device_info_int*  d_info = lapack::device_malloc< device_info_int >( 1, queue );
+
+    // Largest workspace the pool should hold.
+    size_t getrf_dev, getrf_host, geqrf_dev, geqrf_host;
+    lapack::getrf_work_size_bytes( m, n, dA, lda, &getrf_dev, &getrf_host, queue );
+    lapack::geqrf_work_size_bytes( m, n, dA, lda, &geqrf_dev, &geqrf_host, queue );
+    size_t peak_dev  = blas::max( getrf_dev,  geqrf_dev  );
+    size_t peak_host = blas::max( getrf_host, geqrf_host );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, batch=%lld\n"
+                "workspace device %lld bytes, host %lld bytes\n",
+                (lld) m, (lld) n, (lld) lda, (lld) batch,
+                (lld) peak_dev, (lld) peak_host );
+    }
+
+    // ---------- run test, using the pool
+    testsweeper::flush_cache( params.cache() );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::device_setmatrix( m, n, A.data(), lda, dA, lda, queue );
+        if (i % 2 == 0) {
+            lapack::getrf( m, n, dA, lda, d_ipiv, d_info, queue );
+            lapack::device_getmatrix( m, n, dA, lda, LU_tst.data(), lda, queue );
+        }
+        else {
+            lapack::geqrf( m, n, dA, lda, d_tau, d_info, queue );
+            lapack::device_getmatrix( m, n, dA, lda, QR_tst.data(), lda, queue );
+        }
+    }
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    params.time_call() = time / batch * 1e6;
+
+    if (verbose >= 1) {
+        printf( "pool device %lld bytes (peak %lld), host %lld bytes (peak %lld)\n",
+                (lld) queue.dev_workspace_size(),
+                (lld) queue.dev_workspace_peak(),
+                (lld) queue.host_workspace_size(),
+                (lld) queue.host_workspace_peak() );
+    }
+
+    if (params.check() == 'y') {
+        // ---------- run reference, allocating workspace for each call
+        testsweeper::flush_cache( params.cache() );
+        queue.sync();
+        time = testsweeper::get_wtime();
+
+        for (int64_t i = 0; i < batch; ++i) {
+            size_t d_size, h_size;
+            lapack::device_setmatrix( m, n, A.data(), lda, dA, lda, queue );
+            if (i % 2 == 0) {
+                lapack::getrf_work_size_bytes( m, n, dA, lda, &d_size, &h_size, queue );
+            }
+            else {
+                lapack::geqrf_work_size_bytes( m, n, dA, lda, &d_size, &h_size, queue );
+            }
+            char* d_work = lapack::device_malloc< char >( d_size, queue );
+            std::vector<char> h_work_vector( h_size );
+            char* h_work = h_work_vector.data();
+            if (i % 2 == 0) {
+                lapack::getrf( m, n, dA, lda, d_ipiv,
+                               d_work, d_size, h_work, h_size, d_info, queue );
+                lapack::device_getmatrix( m, n, dA, lda, LU_ref.data(), lda, queue );
+            }
+            else {
+                lapack::geqrf( m, n, dA, lda, d_tau,
+                               d_work, d_size, h_work, h_size, d_info, queue );
+                lapack::device_getmatrix( m, n, dA, lda, QR_ref.data(), lda, queue );
+            }
+            // h_work is freed on return, so wait for the call.
+            lapack::device_free( d_work, queue );
+            queue.sync();
+        }
+
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_time_call() = time / batch * 1e6;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (m > 0 && n > 0) {
+            error = rel_error( LU_tst, LU_ref );
+            if (batch > 1)
+                error = blas::max( error, rel_error( QR_tst, QR_ref ) );
+        }
+        params.error() = error;
+
+        // ---------- check pool sizes
+        // Pool stays allocated, at the peak size, until released.
+        bool pool_okay = (batch < 2
+                          || (queue.dev_workspace_peak()  == peak_dev
+                              && queue.host_workspace_peak() == peak_host
+                              && queue.dev_workspace_size()  == peak_dev
+                              && queue.host_workspace_size() == peak_host));
+        queue.workspace_release();
+        pool_okay = pool_okay
+                    && queue.dev_workspace_size()  == 0
+                    && queue.host_workspace_size() == 0
+                    && queue.dev_workspace() == nullptr;
+
+        // Reserving up front, calls don't grow the pool.
+        queue.workspace_reserve( 2*peak_dev, 2*peak_host );
+        void* dev_ptr = queue.dev_workspace();
+        lapack::device_setmatrix( m, n, A.data(), lda, dA, lda, queue );
+        lapack::getrf( m, n, dA, lda, d_ipiv, d_info, queue );
+        queue.sync();
+        pool_okay = pool_okay
+                    && queue.dev_workspace() == dev_ptr
+                    && queue.dev_workspace_size()  == 2*peak_dev
+                    && queue.host_workspace_size() == 2*peak_host;
+        if (! pool_okay) {
+            params.msg() = "wrong workspace pool size";
+        }
+
+        params.okay() = (error < tol) && pool_okay;
+    }
+
+    // Cleanup device memory.
+    lapack::device_free( dA,     queue );
+    lapack::device_free( d_tau,  queue );
+    lapack::device_free( d_ipiv, queue );
+    lapack::device_free( d_info, queue );
+}
+
+// -----------------------------------------------------------------------------
+void test_workspace_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_workspace_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_workspace_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_workspace_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_workspace_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -8,9 +8,17 @@ It takes a list of routines, without precision prefix (so "getrf" instead of "sg
 It generates files in lapackpp/gen/ directory, which can then be manually moved to the appropriate place.
 
 Arguments:
-    -H, --header   generate header   in gen/wrappers.hh to go in include/lapack/wrappers.hh
-    -w, --wrapper  generate wrappers in gen/foo.cc      to go in src
+    -H, --header   generate header   in gen/wrappers.hh to go in include/lapack/wrappers.hh,
+                   and gen/work.hh to go in include/lapack/work.hh.
+    -w, --wrapper  generate wrappers in gen/foo.cc      to go in src.
+                   For routines with work arrays, gen/foo.cc also has the
+                   overloads taking caller-provided workspace and
+                   foo_work_size_bytes, declared in gen/work.hh.
     -t, --tester   generate testers  in gen/test_foo.cc to go in test
+    -p, --plan     generate plans    in gen/plan_foo.cc to go in src,
+                   and gen/plan.hh to go in include/lapack/plan.hh.
+                   Only for routines with a workspace query; not done by default.
+                   Plans call the caller-provided workspace overloads from -w.
 
 Example creating tester:
 
@@ -84,6 +92,7 @@ from __future__ import print_function
 
 import sys
 import re
+import copy
 import os
 import argparse
 import traceback
@@ -101,6 +110,9 @@ parser.add_argument( '-w', '--wrapper', action='store_true',
 parser.add_argument( '-t', '--tester',  action='store_true',
                      help='generate testers  in gen/test_foo.cc to go in test' )
 
+parser.add_argument( '-p', '--plan',    action='store_true',
+                     help='generate plans    in gen/plan_foo.cc to go in src' )
+
 parser.add_argument( '-d', '--debug',   action='store_true',
                      help='debug mode' )
 
@@ -114,7 +126,7 @@ if (len( args.argv ) == 0):
 # end
 
 # default: do all
-if (not (args.header or args.tester or args.wrapper)):
+if (not (args.header or args.tester or args.wrapper or args.plan)):
     args.header  = True
     args.tester  = True
     args.wrapper = True
@@ -157,6 +169,9 @@ wrapper_top1 = '''\
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "lapack/flops.hh"
+#include "NoConstructAllocator.hh"
+#include "WorkBuffer.hh"
 
 '''
 
@@ -175,6 +190,174 @@ wrapper_bottom = '''\
 }  // namespace lapack
 '''
 
+# --------------------
+# for plan.hh
+plan_header_top = '''\
+#ifndef LAPACK_PLAN_HH
+#define LAPACK_PLAN_HH
+
+#include "lapack/util.hh"
+#include "lapack/work.hh"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace lapack {
+
+namespace internal {
+
+// Aligned heap allocation; see workspace.cc.
+void* aligned_malloc( std::size_t bytes );
+void  aligned_free( void* ptr ) noexcept;
+
+}  // namespace internal
+
+//==============================================================================
+/// Plans hoist the workspace query and allocation out of repeated calls.
+///
+/// Routines such as gesdd query LAPACK for the optimal workspace size
+/// (lwork = -1), allocate it, then call LAPACK again, on every call.
+/// A plan does the query and allocation once when it is constructed,
+/// for fixed options and dimensions; then each execute() makes a single
+/// LAPACK call, with no query and no allocation.
+/// For example:
+///
+///     lapack::plan::gesdd< double > plan( lapack::Job::SomeVec, m, n );
+///     for (...) {
+///         int64_t info = plan.execute( A, lda, S, U, ldu, VT, ldvt );
+///     }
+///
+/// Arguments to the plan's constructor are the options and dimensions
+/// of the corresponding routine, that is, the arguments before the first
+/// array, plus any later dimensions the workspace query needs (trevc3's
+/// n and mm, geqr's tsize). Arguments to execute() are the remaining
+/// arguments, that is, arrays and their leading dimensions. The plan's
+/// workspace is reused by each execute(), so a plan must not be executed
+/// concurrently from multiple threads; use one plan per thread.
+///
+/// A plan holds one buffer, sized by the routine's *_work_size_bytes
+/// query (see lapack/work.hh), and passes it to the routine's
+/// caller-provided workspace overload. The buffer is aligned and
+/// not initialized.
+/// Every routine that does a workspace query has a plan, generated by
+/// tools/wrapper_gen.py -p. As in lapack/work.hh, real routines named
+/// sy, sp, sb, or, and op use the complex-named plan, instantiated for
+/// all precisions (syev uses heev). If the real routine has only real
+/// precisions, its name is an alias of that plan (plan::syev is
+/// plan::heev). Routines with hand-written wrappers, such as geev, gees,
+/// gges, and trsen, have hand-written plans in the same form.
+///
+/// @ingroup plan
+namespace plan {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Allocator for a plan's workspace: aligned heap memory whose elements
+/// are not initialized, like lapack::vector. Unlike lapack::vector, it
+/// doesn't use the workspace arena, since a plan's buffer outlives the
+/// calls that use it and may be freed on another thread.
+template <typename T>
+struct WorkAllocator
+{
+    using value_type = T;
+
+    WorkAllocator() = default;
+
+    template <typename U>
+    WorkAllocator( WorkAllocator< U > const& ) noexcept {}
+
+    // Construction and destruction are null-ops, leaving memory uninitialized.
+    template <typename... Args>
+    void construct( T* ptr, Args&& ... args ) {}
+
+    void destroy( T* ptr ) {}
+
+    T* allocate( std::size_t n )
+    {
+        if (n > std::numeric_limits< std::size_t >::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast< T* >( lapack::internal::aligned_malloc( n*sizeof(T) ) );
+    }
+
+    void deallocate( T* ptr, std::size_t n ) noexcept
+    {
+        lapack::internal::aligned_free( ptr );
+    }
+};
+
+template <typename T, typename U>
+bool operator == ( WorkAllocator< T > const&, WorkAllocator< U > const& )
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator != ( WorkAllocator< T > const&, WorkAllocator< U > const& )
+{
+    return false;
+}
+
+/// Workspace buffer of a plan.
+using work_vector = std::vector< char, WorkAllocator< char > >;
+
+}  // namespace internal
+
+'''
+
+plan_header_bottom = '''\
+}  // namespace plan
+}  // namespace lapack
+
+#endif // LAPACK_PLAN_HH
+'''
+
+# --------------------
+# for src/plan_*.cc plans
+plan_top1 = '''\
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/plan.hh"
+
+'''
+
+plan_top2 = '''\
+namespace lapack {
+namespace plan {
+
+using blas::max;
+
+'''
+
+plan_bottom = '''\
+}  // namespace plan
+}  // namespace lapack
+'''
+
+# --------------------
+# for work.hh
+work_header_top = '''\
+#ifndef LAPACK_WORK_HH
+#define LAPACK_WORK_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+
+'''
+
+work_header_bottom = '''\
+}  // namespace lapack
+
+#endif // LAPACK_WORK_HH
+'''
+
 # --------------------
 # for test/test_*.cc testers
 tester_top = '''\
@@ -597,6 +780,27 @@ post_rename = {
     'ggsvp3':       (( 'jobu_ggsvd', 'jobu' ), ),
 }
 
+# ------------------------------------------------------------------------------
+# Routines implemented natively in src/foo.cc instead of wrapping LAPACK.
+# Their wrappers, caller-provided workspace overloads, and plans are not
+# generated, so regenerating can't overwrite the native kernels with
+# Fortran wrappers. Headers and testers are still generated.
+native_routines = (
+    'lange',  # norm_kernels.cc
+    'lanhe',
+    'lansy',
+    'lantr',
+    'lassq',
+
+    'laswp',  # permute_kernels.cc
+    'lapmr',
+    'lapmt',
+
+    'lacpy',  # copy_kernels.cc
+    'laset',
+    'lascl',
+)
+
 # ------------------------------------------------------------------------------
 alias_map = {
     'sy': 'he',
@@ -605,6 +809,19 @@ alias_map = {
     'or': 'un',
     'op': 'up',
 }
+alias_map_inverse = dict( (v, k) for (k, v) in alias_map.items() )
+
+# ------------------------------------------------------------------------------
+# LAPACK++ names that differ from the LAPACK base names;
+# e.g., lapack::hecon_rk wraps LAPACK's hecon_3.
+wrapper_name_map = {
+    'hecon_3': 'hecon_rk',
+    'hetri_3': 'hetri_rk',
+    'hetrs_3': 'hetrs_rk',
+    'sycon_3': 'sycon_rk',
+    'sytri_3': 'sytri_rk',
+    'sytrs_3': 'sytrs_rk',
+}
 
 # ------------------------------------------------------------------------------
 fortran_operators = {
@@ -678,6 +895,9 @@ class Func:
         else:
             self.name = 'unknown'
             print( 'unknown base function name', xname )
+
+        # name of LAPACK++ wrapper, e.g., hecon_rk for hecon_3
+        self.wname = wrapper_name_map.get( self.name, self.name )
     # end
 # end
 
@@ -1166,7 +1386,7 @@ def parse_docs( func, txt, variables, indent=0 ):
                   sub_enum_short, txt )
 
     # convert function names
-    txt = re.sub( func.xname.upper(), '`'+ func.name + '`', txt )
+    txt = re.sub( func.xname.upper(), '`'+ func.wname + '`', txt )
     txt = re.sub( lapack_functions_re,
                   lambda match: '`lapack::' + match.group(1).lower() + '`', txt )
 
@@ -1314,6 +1534,56 @@ def generate_docs( func ):
     return txt
 # end
 
+# ------------------------------------------------------------------------------
+# flops.hh functions, mapping name => list of argument names; parsed on first
+# use by generate_trace_block.
+flops_args = None
+
+def parse_flops():
+    path = os.path.join( os.path.dirname( os.path.abspath( __file__ ) ),
+                         '..', 'include', 'lapack', 'flops.hh' )
+    args = {}
+    txt = open( path ).read()
+    for s in re.finditer( r'static double (\w+)\(([^)]*)\)', txt ):
+        names = [ a.split()[-1] for a in s.group(2).split( ',' ) if a.strip() ]
+        args.setdefault( s.group(1), names )
+    return args
+# end
+
+# ------------------------------------------------------------------------------
+# Returns trace::internal::Block declaration that traces routine name,
+# for wrappers to emit after their argument checks.
+# prec is the precision expression, e.g., "'d'";
+# dim_args are the wrapper's integer input arguments, passed by value;
+# scalar_t is its scalar type.
+# Dimensions that aren't arguments are -1; k is nrhs for solves.
+# Gflop comes from flops.hh if it has name, taking only dim_args.
+def generate_trace_block( name, prec, dim_args, scalar_t ):
+    global flops_args
+    if (flops_args is None):
+        flops_args = parse_flops()
+
+    m = 'm' if ('m' in dim_args) else '-1'
+    n = 'n' if ('n' in dim_args) else '-1'
+    if ('nrhs' in dim_args):
+        k = 'nrhs'
+    elif ('k' in dim_args):
+        k = 'k'
+    else:
+        k = '-1'
+
+    fargs = flops_args.get( name )
+    if (fargs is not None and all( a in dim_args for a in fargs )):
+        gflop = ('[&]() { return Gflop< ' + scalar_t + ' >::' + name
+              +  '( ' + ', '.join( fargs ) + ' ); }')
+    else:
+        gflop = '[]() { return 0.0; }'
+
+    return (tab + 'trace::internal::Block trace_block(\n'
+         +  tab*2 + '"' + name + '", ' + prec + ', ' + m + ', ' + n + ', ' + k + ',\n'
+         +  tab*2 + gflop + ' );\n')
+# end
+
 # ------------------------------------------------------------------------------
 # returns LAPACK++ wrapper for given function
 def generate_wrapper( func, header=False ):
@@ -1330,6 +1600,7 @@ def generate_wrapper( func, header=False ):
     query_args = []
     call_args  = []
     alias_args = []
+    dim_args   = []
     use_query  = False
     i = 0
     for arg in func.args:
@@ -1360,7 +1631,7 @@ def generate_wrapper( func, header=False ):
                     # integer input arrays: copy in input
                     local_vars += (tab + '#if 1\n'
                                +   tab*2 + '// 32-bit copy\n'
-                               +   tab*2 + 'std::vector< lapack_int > ' + arg.lname + '( &' + arg.name + '[0], &' + arg.name + '[' + arg.dim + '] );\n'
+                               +   tab*2 + 'lapack::small_vector< lapack_int > ' + arg.lname + '( &' + arg.name + '[0], &' + arg.name + '[' + arg.dim + '] );\n'
                                +   tab*2 + 'lapack_int const* ' + arg.pname + ' = &' + arg.lname + '[0];\n'
                                +   tab + '#else\n'
                                +   tab*2 + 'lapack_int const* ' + arg.pname + ' = ' + arg.lname + ';\n'
@@ -1379,6 +1650,7 @@ def generate_wrapper( func, header=False ):
                 query_args.append( prefix + cast + arg.pname )
                 if (arg.dtype in ('int64_t', 'bool')):
                     # local 32-bit copy of 64-bit int
+                    dim_args.append( arg.name )
                     int_checks += tab*2 + 'lapack_error_if( std::abs(' + arg.name + ') > std::numeric_limits<lapack_int>::max() );\n'
                     local_vars += tab + 'lapack_int ' + arg.lname + ' = (lapack_int) ' + arg.name + ';\n'
                 elif (arg.is_enum):
@@ -1392,10 +1664,11 @@ def generate_wrapper( func, header=False ):
                 query_args.append( prefix + cast + 'qry_' + arg.name )
                 query += tab + arg.dtype + ' qry_' + arg.name + '[1];\n'
 
+                # lapack::vector draws from the workspace arena, if enabled.
                 if (arg.use_query):
-                    alloc_work += tab + 'std::vector< ' + arg.dtype + ' > ' + arg.lname + '( ' + func.args[i+1].lname + ' );\n'
+                    alloc_work += tab + 'lapack::small_vector< ' + arg.dtype + ' > ' + arg.lname + '( ' + func.args[i+1].lname + ' );\n'
                 else:
-                    alloc_work += tab + 'std::vector< ' + arg.dtype + ' > ' + arg.lname + '( ' + arg.dim.lower() + ' );\n'
+                    alloc_work += tab + 'lapack::small_vector< ' + arg.dtype + ' > ' + arg.lname + '( ' + arg.dim.lower() + ' );\n'
 
                 ##alloc_work += (tab + arg.dtype + '* ' + arg.name + '_'
                 ##           +   ' = new ' + arg.dtype + '[ l' + arg.name + ' ];\n')
@@ -1426,7 +1699,7 @@ def generate_wrapper( func, header=False ):
                         # copy in input, copy out in cleanup
                         local_vars += (tab + '#if 1\n'
                                    +   tab*2 + '// 32-bit copy\n'
-                                   +   tab*2 + 'std::vector< lapack_int > ' + arg.lname + '( &' + arg.name + '[0], &' + arg.name + '[' + arg.dim + '] );\n'
+                                   +   tab*2 + 'lapack::small_vector< lapack_int > ' + arg.lname + '( &' + arg.name + '[0], &' + arg.name + '[' + arg.dim + '] );\n'
                                    +   tab*2 + 'lapack_int* ' + arg.pname + ' = &' + arg.lname + '[0];\n'
                                    +   tab + '#else\n'
                                    +   tab*2 + 'lapack_int* ' + arg.pname + ' = ' + arg.name + ';\n'
@@ -1435,7 +1708,7 @@ def generate_wrapper( func, header=False ):
                         # allocate w/o copy, copy out in cleanup
                         local_vars += (tab + '#if 1\n'
                                    +   tab*2 + '// 32-bit copy\n'
-                                   +   tab*2 + 'std::vector< lapack_int > ' + arg.lname + '( ' + arg.dim + ' );\n'
+                                   +   tab*2 + 'lapack::small_vector< lapack_int > ' + arg.lname + '( ' + arg.dim + ' );\n'
                                    +   tab*2 + 'lapack_int* ' + arg.pname + ' = &' + arg.lname + '[0];\n'
                                    +   tab + '#else\n'
                                    +   tab*2 + 'lapack_int* ' + arg.pname + ' = ' + arg.name + ';\n'
@@ -1478,6 +1751,12 @@ def generate_wrapper( func, header=False ):
                    +  tab + '}\n')
     # end
 
+    # trace after argument checks, so calls that throw aren't recorded
+    trace = generate_trace_block( func.wname, "'" + func.xname[0] + "'",
+                                  dim_args, func_scalar_type( func ) ) + '\n'
+    if (int_checks):
+        trace = '\n' + trace
+
     if (alloc_work):
         alloc_work = ('\n'
                    +  tab + '// allocate workspace\n'
@@ -1492,26 +1771,27 @@ def generate_wrapper( func, header=False ):
         call = '\n' + tab + 'LAPACK_' + func.xname + '(\n' + tab*2 + ', '.join( call_args ) + ' );\n'
 
     if (header):
-        txt = (func.retval + ' ' + func.name + '(\n'
+        txt = (func.retval + ' ' + func.wname + '(\n'
             +  tab + ', '.join( proto_args )
             +  ' );\n\n')
         # aliases for real routines (hesv => sysv, etc.)
-        s = re.search( r'^[sd](sy|sp|sb|or|op)(\w+)', func.xname )
-        if (s):
+        s = re.search( r'^(sy|sp|sb|or|op)(\w+)', func.wname )
+        if (s and func.xname[0] in ('s', 'd')):
             alias = alias_map[ s.group(1) ] + s.group(2)
             # todo: he
-            txt += ('// ' + alias + ' alias to ' + func.name + '\n'
+            txt += ('// ' + alias + ' alias to ' + func.wname + '\n'
                 +   'inline ' + func.retval + ' ' + alias + '(\n'
                 +   tab + ', '.join( proto_args ) + ' )\n'
                 +   '{\n'
-                +   tab + 'return ' + func.name + '( ' + ', '.join( alias_args ) + ' );\n'
+                +   tab + 'return ' + func.wname + '( ' + ', '.join( alias_args ) + ' );\n'
                 +   '}\n\n')
         # end
     else:
-        txt = (func.retval + ' ' + func.name + '(\n'
+        txt = (func.retval + ' ' + func.wname + '(\n'
             +  tab + ', '.join( proto_args )
             +  ' )\n{\n'
             +  int_checks
+            +  trace
             +  local_vars
             +  query
             +  alloc_work
@@ -1533,6 +1813,1075 @@ def generate_wrapper( func, header=False ):
     return txt
 # end
 
+# ------------------------------------------------------------------------------
+# Given txt from generate_wrapper, returns the same wrapper with pivots ipiv
+# of type lapack_int instead of int64_t, passed directly to LAPACK without
+# a 32-bit copy, or '' if the routine has no pivots.
+# These overloads exist only in LP64 builds, so go in #ifndef LAPACK_ILP64.
+def generate_native_pivot( txt ):
+    if (not re.search( r'int64_t( const)?\* ipiv\b', txt )):
+        return ''
+    txt = re.sub( r'int64_t( const)?\* ipiv\b', r'lapack_int\1* ipiv', txt )
+    # generated code has "#if 1", later edited to "#ifndef LAPACK_ILP64"
+    txt = re.sub( r'    #(if 1|ifndef LAPACK_ILP64)\n        // 32-bit copy\n.*?    #else\n'
+                  r'        lapack_int( const)?\* ipiv_ptr = ipiv_?;\n    #endif\n',
+                  '', txt, 0, re.S )
+    txt = re.sub( r'    #(if 1|ifndef LAPACK_ILP64)\n        std::copy\( ipiv_\.begin\(\), ipiv_\.end\(\), ipiv \);\n    #endif\n',
+                  '', txt )
+    txt = txt.replace( 'ipiv_ptr', 'ipiv' )
+    return txt
+# end
+
+native_pivot_doc = '''\
+// -----------------------------------------------------------------------------
+/// Same as above, but with pivots ipiv of type lapack::pivot_t (lapack_int),
+/// which are passed directly to LAPACK, without a 32-bit copy.
+/// Only in LP64 builds; in ILP64 builds, the int64_t version suffices.
+///
+'''
+
+# ------------------------------------------------------------------------------
+# Templated code: caller-provided workspace overloads and plans.
+# These are templated on scalar_t, with intermediate wrappers that dispatch
+# to each precision's Fortran routine, so they need all precisions at once.
+
+# --------------------
+# Returns lower bound for leading dimension in workspace query,
+# combining all bounds found, e.g., "1; m" => "max( 1, m )".
+def query_lbound( arg ):
+    terms = []
+    for b in arg.lbound.split( ';' ):
+        b = b.strip()
+        s = re.search( r'^max\( *(.*?) *\)$', b )
+        if (s and '(' not in s.group(1)):
+            bs = [x.strip() for x in s.group(1).split( ',' )]
+        else:
+            bs = [b]
+        for b in bs:
+            if (b and b not in terms):
+                terms.append( b )
+    # end
+    if ('1' not in terms):
+        terms.insert( 0, '1' )
+    return 'max( ' + ', '.join( terms ) + ' )'
+# end
+
+# --------------------
+# Captures arguments of a routine, across precisions, for templated code.
+class TemplateInfo:
+    def __init__( self, funcs ):
+        # master has the most arguments (e.g., complex has rwork)
+        self.funcs  = funcs
+        self.master = funcs[0]
+        for func in funcs:
+            if (len( func.args ) > len( self.master.args )):
+                self.master = func
+        # end
+        self.name = self.master.wname
+        self.is_complex = any( func.xname[0] in ('c', 'z') for func in funcs )
+        self.is_mixed   = self.is_complex and any( func.xname[0] in ('s', 'd') for func in funcs )
+
+        # args is the union of arguments of all precisions, in order,
+        # with types from a complex precision if there is one,
+        # e.g., gecon has iwork in real and rwork in complex precisions.
+        primary = funcs[0]
+        for func in funcs:
+            if (func.xname[0] in ('c', 'z')):
+                primary = func
+                break
+        # end
+        # If intents differ, e.g., [sd]trevc update select but [cz]trevc
+        # don't, the template uses in,out.
+        self.args = [ copy.copy( arg ) for arg in primary.args ]
+        for func in funcs:
+            prev = None
+            for arg in func.args:
+                names = [ a.name for a in self.args ]
+                if (arg.name not in names):
+                    i = names.index( prev ) + 1 if (prev) else 0
+                    self.args.insert( i, copy.copy( arg ) )
+                else:
+                    targ = self.args[ names.index( arg.name ) ]
+                    if (targ.intent != arg.intent):
+                        targ.intent = 'in,out'
+                prev = arg.name
+            # end
+        # end
+
+        self.plan_args  = []  # before 1st array: options and dimensions
+        self.exec_args  = []  # rest, excluding workspace and info
+        self.work_args  = []  # work, rwork, iwork, ...
+        self.int_arrays = []  # need 32-bit copies
+        self.use_query  = False
+        pre_arrays = True
+        for arg in self.args:
+            if (arg.is_array):
+                pre_arrays = False
+            if (arg.use_query):
+                self.use_query = True
+            if (arg.is_work):
+                self.work_args.append( arg )
+            elif (arg.is_lwork or arg.name == 'info'):
+                pass
+            elif (pre_arrays and arg.intent == 'in'):
+                self.plan_args.append( arg )
+            else:
+                self.exec_args.append( arg )
+                if (arg.is_array and arg.dtype in ('int64_t', 'bool')):
+                    self.int_arrays.append( arg )
+            # end
+        # end
+
+        # The queried work array gets the rest of the buffer, preferably
+        # work; other queried arrays (rwork, iwork) get their queried size;
+        # the rest are sized by their dimension.
+        self.main_work = None
+        self.queried   = []
+        for arg in self.work_args:
+            lwork = self.lwork( arg )
+            if (lwork and lwork.use_query):
+                self.queried.append( arg )
+                if (self.main_work is None or arg.name == 'work'):
+                    self.main_work = arg
+        # end
+    # end
+
+    # returns template type for arg, e.g., scalar_t or real_t
+    def ttype( self, arg, real_t='real_t' ):
+        if (arg.dtype in ('float', 'double')):
+            return real_t if self.is_complex else 'scalar_t'
+        elif (re.search( r'^std::complex', arg.dtype )):
+            return 'scalar_t'
+        return arg.dtype
+    # end
+
+    def uses_real( self, args ):
+        return any( self.ttype( arg ) == 'real_t' for arg in args )
+
+    # returns lwork argument for work array arg
+    def lwork( self, arg ):
+        i = self.args.index( arg )
+        if (i + 1 < len( self.args ) and self.args[ i+1 ].is_lwork):
+            return self.args[ i+1 ]
+        return None
+    # end
+
+    # returns expr, or 0 for precisions that don't have arg,
+    # e.g., rwork exists only in complex precisions.
+    # If given, real_expr is used for real precisions.
+    def guard( self, arg, expr, real_expr=None ):
+        if (not self.is_mixed):
+            return expr
+        have = [ func.xname[0] in ('c', 'z') for func in self.funcs
+                 if (arg.name in [ a.name for a in func.args ]) ]
+        if (all( have )):
+            real_expr = '0'
+        elif (not any( have )):
+            (expr, real_expr) = ('0', expr)
+        if (real_expr is None or real_expr == expr):
+            return expr
+        return 'blas::is_complex<scalar_t>::value ? ' + expr + ' : ' + real_expr
+    # end
+
+    # returns size expressions of fixed-size work array arg, as
+    # (complex, real), which differ for, e.g., gecon work.
+    def work_dims( self, arg ):
+        dims = {}
+        for func in self.funcs:
+            for a in func.args:
+                if (a.name == arg.name):
+                    dims[ func.xname[0] in ('c', 'z') ] = unparen( a.dim )
+        # end
+        dim = unparen( arg.dim )
+        return (dims.get( True, dim ), dims.get( False, dim ))
+    # end
+
+    # returns whether arg is passed to foo_work_size_bytes.
+    # Outputs that aren't arrays (rank, rcond, ...) and integer arrays
+    # (ipiv, ...) aren't referenced by the query, so are omitted;
+    # enums are kept, including in,out equed.
+    def in_size_query( self, arg ):
+        if (arg.is_array):
+            return arg not in self.int_arrays
+        return arg.intent == 'in' or arg.is_enum
+    # end
+
+    # returns whether arg is a dimension after the first array that the
+    # workspace query needs, e.g., trevc3's n and mm, or geqr's tsize.
+    # A plan takes it in its constructor instead of execute().
+    # Leading dimensions get their smallest valid value instead, and
+    # arguments in plan_query_values get that value.
+    def is_plan_dim( self, arg ):
+        return (arg in self.exec_args and not arg.is_array
+                and arg.intent == 'in' and arg.dtype == 'int64_t'
+                and not re.search( r'^ld', arg.name )
+                and arg.name not in plan_query_values)
+    # end
+
+    # returns prototype arguments, except workspace;
+    # with size=True, only those for foo_work_size_bytes;
+    # with exec_only=True, only those for a plan's execute.
+    def proto( self, real_t='blas::real_type<scalar_t>', size=False, exec_only=False ):
+        proto = []
+        args = self.exec_args if (exec_only) else self.plan_args + self.exec_args
+        for arg in args:
+            if (size and not self.in_size_query( arg )):
+                continue
+            if (exec_only and self.is_plan_dim( arg )):
+                continue
+            prefix = '\n' + tab if (arg.is_array and proto) else ''
+            if (arg.is_array):
+                const = ' const' if (arg.intent == 'in') else ''
+                proto.append( prefix + self.ttype( arg, real_t ) + const + '* ' + arg.name )
+            elif (arg.intent == 'in'):
+                proto.append( self.ttype( arg, real_t ) + ' ' + arg.name )
+            else:
+                proto.append( ('\n' + tab if (proto) else '') + self.ttype( arg, real_t ) + '* ' + arg.name )
+        # end
+        return wrap_args( tab + ', '.join( proto ) )
+    # end
+# end
+
+# --------------------
+# returns intermediate wrappers around LAPACK to deal with precisions
+def generate_dispatch( info ):
+    txt = ('//' + '-'*78 + '\n'
+        +  '// Intermediate wrappers around LAPACK to deal with precisions.\n')
+    first = True
+    for func in info.funcs:
+        if (not first):
+            txt += '//----------\n'
+        first = False
+        fargs = dict( (arg.name, arg) for arg in func.args )
+        real_t = 'float' if (func.xname[0] in ('s', 'c')) else 'double'
+        params = []
+        call   = []
+        for marg in info.args:
+            arg = fargs.get( marg.name )
+            if (arg):
+                dtype = arg.dtype
+            elif (marg.dtype in ('float', 'double')):
+                # not in this precision, e.g., rwork in real; not passed
+                dtype = real_t
+            elif (re.search( r'^std::complex', marg.dtype )):
+                dtype = func_scalar_type( func )
+            else:
+                dtype = marg.dtype
+            cast = ''
+            m = re.search( r'^std::complex<(\w+)>$', dtype )
+            if (m):
+                cast = '(lapack_complex_' + m.group(1) + '*) '
+            prefix = '\n' + tab if (marg.is_array) else ''
+            if (marg.is_enum and marg.intent == 'in'):
+                params.append( prefix + 'char ' + marg.name )
+                ref = '&' + marg.name
+            elif (marg.is_enum):
+                # in,out enums: equed
+                params.append( prefix + 'char* ' + marg.name )
+                ref = marg.name
+            elif (marg.is_array):
+                const = ' const' if (marg.intent == 'in') else ''
+                if (dtype in ('int64_t', 'bool')):
+                    dtype = 'lapack_int'
+                params.append( prefix + dtype + const + '* ' + marg.name )
+                ref = re.sub( r'\*', const + '*', cast ) + marg.name
+            elif (marg.intent == 'in' and dtype in ('int64_t', 'bool')):
+                params.append( prefix + 'lapack_int ' + marg.name )
+                ref = '&' + marg.name
+            elif (marg.intent == 'in'):
+                params.append( prefix + dtype + ' ' + marg.name )
+                ref = cast + '&' + marg.name
+            elif (dtype in ('int64_t', 'bool')):
+                # output dimensions: info, rank, ...
+                params.append( prefix + 'lapack_int* ' + marg.name )
+                ref = marg.name
+            else:
+                # output scalars: rcond, ...
+                params.append( prefix + dtype + '* ' + marg.name )
+                ref = cast + marg.name
+            # end
+            if (arg):
+                call.append( ('\n' + tab*2 if marg.is_array else '') + ref )
+        # end
+        retval = func.retval if (func.is_func) else 'void'
+        ret    = 'return ' if (func.is_func) else ''
+        txt += ('static ' + retval + ' fortran_' + info.name + '(\n' + tab + ', '.join( params ) + ' )\n'
+            +   '{\n'
+            +   tab + ret + 'LAPACK_' + func.xname + '(\n' + tab*2 + ', '.join( call ))
+        nchar = len( [ arg for arg in func.args if (arg.is_enum) ] )
+        if (nchar > 0):
+            txt += ('\n' + tab*2 + '#ifdef LAPACK_FORTRAN_STRLEN_END\n'
+                +   tab*2 + ', ' + ', '.join( ['1']*nchar ) + '\n'
+                +   tab*2 + '#endif\n'
+                +   tab + ');\n')
+        else:
+            txt += ' );\n'
+        txt += '}\n\n'
+    # end
+    return txt
+# end
+
+# --------------------
+# returns txt with lines longer than 80 characters wrapped after commas,
+# keeping each line's indent, e.g., the long scalar arguments of heevx
+# in work.hh
+def wrap_args( txt ):
+    lines = []
+    for line in txt.split( '\n' ):
+        indent = re.match( r' *', line ).group( 0 )
+        while (len( line ) > 80):
+            i = line.rfind( ', ', 0, 80 )
+            if (i < len( indent )):
+                break
+            lines.append( line[ :i+1 ] )
+            line = indent + line[ i+2: ]
+        # end
+        lines.append( line )
+    # end
+    return '\n'.join( lines )
+# end
+
+# --------------------
+# returns dim without enclosing parens, e.g., "(n)" => "n"
+def unparen( dim ):
+    if (dim and dim[0] == '(' and dim[-1] == ')'):
+        depth = 0
+        for i in range( len( dim ) ):
+            if (dim[i] == '('):
+                depth += 1
+            elif (dim[i] == ')'):
+                depth -= 1
+            if (depth == 0 and i < len( dim ) - 1):
+                return dim
+        # end
+        return dim[1:-1].strip()
+    return dim
+# end
+
+# --------------------
+# returns size from workspace query for work array arg,
+# e.g., "max( 1, lapack_int( real(qry_work[0]) ) )"
+def query_size_expr( info, arg ):
+    if (arg.dtype == 'lapack_int'):
+        qry = 'qry_' + arg.name + '[0]'
+    else:
+        qry = 'lapack_int( real(qry_' + arg.name + '[0]) )'
+    return info.guard( arg, 'max( 1, ' + qry + ' )' )
+# end
+
+# --------------------
+# adds "using real_t" to function body if it uses real_t
+def add_using_real( body ):
+    if (re.search( r'\breal_t\b', body )):
+        body = tab + 'using real_t = blas::real_type<scalar_t>;\n\n' + body
+    return body
+# end
+
+# ------------------------------------------------------------------------------
+# returns overloads taking caller-provided workspace, and the
+# foo_work_size_bytes query for them, for given functions, which are
+# the precisions of one routine. Declarations go in include/lapack/work.hh
+# (header=True); definitions go at the end of src/foo.cc.
+def generate_work( funcs, header=False ):
+    info = TemplateInfo( funcs )
+    name = info.name
+    if (not info.work_args):
+        return ''
+    is_func = info.master.is_func
+    if (is_func and info.use_query):
+        print( 'Warning: workspace query in function', name, '; no work overloads generated' )
+        return ''
+    retval = 'blas::real_type<scalar_t>' if (is_func) else 'int64_t'
+
+    proto      = info.proto()
+    proto_size = info.proto( size=True )
+    if (header):
+        txt = ('//' + '-'*78 + '\n'
+            +  'template <typename scalar_t>\n'
+            +  'void ' + name + '_work_size_bytes(\n' + proto_size + ',\n'
+            +  tab + 'size_t* work_size );\n\n'
+            +  'template <typename scalar_t>\n'
+            +  retval + ' ' + name + '(\n' + proto + ',\n'
+            +  tab + 'void* work, size_t work_size );\n\n')
+
+        # aliases for real routines (hesv => sysv, etc.)
+        s = re.search( r'^(sy|sp|sb|or|op)(\w+)', name )
+        if (s):
+            alias = alias_map[ s.group(1) ] + s.group(2)
+            size_args = [ a.name for a in info.plan_args + info.exec_args
+                          if (info.in_size_query( a )) ]
+            args = [ a.name for a in info.plan_args + info.exec_args ]
+            for func in funcs:
+                if (func.xname[0] not in ('s', 'd')):
+                    continue
+                scalar_t = func_scalar_type( func )
+                for (rv, fname, p, a, last, last_args) in (
+                        ('void', '_work_size_bytes', proto_size, size_args,
+                         'size_t* work_size', 'work_size'),
+                        (retval, '', proto, args,
+                         'void* work, size_t work_size', 'work, work_size')):
+                    p = p.replace( 'blas::real_type<scalar_t>', scalar_t ).replace( 'scalar_t', scalar_t )
+                    rv = rv.replace( 'blas::real_type<scalar_t>', scalar_t )
+                    ret = '' if (rv == 'void') else 'return '
+                    txt += ('// ' + alias + fname + ' alias to ' + name + fname + '\n'
+                        +   'inline ' + rv + ' ' + alias + fname + '(\n' + p + ',\n'
+                        +   tab + last + ' )\n'
+                        +   '{\n'
+                        +   tab + ret + name + fname + '( ' + ', '.join( a + [ last_args ] ) + ' );\n'
+                        +   '}\n\n')
+                # end
+            # end
+        # end
+        if (name in post_rename):
+            for (search, replace) in post_rename[ name ]:
+                txt = re.sub( search, replace, txt )
+        txt = re.sub( r' +$', r'', txt, 0, re.M )
+        return txt
+    # end
+
+    # --------------------
+    int_checks  = ''
+    locals_size = ''  # local variables in foo_work_size_bytes
+    locals_exec = ''  # local variables in foo
+    fixed_lwork = ''  # lwork not queried, also needed for layout
+    qry_vars    = ''
+    qry_size    = []  # arguments to query in foo_work_size_bytes
+    qry_exec    = []  # arguments to query in foo
+    call_args   = []
+    cleanup     = ''
+    for arg in info.args:
+        prefix = '\n' + tab*2 if (arg.is_array) else ''
+        if (arg.is_work):
+            if (arg in info.queried):
+                qry_vars += tab + info.ttype( arg ) + ' qry_' + arg.name + '[1];\n'
+                qry = prefix + 'qry_' + arg.name
+            else:
+                # not referenced in query
+                qry = prefix + 'nullptr'
+            qry_size.append( qry )
+            qry_exec.append( qry )
+            call_args.append( prefix + arg.name + '_' )
+        elif (arg.is_lwork):
+            if (arg.use_query):
+                qry = 'ineg_one'
+            else:
+                var = tab + 'lapack_int ' + arg.lname + ' = (lapack_int) ' + arg.lbound + ';\n'
+                fixed_lwork += var
+                locals_exec += var
+                qry = arg.lname
+            qry_size.append( qry )
+            qry_exec.append( qry )
+            call_args.append( arg.lname )
+        elif (arg.name == 'info'):
+            qry_size.append( '&info_' )
+            qry_exec.append( '&info_' )
+            call_args.append( '&info_' )
+        elif (arg.is_array):
+            if (arg in info.int_arrays):
+                # not referenced in query
+                qry = prefix + 'nullptr'
+                call_args.append( prefix + arg.pname )
+            else:
+                qry = prefix + arg.name
+                call_args.append( prefix + arg.name )
+            qry_size.append( qry )
+            qry_exec.append( qry )
+        elif (arg.intent == 'in' and arg.dtype in ('int64_t', 'bool')):
+            int_checks += tab*2 + 'lapack_error_if( std::abs(' + arg.name + ') > std::numeric_limits<lapack_int>::max() );\n'
+            var = tab + 'lapack_int ' + arg.lname + ' = (lapack_int) ' + arg.name + ';\n'
+            locals_size += var
+            locals_exec += var
+            qry_size.append( arg.lname )
+            qry_exec.append( arg.lname )
+            call_args.append( arg.lname )
+        elif (arg.is_enum):
+            enum2char = enum_map[ arg.name ][1]
+            if (arg.intent == 'in'):
+                var = tab + 'char ' + arg.lname + ' = ' + enum2char + '( ' + arg.name + ' );\n'
+                ref = arg.lname
+            else:
+                # in,out enums: equed
+                var = tab + 'char ' + arg.lname + ' = ' + enum2char + '( *' + arg.name + ' );\n'
+                ref = '&' + arg.lname
+                char2enum = re.sub( r'^(\w+)2char$', r'char2\1', enum2char )
+                cleanup += tab + '*' + arg.name + ' = ' + char2enum + '( ' + arg.lname + ' );\n'
+            locals_size += var
+            locals_exec += var
+            qry_size.append( ref )
+            qry_exec.append( ref )
+            call_args.append( ref )
+        elif (arg.intent == 'in'):
+            qry_size.append( arg.name )
+            qry_exec.append( arg.name )
+            call_args.append( arg.name )
+        elif (arg.dtype in ('int64_t', 'bool')):
+            # output dimensions: rank, nfound, ...
+            # as in the wrapper, copy in case it is in,out (trexc ifst)
+            locals_size += tab + 'lapack_int ' + arg.lname + ' = 0;\n'
+            locals_exec += tab + 'lapack_int ' + arg.lname + ' = (lapack_int) *' + arg.name + ';\n'
+            qry_size.append( '&' + arg.lname )
+            qry_exec.append( '&' + arg.lname )
+            call_args.append( '&' + arg.lname )
+            cleanup += tab + '*' + arg.name + ' = ' + arg.lname + ';\n'
+        else:
+            # output scalars: rcond, ...; omitted from foo_work_size_bytes
+            locals_size += tab + info.ttype( arg ) + ' ' + arg.name + '_;\n'
+            qry_size.append( '&' + arg.name + '_' )
+            qry_exec.append( arg.name )
+            call_args.append( arg.name )
+        # end
+    # end
+    if (not info.queried):
+        pass  # no query in foo_work_size_bytes; see layout below
+    elif (not is_func):
+        locals_size += fixed_lwork + tab + 'lapack_int info_ = 0;\n'
+    if (not is_func):
+        locals_exec += tab + 'lapack_int info_ = 0;\n'
+
+    if (int_checks):
+        int_checks = (tab + '// check for overflow\n'
+                   +  tab + 'if (sizeof(int64_t) > sizeof(lapack_int)) {\n'
+                   +  int_checks
+                   +  tab + '}\n')
+
+    # trace the call, not the size query
+    dim_args = [ a.name for a in info.args
+                 if (a.intent == 'in' and not a.is_array
+                     and a.dtype in ('int64_t', 'bool')) ]
+    trace = generate_trace_block( name, 'trace::internal::precision< scalar_t >()',
+                                  dim_args, 'scalar_t' )
+    trace = ('\n' if int_checks else '') + trace + '\n'
+
+    # layout of workspace buffer: 32-bit copies of int arrays,
+    # then fixed-size work arrays, then other queried work arrays,
+    # then main queried work array.
+    layout_size = ''
+    layout_get  = ''
+    for arg in info.int_arrays:
+        const = ' const' if (arg.intent == 'in') else ''
+        dim = unparen( arg.dim )
+        end = dim if (re.search( r'^\w+$', dim )) else '(' + dim + ')'
+        copy_in  = ''
+        copy_out = ''
+        if (arg.intent in ('in', 'in,out')):
+            copy_in = 'std::copy( ' + arg.name + ', ' + arg.name + ' + ' + end + ', ' + arg.lname + ' );\n'
+        if (arg.intent in ('out', 'in,out')):
+            copy_out = 'std::copy( ' + arg.lname + ', ' + arg.lname + ' + ' + end + ', ' + arg.name + ' );\n'
+        if (arg.dtype == 'bool'):
+            # bool arrays (select) always need lapack_int copies
+            layout_size += tab + 'buffer.take< lapack_int >( ' + dim + ' );\n'
+            layout_get  += tab + 'lapack_int* ' + arg.lname + ' = buffer.take< lapack_int >( ' + dim + ' );\n'
+            if (copy_in):
+                layout_get += tab + copy_in
+            layout_get += tab + 'lapack_int' + const + '* ' + arg.pname + ' = ' + arg.lname + ';\n'
+            if (copy_out):
+                cleanup += tab + copy_out
+            continue
+        # end
+        layout_size += (tab + '#ifndef LAPACK_ILP64\n'
+                    +   tab*2 + 'buffer.take< lapack_int >( ' + dim + ' );\n'
+                    +   tab + '#endif\n')
+        layout_get  += (tab + '#ifndef LAPACK_ILP64\n'
+                    +   tab*2 + 'lapack_int* ' + arg.lname + ' = buffer.take< lapack_int >( ' + dim + ' );\n')
+        if (copy_in):
+            layout_get += tab*2 + copy_in
+        layout_get  += (tab*2 + 'lapack_int' + const + '* ' + arg.pname + ' = ' + arg.lname + ';\n'
+                    +   tab + '#else\n'
+                    +   tab*2 + 'lapack_int' + const + '* ' + arg.pname + ' = ' + arg.name + ';\n'
+                    +   tab + '#endif\n')
+        if (copy_out):
+            cleanup += (tab + '#ifndef LAPACK_ILP64\n'
+                    +   tab*2 + copy_out
+                    +   tab + '#endif\n')
+    # end
+    known = set( a.name.lower() for a in info.args ) | set( ('max', 'min') )
+    for arg in info.work_args:
+        if (arg in info.queried):
+            continue
+        (dim, real_dim) = info.work_dims( arg )
+        # dimension from LAPACK docs may use variables that aren't arguments
+        unknown = set( re.findall( r'\b[a-z_]\w*', re.sub( r'\w+::\w+', '', dim + ' ' + real_dim ) ) ) - known
+        if (unknown):
+            todo = tab + '// todo: size of ' + arg.name + ' uses ' + ', '.join( sorted( unknown ) ) + '\n'
+            layout_size += todo
+            layout_get  += todo
+        dim = info.guard( arg, dim, real_dim )
+        t = info.ttype( arg )
+        layout_size += tab + 'buffer.take< ' + t + ' >( ' + dim + ' );\n'
+        layout_get  += tab + t + '* ' + arg.name + '_ = buffer.take< ' + t + ' >( ' + dim + ' );\n'
+    # end
+
+    query_size = ''
+    query_exec = ''
+    if (info.queried):
+        query = (tab + 'lapack_int ineg_one = -1;\n'
+              +  tab + 'fortran_' + name + '(\n' + tab*2 + ', '.join( qry_size ) + ' );\n'
+              +  tab + 'if (info_ < 0) {\n'
+              +  tab*2 + 'throw Error();\n'
+              +  tab + '}\n')
+        query_size = ('\n'
+                   +  tab + '// query for workspace size\n'
+                   +  qry_vars
+                   +  query)
+        sizes = ''
+        for arg in info.queried:
+            lwork = info.lwork( arg )
+            sizes += tab + 'lapack_int ' + lwork.lname + ' = ' + query_size_expr( info, arg ) + ';\n'
+            if (arg is not info.main_work):
+                t = info.ttype( arg )
+                layout_size += tab + 'buffer.take< ' + t + ' >( ' + lwork.lname + ' );\n'
+                layout_get  += tab + t + '* ' + arg.name + '_ = buffer.take< ' + t + ' >( ' + lwork.lname + ' );\n'
+        # end
+        query_size += sizes
+
+        # other queried arrays (rwork, iwork) need their queried size
+        secondary = [ arg for arg in info.queried if (arg is not info.main_work) ]
+        if (secondary):
+            query_exec = ('\n'
+                       +  tab + '// query for size of '
+                       +  ', '.join( arg.name for arg in secondary ) + '\n'
+                       +  qry_vars
+                       +  query.replace( ', '.join( qry_size ), ', '.join( qry_exec ) ))
+            for arg in secondary:
+                lwork = info.lwork( arg )
+                query_exec += tab + 'lapack_int ' + lwork.lname + ' = ' + query_size_expr( info, arg ) + ';\n'
+        # end
+
+        w = info.main_work
+        t = info.ttype( w )
+        lwork = info.lwork( w )
+        layout_size += tab + 'buffer.take< ' + t + ' >( ' + lwork.lname + ' );\n'
+        layout_get  += (tab + 'lapack_int ' + lwork.lname + ' = buffer.remaining< ' + t + ' >();\n'
+                    +   tab + t + '* ' + w.name + '_ = buffer.take< ' + t + ' >( ' + lwork.lname + ' );\n')
+    # end
+
+    if (is_func):
+        call = tab + 'return fortran_' + name + '(\n' + tab*2 + ', '.join( call_args ) + ' );\n'
+    else:
+        call = (tab + 'fortran_' + name + '(\n' + tab*2 + ', '.join( call_args ) + ' );\n'
+             +  tab + 'if (info_ < 0) {\n'
+             +  tab*2 + 'throw Error();\n'
+             +  tab + '}\n'
+             +  cleanup
+             +  tab + 'return info_;\n')
+
+    if (not info.queried):
+        # keep only fixed lwork that the layout uses
+        locals_size = ''.join( v for v in fixed_lwork.splitlines( True )
+                               if (re.search( r'\b' + v.split()[1] + r'\b', layout_size )) )
+
+    body_size = add_using_real(
+                int_checks
+              + locals_size
+              + query_size
+              + '\n'
+              + tab + 'internal::WorkBuffer buffer;\n'
+              + layout_size
+              + tab + '*work_size = buffer.bytes();\n' )
+
+    # with a query, work gets what remains after the other arrays
+    rest = '; work gets the rest' if (info.queried) else ''
+    body_exec = add_using_real(
+                int_checks
+              + trace
+              + locals_exec
+              + query_exec
+              + '\n'
+              + tab + '// carve workspace arrays from buffer' + rest + '\n'
+              + tab + 'internal::WorkBuffer buffer( work, work_size );\n'
+              + layout_get
+              + '\n'
+              + call )
+
+    txt = generate_dispatch( info )
+    txt += ('//' + '-'*78 + '\n'
+        +   '/// Computes the size of workspace needed by ' + name + ' with caller-provided\n'
+        +   '/// workspace. Arrays are not referenced.\n'
+        +   '///\n'
+        +   '/// @param[out] work_size\n'
+        +   '///     Size of workspace, in bytes.\n'
+        +   '///\n'
+        +   '/// @ingroup work\n'
+        +   'template <typename scalar_t>\n'
+        +   'void ' + name + '_work_size_bytes(\n' + proto_size + ',\n'
+        +   tab + 'size_t* work_size )\n'
+        +   '{\n'
+        +   body_size
+        +   '}\n\n')
+
+    txt += ('//' + '-'*78 + '\n'
+        +   '/// Same as lapack::' + name + ', but with caller-provided workspace\n'
+        +   '/// instead of allocating it.\n'
+        +   '/// See lapack::' + name + ' for the other arguments.\n'
+        +   '///\n'
+        +   '/// @param[in] work\n'
+        +   '///     Workspace buffer of work_size bytes.\n'
+        +   '///\n'
+        +   '/// @param[in] work_size\n'
+        +   '///     Size of work, in bytes, at least that returned by\n'
+        +   '///     ' + name + '_work_size_bytes.\n'
+        +   '///\n'
+        +   '/// @ingroup work\n'
+        +   'template <typename scalar_t>\n'
+        +   retval + ' ' + name + '(\n' + proto + ',\n'
+        +   tab + 'void* work, size_t work_size )\n'
+        +   '{\n'
+        +   body_exec
+        +   '}\n\n')
+
+    # explicit instantiations
+    txt += ('//' + '-'*78 + '\n'
+        +   '// Explicit instantiations.\n')
+    for (rv, fname, p, last) in (('void', name + '_work_size_bytes', proto_size, 'size_t* work_size'),
+                                 (retval, name, proto, 'void* work, size_t work_size')):
+        if (fname == name):
+            txt += '//--------------------\n'
+        for func in funcs:
+            scalar_t = func_scalar_type( func )
+            real_t = 'float' if (func.xname[0] in ('s', 'c')) else 'double'
+            p2 = p.replace( 'blas::real_type<scalar_t>', real_t ).replace( 'scalar_t', scalar_t )
+            rv2 = rv.replace( 'blas::real_type<scalar_t>', real_t )
+            txt += 'template\n' + rv2 + ' ' + fname + '(\n' + p2 + ',\n' + tab + last + ' );\n\n'
+        # end
+    # end
+
+    # post renaming
+    if (name in post_rename):
+        for (search, replace) in post_rename[ name ]:
+            txt = re.sub( search, replace, txt )
+
+    # trim trailing whitespace
+    txt = re.sub( r' +$', r'', txt, 0, re.M )
+
+    return txt
+# end
+
+# --------------------
+# returns scalar type of func's precision
+def func_scalar_type( func ):
+    return { 's': 'float', 'd': 'double',
+             'c': 'std::complex<float>', 'z': 'std::complex<double>' }[ func.xname[0] ]
+# end
+
+# ------------------------------------------------------------------------------
+# Values that plans pass in workspace queries for scalar arguments of
+# execute(), where LAPACK would reject 0, e.g., il = 0 for range = Index.
+# The workspace doesn't depend on them.
+plan_query_values = {
+    'vl':     'real_t( 0 )',
+    'vu':     'real_t( 1 )',
+    'il':     '1',
+    'iu':     'n',
+    'abstol': 'real_t( 0 )',
+    'rcond':  'real_t( -1 )',
+    'tola':   'real_t( 0 )',
+    'tolb':   'real_t( 0 )',
+    'nzc':    'n',
+}
+
+# Routines that need other query values than plan_query_values.
+plan_query_overrides = {
+    'gesvdx': { 'iu': 'std::min( m, n )' },  # iu <= min( m, n )
+}
+
+# ------------------------------------------------------------------------------
+# What each plan's execute() does, for its doc.
+plan_descriptions = {
+    'bbcsd':        'Computes the CS decomposition of a bidiagonal-block matrix',
+    'gebrd':        'Reduces a general matrix to bidiagonal form',
+    'gees':         'Computes the Schur factorization',
+    'geesx':        'Computes the Schur factorization, with condition numbers,',
+    'geev':         'Computes eigenvalues and, optionally, eigenvectors',
+    'gehrd':        'Reduces a general matrix to upper Hessenberg form',
+    'gelq':         'Computes the LQ factorization, with tall-skinny LQ,',
+    'gelqf':        'Computes the LQ factorization',
+    'gels':         'Solves the least squares problem',
+    'gelsd':        'Solves the least squares problem by the SVD, with divide and conquer,',
+    'gelss':        'Solves the least squares problem by the SVD',
+    'gelsy':        'Solves a least squares problem by complete orthogonal factorization,',
+    'gemlq':        'Multiplies by the matrix Q from gelq',
+    'gemqr':        'Multiplies by the matrix Q from geqr',
+    'geqlf':        'Computes the QL factorization',
+    'geqp3':        'Computes the QR factorization with column pivoting',
+    'geqr':         'Computes the QR factorization, with tall-skinny QR,',
+    'geqrf':        'Computes the QR factorization',
+    'geqrfp':       'Computes the QR factorization, with nonnegative diagonal R,',
+    'gerqf':        'Computes the RQ factorization',
+    'gesdd':        'Computes the SVD',
+    'gesvd':        'Computes the SVD',
+    'gesvdx':       'Computes selected singular values and vectors',
+    'getri':        'Computes the inverse from the LU factorization',
+    'getsls':       'Solves the least squares problem with tall-skinny QR or LQ',
+    'ggev':         'Computes generalized eigenvalues and, optionally, eigenvectors',
+    'ggev3':        'Computes generalized eigenvalues and, optionally, eigenvectors',
+    'ggglm':        'Solves a general Gauss-Markov linear model problem',
+    'gges':         'Computes the generalized Schur factorization',
+    'gges3':        'Computes the generalized Schur factorization',
+    'ggesx':        'Computes the generalized Schur factorization, with condition numbers,',
+    'gglse':        'Solves a linear equality-constrained least squares problem',
+    'ggqrf':        'Computes the generalized QR factorization',
+    'ggrqf':        'Computes the generalized RQ factorization',
+    'ggsvd3':       'Computes the generalized SVD',
+    'ggsvp3':       'Computes the preprocessing for the generalized SVD',
+    'hbev_2stage':  'Computes band eigenvalues and, optionally, eigenvectors',
+    'hbevd':        'Computes band eigenvalues and, optionally, eigenvectors',
+    'hbevd_2stage': 'Computes band eigenvalues and, optionally, eigenvectors',
+    'hbevx_2stage': 'Computes selected band eigenvalues and, optionally, eigenvectors,',
+    'hbgvd':        'Computes generalized band eigenvalues and, optionally, eigenvectors,',
+    'heev':         'Computes eigenvalues and, optionally, eigenvectors',
+    'heev_2stage':  'Computes eigenvalues and, optionally, eigenvectors',
+    'heevd':        'Computes eigenvalues and, optionally, eigenvectors',
+    'heevd_2stage': 'Computes eigenvalues and, optionally, eigenvectors',
+    'heevr':        'Computes selected eigenvalues and, optionally, eigenvectors',
+    'heevr_2stage': 'Computes selected eigenvalues and, optionally, eigenvectors',
+    'heevx':        'Computes selected eigenvalues and, optionally, eigenvectors',
+    'heevx_2stage': 'Computes selected eigenvalues and, optionally, eigenvectors',
+    'hegv':         'Computes generalized eigenvalues and, optionally, eigenvectors',
+    'hegv_2stage':  'Computes generalized eigenvalues and, optionally, eigenvectors',
+    'hegvd':        'Computes generalized eigenvalues and, optionally, eigenvectors',
+    'hegvx':        'Computes selected generalized eigenvalues and, optionally, eigenvectors,',
+    'hesv':         'Solves a Hermitian indefinite system',
+    'hesv_aa':      'Solves a Hermitian indefinite system with Aasen\'s algorithm,',
+    'hesv_rk':      'Solves a Hermitian indefinite system with bounded Bunch-Kaufman pivoting,',
+    'hesv_rook':    'Solves a Hermitian indefinite system with rook pivoting,',
+    'hesvx':        'Solves a Hermitian indefinite system, with error bounds,',
+    'hetrd':        'Reduces a Hermitian matrix to tridiagonal form',
+    'hetrd_2stage': 'Reduces a Hermitian matrix to tridiagonal form in two stages',
+    'hetrf':        'Computes the Bunch-Kaufman factorization',
+    'hetrf_aa':     'Computes the Aasen factorization',
+    'hetrf_rk':     'Computes the bounded Bunch-Kaufman factorization',
+    'hetrf_rook':   'Computes the rook factorization',
+    'hetri2':       'Computes the inverse from the Bunch-Kaufman factorization',
+    'hetri_rk':     'Computes the inverse from the bounded Bunch-Kaufman factorization',
+    'hgeqz':        'Computes the generalized Schur form of a Hessenberg-triangular pair',
+    'hpevd':        'Computes packed eigenvalues and, optionally, eigenvectors',
+    'hpgvd':        'Computes generalized packed eigenvalues and, optionally, eigenvectors,',
+    'hseqr':        'Computes eigenvalues and, optionally, the Schur form of a Hessenberg matrix',
+    'orcsd2by1':    'Computes the CS decomposition of a 2-by-1 block orthogonal matrix',
+    'stedc':        'Computes tridiagonal eigenvalues and vectors by divide and conquer',
+    'stegr':        'Computes selected tridiagonal eigenvalues and vectors by MRRR',
+    'stemr':        'Computes selected tridiagonal eigenvalues and vectors by MRRR',
+    'stevd':        'Computes tridiagonal eigenvalues and, optionally, eigenvectors',
+    'stevr':        'Computes selected tridiagonal eigenvalues and vectors by MRRR',
+    'sysv':         'Solves a symmetric indefinite system',
+    'sysv_aa':      'Solves a symmetric indefinite system with Aasen\'s algorithm,',
+    'sysv_rk':      'Solves a symmetric indefinite system with bounded Bunch-Kaufman pivoting,',
+    'sysv_rook':    'Solves a symmetric indefinite system with rook pivoting,',
+    'sysvx':        'Solves a symmetric indefinite system, with error bounds,',
+    'sytrf':        'Computes the Bunch-Kaufman factorization',
+    'sytrf_aa':     'Computes the Aasen factorization',
+    'sytrf_rk':     'Computes the bounded Bunch-Kaufman factorization',
+    'sytrf_rook':   'Computes the rook factorization',
+    'sytri2':       'Computes the inverse from the Bunch-Kaufman factorization',
+    'sytri_rk':     'Computes the inverse from the bounded Bunch-Kaufman factorization',
+    'tgsyl':        'Solves the generalized Sylvester equation',
+    'trevc3':       'Computes eigenvectors of a triangular matrix',
+    'trsen':        'Reorders the Schur factorization, with condition numbers,',
+    'tzrzf':        'Reduces an upper trapezoidal matrix to upper triangular form',
+    'ungbr':        'Generates the matrix Q or P**H from gebrd',
+    'unghr':        'Generates the matrix Q from gehrd',
+    'unglq':        'Generates the matrix Q of an LQ factorization',
+    'ungql':        'Generates the matrix Q of a QL factorization',
+    'ungqr':        'Generates the matrix Q of a QR factorization',
+    'ungrq':        'Generates the matrix Q of an RQ factorization',
+    'ungtr':        'Generates the matrix Q from hetrd',
+    'unmbr':        'Multiplies by the matrix Q or P from gebrd',
+    'unmhr':        'Multiplies by the matrix Q from gehrd',
+    'unmlq':        'Multiplies by the matrix Q of an LQ factorization',
+    'unmql':        'Multiplies by the matrix Q of a QL factorization',
+    'unmqr':        'Multiplies by the matrix Q of a QR factorization',
+    'unmrq':        'Multiplies by the matrix Q of an RQ factorization',
+    'unmrz':        'Multiplies by the matrix Z from tzrzf',
+    'unmtr':        'Multiplies by the matrix Q from hetrd',
+}
+
+# ------------------------------------------------------------------------------
+# Real routines whose complex-named counterpart takes different arguments,
+# so they get their own plan instead of sharing the complex-named one.
+plan_unaliased = (
+    'orcsd2by1',  # uncsd2by1 has rwork
+)
+
+# returns whether LAPACK has routine xname, e.g., 'dsytrd'.
+def lapack_has( xname ):
+    return os.path.exists( os.path.join( lapack, 'SRC', xname + '.f' ) )
+# end
+
+# ------------------------------------------------------------------------------
+# returns LAPACK++ plan for given functions, which are the precisions of
+# one routine. A plan's constructor takes arguments before the first array
+# (and dimensions after it that the query needs) and does the workspace
+# query; execute() takes the remaining arguments and calls the
+# caller-provided workspace overload from generate_work.
+# The class declaration goes in include/lapack/plan.hh (header=True);
+# the constructor and execute go in src/plan_foo.cc.
+#
+# As in lapack/work.hh, real routines named sy, or, etc. use the
+# complex-named plan (syev uses heev), which is instantiated for all
+# precisions. If the real routine has only real precisions, the plan
+# also gets its name as an alias (plan::syev is plan::heev).
+def generate_plan( funcs, header=False ):
+    info = TemplateInfo( funcs )
+    name = info.name
+    if (not info.use_query):
+        print( 'Warning: no workspace query in', name, '; no plan generated' )
+        return ''
+
+    base = funcs[0].name
+    s = re.search( r'^(sy|sp|sb|or|op)(\w+)', base )
+    if (s and not info.is_complex and base not in plan_unaliased):
+        cname = alias_map[ s.group(1) ] + s.group(2)
+        if (lapack_has( 'z' + cname )):
+            print( 'no plan for', name, '; it uses the',
+                   wrapper_name_map.get( cname, cname ), 'plan' )
+            return ''
+    # end
+
+    real_name = None  # real routine that uses this plan, e.g., sytrd
+    alias = None      # plan alias, if real routine has only real precisions
+    s = re.search( r'^(he|hp|hb|un|up)(\w+)', base )
+    if (s and not info.is_mixed):
+        rname = alias_map_inverse[ s.group(1) ] + s.group(2)
+        if (lapack_has( 'd' + rname ) and rname not in plan_unaliased):
+            real_name = wrapper_name_map.get( rname, rname )
+            if (not lapack_has( 'z' + rname )):
+                alias = real_name
+    # end
+
+    plan_args = info.plan_args + [ arg for arg in info.exec_args
+                                   if (info.is_plan_dim( arg )) ]
+    proto_plan = ', '.join( arg.dtype + ' ' + arg.name for arg in plan_args )
+    proto_exec = info.proto( 'real_t', exec_only=True )
+    query_values = dict( plan_query_values )
+    query_values.update( plan_query_overrides.get( name, {} ) )
+
+    if (header):
+        members = ''
+        for arg in plan_args:
+            members += tab + info.ttype( arg ) + ' ' + arg.name + '_;\n'
+        members += tab + 'internal::work_vector work_;\n'
+        also = ' and lapack::' + alias if (alias) else ''
+        txt = ('//' + '-'*78 + '\n'
+            +  '/// Plan for lapack::' + name + also + '.\n'
+            +  '/// @ingroup plan\n'
+            +  'template <typename scalar_t>\n'
+            +  'class ' + name + '\n'
+            +  '{\n'
+            +  'public:\n')
+        # real_t is also needed for query values such as vl, e.g., in stevr
+        if (info.uses_real( info.exec_args )
+            or any( 'real_t' in query_values.get( arg.name, '' )
+                    for arg in info.exec_args )):
+            txt += tab + 'using real_t = blas::real_type< scalar_t >;\n\n'
+        txt += (tab + name + '(\n' + wrap_args( tab*2 + proto_plan + ' );' ) + '\n\n'
+            +   tab + 'int64_t execute(\n' + re.sub( r'^', tab, proto_exec, 0, re.M ) + ' );\n\n'
+            +   'private:\n'
+            +   members
+            +   '};\n\n')
+        if (alias):
+            txt += ('// ' + alias + ' alias to ' + name + '\n'
+                +   'template <typename scalar_t>\n'
+                +   'using ' + alias + ' = ' + name + '< scalar_t >;\n\n')
+        if (name in post_rename):
+            for (search, replace) in post_rename[ name ]:
+                txt = re.sub( search, replace, txt )
+        txt = re.sub( r' +$', r'', txt, 0, re.M )
+        return txt
+    # end
+
+    init = []
+    for arg in plan_args:
+        init.append( arg.name + '_( ' + arg.name + ' )' )
+    lds = ''
+    qry_args = []
+    call_args = []
+    for arg in info.plan_args:
+        qry_args.append( arg.name )
+        call_args.append( arg.name + '_' )
+    for arg in info.exec_args:
+        prefix = '\n' + tab*2 if (arg.is_array) else ''
+        if (info.is_plan_dim( arg )):
+            call_args.append( arg.name + '_' )
+        else:
+            call_args.append( prefix + arg.name )
+        if (not info.in_size_query( arg )):
+            continue
+        elif (arg.is_array):
+            qry_args.append( prefix + '(' + info.ttype( arg ) + '*) nullptr' )
+        elif (info.is_plan_dim( arg )):
+            qry_args.append( arg.name )
+        elif (re.search( r'^ld', arg.name ) and arg.lbound):
+            if (not lds):
+                lds = tab + '// smallest valid leading dimensions for the query\n'
+            lds += tab + 'int64_t ' + arg.name + ' = ' + query_lbound( arg ) + ';\n'
+            qry_args.append( arg.name )
+        elif (arg.name in query_values):
+            qry_args.append( query_values[ arg.name ] )
+        else:
+            print( 'Warning:', name, 'plan passes 0 for', arg.name, 'in workspace query' )
+            qry_args.append( '0' )
+    # end
+
+    also = ' (or ' + alias + ')' if (alias) else ''
+    line = '/// Creates a plan for ' + name + also + ', querying and allocating its workspace.\n'
+    if (len( line ) > 81):
+        line = line.replace( ' allocating', '\n/// allocating' )
+    txt = ('//' + '-'*78 + '\n'
+        +  line
+        +  '/// See lapack::' + name + ' for a description of the arguments.\n'
+        +  '///\n'
+        +  '/// @ingroup plan\n'
+        +  'template <typename scalar_t>\n'
+        +  name + '< scalar_t >::' + name + '(\n'
+        +  wrap_args( tab + proto_plan + ' )' ) + '\n'
+        +  tab + ': ' + (',\n' + tab + '  ').join( init ) + '\n'
+        +  '{\n'
+        +  lds
+        +  tab + 'size_t work_size;\n'
+        +  tab + 'lapack::' + name + '_work_size_bytes(\n' + tab*2 + ', '.join( qry_args ) + ',\n'
+        +  tab*2 + '&work_size );\n'
+        +  tab + 'work_.resize( work_size );\n'
+        +  '}\n\n')
+
+    desc = plan_descriptions.get( name, 'Calls ' + name )
+    line = '/// ' + desc + ' using the plan\'s workspace; see lapack::' + name + '.\n'
+    if (len( line ) > 81):
+        line = line.replace( ' using the plan', '\n/// using the plan' )
+    txt += ('//' + '-'*78 + '\n'
+        +   line
+        +   '/// Arrays must match the options and dimensions the plan was created for.\n'
+        +   '///\n'
+        +   '/// @ingroup plan\n'
+        +   'template <typename scalar_t>\n'
+        +   'int64_t ' + name + '< scalar_t >::execute(\n'
+        +   proto_exec + ' )\n'
+        +   '{\n'
+        +   tab + 'return lapack::' + name + '(\n' + tab*2 + ', '.join( call_args ) + ',\n'
+        +   tab*2 + 'work_.data(), work_.size() );\n'
+        +   '}\n\n')
+
+    # real precisions of complex-named plans call the aliases in work.hh
+    if (real_name):
+        types = ('float', 'double', 'std::complex<float>', 'std::complex<double>')
+    else:
+        types = [ func_scalar_type( func ) for func in funcs ]
+    txt += ('//' + '-'*78 + '\n'
+        +   '// Explicit instantiations.\n')
+    for t in types:
+        txt += 'template class ' + name + '< ' + t + ' >;\n'
+    txt += '\n'
+
+    # post renaming
+    if (name in post_rename):
+        for (search, replace) in post_rename[ name ]:
+            txt = re.sub( search, replace, txt )
+
+    # trim trailing whitespace
+    txt = re.sub( r' +$', r'', txt, 0, re.M )
+
+    return txt
+# end
+
 # ------------------------------------------------------------------------------
 def generate_tester( funcs ):
     # heuristic:
@@ -1853,10 +3202,18 @@ def process_routine( arg ):
         return
     # end
 
+    # native routines keep their header and tester, but nothing that
+    # would replace src/foo.cc or call the Fortran routine
+    do_wrapper = args.wrapper
+    do_plan    = args.plan
+    if (arg in native_routines):
+        print( 'skipping wrapper and plan for native routine', arg )
+        do_wrapper = do_plan = False
+
     if (args.header):
         print( '// ' + '-'*77, file=header )
 
-    if (args.wrapper):
+    if (do_wrapper):
         wrapper_file = os.path.join( gen, arg + '.cc' )
         print( 'generating', wrapper_file )
         wrapper = open( wrapper_file, 'w' )
@@ -1871,6 +3228,8 @@ def process_routine( arg ):
     requires_end = ''
 
     funcs = []
+    native_header  = ''
+    native_wrapper = ''
     i = 0
     for f in files:
         i += 1
@@ -1886,7 +3245,7 @@ def process_routine( arg ):
                 requires_if  = '#if LAPACK_VERSION >= %d%02d%02d  // >= %d.%d.%d\n\n' % (version + version)
                 requires_end = '\n#endif  // LAPACK >= %d.%d.%d\n' % (version)
             # end
-            if (args.wrapper):
+            if (do_wrapper):
                 print( wrapper_top1, file=wrapper, end='' )
                 print( requires_if,  file=wrapper, end='' )
                 print( wrapper_top2, file=wrapper, end='' )
@@ -1896,7 +3255,8 @@ def process_routine( arg ):
         if (args.header):
             txt = generate_wrapper( func, header=True )
             print( txt, file=header, end='' )
-        if (args.wrapper):
+            native_header += generate_native_pivot( txt )
+        if (do_wrapper):
             txt = '// ' + '-'*77 + '\n'
             print( txt, file=wrapper, end='' )
             if (last):
@@ -1906,14 +3266,50 @@ def process_routine( arg ):
                 print( '/// @ingroup ' + func.group + '\n', file=wrapper, end='' )
             txt = generate_wrapper( func )
             print( txt, file=wrapper, end='' )
+            native_wrapper += generate_native_pivot( txt )
     # end
 
+    # caller-provided workspace overloads are templated,
+    # so need to see all related functions.
+    if (args.header):
+        txt = generate_work( funcs, header=True )
+        print( txt, file=work_header, end='' )
+    if (do_wrapper):
+        txt = generate_work( funcs )
+        print( txt, file=wrapper, end='' )
+
+    # overloads with native lapack_int pivots
+    if (args.header and native_header):
+        print( '#ifndef LAPACK_ILP64\n' + native_header + '#endif\n\n',
+               file=header, end='' )
+    if (do_wrapper and native_wrapper):
+        print( '#ifndef LAPACK_ILP64\n\n' + native_pivot_doc
+               + '/// @ingroup ' + funcs[-1].group + '\n'
+               + native_wrapper + '\n#endif  // LAPACK_ILP64\n\n',
+               file=wrapper, end='' )
+
     # tester needs to see all related functions
     if (args.tester):
         txt = generate_tester( funcs )
         print( txt, file=tester, end='' )
 
-    if (args.wrapper):
+    # plan is templated, so also needs to see all related functions
+    if (do_plan):
+        txt = generate_plan( funcs, header=True )
+        if (txt):
+            print( txt, file=plan_header, end='' )
+            plan_file = os.path.join( gen, 'plan_' + arg + '.cc' )
+            print( 'generating', plan_file )
+            plan = open( plan_file, 'w' )
+            print( plan_top1,    file=plan, end='' )
+            print( requires_if,  file=plan, end='' )
+            print( plan_top2,    file=plan, end='' )
+            print( generate_plan( funcs ), file=plan, end='' )
+            print( plan_bottom,  file=plan, end='' )
+            print( requires_end, file=plan, end='' )
+            plan.close()
+
+    if (do_wrapper):
         print( wrapper_bottom, file=wrapper, end='' )
         print( requires_end,   file=wrapper, end='' )
         wrapper.close()
@@ -1937,6 +3333,17 @@ if (args.header):
     header = open( header_file, 'w' )
     print( header_top, file=header, end='' )
 
+    work_header_file = os.path.join( gen, 'work.hh' )
+    print( 'generating', work_header_file )
+    work_header = open( work_header_file, 'w' )
+    print( work_header_top, file=work_header, end='' )
+
+if (args.plan):
+    plan_header_file = os.path.join( gen, 'plan.hh' )
+    print( 'generating', plan_header_file )
+    plan_header = open( plan_header_file, 'w' )
+    print( plan_header_top, file=plan_header, end='' )
+
 for arg in args.argv:
     try:
         process_routine( arg )
@@ -1949,3 +3356,10 @@ for arg in args.argv:
 if (args.header):
     print( header_bottom, file=header, end='' )
     header.close()
+
+    print( work_header_bottom, file=work_header, end='' )
+    work_header.close()
+
+if (args.plan):
+    print( plan_header_bottom, file=plan_header, end='' )
+    plan_header.close()